@@ -0,0 +1,86 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace paddle {
+namespace distributed {
+
+// Wire codec for dense fp32 values on the push/pull path. Values are
+// quantized per block of kDenseCompressBlock floats: one fp32 max-abs
+// scale followed by the int16/int8 codes of the block, so the absolute
+// quantization error of an element is bounded by scale (the block max
+// divided by the integer range). int16 halves and int8 quarters the
+// wire bytes. Both ends read the table config, so no handshake is
+// needed on the wire.
+static const size_t kDenseCompressBlock = 1024;
+
+template <typename QType>
+inline size_t DenseCompressedSize(size_t num) {
+  size_t blocks = (num + kDenseCompressBlock - 1) / kDenseCompressBlock;
+  return blocks * sizeof(float) + num * sizeof(QType);
+}
+
+template <typename QType>
+inline void DenseCompress(const float* src, size_t num, char* dst) {
+  const float q_max = static_cast<float>(std::numeric_limits<QType>::max());
+
+  for (size_t begin = 0; begin < num; begin += kDenseCompressBlock) {
+    size_t end = std::min(begin + kDenseCompressBlock, num);
+
+    float max_abs = 0.0;
+    for (size_t i = begin; i < end; ++i) {
+      max_abs = std::max(max_abs, std::abs(src[i]));
+    }
+    float scale = max_abs / q_max;
+    memcpy(dst, &scale, sizeof(float));
+    dst += sizeof(float);
+
+    QType* codes = reinterpret_cast<QType*>(dst);
+    if (scale > 0) {
+      for (size_t i = begin; i < end; ++i) {
+        codes[i - begin] = static_cast<QType>(std::lround(src[i] / scale));
+      }
+    } else {
+      memset(dst, 0, (end - begin) * sizeof(QType));
+    }
+    dst += (end - begin) * sizeof(QType);
+  }
+}
+
+template <typename QType>
+inline void DenseDecompress(const char* src, size_t num, float* dst) {
+  for (size_t begin = 0; begin < num; begin += kDenseCompressBlock) {
+    size_t end = std::min(begin + kDenseCompressBlock, num);
+
+    float scale = 0.0;
+    memcpy(&scale, src, sizeof(float));
+    src += sizeof(float);
+
+    const QType* codes = reinterpret_cast<const QType*>(src);
+    for (size_t i = begin; i < end; ++i) {
+      dst[i] = static_cast<float>(codes[i - begin]) * scale;
+    }
+    src += (end - begin) * sizeof(QType);
+  }
+}
+
+}  // namespace distributed
+}  // namespace paddle
@@ -14,6 +14,8 @@
 
 #include "paddle/fluid/distributed/index_dataset/index_sampler.h"
 
+#include <random>
+
 namespace paddle {
 namespace distributed {
 
@@ -27,11 +29,30 @@ std::vector<std::vector<uint64_t>> LayerWiseSampler::sample(
       std::vector<uint64_t>(user_feature_num + 2));
 
   auto max_layer = tree_->Height();
-  size_t idx = 0;
+
+  // GetTravelCodes throws on an unknown target id, which must not happen
+  // inside the parallel region below, so the travel paths are resolved in a
+  // serial pre-pass (cheap map lookups).
+  std::vector<std::vector<IndexNode>> travel_paths(input_num);
   for (size_t i = 0; i < input_num; i++) {
-    auto travel_codes =
-        tree_->GetTravelCodes(target_ids[i], start_sample_layer_);
-    auto travel_path = tree_->GetNodes(travel_codes);
+    travel_paths[i] = tree_->GetNodes(
+        tree_->GetTravelCodes(target_ids[i], start_sample_layer_));
+  }
+
+  // Every instance writes a disjoint [i * layer_counts_sum_, (i + 1) *
+  // layer_counts_sum_) slice of the outputs and only reads the shared,
+  // immutable tree and layer-id tables, so the instances are sampled in
+  // parallel. The shared samplers in sampler_vec_ are not used here: their
+  // engine is a single contended mt19937_64, so each instance draws its
+  // negatives from a private engine seeded with seed_ + i, which also keeps
+  // the result deterministic regardless of the number of threads.
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+  for (int64_t i = 0; i < static_cast<int64_t>(input_num); i++) {
+    std::mt19937_64 rng(seed_ + i);
+    auto& travel_path = travel_paths[i];
+    size_t idx = i * layer_counts_sum_;
     for (size_t j = 0; j < travel_path.size(); j++) {
       // user
       if (j > 0 && with_hierarchy) {
@@ -55,10 +76,12 @@ std::vector<std::vector<uint64_t>> LayerWiseSampler::sample(
       outputs[idx][user_feature_num] = travel_path[j].id();
       outputs[idx][user_feature_num + 1] = 1.0;
       idx += 1;
+      std::uniform_int_distribution<int64_t> dist(
+          0, static_cast<int64_t>(layer_ids_[j].size()) - 1);
       for (int idx_offset = 0; idx_offset < layer_counts_[j]; idx_offset++) {
-        int sample_res = 0;
+        int64_t sample_res = 0;
         do {
-          sample_res = sampler_vec_[j]->Sample();
+          sample_res = dist(rng);
         } while (layer_ids_[j][sample_res].id() == travel_path[j].id());
         outputs[idx + idx_offset][user_feature_num] =
             layer_ids_[j][sample_res].id();
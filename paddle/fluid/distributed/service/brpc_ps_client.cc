@@ -12,10 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>  // NOLINT
 #include <memory>
 #include <sstream>
 #include <string>
 
+#include "paddle/fluid/distributed/common/dense_compress.h"
 #include "paddle/fluid/distributed/service/brpc_ps_client.h"
 #include "paddle/fluid/framework/archive.h"
 
@@ -52,6 +54,11 @@ DEFINE_int32(pserver_connect_timeout_ms, 10000,
 
 DEFINE_int32(pserver_sparse_merge_thread, 1, "pserver sparse merge thread num");
 
+DEFINE_int32(pserver_pull_sparse_merge_window_us, 0,
+             "merge concurrent pull_sparse requests of one table within this "
+             "time window and deduplicate their keys before the rpc burst, "
+             "0 means no merging");
+
 namespace paddle {
 namespace framework {
 class Scope;
@@ -184,11 +191,26 @@ int32_t BrpcPsClient::initialize() {
   // 启动client探听接口, 并相互建立连接
   start_client_service();
 
+  const auto &work_param = _config.server_param().downpour_server_param();
+  for (size_t i = 0; i < work_param.downpour_table_param_size(); ++i) {
+    const auto &table_param = work_param.downpour_table_param(i);
+    _dense_compress_types[table_param.table_id()] =
+        table_param.dense_value_compress();
+  }
+
   _running = true;
   _flushing = false;
   return 0;
 }
 
+int BrpcPsClient::dense_compress_type(size_t table_id) {
+  auto itr = _dense_compress_types.find(table_id);
+  if (itr == _dense_compress_types.end()) {
+    return DENSE_COMPRESS_NONE;
+  }
+  return itr->second;
+}
+
 int DownpourBrpcClosure::check_response(size_t request_idx, int cmd_id) {
   if (_cntls[request_idx]->Failed()) {
     LOG(ERROR) << "resquest cmd_id:" << cmd_id << " failed, "
@@ -393,6 +415,10 @@ std::future<int32_t> BrpcPsClient::flush() {
 void BrpcPsClient::finalize_worker() {
   flush();
   _running = false;
+  _sparse_pull_merge_cv.notify_all();
+  if (_sparse_pull_merge_thread.joinable()) {
+    _sparse_pull_merge_thread.join();
+  }
   _server.Stop(1000);
   _server.Join();
 }
@@ -507,15 +533,25 @@ std::future<int32_t> BrpcPsClient::pull_dense(Region *regions,
   size_t request_call_num = _server_channels.size();
   uint32_t num_per_shard =
       dense_dim_per_shard(accessor->fea_dim(), request_call_num);
+  int compress = dense_compress_type(table_id);
   // callback 将各shard结果，顺序填入region
   DownpourBrpcClosure *closure = new DownpourBrpcClosure(
       request_call_num, [request_call_num, num_per_shard, regions, region_num,
-                         accessor](void *done) {
+                         accessor, compress](void *done) {
         int ret = 0;
         size_t region_idx = 0;       // 当前填充的region偏移
         size_t region_data_idx = 0;  // 当前填充的region内data偏移
         auto *closure = (DownpourBrpcClosure *)done;
         size_t shard_data_size = num_per_shard * accessor->select_size();
+        size_t shard_float_num = shard_data_size / sizeof(float);
+        size_t shard_wire_size = shard_data_size;
+        if (compress == DENSE_COMPRESS_INT16) {
+          shard_wire_size = DenseCompressedSize<int16_t>(shard_float_num);
+        } else if (compress == DENSE_COMPRESS_INT8) {
+          shard_wire_size = DenseCompressedSize<int8_t>(shard_float_num);
+        }
+        std::vector<char> wire_buffer;
+        std::vector<float> decompress_buffer;
         for (size_t i = 0; i < request_call_num; ++i) {
           if (closure->check_response(i, PS_PULL_DENSE_TABLE) != 0) {
             ret = -1;
@@ -525,19 +561,43 @@ std::future<int32_t> BrpcPsClient::pull_dense(Region *regions,
 
           butil::IOBufBytesIterator io_buffer_itr(res_io_buffer);
           size_t shard_buffer_remain = res_io_buffer.size();
-          if (shard_buffer_remain != shard_data_size) {
-            LOG(ERROR) << "expect res_size:" << shard_data_size
+          if (shard_buffer_remain != shard_wire_size) {
+            LOG(ERROR) << "expect res_size:" << shard_wire_size
                        << ", but size:" << shard_buffer_remain
                        << ", ignore this response";
             ret = -1;
             break;
           }
+          const char *shard_data = nullptr;
+          if (compress != DENSE_COMPRESS_NONE) {
+            // 解压后再按region切分
+            wire_buffer.resize(shard_wire_size);
+            io_buffer_itr.copy_and_forward((void *)wire_buffer.data(),
+                                           shard_wire_size);
+            decompress_buffer.resize(shard_float_num);
+            if (compress == DENSE_COMPRESS_INT16) {
+              DenseDecompress<int16_t>(wire_buffer.data(), shard_float_num,
+                                       decompress_buffer.data());
+            } else {
+              DenseDecompress<int8_t>(wire_buffer.data(), shard_float_num,
+                                      decompress_buffer.data());
+            }
+            shard_data = (const char *)decompress_buffer.data();
+            shard_buffer_remain = shard_data_size;
+          }
           while (shard_buffer_remain > 0 && region_idx < region_num) {
             auto &region = regions[region_idx];
             if (region.size - region_data_idx >= shard_buffer_remain) {
               // region待填充空间 >= 分片buffer数据, 直接拷贝置入
-              io_buffer_itr.copy_and_forward(
-                  (void *)(region.data + region_data_idx), shard_buffer_remain);
+              if (shard_data != nullptr) {
+                memcpy((void *)(region.data + region_data_idx), shard_data,
+                       shard_buffer_remain);
+                shard_data += shard_buffer_remain;
+              } else {
+                io_buffer_itr.copy_and_forward(
+                    (void *)(region.data + region_data_idx),
+                    shard_buffer_remain);
+              }
               region_data_idx += shard_buffer_remain;
               shard_buffer_remain = 0;
             } else if (region.size - region_data_idx == 0) {
@@ -546,9 +606,15 @@ std::future<int32_t> BrpcPsClient::pull_dense(Region *regions,
               region_data_idx = 0;
             } else {
               // region不足以容纳所有数据，则能放多少 拷贝多少
-              io_buffer_itr.copy_and_forward(
-                  (void *)(region.data + region_data_idx),
-                  region.size - region_data_idx);
+              if (shard_data != nullptr) {
+                memcpy((void *)(region.data + region_data_idx), shard_data,
+                       region.size - region_data_idx);
+                shard_data += region.size - region_data_idx;
+              } else {
+                io_buffer_itr.copy_and_forward(
+                    (void *)(region.data + region_data_idx),
+                    region.size - region_data_idx);
+              }
               shard_buffer_remain -= (region.size - region_data_idx);
               ++region_idx;
               region_data_idx = 0;
@@ -715,17 +781,38 @@ std::future<int32_t> BrpcPsClient::push_dense_raw_gradient(
   auto *accessor = table_accessor(table_id);
   uint32_t num_per_shard =
       dense_dim_per_shard(accessor->fea_dim(), request_call_num);
+  int compress = dense_compress_type(table_id);
   for (size_t i = 0; i < request_call_num; ++i) {
     closure->request(i)->set_cmd_id(PS_PUSH_DENSE_TABLE);
     closure->request(i)->set_table_id(table_id);
     closure->request(i)->set_client_id(_client_id);
     auto *push_data = closure->request(i)->mutable_data();
     push_data->clear();
-    push_data->resize(sizeof(uint32_t) + num_per_shard * sizeof(float));
-    char *push_data_ptr = const_cast<char *>(push_data->data());
-    memcpy(push_data_ptr, &num_per_shard, sizeof(uint32_t));
-    memcpy(push_data_ptr + sizeof(uint32_t),
-           total_send_data + i * num_per_shard, num_per_shard * sizeof(float));
+    if (compress == DENSE_COMPRESS_NONE) {
+      push_data->resize(sizeof(uint32_t) + num_per_shard * sizeof(float));
+      char *push_data_ptr = const_cast<char *>(push_data->data());
+      memcpy(push_data_ptr, &num_per_shard, sizeof(uint32_t));
+      memcpy(push_data_ptr + sizeof(uint32_t),
+             total_send_data + i * num_per_shard,
+             num_per_shard * sizeof(float));
+    } else {
+      size_t compressed_size =
+          compress == DENSE_COMPRESS_INT16
+              ? DenseCompressedSize<int16_t>(num_per_shard)
+              : DenseCompressedSize<int8_t>(num_per_shard);
+      push_data->resize(sizeof(uint32_t) + compressed_size);
+      char *push_data_ptr = const_cast<char *>(push_data->data());
+      memcpy(push_data_ptr, &num_per_shard, sizeof(uint32_t));
+      if (compress == DENSE_COMPRESS_INT16) {
+        DenseCompress<int16_t>(total_send_data + i * num_per_shard,
+                               num_per_shard,
+                               push_data_ptr + sizeof(uint32_t));
+      } else {
+        DenseCompress<int8_t>(total_send_data + i * num_per_shard,
+                              num_per_shard,
+                              push_data_ptr + sizeof(uint32_t));
+      }
+    }
     VLOG(1) << "push_dense_raw_gradient finish memcpy";
     // closure->cntl(i)->set_request_compress_type(
     //     (brpc::CompressType)FLAGS_pserver_communicate_compress_type);
@@ -770,6 +857,94 @@ std::future<int32_t> BrpcPsClient::pull_sparse(float **select_values,
                                                size_t table_id,
                                                const uint64_t *keys, size_t num,
                                                bool is_training) {
+  if (FLAGS_pserver_pull_sparse_merge_window_us <= 0) {
+    return pull_sparse_impl(select_values, table_id, keys, num, is_training);
+  }
+  SparsePullTask task;
+  task.select_values = select_values;
+  task.keys = keys;
+  task.num = num;
+  task.is_training = is_training;
+  task.promise = std::make_shared<std::promise<int32_t>>();
+  std::future<int32_t> fut = task.promise->get_future();
+  {
+    std::lock_guard<std::mutex> lock(_sparse_pull_merge_mutex);
+    if (!_sparse_pull_merge_thread.joinable()) {
+      _sparse_pull_merge_thread =
+          std::thread(&BrpcPsClient::sparse_pull_merge_thread_func, this);
+    }
+    _sparse_pull_tasks[table_id].emplace_back(std::move(task));
+  }
+  _sparse_pull_merge_cv.notify_all();
+  return fut;
+}
+
+void BrpcPsClient::sparse_pull_merge_thread_func() {
+  while (_running) {
+    std::unique_lock<std::mutex> lock(_sparse_pull_merge_mutex);
+    _sparse_pull_merge_cv.wait_for(
+        lock, std::chrono::milliseconds(10),
+        [this] { return !_sparse_pull_tasks.empty() || !_running; });
+    if (_sparse_pull_tasks.empty()) {
+      continue;
+    }
+    lock.unlock();
+    // let the window fill with the pulls of the other ops of this step
+    usleep(FLAGS_pserver_pull_sparse_merge_window_us);
+    lock.lock();
+    auto tasks = std::move(_sparse_pull_tasks);
+    _sparse_pull_tasks.clear();
+    lock.unlock();
+    for (auto &table_tasks : tasks) {
+      flush_sparse_pull_tasks(table_tasks.first, &table_tasks.second);
+    }
+  }
+  // drain whatever arrived after _running went false
+  std::unique_lock<std::mutex> lock(_sparse_pull_merge_mutex);
+  auto tasks = std::move(_sparse_pull_tasks);
+  _sparse_pull_tasks.clear();
+  lock.unlock();
+  for (auto &table_tasks : tasks) {
+    flush_sparse_pull_tasks(table_tasks.first, &table_tasks.second);
+  }
+}
+
+void BrpcPsClient::flush_sparse_pull_tasks(size_t table_id,
+                                           std::vector<SparsePullTask> *tasks) {
+  size_t total_num = 0;
+  bool is_training = false;
+  for (auto &task : *tasks) {
+    total_num += task.num;
+    is_training = is_training || task.is_training;
+  }
+  std::vector<uint64_t> merged_keys;
+  std::vector<float *> merged_values;
+  merged_keys.reserve(total_num);
+  merged_values.reserve(total_num);
+  for (auto &task : *tasks) {
+    merged_keys.insert(merged_keys.end(), task.keys, task.keys + task.num);
+    merged_values.insert(merged_values.end(), task.select_values,
+                         task.select_values + task.num);
+  }
+  VLOG(3) << "merged " << tasks->size() << " pull_sparse requests with "
+          << total_num << " keys for table " << table_id;
+  // pull_sparse_impl sorts the merged keys per shard, sends every key
+  // once and scatters the value to each destination pointer, so the
+  // deduplication across the merged ops comes from the existing path
+  auto fut = pull_sparse_impl(merged_values.data(), table_id,
+                              merged_keys.data(), merged_keys.size(),
+                              is_training);
+  int32_t ret = fut.get();
+  for (auto &task : *tasks) {
+    task.promise->set_value(ret);
+  }
+}
+
+std::future<int32_t> BrpcPsClient::pull_sparse_impl(float **select_values,
+                                                    size_t table_id,
+                                                    const uint64_t *keys,
+                                                    size_t num,
+                                                    bool is_training) {
   size_t request_call_num = _server_channels.size();
 
   auto shard_sorted_kvs = std::make_shared<
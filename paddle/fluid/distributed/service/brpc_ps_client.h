@@ -14,8 +14,13 @@
 
 #pragma once
 
+#include <condition_variable>  // NOLINT
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
+#include <thread>  // NOLINT
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "brpc/channel.h"
@@ -227,6 +232,37 @@ class BrpcPsClient : public PSClient {
  private:
   int32_t start_client_service();
 
+  // Client side pull_sparse coalescing, enabled by
+  // FLAGS_pserver_pull_sparse_merge_window_us: concurrent pull_sparse
+  // calls of one table are merged within the window into a single
+  // request, so keys pulled by several embedding ops of the same batch
+  // go over the wire once and the responses are scattered back to every
+  // destination pointer.
+  struct SparsePullTask {
+    float **select_values;
+    const uint64_t *keys;
+    size_t num;
+    bool is_training;
+    std::shared_ptr<std::promise<int32_t>> promise;
+  };
+
+  std::future<int32_t> pull_sparse_impl(float **select_values, size_t table_id,
+                                        const uint64_t *keys, size_t num,
+                                        bool is_training);
+  void sparse_pull_merge_thread_func();
+  void flush_sparse_pull_tasks(size_t table_id,
+                               std::vector<SparsePullTask> *tasks);
+
+  std::unordered_map<size_t, std::vector<SparsePullTask>> _sparse_pull_tasks;
+  std::mutex _sparse_pull_merge_mutex;
+  std::condition_variable _sparse_pull_merge_cv;
+  std::thread _sparse_pull_merge_thread;
+
+  // per-table dense wire compression from the table config, filled once
+  // at initialize; the server reads the same config, so both ends agree
+  int dense_compress_type(size_t table_id);
+  std::unordered_map<size_t, int> _dense_compress_types;
+
   float _mae = 0;
   float _mse = 0;
   uint16_t _push_times = 0;
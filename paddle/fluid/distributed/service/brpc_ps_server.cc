@@ -15,6 +15,7 @@
 #include "paddle/fluid/distributed/service/brpc_ps_server.h"
 #include <thread>  // NOLINT
 #include "butil/object_pool.h"
+#include "paddle/fluid/distributed/common/dense_compress.h"
 #include "paddle/fluid/distributed/table/depends/sparse_utils.h"
 #include "paddle/fluid/distributed/table/table.h"
 #include "paddle/fluid/framework/archive.h"
@@ -201,8 +202,27 @@ int32_t BrpcPsService::pull_dense(Table *table, const PsRequestMessage &request,
   res_data->resize(num * table->value_accesor()->select_size() / sizeof(float));
   table->pull_dense(res_data->data(), num);
 
-  cntl->response_attachment().append((char *)(res_data->data()),
-                                     res_data->size() * sizeof(float));
+  auto compress = table->config().dense_value_compress();
+  if (compress == DENSE_COMPRESS_NONE) {
+    cntl->response_attachment().append((char *)(res_data->data()),
+                                       res_data->size() * sizeof(float));
+  } else {
+    thread_local std::vector<char> compress_buffer;
+    size_t compressed_size =
+        compress == DENSE_COMPRESS_INT16
+            ? DenseCompressedSize<int16_t>(res_data->size())
+            : DenseCompressedSize<int8_t>(res_data->size());
+    compress_buffer.resize(compressed_size);
+    if (compress == DENSE_COMPRESS_INT16) {
+      DenseCompress<int16_t>(res_data->data(), res_data->size(),
+                             compress_buffer.data());
+    } else {
+      DenseCompress<int8_t>(res_data->data(), res_data->size(),
+                            compress_buffer.data());
+    }
+    cntl->response_attachment().append(compress_buffer.data(),
+                                       compressed_size);
+  }
   butil::return_object(res_data);
 
   return 0;
@@ -254,6 +274,20 @@ int32_t BrpcPsService::push_dense(Table *table, const PsRequestMessage &request,
   uint32_t num = *(const uint32_t *)(request.data().data());
   const float *values =
       (const float *)(request.data().data() + sizeof(uint32_t));
+
+  auto compress = table->config().dense_value_compress();
+  if (compress != DENSE_COMPRESS_NONE) {
+    thread_local std::vector<float> decompress_buffer;
+    decompress_buffer.resize(num);
+    const char *src = request.data().data() + sizeof(uint32_t);
+    if (compress == DENSE_COMPRESS_INT16) {
+      DenseDecompress<int16_t>(src, num, decompress_buffer.data());
+    } else {
+      DenseDecompress<int8_t>(src, num, decompress_buffer.data());
+    }
+    values = decompress_buffer.data();
+  }
+
   if (table->push_dense(values, num) != 0) {
     set_response_code(response, -1, "push_dense failed");
   }
@@ -15,6 +15,9 @@ limitations under the License. */
 #include "paddle/fluid/distributed/service/brpc_utils.h"
 #include <arpa/inet.h>
 #include <netdb.h>
+#include <mutex>  // NOLINT
+#include <unordered_map>
+#include "paddle/fluid/memory/malloc.h"
 #include "paddle/fluid/platform/enforce.h"
 
 namespace paddle {
@@ -27,6 +30,71 @@ class LoDTensor;
 namespace paddle {
 namespace distributed {
 
+// Deleter for iobuf blocks that only borrow tensor memory owned by the
+// caller's scope; nothing is freed here.
+static void IOBufBorrowedPayloadDeleter(void* data) {}
+
+#ifdef PADDLE_WITH_CUDA
+namespace {
+
+// Pool of reusable pinned host staging buffers for the cuda tensor
+// serialize/deserialize paths. Pinned pages make the device copy a real
+// DMA and are registered with the driver once instead of on every RPC.
+// A buffer leased to an iobuf comes back through the deleter once brpc
+// has flushed the payload.
+class PinnedStagingPool {
+ public:
+  static PinnedStagingPool& Instance() {
+    static PinnedStagingPool pool;
+    return pool;
+  }
+
+  char* Acquire(size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = free_.begin(); it != free_.end(); ++it) {
+      if ((*it)->size() >= size) {
+        auto block = std::move(*it);
+        free_.erase(it);
+        char* ptr = reinterpret_cast<char*>(block->ptr());
+        leased_.emplace(ptr, std::move(block));
+        return ptr;
+      }
+    }
+    auto block = memory::Alloc(platform::CUDAPinnedPlace(), size);
+    char* ptr = reinterpret_cast<char*>(block->ptr());
+    leased_.emplace(ptr, std::move(block));
+    return ptr;
+  }
+
+  void Release(void* ptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = leased_.find(ptr);
+    if (it == leased_.end()) {
+      return;
+    }
+    // Cap the ring so a one-off huge tensor does not pin memory forever.
+    if (free_.size() < kMaxFreeBlocks) {
+      free_.push_back(std::move(it->second));
+    }
+    leased_.erase(it);
+  }
+
+ private:
+  static constexpr size_t kMaxFreeBlocks = 8;
+  std::mutex mutex_;
+  std::vector<memory::AllocationPtr> free_;
+  std::unordered_map<void*, memory::AllocationPtr> leased_;
+};
+
+}  // namespace
+
+// Deleter for iobuf blocks staging cuda tensors; the pinned buffer goes
+// back to the pool for the next RPC.
+static void IOBufPinnedPayloadDeleter(void* data) {
+  PinnedStagingPool::Instance().Release(data);
+}
+#endif
+
 framework::proto::VarType::Type VarMessageToVarType(
     VariableMessage::Type type) {
   switch (type) {
@@ -51,7 +119,7 @@ void SerializeToMultiVarMsgAndIOBuf(
     const std::vector<std::string>& send_var_name_val,
     const std::vector<std::string>& recv_var_name_val,
     const platform::DeviceContext& ctx, const framework::Scope* scope,
-    MultiVarMsg* request, butil::IOBuf* iobuf) {
+    MultiVarMsg* request, butil::IOBuf* iobuf, bool zero_copy_payload) {
   // 1. message_name
   request->set_message_name(message_name);
 
@@ -72,9 +140,11 @@ void SerializeToMultiVarMsgAndIOBuf(
     framework::Variable* var = scope->FindVar(send_var_name);
 
     if (var->IsType<framework::LoDTensor>()) {
-      SerializeLodTensor(var, ctx, send_var_msg, &temp_iobuf);
+      SerializeLodTensor(var, ctx, send_var_msg, &temp_iobuf,
+                         zero_copy_payload);
     } else if (var->IsType<framework::SelectedRows>()) {
-      SerializeSelectedRows(var, ctx, send_var_msg, &temp_iobuf);
+      SerializeSelectedRows(var, ctx, send_var_msg, &temp_iobuf,
+                            zero_copy_payload);
     }
     iobuf->append(temp_iobuf);
   }
@@ -82,7 +152,7 @@ void SerializeToMultiVarMsgAndIOBuf(
 
 void SerializeLodTensor(framework::Variable* var,
                         const platform::DeviceContext& ctx, VarMsg* var_msg,
-                        butil::IOBuf* iobuf) {
+                        butil::IOBuf* iobuf, bool zero_copy_payload) {
   auto* tensor = var->GetMutable<framework::LoDTensor>();
   var_msg->set_type(::paddle::distributed::LOD_TENSOR);
   const framework::LoD lod = tensor->lod();
@@ -103,30 +173,36 @@ void SerializeLodTensor(framework::Variable* var,
   if (platform::is_cpu_place(tensor->place())) {
     auto data_len = tensor->numel() * framework::SizeOfType(tensor->type());
     iobuf->append(reinterpret_cast<const char*>(&data_len), 8);
-    iobuf->append(reinterpret_cast<const char*>(tensor->data<void>()),
-                  data_len);
+    if (zero_copy_payload && data_len > 0) {
+      iobuf->append_user_data(tensor->data<void>(), data_len,
+                              IOBufBorrowedPayloadDeleter);
+    } else {
+      iobuf->append(reinterpret_cast<const char*>(tensor->data<void>()),
+                    data_len);
+    }
   } else {
 #ifdef PADDLE_WITH_CUDA
-    char* temp_ptr =
-        new char[tensor->numel() * framework::SizeOfType(tensor->type())];
-    auto stream =
-        reinterpret_cast<const platform::CUDADeviceContext&>(ctx).stream();
-    memory::Copy(platform::CPUPlace(), temp_ptr,
-                 BOOST_GET_CONST(platform::CUDAPlace, tensor->place()),
-                 tensor->data<void>(),
-                 tensor->numel() * framework::SizeOfType(tensor->type()),
-                 stream);
     auto data_len = tensor->numel() * framework::SizeOfType(tensor->type());
     iobuf->append(reinterpret_cast<const char*>(&data_len), 8);
-    iobuf->append(reinterpret_cast<const char*>(temp_ptr), data_len);
-    delete[] temp_ptr;
+    if (data_len > 0) {
+      // Stage through a pooled pinned buffer and lease it to the iobuf
+      // instead of copying a second time; the deleter returns it to the
+      // pool once the data is sent.
+      char* temp_ptr = PinnedStagingPool::Instance().Acquire(data_len);
+      auto stream =
+          reinterpret_cast<const platform::CUDADeviceContext&>(ctx).stream();
+      memory::Copy(platform::CPUPlace(), temp_ptr,
+                   BOOST_GET_CONST(platform::CUDAPlace, tensor->place()),
+                   tensor->data<void>(), data_len, stream);
+      iobuf->append_user_data(temp_ptr, data_len, IOBufPinnedPayloadDeleter);
+    }
 #endif
   }
 }
 
 void SerializeSelectedRows(framework::Variable* var,
                            const platform::DeviceContext& ctx, VarMsg* var_msg,
-                           butil::IOBuf* iobuf) {
+                           butil::IOBuf* iobuf, bool zero_copy_payload) {
   framework::SelectedRows* slr = var->GetMutable<framework::SelectedRows>();
   auto* tensor = slr->mutable_value();
   auto* rows = slr->mutable_rows();
@@ -147,23 +223,27 @@ void SerializeSelectedRows(framework::Variable* var,
   if (platform::is_cpu_place(tensor->place())) {
     auto data_len = tensor->numel() * framework::SizeOfType(tensor->type());
     iobuf->append(reinterpret_cast<const char*>(&data_len), 8);
-    iobuf->append(reinterpret_cast<const char*>(tensor->data<void>()),
-                  data_len);
+    if (zero_copy_payload && data_len > 0) {
+      iobuf->append_user_data(tensor->data<void>(), data_len,
+                              IOBufBorrowedPayloadDeleter);
+    } else {
+      iobuf->append(reinterpret_cast<const char*>(tensor->data<void>()),
+                    data_len);
+    }
   } else {
 #ifdef PADDLE_WITH_CUDA
-    char* temp_ptr =
-        new char[tensor->numel() * framework::SizeOfType(tensor->type())];
-    auto stream =
-        reinterpret_cast<const platform::CUDADeviceContext&>(ctx).stream();
-    memory::Copy(platform::CPUPlace(), temp_ptr,
-                 BOOST_GET_CONST(platform::CUDAPlace, tensor->place()),
-                 tensor->data<void>(),
-                 tensor->numel() * framework::SizeOfType(tensor->type()),
-                 stream);
     auto data_len = tensor->numel() * framework::SizeOfType(tensor->type());
     iobuf->append(reinterpret_cast<const char*>(&data_len), 8);
-    iobuf->append(reinterpret_cast<const char*>(temp_ptr), data_len);
-    delete[] temp_ptr;
+    if (data_len > 0) {
+      // Same pinned-staging handover as in SerializeLodTensor.
+      char* temp_ptr = PinnedStagingPool::Instance().Acquire(data_len);
+      auto stream =
+          reinterpret_cast<const platform::CUDADeviceContext&>(ctx).stream();
+      memory::Copy(platform::CPUPlace(), temp_ptr,
+                   BOOST_GET_CONST(platform::CUDAPlace, tensor->place()),
+                   tensor->data<void>(), data_len, stream);
+      iobuf->append_user_data(temp_ptr, data_len, IOBufPinnedPayloadDeleter);
+    }
 #endif
   }
 }
@@ -239,8 +319,8 @@ void DeserializeLodTensor(framework::Variable* var, const VarMsg& msg,
   } else if (platform::is_gpu_place(place)) {
 #ifdef PADDLE_WITH_CUDA
     unsigned long data_len;
-    char* temp_ptr =
-        new char[tensor->numel() * framework::SizeOfType(tensor->type())];
+    char* temp_ptr = PinnedStagingPool::Instance().Acquire(
+        tensor->numel() * framework::SizeOfType(tensor->type()));
     io_buffer_itr.copy_and_forward((void*)(&data_len), 8);
     io_buffer_itr.copy_and_forward((void*)temp_ptr, data_len);
     auto stream =
@@ -249,7 +329,7 @@ void DeserializeLodTensor(framework::Variable* var, const VarMsg& msg,
                  platform::CPUPlace(), (void*)temp_ptr,
                  tensor->numel() * framework::SizeOfType(tensor->type()),
                  stream);
-    delete[] temp_ptr;
+    PinnedStagingPool::Instance().Release(temp_ptr);
 #endif
   }
 }
@@ -278,8 +358,8 @@ void DeserializeSelectedRows(framework::Variable* var, const VarMsg& msg,
     io_buffer_itr.copy_and_forward(tensor_data, data_len);
   } else if (platform::is_gpu_place(place)) {
 #ifdef PADDLE_WITH_CUDA
-    char* temp_ptr =
-        new char[tensor->numel() * framework::SizeOfType(tensor->type())];
+    char* temp_ptr = PinnedStagingPool::Instance().Acquire(
+        tensor->numel() * framework::SizeOfType(tensor->type()));
     unsigned long data_len;
     io_buffer_itr.copy_and_forward((void*)(&data_len), 8);
     io_buffer_itr.copy_and_forward(temp_ptr, data_len);
@@ -289,7 +369,7 @@ void DeserializeSelectedRows(framework::Variable* var, const VarMsg& msg,
                  platform::CPUPlace(), temp_ptr,
                  tensor->numel() * framework::SizeOfType(tensor->type()),
                  stream);
-    delete[] temp_ptr;
+    PinnedStagingPool::Instance().Release(temp_ptr);
 #endif
   }
 }
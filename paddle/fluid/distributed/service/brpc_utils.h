@@ -53,20 +53,27 @@ namespace distributed {
 using MultiVarMsg = ::paddle::distributed::MultiVariableMessage;
 using VarMsg = ::paddle::distributed::VariableMessage;
 
+// When zero_copy_payload is true, cpu tensor data is attached to the iobuf
+// as zero-copy blocks instead of being copied into it, so the caller must
+// keep the scope (and the tensors it holds) alive until the iobuf has been
+// fully written out, e.g. until the rpc carrying it completes. The server
+// side deletes its local scope right after serializing the response, so
+// only the client request path may enable it.
 void SerializeToMultiVarMsgAndIOBuf(
     const std::string& message_name,
     const std::vector<std::string>& send_var_name_val,
     const std::vector<std::string>& recv_var_name_val,
     const platform::DeviceContext& ctx, const framework::Scope* scope,
-    MultiVarMsg* var_msg, butil::IOBuf* iobuf);
+    MultiVarMsg* var_msg, butil::IOBuf* iobuf,
+    bool zero_copy_payload = false);
 
 void SerializeLodTensor(framework::Variable* var,
                         const platform::DeviceContext& ctx, VarMsg* var_msg,
-                        butil::IOBuf* iobuf);
+                        butil::IOBuf* iobuf, bool zero_copy_payload = false);
 
 void SerializeSelectedRows(framework::Variable* var,
                            const platform::DeviceContext& ctx, VarMsg* request,
-                           butil::IOBuf* iobuf);
+                           butil::IOBuf* iobuf, bool zero_copy_payload = false);
 
 // Deserialize for Server
 void DeserializeFromMultiVarMsgAndIOBuf(const MultiVarMsg& multi_msg,
@@ -466,7 +466,11 @@ void AsyncCommunicator::SendByCommunicator() {
       vars.resize(var_nums);
       int merged_var_num = 0;
       int wait_times = 0;
-      while (merged_var_num < max_merge_var_num_) {
+      auto cycle_start = GetCurrentUS();
+      int merge_limit = adaptive_merge_
+                            ? adaptive_merge_num_.load(std::memory_order_relaxed)
+                            : max_merge_var_num_;
+      while (merged_var_num < merge_limit) {
         if (check_queue->Size() == 0) {
           VLOG(4) << "wait_times -> " << wait_times;
           if (wait_times >= send_wait_times_) {
@@ -496,6 +500,7 @@ void AsyncCommunicator::SendByCommunicator() {
         }
       }
 
+      auto rpc_start = GetCurrentUS();
       if (ctx.is_tensor_table) {
         SendGlobalStep(ctx, merged_var_num, send_scope_.get());
       } else if (ctx.is_sparse) {
@@ -512,6 +517,11 @@ void AsyncCommunicator::SendByCommunicator() {
           RpcRecvDense(recv_varnames, table_id, recv_scope_);
         }
       }
+      if (adaptive_merge_) {
+        auto cycle_end = GetCurrentUS();
+        UpdateAdaptiveMerge(check_queue->Size(), cycle_end - rpc_start,
+                            cycle_end - cycle_start, merged_var_num);
+      }
       if (independent_recv_) {
         grad_num_.fetch_add(1, std::memory_order_relaxed);
       }
@@ -524,6 +534,41 @@ void AsyncCommunicator::SendByCommunicator() {
   return;
 }
 
+void AsyncCommunicator::UpdateAdaptiveMerge(size_t queue_depth, double rpc_us,
+                                            double cycle_us,
+                                            int merged_var_num) {
+  send_rounds_.fetch_add(1, std::memory_order_relaxed);
+  merged_grad_num_.fetch_add(merged_var_num, std::memory_order_relaxed);
+  send_rpc_us_.fetch_add(static_cast<int64_t>(rpc_us),
+                         std::memory_order_relaxed);
+
+  // utilization is the share of the send round spent waiting on the PS;
+  // above target (or with a growing backlog) merge more batches per
+  // request, well below target with a drained queue send fresher
+  // updates instead
+  double utilization = cycle_us > 0 ? rpc_us / cycle_us : 0.0;
+  int window = adaptive_merge_num_.load(std::memory_order_relaxed);
+  if (utilization > adaptive_target_util_ ||
+      queue_depth > static_cast<size_t>(window)) {
+    window = std::min(window + 1, max_merge_var_num_);
+  } else if (utilization < adaptive_target_util_ / 2 && queue_depth == 0) {
+    window = std::max(window - 1, 1);
+  }
+  adaptive_merge_num_.store(window, std::memory_order_relaxed);
+
+  auto rounds = send_rounds_.load(std::memory_order_relaxed);
+  if (rounds % 200 == 0) {
+    auto merged = merged_grad_num_.load(std::memory_order_relaxed);
+    auto rpc_total_us = send_rpc_us_.load(std::memory_order_relaxed);
+    VLOG(1) << "Communicator adaptive merge: window " << window
+            << ", merge ratio "
+            << static_cast<double>(merged) / static_cast<double>(rounds)
+            << ", avg rpc " << rpc_total_us / rounds / 1000.0
+            << " ms, queue depth " << queue_depth << ", utilization "
+            << utilization;
+  }
+}
+
 void AsyncCommunicator::MainThread() {
   VLOG(3) << "AsyncCommunicator MainThread start and wait";
 
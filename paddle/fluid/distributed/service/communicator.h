@@ -399,6 +399,15 @@ class AsyncCommunicator : public Communicator {
     send_queue_size_ = std::stoi(envs.at("communicator_send_queue_size"));
     need_global_step_ =
         static_cast<bool>(std::stoi(envs.at("need_global_step")));
+    if (envs.count("communicator_adaptive_merge")) {
+      adaptive_merge_ =
+          static_cast<bool>(std::stoi(envs.at("communicator_adaptive_merge")));
+    }
+    if (envs.count("communicator_adaptive_target_utilization")) {
+      adaptive_target_util_ =
+          std::stof(envs.at("communicator_adaptive_target_utilization"));
+    }
+    adaptive_merge_num_ = max_merge_var_num_;
   }
 
   void Start() override;
@@ -432,6 +441,12 @@ class AsyncCommunicator : public Communicator {
 
   virtual void BarrierWeakUp() {}
 
+  // Adjusts the adaptive merge window after a send round from the share
+  // of the round spent waiting on the PS and the send queue backlog,
+  // and accumulates the merge ratio metrics logged periodically.
+  virtual void UpdateAdaptiveMerge(size_t queue_depth, double rpc_us,
+                                   double cycle_us, int merged_var_num);
+
  protected:
   std::unordered_map<std::string,
                      std::shared_ptr<BlockingQueue<std::shared_ptr<Variable>>>>
@@ -447,6 +462,17 @@ class AsyncCommunicator : public Communicator {
   bool independent_recv_ = true;
   int parallel_task_nums_ = 0;
 
+  // adaptive send batching: when enabled the merge window follows the
+  // PS round trip latency and the send queue depth at runtime instead
+  // of always merging max_merge_var_num_ batches, staying within
+  // [1, max_merge_var_num_]
+  bool adaptive_merge_ = false;
+  float adaptive_target_util_ = 0.5;
+  std::atomic<int> adaptive_merge_num_{1};
+  std::atomic<int64_t> send_rounds_{0};
+  std::atomic<int64_t> merged_grad_num_{0};
+  std::atomic<int64_t> send_rpc_us_{0};
+
   std::unique_ptr<std::thread> main_thread_{nullptr};
   std::unique_ptr<std::thread> recv_thread_{nullptr};
 
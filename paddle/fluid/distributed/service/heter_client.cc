@@ -107,6 +107,23 @@ void HeterClient::SendAndRecvAsync(
     const std::vector<std::string>& send_var_name,
     const std::vector<std::string>& recv_var_name) {
   platform::RecordEvent record_event("HeterClient->SendAndRecvAsync");
+  auto fut = AsyncSendAndRecv(ep, ctx, scope, message_name, send_var_name,
+                              recv_var_name);
+  PADDLE_ENFORCE_EQ(
+      fut.get(), 0,
+      platform::errors::Unimplemented(
+          "HeterClient::SendAndRecv meets brpc error, see the error log of "
+          "message_name %s for the brpc error message",
+          message_name));
+  VLOG(4) << "call heter_worker success";
+}
+
+std::future<int32_t> HeterClient::AsyncSendAndRecv(
+    const std::vector<std::string>& ep, const platform::DeviceContext& ctx,
+    const framework::Scope& scope, const std::string& message_name,
+    const std::vector<std::string>& send_var_name,
+    const std::vector<std::string>& recv_var_name) {
+  platform::RecordEvent record_event("HeterClient->AsyncSendAndRecv");
   const platform::DeviceContext* p_ctx = &ctx;
   const framework::Scope* p_scope = &scope;
   const std::string message_name_val = message_name;
@@ -118,24 +135,35 @@ void HeterClient::SendAndRecvAsync(
   // Todo: get correct channel
   int num = trainer_id_ % xpu_channels_.size();
 
-  brpc::Controller cntl;
-  cntl.set_timeout_ms(FLAGS_pserver_timeout_ms);
-  distributed::MultiVarMsg request, response;
-  auto& request_io_buffer = cntl.request_attachment();
-  ::paddle::distributed::PsService_Stub stub(xpu_channels_[num].get());
+  auto promise = std::make_shared<std::promise<int32_t>>();
+  std::future<int32_t> fut = promise->get_future();
+  OnHeterRpcDone* closure = new OnHeterRpcDone([p_ctx, p_scope, message_name_val,
+                                                promise](void* done) {
+    auto* closure = reinterpret_cast<OnHeterRpcDone*>(done);
+    int32_t ret = 0;
+    if (closure->cntl.Failed()) {
+      ret = -1;
+      LOG(ERROR) << "HeterClient::SendAndRecv meets brpc error, message_name "
+                 << message_name_val << ", error message is "
+                 << closure->cntl.ErrorText();
+    } else {
+      auto& response_io_buffer = closure->cntl.response_attachment();
+      distributed::DeserializeFromMultiVarMsgAndIOBuf(
+          closure->response, &response_io_buffer, *p_ctx, p_scope);
+    }
+    promise->set_value(ret);
+  });
+  closure->cntl.set_timeout_ms(FLAGS_pserver_timeout_ms);
+
+  distributed::MultiVarMsg request;
+  auto& request_io_buffer = closure->cntl.request_attachment();
   distributed::SerializeToMultiVarMsgAndIOBuf(
       message_name_val, send_var_name_val, recv_var_name_val, *p_ctx, p_scope,
-      &request, &request_io_buffer);
-  stub.SendAndRecvVariable(&cntl, &request, &response, NULL);
-  PADDLE_ENFORCE_NE(
-      cntl.Failed(), true,
-      platform::errors::Unimplemented(
-          "HeterClient::SendAndRecv meets brpc error, error message is %s",
-          cntl.ErrorText()));
-  VLOG(4) << "call heter_worker success";
-  auto& response_io_buffer = cntl.response_attachment();
-  distributed::DeserializeFromMultiVarMsgAndIOBuf(response, &response_io_buffer,
-                                                  ctx, p_scope);
+      &request, &request_io_buffer, /* zero_copy_payload = */ true);
+  ::paddle::distributed::PsService_Stub stub(xpu_channels_[num].get());
+  stub.SendAndRecvVariable(&closure->cntl, &request, &closure->response,
+                           closure);
+  return fut;
 }
 
 std::future<int32_t> HeterClient::SendCmd(
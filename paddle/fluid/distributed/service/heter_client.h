@@ -76,6 +76,7 @@ class HeterClient {
 
   void CreateClient2XpuConnection();
 
+  // Blocks until the recv vars have been written back to scope.
   void SendAndRecvAsync(const std::vector<std::string>& ep,
                         const platform::DeviceContext& ctx,
                         const framework::Scope& scope,
@@ -83,6 +84,19 @@ class HeterClient {
                         const std::vector<std::string>& send_var_name,
                         const std::vector<std::string>& recv_var_name);
 
+  // Issues the exchange without waiting, so several micro-batch exchanges
+  // can be kept in flight and the transfer overlaps with compute on both
+  // sides. The send tensors are attached to the request as zero-copy iobuf
+  // blocks, so the scope must stay alive (and the send vars unchanged)
+  // until the returned future is ready; the recv vars have been written
+  // back to the scope by then. The future yields 0 on success, -1 on rpc
+  // failure.
+  std::future<int32_t> AsyncSendAndRecv(
+      const std::vector<std::string>& ep, const platform::DeviceContext& ctx,
+      const framework::Scope& scope, const std::string& message_name,
+      const std::vector<std::string>& send_var_name,
+      const std::vector<std::string>& recv_var_name);
+
   // HeterClient singleton
   static std::shared_ptr<HeterClient> GetInstance(
       const std::vector<std::string>& endpoint, const int& trainer_id) {
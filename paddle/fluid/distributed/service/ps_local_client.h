@@ -22,6 +22,15 @@ namespace distributed {
 
 class Table;
 
+// In-process client for colocated trainer/server deployments: every
+// call goes straight into Table with the caller's buffers, there is no
+// protobuf request/response and no serialization round trip.
+// Threading contract: calls execute synchronously on the calling
+// thread and the returned futures are already completed when they are
+// handed back; concurrent calls from several threads are safe because
+// the tables synchronize internally, but caller-owned key/value
+// buffers are only borrowed for the duration of the call and may be
+// reused as soon as it returns.
 class PsLocalClient : public PSClient {
  public:
   PsLocalClient() {}
@@ -65,13 +74,7 @@ class PsLocalClient : public PSClient {
   virtual ::std::future<int32_t> pull_sparse(float** select_values,
                                              size_t table_id,
                                              const uint64_t* keys, size_t num,
-                                             bool is_training) {
-    std::promise<int32_t> prom;
-    std::future<int32_t> fut = prom.get_future();
-    prom.set_value(0);
-
-    return fut;
-  }
+                                             bool is_training);
 
   virtual ::std::future<int32_t> pull_sparse_ptr(char** select_values,
                                                  size_t table_id,
@@ -24,9 +24,54 @@
 #include "paddle/fluid/string/printf.h"
 #include "paddle/fluid/string/string_helper.h"
 
+DEFINE_int32(pserver_graph_sample_cache_size, 0,
+             "total number of cached neighbor sample results per graph "
+             "table, split evenly over the task pool workers, 0 disables "
+             "the cache");
+DEFINE_int32(pserver_graph_sample_cache_ttl, 4,
+             "how many times one cached neighbor sample result may be "
+             "served before the node is resampled");
+
 namespace paddle {
 namespace distributed {
 
+bool SampleCache::get(uint64_t node_id, int sample_size, std::string *buffer) {
+  auto iter = index_.find(node_id);
+  if (iter == index_.end()) {
+    return false;
+  }
+  auto entry = iter->second;
+  if (entry->sample_size != sample_size || entry->remain <= 0) {
+    lru_.erase(entry);
+    index_.erase(iter);
+    return false;
+  }
+  --entry->remain;
+  *buffer = entry->buffer;
+  lru_.splice(lru_.begin(), lru_, entry);
+  return true;
+}
+
+void SampleCache::put(uint64_t node_id, int sample_size,
+                      const std::string &buffer) {
+  auto iter = index_.find(node_id);
+  if (iter != index_.end()) {
+    lru_.erase(iter->second);
+    index_.erase(iter);
+  }
+  if (lru_.size() >= capacity_) {
+    index_.erase(lru_.back().node_id);
+    lru_.pop_back();
+  }
+  lru_.push_front(Entry{node_id, sample_size, ttl_, buffer});
+  index_[node_id] = lru_.begin();
+}
+
+void SampleCache::clear() {
+  lru_.clear();
+  index_.clear();
+}
+
 std::vector<Node *> GraphShard::get_batch(int start, int end, int step) {
   if (start < 0) start = 0;
   std::vector<Node *> res;
@@ -54,6 +99,7 @@ int32_t GraphTable::add_graph_node(std::vector<uint64_t> &id_list,
   for (size_t i = 0; i < batch.size(); ++i) {
     if (!batch[i].size()) continue;
     tasks.push_back(_shards_task_pool[i]->enqueue([&batch, i, this]() -> int {
+      this->_sample_caches[i].clear();
       for (auto &p : batch[i]) {
         size_t index = p.first % this->shard_num - this->shard_start;
         this->shards[index].add_graph_node(p.first)->build_edges(p.second);
@@ -77,6 +123,7 @@ int32_t GraphTable::remove_graph_node(std::vector<uint64_t> &id_list) {
   for (size_t i = 0; i < batch.size(); ++i) {
     if (!batch[i].size()) continue;
     tasks.push_back(_shards_task_pool[i]->enqueue([&batch, i, this]() -> int {
+      this->_sample_caches[i].clear();
       for (auto &p : batch[i]) {
         size_t index = p % this->shard_num - this->shard_start;
         this->shards[index].delete_node(p);
@@ -292,6 +339,10 @@ int32_t GraphTable::load_edges(const std::string &path, bool reverse_edge) {
       bucket[i]->build_sampler(sample_type);
     }
   }
+  //边集变了，旧的采样结果全部失效
+  for (auto &cache : _sample_caches) {
+    cache.clear();
+  }
   return 0;
 }
 
@@ -319,6 +370,8 @@ int32_t GraphTable::clear_nodes() {
     tasks.push_back(
         _shards_task_pool[get_thread_pool_index_by_shard_index(i)]->enqueue(
             [this, i]() -> int {
+              this->_sample_caches[get_thread_pool_index_by_shard_index(i)]
+                  .clear();
               this->shards[i].clear();
               return 0;
             }));
@@ -406,30 +459,44 @@ int32_t GraphTable::random_sample_neighboors(
     int thread_pool_index = get_thread_pool_index(node_id);
     auto rng = _shards_task_rng_pool[thread_pool_index];
 
-    tasks.push_back(_shards_task_pool[thread_pool_index]->enqueue([&]() -> int {
-      Node *node = find_node(node_id);
+    tasks.push_back(_shards_task_pool[thread_pool_index]->enqueue(
+        [&, thread_pool_index]() -> int {
+          auto &cache = _sample_caches[thread_pool_index];
+          std::string cached;
+          if (cache.enabled() && cache.get(node_id, sample_size, &cached)) {
+            actual_size = cached.size();
+            char *buffer_addr = new char[actual_size];
+            buffer.reset(buffer_addr);
+            memcpy(buffer_addr, cached.data(), actual_size);
+            return 0;
+          }
+          Node *node = find_node(node_id);
 
-      if (node == nullptr) {
-        actual_size = 0;
-        return 0;
-      }
-      std::vector<int> res = node->sample_k(sample_size, rng);
-      actual_size = res.size() * (Node::id_size + Node::weight_size);
-      int offset = 0;
-      uint64_t id;
-      float weight;
-      char *buffer_addr = new char[actual_size];
-      buffer.reset(buffer_addr);
-      for (int &x : res) {
-        id = node->get_neighbor_id(x);
-        weight = node->get_neighbor_weight(x);
-        memcpy(buffer_addr + offset, &id, Node::id_size);
-        offset += Node::id_size;
-        memcpy(buffer_addr + offset, &weight, Node::weight_size);
-        offset += Node::weight_size;
-      }
-      return 0;
-    }));
+          if (node == nullptr) {
+            actual_size = 0;
+            return 0;
+          }
+          std::vector<int> res = node->sample_k(sample_size, rng);
+          actual_size = res.size() * (Node::id_size + Node::weight_size);
+          int offset = 0;
+          uint64_t id;
+          float weight;
+          char *buffer_addr = new char[actual_size];
+          buffer.reset(buffer_addr);
+          for (int &x : res) {
+            id = node->get_neighbor_id(x);
+            weight = node->get_neighbor_weight(x);
+            memcpy(buffer_addr + offset, &id, Node::id_size);
+            offset += Node::id_size;
+            memcpy(buffer_addr + offset, &weight, Node::weight_size);
+            offset += Node::weight_size;
+          }
+          if (cache.enabled()) {
+            cache.put(node_id, sample_size,
+                      std::string(buffer_addr, actual_size));
+          }
+          return 0;
+        }));
   }
   for (size_t idx = 0; idx < node_num; ++idx) {
     tasks[idx].get();
@@ -582,9 +649,15 @@ int32_t GraphTable::get_server_index_by_id(uint64_t id) {
 
 int32_t GraphTable::initialize() {
   _shards_task_pool.resize(task_pool_size_);
+  size_t cache_size_per_worker =
+      (FLAGS_pserver_graph_sample_cache_size + task_pool_size_ - 1) /
+      task_pool_size_;
+  _sample_caches.resize(task_pool_size_);
   for (size_t i = 0; i < _shards_task_pool.size(); ++i) {
     _shards_task_pool[i].reset(new ::ThreadPool(1));
     _shards_task_rng_pool.push_back(paddle::framework::GetCPURandomEngine(0));
+    _sample_caches[i].init(cache_size_per_worker,
+                           FLAGS_pserver_graph_sample_cache_ttl);
   }
   server_num = _shard_num;
   // VLOG(0) << "in init graph table server num = " << server_num;
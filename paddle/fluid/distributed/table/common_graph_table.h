@@ -62,6 +62,35 @@ class GraphShard {
   int shard_num;
   std::vector<Node *> bucket;
 };
+// LRU of serialized random_sample_neighboors results for hot vertices.
+// Each instance belongs to exactly one worker of _shards_task_pool (the
+// pools are single threaded), so no locking is needed. An entry is served
+// at most ttl times before it is dropped and the node is resampled, which
+// keeps cached neighborhoods statistically fresh.
+class SampleCache {
+ public:
+  void init(size_t capacity, int ttl) {
+    capacity_ = capacity;
+    ttl_ = ttl;
+  }
+  bool enabled() const { return capacity_ > 0; }
+  bool get(uint64_t node_id, int sample_size, std::string *buffer);
+  void put(uint64_t node_id, int sample_size, const std::string &buffer);
+  void clear();
+
+ private:
+  struct Entry {
+    uint64_t node_id;
+    int sample_size;
+    int remain;
+    std::string buffer;
+  };
+  size_t capacity_ = 0;
+  int ttl_ = 0;
+  std::list<Entry> lru_;
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> index_;
+};
+
 class GraphTable : public SparseTable {
  public:
   GraphTable() {}
@@ -146,6 +175,8 @@ class GraphTable : public SparseTable {
 
   std::vector<std::shared_ptr<::ThreadPool>> _shards_task_pool;
   std::vector<std::shared_ptr<std::mt19937_64>> _shards_task_rng_pool;
+  // one cache per task pool worker, only touched from that worker
+  std::vector<SampleCache> _sample_caches;
 };
 }  // namespace distributed
 
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "paddle/fluid/distributed/table/common_sparse_table.h"
+#include <cstring>
+#include <iterator>
 #include <sstream>
 
 #include "glog/logging.h"
@@ -27,6 +29,10 @@ class ValueBlock;
 namespace paddle {
 namespace distributed {
 
+// header of the binary snapshot format: |8B magic|4B value_length|, then
+// fixed-width records |8B id|4B count|4B unseen_days|1B is_entry|values|
+const uint64_t SPARSE_SAVE_BIN_MAGIC = 0x4448534E49425350UL;  // "PSBINSHD"
+
 void CommonSparseTable::ProcessALine(const std::vector<std::string>& columns,
                                      const Meta& meta, const int64_t id,
                                      std::vector<std::vector<float>>* values) {
@@ -86,7 +92,9 @@ int64_t CommonSparseTable::SaveValueToText(std::ostream* os,
                                            std::shared_ptr<::ThreadPool> pool,
                                            const int mode, int shard_id) {
   int64_t save_num = 0;
-  for (auto& table : block->values_) {
+  for (size_t bucket = 0; bucket < SPARSE_SHARD_BUCKET_NUM; ++bucket) {
+    std::lock_guard<std::mutex> guard(block->bucket_mutex_[bucket]);
+    auto& table = block->values_[bucket];
     for (auto& value : table) {
       if (mode == SaveMode::delta && !value.second->need_save_) {
         continue;
@@ -121,6 +129,42 @@ int64_t CommonSparseTable::SaveValueToText(std::ostream* os,
   return save_num;
 }
 
+int64_t CommonSparseTable::SaveValueToBin(std::ostream* os,
+                                          std::shared_ptr<ValueBlock> block,
+                                          const int mode, int shard_id) {
+  int64_t save_num = 0;
+  for (size_t bucket = 0; bucket < SPARSE_SHARD_BUCKET_NUM; ++bucket) {
+    std::lock_guard<std::mutex> guard(block->bucket_mutex_[bucket]);
+    auto& table = block->values_[bucket];
+    for (auto& value : table) {
+      if (mode == SaveMode::delta_bin && !value.second->need_save_) {
+        continue;
+      }
+
+      ++save_num;
+
+      uint64_t id = value.first;
+      int32_t count = value.second->count_;
+      int32_t unseen_days = value.second->unseen_days_;
+      char is_entry = static_cast<char>(value.second->is_entry_);
+
+      os->write(reinterpret_cast<const char*>(&id), sizeof(id));
+      os->write(reinterpret_cast<const char*>(&count), sizeof(count));
+      os->write(reinterpret_cast<const char*>(&unseen_days),
+                sizeof(unseen_days));
+      os->write(&is_entry, sizeof(is_entry));
+      os->write(reinterpret_cast<const char*>(value.second->data_.data()),
+                sizeof(float) * block->value_length_);
+
+      if (mode == SaveMode::base_bin || mode == SaveMode::delta_bin) {
+        value.second->need_save_ = false;
+      }
+    }
+  }
+
+  return save_num;
+}
+
 int64_t CommonSparseTable::LoadFromText(
     const std::string& valuepath, const std::string& metapath,
     const int pserver_id, const int pserver_num, const int local_shard_num,
@@ -167,6 +211,85 @@ int64_t CommonSparseTable::LoadFromText(
   return 0;
 }
 
+int64_t CommonSparseTable::LoadFromBin(
+    const std::string& valuepath, const int pserver_id, const int pserver_num,
+    const int local_shard_num, std::vector<std::shared_ptr<ValueBlock>>* blocks) {
+  std::ifstream file(valuepath, std::ios::binary);
+  uint64_t magic = 0;
+  uint32_t value_length = 0;
+  file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+  file.read(reinterpret_cast<char*>(&value_length), sizeof(value_length));
+  PADDLE_ENFORCE_EQ(magic, SPARSE_SAVE_BIN_MAGIC,
+                    paddle::platform::errors::InvalidArgument(
+                        "%s is not a sparse binary snapshot", valuepath));
+  PADDLE_ENFORCE_EQ(
+      value_length, static_cast<uint32_t>(blocks->at(0)->value_length_),
+      paddle::platform::errors::InvalidArgument(
+          "value length %d in %s does not match the table config %d",
+          value_length, valuepath, blocks->at(0)->value_length_));
+
+  std::string data((std::istreambuf_iterator<char>(file)),
+                   std::istreambuf_iterator<char>());
+  const size_t record_size = sizeof(uint64_t) + 2 * sizeof(int32_t) +
+                             sizeof(char) + sizeof(float) * value_length;
+  PADDLE_ENFORCE_EQ(data.size() % record_size, 0,
+                    paddle::platform::errors::InvalidArgument(
+                        "%s is truncated, %d bytes left over", valuepath,
+                        data.size() % record_size));
+
+  //先按shard归并记录偏移，再由各shard的worker并行恢复
+  std::vector<std::vector<size_t>> offsets(local_shard_num);
+  size_t num_records = data.size() / record_size;
+  for (size_t i = 0; i < num_records; ++i) {
+    uint64_t id;
+    std::memcpy(&id, data.data() + i * record_size, sizeof(id));
+    if (id % pserver_num != pserver_id) {
+      VLOG(3) << "will not load " << id << " from " << valuepath
+              << ", please check id distribution";
+      continue;
+    }
+    offsets[id % local_shard_num].push_back(i * record_size);
+  }
+
+  std::vector<std::future<int64_t>> tasks;
+  for (int shard_id = 0; shard_id < local_shard_num; ++shard_id) {
+    if (offsets[shard_id].empty()) continue;
+    tasks.push_back(_shards_task_pool[shard_id]->enqueue(
+        [this, shard_id, value_length, &data, &offsets,
+         blocks]() -> int64_t {
+          auto block = blocks->at(shard_id);
+          for (auto off : offsets[shard_id]) {
+            const char* rec = data.data() + off;
+            uint64_t id;
+            int32_t count, unseen_days;
+            std::memcpy(&id, rec, sizeof(id));
+            rec += sizeof(id);
+            std::memcpy(&count, rec, sizeof(count));
+            rec += sizeof(count);
+            std::memcpy(&unseen_days, rec, sizeof(unseen_days));
+            rec += sizeof(unseen_days);
+            char is_entry = *rec;
+            rec += sizeof(char);
+
+            block->Init(id, false);
+            VALUE* value_instant = block->GetValue(id);
+            value_instant->count_ = count;
+            value_instant->unseen_days_ = unseen_days;
+            value_instant->is_entry_ = static_cast<bool>(is_entry);
+            std::memcpy(value_instant->data_.data(), rec,
+                        sizeof(float) * value_length);
+          }
+          return static_cast<int64_t>(offsets[shard_id].size());
+        }));
+  }
+
+  int64_t loaded = 0;
+  for (auto& task : tasks) {
+    loaded += task.get();
+  }
+  return loaded;
+}
+
 int32_t CommonSparseTable::initialize() {
   _shards_task_pool.resize(task_pool_size_);
   for (int i = 0; i < _shards_task_pool.size(); ++i) {
@@ -283,8 +406,21 @@ int32_t CommonSparseTable::load(const std::string& path,
                                 const std::string& param) {
   auto begin = GetCurrentUS();
   rwlock_->WRLock();
-  LoadFromText(path, param, _shard_idx, _shard_num, task_pool_size_,
-               &shard_values_);
+  // a binary snapshot is recognized by its magic, whatever the suffix
+  bool is_binary = false;
+  {
+    std::ifstream file(path, std::ios::binary);
+    uint64_t magic = 0;
+    if (file.read(reinterpret_cast<char*>(&magic), sizeof(magic))) {
+      is_binary = (magic == SPARSE_SAVE_BIN_MAGIC);
+    }
+  }
+  if (is_binary) {
+    LoadFromBin(path, _shard_idx, _shard_num, task_pool_size_, &shard_values_);
+  } else {
+    LoadFromText(path, param, _shard_idx, _shard_num, task_pool_size_,
+                 &shard_values_);
+  }
   rwlock_->UNLock();
   auto end = GetCurrentUS();
 
@@ -315,17 +451,50 @@ int32_t CommonSparseTable::save(const std::string& dirname,
   std::string shard_var_pre =
       string::Sprintf("%s.block%d", varname, _shard_idx);
 
-  std::string value_ = string::Sprintf("%s/%s.txt", var_store, shard_var_pre);
+  bool is_binary = (mode == SaveMode::all_bin || mode == SaveMode::base_bin ||
+                    mode == SaveMode::delta_bin);
+  std::string value_ = string::Sprintf("%s/%s.%s", var_store, shard_var_pre,
+                                       is_binary ? "bin" : "txt");
 
-  std::unique_ptr<std::ofstream> vs(new std::ofstream(value_));
+  //各shard在自己的worker上并行序列化，主线程按shard顺序落盘
+  std::vector<std::string> shard_buffers(task_pool_size_);
+  std::vector<int64_t> shard_nums(task_pool_size_, 0);
+  std::vector<std::future<int>> tasks;
+  for (int shard_id = 0; shard_id < task_pool_size_; ++shard_id) {
+    tasks.push_back(_shards_task_pool[shard_id]->enqueue(
+        [this, shard_id, mode, is_binary, &shard_buffers,
+         &shard_nums]() -> int {
+          std::ostringstream os;
+          if (is_binary) {
+            shard_nums[shard_id] =
+                SaveValueToBin(&os, shard_values_[shard_id], mode, shard_id);
+          } else {
+            shard_nums[shard_id] =
+                SaveValueToText(&os, shard_values_[shard_id],
+                                _shards_task_pool[shard_id], mode, shard_id);
+          }
+          shard_buffers[shard_id] = os.str();
+          return 0;
+        }));
+  }
+  for (auto& task : tasks) {
+    task.get();
+  }
 
+  std::unique_ptr<std::ofstream> vs(
+      new std::ofstream(value_, std::ios::binary | std::ios::trunc));
   int64_t total_ins = 0;
+  if (is_binary) {
+    uint64_t magic = SPARSE_SAVE_BIN_MAGIC;
+    uint32_t value_length =
+        static_cast<uint32_t>(shard_values_[0]->value_length_);
+    vs->write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+    vs->write(reinterpret_cast<const char*>(&value_length),
+              sizeof(value_length));
+  }
   for (int shard_id = 0; shard_id < task_pool_size_; ++shard_id) {
-    // save values
-    auto shard_save_num =
-        SaveValueToText(vs.get(), shard_values_[shard_id],
-                        _shards_task_pool[shard_id], mode, shard_id);
-    total_ins += shard_save_num;
+    vs->write(shard_buffers[shard_id].data(), shard_buffers[shard_id].size());
+    total_ins += shard_nums[shard_id];
   }
   vs->close();
 
@@ -347,8 +516,9 @@ std::pair<int64_t, int64_t> CommonSparseTable::print_table_stat() {
   int64_t mf_size = 0;
 
   for (auto& shard : shard_values_) {
-    for (auto& table : shard->values_) {
-      feasign_size += table.size();
+    for (size_t bucket = 0; bucket < SPARSE_SHARD_BUCKET_NUM; ++bucket) {
+      std::lock_guard<std::mutex> guard(shard->bucket_mutex_[bucket]);
+      feasign_size += shard->values_[bucket].size();
     }
   }
 
@@ -378,40 +548,36 @@ int32_t CommonSparseTable::pour() {
 int32_t CommonSparseTable::pull_sparse(float* pull_values,
                                        const PullSparseValue& pull_value) {
   auto shard_num = task_pool_size_;
-  std::vector<std::future<int>> tasks(shard_num);
 
+  // runs on the calling server thread instead of hopping to the
+  // per-shard worker threads: keys are grouped by shard before any lock
+  // is taken and ValueBlock locks per bucket internally, so concurrent
+  // requests proceed in parallel instead of queueing behind the shard
+  // workers
   for (int shard_id = 0; shard_id < shard_num; ++shard_id) {
-    tasks[shard_id] = _shards_task_pool[shard_id]->enqueue(
-        [this, shard_id, shard_num, &pull_value, &pull_values]() -> int {
-          auto& block = shard_values_[shard_id];
-
-          std::vector<int> offsets;
-          pull_value.Fission(shard_id, shard_num, &offsets);
-
-          if (pull_value.is_training_) {
-            for (auto& offset : offsets) {
-              auto feasign = pull_value.feasigns_[offset];
-              auto frequencie = pull_value.frequencies_[offset];
-              auto* value = block->Init(feasign, true, frequencie);
-              std::copy_n(value + param_offset_, param_dim_,
-                          pull_values + param_dim_ * offset);
-            }
-          } else {
-            for (auto& offset : offsets) {
-              auto feasign = pull_value.feasigns_[offset];
-              auto* value = block->Init(feasign, false);
-              std::copy_n(value + param_offset_, param_dim_,
-                          pull_values + param_dim_ * offset);
-            }
-          }
-
-          return 0;
-        });
+    auto& block = shard_values_[shard_id];
+
+    std::vector<int> offsets;
+    pull_value.Fission(shard_id, shard_num, &offsets);
+
+    if (pull_value.is_training_) {
+      for (auto& offset : offsets) {
+        auto feasign = pull_value.feasigns_[offset];
+        auto frequencie = pull_value.frequencies_[offset];
+        auto* value = block->Init(feasign, true, frequencie);
+        std::copy_n(value + param_offset_, param_dim_,
+                    pull_values + param_dim_ * offset);
+      }
+    } else {
+      for (auto& offset : offsets) {
+        auto feasign = pull_value.feasigns_[offset];
+        auto* value = block->Init(feasign, false);
+        std::copy_n(value + param_offset_, param_dim_,
+                    pull_values + param_dim_ * offset);
+      }
+    }
   }
 
-  for (size_t shard_id = 0; shard_id < tasks.size(); ++shard_id) {
-    tasks[shard_id].wait();
-  }
   return 0;
 }
 
@@ -425,30 +591,20 @@ int32_t CommonSparseTable::pull_sparse_ptr(char** pull_values,
     offset_bucket[y].push_back(x);
   }
 
-  std::vector<std::future<int>> tasks(task_pool_size_);
-
   for (int shard_id = 0; shard_id < task_pool_size_; ++shard_id) {
-    tasks[shard_id] = _shards_task_pool[shard_id]->enqueue(
-        [this, shard_id, &keys, &offset_bucket, &pull_values]() -> int {
-          auto& block = shard_values_[shard_id];
-          auto& offsets = offset_bucket[shard_id];
-
-          for (int i = 0; i < offsets.size(); ++i) {
-            auto offset = offsets[i];
-            auto id = keys[offset];
-            auto* value = block->InitGet(id);
-            // std::copy_n(value + param_offset_, param_dim_,
-            //            pull_values + param_dim_ * offset);
-            pull_values[offset] = reinterpret_cast<char*>(value);
-          }
-
-          return 0;
-        });
+    auto& block = shard_values_[shard_id];
+    auto& offsets = offset_bucket[shard_id];
+
+    for (int i = 0; i < offsets.size(); ++i) {
+      auto offset = offsets[i];
+      auto id = keys[offset];
+      auto* value = block->InitGet(id);
+      // std::copy_n(value + param_offset_, param_dim_,
+      //            pull_values + param_dim_ * offset);
+      pull_values[offset] = reinterpret_cast<char*>(value);
+    }
   }
 
-  for (size_t shard_id = 0; shard_id < tasks.size(); ++shard_id) {
-    tasks[shard_id].wait();
-  }
   return 0;
 }
 
@@ -462,21 +618,13 @@ int32_t CommonSparseTable::_push_sparse(const uint64_t* keys,
     offset_bucket[y].push_back(x);
   }
 
-  std::vector<std::future<int>> tasks(task_pool_size_);
-
+  // applied on the calling server thread, see pull_sparse
   for (int shard_id = 0; shard_id < task_pool_size_; ++shard_id) {
-    tasks[shard_id] = _shards_task_pool[shard_id]->enqueue(
-        [this, shard_id, &keys, &values, num, &offset_bucket]() -> int {
-          auto& offsets = offset_bucket[shard_id];
-          optimizer_->update(keys, values, num, offsets,
-                             shard_values_[shard_id].get());
-          return 0;
-        });
+    auto& offsets = offset_bucket[shard_id];
+    optimizer_->update(keys, values, num, offsets,
+                       shard_values_[shard_id].get());
   }
 
-  for (size_t shard_id = 0; shard_id < tasks.size(); ++shard_id) {
-    tasks[shard_id].wait();
-  }
   return 0;
 }
 
@@ -522,24 +670,16 @@ int32_t CommonSparseTable::_push_sparse(const uint64_t* keys,
     offset_bucket[y].push_back(x);
   }
 
-  std::vector<std::future<int>> tasks(task_pool_size_);
-
+  // applied on the calling server thread, see pull_sparse
   for (int shard_id = 0; shard_id < task_pool_size_; ++shard_id) {
-    tasks[shard_id] = _shards_task_pool[shard_id]->enqueue(
-        [this, shard_id, &keys, &values, num, &offset_bucket]() -> int {
-          auto& offsets = offset_bucket[shard_id];
-          for (size_t i = 0; i < offsets.size(); ++i) {
-            std::vector<uint64_t> tmp_off = {0};
-            optimizer_->update(keys + offsets[i], values[offsets[i]], num,
-                               tmp_off, shard_values_[shard_id].get());
-          }
-          return 0;
-        });
+    auto& offsets = offset_bucket[shard_id];
+    for (size_t i = 0; i < offsets.size(); ++i) {
+      std::vector<uint64_t> tmp_off = {0};
+      optimizer_->update(keys + offsets[i], values[offsets[i]], num, tmp_off,
+                         shard_values_[shard_id].get());
+    }
   }
 
-  for (size_t shard_id = 0; shard_id < tasks.size(); ++shard_id) {
-    tasks[shard_id].wait();
-  }
   return 0;
 }
 
@@ -553,29 +693,21 @@ int32_t CommonSparseTable::push_sparse_param(const uint64_t* keys,
     offset_bucket[y].push_back(x);
   }
 
-  std::vector<std::future<int>> tasks(task_pool_size_);
-
+  // applied on the calling server thread, see pull_sparse
   for (int shard_id = 0; shard_id < task_pool_size_; ++shard_id) {
-    tasks[shard_id] = _shards_task_pool[shard_id]->enqueue(
-        [this, shard_id, &keys, &offset_bucket, &values]() -> int {
-          auto& block = shard_values_[shard_id];
-          auto& offsets = offset_bucket[shard_id];
-
-          for (int i = 0; i < offsets.size(); ++i) {
-            auto offset = offsets[i];
-            auto id = keys[offset];
-            auto* value = block->Init(id, false);
-            std::copy_n(values + param_dim_ * offset, param_dim_,
-                        value + param_offset_);
-            block->SetEntry(id, true);
-          }
-          return 0;
-        });
+    auto& block = shard_values_[shard_id];
+    auto& offsets = offset_bucket[shard_id];
+
+    for (int i = 0; i < offsets.size(); ++i) {
+      auto offset = offsets[i];
+      auto id = keys[offset];
+      auto* value = block->Init(id, false);
+      std::copy_n(values + param_dim_ * offset, param_dim_,
+                  value + param_offset_);
+      block->SetEntry(id, true);
+    }
   }
 
-  for (size_t shard_id = 0; shard_id < tasks.size(); ++shard_id) {
-    tasks[shard_id].wait();
-  }
   return 0;
 }
 
@@ -39,7 +39,9 @@ namespace distributed {
 
 class SparseOptimizer;
 
-enum SaveMode { all, base, delta };
+// modes >= all_bin write the fixed-width binary snapshot format instead
+// of the text dump; the *_bin modes mirror all/base/delta one to one
+enum SaveMode { all, base, delta, all_bin, base_bin, delta_bin };
 
 struct Meta {
   std::string param;
@@ -138,6 +140,9 @@ class CommonSparseTable : public SparseTable {
                           std::shared_ptr<::ThreadPool> pool, const int mode,
                           int shard_id);
 
+  int64_t SaveValueToBin(std::ostream* os, std::shared_ptr<ValueBlock> block,
+                         const int mode, int shard_id);
+
   virtual void ProcessALine(const std::vector<std::string>& columns,
                             const Meta& meta, const int64_t id,
                             std::vector<std::vector<float>>* values);
@@ -147,6 +152,11 @@ class CommonSparseTable : public SparseTable {
       const int pserver_id, const int pserver_num, const int local_shard_num,
       std::vector<std::shared_ptr<ValueBlock>>* blocks);
 
+  virtual int64_t LoadFromBin(const std::string& valuepath,
+                              const int pserver_id, const int pserver_num,
+                              const int local_shard_num,
+                              std::vector<std::shared_ptr<ValueBlock>>* blocks);
+
   virtual std::pair<int64_t, int64_t> print_table_stat();
   virtual int32_t pull_sparse(float* values, const PullSparseValue& pull_value);
 
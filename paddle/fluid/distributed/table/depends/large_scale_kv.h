@@ -18,6 +18,7 @@
 #include <functional>
 #include <future>  // NOLINT
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <thread>  // NOLINT
 #include <unordered_map>
@@ -81,6 +82,10 @@ inline bool probility_entry(VALUE *value, float threshold) {
   return uniform.GetValue() >= threshold;
 }
 
+// Thread safe for concurrent server threads: every bucket carries its own
+// mutex, taken only around the map lookup/insert/erase, so accesses from
+// different threads contend only when they hit the same bucket. The VALUE
+// payload itself is updated without a lock, as in the single writer case.
 class ValueBlock {
  public:
   typedef typename robin_hood::unordered_map<uint64_t, VALUE *> map_type;
@@ -168,6 +173,7 @@ class ValueBlock {
               const int counter = 1) {
     size_t hash = _hasher(id);
     size_t bucket = compute_bucket(hash);
+    std::lock_guard<std::mutex> guard(bucket_mutex_[bucket]);
 
     auto &table = values_[bucket];
     auto res = table.find(id);
@@ -192,6 +198,7 @@ class ValueBlock {
                  const int counter = 1) {
     size_t hash = _hasher(id);
     size_t bucket = compute_bucket(hash);
+    std::lock_guard<std::mutex> guard(bucket_mutex_[bucket]);
 
     auto &table = values_[bucket];
     auto res = table.find(id);
@@ -233,6 +240,7 @@ class ValueBlock {
   float *Get(const uint64_t &id) {
     size_t hash = _hasher(id);
     size_t bucket = compute_bucket(hash);
+    std::lock_guard<std::mutex> guard(bucket_mutex_[bucket]);
     auto &table = values_[bucket];
 
     // auto &value = table.at(id);
@@ -246,6 +254,7 @@ class ValueBlock {
   VALUE *GetValue(const uint64_t &id) {
     size_t hash = _hasher(id);
     size_t bucket = compute_bucket(hash);
+    std::lock_guard<std::mutex> guard(bucket_mutex_[bucket]);
 
     auto &table = values_[bucket];
     auto res = table.find(id);
@@ -265,6 +274,7 @@ class ValueBlock {
   void erase(uint64_t feasign) {
     size_t hash = _hasher(feasign);
     size_t bucket = compute_bucket(hash);
+    std::lock_guard<std::mutex> guard(bucket_mutex_[bucket]);
     auto &table = values_[bucket];
 
     auto iter = table.find(feasign);
@@ -275,7 +285,9 @@ class ValueBlock {
   }
 
   void Shrink(const int threshold) {
-    for (auto &table : values_) {
+    for (size_t bucket = 0; bucket < SPARSE_SHARD_BUCKET_NUM; ++bucket) {
+      std::lock_guard<std::mutex> guard(bucket_mutex_[bucket]);
+      auto &table = values_[bucket];
       for (auto iter = table.begin(); iter != table.end();) {
         // VALUE* value = (VALUE*)(void*)(iter->second);
         VALUE *value = iter->second;
@@ -309,6 +321,7 @@ class ValueBlock {
   map_type::iterator Find(uint64_t id) {
     size_t hash = _hasher(id);
     size_t bucket = compute_bucket(hash);
+    std::lock_guard<std::mutex> guard(bucket_mutex_[bucket]);
     auto &table = values_[bucket];
 
     auto got = table.find(id);
@@ -323,6 +336,7 @@ class ValueBlock {
   bool Has(const uint64_t id) {
     size_t hash = _hasher(id);
     size_t bucket = compute_bucket(hash);
+    std::lock_guard<std::mutex> guard(bucket_mutex_[bucket]);
     auto &table = values_[bucket];
 
     auto got = table.find(id);
@@ -335,6 +349,9 @@ class ValueBlock {
 
  public:
   map_type values_[SPARSE_SHARD_BUCKET_NUM];
+  // guards the map of the bucket with the same index; anyone iterating
+  // values_[x] directly must hold bucket_mutex_[x]
+  std::mutex bucket_mutex_[SPARSE_SHARD_BUCKET_NUM];
   size_t value_length_ = 0;
   std::hash<uint64_t> _hasher;
 
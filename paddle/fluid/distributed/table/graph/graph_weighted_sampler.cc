@@ -15,7 +15,7 @@
 #include "paddle/fluid/distributed/table/graph/graph_weighted_sampler.h"
 #include <iostream>
 #include <memory>
-#include <unordered_map>
+#include <utility>
 #include "paddle/fluid/framework/generator.h"
 namespace paddle {
 namespace distributed {
@@ -56,58 +56,28 @@ std::vector<int> RandomSampler::sample_k(
   return sample_result;
 }
 
-WeightedSampler::WeightedSampler() {
-  left = nullptr;
-  right = nullptr;
-  edges = nullptr;
-}
-
-WeightedSampler::~WeightedSampler() {
-  if (left != nullptr) {
-    delete left;
-    left = nullptr;
-  }
-  if (right != nullptr) {
-    delete right;
-    right = nullptr;
-  }
-}
-
 void WeightedSampler::build(GraphEdgeBlob *edges) {
-  if (left != nullptr) {
-    delete left;
-    left = nullptr;
+  num_edges = (int)edges->size();
+  leaf_offset = 1;
+  while (leaf_offset < num_edges) {
+    leaf_offset <<= 1;
   }
-  if (right != nullptr) {
-    delete right;
-    right = nullptr;
+  tree_weight.assign(leaf_offset * 2, 0);
+  tree_count.assign(leaf_offset * 2, 0);
+  for (int i = 0; i < num_edges; i++) {
+    tree_weight[leaf_offset + i] = edges->get_weight(i);
+    tree_count[leaf_offset + i] = 1;
   }
-  return build_one((WeightedGraphEdgeBlob *)edges, 0, edges->size());
-}
-
-void WeightedSampler::build_one(WeightedGraphEdgeBlob *edges, int start,
-                                int end) {
-  count = 0;
-  this->edges = edges;
-  if (start + 1 == end) {
-    left = right = nullptr;
-    idx = start;
-    count = 1;
-    weight = edges->get_weight(idx);
-
-  } else {
-    left = new WeightedSampler();
-    right = new WeightedSampler();
-    left->build_one(edges, start, start + (end - start) / 2);
-    right->build_one(edges, start + (end - start) / 2, end);
-    weight = left->weight + right->weight;
-    count = left->count + right->count;
+  for (int x = leaf_offset - 1; x >= 1; x--) {
+    tree_weight[x] = tree_weight[2 * x] + tree_weight[2 * x + 1];
+    tree_count[x] = tree_count[2 * x] + tree_count[2 * x + 1];
   }
 }
+
 std::vector<int> WeightedSampler::sample_k(
     int k, const std::shared_ptr<std::mt19937_64> rng) {
-  if (k >= count) {
-    k = count;
+  if (k >= num_edges) {
+    k = num_edges;
     std::vector<int> sample_result;
     for (int i = 0; i < k; i++) {
       sample_result.push_back(i);
@@ -115,46 +85,50 @@ std::vector<int> WeightedSampler::sample_k(
     return sample_result;
   }
   std::vector<int> sample_result;
-  float subtract;
-  std::unordered_map<WeightedSampler *, float> subtract_weight_map;
-  std::unordered_map<WeightedSampler *, int> subtract_count_map;
+  //无放回采样：命中的叶子权重沿路径扣除，采样结束后再精确恢复
+  std::vector<std::pair<int, float>> sampled;
+  sampled.reserve(k);
   std::uniform_real_distribution<float> distrib(0, 1.0);
   while (k--) {
-    float query_weight = distrib(*rng);
-    query_weight *= weight - subtract_weight_map[this];
-    sample_result.push_back(sample(query_weight, subtract_weight_map,
-                                   subtract_count_map, subtract));
+    float query_weight = distrib(*rng) * tree_weight[1];
+    float sampled_weight = 0;
+    int idx = sample_one(query_weight, &sampled_weight);
+    sample_result.push_back(idx);
+    sampled.push_back({idx, sampled_weight});
+  }
+  for (auto &p : sampled) {
+    tree_weight[leaf_offset + p.first] = p.second;
+    tree_count[leaf_offset + p.first] = 1;
+  }
+  // ancestors are recomputed as the sum of their children so repeated
+  // queries do not accumulate float subtraction error
+  for (auto &p : sampled) {
+    for (int x = (leaf_offset + p.first) >> 1; x >= 1; x >>= 1) {
+      tree_weight[x] = tree_weight[2 * x] + tree_weight[2 * x + 1];
+      tree_count[x] = tree_count[2 * x] + tree_count[2 * x + 1];
+    }
   }
   return sample_result;
 }
 
-int WeightedSampler::sample(
-    float query_weight,
-    std::unordered_map<WeightedSampler *, float> &subtract_weight_map,
-    std::unordered_map<WeightedSampler *, int> &subtract_count_map,
-    float &subtract) {
-  if (left == nullptr) {
-    subtract_weight_map[this] = weight;
-    subtract = weight;
-    subtract_count_map[this] = 1;
-    return idx;
+int WeightedSampler::sample_one(float query_weight, float *sampled_weight) {
+  int x = 1;
+  while (x < leaf_offset) {
+    int left = 2 * x, right = 2 * x + 1;
+    if (tree_count[right] == 0 ||
+        (tree_count[left] > 0 && tree_weight[left] >= query_weight)) {
+      x = left;
+    } else {
+      query_weight -= tree_weight[left];
+      x = right;
+    }
   }
-  int left_count = left->count - subtract_count_map[left];
-  int right_count = right->count - subtract_count_map[right];
-  float left_subtract = subtract_weight_map[left];
-  int return_idx;
-  if (right_count == 0 ||
-      left_count > 0 && left->weight - left_subtract >= query_weight) {
-    return_idx = left->sample(query_weight, subtract_weight_map,
-                              subtract_count_map, subtract);
-  } else {
-    return_idx =
-        right->sample(query_weight - (left->weight - left_subtract),
-                      subtract_weight_map, subtract_count_map, subtract);
+  *sampled_weight = tree_weight[x];
+  for (int y = x; y >= 1; y >>= 1) {
+    tree_weight[y] -= *sampled_weight;
+    tree_count[y]--;
   }
-  subtract_weight_map[this] += subtract;
-  subtract_count_map[this]++;
-  return return_idx;
+  return x - leaf_offset;
 }
 }  // namespace distributed
 }  // namespace paddle
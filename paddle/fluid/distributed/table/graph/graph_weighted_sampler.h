@@ -41,23 +41,23 @@ class RandomSampler : public Sampler {
 
 class WeightedSampler : public Sampler {
  public:
-  WeightedSampler();
-  virtual ~WeightedSampler();
-  WeightedSampler *left, *right;
-  float weight;
-  int count;
-  int idx;
-  GraphEdgeBlob *edges;
+  WeightedSampler() {}
+  virtual ~WeightedSampler() {}
   virtual void build(GraphEdgeBlob *edges);
-  virtual void build_one(WeightedGraphEdgeBlob *edges, int start, int end);
   virtual std::vector<int> sample_k(int k,
                                     const std::shared_ptr<std::mt19937_64> rng);
 
  private:
-  int sample(float query_weight,
-             std::unordered_map<WeightedSampler *, float> &subtract_weight_map,
-             std::unordered_map<WeightedSampler *, int> &subtract_count_map,
-             float &subtract);
+  int sample_one(float query_weight, float *sampled_weight);
+
+  // implicit binary tree flattened into two arrays at build time: node x
+  // has children 2x and 2x+1, the leaf of edge i lives at leaf_offset + i,
+  // so one draw is a root-to-leaf walk through contiguous memory instead
+  // of a chase through heap-allocated tree nodes and per-query hash maps
+  int num_edges = 0;
+  int leaf_offset = 0;
+  std::vector<float> tree_weight;
+  std::vector<int> tree_count;
 };
 }  // namespace distributed
 }  // namespace paddle
@@ -16,10 +16,22 @@
 #include "paddle/fluid/distributed/table/ssd_sparse_table.h"
 
 DEFINE_string(rocksdb_path, "database", "path of sparse table rocksdb file");
+DEFINE_int64(ssd_sparse_bloomfilter_bits, 134217728,
+             "bits per shard of the ssd sparse table bloom filter, keys the "
+             "filter has never seen skip the rocksdb read; 0 disables it");
+DEFINE_int32(ssd_sparse_cache_admit_frequency, 1,
+             "minimum pull frequency for a key read back from rocksdb to be "
+             "admitted into the in-memory hot tier; colder keys are served "
+             "from the ssd value without promotion");
 
 namespace paddle {
 namespace distributed {
 
+using paddle::operators::math::bloomfilter;
+using paddle::operators::math::bloomfilter_get;
+using paddle::operators::math::bloomfilter_init;
+using paddle::operators::math::bloomfilter_set;
+
 int32_t SSDSparseTable::initialize() {
   _shards_task_pool.resize(task_pool_size_);
   for (int i = 0; i < _shards_task_pool.size(); ++i) {
@@ -58,6 +70,18 @@ int32_t SSDSparseTable::initialize() {
   initialize_recorder();
   _db = paddle::distributed::RocksDBHandler::GetInstance();
   _db->initialize(FLAGS_rocksdb_path, task_pool_size_);
+
+  _bloom_filters.resize(task_pool_size_, nullptr);
+  if (FLAGS_ssd_sparse_bloomfilter_bits > 0) {
+    for (int i = 0; i < task_pool_size_; ++i) {
+      PADDLE_ENFORCE_EQ(
+          bloomfilter_init(&_bloom_filters[i],
+                           FLAGS_ssd_sparse_bloomfilter_bits, 3),
+          1, paddle::platform::errors::ResourceExhausted(
+                 "alloc bloom filter of %ld bits for sparse table failed",
+                 FLAGS_ssd_sparse_bloomfilter_bits));
+    }
+  }
   return 0;
 }
 
@@ -74,34 +98,43 @@ int32_t SSDSparseTable::pull_sparse(float* pull_values,
           std::vector<int> offsets;
           pull_value.Fission(shard_id, shard_num, &offsets);
 
+          auto* filter = _bloom_filters[shard_id];
+
           for (auto& offset : offsets) {
             auto feasign = pull_value.feasigns_[offset];
             auto frequencie = pull_value.frequencies_[offset];
             float* embedding = nullptr;
+            std::string tmp_str("");
             auto iter = block->Find(feasign);
-            // in mem
-            if (iter == block->end()) {
+            if (iter != block->end()) {
+              // in mem
               embedding = iter->second->data_.data();
               if (pull_value.is_training_) {
                 block->AttrUpdate(iter->second, frequencie);
               }
+            } else if (filter != nullptr &&
+                       !bloomfilter_get(filter, &feasign, sizeof(uint64_t))) {
+              // never seen before, skip the rocksdb read and create
+              embedding = block->Init(feasign, true, frequencie);
+              bloomfilter_set(filter, &feasign, sizeof(uint64_t));
+            } else if (_db->get(shard_id, (char*)&feasign, sizeof(uint64_t),
+                                tmp_str) > 0) {
+              // bloom filter false positive, need create
+              embedding = block->Init(feasign, true, frequencie);
+              if (filter != nullptr) {
+                bloomfilter_set(filter, &feasign, sizeof(uint64_t));
+              }
             } else {
-              // need create
-              std::string tmp_str("");
-              if (_db->get(shard_id, (char*)&feasign, sizeof(uint64_t),
-                           tmp_str) > 0) {
-                embedding = block->Init(feasign, true, frequencie);
-              } else {
-                // in db
-                int data_size = tmp_str.size() / sizeof(float);
-                int value_size = block->value_length_;
-                float* db_value = (float*)const_cast<char*>(tmp_str.c_str());
-                VALUE* value = block->InitGet(feasign);
+              // in db
+              int value_size = block->value_length_;
+              float* db_value = (float*)const_cast<char*>(tmp_str.c_str());
 
-                // copy to mem
+              if (frequencie >= FLAGS_ssd_sparse_cache_admit_frequency) {
+                // hot enough, promote into mem
+                VALUE* value = block->InitGet(feasign);
                 memcpy(value->data_.data(), db_value,
                        value_size * sizeof(float));
-                embedding = db_value;
+                embedding = value->data_.data();
 
                 // param, count, unseen_day
                 value->count_ = db_value[value_size];
@@ -110,6 +143,9 @@ int32_t SSDSparseTable::pull_sparse(float* pull_values,
                 if (pull_value.is_training_) {
                   block->AttrUpdate(value, frequencie);
                 }
+              } else {
+                // cold key, serve from the ssd value without promotion
+                embedding = db_value;
               }
             }
             std::copy_n(embedding + param_offset_, param_dim_,
@@ -144,6 +180,8 @@ int32_t SSDSparseTable::pull_sparse_ptr(char** pull_values,
           auto& block = shard_values_[shard_id];
           auto& offsets = offset_bucket[shard_id];
 
+          auto* filter = _bloom_filters[shard_id];
+
           for (auto& offset : offsets) {
             auto feasign = keys[offset];
             auto iter = block->Find(feasign);
@@ -151,15 +189,22 @@ int32_t SSDSparseTable::pull_sparse_ptr(char** pull_values,
             // in mem
             if (iter != block->end()) {
               value = iter->second;
+            } else if (filter != nullptr &&
+                       !bloomfilter_get(filter, &feasign, sizeof(uint64_t))) {
+              // never seen before, skip the rocksdb read and create
+              value = block->InitGet(feasign);
+              bloomfilter_set(filter, &feasign, sizeof(uint64_t));
             } else {
               // need create
               std::string tmp_str("");
               if (_db->get(shard_id, (char*)&feasign, sizeof(uint64_t),
                            tmp_str) > 0) {
                 value = block->InitGet(feasign);
+                if (filter != nullptr) {
+                  bloomfilter_set(filter, &feasign, sizeof(uint64_t));
+                }
               } else {
                 // in db
-                int data_size = tmp_str.size() / sizeof(float);
                 int value_size = block->value_length_;
                 float* db_value = (float*)const_cast<char*>(tmp_str.c_str());
                 value = block->InitGet(feasign);
@@ -321,6 +366,10 @@ int64_t SSDSparseTable::LoadFromText(
     auto shard_id = id % local_shard_num;
     auto block = blocks->at(shard_id);
 
+    if (_bloom_filters[shard_id] != nullptr) {
+      bloomfilter_set(_bloom_filters[shard_id], &id, sizeof(uint64_t));
+    }
+
     std::vector<std::vector<float>> kvalues;
     ProcessALine(values, meta, id, &kvalues);
 
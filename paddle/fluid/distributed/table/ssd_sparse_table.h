@@ -15,13 +15,21 @@
 #pragma once
 #include "paddle/fluid/distributed/table/common_sparse_table.h"
 #include "paddle/fluid/distributed/table/depends/rocksdb_warpper.h"
+#include "paddle/fluid/operators/math/bloomfilter.h"
 #ifdef PADDLE_WITH_HETERPS
 namespace paddle {
 namespace distributed {
 class SSDSparseTable : public CommonSparseTable {
  public:
   SSDSparseTable() {}
-  virtual ~SSDSparseTable() {}
+  virtual ~SSDSparseTable() {
+    for (auto*& filter : _bloom_filters) {
+      if (filter != nullptr) {
+        free(filter);
+        filter = nullptr;
+      }
+    }
+  }
 
   virtual int32_t initialize() override;
 
@@ -54,6 +62,10 @@ class SSDSparseTable : public CommonSparseTable {
  private:
   RocksDBHandler* _db;
   int64_t _cache_tk_size;
+  // one filter per shard, recording every feasign ever admitted to the
+  // table; a negative lookup lets brand-new keys skip the rocksdb read.
+  // Each filter is only touched from its shard's worker thread.
+  std::vector<paddle::operators::math::bloomfilter*> _bloom_filters;
 };
 
 }  // namespace ps
@@ -120,6 +120,8 @@ class Table {
     return _value_accesor;
   }
 
+  inline const TableParameter &config() const { return _config; }
+
   virtual void *get_shard(size_t shard_idx) = 0;
   virtual std::pair<int64_t, int64_t> print_table_stat() { return {0, 0}; }
 
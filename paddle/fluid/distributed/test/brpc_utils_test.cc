@@ -66,7 +66,7 @@ void CreateVarsOnScope(framework::Scope* scope, platform::Place* place,
   for (int i = 0; i < 564; ++i) rows->push_back(i);
 }
 
-void RunMultiVarMsg(platform::Place place) {
+void RunMultiVarMsg(platform::Place place, bool zero_copy_payload = false) {
   framework::Scope scope;
   platform::DeviceContextPool& pool = platform::DeviceContextPool::Instance();
   auto& ctx = *pool.Get(place);
@@ -81,7 +81,8 @@ void RunMultiVarMsg(platform::Place place) {
   butil::IOBuf io_buf;
   distributed::SerializeToMultiVarMsgAndIOBuf(message_name, send_var_name,
                                               recv_var_name, ctx, &scope,
-                                              &multi_msg, &io_buf);
+                                              &multi_msg, &io_buf,
+                                              zero_copy_payload);
   EXPECT_GT(multi_msg.ByteSizeLong(), static_cast<size_t>(0));
 
   // deserialize
@@ -130,6 +131,11 @@ TEST(MultiVarMsgCPU, Run) {
   RunMultiVarMsg(place);
 }
 
+TEST(MultiVarMsgCPU, RunZeroCopyPayload) {
+  platform::CPUPlace place;
+  RunMultiVarMsg(place, true);
+}
+
 // #ifdef PADDLE_WITH_CUDA
 // TEST(MultiVarMsgGPU, Run) {
 //   platform::CUDAPlace place;
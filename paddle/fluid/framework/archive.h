@@ -26,6 +26,7 @@
 #include <set>
 #include <string>
 #include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -33,6 +34,7 @@
 #include <vector>
 #include "paddle/fluid/framework/expect.h"
 #include "paddle/fluid/platform/enforce.h"
+#include "paddle/fluid/string/piece.h"
 
 namespace paddle {
 namespace framework {
@@ -224,6 +226,17 @@ class ArchiveBase {
     }
   }
 
+  // Borrowed read: returns a pointer into the archive's own buffer and
+  // advances the cursor past size bytes. Nothing is copied, so the pointer
+  // is only valid while the underlying buffer (e.g. the channel buffer
+  // handed to SetReadBuffer) stays alive and unmodified.
+  char* ReadBorrowed(size_t size) {
+    PrepareRead(size);
+    char* ptr = cursor_;
+    AdvanceCursor(size);
+    return ptr;
+  }
+
   void ReadBack(void* data, size_t size) {
     if (size > 0) {
       CHECK(size <= size_t(finish_ - cursor_));
@@ -317,6 +330,35 @@ class Archive<BinaryArchiveType> : public ArchiveBase {
     return x;
   }
 
+  // Reads a length-prefixed string without copying it out: the returned
+  // piece points into the archive buffer, under the same lifetime rules as
+  // ReadBorrowed().
+  string::Piece GetPiece() {
+#ifdef _LINUX
+    size_t len = Get<size_t>();
+#else
+    size_t len = static_cast<size_t>(Get<uint64_t>());
+#endif
+    return string::Piece(ReadBorrowed(len), len);
+  }
+
+  // Reads a length-prefixed vector of arithmetic elements as a borrowed
+  // span into the archive buffer; *count receives the element count. Only
+  // valid for element types whose encoding is their object representation
+  // (everything the bulk operator<< below writes). Same lifetime rules as
+  // ReadBorrowed().
+  template <class T>
+  const T* GetSpan(size_t* count) {
+    static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value,
+                  "GetSpan requires a non-bool arithmetic element type");
+#ifdef _LINUX
+    *count = Get<size_t>();
+#else
+    *count = static_cast<size_t>(Get<uint64_t>());
+#endif
+    return reinterpret_cast<const T*>(ReadBorrowed(*count * sizeof(T)));
+  }
+
   template <class... ARGS>
   void Printf(const char* fmt, ARGS&&... args) {
     size_t temp = Limit() - Finish();
@@ -372,6 +414,38 @@ Archive<AR>& operator>>(Archive<AR>& ar, std::vector<T>& p) {
   return ar;
 }
 
+// Bulk fast paths for BinaryArchive vectors of arithmetic elements, whose
+// per-element encoding is exactly their object representation: one memcpy
+// replaces the per-element loop. vector<bool> is excluded because it is
+// not contiguous.
+template <class T>
+typename std::enable_if<std::is_arithmetic<T>::value &&
+                            !std::is_same<T, bool>::value,
+                        BinaryArchive&>::type
+operator<<(BinaryArchive& ar, const std::vector<T>& p) {
+#ifdef _LINUX
+  ar << (size_t)p.size();
+#else
+  ar << (uint64_t)p.size();
+#endif
+  ar.Write(p.data(), p.size() * sizeof(T));
+  return ar;
+}
+
+template <class T>
+typename std::enable_if<std::is_arithmetic<T>::value &&
+                            !std::is_same<T, bool>::value,
+                        BinaryArchive&>::type
+operator>>(BinaryArchive& ar, std::vector<T>& p) {
+#ifdef _LINUX
+  p.resize(ar.template Get<size_t>());
+#else
+  p.resize(ar.template Get<uint64_t>());
+#endif
+  ar.Read(p.data(), p.size() * sizeof(T));
+  return ar;
+}
+
 template <class AR, class T>
 Archive<AR>& operator<<(Archive<AR>& ar, const std::valarray<T>& p) {
 #ifdef _LINUX
@@ -14,9 +14,30 @@ limitations under the License. */
 
 #include "paddle/fluid/framework/attribute.h"
 
+#include <mutex>  // NOLINT
+
 namespace paddle {
 namespace framework {
 
+namespace {
+// Global intern table of attribute names. Ids are dense, assigned in the
+// order names are first interned, and never reused; interning usually
+// happens once per call site through a function-local static.
+size_t InternAttrName(const std::string& name) {
+  static std::mutex mtx;
+  static std::unordered_map<std::string, size_t> ids;
+  std::lock_guard<std::mutex> guard(mtx);
+  auto it = ids.find(name);
+  if (it == ids.end()) {
+    it = ids.emplace(name, ids.size()).first;
+  }
+  return it->second;
+}
+}  // namespace
+
+InternedAttrName::InternedAttrName(const std::string& name)
+    : name_(name), id_(InternAttrName(name)) {}
+
 Attribute GetAttrValue(const proto::OpDesc::Attr& attr_desc) {
   switch (attr_desc.type()) {
     case proto::AttrType::BOOLEAN: {
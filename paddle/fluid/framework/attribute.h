@@ -31,6 +31,29 @@ limitations under the License. */
 namespace paddle {
 namespace framework {
 
+// Interned attribute name. The global intern table assigns each distinct
+// attribute name a small dense id exactly once; declaring the name as a
+// function-local static hoists the string hash out of the hot path, so
+// repeated attribute reads resolve through an integer compare instead of
+// hashing the name on every call:
+//
+//   static const framework::InternedAttrName kAxis("axis");
+//   int axis = ctx.Attr<int>(kAxis);
+//
+// The plain string overloads stay available, interning is opt-in for the
+// accesses that show up in profiles.
+class InternedAttrName {
+ public:
+  explicit InternedAttrName(const std::string& name);
+
+  const std::string& name() const { return name_; }
+  size_t id() const { return id_; }
+
+ private:
+  std::string name_;
+  size_t id_;
+};
+
 template <typename T>
 struct ExtractAttribute {
   explicit ExtractAttribute(const std::string& attr_name)
@@ -21,6 +21,8 @@
 
 #include <glog/logging.h>
 #include <algorithm>
+#include <atomic>
+#include <chrono>              // NOLINT
 #include <condition_variable>  // NOLINT
 #include <deque>
 #include <limits>
@@ -43,8 +45,44 @@ class ChannelObject {
     capacity_ = (std::min)(MaxCapacity(), capacity);
   }
 
-  const std::deque<T>& GetData() const { return data_; }
+  // Bounded lock-free mode: Read/Write transfer elements through a fixed
+  // MPMC ring buffer with one atomic reservation per element instead of
+  // the mutex+condvar protocol, which removes the futex traffic of
+  // heavily contended channels. Blocked readers and writers still park
+  // on the condvars, but only after the ring has been observed
+  // empty/full for a whole spin round, and they recheck every
+  // millisecond so a missed notify costs bounded latency. The ring
+  // capacity is rounded up to a power of two; SetCapacity and GetData
+  // are not supported in this mode.
+  ChannelObject(size_t capacity, bool lock_free) {
+    capacity_ = (std::min)(MaxCapacity(), capacity);
+    if (!lock_free) {
+      return;
+    }
+    CHECK(capacity >= 1 && capacity < MaxCapacity())
+        << "lock free channel must have a bounded capacity";
+    ring_size_ = 1;
+    while (ring_size_ < capacity) {
+      ring_size_ <<= 1;
+    }
+    capacity_ = ring_size_;
+    ring_.reset(new Cell[ring_size_]);
+    for (size_t i = 0; i < ring_size_; ++i) {
+      ring_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  const std::deque<T>& GetData() const {
+    CHECK(ring_ == nullptr) << "lock free channel can not expose its data";
+    return data_;
+  }
   void Clear() {
+    if (ring_ != nullptr) {
+      T val;
+      while (TryPop(&val)) {
+      }
+      return;
+    }
     std::unique_lock<std::mutex> lock(mutex_);
     data_.clear();
     data_.shrink_to_fit();
@@ -55,6 +93,7 @@ class ChannelObject {
   }
 
   void SetCapacity(size_t x) {  // capacity can be zero
+    CHECK(ring_ == nullptr) << "lock free channel can not be resized";
     std::lock_guard<std::mutex> lock(mutex_);
     capacity_ = std::min(MaxCapacity(), x);
     Notify();
@@ -96,11 +135,19 @@ class ChannelObject {
   }
 
   size_t Size() {
+    if (ring_ != nullptr) {
+      size_t enqueued = enqueue_pos_.load(std::memory_order_acquire);
+      size_t dequeued = dequeue_pos_.load(std::memory_order_acquire);
+      return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
     std::lock_guard<std::mutex> lock(mutex_);
     return data_.size();
   }
 
   bool Empty() {
+    if (ring_ != nullptr) {
+      return Size() == 0;
+    }
     std::lock_guard<std::mutex> lock(mutex_);
     return EmptyUnlocked();
   }
@@ -114,6 +161,9 @@ class ChannelObject {
     if (n == 0) {
       return 0;
     }
+    if (ring_ != nullptr) {
+      return ReadLockFree(n, p, false);
+    }
 
     std::unique_lock<std::mutex> lock(mutex_);
     size_t finished = Read(n, p, lock);
@@ -133,6 +183,9 @@ class ChannelObject {
     if (n == 0) {
       return 0;
     }
+    if (ring_ != nullptr) {
+      return WriteLockFree(n, p);
+    }
     std::unique_lock<std::mutex> lock(mutex_);
     size_t finished = Write(n, p, lock);
     Notify();
@@ -144,6 +197,9 @@ class ChannelObject {
     if (n == 0) {
       return 0;
     }
+    if (ring_ != nullptr) {
+      return WriteMoveLockFree(n, p);
+    }
     std::unique_lock<std::mutex> lock(mutex_);
     size_t finished = WriteMove(n, p, lock);
     Notify();
@@ -162,6 +218,12 @@ class ChannelObject {
     if (size == 0) {
       return 0;
     }
+    if (ring_ != nullptr) {
+      p.resize(size);
+      size_t finished = ReadLockFree(size, &p[0], true);
+      p.resize(finished);
+      return finished;
+    }
     std::unique_lock<std::mutex> lock(mutex_);
     p.resize(size);
     size_t finished = Read(size, &p[0], lock, true);
@@ -192,6 +254,11 @@ class ChannelObject {
   size_t Write(std::vector<T>&& p) { return WriteMove(p.size(), &p[0]); }
 
  private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T data;
+  };
+
   size_t capacity_ = MaxCapacity();
   size_t block_size_ = 1024;
   bool closed_ = false;
@@ -199,15 +266,159 @@ class ChannelObject {
   // use deque to store data
   std::deque<T> data_;
   size_t reading_count_ = 0;
-  int empty_waiters_ = 0;
-  int full_waiters_ = 0;
+  std::atomic<int> empty_waiters_{0};
+  std::atomic<int> full_waiters_{0};
   std::condition_variable empty_cond_;
   std::condition_variable full_cond_;
+  // the lock free mode stores data in a MPMC ring buffer instead of the
+  // deque; ring_ being null selects the mutex+condvar implementation
+  std::unique_ptr<Cell[]> ring_;
+  size_t ring_size_ = 0;
+  std::atomic<size_t> enqueue_pos_{0};
+  std::atomic<size_t> dequeue_pos_{0};
+
+  static constexpr int kSpinCount = 1024;
 
   static constexpr size_t MaxCapacity() {
     return (std::numeric_limits<size_t>::max)() / 2;
   }
 
+  // single element reservation on the ring, following the classic
+  // bounded MPMC scheme: a cell is free for writing when its sequence
+  // equals the enqueue position, and holds data when it equals the
+  // dequeue position plus one
+  template <class U>
+  bool TryPush(U&& val) {
+    Cell* cell = nullptr;
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &ring_[pos & (ring_size_ - 1)];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (dif == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        return false;  // full
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->data = std::forward<U>(val);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool TryPop(T* val) {
+    Cell* cell = nullptr;
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &ring_[pos & (ring_size_ - 1)];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      intptr_t dif =
+          static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if (dif == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        return false;  // empty
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    *val = std::move(cell->data);
+    cell->sequence.store(pos + ring_size_, std::memory_order_release);
+    return true;
+  }
+
+  // park on a condvar after the spin round failed; the timed wait makes
+  // a missed notify cost at most one millisecond instead of a hang
+  void ParkLockFree(std::condition_variable& cond,   // NOLINT
+                    std::atomic<int>& waiters) {     // NOLINT
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++waiters;
+    cond.wait_for(lock, std::chrono::milliseconds(1));
+    --waiters;
+  }
+
+  size_t ReadLockFree(size_t n, T* p, bool once) {
+    size_t finished = 0;
+    int spins = 0;
+    while (finished < n) {
+      if (TryPop(&p[finished])) {
+        ++finished;
+        spins = 0;
+        if (full_waiters_.load(std::memory_order_relaxed) != 0) {
+          full_cond_.notify_one();
+        }
+        continue;
+      }
+      if (once && finished > 0) {
+        break;
+      }
+      if (closed_) {
+        // drain what racing writers published before the close
+        if (!TryPop(&p[finished])) {
+          break;
+        }
+        ++finished;
+        continue;
+      }
+      if (++spins < kSpinCount) {
+        continue;
+      }
+      spins = 0;
+      ParkLockFree(empty_cond_, empty_waiters_);
+    }
+    return finished;
+  }
+
+  size_t WriteLockFree(size_t n, const T* p) {
+    size_t finished = 0;
+    int spins = 0;
+    while (finished < n && !closed_) {
+      if (TryPush(p[finished])) {
+        ++finished;
+        spins = 0;
+        if (empty_waiters_.load(std::memory_order_relaxed) != 0) {
+          empty_cond_.notify_one();
+        }
+        continue;
+      }
+      if (++spins < kSpinCount) {
+        continue;
+      }
+      spins = 0;
+      ParkLockFree(full_cond_, full_waiters_);
+    }
+    return finished;
+  }
+
+  size_t WriteMoveLockFree(size_t n, T* p) {
+    size_t finished = 0;
+    int spins = 0;
+    while (finished < n && !closed_) {
+      if (TryPush(std::move(p[finished]))) {
+        ++finished;
+        spins = 0;
+        if (empty_waiters_.load(std::memory_order_relaxed) != 0) {
+          empty_cond_.notify_one();
+        }
+        continue;
+      }
+      if (++spins < kSpinCount) {
+        continue;
+      }
+      spins = 0;
+      ParkLockFree(full_cond_, full_waiters_);
+    }
+    return finished;
+  }
+
   void Notify() {
     if (empty_waiters_ != 0 && (!EmptyUnlocked() || closed_)) {
       empty_cond_.notify_one();
@@ -310,6 +521,12 @@ Channel<T> MakeChannel(size_t capacity = (std::numeric_limits<size_t>::max)()) {
   return std::make_shared<ChannelObject<T>>(capacity);
 }
 
+// bounded channel, optionally backed by the lock-free MPMC ring buffer
+template <class T>
+Channel<T> MakeChannel(size_t capacity, bool lock_free) {
+  return std::make_shared<ChannelObject<T>>(capacity, lock_free);
+}
+
 template <class T, class U>
 Channel<T> MakeChannel(const Channel<U>& other) {
   CHECK(other != nullptr) << "channel can not be NULL";
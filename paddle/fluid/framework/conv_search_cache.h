@@ -14,8 +14,15 @@ limitations under the License. */
 
 #pragma once
 
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
 #include "paddle/fluid/framework/op_registry.h"
 #include "paddle/fluid/framework/operator_kernel_configs.h"
+#include "paddle/fluid/platform/gpu_info.h"
+#include "paddle/fluid/platform/port.h"
 
 #ifdef PADDLE_WITH_HIP
 #include "paddle/fluid/platform/miopen_helper.h"
@@ -23,6 +30,14 @@ limitations under the License. */
 #include "paddle/fluid/platform/cudnn_helper.h"
 #endif
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+DECLARE_string(conv_search_cache_path);
+
 namespace paddle {
 namespace framework {
 
@@ -66,11 +81,107 @@ class ConvSearchCache {
 #endif
 
  private:
-  ConvSearchCache() {}
-  ~ConvSearchCache() {}
+  ConvSearchCache() { LoadFromDisk(); }
+  ~ConvSearchCache() { SaveToDisk(); }
   ConvSearchCache(const ConvSearchCache&) {}
   ConvSearchCache& operator=(const ConvSearchCache&) {}
 
+  // Returns the cache file path keyed by the cuDNN/MIOpen version and the
+  // device architecture, so results never outlive a library or hardware
+  // change. Empty string means persistence is disabled.
+  std::string CacheFilePath() {
+#ifdef _WIN32
+    return "";
+#else
+    if (FLAGS_conv_search_cache_path.empty()) {
+      return "";
+    }
+    std::ostringstream ss;
+    ss << FLAGS_conv_search_cache_path << "/conv_search_cache";
+#ifdef PADDLE_WITH_HIP
+    ss << "_miopen";
+#else
+    ss << "_cudnn" << CUDNN_VERSION;
+#endif
+    ss << "_cc"
+       << platform::GetCUDAComputeCapability(platform::GetCurrentDeviceId())
+       << ".bin";
+    return ss.str();
+#endif
+  }
+
+  // Preloads previously persisted search results, shared with the other
+  // processes on the host through the page cache.
+  void LoadFromDisk() {
+#ifndef _WIN32
+    cache_file_path_ = CacheFilePath();
+    if (cache_file_path_.empty()) {
+      return;
+    }
+    int lock_fd =
+        open((cache_file_path_ + ".lock").c_str(), O_RDWR | O_CREAT, 0644);
+    if (lock_fd != -1) {
+      flock(lock_fd, LOCK_SH);
+    }
+    DeserializeAll(cache_file_path_);
+    if (lock_fd != -1) {
+      flock(lock_fd, LOCK_UN);
+      close(lock_fd);
+    }
+#endif
+  }
+
+  // Persists the accumulated search results at process exit. Entries
+  // written by other processes in the meantime are merged in first, and
+  // the file is committed with an atomic rename under an exclusive lock.
+  void SaveToDisk() {
+#ifndef _WIN32
+    if (cache_file_path_.empty()) {
+      return;
+    }
+    MkDirRecursively(DirName(cache_file_path_).c_str());
+    int lock_fd =
+        open((cache_file_path_ + ".lock").c_str(), O_RDWR | O_CREAT, 0644);
+    if (lock_fd != -1) {
+      flock(lock_fd, LOCK_EX);
+    }
+    DeserializeAll(cache_file_path_);
+    std::string tmp_path =
+        cache_file_path_ + ".tmp." + std::to_string(getpid());
+    {
+      std::ofstream fout(tmp_path, std::ios::binary | std::ios::trunc);
+      if (fout) {
+        forward_cache_.Serialize(&fout);
+        backward_data_cache_.Serialize(&fout);
+        backward_filter_cache_.Serialize(&fout);
+        fusion_forward_cache_.Serialize(&fout);
+      }
+    }
+    if (rename(tmp_path.c_str(), cache_file_path_.c_str()) != 0) {
+      std::remove(tmp_path.c_str());
+    }
+    if (lock_fd != -1) {
+      flock(lock_fd, LOCK_UN);
+      close(lock_fd);
+    }
+#endif
+  }
+
+  // Merges the on-disk entries (if any) into the in-memory caches.
+  void DeserializeAll(const std::string& path) {
+    std::ifstream fin(path, std::ios::binary);
+    if (!fin) {
+      return;
+    }
+    forward_cache_.Deserialize(&fin);
+    backward_data_cache_.Deserialize(&fin);
+    backward_filter_cache_.Deserialize(&fin);
+    fusion_forward_cache_.Deserialize(&fin);
+    VLOG(3) << "Preloaded conv search cache from " << path;
+  }
+
+  std::string cache_file_path_;
+
 #ifdef PADDLE_WITH_HIP
   AlgorithmsCache<miopenConvFwdAlgorithm_t> forward_cache_;
   AlgorithmsCache<miopenConvBwdDataAlgorithm_t> backward_data_cache_;
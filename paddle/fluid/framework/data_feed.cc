@@ -22,6 +22,9 @@ limitations under the License. */
 #include <stdio_ext.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 #endif
 #include "io/fs.h"
 #include "paddle/fluid/platform/monitor.h"
@@ -29,6 +32,7 @@ limitations under the License. */
 
 USE_INT_STAT(STAT_total_feasign_num_in_mem);
 DECLARE_bool(enable_ins_parser_file);
+DECLARE_bool(data_feed_lock_free_channel);
 namespace paddle {
 namespace framework {
 
@@ -275,8 +279,11 @@ void PrivateQueueDataFeed<T>::SetQueueSize(int queue_size) {
       platform::errors::InvalidArgument(
           "Queue size %d is illegal in PrivateQueueDataFeed.", queue_size));
   queue_size_ = queue_size;
-  queue_ = paddle::framework::MakeChannel<T>();
-  queue_->SetCapacity(queue_size);
+  // the queue is the only bounded channel of the feed, so it can be
+  // backed by the lock-free ring; the dataset channels stay unbounded
+  // because whole phases are buffered in them
+  queue_ = paddle::framework::MakeChannel<T>(
+      queue_size, FLAGS_data_feed_lock_free_channel);
 }
 
 template <typename T>
@@ -809,6 +816,111 @@ bool MultiSlotDataFeed::CheckFile(const char* filename) {
   return true;
 }
 
+// Fast locale-independent parsing helpers for the MultiSlot text format.
+// strtof/strtoull spend most of their time on locale handling and errno
+// bookkeeping, which the feed format never needs; the helpers below scan
+// digits directly and fall back to libc only for rare forms such as
+// exponents, inf/nan and overlong decimals.
+static inline const char* SkipBlankChars(const char* p) {
+  while (*p == ' ' || *p == '\t') {
+    ++p;
+  }
+  return p;
+}
+
+static inline int FastParseInt(const char* str, char** endptr) {
+  const char* p = SkipBlankChars(str);
+  bool negative = false;
+  if (*p == '-') {
+    negative = true;
+    ++p;
+  } else if (*p == '+') {
+    ++p;
+  }
+  int value = 0;
+  while (*p >= '0' && *p <= '9') {
+    value = value * 10 + (*p - '0');
+    ++p;
+  }
+  *endptr = const_cast<char*>(p);
+  return negative ? -value : value;
+}
+
+static inline uint64_t FastParseUint64(const char* str, char** endptr) {
+  const char* p = SkipBlankChars(str);
+  uint64_t value = 0;
+  while (*p >= '0' && *p <= '9') {
+    value = value * 10 + static_cast<uint64_t>(*p - '0');
+    ++p;
+  }
+  *endptr = const_cast<char*>(p);
+  return value;
+}
+
+static inline float FastParseFloat(const char* str, char** endptr) {
+  const char* p = SkipBlankChars(str);
+  const char* start = p;
+  bool negative = false;
+  if (*p == '-') {
+    negative = true;
+    ++p;
+  } else if (*p == '+') {
+    ++p;
+  }
+  double value = 0.0;
+  int digit_num = 0;
+  while (*p >= '0' && *p <= '9') {
+    value = value * 10.0 + (*p - '0');
+    ++p;
+    ++digit_num;
+  }
+  if (*p == '.') {
+    ++p;
+    double scale = 0.1;
+    while (*p >= '0' && *p <= '9') {
+      value += (*p - '0') * scale;
+      scale *= 0.1;
+      ++p;
+      ++digit_num;
+    }
+  }
+  // Exponents, inf/nan, hex floats and very long decimals are rare in
+  // feed data; let libc handle them so the result stays identical.
+  if (*p == 'e' || *p == 'E' || *p == 'x' || *p == 'X' || *p == 'n' ||
+      *p == 'N' || *p == 'i' || *p == 'I' || digit_num > 15) {
+    return strtof(start, endptr);
+  }
+  *endptr = const_cast<char*>(p);
+  return static_cast<float>(negative ? -value : value);
+}
+
+// Equivalent of line.find_first_of(' ', pos) over [pos, len). Unused
+// slots are skipped token by token without parsing their feasigns, so
+// this scan dominates when only a few slots are selected; SSE2 compares
+// 16 characters per step where available and the scalar tail doubles as
+// the portable fallback.
+static inline size_t FindNextSpace(const char* str, size_t pos, size_t len) {
+  if (pos >= len) {
+    return len;
+  }
+#if defined(__SSE2__)
+  const __m128i spaces = _mm_set1_epi8(' ');
+  while (pos + 16 <= len) {
+    __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + pos));
+    int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, spaces));
+    if (mask != 0) {
+      return pos + static_cast<size_t>(__builtin_ctz(mask));
+    }
+    pos += 16;
+  }
+#endif
+  while (pos < len && str[pos] != ' ') {
+    ++pos;
+  }
+  return pos;
+}
+
 bool MultiSlotDataFeed::ParseOneInstanceFromPipe(
     std::vector<MultiSlotType>* instance) {
 #ifdef _LINUX
@@ -827,7 +939,7 @@ bool MultiSlotDataFeed::ParseOneInstanceFromPipe(
     int pos = 0;
     for (size_t i = 0; i < use_slots_index_.size(); ++i) {
       int idx = use_slots_index_[i];
-      int num = strtol(&str[pos], &endptr, 10);
+      int num = FastParseInt(&str[pos], &endptr);
 
       if (num <= 0) {
         std::stringstream ss;
@@ -854,23 +966,23 @@ bool MultiSlotDataFeed::ParseOneInstanceFromPipe(
         (*instance)[idx].Init(all_slots_type_[i]);
         if ((*instance)[idx].GetType()[0] == 'f') {  // float
           for (int j = 0; j < num; ++j) {
-            float feasign = strtof(endptr, &endptr);
+            float feasign = FastParseFloat(endptr, &endptr);
             (*instance)[idx].AddValue(feasign);
           }
         } else if ((*instance)[idx].GetType()[0] == 'u') {  // uint64
           for (int j = 0; j < num; ++j) {
-            uint64_t feasign = (uint64_t)strtoull(endptr, &endptr, 10);
+            uint64_t feasign = FastParseUint64(endptr, &endptr);
             (*instance)[idx].AddValue(feasign);
           }
         }
         pos = endptr - str;
       } else {
+        size_t cur = pos;
         for (int j = 0; j <= num; ++j) {
           // pos = line.find_first_of(' ', pos + 1);
-          while (line[pos + 1] != ' ') {
-            pos++;
-          }
+          cur = FindNextSpace(str, cur + 1, line.size());
         }
+        pos = static_cast<int>(cur);
       }
     }
     return true;
@@ -892,7 +1004,7 @@ bool MultiSlotDataFeed::ParseOneInstance(std::vector<MultiSlotType>* instance) {
     int pos = 0;
     for (size_t i = 0; i < use_slots_index_.size(); ++i) {
       int idx = use_slots_index_[i];
-      int num = strtol(&str[pos], &endptr, 10);
+      int num = FastParseInt(&str[pos], &endptr);
       PADDLE_ENFORCE_NE(
           num, 0,
           platform::errors::InvalidArgument(
@@ -911,20 +1023,22 @@ bool MultiSlotDataFeed::ParseOneInstance(std::vector<MultiSlotType>* instance) {
         (*instance)[idx].Init(all_slots_type_[i]);
         if ((*instance)[idx].GetType()[0] == 'f') {  // float
           for (int j = 0; j < num; ++j) {
-            float feasign = strtof(endptr, &endptr);
+            float feasign = FastParseFloat(endptr, &endptr);
             (*instance)[idx].AddValue(feasign);
           }
         } else if ((*instance)[idx].GetType()[0] == 'u') {  // uint64
           for (int j = 0; j < num; ++j) {
-            uint64_t feasign = (uint64_t)strtoull(endptr, &endptr, 10);
+            uint64_t feasign = FastParseUint64(endptr, &endptr);
             (*instance)[idx].AddValue(feasign);
           }
         }
         pos = endptr - str;
       } else {
+        size_t cur = pos;
         for (int j = 0; j <= num; ++j) {
-          pos = line.find_first_of(' ', pos + 1);
+          cur = FindNextSpace(str, cur + 1, line.size());
         }
+        pos = static_cast<int>(cur);
       }
     }
   } else {
@@ -1146,7 +1260,7 @@ bool MultiSlotInMemoryDataFeed::ParseOneInstanceFromPipe(Record* instance) {
     }
     for (size_t i = 0; i < use_slots_index_.size(); ++i) {
       int idx = use_slots_index_[i];
-      int num = strtol(&str[pos], &endptr, 10);
+      int num = FastParseInt(&str[pos], &endptr);
       PADDLE_ENFORCE_NE(
           num, 0,
           platform::errors::InvalidArgument(
@@ -1163,7 +1277,7 @@ bool MultiSlotInMemoryDataFeed::ParseOneInstanceFromPipe(Record* instance) {
       if (idx != -1) {
         if (all_slots_type_[i][0] == 'f') {  // float
           for (int j = 0; j < num; ++j) {
-            float feasign = strtof(endptr, &endptr);
+            float feasign = FastParseFloat(endptr, &endptr);
             // if float feasign is equal to zero, ignore it
             // except when slot is dense
             if (fabs(feasign) < 1e-6 && !use_slots_is_dense_[i]) {
@@ -1175,7 +1289,7 @@ bool MultiSlotInMemoryDataFeed::ParseOneInstanceFromPipe(Record* instance) {
           }
         } else if (all_slots_type_[i][0] == 'u') {  // uint64
           for (int j = 0; j < num; ++j) {
-            uint64_t feasign = (uint64_t)strtoull(endptr, &endptr, 10);
+            uint64_t feasign = FastParseUint64(endptr, &endptr);
             // if uint64 feasign is equal to zero, ignore it
             // except when slot is dense
             if (feasign == 0 && !use_slots_is_dense_[i]) {
@@ -1188,12 +1302,12 @@ bool MultiSlotInMemoryDataFeed::ParseOneInstanceFromPipe(Record* instance) {
         }
         pos = endptr - str;
       } else {
+        size_t cur = pos;
         for (int j = 0; j <= num; ++j) {
           // pos = line.find_first_of(' ', pos + 1);
-          while (line[pos + 1] != ' ') {
-            pos++;
-          }
+          cur = FindNextSpace(str, cur + 1, line.size());
         }
+        pos = static_cast<int>(cur);
       }
     }
     instance->float_feasigns_.shrink_to_fit();
@@ -1217,7 +1331,7 @@ bool MultiSlotInMemoryDataFeed::ParseOneInstance(Record* instance) {
     int pos = 0;
     for (size_t i = 0; i < use_slots_index_.size(); ++i) {
       int idx = use_slots_index_[i];
-      int num = strtol(&str[pos], &endptr, 10);
+      int num = FastParseInt(&str[pos], &endptr);
       PADDLE_ENFORCE_NE(
           num, 0,
           platform::errors::InvalidArgument(
@@ -1235,7 +1349,7 @@ bool MultiSlotInMemoryDataFeed::ParseOneInstance(Record* instance) {
       if (idx != -1) {
         if (all_slots_type_[i][0] == 'f') {  // float
           for (int j = 0; j < num; ++j) {
-            float feasign = strtof(endptr, &endptr);
+            float feasign = FastParseFloat(endptr, &endptr);
             if (fabs(feasign) < 1e-6) {
               continue;
             }
@@ -1245,7 +1359,7 @@ bool MultiSlotInMemoryDataFeed::ParseOneInstance(Record* instance) {
           }
         } else if (all_slots_type_[i][0] == 'u') {  // uint64
           for (int j = 0; j < num; ++j) {
-            uint64_t feasign = (uint64_t)strtoull(endptr, &endptr, 10);
+            uint64_t feasign = FastParseUint64(endptr, &endptr);
             if (feasign == 0) {
               continue;
             }
@@ -1256,9 +1370,11 @@ bool MultiSlotInMemoryDataFeed::ParseOneInstance(Record* instance) {
         }
         pos = endptr - str;
       } else {
+        size_t cur = pos;
         for (int j = 0; j <= num; ++j) {
-          pos = line.find_first_of(' ', pos + 1);
+          cur = FindNextSpace(str, cur + 1, line.size());
         }
+        pos = static_cast<int>(cur);
       }
     }
     instance->float_feasigns_.shrink_to_fit();
@@ -1689,6 +1805,101 @@ bool MultiSlotFileInstantDataFeed::ParseOneMiniBatch() {
 }
 #endif
 
+int ConvertMultiSlotTextToInstantBinary(const std::string& text_filename,
+                                        const std::string& binary_filename,
+                                        const DataFeedDesc& data_feed_desc) {
+  PADDLE_ENFORCE_EQ(
+      data_feed_desc.has_multi_slot_desc(), true,
+      platform::errors::PreconditionNotMet(
+          "Multi_slot_desc has not been set in the data feed desc passed "
+          "to ConvertMultiSlotTextToInstantBinary."));
+  const auto& multi_slot_desc = data_feed_desc.multi_slot_desc();
+  size_t all_slot_num = multi_slot_desc.slots_size();
+  std::vector<char> all_slots_type(all_slot_num);
+  for (size_t i = 0; i < all_slot_num; ++i) {
+    const auto& slot = multi_slot_desc.slots(i);
+    all_slots_type[i] = slot.type()[0];
+    if (slot.is_dense()) {
+      for (int j = 0; j < slot.shape_size(); ++j) {
+        PADDLE_ENFORCE_NE(
+            slot.shape(j), -1,
+            platform::errors::Unimplemented(
+                "Slot[%s] has an inductive shape. The converter does not "
+                "emit the inductive shape entries of the instant binary "
+                "format, so only slots with fully specified shapes are "
+                "supported.",
+                slot.name().c_str()));
+      }
+    }
+  }
+
+  std::ifstream fin(text_filename);
+  PADDLE_ENFORCE_EQ(
+      fin.good(), true,
+      platform::errors::Unavailable(
+          "Fail to open file: %s in ConvertMultiSlotTextToInstantBinary.",
+          text_filename.c_str()));
+  std::ofstream fout(binary_filename, std::ios::binary | std::ios::trunc);
+  PADDLE_ENFORCE_EQ(
+      fout.good(), true,
+      platform::errors::Unavailable(
+          "Fail to create file: %s in ConvertMultiSlotTextToInstantBinary.",
+          binary_filename.c_str()));
+
+  constexpr int kMaxFeasignNum = 65535;  // the format stores num as uint16_t
+  std::string line;
+  std::vector<float> float_buffer;
+  std::vector<uint64_t> uint64_buffer;
+  int instance_num = 0;
+  while (std::getline(fin, line)) {
+    const char* str = line.c_str();
+    char* endptr = const_cast<char*>(str);
+    int pos = 0;
+    for (size_t i = 0; i < all_slot_num; ++i) {
+      int num = FastParseInt(&str[pos], &endptr);
+      PADDLE_ENFORCE_GT(
+          num, 0,
+          platform::errors::InvalidArgument(
+              "The number of ids can not be zero, you need padding "
+              "it in data generator; or if there is something wrong with "
+              "the data, please check if the data contains unresolvable "
+              "characters.\nplease check this error line: %s",
+              str));
+      PADDLE_ENFORCE_LE(
+          num, kMaxFeasignNum,
+          platform::errors::InvalidArgument(
+              "Slot[%s] of instance %d holds %d feasigns, more than the "
+              "uint16_t limit of the instant binary format.",
+              multi_slot_desc.slots(i).name().c_str(), instance_num, num));
+      uint16_t num16 = static_cast<uint16_t>(num);
+      fout.write(reinterpret_cast<const char*>(&num16), sizeof(num16));
+      if (all_slots_type[i] == 'f') {  // float
+        float_buffer.resize(num);
+        for (int j = 0; j < num; ++j) {
+          float_buffer[j] = FastParseFloat(endptr, &endptr);
+        }
+        fout.write(reinterpret_cast<const char*>(float_buffer.data()),
+                   num * sizeof(float));
+      } else if (all_slots_type[i] == 'u') {  // uint64
+        uint64_buffer.resize(num);
+        for (int j = 0; j < num; ++j) {
+          uint64_buffer[j] = FastParseUint64(endptr, &endptr);
+        }
+        fout.write(reinterpret_cast<const char*>(uint64_buffer.data()),
+                   num * sizeof(uint64_t));
+      }
+      pos = endptr - str;
+    }
+    ++instance_num;
+  }
+  PADDLE_ENFORCE_EQ(
+      fout.good(), true,
+      platform::errors::Unavailable(
+          "Fail to write file: %s in ConvertMultiSlotTextToInstantBinary.",
+          binary_filename.c_str()));
+  return instance_num;
+}
+
 bool PaddleBoxDataFeed::Start() {
 #ifdef _LINUX
   int phase = GetCurrentPhase();  // join: 1, update: 0
@@ -2333,7 +2544,7 @@ bool SlotRecordInMemoryDataFeed::ParseOneInstance(const std::string& line,
 
   for (size_t i = 0; i < all_slots_info_.size(); ++i) {
     auto& info = all_slots_info_[i];
-    int num = strtol(&str[pos], &endptr, 10);
+    int num = FastParseInt(&str[pos], &endptr);
     PADDLE_ENFORCE(num,
                    "The number of ids can not be zero, you need padding "
                    "it in data generator; or if there is something wrong with "
@@ -2345,7 +2556,7 @@ bool SlotRecordInMemoryDataFeed::ParseOneInstance(const std::string& line,
         auto& slot_fea = slot_float_feasigns[info.slot_value_idx];
         slot_fea.clear();
         for (int j = 0; j < num; ++j) {
-          float feasign = strtof(endptr, &endptr);
+          float feasign = FastParseFloat(endptr, &endptr);
           if (fabs(feasign) < 1e-6 && !used_slots_info_[info.used_idx].dense) {
             continue;
           }
@@ -2356,8 +2567,7 @@ bool SlotRecordInMemoryDataFeed::ParseOneInstance(const std::string& line,
         auto& slot_fea = slot_uint64_feasigns[info.slot_value_idx];
         slot_fea.clear();
         for (int j = 0; j < num; ++j) {
-          uint64_t feasign =
-              static_cast<uint64_t>(strtoull(endptr, &endptr, 10));
+          uint64_t feasign = FastParseUint64(endptr, &endptr);
           if (feasign == 0 && !used_slots_info_[info.used_idx].dense) {
             continue;
           }
@@ -2367,12 +2577,12 @@ bool SlotRecordInMemoryDataFeed::ParseOneInstance(const std::string& line,
       }
       pos = endptr - str;
     } else {
+      size_t cur = pos;
       for (int j = 0; j <= num; ++j) {
         // pos = line.find_first_of(' ', pos + 1);
-        while (line[pos + 1] != ' ') {
-          pos++;
-        }
+        cur = FindNextSpace(str, cur + 1, line.size());
       }
+      pos = static_cast<int>(cur);
     }
   }
   rec->slot_float_feasigns_.add_slot_feasigns(slot_float_feasigns,
@@ -1207,5 +1207,15 @@ class MultiSlotFileInstantDataFeed
 };
 #endif
 
+// Convert one file of MultiSlot text format into the compact binary
+// instance format that MultiSlotFileInstantDataFeed memory-maps: for
+// every slot of every instance a uint16_t feasign number followed by the
+// raw float/uint64 values. Converted files are loaded at epoch start by
+// mmap plus page-in instead of being re-parsed from text every time.
+// Returns the number of instances written.
+int ConvertMultiSlotTextToInstantBinary(const std::string& text_filename,
+                                        const std::string& binary_filename,
+                                        const DataFeedDesc& data_feed_desc);
+
 }  // namespace framework
 }  // namespace paddle
@@ -13,6 +13,8 @@
  *     limitations under the License. */
 
 #include "paddle/fluid/framework/data_set.h"
+#include <cstdio>
+#include <limits>
 #include "google/protobuf/text_format.h"
 #include "paddle/fluid/framework/data_feed_factory.h"
 #include "paddle/fluid/framework/io/fs.h"
@@ -417,6 +419,27 @@ void DatasetImpl<T>::LoadIntoMemory() {
 template <typename T>
 void DatasetImpl<T>::PreLoadIntoMemory() {
   VLOG(3) << "DatasetImpl<T>::PreLoadIntoMemory() begin";
+  if (preload_double_buffer_) {
+    CHECK(!preload_readers_.empty())
+        << "double buffered preload requires CreatePreLoadReaders";
+    // Load the next pass into a spare channel so the current pass keeps
+    // training from input_channel_; WaitPreLoadDone swaps the two at the
+    // pass boundary.
+    preload_input_channel_ = paddle::framework::MakeChannel<T>();
+    if (preload_budget_ins_ > 0) {
+      preload_input_channel_->SetCapacity(
+          static_cast<size_t>(preload_budget_ins_));
+    }
+    preload_threads_.clear();
+    for (size_t i = 0; i < preload_readers_.size(); ++i) {
+      preload_readers_[i]->SetInputChannel(preload_input_channel_.get());
+      preload_threads_.push_back(
+          std::thread(&paddle::framework::DataFeed::LoadIntoMemory,
+                      preload_readers_[i].get()));
+    }
+    VLOG(3) << "DatasetImpl<T>::PreLoadIntoMemory() end, double buffered";
+    return;
+  }
   if (preload_thread_num_ != 0) {
     CHECK(static_cast<size_t>(preload_thread_num_) == preload_readers_.size());
     preload_threads_.clear();
@@ -439,9 +462,24 @@ void DatasetImpl<T>::PreLoadIntoMemory() {
 template <typename T>
 void DatasetImpl<T>::WaitPreLoadDone() {
   VLOG(3) << "DatasetImpl<T>::WaitPreLoadDone() begin";
+  if (preload_double_buffer_ && preload_input_channel_ != nullptr &&
+      preload_budget_ins_ > 0) {
+    // Lift the budget so writers blocked on it can load the tail of the
+    // pass; the overlap already hid everything up to the budget.
+    preload_input_channel_->SetCapacity(std::numeric_limits<size_t>::max());
+  }
   for (std::thread& t : preload_threads_) {
     t.join();
   }
+  if (preload_double_buffer_ && preload_input_channel_ != nullptr) {
+    // Swap the preloaded pass in and repoint the training readers, whose
+    // raw input channel pointer was taken at CreateReaders time.
+    input_channel_ = preload_input_channel_;
+    preload_input_channel_ = nullptr;
+    for (size_t i = 0; i < readers_.size(); ++i) {
+      readers_[i]->SetInputChannel(input_channel_.get());
+    }
+  }
   input_channel_->Close();
   int64_t in_chan_size = input_channel_->Size();
   input_channel_->SetBlockSize(in_chan_size / thread_num_ + 1);
@@ -456,6 +494,10 @@ void DatasetImpl<T>::ReleaseMemory() {
     input_channel_->Clear();
     input_channel_ = nullptr;
   }
+  if (preload_input_channel_) {
+    preload_input_channel_->Clear();
+    preload_input_channel_ = nullptr;
+  }
   for (size_t i = 0; i < multi_output_channel_.size(); ++i) {
     if (!multi_output_channel_[i]) {
       continue;
@@ -539,6 +581,123 @@ void DatasetImpl<T>::LocalShuffle() {
           << timeline.ElapsedSec() << " seconds";
 }
 
+// do local shuffle with a fixed memory budget: spill every record into a
+// uniformly random bucket file, then stream the buckets back in random
+// order and shuffle each one in memory. A bucket is an unbiased random
+// subset of the dataset, so bucket order plus in-bucket shuffle yields a
+// uniform permutation while only one bucket is resident at a time.
+void MultiSlotDataset::LocalShuffle() {
+  if (shuffle_spill_bucket_num_ <= 0 || shuffle_spill_dir_.empty()) {
+    DatasetImpl<Record>::LocalShuffle();
+    return;
+  }
+#ifdef _LINUX
+  VLOG(3) << "MultiSlotDataset::LocalShuffle() spill begin, bucket_num="
+          << shuffle_spill_bucket_num_;
+  platform::Timer timeline;
+  timeline.Start();
+
+  if (!input_channel_ || input_channel_->Size() == 0) {
+    VLOG(3) << "MultiSlotDataset::LocalShuffle() end, no data to shuffle";
+    return;
+  }
+  auto fleet_ptr = FleetWrapper::GetInstance();
+  input_channel_->Close();
+
+  int bucket_num = shuffle_spill_bucket_num_;
+  std::vector<std::string> bucket_files(bucket_num);
+  std::vector<std::ofstream> spill_outs(bucket_num);
+  for (int i = 0; i < bucket_num; ++i) {
+    bucket_files[i] = shuffle_spill_dir_ + "/shuffle_spill_bucket_" +
+                      std::to_string(i) + ".bin";
+    spill_outs[i].open(bucket_files[i],
+                       std::ios::binary | std::ios::trunc);
+    PADDLE_ENFORCE_EQ(spill_outs[i].good(), true,
+                      platform::errors::Unavailable(
+                          "Fail to create shuffle spill file: %s.",
+                          bucket_files[i].c_str()));
+  }
+
+  // spill phase: sequential appends only, bounded by
+  // bucket_num * kSpillBlockBytes of archive buffers
+  constexpr size_t kSpillBlockBytes = 16 << 20;
+  std::vector<BinaryArchive> ars(bucket_num);
+  std::vector<Record> data;
+  while (input_channel_->Read(data)) {
+    for (auto& rec : data) {
+      int bucket = fleet_ptr->LocalRandomEngine()() % bucket_num;
+      ars[bucket] << rec;
+      if (ars[bucket].Length() >= kSpillBlockBytes) {
+        spill_outs[bucket].write(ars[bucket].Buffer(), ars[bucket].Length());
+        ars[bucket].Clear();
+      }
+    }
+    data.clear();
+    data.shrink_to_fit();
+  }
+  for (int i = 0; i < bucket_num; ++i) {
+    if (ars[i].Length() != 0) {
+      spill_outs[i].write(ars[i].Buffer(), ars[i].Length());
+      ars[i].Clear();
+    }
+    PADDLE_ENFORCE_EQ(spill_outs[i].good(), true,
+                      platform::errors::Unavailable(
+                          "Fail to write shuffle spill file: %s.",
+                          bucket_files[i].c_str()));
+    spill_outs[i].close();
+  }
+  ars.clear();
+  ars.shrink_to_fit();
+  input_channel_->Clear();
+
+  // stream-back phase: buckets in random order, each one shuffled in
+  // memory before it is written back to the channel
+  std::vector<int> bucket_order(bucket_num);
+  for (int i = 0; i < bucket_num; ++i) {
+    bucket_order[i] = i;
+  }
+  std::shuffle(bucket_order.begin(), bucket_order.end(),
+               fleet_ptr->LocalRandomEngine());
+  input_channel_->Open();
+  for (int i : bucket_order) {
+    std::ifstream fin(bucket_files[i], std::ios::binary | std::ios::ate);
+    PADDLE_ENFORCE_EQ(fin.good(), true,
+                      platform::errors::Unavailable(
+                          "Fail to open shuffle spill file: %s.",
+                          bucket_files[i].c_str()));
+    size_t length = static_cast<size_t>(fin.tellg());
+    fin.seekg(0);
+    if (length == 0) {
+      fin.close();
+      std::remove(bucket_files[i].c_str());
+      continue;
+    }
+    std::vector<char> buffer(length);
+    fin.read(buffer.data(), length);
+    fin.close();
+    std::remove(bucket_files[i].c_str());
+
+    BinaryArchive ar;
+    ar.SetReadBuffer(buffer.data(), length, nullptr);
+    std::vector<Record> bucket_data;
+    while (ar.Cursor() < ar.Finish()) {
+      bucket_data.push_back(ar.Get<Record>());
+    }
+    CHECK(ar.Cursor() == ar.Finish());
+    std::shuffle(bucket_data.begin(), bucket_data.end(),
+                 fleet_ptr->LocalRandomEngine());
+    input_channel_->Write(std::move(bucket_data));
+  }
+  input_channel_->Close();
+
+  timeline.Pause();
+  VLOG(3) << "MultiSlotDataset::LocalShuffle() spill end, cost time="
+          << timeline.ElapsedSec() << " seconds";
+#else
+  DatasetImpl<Record>::LocalShuffle();
+#endif
+}
+
 void MultiSlotDataset::GlobalShuffle(int thread_num) {
 #ifdef PADDLE_WITH_PSLIB
   VLOG(3) << "MultiSlotDataset::GlobalShuffle() begin";
@@ -773,6 +932,13 @@ void DatasetImpl<T>::SetFleetSendSleepSeconds(int seconds) {
   fleet_send_sleep_seconds_ = seconds;
 }
 
+template <typename T>
+void DatasetImpl<T>::SetShuffleSpill(const std::string& spill_dir,
+                                     int bucket_num) {
+  shuffle_spill_dir_ = spill_dir;
+  shuffle_spill_bucket_num_ = bucket_num;
+}
+
 template <typename T>
 void DatasetImpl<T>::CreateReaders() {
   VLOG(3) << "Calling CreateReaders()";
@@ -850,6 +1016,12 @@ void DatasetImpl<T>::SetPreLoadThreadNum(int thread_num) {
   preload_thread_num_ = thread_num;
 }
 
+template <typename T>
+void DatasetImpl<T>::SetPreLoadDoubleBuffer(bool enable, int64_t budget_ins) {
+  preload_double_buffer_ = enable;
+  preload_budget_ins_ = budget_ins;
+}
+
 template <typename T>
 void DatasetImpl<T>::CreatePreLoadReaders() {
   VLOG(3) << "Begin CreatePreLoadReaders";
@@ -143,12 +143,25 @@ class Dataset {
   virtual void DestroyPreLoadReaders() = 0;
   // set preload thread num
   virtual void SetPreLoadThreadNum(int thread_num) = 0;
+  // double buffered preload: PreLoadIntoMemory fills a spare input
+  // channel so the next pass loads while the current one trains, and
+  // WaitPreLoadDone swaps the two at the pass boundary. budget_ins > 0
+  // caps the spare channel (in instances); preload blocks on the cap and
+  // the remainder is loaded when WaitPreLoadDone lifts it. Requires
+  // CreatePreLoadReaders.
+  virtual void SetPreLoadDoubleBuffer(bool enable, int64_t budget_ins = 0) = 0;
   // seperate train thread and dataset thread
   virtual void DynamicAdjustChannelNum(int channel_num,
                                        bool discard_remaining_ins = false) = 0;
   virtual void DynamicAdjustReadersNum(int thread_num) = 0;
   // set fleet send sleep seconds
   virtual void SetFleetSendSleepSeconds(int seconds) = 0;
+  // enable disk-backed local shuffle: records are spilled into
+  // bucket_num files under spill_dir and shuffled bucket by bucket, so
+  // the resident memory of a shuffle is one bucket instead of the whole
+  // dataset. bucket_num <= 0 keeps the in-memory shuffle.
+  virtual void SetShuffleSpill(const std::string& spill_dir,
+                               int bucket_num) = 0;
 
  protected:
   virtual int ReceiveFromClient(int msg_type, int client_id,
@@ -228,10 +241,12 @@ class DatasetImpl : public Dataset {
   virtual void CreatePreLoadReaders();
   virtual void DestroyPreLoadReaders();
   virtual void SetPreLoadThreadNum(int thread_num);
+  virtual void SetPreLoadDoubleBuffer(bool enable, int64_t budget_ins = 0);
   virtual void DynamicAdjustChannelNum(int channel_num,
                                        bool discard_remaining_ins = false);
   virtual void DynamicAdjustReadersNum(int thread_num);
   virtual void SetFleetSendSleepSeconds(int seconds);
+  virtual void SetShuffleSpill(const std::string& spill_dir, int bucket_num);
   /* for enable_heterps_
   virtual void EnableHeterps(bool enable_heterps) {
     enable_heterps_ = enable_heterps;
@@ -261,6 +276,11 @@ class DatasetImpl : public Dataset {
   std::vector<std::shared_ptr<paddle::framework::DataFeed>> readers_;
   std::vector<std::shared_ptr<paddle::framework::DataFeed>> preload_readers_;
   paddle::framework::Channel<T> input_channel_;
+  // spare input channel for double buffered preload, swapped into
+  // input_channel_ by WaitPreLoadDone, see SetPreLoadDoubleBuffer
+  paddle::framework::Channel<T> preload_input_channel_;
+  bool preload_double_buffer_ = false;
+  int64_t preload_budget_ins_ = 0;
   paddle::framework::Channel<PvInstance> input_pv_channel_;
   std::vector<paddle::framework::Channel<PvInstance>> multi_pv_output_;
   std::vector<paddle::framework::Channel<PvInstance>> multi_pv_consume_;
@@ -298,6 +318,9 @@ class DatasetImpl : public Dataset {
   int current_phase_;     // 1 join, 0 update
   size_t merge_size_;
   bool slots_shuffle_fea_eval_ = false;
+  // disk-backed local shuffle, see SetShuffleSpill
+  std::string shuffle_spill_dir_;
+  int shuffle_spill_bucket_num_ = 0;
   bool gen_uni_feasigns_ = false;
   int preload_thread_num_;
   std::mutex global_index_mutex_;
@@ -333,6 +356,7 @@ class MultiSlotDataset : public DatasetImpl<Record> {
       const std::unordered_set<uint16_t>& slots_to_replace,
       std::vector<Record>* result);
   virtual ~MultiSlotDataset() {}
+  virtual void LocalShuffle();
   virtual void GlobalShuffle(int thread_num = -1);
   virtual void DynamicAdjustReadersNum(int thread_num);
   virtual void PrepareTrain();
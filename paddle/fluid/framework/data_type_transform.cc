@@ -14,12 +14,140 @@ limitations under the License. */
 
 #include "paddle/fluid/framework/data_type_transform.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "paddle/fluid/framework/selected_rows.h"
+#include "paddle/fluid/platform/cpu_info.h"
 #include "paddle/fluid/platform/transform.h"
 
+#ifdef __AVX512F__
+#include <immintrin.h>
+#endif
+#ifdef PADDLE_WITH_MKLML
+#include <omp.h>
+#endif
+
 namespace paddle {
 namespace framework {
 
+namespace {
+
+// Chunk the buffer is cut into for threading; a multiple of 16 elements, so
+// every chunk start keeps the alignment of the output pointer.
+constexpr int64_t kCastChunkSize = 1 << 16;
+// Above this output size the working set cannot stay cache-resident and
+// non-temporal stores avoid reading the destination lines just to
+// overwrite them.
+constexpr int64_t kCastNonTemporalBytes = 4 << 20;
+
+inline uint16_t Fp32ToBf16Bits(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return static_cast<uint16_t>(bits >> 16);
+}
+
+inline float Bf16BitsToFp32(uint16_t value) {
+  uint32_t bits = static_cast<uint32_t>(value) << 16;
+  float result;
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+#ifdef __AVX512F__
+inline void Fp32ToBf16Chunk(const float* in, uint16_t* out, int64_t n,
+                            bool non_temporal) {
+  int64_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m512i v = _mm512_loadu_si512(reinterpret_cast<const void*>(in + i));
+    __m256i b = _mm512_cvtepi32_epi16(_mm512_srli_epi32(v, 16));
+    if (non_temporal) {
+      _mm256_stream_si256(reinterpret_cast<__m256i*>(out + i), b);
+    } else {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), b);
+    }
+  }
+  for (; i < n; ++i) out[i] = Fp32ToBf16Bits(in[i]);
+}
+
+inline void Bf16ToFp32Chunk(const uint16_t* in, float* out, int64_t n,
+                            bool non_temporal) {
+  int64_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    __m512i v = _mm512_slli_epi32(_mm512_cvtepu16_epi32(b), 16);
+    if (non_temporal) {
+      _mm512_stream_si512(reinterpret_cast<void*>(out + i), v);
+    } else {
+      _mm512_storeu_si512(reinterpret_cast<void*>(out + i), v);
+    }
+  }
+  for (; i < n; ++i) out[i] = Bf16BitsToFp32(in[i]);
+}
+#endif
+
+}  // namespace
+
+void CastCpuFp32ToBf16(const float* in, platform::bfloat16* out,
+                       int64_t numel) {
+  uint16_t* out_bits = reinterpret_cast<uint16_t*>(out);
+#ifdef __AVX512F__
+  if (platform::MayIUse(platform::avx512f)) {
+    const bool non_temporal =
+        numel * static_cast<int64_t>(sizeof(uint16_t)) >=
+            kCastNonTemporalBytes &&
+        reinterpret_cast<uintptr_t>(out_bits) % 32 == 0;
+    const int64_t num_chunks =
+        (numel + kCastChunkSize - 1) / kCastChunkSize;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for if (num_chunks > 1)
+#endif
+    for (int64_t c = 0; c < num_chunks; ++c) {
+      int64_t begin = c * kCastChunkSize;
+      int64_t end = std::min(numel, begin + kCastChunkSize);
+      Fp32ToBf16Chunk(in + begin, out_bits + begin, end - begin,
+                      non_temporal);
+    }
+    if (non_temporal) _mm_sfence();
+    return;
+  }
+#endif
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for if (numel > kCastChunkSize)
+#endif
+  for (int64_t i = 0; i < numel; ++i) out_bits[i] = Fp32ToBf16Bits(in[i]);
+}
+
+void CastCpuBf16ToFp32(const platform::bfloat16* in, float* out,
+                       int64_t numel) {
+  const uint16_t* in_bits = reinterpret_cast<const uint16_t*>(in);
+#ifdef __AVX512F__
+  if (platform::MayIUse(platform::avx512f)) {
+    const bool non_temporal =
+        numel * static_cast<int64_t>(sizeof(float)) >=
+            kCastNonTemporalBytes &&
+        reinterpret_cast<uintptr_t>(out) % 64 == 0;
+    const int64_t num_chunks =
+        (numel + kCastChunkSize - 1) / kCastChunkSize;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for if (num_chunks > 1)
+#endif
+    for (int64_t c = 0; c < num_chunks; ++c) {
+      int64_t begin = c * kCastChunkSize;
+      int64_t end = std::min(numel, begin + kCastChunkSize);
+      Bf16ToFp32Chunk(in_bits + begin, out + begin, end - begin,
+                      non_temporal);
+    }
+    if (non_temporal) _mm_sfence();
+    return;
+  }
+#endif
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for if (numel > kCastChunkSize)
+#endif
+  for (int64_t i = 0; i < numel; ++i) out[i] = Bf16BitsToFp32(in_bits[i]);
+}
+
 template <typename InType, typename OutType>
 struct CastDataTypeFunctor {
   HOSTDEVICE inline OutType operator()(InType in) const {
@@ -43,6 +171,9 @@ struct CastDataType {
     auto* out_begin = out_->mutable_data<OutType>(in_.place());
 
     if (platform::is_cpu_place(in_.place())) {
+      if (TryCastCpuFast(in_begin, out_begin, in_.numel())) {
+        return;
+      }
       platform::Transform<platform::CPUDeviceContext> trans;
       auto* context = static_cast<const platform::CPUDeviceContext*>(ctx_);
       trans(*context, in_begin, in_end, out_begin,
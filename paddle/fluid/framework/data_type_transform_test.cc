@@ -14,6 +14,8 @@ limitations under the License. */
 
 #include "paddle/fluid/framework/data_type_transform.h"
 
+#include <vector>
+
 #include "gtest/gtest.h"
 
 TEST(DataTypeTransform, CPUTransform) {
@@ -311,3 +313,29 @@ TEST(DataTypeTransform, CPUTransform) {
     }
   }
 }
+
+TEST(DataTypeTransform, CPUFastBf16Cast) {
+  // Exercise the vectorized fp32<->bf16 engine across full SIMD blocks and
+  // a scalar remainder, and check it matches the bfloat16 constructor bit
+  // for bit.
+  const int64_t data_number = 4099;
+  std::vector<float> in_float(data_number);
+  for (int64_t i = 0; i < data_number; ++i) {
+    in_float[i] = 0.13f * static_cast<float>(i) - 250.f;
+  }
+
+  std::vector<paddle::platform::bfloat16> out_bf16(data_number);
+  paddle::framework::CastCpuFp32ToBf16(in_float.data(), out_bf16.data(),
+                                       data_number);
+  for (int64_t i = 0; i < data_number; ++i) {
+    EXPECT_EQ(out_bf16[i].x,
+              static_cast<paddle::platform::bfloat16>(in_float[i]).x);
+  }
+
+  std::vector<float> out_float(data_number);
+  paddle::framework::CastCpuBf16ToFp32(out_bf16.data(), out_float.data(),
+                                       data_number);
+  for (int64_t i = 0; i < data_number; ++i) {
+    EXPECT_EQ(out_float[i], static_cast<float>(out_bf16[i]));
+  }
+}
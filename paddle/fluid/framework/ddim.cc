@@ -67,7 +67,10 @@ struct ProductVisitor {
 };
 
 int64_t product(const DDim& ddim) {
-  return ddim.apply_visitor(ProductVisitor());
+  if (ddim.cached_numel_ == DDim::kUnknownNumel) {
+    ddim.cached_numel_ = ddim.apply_visitor(ProductVisitor());
+  }
+  return ddim.cached_numel_;
 }
 
 bool contain_unknown_dim(const DDim& ddim) {
@@ -142,23 +145,51 @@ DDim flatten_to_2d(const DDim& src, int num_col_dims) {
 
 DDim flatten_to_1d(const DDim& src) { return DDim({product(src)}); }
 
+// The rank is a compile-time constant inside the visitors, so the loops
+// below are fully unrolled and free of the per-element rank branch.
+struct StrideVisitor {
+  explicit StrideVisitor(int64_t* out) : out_(out) {}
+
+  template <int D>
+  inline void operator()(const Dim<D>& in) const {
+    if (D > 0) {
+      out_[D - 1] = 1;
+      for (int i = D - 2; i >= 0; --i) {
+        out_[i] = out_[i + 1] * in[i + 1];
+      }
+    }
+  }
+
+  int64_t* out_;
+};
+
+struct StrideNumelVisitor {
+  explicit StrideNumelVisitor(int64_t* out) : out_(out) {}
+
+  template <int D>
+  inline void operator()(const Dim<D>& in) const {
+    if (D > 0) {
+      out_[D - 1] = in[D - 1];
+      for (int i = D - 2; i >= 0; --i) {
+        out_[i] = out_[i + 1] * in[i];
+      }
+    }
+  }
+
+  int64_t* out_;
+};
+
 DDim stride(const DDim& ddim) {
   DDim strides;
   strides.rank_ = ddim.size();
-  strides[ddim.size() - 1] = 1;
-  for (int i = ddim.size() - 2; i >= 0; --i) {
-    strides[i] = strides[i + 1] * ddim[i + 1];
-  }
+  ddim.apply_visitor(StrideVisitor(strides.GetMutable()));
   return strides;
 }
 
 DDim stride_numel(const DDim& ddim) {
   DDim strides;
   strides.rank_ = ddim.size();
-  strides[ddim.size() - 1] = ddim[ddim.size() - 1];
-  for (int i = ddim.size() - 2; i >= 0; --i) {
-    strides[i] = strides[i + 1] * ddim[i];
-  }
+  ddim.apply_visitor(StrideNumelVisitor(strides.GetMutable()));
   return strides;
 }
 
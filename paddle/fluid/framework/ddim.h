@@ -89,14 +89,20 @@ class DDim {
   inline DDim& operator=(const Dim<D>& dim) {
     rank_ = D;
     UnsafeCast<D>() = dim;
+    cached_numel_ = kUnknownNumel;
     return *this;
   }
 
-  inline int64_t& operator[](int idx) { return dim_[idx]; }
+  inline int64_t& operator[](int idx) {
+    // A mutable reference escapes, the cached product can go stale.
+    cached_numel_ = kUnknownNumel;
+    return dim_[idx];
+  }
 
   inline int64_t operator[](int idx) const { return dim_[idx]; }
 
   int64_t& at(int idx) {
+    cached_numel_ = kUnknownNumel;
     PADDLE_ENFORCE_GE(idx, 0,
                       platform::errors::InvalidArgument(
                           "Invalid DDim index to be accessed. The valid index "
@@ -127,6 +133,7 @@ class DDim {
   template <typename Visitor>
   typename std::result_of<Visitor(Dim<0>&)>::type apply_visitor(
       Visitor&& visitor) {
+    cached_numel_ = kUnknownNumel;
     PADDLE_VISIT_DDIM(rank_, visitor(UnsafeCast<kRank>()));
   }
 
@@ -142,7 +149,10 @@ class DDim {
 
   inline const int64_t* Get() const { return dim_.Get(); }
 
-  inline int64_t* GetMutable() { return dim_.GetMutable(); }
+  inline int64_t* GetMutable() {
+    cached_numel_ = kUnknownNumel;
+    return dim_.GetMutable();
+  }
 
   inline int size() const { return rank_; }
 
@@ -168,15 +178,24 @@ class DDim {
   }
 
   inline DDim& CopyFrom(const DDim& ddim) {
-    PADDLE_VISIT_DDIM(ddim.rank_, (*this = ddim.UnsafeCast<kRank>()));
+    rank_ = ddim.rank_;
+    dynamic_dim_assign(ddim.Get(), dim_.GetMutable(), rank_);
+    cached_numel_ = ddim.cached_numel_;
+    return *this;
   }
 
   friend DDim stride(const DDim& ddim);
   friend DDim stride_numel(const DDim& ddim);
+  friend int64_t product(const DDim& ddim);
 
  private:
+  static constexpr int64_t kUnknownNumel = -1;
+
   Dim<kMaxRank> dim_;
   int rank_;
+  // Product of dim_[0..rank_), computed lazily by product() and dropped
+  // whenever a mutable handle to the dims is handed out.
+  mutable int64_t cached_numel_{kUnknownNumel};
 };
 
 #undef PADDLE_VISIT_DDIM_BASE
@@ -13,9 +13,15 @@
 // limitations under the License.
 #include "paddle/fluid/framework/details/all_reduce_op_handle.h"
 
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
 #include "paddle/fluid/framework/details/container_cast.h"
 #include "paddle/fluid/framework/details/reduce_and_gather.h"
+#include "paddle/fluid/framework/selected_rows.h"
 #include "paddle/fluid/platform/profiler.h"
+#include "paddle/fluid/string/string_helper.h"
 
 #if defined(PADDLE_WITH_NCCL) || defined(PADDLE_WITH_RCCL)
 DECLARE_bool(sync_nccl_allreduce);
@@ -100,6 +106,21 @@ void AllReduceOpHandle::AllReduceImpl(
           "%d and the number of places is %d.",
           in_var_handles.size(), num_places));
 
+#if defined(PADDLE_WITH_NCCL) || defined(PADDLE_WITH_RCCL)
+  auto *first_var = local_exec_scopes_[0]->FindVar(in_var_handles[0]->name());
+  PADDLE_ENFORCE_NOT_NULL(first_var, platform::errors::NotFound(
+                                         "Variable %s is not found in local "
+                                         "scope.",
+                                         in_var_handles[0]->name()));
+  if (first_var->IsType<framework::SelectedRows>()) {
+    // Sparse gradients (e.g. produced by lookup_table with is_sparse=True)
+    // only hold the touched rows, so exchange rows and values directly
+    // instead of densifying the whole parameter before the allreduce.
+    NCCLSelectedRowsAllReduce(in_var_handles, out_var_handles);
+    return;
+  }
+#endif
+
   std::vector<const void *> lod_tensor_data;
   std::vector<platform::Place> places;
   lod_tensor_data.reserve(num_places);
@@ -301,6 +322,210 @@ void AllReduceOpHandle::SyncNCCLAllReduce() {
     }
   }
 }
+
+void AllReduceOpHandle::NCCLSelectedRowsAllReduce(
+    const std::vector<VarHandle *> &in_var_handles,
+    const std::vector<VarHandle *> &out_var_handles) {
+#if NCCL_VERSION_CODE >= 2212
+  PADDLE_ENFORCE_NOT_NULL(nccl_ctxs_,
+                          platform::errors::InvalidArgument(
+                              "The nccl context should not be NULL."));
+  PADDLE_ENFORCE_EQ(use_hierarchical_allreduce_, false,
+                    platform::errors::Unimplemented(
+                        "Hierarchical allreduce does not support SelectedRows "
+                        "gradients currently."));
+
+  size_t num_places = places_.size();
+  std::vector<const framework::SelectedRows *> srcs;
+  srcs.reserve(num_places);
+  for (size_t i = 0; i < num_places; ++i) {
+    auto *var = local_exec_scopes_[i]->FindVar(in_var_handles[i]->name());
+    PADDLE_ENFORCE_NOT_NULL(var, platform::errors::NotFound(
+                                     "Variable %s is not found in local scope.",
+                                     in_var_handles[i]->name()));
+    PADDLE_ENFORCE_EQ(
+        in_var_handles[i]->name(), out_var_handles[i]->name(),
+        platform::errors::InvalidArgument(
+            "The name of input and output of all_reduce op should be equal, "
+            "but got input is %s and output is %s.",
+            in_var_handles[i]->name(), out_var_handles[i]->name()));
+    auto &sr = var->Get<framework::SelectedRows>();
+    PADDLE_ENFORCE_EQ(platform::is_gpu_place(sr.value().place()), true,
+                      platform::errors::Unimplemented(
+                          "The SelectedRows allreduce only supports GPU "
+                          "gradients currently."));
+    srcs.emplace_back(&sr);
+  }
+
+  auto dtype = srcs[0]->value().type();
+  auto height = srcs[0]->height();
+  for (auto *src : srcs) {
+    PADDLE_ENFORCE_EQ(
+        dtype, src->value().type(),
+        platform::errors::PreconditionNotMet(
+            "The dtype of SelectedRows of the same variable in different "
+            "local scopes should be equal."));
+    PADDLE_ENFORCE_EQ(
+        height, src->height(),
+        platform::errors::PreconditionNotMet(
+            "The height of SelectedRows of the same variable in different "
+            "local scopes should be equal."));
+  }
+  ncclDataType_t nccl_dtype = platform::ToNCCLDataType(dtype);
+  auto *nccl_ctxs = nccl_ctxs_->GetRunEnvNCCLCtx(run_order_, false);
+
+  int nranks = 0;
+  {
+    int dev_id = BOOST_GET_CONST(platform::CUDAPlace, places_[0]).device;
+    PADDLE_ENFORCE_CUDA_SUCCESS(
+        platform::dynload::ncclCommCount(nccl_ctxs->at(dev_id).comm_, &nranks));
+  }
+
+  // 1. Gather the rows number of every rank, so each place can size its
+  // result before the data exchange. The gathered counts are the same
+  // everywhere, so they only have to be read back from the first place.
+  std::vector<framework::Vector<int64_t>> rows_num_vectors;
+  rows_num_vectors.reserve(num_places);
+  for (size_t i = 0; i < num_places; ++i) {
+    rows_num_vectors.emplace_back(static_cast<size_t>(nranks));
+  }
+  std::vector<std::function<void()>> gather_rows_num_calls;
+  std::vector<gpuStream_t> streams(num_places);
+  for (size_t i = 0; i < num_places; ++i) {
+    int dev_id = BOOST_GET_CONST(platform::CUDAPlace, places_[i]).device;
+    auto &nccl_ctx = nccl_ctxs->at(dev_id);
+    auto stream = nccl_ctx.stream();
+    auto comm = nccl_ctx.comm_;
+    streams[i] = stream;
+
+    int rank = 0;
+    PADDLE_ENFORCE_CUDA_SUCCESS(
+        platform::dynload::ncclCommUserRank(comm, &rank));
+    rows_num_vectors[i][rank] = static_cast<int64_t>(srcs[i]->rows().size());
+    // CUDAMutableData copies host to device on the calculation stream, while
+    // the collectives below run on the communication stream.
+    auto *gpu_rows_num_ptr = rows_num_vectors[i].CUDAMutableData(places_[i]);
+    platform::DeviceContextPool::Instance().Get(places_[i])->Wait();
+    gather_rows_num_calls.emplace_back([=] {
+      PADDLE_ENFORCE_CUDA_SUCCESS(platform::dynload::ncclAllGather(
+          gpu_rows_num_ptr + rank, gpu_rows_num_ptr, 1, ncclInt64, comm,
+          stream));
+    });
+  }
+  {
+    platform::NCCLGroupGuard guard;
+    for (auto &call : gather_rows_num_calls) {
+      call();
+    }
+  }
+  for (auto stream : streams) {
+#ifdef PADDLE_WITH_HIP
+    PADDLE_ENFORCE_CUDA_SUCCESS(hipStreamSynchronize(stream));
+#else
+    PADDLE_ENFORCE_CUDA_SUCCESS(cudaStreamSynchronize(stream));
+#endif
+  }
+
+  const auto *cpu_rows_num_ptr = rows_num_vectors[0].data();
+  auto rows_num = std::accumulate(cpu_rows_num_ptr, cpu_rows_num_ptr + nranks,
+                                  static_cast<int64_t>(0));
+  PADDLE_ENFORCE_GT(rows_num, 0,
+                    platform::errors::PreconditionNotMet(
+                        "The total rows number of SelectedRows %s should be "
+                        "> 0, but got %d.",
+                        in_var_handles[0]->name(), rows_num));
+  bool all_rows_num_equal =
+      std::all_of(cpu_rows_num_ptr, cpu_rows_num_ptr + nranks,
+                  [&](int64_t row) { return row == cpu_rows_num_ptr[0]; });
+  VLOG(10) << "SelectedRows allreduce of " << in_var_handles[0]->name()
+           << ", rows per rank: "
+           << string::join_strings(rows_num_vectors[0], ',')
+           << ", total rows: " << rows_num << ", height: " << height;
+
+  // 2. Gather the rows and the values of every rank. The input and output
+  // handles refer to the same variable, so the result is built in temporary
+  // SelectedRows first and moved in after the exchange has finished.
+  std::vector<framework::SelectedRows> tmp_dsts(num_places);
+  std::vector<std::function<void()>> gather_data_calls;
+  for (size_t i = 0; i < num_places; ++i) {
+    auto &place = places_[i];
+    int dev_id = BOOST_GET_CONST(platform::CUDAPlace, place).device;
+    auto &nccl_ctx = nccl_ctxs->at(dev_id);
+    auto stream = nccl_ctx.stream();
+    auto comm = nccl_ctx.comm_;
+
+    auto &dst = tmp_dsts[i];
+    dst.set_height(height);
+    auto *dst_rows = dst.mutable_rows();
+    dst_rows->resize(rows_num);
+    auto *dst_rows_ptr = dst_rows->CUDAMutableData(place);
+    const auto *src_rows_ptr = srcs[i]->rows().CUDAData(place);
+
+    auto *dst_tensor = dst.mutable_value();
+    auto dims = srcs[i]->value().dims();
+    dims[0] = rows_num;
+    auto feature_size = framework::product(dims) / dims[0];
+    dst_tensor->Resize(dims);
+    auto *dst_tensor_ptr = dst_tensor->mutable_data(place, dtype);
+    const auto *src_tensor_ptr = srcs[i]->value().data<void>();
+
+    platform::DeviceContextPool::Instance().Get(place)->Wait();
+
+    if (all_rows_num_equal) {
+      // Every rank holds the same number of rows, so the cheaper allgather
+      // can replace the per-rank broadcasts.
+      auto row_sendcount = cpu_rows_num_ptr[0];
+      auto value_sendcount = row_sendcount * feature_size;
+      gather_data_calls.emplace_back([=] {
+        PADDLE_ENFORCE_CUDA_SUCCESS(platform::dynload::ncclAllGather(
+            src_rows_ptr, dst_rows_ptr, row_sendcount, ncclInt64, comm,
+            stream));
+        PADDLE_ENFORCE_CUDA_SUCCESS(platform::dynload::ncclAllGather(
+            src_tensor_ptr, dst_tensor_ptr, value_sendcount, nccl_dtype, comm,
+            stream));
+      });
+    } else {
+      auto sizeof_dtype = framework::SizeOfType(dtype);
+      gather_data_calls.emplace_back([=] {
+        int64_t row_offset = 0;
+        for (int r = 0; r < nranks; ++r) {
+          if (cpu_rows_num_ptr[r] == 0) continue;
+          PADDLE_ENFORCE_CUDA_SUCCESS(platform::dynload::ncclBroadcast(
+              src_rows_ptr, dst_rows_ptr + row_offset, cpu_rows_num_ptr[r],
+              ncclInt64, r, comm, stream));
+          auto *dst_tensor_ptr_r = reinterpret_cast<uint8_t *>(dst_tensor_ptr) +
+                                   row_offset * feature_size * sizeof_dtype;
+          PADDLE_ENFORCE_CUDA_SUCCESS(platform::dynload::ncclBroadcast(
+              src_tensor_ptr, dst_tensor_ptr_r,
+              cpu_rows_num_ptr[r] * feature_size, nccl_dtype, r, comm, stream));
+          row_offset += cpu_rows_num_ptr[r];
+        }
+      });
+    }
+  }
+  NCCLAllReduceFunc(gather_data_calls);
+
+  // The collectives still read the old rows and values of the output
+  // variable, so wait for them before the result replaces the input.
+  for (auto stream : streams) {
+#ifdef PADDLE_WITH_HIP
+    PADDLE_ENFORCE_CUDA_SUCCESS(hipStreamSynchronize(stream));
+#else
+    PADDLE_ENFORCE_CUDA_SUCCESS(cudaStreamSynchronize(stream));
+#endif
+  }
+  for (size_t i = 0; i < num_places; ++i) {
+    auto *out_var = local_exec_scopes_[i]->FindVar(out_var_handles[i]->name());
+    auto *out_sr = out_var->GetMutable<framework::SelectedRows>();
+    out_sr->set_height(height);
+    *out_sr->mutable_rows() = std::move(*tmp_dsts[i].mutable_rows());
+    out_sr->mutable_value()->ShareDataWith(tmp_dsts[i].value());
+  }
+#else
+  PADDLE_THROW(platform::errors::Unimplemented(
+      "The SelectedRows allreduce requires NCCL version >= 2.2.12."));
+#endif
+}
 #endif
 
 std::string AllReduceOpHandle::Name() const { return "all_reduce"; }
@@ -86,6 +86,13 @@ class AllReduceOpHandle : public OpHandleBase {
       const std::vector<std::function<void()>> &all_reduce_calls);
 
   void SyncNCCLAllReduce();
+
+  // AllReduce a SelectedRows gradient without densifying it: the per-rank
+  // row numbers are allgathered first, then only the touched rows and their
+  // values are exchanged. Requires NCCL >= 2.2.12.
+  void NCCLSelectedRowsAllReduce(
+      const std::vector<VarHandle *> &in_var_handles,
+      const std::vector<VarHandle *> &out_var_handles);
 #endif
 
 #if defined(PADDLE_WITH_XPU_BKCL)
@@ -13,6 +13,7 @@
 // limitations under the License.
 #include "paddle/fluid/framework/details/fast_threaded_ssa_graph_executor.h"
 
+#include <algorithm>
 #include <deque>
 #include <memory>
 #include <string>
@@ -24,6 +25,7 @@
 #include "paddle/fluid/framework/details/fetch_async_op_handle.h"
 #include "paddle/fluid/framework/details/multi_devices_helper.h"
 #include "paddle/fluid/framework/ir/graph_helper.h"
+#include "paddle/fluid/framework/ir/op_cost_database.h"
 #include "paddle/fluid/platform/profiler.h"
 
 namespace paddle {
@@ -41,7 +43,8 @@ FastThreadedSSAGraphExecutor::FastThreadedSSAGraphExecutor(
       graph_(graph),
       fetch_ctxs_(places),
       // add one more thread for generate op_deps
-      prepare_pool_(1) {
+      prepare_pool_(1),
+      comm_pool_(1) {
   if (ir::IsTopologySortOperationsUnique(*graph_)) {
     VLOG(10)
         << "Change thread number to 1 because the toposort order is unique";
@@ -54,13 +57,64 @@ FastThreadedSSAGraphExecutor::FastThreadedSSAGraphExecutor(
     if (dep == 0) {
       bootstrap_ops_.emplace_back(op);
     }
+    auto *compute_op = dynamic_cast<ComputationOpHandle *>(op);
+    if (compute_op != nullptr) {
+      // Shapes are unknown before the first run, so use the per-op-type
+      // mean as the scheduling hint.
+      double cost_ms = OpCostDatabase::Instance().LookupByOpType(
+          compute_op->GetOp()->Type());
+      if (cost_ms != OpCostDatabase::NOT_MEASURED) {
+        op_cost_hints_.emplace(op, cost_ms);
+      }
+    }
   }
   PADDLE_ENFORCE_GT(op_deps_.size(), 0,
                     platform::errors::PreconditionNotMet(
                         "The graph doesn't have operators."));
+  InitOpPriorities();
+  // Issue the ops with the longest remaining dependency chain first so the
+  // ops which determine the step time do not wait behind cheap ones.
+  std::stable_sort(bootstrap_ops_.begin(), bootstrap_ops_.end(),
+                   [this](OpHandleBase *lhs, OpHandleBase *rhs) {
+                     return OpPriority(lhs) > OpPriority(rhs);
+                   });
   PrepareAtomicOpDeps();
 }
 
+void FastThreadedSSAGraphExecutor::InitOpPriorities() {
+  // The priority of an op is the length of the longest dependency chain
+  // starting at it: priority(op) = cost(op) + max priority of its pending
+  // ops. Ops without a measured cost count as one unit, so un-profiled
+  // graphs degrade to a hop-count critical path.
+  std::vector<OpHandleBase *> topo_order;
+  topo_order.reserve(op_deps_.size());
+  std::unordered_map<OpHandleBase *, int> pending_deps(op_deps_);
+  for (auto *op : bootstrap_ops_) {
+    topo_order.emplace_back(op);
+  }
+  for (size_t i = 0; i < topo_order.size(); ++i) {
+    for (auto &output : topo_order[i]->Outputs()) {
+      for (auto &pending_op : output->PendingOps()) {
+        if (--pending_deps.at(pending_op) == 0) {
+          topo_order.emplace_back(pending_op);
+        }
+      }
+    }
+  }
+  for (auto it = topo_order.rbegin(); it != topo_order.rend(); ++it) {
+    auto *op = *it;
+    double remaining = 0;
+    for (auto &output : op->Outputs()) {
+      for (auto &pending_op : output->PendingOps()) {
+        remaining = std::max(remaining, op_priorities_.at(pending_op));
+      }
+    }
+    auto cost_it = op_cost_hints_.find(op);
+    double cost = cost_it == op_cost_hints_.end() ? 1.0 : cost_it->second;
+    op_priorities_.emplace(op, cost + remaining);
+  }
+}
+
 FetchResultType FastThreadedSSAGraphExecutor::Run(
     const std::vector<std::string> &fetch_tensors, bool return_merged) {
   VLOG(3) << "enter FastThreadedSSAGraphExecutor Run";
@@ -230,7 +284,11 @@ void FastThreadedSSAGraphExecutor::RunOpAsync(
     OpHandleBase *op,
     const std::shared_ptr<BlockingQueue<size_t>> &complete_q) {
   ++remaining_;
-  this->pool_->enqueue([=] {
+  // Multi device transfer ops run on the dedicated communication thread,
+  // so a blocking collective launch never occupies a computation worker.
+  bool is_comm_thread = op->IsMultiDeviceTransfer();
+  auto *pool = is_comm_thread ? &comm_pool_ : pool_.get();
+  pool->enqueue([=] {
     std::deque<OpHandleBase *> op_queue;
     op_queue.push_front(op);
 
@@ -270,12 +328,20 @@ void FastThreadedSSAGraphExecutor::RunOpAsync(
           // first without switching to another thread.
           if (pending_op->GetPriority() == OpHandleBase::Priority::kHighest) {
             op_queue.push_back(pending_op);
-          } else if (pending_op->IsMultiDeviceTransfer()) {
-            // multi device ops should be scheduled prior to computing ops
-            op_queue.push_front(pending_op);
+          } else if (pending_op->IsMultiDeviceTransfer() || is_comm_thread) {
+            // multi device ops go to the communication thread, and ready
+            // computation ops leave the communication thread, both through
+            // RunOpAsync which picks the right pool.
+            RunOpAsync(op_deps, pending_op, complete_q);
           } else {
             if (op_to_run == nullptr) {
               op_to_run = pending_op;
+            } else if (OpPriority(pending_op) > OpPriority(op_to_run)) {
+              // Keep the op with the longer remaining dependency chain in
+              // the local queue: it runs without a thread switch, so the
+              // likely critical-path op starts as early as possible.
+              RunOpAsync(op_deps, op_to_run, complete_q);
+              op_to_run = pending_op;
             } else {
               RunOpAsync(op_deps, pending_op, complete_q);
             }
@@ -292,6 +358,11 @@ void FastThreadedSSAGraphExecutor::RunOpAsync(
   });
 }
 
+double FastThreadedSSAGraphExecutor::OpPriority(OpHandleBase *op) const {
+  auto it = op_priorities_.find(op);
+  return it == op_priorities_.end() ? 0 : it->second;
+}
+
 void FastThreadedSSAGraphExecutor::PrepareAtomicOpDeps() {
   atomic_op_deps_ = prepare_pool_.enqueue([&] {
     auto *op_deps = new std::unordered_map<OpHandleBase *, std::atomic<int>>;
@@ -51,6 +51,13 @@ class FastThreadedSSAGraphExecutor : public SSAGraphExecutor {
 
   std::unordered_map<OpHandleBase *, int> op_deps_;
   std::vector<OpHandleBase *> bootstrap_ops_;
+  // Per-op latency hints from OpCostDatabase, filled once at construction
+  // and read-only afterwards, so they are safe to read from worker threads.
+  std::unordered_map<OpHandleBase *, double> op_cost_hints_;
+  // Remaining critical path length of every op, computed once at
+  // construction and read-only afterwards. Ready ops with a longer
+  // remaining path are issued first.
+  std::unordered_map<OpHandleBase *, double> op_priorities_;
 
   platform::DeviceContextPool fetch_ctxs_;
   std::atomic<int> remaining_;
@@ -62,6 +69,10 @@ class FastThreadedSSAGraphExecutor : public SSAGraphExecutor {
 
   std::unique_ptr<::ThreadPool> pool_;
   ::ThreadPool prepare_pool_;
+  // Multi device transfer ops run on this dedicated thread, so a blocking
+  // collective launch never stalls a computation worker, and one thread
+  // keeps the collective launch order deterministic across trainers.
+  ::ThreadPool comm_pool_;
 
   std::vector<OpHandleBase *> traced_ops_;
 
@@ -75,6 +86,11 @@ class FastThreadedSSAGraphExecutor : public SSAGraphExecutor {
 
   void PrepareAtomicOpDeps();
 
+  void InitOpPriorities();
+
+  // Remaining critical path length of the op, 0 for unknown ops.
+  double OpPriority(OpHandleBase *op) const;
+
   inline void RecordOps(OpHandleBase *op);
 
   inline void ExecutionFinal(std::vector<OpHandleBase *> *fetch_ops);
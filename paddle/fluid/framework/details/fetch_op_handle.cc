@@ -14,7 +14,9 @@
 
 #include "paddle/fluid/framework/details/fetch_op_handle.h"
 
+#include <algorithm>
 #include <string>
+#include <utility>
 
 #include "paddle/fluid/platform/profiler.h"
 
@@ -127,6 +129,36 @@ static void TransData(const framework::LoDTensor &src_item,
   dst_item->set_lod(src_item.lod());
 }
 
+void FetchOpHandle::StageTransData(
+    const LoDTensor &src_item, LoDTensor *dst_item,
+    std::vector<std::pair<const LoDTensor *, LoDTensor *>> *staged_copies,
+    std::vector<platform::DeviceContext *> *wait_ctxs) {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (src_item.IsInitialized() && src_item.numel() > 0 &&
+      platform::is_gpu_place(src_item.place())) {
+    // Stage the copy through a pinned buffer instead of copying straight
+    // into pageable memory: a page-locked destination lets the D2H
+    // transfer run asynchronously on the producer stream, so the copies
+    // of all fetch sources overlap instead of serializing.
+    if (pinned_buffer_index_ == pinned_buffers_.size()) {
+      pinned_buffers_.emplace_back();
+    }
+    auto *staging = &pinned_buffers_[pinned_buffer_index_++];
+    auto *dev_ctx =
+        platform::DeviceContextPool::Instance().Get(src_item.place());
+    TensorCopy(src_item, platform::CUDAPinnedPlace(), *dev_ctx, staging);
+    staging->set_lod(src_item.lod());
+    staged_copies->emplace_back(staging, dst_item);
+    if (std::find(wait_ctxs->begin(), wait_ctxs->end(), dev_ctx) ==
+        wait_ctxs->end()) {
+      wait_ctxs->push_back(dev_ctx);
+    }
+    return;
+  }
+#endif
+  TransData(src_item, dst_item);
+}
+
 void FetchOpHandle::RunImpl() {
   platform::RecordEvent record_event(Name());
   WaitInputVarGenerated(platform::CPUPlace());
@@ -134,6 +166,10 @@ void FetchOpHandle::RunImpl() {
   tensors_.resize(inputs_.size());
   auto &scopes = *local_exec_scopes_;
 
+  pinned_buffer_index_ = 0;
+  std::vector<std::pair<const LoDTensor *, LoDTensor *>> staged_copies;
+  std::vector<platform::DeviceContext *> wait_ctxs;
+
   for (size_t i = 0; i < inputs_.size(); ++i) {
     auto *var_handle = static_cast<VarHandle *>(inputs_[i]);
     auto &scope = scopes.at(var_handle->scope_idx());
@@ -146,17 +182,28 @@ void FetchOpHandle::RunImpl() {
     if (var->IsType<LoDTensor>()) {
       auto &t = var->Get<framework::LoDTensor>();
       auto &item = BOOST_GET(LoDTensor, tensors_[i]);
-      TransData(t, &item);
+      StageTransData(t, &item, &staged_copies, &wait_ctxs);
     } else {
       auto &t = var->Get<framework::LoDTensorArray>();
       LoDTensorArray tmp(t.size());
       tensors_[i] = tmp;
       auto &item = BOOST_GET(LoDTensorArray, tensors_[i]);
       for (size_t j = 0; j < t.size(); ++j) {
-        TransData(t[j], &item[j]);
+        StageTransData(t[j], &item[j], &staged_copies, &wait_ctxs);
       }
     }
   }
+
+  // Drain each involved device stream once, then land the pinned data in
+  // the pageable result tensors with plain host memcpys.
+  for (auto *ctx : wait_ctxs) {
+    ctx->Wait();
+  }
+  for (auto &copy : staged_copies) {
+    TensorCopySync(*copy.first, platform::CPUPlace(), copy.second);
+    copy.second->set_lod(copy.first->lod());
+  }
+
   this->WaitAndMergeCPUFetchVars();
 }
 
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "paddle/fluid/framework/details/op_handle_base.h"
@@ -61,12 +62,27 @@ struct FetchOpHandle : public OpHandleBase {
   void WaitInputVarGenerated(const platform::Place &place) override;
 
  private:
+  // For a GPU source, enqueues an asynchronous D2H copy into one of the
+  // persistent pinned buffers and records the (staging, destination) pair
+  // in staged_copies together with the device context to drain; otherwise
+  // copies synchronously like before. The staged pairs are landed in
+  // RunImpl after a single wait per device.
+  void StageTransData(
+      const LoDTensor &src_item, LoDTensor *dst_item,
+      std::vector<std::pair<const LoDTensor *, LoDTensor *>> *staged_copies,
+      std::vector<platform::DeviceContext *> *wait_ctxs);
+
   FetchResultType *data_;
   size_t offset_;
   std::vector<Scope *> *local_scopes_;
   std::vector<Scope *> *local_exec_scopes_;
   std::vector<FetchType> tensors_;
   bool return_merged_;
+
+  // Pinned staging buffers for GPU fetch sources, reused across steps so
+  // the page-locked allocation is paid only once per fetch target.
+  std::vector<LoDTensor> pinned_buffers_;
+  size_t pinned_buffer_index_{0};
 };
 
 }  // namespace details
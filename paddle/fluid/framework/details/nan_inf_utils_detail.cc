@@ -72,12 +72,23 @@ op_var_nan_inf_white_list() {
   return _op_var_nan_inf_white_list;
 }
 
+// Fast mode knobs, see InitWhiteListFormEnv for the env variables.
+static bool fast_nan_inf_check = false;
+static int nan_inf_sample_blocks = 1;
+
+// When not empty, only the listed op types are checked.
+static std::unordered_set<std::string>& op_type_nan_inf_check_list() {
+  static std::unordered_set<std::string> _op_type_nan_inf_check_list;
+  return _op_type_nan_inf_check_list;
+}
+
 static void InitWhiteListFormEnv() {
   // op_type_skip and op_var_skip may be NULL.
   // So need init static value in there, prevent thread competition.
   // NOTE. role_str2int needn't do this for it only used in this func.
   op_type_nan_inf_white_list();
   op_var_nan_inf_white_list();
+  op_type_nan_inf_check_list();
 
   // export PADDLE_INF_NAN_SKIP_OP="op0,op1,op2"
   // export PADDLE_INF_NAN_SKIP_ROLE="role1,role2,role3"
@@ -124,6 +135,31 @@ static void InitWhiteListFormEnv() {
       op_var_nan_inf_white_list()[op].emplace_back(var);
     }
   }
+
+  // Fast mode for long-running jobs, aimed at keeping check_nan_inf cheap
+  // enough to stay enabled in production:
+  // export PADDLE_INF_NAN_FAST_MODE=1      (blocked scan with early exit)
+  // export PADDLE_INF_NAN_SAMPLE_BLOCKS=16 (check one of every 16 blocks)
+  // export PADDLE_INF_NAN_CHECK_OP="op0,op1" (only check the listed ops)
+  const char* fast_mode = std::getenv("PADDLE_INF_NAN_FAST_MODE");
+  const char* sample_blocks = std::getenv("PADDLE_INF_NAN_SAMPLE_BLOCKS");
+  const char* op_type_check = std::getenv("PADDLE_INF_NAN_CHECK_OP");
+
+  if (fast_mode != NULL && std::string(fast_mode) != "0") {
+    fast_nan_inf_check = true;
+  }
+
+  if (sample_blocks != NULL) {
+    nan_inf_sample_blocks = std::max(std::atoi(sample_blocks), 1);
+  }
+
+  if (op_type_check != NULL) {
+    std::stringstream ss(op_type_check);
+    std::string op_type;
+    while (std::getline(ss, op_type, ',')) {
+      op_type_nan_inf_check_list().emplace(op_type);
+    }
+  }
 }
 
 template <typename T>
@@ -180,10 +216,50 @@ static void PrintNanInf(const T* value, const size_t numel, int print_num,
 
 #endif
 
+template <typename T>
+static void CheckNanInfFast(const T* value, const size_t numel, int print_num,
+                            const std::string& op_type,
+                            const std::string& var_name) {
+  // Scan in cache-resident blocks: every block is reduced with a plain
+  // vectorizable loop and tested once, so corrupted tensors are reported
+  // after the first bad block instead of after a full pass. With
+  // PADDLE_INF_NAN_SAMPLE_BLOCKS=K only one of every K blocks is reduced,
+  // and the rotating start block spreads the coverage over successive calls
+  // so that a persistent nan/inf is still caught within a few steps.
+  constexpr size_t kBlockSize = 512;
+  const size_t block_stride = static_cast<size_t>(nan_inf_sample_blocks);
+  size_t first_block = 0;
+  if (block_stride > 1) {
+    static thread_local size_t rotation = 0;
+    first_block = rotation++ % block_stride;
+  }
+
+  for (size_t block = first_block; block * kBlockSize < numel;
+       block += block_stride) {
+    const size_t begin = block * kBlockSize;
+    const size_t end = std::min(numel, begin + kBlockSize);
+    T sum = static_cast<T>(0.0);
+#if defined _OPENMP && _OPENMP >= 201307
+#pragma omp simd reduction(+ : sum)
+#endif
+    for (size_t i = begin; i < end; ++i) {
+      sum += (value[i] - value[i]);
+    }
+    if (std::isnan(sum) || std::isinf(sum)) {
+      PrintNanInf(value, numel, print_num, op_type, var_name);
+    }
+  }
+}
+
 template <typename T>
 static void CheckNanInf(const T* value, const size_t numel, int print_num,
                         const std::string& op_type,
                         const std::string& var_name) {
+  if (fast_nan_inf_check) {
+    CheckNanInfFast(value, numel, print_num, op_type, var_name);
+    return;
+  }
+
   T sum = static_cast<T>(0.0);
 #if defined _OPENMP && _OPENMP >= 201307
 #pragma omp parallel for simd reduction(+ : sum)
@@ -415,6 +491,13 @@ void CheckVarHasNanOrInf(const std::string& op_type,
 }
 
 bool IsSkipOp(const framework::OperatorBase& op) {
+  // opt-in mode: when PADDLE_INF_NAN_CHECK_OP is set, only listed op types
+  // are checked
+  if (!op_type_nan_inf_check_list().empty() &&
+      op_type_nan_inf_check_list().count(op.Type()) == 0) {
+    return true;
+  }
+
   if (op_type_nan_inf_white_list().count(op.Type()) != 0) return true;
 
   int op_role = op.template Attr<int>(
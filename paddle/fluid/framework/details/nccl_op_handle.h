@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -30,11 +31,28 @@
 #include "paddle/fluid/platform/nccl_helper.h"
 
 DECLARE_bool(sync_nccl_allreduce);
+DECLARE_int32(hierarchical_allreduce_pipeline_nchunks);
 
 namespace paddle {
 namespace framework {
 namespace details {
 
+inline size_t SizeOfNCCLDataType(ncclDataType_t datatype) {
+  switch (datatype) {
+    case ncclFloat16:
+      return 2;
+    case ncclInt:
+    case ncclFloat:
+      return 4;
+    case ncclInt64:
+    case ncclDouble:
+      return 8;
+    default:
+      PADDLE_THROW(platform::errors::Unimplemented(
+          "Unsupported nccl datatype %d.", static_cast<int>(datatype)));
+  }
+}
+
 class NCCLOpHandleBase : public OpHandleBase {
  public:
   NCCLOpHandleBase(ir::Node* node, const std::vector<platform::Place>& places,
@@ -168,18 +186,65 @@ class NCCLOpHandleBase : public OpHandleBase {
         run_order_, 0,
         platform::errors::InvalidArgument(
             "The argument run_order_ must be >= 0, but got %d.", run_order_));
-    InterReduce(place, sendbuff, recvbuff, count, datatype, op);
-    // When a trainer is not in exter allreduce ring
-    // they need not to call this.
-    if (nccl_ctxs_->NeedExterAllReduce()) {
-      ExterAllReduce(place, recvbuff, recvbuff, count, datatype, op);
+    size_t nchunks =
+        static_cast<size_t>(FLAGS_hierarchical_allreduce_pipeline_nchunks);
+    if (nchunks <= 1 || count < nchunks) {
+      InterReduce(place, sendbuff, recvbuff, count, datatype, op);
+      // When a trainer is not in exter allreduce ring
+      // they need not to call this.
+      if (nccl_ctxs_->NeedExterAllReduce()) {
+        ExterAllReduce(place, recvbuff, recvbuff, count, datatype, op);
+      }
+      InterBroadCast(place, recvbuff, count, datatype, op);
+      return;
+    }
+
+    // Split the buffer into chunks and interleave the intra node reduces
+    // with the inter node allreduces, so the network transfer of one chunk
+    // overlaps the NVLink reduce of the next one. The intermediate stream
+    // synchronizations are skipped and replaced by one synchronization after
+    // the last chunk, otherwise FLAGS_sync_nccl_allreduce would serialize
+    // the pipeline again.
+    size_t size_of_dtype = SizeOfNCCLDataType(datatype);
+    size_t chunk_count = (count + nchunks - 1) / nchunks;
+    for (size_t offset = 0; offset < count; offset += chunk_count) {
+      size_t chunk = std::min(chunk_count, count - offset);
+      const void* chunk_sendbuff = static_cast<const char*>(sendbuff) +
+                                   offset * size_of_dtype;
+      void* chunk_recvbuff =
+          static_cast<char*>(recvbuff) + offset * size_of_dtype;
+      InterReduce(place, chunk_sendbuff, chunk_recvbuff, chunk, datatype, op,
+                  /*sync=*/false);
+      if (nccl_ctxs_->NeedExterAllReduce()) {
+        ExterAllReduce(place, chunk_recvbuff, chunk_recvbuff, chunk, datatype,
+                       op, /*sync=*/false);
+      }
+    }
+    // Each broadcast waits on the exter event recorded after the last
+    // allreduce, so the reduced chunks are complete before they leave rank 0.
+    for (size_t offset = 0; offset < count; offset += chunk_count) {
+      size_t chunk = std::min(chunk_count, count - offset);
+      void* chunk_recvbuff =
+          static_cast<char*>(recvbuff) + offset * size_of_dtype;
+      InterBroadCast(place, chunk_recvbuff, chunk, datatype, op);
+    }
+
+    if (FLAGS_sync_nccl_allreduce) {
+      int dev_id = BOOST_GET_CONST(platform::CUDAPlace, place).device;
+      auto inter_stream =
+          nccl_ctxs_->GetHierarchicalInterCtx(run_order_)->at(dev_id).stream();
+#ifdef PADDLE_WITH_HIP
+      PADDLE_ENFORCE_CUDA_SUCCESS(hipStreamSynchronize(inter_stream));
+#else
+      PADDLE_ENFORCE_CUDA_SUCCESS(cudaStreamSynchronize(inter_stream));
+#endif
     }
-    InterBroadCast(place, recvbuff, count, datatype, op);
   }
 
  protected:
   void InterReduce(platform::Place place, const void* sendbuff, void* recvbuff,
-                   size_t count, ncclDataType_t datatype, ncclRedOp_t op) {
+                   size_t count, ncclDataType_t datatype, ncclRedOp_t op,
+                   bool sync = true) {
     auto nccl_ctxs = nccl_ctxs_->GetHierarchicalInterCtx(run_order_);
     int dev_id = BOOST_GET_CONST(platform::CUDAPlace, place).device;
     auto& nccl_ctx = nccl_ctxs->at(dev_id);
@@ -201,7 +266,7 @@ class NCCLOpHandleBase : public OpHandleBase {
     cudaEventRecord(inter_events_.at(dev_id), stream);
 #endif
 
-    if (FLAGS_sync_nccl_allreduce) {
+    if (sync && FLAGS_sync_nccl_allreduce) {
 #ifdef PADDLE_WITH_HIP
       PADDLE_ENFORCE_CUDA_SUCCESS(hipStreamSynchronize(stream));
 #else
@@ -212,7 +277,7 @@ class NCCLOpHandleBase : public OpHandleBase {
 
   void ExterAllReduce(platform::Place place, const void* sendbuff,
                       void* recvbuff, size_t count, ncclDataType_t datatype,
-                      ncclRedOp_t op) {
+                      ncclRedOp_t op, bool sync = true) {
     auto nccl_ctxs = nccl_ctxs_->GetHierarchicalExterCtx(run_order_);
     PADDLE_ENFORCE_NOT_NULL(
         nccl_ctxs_, platform::errors::NotFound(
@@ -235,7 +300,7 @@ class NCCLOpHandleBase : public OpHandleBase {
 
     hipEventRecord(exter_events_.at(dev_id), stream);
 
-    if (FLAGS_sync_nccl_allreduce) {
+    if (sync && FLAGS_sync_nccl_allreduce) {
       PADDLE_ENFORCE_CUDA_SUCCESS(hipStreamSynchronize(stream));
     }
 #else
@@ -246,7 +311,7 @@ class NCCLOpHandleBase : public OpHandleBase {
 
     cudaEventRecord(exter_events_.at(dev_id), stream);
 
-    if (FLAGS_sync_nccl_allreduce) {
+    if (sync && FLAGS_sync_nccl_allreduce) {
       PADDLE_ENFORCE_CUDA_SUCCESS(cudaStreamSynchronize(stream));
     }
 #endif
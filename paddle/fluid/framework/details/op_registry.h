@@ -192,16 +192,23 @@ struct OpInfoFiller<T, kOpProtoAndCheckerMaker> {
     PADDLE_ENFORCE_EQ(info->checker_, nullptr,
                       platform::errors::AlreadyExists(
                           "OpAttrChecker of %s has been registered.", op_type));
-    info->proto_ = new proto::OpProto;
-    info->checker_ = new OpAttrChecker();
-    T maker;
-    maker(info->proto_, info->checker_);
-    info->proto_->set_type(op_type);
-    PADDLE_ENFORCE_EQ(
-        info->proto_->IsInitialized(), true,
-        platform::errors::PreconditionNotMet(
-            "Fail to initialize %s's OpProto, because %s is not initialized.",
-            op_type, info->proto_->InitializationErrorString()));
+    // Only this stub is recorded at static-initialization time. Building
+    // the OpProto and the OpAttrChecker is deferred until the op type is
+    // first looked up in OpInfoMap, so process startup does not pay for the
+    // hundreds of operators a given model never uses. op_type is a string
+    // literal from the registration macro and safe to capture by pointer.
+    info->deferred_proto_and_checker_filler_ = [op_type](OpInfo* deferred) {
+      deferred->proto_ = new proto::OpProto;
+      deferred->checker_ = new OpAttrChecker();
+      T maker;
+      maker(deferred->proto_, deferred->checker_);
+      deferred->proto_->set_type(op_type);
+      PADDLE_ENFORCE_EQ(
+          deferred->proto_->IsInitialized(), true,
+          platform::errors::PreconditionNotMet(
+              "Fail to initialize %s's OpProto, because %s is not initialized.",
+              op_type, deferred->proto_->InitializationErrorString()));
+    };
   }
 };
 
@@ -94,7 +94,11 @@ class PullDenseWorker {
   void Wait(std::vector<::std::future<int32_t>>* status_vec);
   void PullDense(bool force_update = false);
   void CreatePinVar();
+  void CreateShadowVar();
   void MergeDenseParam();
+  // Number of steps the slowest training thread has run since the dense
+  // values it currently sees were fetched from the pserver.
+  uint64_t GetStaleness(uint64_t table_id);
   int GetThreadIdByScope(const Scope* scope);
   void SetThreadIdByScope(const Scope* scope, int tid);
   static std::shared_ptr<PullDenseWorker> GetInstance() {
@@ -110,6 +114,7 @@ class PullDenseWorker {
   PullDenseWorker() : root_scope_(NULL) {}
   void Run();
   bool CheckUpdateParam(uint64_t table_id);
+  void SwapShadowParams();
 
  private:
   std::shared_ptr<paddle::framework::FleetWrapper> fleet_ptr_;
@@ -131,6 +136,13 @@ class PullDenseWorker {
 
   std::vector<::std::future<int32_t>> pull_dense_status_;
   uint32_t pull_dense_fail_times_ = 0;
+
+  // Pipelined prefetch bookkeeping: the training version at which each
+  // pull was issued, the version of the values currently visible to
+  // training threads, and the tables with a pull still in flight.
+  std::map<uint64_t, uint64_t> issued_versions_;
+  std::map<uint64_t, uint64_t> landed_versions_;
+  std::vector<uint64_t> in_flight_tables_;
   std::vector<float> base_norm_param_;
   std::vector<float> mean_;
   std::vector<float> scale_;
@@ -263,6 +275,13 @@ class HogwildWorker : public CPUWorkerBase {
  protected:
   void CreateThreadOperators(const ProgramDesc& program);
   void CreateThreadScope(const ProgramDesc& program);
+  // Double buffered feed/compute pipeline: a companion thread stages the
+  // next batch into one of two feed scopes while ops run on the other,
+  // so reading batch N+1 overlaps computing batch N.
+  void TrainFilesDoubleBuffered();
+  // Rebinds the feed vars to the given scope and reads the next batch
+  // into it. Returns the batch size, <= 0 at end of data.
+  int StageBatch(Scope* scope);
 
   std::vector<std::string> op_names_;
   std::vector<OperatorBase*> ops_;
@@ -271,6 +290,7 @@ class HogwildWorker : public CPUWorkerBase {
   HogwildWorkerParameter param_;
   std::vector<std::string> skip_ops_;
   std::map<std::string, int> stat_var_name_map_;
+  bool double_buffered_ = false;
 };
 
 class DownpourWorker : public HogwildWorker {
@@ -559,6 +579,9 @@ class SectionWorker : public DeviceWorker {
   void SetPipelineStageNum(int num) { num_pipeline_stages_ = num; }
   void SetPipelineStage(int stage) { pipeline_stage_ = stage; }
   void SetScheduleMode(int mode) { schedule_mode_ = mode; }
+  void SetMaxInflightMicrobatches(int num) {
+    max_inflight_microbatches_ = num;
+  }
   void SetMicrobatchScopes(const std::vector<Scope*>& scope) {
     microbatch_scopes_ = scope;
   }
@@ -585,6 +608,8 @@ class SectionWorker : public DeviceWorker {
   int num_pipeline_stages_;
   int pipeline_stage_;
   int schedule_mode_;  // 0 for F-then-B and 1 for 1F1B
+  // cap on in-flight micro batches of 1F1B, 0 for schedule-derived depth
+  int max_inflight_microbatches_ = 0;
   std::vector<Scope*> microbatch_scopes_;
   const Scope* minibatch_scope_;
 
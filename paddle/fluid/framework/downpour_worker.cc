@@ -497,8 +497,11 @@ void DownpourWorker::TrainFilesWithProfiler() {
     total_time += timeline.ElapsedSec();
 
     VLOG(3) << "program config size: " << param_.program_config_size();
-    for (int i = 0; i < param_.program_config(0).pull_sparse_table_id_size();
-         ++i) {
+    // issue every table's pull first, see DownpourWorker::TrainFiles
+    int pull_table_num = param_.program_config(0).pull_sparse_table_id_size();
+    std::vector<std::future<int32_t>> pull_sparse_status(pull_table_num);
+    timeline.Start();
+    for (int i = 0; i < pull_table_num; ++i) {
       uint64_t tid = static_cast<uint64_t>(
           param_.program_config(0).pull_sparse_table_id(i));
       TableParameter table;
@@ -508,10 +511,19 @@ void DownpourWorker::TrainFilesWithProfiler() {
           break;
         }
       }
-      timeline.Start();
-      fleet_ptr_->PullSparseVarsSync(
+      pull_sparse_status[i] = fleet_ptr_->PullSparseVarsIssue(
           *thread_scope_, tid, sparse_key_names_[tid], &features_[tid],
           &feature_values_[tid], table.fea_dim(), sparse_value_names_[tid]);
+    }
+    timeline.Pause();
+    pull_sparse_time += timeline.ElapsedSec();
+    total_time += timeline.ElapsedSec();
+    for (int i = 0; i < pull_table_num; ++i) {
+      uint64_t tid = static_cast<uint64_t>(
+          param_.program_config(0).pull_sparse_table_id(i));
+      timeline.Start();
+      fleet_ptr_->PullSparseVarsWait(std::move(pull_sparse_status[i]), tid,
+                                     &features_[tid], &feature_values_[tid]);
       timeline.Pause();
       pull_sparse_time += timeline.ElapsedSec();
       total_time += timeline.ElapsedSec();
@@ -752,8 +764,12 @@ void DownpourWorker::TrainFiles() {
       }
     }
     // pull sparse here
-    for (int i = 0; i < param_.program_config(0).pull_sparse_table_id_size();
-         ++i) {
+    // issue every table's pull first so the parameter server round trips
+    // run concurrently and each overlaps with the label collection and
+    // value filling of the tables waited on before it
+    int pull_table_num = param_.program_config(0).pull_sparse_table_id_size();
+    std::vector<std::future<int32_t>> pull_sparse_status(pull_table_num);
+    for (int i = 0; i < pull_table_num; ++i) {
       uint64_t tid = static_cast<uint64_t>(
           param_.program_config(0).pull_sparse_table_id(i));
       TableParameter table;
@@ -763,9 +779,15 @@ void DownpourWorker::TrainFiles() {
           break;
         }
       }
-      fleet_ptr_->PullSparseVarsSync(
+      pull_sparse_status[i] = fleet_ptr_->PullSparseVarsIssue(
           *thread_scope_, tid, sparse_key_names_[tid], &features_[tid],
           &feature_values_[tid], table.fea_dim(), sparse_value_names_[tid]);
+    }
+    for (int i = 0; i < pull_table_num; ++i) {
+      uint64_t tid = static_cast<uint64_t>(
+          param_.program_config(0).pull_sparse_table_id(i));
+      fleet_ptr_->PullSparseVarsWait(std::move(pull_sparse_status[i]), tid,
+                                     &features_[tid], &feature_values_[tid]);
       CollectLabelInfo(i);
       FillSparseValue(i);
       auto nid_iter = std::find(sparse_value_names_[tid].begin(),
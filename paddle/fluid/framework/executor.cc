@@ -62,6 +62,12 @@ void ExecutorPrepareContext::PrepareUnusedVars(
   unused_vars_ = GetUnusedVars(prog_.Block(block_id_), ops_, keep_vars);
 }
 
+void ExecutorPrepareContext::EnableRuntimeContextCache() {
+  for (auto& op : ops_) {
+    op->SetAttr(kEnableCacheRuntimeContext, true);
+  }
+}
+
 ExecutorPrepareContext::~ExecutorPrepareContext() {
   VLOG(5) << "destroy ExecutorPrepareContext";
 }
@@ -371,7 +377,8 @@ void Executor::Run(const ProgramDesc& program, Scope* scope,
 
 std::unique_ptr<ExecutorPrepareContext> Executor::Prepare(
     const ProgramDesc& program, int block_id,
-    const std::vector<std::string>& skip_ref_cnt_vars, bool force_disable_gc) {
+    const std::vector<std::string>& skip_ref_cnt_vars, bool force_disable_gc,
+    bool enable_runtime_context_cache) {
   std::unique_ptr<ExecutorPrepareContext> ctx(
       new ExecutorPrepareContext(program, block_id));
   PADDLE_ENFORCE_LT(static_cast<size_t>(block_id), program.Size(),
@@ -384,6 +391,9 @@ std::unique_ptr<ExecutorPrepareContext> Executor::Prepare(
     ctx->ops_.push_back(OpRegistry::CreateOp(*op_desc));
   }
   ctx->PrepareUnusedVars(skip_ref_cnt_vars, force_disable_gc);
+  if (enable_runtime_context_cache) {
+    ctx->EnableRuntimeContextCache();
+  }
   return ctx;
 }
 
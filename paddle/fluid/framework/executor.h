@@ -44,6 +44,13 @@ struct ExecutorPrepareContext {
   void PrepareUnusedVars(const std::vector<std::string>& keep_vars,
                          bool force_disable_gc = false);
 
+  // Mark every op so that its input/output variables are resolved to direct
+  // Variable* handles once per scope and then reused across iterations,
+  // instead of calling Scope::FindVar() with string names on every run.
+  // Do not enable it when ops may create or delete scope variables between
+  // iterations (e.g. control flow ops running with varying sub-scopes).
+  void EnableRuntimeContextCache();
+
   const framework::ProgramDesc& prog_;
   const size_t block_id_;
 
@@ -109,7 +116,8 @@ class Executor {
       const ProgramDesc& program, int block_id,
       const std::vector<std::string>& skip_ref_cnt_vars =
           std::vector<std::string>(),
-      bool force_disable_gc = false);
+      bool force_disable_gc = false,
+      bool enable_runtime_context_cache = false);
 
   static std::vector<std::shared_ptr<ExecutorPrepareContext>> Prepare(
       const ProgramDesc& program, const std::vector<int>& block_ids,
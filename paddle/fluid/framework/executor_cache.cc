@@ -13,7 +13,21 @@
 // limitations under the License.
 
 #include "paddle/fluid/framework/executor_cache.h"
+
+#include <fstream>
+
 #include "paddle/fluid/framework/op_info.h"
+#include "paddle/fluid/platform/flags.h"
+
+extern "C" {
+#include <xxhash.h>
+}
+
+PADDLE_DEFINE_EXPORTED_string(
+    executor_cache_dir, "",
+    "Directory holding persisted executor analysis results keyed by a "
+    "program hash, so warm restarts skip program analysis. Empty disables "
+    "the persistent cache.");
 
 namespace paddle {
 namespace framework {
@@ -73,10 +87,81 @@ void AppendSkipDeletionVars(const std::vector<std::string> &append_vars,
  *   1. it is an output var in run_program_op
  *   2. it is an input var used in backward_op
  */
+// Hash identifying one analysis result: the serialized program plus the
+// parameters the analysis depends on.
+static uint64_t PlanHash(const ProgramDesc &program, int64_t forward_op_nums,
+                         const std::vector<std::string> &output_var_names) {
+  std::string buffer;
+  // Proto() only flushes the in-memory desc, it does not mutate the program.
+  const_cast<ProgramDesc &>(program).Proto()->SerializeToString(&buffer);
+  XXH64_state_t state;
+  XXH64_reset(&state, 1);
+  XXH64_update(&state, buffer.data(), buffer.size());
+  XXH64_update(&state, &forward_op_nums, sizeof(forward_op_nums));
+  for (auto &name : output_var_names) {
+    XXH64_update(&state, name.data(), name.size());
+  }
+  return XXH64_digest(&state);
+}
+
+static std::string PlanCachePath(uint64_t plan_hash) {
+  std::ostringstream path;
+  path << FLAGS_executor_cache_dir << "/exec_plan_" << std::hex << plan_hash
+       << ".txt";
+  return path.str();
+}
+
+static bool TryLoadSkipEagerDeleteVars(uint64_t plan_hash,
+                                       std::vector<std::string> *skip_vars) {
+  std::ifstream file(PlanCachePath(plan_hash));
+  if (!file.is_open()) {
+    return false;
+  }
+  std::string line;
+  if (!std::getline(file, line) || line != std::to_string(plan_hash)) {
+    // Stale or truncated entry; fall back to the full analysis.
+    return false;
+  }
+  while (std::getline(file, line)) {
+    if (!line.empty()) {
+      skip_vars->emplace_back(line);
+    }
+  }
+  return true;
+}
+
+static void SaveSkipEagerDeleteVars(uint64_t plan_hash,
+                                    const std::vector<std::string> &skip_vars) {
+  std::string path = PlanCachePath(plan_hash);
+  std::ofstream file(path + ".tmp");
+  if (!file.is_open()) {
+    VLOG(2) << "Cannot write executor plan cache to " << path;
+    return;
+  }
+  file << plan_hash << "\n";
+  for (auto &name : skip_vars) {
+    file << name << "\n";
+  }
+  file.close();
+  // Atomic publish so concurrent processes never observe a partial file.
+  if (std::rename((path + ".tmp").c_str(), path.c_str()) != 0) {
+    VLOG(2) << "Cannot publish executor plan cache to " << path;
+  }
+}
+
 void ParseSafeEagerDeletionSkipVars(
     const ProgramDesc &program, int64_t forward_op_nums,
     const std::vector<std::string> &output_var_names,
     std::vector<std::string> *skip_eager_delete_vars) {
+  uint64_t plan_hash = 0;
+  if (!FLAGS_executor_cache_dir.empty()) {
+    plan_hash = PlanHash(program, forward_op_nums, output_var_names);
+    if (TryLoadSkipEagerDeleteVars(plan_hash, skip_eager_delete_vars)) {
+      VLOG(3) << "Loaded " << skip_eager_delete_vars->size()
+              << " skip_eager_delete_vars from persistent cache";
+      return;
+    }
+  }
   auto all_ops = program.Block(0).AllOps();
   auto &op_info_map = OpInfoMap::Instance();
   // NOTE: skip `shape` and `fill_constant` op created by
@@ -125,6 +210,9 @@ void ParseSafeEagerDeletionSkipVars(
     }
   }
   VLOG(3) << "Found skip_eager_delete_vars: " << skip_eager_delete_vars->size();
+  if (!FLAGS_executor_cache_dir.empty()) {
+    SaveSkipEagerDeleteVars(plan_hash, *skip_eager_delete_vars);
+  }
 }
 
 }  // namespace details
@@ -29,6 +29,7 @@ limitations under the License. */
 #include "paddle/fluid/framework/variable_helper.h"
 #include "paddle/fluid/inference/io.h"
 #include "paddle/fluid/platform/cpu_helper.h"
+#include "paddle/fluid/platform/cpu_info.h"
 #include "paddle/fluid/platform/place.h"
 #include "paddle/fluid/platform/timer.h"
 #include "paddle/fluid/pybind/pybind.h"
@@ -184,7 +185,8 @@ void ExecutorThreadWorker::SetDevice() {
 #if defined _WIN32 || defined __APPLE__
   return;
 #else
-  static unsigned concurrency_cap = std::thread::hardware_concurrency();
+  static unsigned concurrency_cap =
+      static_cast<unsigned>(platform::CpuAvailableCoreCount());
   LOG(WARNING) << "concurrency capacity " << concurrency_cap;
   int thread_id = this->thread_id_;
 
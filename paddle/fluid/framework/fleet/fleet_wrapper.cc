@@ -513,8 +513,19 @@ void FleetWrapper::PullSparseVarsSync(
     std::vector<std::vector<float>>* fea_values, int fea_value_dim,
     const std::vector<std::string>& var_emb_names) {
 #ifdef PADDLE_WITH_PSLIB
-  std::vector<::std::future<int32_t>> pull_sparse_status;
-  pull_sparse_status.resize(0);
+  PullSparseVarsWait(
+      PullSparseVarsIssue(scope, table_id, var_names, fea_keys, fea_values,
+                          fea_value_dim, var_emb_names),
+      table_id, fea_keys, fea_values);
+#endif
+}
+
+std::future<int32_t> FleetWrapper::PullSparseVarsIssue(
+    const Scope& scope, const uint64_t table_id,
+    const std::vector<std::string>& var_names, std::vector<uint64_t>* fea_keys,
+    std::vector<std::vector<float>>* fea_values, int fea_value_dim,
+    const std::vector<std::string>& var_emb_names) {
+#ifdef PADDLE_WITH_PSLIB
   fea_keys->clear();
   fea_keys->resize(0);
   fea_keys->reserve(MAX_FEASIGN_NUM);
@@ -551,37 +562,43 @@ void FleetWrapper::PullSparseVarsSync(
   for (auto& t : *fea_values) {
     pull_result_ptr.push_back(t.data());
   }
+  return pslib_ptr_->_worker_ptr->pull_sparse(
+      pull_result_ptr.data(), table_id, fea_keys->data(), fea_keys->size());
+#endif
+  return std::future<int32_t>();
+}
 
+void FleetWrapper::PullSparseVarsWait(
+    std::future<int32_t> status, const uint64_t table_id,
+    std::vector<uint64_t>* fea_keys,
+    std::vector<std::vector<float>>* fea_values) {
+#ifdef PADDLE_WITH_PSLIB
   int32_t cnt = 0;
   while (true) {
-    pull_sparse_status.clear();
-    auto status = pslib_ptr_->_worker_ptr->pull_sparse(
-        pull_result_ptr.data(), table_id, fea_keys->data(), fea_keys->size());
-    pull_sparse_status.push_back(std::move(status));
-    bool flag = true;
-    for (auto& t : pull_sparse_status) {
-      t.wait();
-      int32_t status = -1;
-      try {
-        status = t.get();
-      } catch (const std::future_error& e) {
-        VLOG(0) << "Caught a future_error with code" << e.code()
-                << ", Message:" << e.what();
-      }
-      if (status != 0) {
-        VLOG(0) << "fleet pull sparse failed, status[" << status << "]";
-        sleep(sleep_seconds_before_fail_exit_);
-        flag = false;
-        cnt++;
-      }
-      if (cnt > 3) {
-        VLOG(0) << "fleet pull sparse failed, retry 3 times";
-        exit(-1);
-      }
+    status.wait();
+    int32_t ret = -1;
+    try {
+      ret = status.get();
+    } catch (const std::future_error& e) {
+      VLOG(0) << "Caught a future_error with code" << e.code()
+              << ", Message:" << e.what();
     }
-    if (flag) {
+    if (ret == 0) {
       break;
     }
+    VLOG(0) << "fleet pull sparse failed, status[" << ret << "]";
+    sleep(sleep_seconds_before_fail_exit_);
+    cnt++;
+    if (cnt > 3) {
+      VLOG(0) << "fleet pull sparse failed, retry 3 times";
+      exit(-1);
+    }
+    std::vector<float*> pull_result_ptr;
+    for (auto& t : *fea_values) {
+      pull_result_ptr.push_back(t.data());
+    }
+    status = pslib_ptr_->_worker_ptr->pull_sparse(
+        pull_result_ptr.data(), table_id, fea_keys->data(), fea_keys->size());
   }
 #endif
 }
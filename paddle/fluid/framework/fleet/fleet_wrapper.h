@@ -118,6 +118,27 @@ class FleetWrapper {
                           int fea_dim,
                           const std::vector<std::string>& var_emb_names);
 
+  // Issue the sparse pull for one table without waiting. The feasign keys
+  // are copied out of the scope tensors before returning, so the caller can
+  // overlap the parameter server round trip with other per-batch work and
+  // collect the values later with PullSparseVarsWait. Slots without
+  // embedding are skipped, like in PullSparseVarsSync.
+  // Param<in>: scope, table_id, var_names, fea_keys, fea_dim, var_emb_names
+  // Param<out>: fea_values std::future
+  std::future<int32_t> PullSparseVarsIssue(
+      const Scope& scope, const uint64_t table_id,
+      const std::vector<std::string>& var_names,
+      std::vector<uint64_t>* fea_keys,
+      std::vector<std::vector<float>>* fea_values, int fea_dim,
+      const std::vector<std::string>& var_emb_names);
+
+  // Wait for a pull issued by PullSparseVarsIssue, with the same retry and
+  // abort-on-repeated-failure behavior as PullSparseVarsSync. fea_keys and
+  // fea_values must be the vectors passed to PullSparseVarsIssue.
+  void PullSparseVarsWait(std::future<int32_t> status, const uint64_t table_id,
+                          std::vector<uint64_t>* fea_keys,
+                          std::vector<std::vector<float>>* fea_values);
+
   // Pull sparse variables from server in async mode
   // Param<in>: scope, table_id, var_names, fea_keys, fea_dim
   // Param<out>: fea_values std::future
@@ -20,9 +20,11 @@ limitations under the License. */
 #include <sys/types.h>
 #include <unistd.h>
 #endif
+#include <exception>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 #ifdef PADDLE_WITH_GLOO
@@ -148,6 +150,14 @@ class GlooWrapper {
     run_timeout_ = std::chrono::seconds(run_seconds);
   }
 
+  // Configure chunked AllReduce. When set to a non-zero element count,
+  // buffers larger than that are split into chunks which are allreduced
+  // concurrently, each chunk as its own gloo operation on a distinct tag
+  // and thread, so the communication rounds of one chunk overlap with the
+  // reduction and wire time of the others. All ranks must configure the
+  // same chunk size. 0 (default) keeps the single whole-buffer ring.
+  void SetAllReduceChunkElements(size_t x) { allreduce_chunk_elems_ = x; }
+
   int Rank() { return rank_; }
 
   int Size() { return size_; }
@@ -197,32 +207,79 @@ class GlooWrapper {
     std::vector<T> recvbuf(sendbuf.size(), T());
     CHECK_EQ(sendbuf.size() == recvbuf.size(), true);
 #ifdef PADDLE_WITH_GLOO
-    gloo::AllreduceOptions opts(context_);
-    opts.setInput(sendbuf.data(), sendbuf.size());
-    opts.setOutput(recvbuf.data(), recvbuf.size());
+    void (*reduce_func)(void*, const void*, const void*, size_t) = nullptr;
     if (mode == "sum") {
-      opts.setReduceFunction(
+      reduce_func =
           static_cast<void (*)(void*, const void*, const void*, size_t)>(
-              &gloo::sum<T>));
+              &gloo::sum<T>);
     } else if (mode == "max") {
-      opts.setReduceFunction(
+      reduce_func =
           static_cast<void (*)(void*, const void*, const void*, size_t)>(
-              &gloo::max<T>));
+              &gloo::max<T>);
     } else if (mode == "min") {
-      opts.setReduceFunction(
+      reduce_func =
           static_cast<void (*)(void*, const void*, const void*, size_t)>(
-              &gloo::min<T>));
+              &gloo::min<T>);
     } else {
       PADDLE_ENFORCE_EQ(0, 1, paddle::platform::errors::InvalidArgument(
                                   "AllReduce mode not known: " + mode));
     }
-    gloo::allreduce(opts);
+    size_t chunk_elems = allreduce_chunk_elems_;
+    if (chunk_elems == 0 || sendbuf.size() <= chunk_elems) {
+      AllReduceChunk(sendbuf.data(), recvbuf.data(), sendbuf.size(),
+                     reduce_func, 0);
+      return recvbuf;
+    }
+    size_t chunk_num = (sendbuf.size() + chunk_elems - 1) / chunk_elems;
+    std::vector<std::exception_ptr> excepts(chunk_num);
+    std::vector<std::thread> threads;
+    threads.reserve(chunk_num);
+    for (size_t i = 0; i < chunk_num; ++i) {
+      size_t offset = i * chunk_elems;
+      size_t len = offset + chunk_elems <= sendbuf.size()
+                       ? chunk_elems
+                       : sendbuf.size() - offset;
+      // each chunk runs on its own tag, so the concurrent operations use
+      // disjoint gloo slots; tag 0 stays reserved for the unchunked path
+      threads.emplace_back([this, &sendbuf, &recvbuf, &excepts, reduce_func,
+                            offset, len, i]() {
+        try {
+          AllReduceChunk(sendbuf.data() + offset, recvbuf.data() + offset, len,
+                         reduce_func, static_cast<uint32_t>(i + 1));
+        } catch (...) {
+          excepts[i] = std::current_exception();
+        }
+      });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+    for (auto& e : excepts) {
+      if (e) {
+        std::rethrow_exception(e);
+      }
+    }
 #else
     LOG(WARNING) << "AllReduce does nothing when WITH_GLOO=OFF";
 #endif
     return recvbuf;
   }
 
+#ifdef PADDLE_WITH_GLOO
+  template <typename T>
+  void AllReduceChunk(T* sendbuf, T* recvbuf, size_t len,
+                      void (*reduce_func)(void*, const void*, const void*,
+                                          size_t),
+                      uint32_t tag) {
+    gloo::AllreduceOptions opts(context_);
+    opts.setTag(tag);
+    opts.setInput(sendbuf, len);
+    opts.setOutput(recvbuf, len);
+    opts.setReduceFunction(reduce_func);
+    gloo::allreduce(opts);
+  }
+#endif
+
   template <typename T>
   std::vector<T> AllGather(T& input) {  // NOLINT
     CHECK_EQ(is_initialized_, true);
@@ -263,6 +320,8 @@ class GlooWrapper {
 #endif
   int rank_ = 0;
   int size_ = 0;
+  // chunk size (in elements) for chunked AllReduce, 0 means disabled
+  size_t allreduce_chunk_elems_ = 0;
   std::chrono::seconds init_timeout_ = std::chrono::seconds(9999999);
   std::chrono::seconds run_timeout_ = std::chrono::seconds(9999999);
   std::string iface_ = "lo";
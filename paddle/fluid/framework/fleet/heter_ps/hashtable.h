@@ -55,6 +55,9 @@ class HashTable {
               gpuStream_t stream);
   void get(const KeyType* d_keys, ValType* d_vals, size_t len,
            gpuStream_t stream);
+  // grows the container to new_capacity and migrates every filled slot;
+  // only called from the insert (build) path, pull/push never rehash
+  void rehash(size_t new_capacity, gpuStream_t stream);
   void show();
   void dump_to_cpu(int devid, cudaStream_t stream);
 
@@ -71,6 +74,7 @@ class HashTable {
   int BLOCK_SIZE_{256};
   float LOAD_FACTOR{0.75f};
   size_t capacity_;
+  size_t num_elements_{0};
 };
 }  // end namespace framework
 }  // end namespace paddle
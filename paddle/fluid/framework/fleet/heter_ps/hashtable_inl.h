@@ -42,6 +42,21 @@ __global__ void insert_kernel(Table* table,
   }
 }
 
+template <typename Table>
+__global__ void migrate_kernel(Table* new_table,
+                               const typename Table::value_type* old_data,
+                               size_t old_capacity,
+                               typename Table::key_type unused_key) {
+  ReplaceOp<typename Table::mapped_type> op;
+  const size_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < old_capacity) {
+    if (old_data[i].first != unused_key) {
+      auto it = new_table->insert(old_data[i], op);
+      assert(it != new_table->end() && "error: migrate fails: table is full");
+    }
+  }
+}
+
 template <typename Table>
 __global__ void search_kernel(Table* table,
                               const typename Table::key_type* const keys,
@@ -73,6 +88,7 @@ __global__ void update_kernel(Table* table,
 template <typename KeyType, typename ValType>
 HashTable<KeyType, ValType>::HashTable(size_t capacity) {
   container_ = new TableContainer<KeyType, ValType>(capacity);
+  capacity_ = capacity;
   rwlock_.reset(new RWLock);
 }
 
@@ -104,11 +120,38 @@ void HashTable<KeyType, ValType>::insert(const KeyType* d_keys,
   if (len == 0) {
     return;
   }
+  if (num_elements_ + len > capacity_ * LOAD_FACTOR) {
+    size_t new_capacity = capacity_ * 2;
+    while (num_elements_ + len > new_capacity * LOAD_FACTOR) {
+      new_capacity *= 2;
+    }
+    rehash(new_capacity, stream);
+  }
+  num_elements_ += len;
   const int grid_size = (len - 1) / BLOCK_SIZE_ + 1;
   insert_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(container_, d_keys,
                                                        d_vals, len);
 }
 
+template <typename KeyType, typename ValType>
+void HashTable<KeyType, ValType>::rehash(size_t new_capacity,
+                                         gpuStream_t stream) {
+  auto* new_container = new TableContainer<KeyType, ValType>(new_capacity);
+  // pending inserts into the old container (build_ps round-robins over
+  // several streams) must land before the slots are migrated
+  cudaDeviceSynchronize();
+  const int grid_size = (capacity_ - 1) / BLOCK_SIZE_ + 1;
+  migrate_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(
+      new_container, container_->data(), capacity_,
+      std::numeric_limits<KeyType>::max());
+  cudaStreamSynchronize(stream);
+  delete container_;
+  container_ = new_container;
+  VLOG(1) << "hashtable rehashed from " << capacity_ << " to " << new_capacity
+          << " slots with " << num_elements_ << " elements";
+  capacity_ = new_capacity;
+}
+
 template <typename KeyType, typename ValType>
 void HashTable<KeyType, ValType>::dump_to_cpu(int devid, cudaStream_t stream) {
   container_->prefetch(cudaCpuDeviceId, stream);
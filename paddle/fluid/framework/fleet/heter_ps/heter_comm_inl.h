@@ -18,11 +18,16 @@ limitations under the License. */
 namespace paddle {
 namespace framework {
 
-template <typename T>
-__global__ void fill_idx(T* idx, size_t len) {
+// fused: writes the identity permutation and the destination shard of
+// every key in one pass, instead of two kernel launches over the input
+template <typename KeyType, typename T>
+__global__ void fill_idx_and_shard_index(T* idx, KeyType* d_keys,
+                                         T* shard_index, size_t len,
+                                         int total_gpu) {
   const size_t i = blockIdx.x * blockDim.x + threadIdx.x;
   if (i < len) {
     idx[i] = i;
+    shard_index[i] = d_keys[i] % total_gpu;
   }
 }
 
@@ -55,15 +60,6 @@ __global__ void calc_shard_offset(T* idx, T* left, T* right, size_t len) {
   }
 }
 
-template <typename KeyType, typename T>
-__global__ void calc_shard_index(KeyType* d_keys, size_t len, T* shard_index,
-                                 int total_gpu) {
-  const size_t i = blockIdx.x * blockDim.x + threadIdx.x;
-  if (i < len) {
-    shard_index[i] = d_keys[i] % total_gpu;
-  }
-}
-
 template <typename KeyType, typename T>
 __global__ void fill_shard_key(KeyType* d_shard_keys, KeyType* d_keys, T* idx,
                                size_t len) {
@@ -438,9 +434,8 @@ void HeterComm<KeyType, ValType, GradType>::split_input_to_shard(
   int* d_shard_index_tmp_ptr = reinterpret_cast<int*>(d_shard_index_tmp->ptr());
 
   int grid_size = (len - 1) / block_size_ + 1;
-  fill_idx<<<grid_size, block_size_, 0, stream>>>(d_idx_tmp_ptr, len);
-  calc_shard_index<<<grid_size, block_size_, 0, stream>>>(
-      d_keys, len, d_shard_index_tmp_ptr, total_gpu);
+  fill_idx_and_shard_index<<<grid_size, block_size_, 0, stream>>>(
+      d_idx_tmp_ptr, d_keys, d_shard_index_tmp_ptr, len, total_gpu);
 
   size_t temp_storage_bytes;
   const int num_bits = 1 + log2i(total_gpu);
@@ -474,16 +469,17 @@ void HeterComm<KeyType, ValType, GradType>::pull_sparse(int num,
 
   int grid_size = (len - 1) / block_size_ + 1;
 
-  int h_left[total_gpu];
-  int h_right[total_gpu];
+  // left and right share one buffer so the shard boundaries come back to
+  // the host in a single batched copy
+  int h_left_right[2 * total_gpu];
+  int* h_left = h_left_right;
+  int* h_right = h_left_right + total_gpu;
 
-  auto d_left = memory::AllocShared(place, total_gpu * sizeof(int));
-  auto d_right = memory::AllocShared(place, total_gpu * sizeof(int));
-  int* d_left_ptr = reinterpret_cast<int*>(d_left->ptr());
-  int* d_right_ptr = reinterpret_cast<int*>(d_right->ptr());
+  auto d_left_right = memory::AllocShared(place, 2 * total_gpu * sizeof(int));
+  int* d_left_ptr = reinterpret_cast<int*>(d_left_right->ptr());
+  int* d_right_ptr = d_left_ptr + total_gpu;
 
-  cudaMemset(d_left_ptr, -1, total_gpu * sizeof(int));
-  cudaMemset(d_right_ptr, -1, total_gpu * sizeof(int));
+  cudaMemset(d_left_ptr, -1, 2 * total_gpu * sizeof(int));
   //
   auto d_idx = memory::AllocShared(place, len * sizeof(int));
   int* d_idx_ptr = reinterpret_cast<int*>(d_idx->ptr());
@@ -498,13 +494,10 @@ void HeterComm<KeyType, ValType, GradType>::pull_sparse(int num,
   fill_shard_key<<<grid_size, block_size_, 0, stream>>>(d_shard_keys_ptr,
                                                         d_keys, d_idx_ptr, len);
 
+  cudaMemcpyAsync(h_left_right, d_left_ptr, 2 * total_gpu * sizeof(int),
+                  cudaMemcpyDeviceToHost, stream);
   cudaStreamSynchronize(stream);
 
-  cudaMemcpy(h_left, d_left_ptr, total_gpu * sizeof(int),
-             cudaMemcpyDeviceToHost);
-  cudaMemcpy(h_right, d_right_ptr, total_gpu * sizeof(int),
-             cudaMemcpyDeviceToHost);
-
   std::vector<std::shared_ptr<memory::Allocation>> local_storage;
 
   for (int i = 0; i < total_gpu; ++i) {
@@ -564,16 +557,15 @@ void HeterComm<KeyType, ValType, GradType>::push_sparse(int gpu_num,
   platform::CUDADeviceGuard guard(dev_id);
   auto stream = resource_->local_stream(gpu_num, 0);
 
-  int h_left[total_gpu];
-  int h_right[total_gpu];
+  int h_left_right[2 * total_gpu];
+  int* h_left = h_left_right;
+  int* h_right = h_left_right + total_gpu;
 
-  auto d_left = memory::AllocShared(place, total_gpu * sizeof(int));
-  auto d_right = memory::AllocShared(place, total_gpu * sizeof(int));
-  int* d_left_ptr = reinterpret_cast<int*>(d_left->ptr());
-  int* d_right_ptr = reinterpret_cast<int*>(d_right->ptr());
+  auto d_left_right = memory::AllocShared(place, 2 * total_gpu * sizeof(int));
+  int* d_left_ptr = reinterpret_cast<int*>(d_left_right->ptr());
+  int* d_right_ptr = d_left_ptr + total_gpu;
 
-  cudaMemset(d_left_ptr, -1, total_gpu * sizeof(int));
-  cudaMemset(d_right_ptr, -1, total_gpu * sizeof(int));
+  cudaMemset(d_left_ptr, -1, 2 * total_gpu * sizeof(int));
   //
   auto d_idx = memory::AllocShared(place, len * sizeof(int));
   int* d_idx_ptr = reinterpret_cast<int*>(d_idx->ptr());
@@ -596,13 +588,10 @@ void HeterComm<KeyType, ValType, GradType>::push_sparse(int gpu_num,
       d_shard_keys_ptr, d_keys, d_shard_grads_ptr, d_grads, d_idx_ptr,
       uniq_len);
 
+  cudaMemcpyAsync(h_left_right, d_left_ptr, 2 * total_gpu * sizeof(int),
+                  cudaMemcpyDeviceToHost, stream);
   cudaStreamSynchronize(stream);
 
-  cudaMemcpy(h_left, d_left_ptr, total_gpu * sizeof(int),
-             cudaMemcpyDeviceToHost);
-  cudaMemcpy(h_right, d_right_ptr, total_gpu * sizeof(int),
-             cudaMemcpyDeviceToHost);
-
   std::vector<std::shared_ptr<memory::Allocation>> local_storage;
   for (int i = 0; i < total_gpu; ++i) {
     int shard_len = h_right[i] - h_left[i] + 1;
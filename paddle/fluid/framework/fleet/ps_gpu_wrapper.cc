@@ -283,36 +283,10 @@ void PSGPUWrapper::BuildPull(std::shared_ptr<HeterContext> gpu_task) {
               << local_keys[i].size();
     }
   };
-  for (size_t i = 0; i < threads.size(); i++) {
-    threads[i] = std::thread(ptl_func, i);
-  }
-  for (std::thread& t : threads) {
-    t.join();
-  }
-  timeline.Pause();
-  VLOG(1) << "pull sparse from CpuPS into GpuPS cost " << timeline.ElapsedSec()
-          << " seconds.";
-  if (multi_node_) {
-    auto gloo_wrapper = paddle::framework::GlooWrapper::GetInstance();
-    if (!gloo_wrapper->IsInitialized()) {
-      VLOG(0) << "GLOO is not inited";
-      gloo_wrapper->Init();
-    }
-    gloo_wrapper->Barrier();
-  }
-
-  timeline.Start();
   std::vector<std::vector<std::pair<uint64_t, char*>>> pass_values;
 
   bool record_status = false;
-#ifdef PADDLE_WITH_PSLIB
-  uint16_t pass_id = 0;
-  if (multi_node_) {
-    record_status = fleet_ptr->pslib_ptr_->_worker_ptr->take_sparse_record(
-        table_id_, pass_id, pass_values);
-  }
-#endif
-  auto build_func = [device_num, record_status, &pass_values, &local_keys,
+  auto build_func = [device_num, &record_status, &pass_values, &local_keys,
                      &local_ptr, &device_keys, &device_vals,
                      &device_mutex](int i) {
     std::vector<std::vector<FeatureKey>> task_keys(device_num);
@@ -415,15 +389,56 @@ void PSGPUWrapper::BuildPull(std::shared_ptr<HeterContext> gpu_task) {
     }
   };
 
-  for (size_t i = 0; i < threads.size(); i++) {
-    threads[i] = std::thread(build_func, i);
-  }
-  for (std::thread& t : threads) {
-    t.join();
+  if (!multi_node_) {
+    //单机：每个shard拉完立刻分桶，shard之间流水并行
+    auto shard_func = [&ptl_func, &build_func](int i) {
+      ptl_func(i);
+      build_func(i);
+    };
+    for (size_t i = 0; i < threads.size(); i++) {
+      threads[i] = std::thread(shard_func, i);
+    }
+    for (std::thread& t : threads) {
+      t.join();
+    }
+    timeline.Pause();
+    VLOG(1) << "pull sparse and prepare for build hbm cost "
+            << timeline.ElapsedSec() << " seconds.";
+  } else {
+    // the barrier and the pass record exchange need every shard pulled,
+    // so the two phases stay separate across nodes
+    for (size_t i = 0; i < threads.size(); i++) {
+      threads[i] = std::thread(ptl_func, i);
+    }
+    for (std::thread& t : threads) {
+      t.join();
+    }
+    timeline.Pause();
+    VLOG(1) << "pull sparse from CpuPS into GpuPS cost "
+            << timeline.ElapsedSec() << " seconds.";
+    auto gloo_wrapper = paddle::framework::GlooWrapper::GetInstance();
+    if (!gloo_wrapper->IsInitialized()) {
+      VLOG(0) << "GLOO is not inited";
+      gloo_wrapper->Init();
+    }
+    gloo_wrapper->Barrier();
+
+    timeline.Start();
+#ifdef PADDLE_WITH_PSLIB
+    uint16_t pass_id = 0;
+    record_status = fleet_ptr->pslib_ptr_->_worker_ptr->take_sparse_record(
+        table_id_, pass_id, pass_values);
+#endif
+    for (size_t i = 0; i < threads.size(); i++) {
+      threads[i] = std::thread(build_func, i);
+    }
+    for (std::thread& t : threads) {
+      t.join();
+    }
+    timeline.Pause();
+    VLOG(1) << "GpuPs prepare for build hbm cost " << timeline.ElapsedSec()
+            << " seconds.";
   }
-  timeline.Pause();
-  VLOG(1) << "GpuPs prepare for build hbm cost " << timeline.ElapsedSec()
-          << " seconds.";
 }
 
 void PSGPUWrapper::BuildGPUTask(std::shared_ptr<HeterContext> gpu_task) {
@@ -519,17 +534,25 @@ void PSGPUWrapper::build_thread() {
   // build: build_pull + build_gputask
   while (running_) {
     std::shared_ptr<HeterContext> gpu_task = nullptr;
-    if (!gpu_free_channel_->Get(gpu_task)) {
-      continue;
-    }
     if (!buildcpu_ready_channel_->Get(gpu_task)) {
       continue;
     }
-    VLOG(3) << "thread BuildGPUTask start.";
+    // BuildPull only touches CPU-side state, so the next pass's pull and
+    // partition overlap the current pass's training
+    VLOG(3) << "thread BuildPull start.";
     platform::Timer timer;
     timer.Start();
     BuildPull(gpu_task);
     timer.Pause();
+    VLOG(1) << "thread BuildPull end, cost time: " << timer.ElapsedSec()
+            << "s";
+    // BuildGPUTask frees the live HBM table, so it must wait for the
+    // current pass to end and return the gpu free token
+    std::shared_ptr<HeterContext> free_token = nullptr;
+    if (!gpu_free_channel_->Get(free_token)) {
+      continue;
+    }
+    VLOG(3) << "thread BuildGPUTask start.";
     timer.Start();
     BuildGPUTask(gpu_task);
     timer.Pause();
@@ -58,6 +58,10 @@ TEST(TEST_GLOO, store_1) {
   gw.Barrier();
   std::vector<double> input;
   gw.AllReduce(input);
+  gw.SetAllReduceChunkElements(2);
+  std::vector<double> chunked_input(5, 1.0);
+  gw.AllReduce(chunked_input);
+  gw.SetAllReduceChunkElements(0);
   int64_t t;
   gw.AllGather(t);
 #endif
@@ -12,7 +12,10 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License. */
 
+#include <condition_variable>  // NOLINT
 #include <ctime>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
 #include "paddle/fluid/framework/data_type.h"
 #include "paddle/fluid/framework/device_worker.h"
 #include "paddle/fluid/operators/controlflow/conditional_block_op_helper.h"
@@ -35,6 +38,7 @@ void HogwildWorker::Initialize(const TrainerDesc &desc) {
   }
   use_cvm_ = desc.use_cvm();
   thread_barrier_ = desc.thread_barrier();
+  double_buffered_ = param_.double_buffered();
 
   for (int i = 0; i < param_.stat_var_names_size(); ++i) {
     stat_var_name_map_[param_.stat_var_names(i)] = 1;
@@ -207,7 +211,139 @@ void HogwildWorker::TrainFilesWithProfiler() {
 #endif
 }
 
+int HogwildWorker::StageBatch(Scope *scope) {
+  const std::vector<std::string> &input_feed =
+      device_reader_->GetUseSlotAlias();
+  for (auto &name : input_feed) {
+    device_reader_->AddFeedVar(scope->FindVar(name), name);
+  }
+  return device_reader_->Next();
+}
+
+void HogwildWorker::TrainFilesDoubleBuffered() {
+  platform::SetNumThreads(1);
+  platform::Timer timeline;
+  timeline.Start();
+
+  device_reader_->Start();
+
+  // Two feed scopes under the thread scope, each holding its own copy of
+  // the feed vars. All other vars resolve through the parent, so ops,
+  // stat vars, fetch vars and dumps keep using thread_scope_'s storage;
+  // only the feed slots alternate. The feeder thread therefore never
+  // touches a variable the compute thread is using.
+  Scope *feed_scopes[2] = {&thread_scope_->NewScope(),
+                           &thread_scope_->NewScope()};
+  const std::vector<std::string> &input_feed =
+      device_reader_->GetUseSlotAlias();
+  for (auto *scope : feed_scopes) {
+    for (auto &name : input_feed) {
+      scope->Var(name);
+    }
+  }
+
+  std::mutex mu;
+  std::condition_variable cv;
+  bool stage_request = false;
+  bool staged_valid = false;
+  bool done = false;
+  int stage_index = 0;
+  int staged_size = 0;
+
+  std::thread feeder([&]() {
+    std::unique_lock<std::mutex> lock(mu);
+    for (;;) {
+      cv.wait(lock, [&] { return stage_request || done; });
+      if (done) {
+        break;
+      }
+      stage_request = false;
+      int index = stage_index;
+      lock.unlock();
+      int batch = StageBatch(feed_scopes[index]);
+      lock.lock();
+      staged_size = batch;
+      staged_valid = true;
+      cv.notify_all();
+    }
+  });
+
+  auto request_stage = [&](int index) {
+    std::lock_guard<std::mutex> lock(mu);
+    stage_index = index;
+    stage_request = true;
+    cv.notify_all();
+  };
+  auto wait_staged = [&]() {
+    std::unique_lock<std::mutex> lock(mu);
+    cv.wait(lock, [&] { return staged_valid; });
+    staged_valid = false;
+    return staged_size;
+  };
+
+  int total_ins_num = 0;
+  int batch_cnt = 0;
+  int cur_index = 0;
+  request_stage(cur_index);
+  int cur_batch = wait_staged();
+  while (cur_batch > 0) {
+    // batch N+1 is read into the spare scope while batch N computes
+    request_stage(1 - cur_index);
+    Scope &scope = *feed_scopes[cur_index];
+    for (auto &op : ops_) {
+      bool need_skip = false;
+      for (auto t = 0u; t < skip_ops_.size(); ++t) {
+        if (op->Type().find(skip_ops_[t]) != std::string::npos) {
+          need_skip = true;
+          break;
+        }
+      }
+      if (!need_skip) {
+        op->Run(scope, place_);
+      }
+    }
+
+    if (need_dump_field_) {
+      DumpField(scope, dump_mode_, dump_interval_);
+    }
+    if (need_dump_param_ && thread_id_ == 0) {
+      DumpParam(scope, batch_cnt);
+    }
+
+    total_ins_num += cur_batch;
+    ++batch_cnt;
+    PrintFetchVars();
+    scope.DropKids();
+    cur_index = 1 - cur_index;
+    cur_batch = wait_staged();
+  }
+  {
+    std::lock_guard<std::mutex> lock(mu);
+    done = true;
+    cv.notify_all();
+  }
+  feeder.join();
+
+  timeline.Pause();
+  VLOG(3) << "worker " << thread_id_ << " train cost " << timeline.ElapsedSec()
+          << " seconds, ins_num: " << total_ins_num;
+
+  if (need_dump_field_ || need_dump_param_) {
+    writer_.Flush();
+  }
+
+#if defined PADDLE_WITH_PSCORE
+  if (thread_barrier_) {
+    paddle::distributed::Communicator::GetInstance()->BarrierTriggerDecrement();
+  }
+#endif
+}
+
 void HogwildWorker::TrainFiles() {
+  if (double_buffered_) {
+    TrainFilesDoubleBuffered();
+    return;
+  }
   platform::SetNumThreads(1);
   platform::Timer timeline;
   timeline.Start();
@@ -15,7 +15,18 @@ limitations under the License. */
 #include "paddle/fluid/framework/io/fs.h"
 
 #include <sys/stat.h>
+#include <cstring>
 #include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <csignal>
+#endif
 
 #include "glog/logging.h"
 #include "paddle/fluid/platform/enforce.h"
@@ -81,6 +92,92 @@ static std::shared_ptr<FILE> fs_open_internal(const std::string& path,
   return fp;
 }
 
+static size_t& fs_readahead_buffer_size_internal() {
+  static size_t x = 0;
+  return x;
+}
+
+size_t fs_readahead_buffer_size() { return fs_readahead_buffer_size_internal(); }
+
+void fs_set_readahead_buffer_size(size_t x) {
+  fs_readahead_buffer_size_internal() = x;
+}
+
+// Decouple the consumer from the latency of the underlying stream: a
+// background thread reads `src` in buffer_size chunks and pushes the bytes
+// through an OS pipe whose capacity is raised to buffer_size, so up to two
+// buffers are in flight while the consumer parses the previous one. The
+// returned stream is a plain FILE*, keeping the fs_open_read contract.
+// Returns `src` unchanged when readahead cannot be set up.
+static std::shared_ptr<FILE> fs_add_readahead_internal(
+    std::shared_ptr<FILE> src, size_t buffer_size) {
+#ifdef _WIN32
+  return src;
+#else
+  if (src == nullptr || buffer_size == 0) {
+    return src;
+  }
+
+  int pipe_fds[2];
+  if (pipe(pipe_fds) != 0) {
+    LOG(WARNING) << "readahead disabled, pipe() failed: " << strerror(errno);
+    return src;
+  }
+#if defined(F_SETPIPE_SZ)
+  // Best effort; the default pipe capacity still works, just smaller.
+  fcntl(pipe_fds[1], F_SETPIPE_SZ, static_cast<int>(buffer_size));
+#endif
+
+  int write_fd = pipe_fds[1];
+  auto* thread = new std::thread([src, buffer_size, write_fd]() {
+    // The consumer may close the read end early (e.g. stopping at a parse
+    // error); block SIGPIPE in this thread so write() reports EPIPE instead
+    // of killing the process.
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &set, nullptr);
+
+    std::vector<char> buffer(buffer_size);
+    bool reader_alive = true;
+    while (reader_alive) {
+      size_t n = fread(buffer.data(), 1, buffer.size(), src.get());
+      if (n == 0) {
+        break;
+      }
+      size_t off = 0;
+      while (off < n) {
+        ssize_t w = write(write_fd, buffer.data() + off, n - off);
+        if (w < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          reader_alive = false;
+          break;
+        }
+        off += static_cast<size_t>(w);
+      }
+    }
+    close(write_fd);
+  });
+
+  FILE* read_fp = fdopen(pipe_fds[0], "r");
+  if (read_fp == nullptr) {
+    close(pipe_fds[0]);
+    thread->join();
+    delete thread;
+    return src;
+  }
+
+  return {read_fp, [thread](FILE* fp) {
+            // Closing the read end unblocks the relay thread with EPIPE.
+            fclose(fp);
+            thread->join();
+            delete thread;
+          }};
+#endif  // _WIN32
+}
+
 static bool fs_begin_with_internal(const std::string& path,
                                    const std::string& str) {
   return strncmp(path.c_str(), str.c_str(), str.length()) == 0;
@@ -255,7 +352,9 @@ std::shared_ptr<FILE> hdfs_open_read(std::string path, int* err_no,
 
   bool is_pipe = true;
   fs_add_read_converter_internal(path, is_pipe, converter);
-  return fs_open_internal(path, is_pipe, "r", hdfs_buffer_size(), err_no);
+  return fs_add_readahead_internal(
+      fs_open_internal(path, is_pipe, "r", hdfs_buffer_size(), err_no),
+      fs_readahead_buffer_size());
 }
 
 std::shared_ptr<FILE> hdfs_open_write(std::string path, int* err_no,
@@ -29,6 +29,15 @@ namespace framework {
 
 int fs_select_internal(const std::string& path);
 
+// Readahead for remote streams. When set to a non-zero chunk size, every
+// hdfs_open_read stream is drained by a background thread in chunks of that
+// size and handed to the consumer through an OS pipe, so pipe latency
+// overlaps with parsing instead of serializing with it. 0 (default) disables
+// readahead.
+extern size_t fs_readahead_buffer_size();
+
+extern void fs_set_readahead_buffer_size(size_t x);
+
 // localfs
 extern size_t localfs_buffer_size();
 
@@ -0,0 +1,326 @@
+/* Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include "paddle/fluid/framework/ir/bias_dropout_residual_layer_norm_fuse_pass.h"
+
+#include <string>
+
+#include "paddle/fluid/framework/ir/graph_pattern_detector.h"
+
+namespace paddle {
+namespace framework {
+namespace ir {
+class Node;
+}  // namespace ir
+}  // namespace framework
+}  // namespace paddle
+
+namespace paddle {
+namespace framework {
+namespace ir {
+namespace patterns {
+
+struct BiasDropoutResidualLayerNorm : public PatternBase {
+  BiasDropoutResidualLayerNorm(PDPattern *pattern,
+                               const std::string &name_scope)
+      : PatternBase(pattern, name_scope, "bias_dropout_residual_layer_norm") {}
+
+  PDNode *operator()(PDNode *x);
+
+  // declare operator node's name
+  PATTERN_DECL_NODE(dropout);
+  PATTERN_DECL_NODE(elementwise);
+  PATTERN_DECL_NODE(layer_norm);
+  // declare variable node's name
+  PATTERN_DECL_NODE(dropout_out);  // (x) -> dropout_out
+  PATTERN_DECL_NODE(residual);
+  PATTERN_DECL_NODE(elementwise_out);  // (dropout_out,residual)
+  PATTERN_DECL_NODE(layer_norm_bias);
+  PATTERN_DECL_NODE(layer_norm_scale);
+  PATTERN_DECL_NODE(layer_norm_out);
+  PATTERN_DECL_NODE(layer_norm_mean);
+  PATTERN_DECL_NODE(layer_norm_variance);
+};
+
+PDNode *BiasDropoutResidualLayerNorm::operator()(PDNode *x) {
+  // Create nodes for dropout op.
+  x->assert_is_op_input("dropout", "X");
+  auto *dropout = pattern->NewNode(dropout_repr())->assert_is_op("dropout");
+  auto *dropout_out_var = pattern->NewNode(dropout_out_repr())
+                              ->assert_is_op_output("dropout", "Out");
+
+  // Add links for dropout op.
+  dropout->LinksFrom({x}).LinksTo({dropout_out_var});
+
+  // Create nodes for elementwise_add op.
+  dropout_out_var->AsIntermediate()->assert_is_op_input("elementwise_add");
+  auto *elementwise =
+      pattern->NewNode(elementwise_repr())->assert_is_op("elementwise_add");
+  auto *residual_var =
+      pattern->NewNode(residual_repr())->assert_is_op_input("elementwise_add");
+  auto *elementwise_out_var = pattern->NewNode(elementwise_out_repr())
+                                  ->AsOutput()
+                                  ->assert_is_op_output("elementwise_add");
+
+  // Add links for elementwise_add op.
+  elementwise->LinksFrom({dropout_out_var, residual_var})
+      .LinksTo({elementwise_out_var});
+
+  // Create nodes for layer_norm op.
+  elementwise_out_var->assert_is_op_input("layer_norm");
+  auto *layer_norm =
+      pattern->NewNode(layer_norm_repr())->assert_is_op("layer_norm");
+  auto *layer_norm_bias_var = pattern->NewNode(layer_norm_bias_repr())
+                                  ->AsInput()
+                                  ->assert_is_persistable_var()
+                                  ->assert_is_op_input("layer_norm", "Bias");
+  auto *layer_norm_scale_var = pattern->NewNode(layer_norm_scale_repr())
+                                   ->AsInput()
+                                   ->assert_is_persistable_var()
+                                   ->assert_is_op_input("layer_norm", "Scale");
+
+  auto *layer_norm_out_var = pattern->NewNode(layer_norm_out_repr())
+                                 ->AsOutput()
+                                 ->assert_is_op_output("layer_norm", "Y");
+  auto *layer_norm_mean_var = pattern->NewNode(layer_norm_mean_repr())
+                                  ->AsOutput()
+                                  ->assert_is_op_output("layer_norm", "Mean");
+  auto *layer_norm_variance_var =
+      pattern->NewNode(layer_norm_variance_repr())
+          ->AsOutput()
+          ->assert_is_op_output("layer_norm", "Variance");
+
+  // Add links for layer_norm op.
+  layer_norm
+      ->LinksFrom(
+          {elementwise_out_var, layer_norm_bias_var, layer_norm_scale_var})
+      .LinksTo(
+          {layer_norm_out_var, layer_norm_mean_var, layer_norm_variance_var});
+  return layer_norm_out_var;
+}
+
+}  // namespace patterns
+
+template <typename T>
+static bool IsEqual(const std::vector<T> &x, const std::vector<T> &y) {
+  if (!(x.size() > 0U && y.size() > 0U) || x.size() != y.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < x.size(); ++i) {
+    if (x[i] != y[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+BiasDropoutResidualLayerNormFusePass::BiasDropoutResidualLayerNormFusePass() {
+  AddOpCompat(OpCompat("dropout"))
+      .AddInput("X")
+      .IsTensor()
+      .End()
+      .AddOutput("Out")
+      .IsTensor()
+      .End()
+      .AddOutput("Mask")
+      .IsOptional()
+      .End()
+      .AddAttr("dropout_prob")
+      .IsNumGE(0.0f)
+      .IsNumLE(1.0f)
+      .End()
+      .AddAttr("dropout_implementation")
+      .IsStringIn({"downgrade_in_infer", "upscale_in_train"})
+      .End();
+
+  AddOpCompat(OpCompat("elementwise_add"))
+      .AddInput("X")
+      .IsTensor()
+      .End()
+      .AddInput("Y")
+      .IsTensor()
+      .End()
+      .AddOutput("Out")
+      .IsTensor()
+      .End()
+      .AddAttr("axis")
+      .IsIntIn({-1, 0})
+      .End();
+
+  AddOpCompat(OpCompat("layer_norm"))
+      .AddInput("X")
+      .IsTensor()
+      .End()
+      .AddInput("Scale")
+      .IsTensor()
+      .End()
+      .AddInput("Bias")
+      .IsTensor()
+      .End()
+      .AddOutput("Y")
+      .IsTensor()
+      .End()
+      .AddOutput("Mean")
+      .IsOptional()
+      .End()
+      .AddOutput("Variance")
+      .IsOptional()
+      .End()
+      .AddAttr("epsilon")
+      .IsNumGE(0.0f)
+      .IsNumLE(0.001f)
+      .End()
+      .AddAttr("begin_norm_axis")
+      .IsNumGT(0)
+      .End();
+}
+
+void BiasDropoutResidualLayerNormFusePass::ApplyImpl(ir::Graph *graph) const {
+  PADDLE_ENFORCE_NOT_NULL(graph,
+                          platform::errors::InvalidArgument(
+                              "Pointer to graph argument should not be NULL."));
+  FusePassBase::Init("bias_dropout_residual_layer_norm_fuse", graph);
+  int found_subgraph_count = 0;
+
+  GraphPatternDetector gpd;
+  auto *x = gpd.mutable_pattern()
+                ->NewNode("bias_dropout_residual_layer_norm_fuse/x")
+                ->AsInput()
+                ->assert_is_op_input("dropout", "X");
+  patterns::BiasDropoutResidualLayerNorm fused_pattern(
+      gpd.mutable_pattern(), "bias_dropout_residual_layer_norm_fuse");
+  fused_pattern(x);
+
+  auto handler = [&](const GraphPatternDetector::subgraph_t &subgraph,
+                     Graph *graph) {
+    if (subgraph.count(x) <= 0) {
+      LOG(WARNING) << "The subgraph is empty.";
+      return;
+    }
+
+    if (!IsCompat(subgraph, graph)) {
+      LOG(WARNING) << "Pass in op compat failed.";
+      return;
+    }
+
+    VLOG(4) << "handle BiasDropoutResidualLayerNorm fuse";
+    GET_IR_NODE_FROM_SUBGRAPH(dropout, dropout, fused_pattern);
+    GET_IR_NODE_FROM_SUBGRAPH(dropout_out, dropout_out, fused_pattern);
+    GET_IR_NODE_FROM_SUBGRAPH(elementwise, elementwise, fused_pattern);
+    GET_IR_NODE_FROM_SUBGRAPH(residual, residual, fused_pattern);
+    GET_IR_NODE_FROM_SUBGRAPH(elementwise_out, elementwise_out, fused_pattern);
+    GET_IR_NODE_FROM_SUBGRAPH(layer_norm, layer_norm, fused_pattern);
+    GET_IR_NODE_FROM_SUBGRAPH(layer_norm_bias, layer_norm_bias, fused_pattern);
+    GET_IR_NODE_FROM_SUBGRAPH(layer_norm_scale, layer_norm_scale,
+                              fused_pattern);
+    GET_IR_NODE_FROM_SUBGRAPH(layer_norm_out, layer_norm_out, fused_pattern);
+    GET_IR_NODE_FROM_SUBGRAPH(layer_norm_mean, layer_norm_mean, fused_pattern);
+    GET_IR_NODE_FROM_SUBGRAPH(layer_norm_variance, layer_norm_variance,
+                              fused_pattern);
+
+    if (!IsEqual(dropout_out->Var()->GetShape(),
+                 residual->Var()->GetShape())) {
+      return;
+    }
+
+    // The fused kernel normalizes over the last dimension only.
+    auto x_shape = dropout_out->Var()->GetShape();
+    int begin_norm_axis =
+        BOOST_GET_CONST(int, layer_norm->Op()->GetAttr("begin_norm_axis"));
+    if (begin_norm_axis != static_cast<int>(x_shape.size()) - 1) {
+      return;
+    }
+
+    if (dropout_out->outputs.size() > 1U) {
+      // dropout_out disappears in the fused op, so it must not feed any
+      // other operator. elementwise_out survives as
+      // BiasDropoutResidualOut and may keep extra consumers.
+      return;
+    }
+
+    std::unordered_set<const Node *> del_node_set;
+
+    // Reuse dropout's Mask variable for the fused mask output when it
+    // exists, otherwise create one.
+    Node *mask_node = nullptr;
+    for (auto *out_node : dropout->outputs) {
+      if (out_node != dropout_out) {
+        mask_node = out_node;
+        break;
+      }
+    }
+    if (mask_node == nullptr) {
+      VarDesc mask_desc(patterns::PDNodeName(
+          "bias_dropout_residual_layer_norm_fuse", "dropout_mask"));
+      mask_desc.SetPersistable(false);
+      mask_node = graph->CreateVarNode(&mask_desc);
+    }
+
+    // Create the fused op node.
+    OpDesc new_desc;
+    new_desc.SetType("fused_bias_dropout_residual_layer_norm");
+
+    // inputs
+    new_desc.SetInput("X", {subgraph.at(x)->Name()});
+    new_desc.SetInput("Residual", {residual->Name()});
+    new_desc.SetInput("LnScale", {layer_norm_scale->Name()});
+    new_desc.SetInput("LnBias", {layer_norm_bias->Name()});
+
+    // outputs
+    new_desc.SetOutput("Y", {layer_norm_out->Name()});
+    new_desc.SetOutput("BiasDropoutResidualOut", {elementwise_out->Name()});
+    new_desc.SetOutput("DropoutMaskOut", {mask_node->Name()});
+    new_desc.SetOutput("LnMean", {layer_norm_mean->Name()});
+    new_desc.SetOutput("LnVariance", {layer_norm_variance->Name()});
+
+    // attrs
+    new_desc.SetAttr("dropout_prob", dropout->Op()->GetAttr("dropout_prob"));
+    new_desc.SetAttr("dropout_implementation",
+                     dropout->Op()->GetAttr("dropout_implementation"));
+    new_desc.SetAttr("dropout_is_test", dropout->Op()->GetAttr("is_test"));
+    new_desc.SetAttr("dropout_fix_seed", dropout->Op()->GetAttr("fix_seed"));
+    new_desc.SetAttr("dropout_seed", dropout->Op()->GetAttr("seed"));
+    new_desc.SetAttr("ln_epsilon", layer_norm->Op()->GetAttr("epsilon"));
+
+    auto fused_node = graph->CreateOpNode(&new_desc);  // OpDesc will be copied.
+
+    del_node_set.insert(dropout);
+    del_node_set.insert(elementwise);
+    del_node_set.insert(layer_norm);
+    del_node_set.insert(dropout_out);
+    GraphSafeRemoveNodes(graph, del_node_set);
+
+    IR_NODE_LINK_TO(subgraph.at(x), fused_node);
+    IR_NODE_LINK_TO(residual, fused_node);
+    IR_NODE_LINK_TO(layer_norm_scale, fused_node);
+    IR_NODE_LINK_TO(layer_norm_bias, fused_node);
+    IR_NODE_LINK_TO(fused_node, layer_norm_out);
+    IR_NODE_LINK_TO(fused_node, elementwise_out);
+    IR_NODE_LINK_TO(fused_node, mask_node);
+    IR_NODE_LINK_TO(fused_node, layer_norm_mean);
+    IR_NODE_LINK_TO(fused_node, layer_norm_variance);
+
+    found_subgraph_count++;
+  };
+
+  gpd(graph, handler);
+  AddStatis(found_subgraph_count);
+}
+
+}  // namespace ir
+}  // namespace framework
+}  // namespace paddle
+
+REGISTER_PASS(bias_dropout_residual_layer_norm_fuse_pass,
+              paddle::framework::ir::BiasDropoutResidualLayerNormFusePass);
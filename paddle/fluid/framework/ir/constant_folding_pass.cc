@@ -0,0 +1,155 @@
+/* Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include "paddle/fluid/framework/ir/constant_folding_pass.h"
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "paddle/fluid/framework/ir/graph_helper.h"
+#include "paddle/fluid/framework/ir/graph_pattern_detector.h"
+#include "paddle/fluid/framework/lod_tensor.h"
+#include "paddle/fluid/framework/op_registry.h"
+#include "paddle/fluid/framework/operator.h"
+
+namespace paddle {
+namespace framework {
+namespace ir {
+
+namespace {
+
+bool HasCPUKernel(const std::string &op_type) {
+  auto &all_kernels = OperatorWithKernel::AllOpKernels();
+  auto it = all_kernels.find(op_type);
+  if (it == all_kernels.end()) return false;
+  for (auto &kernel_pair : it->second) {
+    if (platform::is_cpu_place(kernel_pair.first.place_)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+void ConstantFoldingPass::ApplyImpl(ir::Graph *graph) const {
+  PADDLE_ENFORCE_NOT_NULL(
+      graph, platform::errors::InvalidArgument(
+                 "The input graph of ConstantFoldingPass should not be null."));
+  FusePassBase::Init("constant_folding", graph);
+  auto *scope = param_scope();
+  PADDLE_ENFORCE_NOT_NULL(
+      scope, platform::errors::InvalidArgument(
+                 "The scope of ConstantFoldingPass should not be null."));
+
+  // Ops that must not be folded even when all their inputs are constant.
+  const std::unordered_set<std::string> blocklist{
+      "feed", "fetch", "while", "conditional_block", "recurrent", "dropout"};
+
+  int folded_op_num = 0;
+  for (auto *op_node : TopologySortOperations(*graph)) {
+    auto *op_desc = op_node->Op();
+    if (op_desc == nullptr) continue;
+    const std::string &op_type = op_desc->Type();
+    if (blocklist.count(op_type)) continue;
+    if (op_desc->HasAttr("sub_block")) continue;
+    // Ops with random outputs are not constant even with constant inputs.
+    if (op_type.find("random") != std::string::npos) continue;
+    // Folding an input-less op would treat every source op as constant;
+    // fill_constant is the only deterministic one worth folding, and it is
+    // the usual root of exported shape arithmetic.
+    if (op_node->inputs.empty() && op_type != "fill_constant") continue;
+    if (op_node->outputs.empty()) continue;
+    if (!HasCPUKernel(op_type)) continue;
+
+    bool foldable = true;
+    for (auto *in_node : op_node->inputs) {
+      auto *in_var = in_node->Var();
+      if (in_var == nullptr || !in_var->Persistable() ||
+          in_var->GetType() != proto::VarType::LOD_TENSOR ||
+          scope->FindVar(in_node->Name()) == nullptr) {
+        foldable = false;
+        break;
+      }
+    }
+    for (auto *out_node : op_node->outputs) {
+      auto *out_var = out_node->Var();
+      // Never overwrite an existing persistable var (a weight).
+      if (out_var == nullptr || out_var->Persistable() ||
+          out_var->GetType() != proto::VarType::LOD_TENSOR) {
+        foldable = false;
+        break;
+      }
+    }
+    if (!foldable) continue;
+
+    // Execute the op once on the CPU in a scratch scope. The inputs are
+    // shared into the scratch scope, the outputs keep their allocations
+    // alive through the shared holder after it is destroyed.
+    Scope scratch_scope;
+    for (auto *in_node : op_node->inputs) {
+      auto &src_tensor = scope->FindVar(in_node->Name())->Get<LoDTensor>();
+      if (!src_tensor.IsInitialized()) {
+        foldable = false;
+        break;
+      }
+      auto *dst_tensor =
+          scratch_scope.Var(in_node->Name())->GetMutable<LoDTensor>();
+      dst_tensor->ShareDataWith(src_tensor);
+      dst_tensor->set_lod(src_tensor.lod());
+    }
+    if (!foldable) continue;
+    for (auto *out_node : op_node->outputs) {
+      scratch_scope.Var(out_node->Name());
+    }
+
+    try {
+      auto op = OpRegistry::CreateOp(*op_desc);
+      op->Run(scratch_scope, platform::CPUPlace());
+    } catch (...) {
+      // The op may reject the constant inputs at runtime (unsupported
+      // dtype, invalid attribute combination); leave it in the graph.
+      VLOG(3) << "Can not fold op " << op_type << ", skipped.";
+      continue;
+    }
+
+    for (auto *out_node : op_node->outputs) {
+      auto &folded_tensor =
+          scratch_scope.FindVar(out_node->Name())->Get<LoDTensor>();
+      auto *dst_tensor =
+          scope->Var(out_node->Name())->GetMutable<LoDTensor>();
+      dst_tensor->ShareDataWith(folded_tensor);
+      dst_tensor->set_lod(folded_tensor.lod());
+      out_node->Var()->SetPersistable(true);
+      out_node->Var()->SetShape(framework::vectorize(folded_tensor.dims()));
+    }
+
+    VLOG(4) << "Fold op " << op_type << " into constant output(s).";
+    GraphSafeRemoveNodes(graph, {op_node});
+    ++folded_op_num;
+  }
+
+  if (folded_op_num > 0) {
+    LOG(INFO) << "---  folded " << folded_op_num
+              << " constant subgraph ops into precomputed tensors";
+  }
+}
+
+}  // namespace ir
+}  // namespace framework
+}  // namespace paddle
+
+REGISTER_PASS(constant_folding_pass,
+              paddle::framework::ir::ConstantFoldingPass);
@@ -15,6 +15,8 @@
 #include "paddle/fluid/framework/ir/cost_model.h"
 
 #include <memory>
+#include <sstream>
+#include "paddle/fluid/framework/data_type.h"
 #include "paddle/fluid/framework/executor.h"
 #include "paddle/fluid/framework/scope.h"
 #include "paddle/fluid/platform/errors.h"
@@ -34,6 +36,9 @@ CostData::~CostData() {
   // here.
 }
 
+bool CostData::HasOpTime(int op_id) const {
+  return op_time_ms_.count(op_id) > 0;
+}
 double CostData::GetOpTimeMs(int op_id) const { return op_time_ms_.at(op_id); }
 double CostData::GetOpMemoryBytes(int op_id) const {
   return op_memory_bytes_.at(op_id);
@@ -203,6 +208,24 @@ std::string ToLowerCopy(const std::string& in) {
   return out;
 }
 
+std::string OpCostKey(const OpDesc& op_desc, const BlockDesc& block,
+                      const std::string& device) {
+  std::ostringstream os;
+  os << op_desc.Type() << "|";
+  for (const std::string& arg_name : op_desc.InputArgumentNames()) {
+    const VarDesc* var = block.FindVarRecursive(arg_name);
+    if (var == nullptr || var->GetType() != proto::VarType::LOD_TENSOR) {
+      continue;
+    }
+    for (int64_t dim : var->GetShape()) {
+      os << dim << "x";
+    }
+    os << DataTypeToString(var->GetDataType()) << ",";
+  }
+  os << "|" << ToLowerCopy(device);
+  return os.str();
+}
+
 CostData CostModel::ProfileMeasure(
     const ProgramDesc& main_program, const ProgramDesc& startup_program,
     const std::string& device,
@@ -249,8 +272,63 @@ CostData CostModel::ProfileMeasure(
   CostData cost_data;
   cost_data.SetCostData(main_program, *time_events);
 
+  // Accumulate the per-op measurements into the global cost database so
+  // they can be reused by IR passes and executors and persisted across
+  // processes via OpCostDatabase::Save/Load.
+  if (main_program.Size() > 0) {
+    const BlockDesc& global_block = main_program.Block(0);
+    for (size_t i = 0; i < global_block.OpSize(); ++i) {
+      int op_id = static_cast<int>(i);
+      if (!cost_data.HasOpTime(op_id)) {
+        continue;
+      }
+      OpCostDatabase::Instance().Record(
+          OpCostKey(*global_block.Op(i), global_block, device),
+          cost_data.GetOpTimeMs(op_id));
+    }
+  }
+
   return cost_data;
 }
 
+double CostModel::PredictProfile(const ProgramDesc& main_program,
+                                 const std::string& device) const {
+  if (main_program.Size() == 0) {
+    return 0;
+  }
+  const OpCostDatabase& db = OpCostDatabase::Instance();
+  // Support global block only
+  // TODO(zhhsplendid): support sub blocks
+  const BlockDesc& global_block = main_program.Block(0);
+  double predicted_time_ms = 0;
+  size_t num_predicted = 0;
+  size_t num_missing = 0;
+  for (size_t i = 0; i < global_block.OpSize(); ++i) {
+    const OpDesc* op_desc = global_block.Op(i);
+    double op_time_ms = db.Lookup(OpCostKey(*op_desc, global_block, device));
+    if (op_time_ms == OpCostDatabase::NOT_MEASURED) {
+      // The exact shapes were never measured; a mean over all measured
+      // shapes of the op type is still a usable replay estimate.
+      op_time_ms = db.LookupByOpType(op_desc->Type());
+    }
+    if (op_time_ms == OpCostDatabase::NOT_MEASURED) {
+      ++num_missing;
+      continue;
+    }
+    predicted_time_ms += op_time_ms;
+    ++num_predicted;
+  }
+  if (num_predicted == 0) {
+    return CostData::NOT_MEASURED;
+  }
+  if (num_missing > 0) {
+    LOG(WARNING) << "PredictProfile misses " << num_missing << " of "
+                 << global_block.OpSize()
+                 << " ops in the cost database, the prediction is a lower "
+                    "bound";
+  }
+  return predicted_time_ms;
+}
+
 }  // namespace framework
 }  // namespace paddle
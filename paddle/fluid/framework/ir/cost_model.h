@@ -24,6 +24,7 @@
 
 #include "paddle/fluid/framework/ir/graph.h"
 #include "paddle/fluid/framework/ir/node.h"
+#include "paddle/fluid/framework/ir/op_cost_database.h"
 #include "paddle/fluid/framework/program_desc.h"
 #include "paddle/fluid/platform/profiler.h"
 #include "paddle/fluid/platform/variant.h"
@@ -39,6 +40,7 @@ class CostData {
 
   // Support global block only
   // TODO(zhhsplendid): add support for sub-block
+  bool HasOpTime(int op_id) const;
   double GetOpTimeMs(int op_id) const;
   double GetOpMemoryBytes(int op_id) const;
   double GetWholeTimeMs() const;
@@ -70,15 +72,33 @@ class CostData {
       NOT_MEASURED};  // communication cost of the whole program or graph
 };
 
+// Build the OpCostDatabase key of one op: its type, the shapes and dtypes
+// of its LoDTensor inputs taken from the block var descs, and the device.
+// The op type is the key prefix up to the first '|', which OpCostDatabase
+// relies on for its per-op-type aggregate.
+std::string OpCostKey(const OpDesc& op_desc, const BlockDesc& block,
+                      const std::string& device);
+
 class CostModel {
  public:
   CostModel() {}
   ~CostModel() {}
 
+  // Besides returning the measured CostData, records every measured op into
+  // OpCostDatabase::Instance() so results accumulate across calls and, via
+  // OpCostDatabase::Save/Load, across processes.
   CostData ProfileMeasure(
       const ProgramDesc& main_program, const ProgramDesc& startup_program,
       const std::string& device,
       const std::vector<std::string>& fetch_cost_list) const;
+
+  // Replay the program against OpCostDatabase::Instance() without running
+  // it: sum the recorded latency of every op in the global block, falling
+  // back to the per-op-type mean when the exact shapes were never measured.
+  // Returns CostData::NOT_MEASURED when no op of the program is in the
+  // database.
+  double PredictProfile(const ProgramDesc& main_program,
+                        const std::string& device) const;
 };
 
 }  // namespace framework
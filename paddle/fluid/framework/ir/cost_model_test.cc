@@ -131,6 +131,28 @@ TEST(CostModelTest, TestProfileMeasure_Program) {
   EXPECT_GT(cost_data.GetWholeTimeMs(), op0_time_ms + op1_time_ms);
 }
 
+TEST(CostModelTest, TestProfileMeasure_FillsDatabase) {
+  OpCostDatabase::Instance().Clear();
+  CostModel cost_model;
+  ProgramDesc program = CreateTestProgram();
+  ProgramDesc empty_program;
+  cost_model.ProfileMeasure(program, empty_program, "cpu", {"time"});
+  EXPECT_GT(OpCostDatabase::Instance().Size(), 0u);
+  EXPECT_GT(OpCostDatabase::Instance().LookupByOpType("fake_test_op"), 0);
+
+  double predicted_time_ms = cost_model.PredictProfile(program, "cpu");
+  EXPECT_GT(predicted_time_ms, 0);
+  OpCostDatabase::Instance().Clear();
+}
+
+TEST(CostModelTest, TestPredictProfile_EmptyDatabase) {
+  OpCostDatabase::Instance().Clear();
+  CostModel cost_model;
+  ProgramDesc program = CreateTestProgram();
+  EXPECT_EQ(cost_model.PredictProfile(program, "cpu"),
+            CostData::NOT_MEASURED);
+}
+
 TEST(CostModelTest, TestProfileMeasure_UnsupportedDevice) {
   CostModel cost_model;
   ProgramDesc program = CreateTestProgram();
@@ -141,6 +163,40 @@ TEST(CostModelTest, TestProfileMeasure_UnsupportedDevice) {
                paddle::platform::EnforceNotMet);
 }
 
+TEST(OpCostDatabaseTest, TestRecordLookup) {
+  OpCostDatabase& db = OpCostDatabase::Instance();
+  db.Clear();
+  db.Record("fake_test_op|1000x784xfp32,|cpu", 2.0);
+  db.Record("fake_test_op|1000x784xfp32,|cpu", 4.0);
+  db.Record("fake_test_op|10x10xfp32,|cpu", 9.0);
+  EXPECT_EQ(db.Size(), 2u);
+  EXPECT_EQ(db.Lookup("fake_test_op|1000x784xfp32,|cpu"), 3.0);
+  EXPECT_EQ(db.Lookup("not_exist_op|1x1xfp32,|cpu"),
+            OpCostDatabase::NOT_MEASURED);
+  EXPECT_EQ(db.LookupByOpType("fake_test_op"), 5.0);
+  EXPECT_EQ(db.LookupByOpType("not_exist_op"), OpCostDatabase::NOT_MEASURED);
+  db.Clear();
+  EXPECT_EQ(db.Size(), 0u);
+}
+
+TEST(OpCostDatabaseTest, TestSaveLoad) {
+  OpCostDatabase& db = OpCostDatabase::Instance();
+  db.Clear();
+  db.Record("fake_test_op|1000x784xfp32,|cpu", 2.0);
+  db.Record("another_op|100x10xfp32,|cpu", 7.0);
+  std::string path = "op_cost_database_test.txt";
+  db.Save(path);
+  db.Clear();
+  EXPECT_TRUE(db.Load(path));
+  EXPECT_EQ(db.Size(), 2u);
+  EXPECT_EQ(db.Lookup("fake_test_op|1000x784xfp32,|cpu"), 2.0);
+  // Loading again merges by weighted mean, the means stay unchanged.
+  EXPECT_TRUE(db.Load(path));
+  EXPECT_EQ(db.Lookup("another_op|100x10xfp32,|cpu"), 7.0);
+  EXPECT_FALSE(db.Load("not_exist_op_cost_database.txt"));
+  db.Clear();
+}
+
 TEST(CostDataTest, TestGetGraphProgram) {
   CostData cost_data;
   EXPECT_EQ(cost_data.GetGraph(), nullptr);
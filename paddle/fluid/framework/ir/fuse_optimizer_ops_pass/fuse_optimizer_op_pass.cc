@@ -99,11 +99,13 @@ void FuseOptimizerOpPass::ApplyImpl(ir::Graph *graph) const {
         fused_var_set.count(fused_var_name), 0,
         platform::errors::AlreadyExists(
             "The fused variable(%s) already exists.", fused_var_name));
-    // FIXME(wangxi). update persistable
     details::VariableInfo var_info;
     var_info.name_ = fused_var_name;
     var_info.type_ = proto::VarType::LOD_TENSOR;
-    var_info.persistable_ = false;
+    // The fused parameter and moment buffers hold optimizer state that must
+    // survive scope dropping, so they are persistable; the fused gradient is
+    // rewritten every iteration and stays local.
+    var_info.persistable_ = var_name != kGrad;
     fused_var_set.insert({fused_var_name, var_info});
     fused_vars_name.emplace(var_name, fused_var_name);
   }
@@ -433,14 +435,28 @@ void FuseOptimizerOpPass::FuseVarsToContinuousSpace(
         &aux_var_map,
     const std::unordered_map<std::string, std::string> &fused_vars_name,
     const proto::VarType::Type &dtype, ir::Graph *result) const {
-  // Define Ops
-  result->Get<details::ProgramDescs>(details::kProgramDescs).emplace_back();
-  ProgramDesc &program_desc =
-      result->Get<details::ProgramDescs>(details::kProgramDescs).back();
-  auto *global_block = program_desc.MutableBlock(0);
+  auto vars_info = GetVarInfo(*result);
   for (auto &var_name : aux_var_names) {
+    bool all_persistable = true;
+    for (auto &name : aux_var_map.at(var_name)) {
+      if (!GetVarDescFromVarsInfo(vars_info, name)->Persistable()) {
+        all_persistable = false;
+        break;
+      }
+    }
+    // Parameters and moments are persistable optimizer state, so their
+    // fused buffer only needs to be coalesced once at startup; afterwards
+    // the fused optimizer op updates it in place. Non-persistable vars are
+    // erased by DropScope() and have to be coalesced again after it.
+    auto &program_descs =
+        all_persistable
+            ? result->Get<details::ProgramDescs>(details::kStartupProgramDescs)
+            : result->Get<details::ProgramDescs>(details::kProgramDescs);
+    program_descs.emplace_back();
+    auto *global_block = program_descs.back().MutableBlock(0);
     VLOG(6) << "aux_var_names : " << var_name
-            << ". fused_vars_name: " << fused_vars_name.at(var_name);
+            << ". fused_vars_name: " << fused_vars_name.at(var_name)
+            << ". coalesce at startup: " << all_persistable;
     AppendCoalesceTensorOp(aux_var_map.at(var_name), aux_var_map.at(var_name),
                            fused_vars_name.at(var_name), dtype, global_block,
                            true);
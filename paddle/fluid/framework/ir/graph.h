@@ -48,6 +48,12 @@ constexpr char kStaleProgramOpDescs[] = "stale_program_op_descs";
 
 namespace ir {
 
+// The cached node index built by the GraphPatternDetector (see
+// graph_pattern_detector.h). Pass::Apply erases it after every pass, because
+// a pass may rewrite op descs in place without touching the node set.
+constexpr char kGraphPatternDetectorNodeIndex[] =
+    "graph_pattern_detector_node_index";
+
 /*
  * The graph is a Directed Acyclic Single Static Assignment Graph.
  *
@@ -217,6 +223,18 @@ class Graph {
     return node_set_;
   }
 
+  // Monotonic counter bumped every time a node is added to or removed from
+  // the graph. Caches keyed on the node set (e.g. the pattern detector node
+  // index) compare it to decide whether they are still valid.
+  size_t ModifyGeneration() const {
+    if (FLAGS_convert_all_blocks) {
+      if (IsMainGraph()) {
+        return GetSubGraph(0)->ModifyGeneration();
+      }
+    }
+    return modify_generation_;
+  }
+
   // Create a normal variable with non-null VarDesc.
   ir::Node *CreateVarNode(VarDesc *var_desc, int block_id = -1) {
     if (FLAGS_convert_all_blocks) {
@@ -293,6 +311,7 @@ class Graph {
     }
     nodes_.clear();
     node_set_.clear();
+    ++modify_generation_;
     return ret;
   }
 
@@ -309,6 +328,7 @@ class Graph {
     ret.reset(nodes_.at(node).release());
     nodes_.erase(node);
     node_set_.erase(node);
+    ++modify_generation_;
     return ret;
   }
 
@@ -352,6 +372,7 @@ class Graph {
                           "The node to be added already exists."));
     nodes_[node].reset(node);
     node_set_.insert(node);
+    ++modify_generation_;
     return node;
   }
 
@@ -432,6 +453,7 @@ class Graph {
   std::map<ir::Node *, std::unique_ptr<ir::Node>> nodes_;
   std::unordered_set<ir::Node *> node_set_;
   size_t num_node_created_{0};  // help to generate a unique node id.
+  size_t modify_generation_{0};  // bumped on node add/remove.
   // NOTE(Aurelius84): Whether is constructed with partial ProgramDesc.
   // In case of @to_static, whole trainning program is splited into two
   // parts: forward graph and backward graph, which can be executed
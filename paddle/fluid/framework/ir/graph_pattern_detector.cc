@@ -77,7 +77,7 @@ void PDPattern::AddEdge(PDNode *a, PDNode *b) {
 
 void GraphPatternDetector::operator()(Graph *graph,
                                       GraphPatternDetector::handle_t handler) {
-  if (!MarkPDNodesInGraph(*graph)) {
+  if (!MarkPDNodesInGraph(graph)) {
     return;
   }
 
@@ -96,15 +96,68 @@ void GraphPatternDetector::operator()(Graph *graph,
   }
 }
 
-bool GraphPatternDetector::MarkPDNodesInGraph(const ir::Graph &graph) {
-  VLOG(3) << "mark pdnodes in graph";
-  if (graph.Nodes().empty()) return false;
+void GraphPatternDetector::BuildNodeIndex(ir::Graph *graph) {
+  auto &index =
+      graph->GetOrInit<GraphNodeIndex>(kGraphPatternDetectorNodeIndex);
+  const size_t generation = graph->ModifyGeneration();
+  if (index.generation == generation) {
+    VLOG(4) << "reuse the cached node index of generation " << generation;
+    node_index_ = &index;
+    return;
+  }
+  index.nodes.clear();
+  index.optype2nodes.clear();
+  for (auto &node : GraphTraits::DFS(*graph)) {
+    index.nodes.push_back(&node);
+    if (node.IsOp() && node.Op()) {
+      index.optype2nodes[node.Op()->Type()].push_back(&node);
+    }
+  }
+  index.generation = generation;
+  node_index_ = &index;
+}
+
+std::vector<Node *> GraphPatternDetector::CandidateNodes(
+    const PDNode *pdnode) const {
+  std::vector<Node *> candidates;
+  if (pdnode->has_op_type_hints()) {
+    for (const auto &op_type : pdnode->op_type_hints()) {
+      auto it = node_index_->optype2nodes.find(op_type);
+      if (it == node_index_->optype2nodes.end()) continue;
+      candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+    }
+    return candidates;
+  }
+  if (pdnode->has_neighbor_op_hint()) {
+    // The variable must link to an op with one of the hinted types, so only
+    // the in/out variables of those ops can match. A variable linked to
+    // several such ops appears several times, which is harmless since the
+    // matched nodes are collected in a set.
+    for (const auto &op_type : pdnode->neighbor_op_types()) {
+      auto it = node_index_->optype2nodes.find(op_type);
+      if (it == node_index_->optype2nodes.end()) continue;
+      for (Node *op : it->second) {
+        auto &vars =
+            pdnode->neighbor_hint_is_input() ? op->inputs : op->outputs;
+        candidates.insert(candidates.end(), vars.begin(), vars.end());
+      }
+    }
+    return candidates;
+  }
+  // No hints recorded (e.g. a raw teller), fall back to the whole graph.
+  return node_index_->nodes;
+}
 
-  for (auto &node : GraphTraits::DFS(graph)) {
-    for (const auto &pdnode : pattern_.nodes()) {
-      if (pdnode->Tell(&node)) {
-        VLOG(4) << "Node " << node.Name() << " marked as " << pdnode->name();
-        pdnodes2nodes_[pdnode.get()].insert(&node);
+bool GraphPatternDetector::MarkPDNodesInGraph(ir::Graph *graph) {
+  VLOG(3) << "mark pdnodes in graph";
+  if (graph->Nodes().empty()) return false;
+
+  BuildNodeIndex(graph);
+  for (const auto &pdnode : pattern_.nodes()) {
+    for (Node *node : CandidateNodes(pdnode.get())) {
+      if (pdnode->Tell(node)) {
+        VLOG(4) << "Node " << node->Name() << " marked as " << pdnode->name();
+        pdnodes2nodes_[pdnode.get()].insert(node);
       }
     }
   }
@@ -396,12 +449,41 @@ PDNode &PDNode::LinksFrom(const std::vector<PDNode *> &others) {
   return *this;
 }
 
+void PDNode::RecordOpTypeHints(
+    const std::unordered_set<std::string> &op_types) {
+  // A raw teller bypasses the asserts in Tell, so the hint would not be a
+  // superset of what the node matches.
+  if (teller_) return;
+  if (!has_op_type_hints_) {
+    has_op_type_hints_ = true;
+    op_type_hints_ = op_types;
+    return;
+  }
+  for (auto it = op_type_hints_.begin(); it != op_type_hints_.end();) {
+    if (op_types.count(*it) == 0) {
+      it = op_type_hints_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void PDNode::RecordNeighborOpHint(
+    const std::unordered_set<std::string> &op_types, bool as_input) {
+  if (teller_) return;
+  if (has_neighbor_op_hint_) return;
+  has_neighbor_op_hint_ = true;
+  neighbor_op_types_ = op_types;
+  neighbor_hint_is_input_ = as_input;
+}
+
 PDNode *PDNode::assert_is_op() {
   asserts_.emplace_back([](Node *x) { return x && x->IsOp(); });
   return this;
 }
 
 PDNode *PDNode::assert_is_op(const std::string &op_type) {
+  RecordOpTypeHints({op_type});
   asserts_.emplace_back([op_type](Node *x) {
     return x && x->IsOp() && x->Op()->Type() == op_type;
   });
@@ -455,6 +537,7 @@ PDNode *PDNode::assert_is_op_nth_input(const std::string &op_type,
 PDNode *PDNode::assert_is_op_nth_output(const std::string &op_type,
                                         const std::string &argument, int nth) {
   assert_is_var();
+  RecordNeighborOpHint({op_type}, false /*as_input*/);
   asserts_.emplace_back([=](Node *x) {
     for (auto *op : x->inputs) {
       if (op->IsOp() && op->Op()->Type() == op_type &&
@@ -468,6 +551,7 @@ PDNode *PDNode::assert_is_op_nth_output(const std::string &op_type,
 
 PDNode *PDNode::assert_is_only_input_of_op(const std::string &op_type) {
   assert_is_var();
+  RecordNeighborOpHint({op_type}, true /*as_input*/);
   asserts_.emplace_back([=](Node *x) {
     for (auto *op : x->outputs) {
       if (op && op->IsOp() && op->Op() && op->Op()->Type() == op_type &&
@@ -482,6 +566,7 @@ PDNode *PDNode::assert_is_only_input_of_op(const std::string &op_type) {
 
 PDNode *PDNode::assert_is_only_output_of_op(const std::string &op_type) {
   assert_is_var();
+  RecordNeighborOpHint({op_type}, false /*as_input*/);
   asserts_.emplace_back([=](Node *x) {
     for (auto *op : x->inputs) {
       if (op && op->IsOp() && op->Op() && op->Op()->Type() == op_type &&
@@ -496,6 +581,7 @@ PDNode *PDNode::assert_is_only_output_of_op(const std::string &op_type) {
 
 PDNode *PDNode::assert_is_op_output(const std::string &op_type) {
   assert_is_var();
+  RecordNeighborOpHint({op_type}, false /*as_input*/);
   asserts_.emplace_back([=](Node *x) {
     for (auto *op : x->inputs) {
       if (op && op->IsOp() && op->Op() && op->Op()->Type() == op_type) {
@@ -516,6 +602,7 @@ PDNode *PDNode::assert_is_op_output(const std::string &op_type,
 
 PDNode *PDNode::assert_is_op_input(const std::string &op_type) {
   assert_is_var();
+  RecordNeighborOpHint({op_type}, true /*as_input*/);
   asserts_.emplace_back([=](Node *x) {
     for (auto *op : x->outputs) {
       if (op && op->IsOp() && op->Op() && op->Op()->Type() == op_type) {
@@ -572,6 +659,7 @@ PDNode *PDNode::assert_more(PDNode::teller_t &&teller) {
 }
 
 PDNode *PDNode::assert_is_ops(const std::unordered_set<std::string> &op_types) {
+  RecordOpTypeHints(op_types);
   asserts_.emplace_back([op_types](Node *x) {
     return x && x->IsOp() && op_types.count(x->Op()->Type());
   });
@@ -598,6 +686,7 @@ PDNode *PDNode::assert_is_ops_nth_output(
     const std::unordered_set<std::string> &op_types,
     const std::string &argument, int nth) {
   assert_is_var();
+  RecordNeighborOpHint(op_types, false /*as_input*/);
   asserts_.emplace_back([=](Node *x) {
     for (auto *op : x->inputs) {
       if (op->IsOp() && op_types.count(op->Op()->Type()) &&
@@ -611,6 +700,7 @@ PDNode *PDNode::assert_is_ops_nth_output(
 PDNode *PDNode::assert_is_ops_output(
     const std::unordered_set<std::string> &op_types) {
   assert_is_var();
+  RecordNeighborOpHint(op_types, false /*as_input*/);
   asserts_.emplace_back([=](Node *x) {
     for (auto *op : x->inputs) {
       if (op && op->IsOp() && op->Op() && op_types.count(op->Op()->Type())) {
@@ -633,6 +723,7 @@ PDNode *PDNode::assert_is_ops_output(
 PDNode *PDNode::assert_is_ops_input(
     const std::unordered_set<std::string> &op_types) {
   assert_is_var();
+  RecordNeighborOpHint(op_types, true /*as_input*/);
   asserts_.emplace_back([=](Node *x) {
     for (auto *op : x->outputs) {
       if (op && op->IsOp() && op->Op() && op_types.count(op->Op()->Type())) {
@@ -655,6 +746,7 @@ PDNode *PDNode::assert_is_ops_input(
 PDNode *PDNode::assert_is_only_input_of_ops(
     const std::unordered_set<std::string> &op_types) {
   assert_is_var();
+  RecordNeighborOpHint(op_types, true /*as_input*/);
   asserts_.emplace_back([=](Node *x) {
     for (auto *op : x->outputs) {
       if (op && op->IsOp() && op->Op() && op_types.count(op->Op()->Type()) &&
@@ -670,6 +762,7 @@ PDNode *PDNode::assert_is_only_input_of_ops(
 PDNode *PDNode::assert_is_only_output_of_ops(
     const std::unordered_set<std::string> &op_types) {
   assert_is_var();
+  RecordNeighborOpHint(op_types, false /*as_input*/);
   asserts_.emplace_back([=](Node *x) {
     for (auto *op : x->inputs) {
       if (op && op->IsOp() && op->Op() && op_types.count(op->Op()->Type()) &&
@@ -2289,6 +2382,7 @@ PDNode *patterns::Bfloat16Placement::operator()(
                                        "conv2d_transpose",
                                        "elementwise_add",
                                        "elementwise_mul",
+                                       "elementwise_sub",
                                        "expand_v2",
                                        "fc",
                                        "fusion_gru",
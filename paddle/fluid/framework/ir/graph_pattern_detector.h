@@ -106,6 +106,21 @@ struct PDNode {
   bool IsInput() const { return role_ == Role::kInput; }
   bool IsOutput() const { return role_ == Role::kOutput; }
 
+  // Candidate hints collected from the type asserts below. They describe a
+  // superset of the graph nodes this PDNode can match, so that
+  // GraphPatternDetector only has to test the candidate nodes instead of
+  // scanning the whole graph for every PDNode. A PDNode built with a raw
+  // teller records no hints, because Tell() bypasses the asserts then.
+  bool has_op_type_hints() const { return has_op_type_hints_; }
+  const std::unordered_set<std::string>& op_type_hints() const {
+    return op_type_hints_;
+  }
+  bool has_neighbor_op_hint() const { return has_neighbor_op_hint_; }
+  const std::unordered_set<std::string>& neighbor_op_types() const {
+    return neighbor_op_types_;
+  }
+  bool neighbor_hint_is_input() const { return neighbor_hint_is_input_; }
+
   // Assertions, helper functions to simplify the pattern definition.
   PDNode* assert_is_op();
   PDNode* assert_is_op(const std::string& op_type);
@@ -179,6 +194,15 @@ struct PDNode {
 
   PDNode(PDNode&& other) = default;
 
+  // Narrow the op types this node can match. Repeated calls intersect, an
+  // assert with another op type can never match.
+  void RecordOpTypeHints(const std::unordered_set<std::string>& op_types);
+  // Record that this variable node must be an input (as_input) or an output
+  // of an op with one of the given types. Only the first hint is kept; any
+  // single hint already yields a valid candidate superset.
+  void RecordNeighborOpHint(const std::unordered_set<std::string>& op_types,
+                            bool as_input);
+
   friend class PDPattern;
 
   // Will removed latter.
@@ -188,6 +212,12 @@ struct PDNode {
   std::string name_;
   Type type_;
   Role role_{Role::kUnknown};
+
+  std::unordered_set<std::string> op_type_hints_;
+  bool has_op_type_hints_{false};
+  std::unordered_set<std::string> neighbor_op_types_;
+  bool has_neighbor_op_hint_{false};
+  bool neighbor_hint_is_input_{false};
 };
 
 /*
@@ -275,6 +305,17 @@ class PDPattern {
  *    // Execute the detector.
  *    detector(&graph, handler);
  */
+// Node index of a graph, stored on the graph itself as the
+// kGraphPatternDetectorNodeIndex attribute so that the detectors a pass runs
+// back to back share one traversal. `generation` records the graph
+// modification generation the index was built at; a mismatch means nodes
+// were added or removed since then and the index has to be rebuilt.
+struct GraphNodeIndex {
+  size_t generation{static_cast<size_t>(-1)};
+  std::vector<Node*> nodes;
+  std::unordered_map<std::string, std::vector<Node*>> optype2nodes;
+};
+
 class GraphPatternDetector {
  public:
   using subgraph_t = std::map<PDNode*, Node*>;
@@ -290,7 +331,7 @@ class GraphPatternDetector {
 
  private:
   // Mark the nodes that fits the pattern.
-  bool MarkPDNodesInGraph(const ir::Graph& graph);
+  bool MarkPDNodesInGraph(ir::Graph* graph);
 
   // Detect all the pattern and output the hit records.
   std::vector<subgraph_t> DetectPatterns();
@@ -312,6 +353,14 @@ class GraphPatternDetector {
   // Validate whether the intermediate nodes are linked by external nodes.
   void ValidateByNodeRole(std::vector<subgraph_t>* subgraphs);
 
+  // Make node_index_ point at the node index cached on the graph, rebuilding
+  // it first when the graph changed since the index was built.
+  void BuildNodeIndex(ir::Graph* graph);
+
+  // Collect the graph nodes a PDNode has to be tested against, based on the
+  // candidate hints of the PDNode and the node index.
+  std::vector<Node*> CandidateNodes(const PDNode* pdnode) const;
+
 #ifdef PADDLE_WITH_TESTING
   FRIEND_TEST(GraphPatternDetecter, MarkPDNodesInGraph);
   FRIEND_TEST(GraphPatternDetecter, DetectPatterns);
@@ -322,6 +371,9 @@ class GraphPatternDetector {
       std::pair<Node* /*node in graph*/, PDNode* /*node in pattern*/>;
   PDPattern pattern_;
   std::map<const PDNode*, std::set<Node*>> pdnodes2nodes_;
+  // Node index of the graph being matched; points into the cache stored on
+  // the graph (see GraphNodeIndex), valid for the duration of one run.
+  const GraphNodeIndex* node_index_{nullptr};
 };
 
 // some helper methods.
@@ -120,7 +120,7 @@ TEST(GraphPatternDetecter, MarkPDNodesInGraph) {
   Graph graph(program);
   BuildGraph(&graph);
 
-  x.MarkPDNodesInGraph(graph);
+  x.MarkPDNodesInGraph(&graph);
 
   ASSERT_EQ(x.pdnodes2nodes_.size(), 3UL);
 
@@ -104,6 +104,46 @@ MapMatmulv2ToMulPass::MapMatmulv2ToMulPass() {
       .End();
 }
 
+MapMatmulV2ToMatmulPass::MapMatmulV2ToMatmulPass() {
+  AddOpCompat(OpCompat("matmul_v2"))
+      .AddInput("X")
+      .IsTensor()
+      .End()
+      .AddInput("Y")
+      .IsTensor()
+      .End()
+      .AddOutput("Out")
+      .IsTensor()
+      .End()
+      .AddAttr("trans_x")
+      .IsType<bool>()
+      .End()
+      .AddAttr("trans_y")
+      .IsType<bool>()
+      .End();
+
+  AddOpCompat(OpCompat("matmul"))
+      .AddInput("X")
+      .IsTensor()
+      .End()
+      .AddInput("Y")
+      .IsTensor()
+      .End()
+      .AddOutput("Out")
+      .IsTensor()
+      .End()
+      .AddAttr("alpha")
+      .IsNumGE(0.99f)
+      .IsNumLE(1.01f)
+      .End()
+      .AddAttr("transpose_X")
+      .IsType<bool>()
+      .End()
+      .AddAttr("transpose_Y")
+      .IsType<bool>()
+      .End();
+}
+
 Flatten2MatmulFusePass::Flatten2MatmulFusePass() {
   AddOpCompat(OpCompat("matmul"))
       .AddInput("X")
@@ -356,6 +396,76 @@ void MapMatmulv2ToMulPass::ApplyImpl(ir::Graph* graph) const {
   AddStatis(found_count);
 }
 
+void MapMatmulV2ToMatmulPass::ApplyImpl(ir::Graph* graph) const {
+  PADDLE_ENFORCE_NOT_NULL(
+      graph, platform::errors::InvalidArgument("Graph cannot be nullptr."));
+  std::string name_scope = "map_matmul_v2_to_matmul_pass";
+  FusePassBase::Init(name_scope, graph);
+
+  GraphPatternDetector gpd;
+  patterns::MatmulV2 matmul_pattern(gpd.mutable_pattern(), name_scope);
+  matmul_pattern();
+
+  int found_count = 0;
+  auto handler = [&](const GraphPatternDetector::subgraph_t& subgraph,
+                     Graph* g) {
+    VLOG(4) << "map matmul_v2 to matmul";
+    GET_IR_NODE_FROM_SUBGRAPH(matmul_in_x, matmul_in_x, matmul_pattern);
+    GET_IR_NODE_FROM_SUBGRAPH(matmul_in_y, matmul_in_y, matmul_pattern);
+    GET_IR_NODE_FROM_SUBGRAPH(matmul_op, matmul_op, matmul_pattern);
+    GET_IR_NODE_FROM_SUBGRAPH(matmul_out, matmul_out, matmul_pattern);
+
+    std::vector<int64_t> x_shape = matmul_in_x->Var()->GetShape();
+    std::vector<int64_t> y_shape = matmul_in_y->Var()->GetShape();
+    size_t x_rank = x_shape.size();
+    size_t y_rank = y_shape.size();
+    if (x_rank != y_rank || x_rank < 2 || x_rank > 4) return;
+    // matmul does not broadcast the batch dimensions, so they must match
+    // exactly; -1 (dynamic batch) on both sides is accepted
+    for (size_t i = 0; i < x_rank - 2; ++i) {
+      if (x_shape[i] != y_shape[i]) return;
+    }
+
+    if (!IsCompat(subgraph, g)) {
+      LOG(WARNING) << "Pass in op compat failed.";
+      return;
+    }
+    OpDesc desc(matmul_op->Op()->Block());
+    desc.SetType("matmul");
+    desc.SetInput("X", {matmul_in_x->Name()});
+    desc.SetInput("Y", {matmul_in_y->Name()});
+    desc.SetOutput("Out", {matmul_out->Name()});
+    desc.SetAttr("transpose_X", matmul_op->Op()->GetAttr("trans_x"));
+    desc.SetAttr("transpose_Y", matmul_op->Op()->GetAttr("trans_y"));
+    desc.SetAttr("alpha", 1.0f);
+    // mkldnn_placement_pass has already run, carry its decisions over
+    for (const auto& attr :
+         {std::string("use_mkldnn"), std::string("mkldnn_data_type")}) {
+      if (matmul_op->Op()->HasAttr(attr)) {
+        desc.SetAttr(attr, matmul_op->Op()->GetAttr(attr));
+      }
+    }
+    if (matmul_op->Op()->HasAttr("enable_int8")) {
+      desc.SetAttr("enable_int8", matmul_op->Op()->GetAttr("enable_int8"));
+      desc.SetAttr("X_scale", matmul_op->Op()->GetAttr("X_scale"));
+      desc.SetAttr("weight_scale", matmul_op->Op()->GetAttr("weight_scale"));
+    }
+    if (!IsCompat(desc)) {
+      LOG(WARNING) << "MapMatmulV2ToMatmulPass in out matmul op compat failed.";
+      return;
+    }
+    auto matmul_node = g->CreateOpNode(&desc);
+    IR_NODE_LINK_TO(matmul_in_x, matmul_node);
+    IR_NODE_LINK_TO(matmul_in_y, matmul_node);
+    IR_NODE_LINK_TO(matmul_node, matmul_out);
+    GraphSafeRemoveNodes(graph, {matmul_op});
+    ++found_count;
+  };
+
+  gpd(graph, handler);
+  AddStatis(found_count);
+}
+
 void Squeeze2MatmulFusePass::ApplyImpl(ir::Graph* graph) const {
   PADDLE_ENFORCE_NOT_NULL(
       graph, platform::errors::InvalidArgument("Graph cannot be nullptr."));
@@ -681,6 +791,14 @@ REGISTER_PASS_CAPABILITY(map_matmul_v2_to_mul_pass)
             .EQ("matmul_v2", 0)
             .EQ("mul", 0));
 
+REGISTER_PASS(map_matmul_v2_to_matmul_pass,
+              paddle::framework::ir::MapMatmulV2ToMatmulPass);
+REGISTER_PASS_CAPABILITY(map_matmul_v2_to_matmul_pass)
+    .AddCombination(
+        paddle::framework::compatible::OpVersionComparatorCombination()
+            .EQ("matmul_v2", 0)
+            .LE("matmul", 1));
+
 REGISTER_PASS(squeeze2_matmul_fuse_pass,
               paddle::framework::ir::Squeeze2MatmulFusePass);
 REGISTER_PASS_CAPABILITY(squeeze2_matmul_fuse_pass)
@@ -58,6 +58,27 @@ class MapMatmulv2ToMulPass : public FusePassBase {
   void ApplyImpl(Graph* graph) const override;
 };
 
+/*
+ * Map matmul_v2 to matmul, so attention-style
+ * reshape2+transpose2+matmul_v2+transpose2+reshape2 chains can be folded
+ * by the oneDNN matmul fuse passes, which only understand matmul.
+ * The matmul_v2 op must satisfy the following conditions:
+ * 1. the rank of input X and Y is the same and in [2, 4]
+ * 2. the batch dims of X and Y are equal (matmul has no broadcasting)
+ *
+ * Notice:
+ *  the rank of input activation is obtained from var_desc,
+ *  it maybe change in runtime.
+ */
+class MapMatmulV2ToMatmulPass : public FusePassBase {
+ public:
+  MapMatmulV2ToMatmulPass();
+  virtual ~MapMatmulV2ToMatmulPass() {}
+
+ protected:
+  void ApplyImpl(Graph* graph) const override;
+};
+
 /*
  * Fuse squeeze2+matmul to mul, so the optimization can use fc_fuse_pass.
  * The squeeze2 op must satisfy the following conditions:
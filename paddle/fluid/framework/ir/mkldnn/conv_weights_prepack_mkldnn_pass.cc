@@ -0,0 +1,238 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/ir/mkldnn/conv_weights_prepack_mkldnn_pass.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "paddle/fluid/framework/lod_tensor.h"
+#include "paddle/fluid/platform/device_context.h"
+#include "paddle/fluid/platform/enforce.h"
+#include "paddle/fluid/platform/mkldnn_helper.h"
+
+namespace paddle {
+namespace framework {
+namespace ir {
+
+namespace {
+
+// Mirrors operators::UpdatePaddingAndDilation for the EXPLICIT/SAME/VALID
+// padding algorithms, so that framework/ir does not have to include operator
+// headers.
+void UpdatePaddingAndDilation(std::vector<int64_t>* paddings,
+                              std::vector<int64_t>* dilations,
+                              const std::string& padding_algorithm,
+                              const std::vector<int64_t>& data_dims,
+                              const std::vector<int64_t>& strides,
+                              const std::vector<int64_t>& ksize) {
+  if (paddings->size() == data_dims.size()) {
+    for (size_t i = 0; i < data_dims.size(); ++i) {
+      int64_t copy_pad = *(paddings->begin() + 2 * i);
+      paddings->insert(paddings->begin() + 2 * i + 1, copy_pad);
+    }
+  }
+
+  if (padding_algorithm == "SAME") {
+    for (size_t i = 0; i < data_dims.size(); ++i) {
+      int64_t out_size = (data_dims[i] + strides[i] - 1) / strides[i];
+      int64_t pad_sum = std::max(
+          (out_size - 1) * strides[i] + ksize[i] - data_dims[i], int64_t(0));
+      int64_t pad_0 = pad_sum / 2;
+      int64_t pad_1 = pad_sum - pad_0;
+      *(paddings->begin() + i * 2) = pad_0;
+      *(paddings->begin() + i * 2 + 1) = pad_1;
+      *(dilations->begin() + i) = 1;
+    }
+  } else if (padding_algorithm == "VALID") {
+    std::fill(paddings->begin(), paddings->end(), int64_t(0));
+  }
+}
+
+Node* FindVarNode(const std::vector<Node*>& vars, const std::string& name) {
+  for (auto* var : vars) {
+    if (var->IsVar() && var->Name() == name) return var;
+  }
+  return nullptr;
+}
+
+// Returns the statically known shape of a variable with the batch dimension
+// substituted by 1, or an empty vector if any non-batch dimension is unknown.
+std::vector<int64_t> GetStaticShape(const Node* var) {
+  auto shape = var->Var()->GetShape();
+  if (!shape.empty() && shape[0] < 0) shape[0] = 1;
+  for (auto dim : shape) {
+    if (dim <= 0) return {};
+  }
+  return shape;
+}
+
+}  // namespace
+
+void ConvWeightsPrepackPass::ApplyImpl(ir::Graph* graph) const {
+  PADDLE_ENFORCE_NOT_NULL(graph,
+                          platform::errors::InvalidArgument(
+                              "Pointer to graph argument should not be NULL."));
+  Init(name_scope_, graph);
+  auto* scope = param_scope();
+  PADDLE_ENFORCE_NOT_NULL(
+      scope, platform::errors::InvalidArgument("Scope cannot be nullptr."));
+
+  platform::DeviceContextPool& pool = platform::DeviceContextPool::Instance();
+  auto* dev_ctx = static_cast<platform::MKLDNNDeviceContext*>(
+      pool.Get(platform::CPUPlace()));
+  const auto& engine = dev_ctx->GetEngine();
+
+  int found_count = 0;
+  for (const Node* node : graph->Nodes()) {
+    if (!node->IsOp() || node->Op()->Type() != "conv2d") continue;
+    auto* op = node->Op();
+
+    if (!(op->HasAttr("use_mkldnn") &&
+          BOOST_GET_CONST(bool, op->GetAttr("use_mkldnn")))) {
+      continue;
+    }
+    // The int8 and bfloat16 flows reorder weights themselves with their own
+    // scales and data types, so only plain fp32 convolutions are prepacked.
+    if (op->HasAttr("mkldnn_data_type") &&
+        BOOST_GET_CONST(std::string, op->GetAttr("mkldnn_data_type")) !=
+            "float32") {
+      continue;
+    }
+    if (op->HasAttr("use_quantizer") &&
+        BOOST_GET_CONST(bool, op->GetAttr("use_quantizer"))) {
+      continue;
+    }
+    // For grouped convolutions the kernel rebuilds the weights descriptor
+    // from a hard-coded goihw tag instead of the tensor format, so it could
+    // not consume pre-blocked data; leave them to the lazy reorder.
+    const int groups = BOOST_GET_CONST(int, op->GetAttr("groups"));
+    if (groups != 1) continue;
+
+    auto* input_var = FindVarNode(node->inputs, op->Input("Input")[0]);
+    auto* filter_var_node = FindVarNode(node->inputs, op->Input("Filter")[0]);
+    auto* output_var = FindVarNode(node->outputs, op->Output("Output")[0]);
+    if (input_var == nullptr || filter_var_node == nullptr ||
+        output_var == nullptr || !filter_var_node->Var()->Persistable()) {
+      continue;
+    }
+
+    const auto src_tz = GetStaticShape(input_var);
+    const auto dst_tz = GetStaticShape(output_var);
+    if (src_tz.size() != 4 || dst_tz.size() != 4) continue;
+
+    auto* filter_var = scope->FindVar(filter_var_node->Name());
+    if (filter_var == nullptr) continue;
+    auto* filter = filter_var->GetMutable<LoDTensor>();
+    if (!filter->IsInitialized() ||
+        filter->type() != framework::proto::VarType::FP32 ||
+        filter->dims().size() != 4 ||
+        filter->layout() == DataLayout::kMKLDNN) {
+      continue;
+    }
+    const auto weights_tz = framework::vectorize(filter->dims());
+
+    auto strides_temp =
+        BOOST_GET_CONST(std::vector<int>, op->GetAttr("strides"));
+    std::vector<int64_t> strides(begin(strides_temp), end(strides_temp));
+    auto paddings_temp =
+        BOOST_GET_CONST(std::vector<int>, op->GetAttr("paddings"));
+    std::vector<int64_t> paddings(begin(paddings_temp), end(paddings_temp));
+    auto dilations_temp =
+        BOOST_GET_CONST(std::vector<int>, op->GetAttr("dilations"));
+    std::vector<int64_t> dilations(begin(dilations_temp), end(dilations_temp));
+    const std::string padding_algorithm =
+        op->HasAttr("padding_algorithm")
+            ? BOOST_GET_CONST(std::string, op->GetAttr("padding_algorithm"))
+            : "EXPLICIT";
+
+    const std::vector<int64_t> data_dims(src_tz.begin() + 2, src_tz.end());
+    const std::vector<int64_t> ksize(weights_tz.begin() + 2, weights_tz.end());
+    UpdatePaddingAndDilation(&paddings, &dilations, padding_algorithm,
+                             data_dims, strides, ksize);
+    std::transform(dilations.begin(), dilations.end(), dilations.begin(),
+                   [](int64_t i) { return i - 1; });
+
+    const auto data_type = mkldnn::memory::data_type::f32;
+    const auto src_md =
+        platform::MKLDNNMemDesc(src_tz, data_type, MKLDNNMemoryFormat::any);
+    const auto weights_md =
+        platform::MKLDNNMemDesc(weights_tz, data_type, MKLDNNMemoryFormat::any);
+    const auto dst_md =
+        platform::MKLDNNMemDesc(dst_tz, data_type, MKLDNNMemoryFormat::any);
+    const mkldnn::memory::dims stride_dims = strides;
+    const mkldnn::memory::dims dilations_dims = dilations;
+    const auto mkldnn_paddings = platform::ToMkldnnPadding(paddings);
+
+    // Post-ops (fused activations, residual sum) do not influence the weights
+    // layout chosen by the primitive descriptor, so they are not replicated
+    // here; neither is the bias, whose descriptor is always plain.
+    mkldnn::memory::desc target_md;
+    MKLDNNMemoryFormat target_format;
+    try {
+      const auto conv_desc = mkldnn::convolution_forward::desc(
+          mkldnn::prop_kind::forward_inference,
+          mkldnn::algorithm::convolution_direct, src_md, weights_md, dst_md,
+          stride_dims, dilations_dims, mkldnn_paddings[0], mkldnn_paddings[1]);
+      const auto conv_pd =
+          mkldnn::convolution_forward::primitive_desc(conv_desc, engine);
+
+      target_format = platform::GetMKLDNNFormat(conv_pd.weights_desc());
+      if (target_format == MKLDNNMemoryFormat::undef ||
+          target_format == MKLDNNMemoryFormat::oihw) {
+        continue;
+      }
+      // The kernel will rebuild the descriptor from the tag stored in the
+      // tensor, so only layouts that round-trip through a format tag can be
+      // prepacked.
+      target_md = platform::MKLDNNMemDesc(weights_tz, data_type, target_format);
+      if (target_md != conv_pd.weights_desc()) continue;
+    } catch (const mkldnn::error& e) {
+      VLOG(3) << "Skipping weights prepack of " << filter_var_node->Name()
+              << ": " << e.message;
+      continue;
+    }
+
+    LoDTensor prepacked;
+    prepacked.Resize(filter->dims());
+    auto* prepacked_data = prepacked.mutable_data<float>(
+        platform::CPUPlace(), target_md.get_size());
+
+    const auto user_md = platform::MKLDNNMemDesc(weights_tz, data_type,
+                                                 MKLDNNMemoryFormat::oihw);
+    mkldnn::memory user_mem(
+        user_md, engine, platform::to_void_cast<float>(filter->data<float>()));
+    mkldnn::memory target_mem(target_md, engine, prepacked_data);
+    platform::Reorder(user_mem, target_mem, engine);
+
+    filter->ShareDataWith(prepacked);
+    filter->set_layout(DataLayout::kMKLDNN);
+    filter->set_format(target_format);
+
+    VLOG(4) << "Prepacked weights " << filter_var_node->Name() << " of "
+            << op->Type() << " into format "
+            << static_cast<int>(target_format);
+    ++found_count;
+  }
+
+  AddStatis(found_count);
+}
+
+}  // namespace ir
+}  // namespace framework
+}  // namespace paddle
+
+REGISTER_PASS(conv_weights_prepack_mkldnn_pass,
+              paddle::framework::ir::ConvWeightsPrepackPass);
@@ -0,0 +1,41 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+#include <string>
+
+#include "paddle/fluid/framework/ir/fuse_pass_base.h"
+#include "paddle/fluid/framework/ir/graph.h"
+#include "paddle/fluid/framework/ir/pass.h"
+
+namespace paddle {
+namespace framework {
+namespace ir {
+/*
+ * Reorder conv2d weights into the blocked layout preferred by oneDNN once at
+ * predictor initialization, so the first request does not pay for the weight
+ * reorders that the kernels otherwise perform lazily on first execution.
+ */
+class Graph;
+
+class ConvWeightsPrepackPass : public FusePassBase {
+ public:
+  virtual ~ConvWeightsPrepackPass() {}
+
+ protected:
+  void ApplyImpl(ir::Graph* graph) const override;
+  const std::string name_scope_{"conv_weights_prepack_mkldnn"};
+};
+}  // namespace ir
+}  // namespace framework
+}  // namespace paddle
@@ -31,6 +31,26 @@ void UnlinkNodes(ir::Node* a, ir::Node* b) {
                   b->inputs.end());
 }
 
+bool IsBfloat16Op(const Node* op) {
+  return op->Op()->GetAttrIfExists<std::string>("mkldnn_data_type") ==
+         "bfloat16";
+}
+
+// A variable stays in bf16 end-to-end when it is produced by a bfloat16
+// operator and every operator consuming it runs in bfloat16 as well. Such
+// interior edges need no quantize/dequantize pair at all - inserting one
+// would only convert the data to fp32 and straight back.
+bool IsInteriorBfloat16Var(const Node* var) {
+  if (var->inputs.empty() || var->outputs.empty()) return false;
+  for (auto* producer : var->inputs) {
+    if (!producer->IsOp() || !IsBfloat16Op(producer)) return false;
+  }
+  for (auto* consumer : var->outputs) {
+    if (!consumer->IsOp() || !IsBfloat16Op(consumer)) return false;
+  }
+  return true;
+}
+
 // Checking whether a reorder from FP32 to BF16 should be added before the input
 // to the operator
 bool IsPermittedInputName(const std::string& input_name) {
@@ -53,6 +73,9 @@ bool IsPermittedOutputName(const std::string& output_name) {
 
 void AddQuantize(Graph* g, ir::Node* op, ir::Node* op_in,
                  int* quantize_counter) {
+  // The data is already in bf16 on edges between two bfloat16 operators
+  if (IsInteriorBfloat16Var(op_in)) return;
+
   std::vector<std::string> input_names;
 
   // Find the name of the input linking op to op_in
@@ -104,17 +127,23 @@ void AddQuantizes(Graph* g, ir::Node* op, int* quantize_counter) {
   OpDesc q_desc;
   q_desc.SetType("quantize");
 
-  std::vector<Node*> quantize_out_nodes(inputs.size());
-  std::vector<std::string> quantize_out_node_names(inputs.size());
+  std::vector<std::string> quantized_input_names(inputs.size());
 
   for (size_t i = 0; i < inputs.size(); i++) {
+    // Inputs coming straight from another bfloat16 operator are in bf16
+    // already and are consumed as-is
+    if (IsInteriorBfloat16Var(inputs[i])) {
+      quantized_input_names[i] = inputs[i]->Name();
+      continue;
+    }
+
     VarDesc quantize_out_desc(patterns::PDNodeName("quantize", "out"));
-    quantize_out_nodes[i] = g->CreateVarNode(&quantize_out_desc);
-    quantize_out_node_names[i] = quantize_out_nodes[i]->Name();
+    auto* quantize_out_node = g->CreateVarNode(&quantize_out_desc);
+    quantized_input_names[i] = quantize_out_node->Name();
 
     q_desc.SetInput("Input", std::vector<std::string>({inputs[i]->Name()}));
     q_desc.SetOutput("Output",
-                     std::vector<std::string>({quantize_out_node_names[i]}));
+                     std::vector<std::string>({quantized_input_names[i]}));
     q_desc.SetAttr("Scale", 1.f);
     q_desc.SetAttr("Shift", 0.0f);
     q_desc.SetAttr("bfloat16", true);
@@ -125,12 +154,12 @@ void AddQuantizes(Graph* g, ir::Node* op, int* quantize_counter) {
 
     UnlinkNodes(inputs[i], op);
     IR_NODE_LINK_TO(inputs[i], quantize_op);
-    IR_NODE_LINK_TO(quantize_op, quantize_out_nodes[i]);
-    IR_NODE_LINK_TO(quantize_out_nodes[i], op);
+    IR_NODE_LINK_TO(quantize_op, quantize_out_node);
+    IR_NODE_LINK_TO(quantize_out_node, op);
     (*quantize_counter)++;
   }
 
-  op->Op()->SetInput("X", quantize_out_node_names);
+  op->Op()->SetInput("X", quantized_input_names);
 }
 
 // Operators like Concat and Sum have a single input name X, which actually
@@ -187,6 +216,10 @@ void CPUBFloat16Pass::SetOutputDataType(ir::Graph* graph) const {
     GET_IR_NODE_FROM_SUBGRAPH(op, op, bfloat16_ops);
     GET_IR_NODE_FROM_SUBGRAPH(op_out, op_out, bfloat16_ops);
 
+    // Outputs consumed exclusively by other bfloat16 operators are passed
+    // on in bf16, so the dequantize/quantize round-trip is dropped entirely
+    if (IsInteriorBfloat16Var(op_out)) return;
+
     if (op->Op()->Type() != "prior_box") {
       // Find the name of the output linking op to op_out
       std::vector<std::string> output_names;
@@ -0,0 +1,109 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/ir/mkldnn/mkldnn_layout_propagation_pass.h"
+
+#include <string>
+#include <unordered_set>
+
+#include "paddle/fluid/platform/enforce.h"
+#include "paddle/fluid/platform/mkldnn_helper.h"
+#include "paddle/fluid/string/pretty_log.h"
+
+namespace paddle {
+namespace framework {
+namespace ir {
+
+using string::PrettyLogDetail;
+
+namespace {
+
+// Layout-agnostic operators with oneDNN kernels registered in this tree.
+// Switching them to oneDNN keeps activations in the blocked layout, which
+// would otherwise be reordered back to NCHW in front of them and reordered
+// again behind them.
+const std::unordered_set<std::string> kLayoutAgnosticOps{
+    // activations
+    "abs", "gelu", "hard_swish", "leaky_relu", "relu", "relu6", "sigmoid",
+    "sqrt", "swish", "tanh",
+    // elementwise
+    "elementwise_add", "elementwise_mul", "elementwise_sub",
+    // others preserving the input layout
+    "clip", "concat", "lrn", "pool2d", "scale", "slice", "softmax", "split",
+    "sum", "transpose2"};
+
+bool IsMKLDNNOp(const Node* node) {
+  return node->IsOp() && node->Op() &&
+         node->Op()->GetAttrIfExists<bool>("use_mkldnn");
+}
+
+bool IsConvertible(const Node* node) {
+  if (!node->IsOp() || node->Op() == nullptr) return false;
+  auto* op = node->Op();
+  if (kLayoutAgnosticOps.count(op->Type()) == 0) return false;
+  if (!op->HasAttr("use_mkldnn") && !op->HasProtoAttr("use_mkldnn"))
+    return false;
+  if (op->GetAttrIfExists<bool>("use_mkldnn")) return false;
+  if (platform::HasOpINT8DataType(op)) return false;
+  return true;
+}
+
+// True when any operator producing or consuming this op's tensors already
+// runs on oneDNN, i.e. converting the op removes at least one reorder.
+bool HasMKLDNNNeighbour(const Node* node) {
+  for (auto* var : node->inputs) {
+    for (auto* op : var->inputs) {
+      if (IsMKLDNNOp(op)) return true;
+    }
+  }
+  for (auto* var : node->outputs) {
+    for (auto* op : var->outputs) {
+      if (IsMKLDNNOp(op)) return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+void MKLDNNLayoutPropagationPass::ApplyImpl(ir::Graph* graph) const {
+  PADDLE_ENFORCE_NOT_NULL(graph,
+                          platform::errors::InvalidArgument(
+                              "Pointer to graph argument should not be NULL."));
+  int converted_count = 0;
+  // Iterate to a fixpoint so whole chains hanging off a single oneDNN
+  // operator get converted, not only its direct neighbours.
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (Node* node : graph->Nodes()) {
+      if (IsConvertible(node) && HasMKLDNNNeighbour(node)) {
+        node->Op()->SetAttr("use_mkldnn", true);
+        ++converted_count;
+        changed = true;
+      }
+    }
+  }
+
+  if (converted_count > 0 || VLOG_IS_ON(3))
+    PrettyLogDetail("---    switched %d operators to the oneDNN layout",
+                    converted_count);
+}
+
+}  // namespace ir
+}  // namespace framework
+}  // namespace paddle
+
+REGISTER_PASS(mkldnn_layout_propagation_pass,
+              paddle::framework::ir::MKLDNNLayoutPropagationPass);
@@ -0,0 +1,227 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/ir/mkldnn/parallel_matmul_fuse_pass.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "paddle/fluid/framework/data_type.h"
+#include "paddle/fluid/framework/ir/graph_pattern_detector.h"
+#include "paddle/fluid/framework/lod_tensor.h"
+#include "paddle/fluid/platform/enforce.h"
+
+namespace paddle {
+namespace framework {
+namespace ir {
+
+namespace {
+
+Node* FindVarNode(const std::vector<Node*>& vars, const std::string& name) {
+  for (auto* var : vars) {
+    if (var->IsVar() && var->Name() == name) return var;
+  }
+  return nullptr;
+}
+
+std::string GetMKLDNNDataType(const OpDesc* op) {
+  return op->HasAttr("mkldnn_data_type")
+             ? BOOST_GET_CONST(std::string, op->GetAttr("mkldnn_data_type"))
+             : "float32";
+}
+
+}  // namespace
+
+void ParallelMatmulFusePass::ApplyImpl(ir::Graph* graph) const {
+  PADDLE_ENFORCE_NOT_NULL(graph,
+                          platform::errors::InvalidArgument(
+                              "Pointer to graph argument should not be NULL."));
+  Init(name_scope_, graph);
+  auto* scope = param_scope();
+  PADDLE_ENFORCE_NOT_NULL(
+      scope, platform::errors::InvalidArgument("Scope cannot be nullptr."));
+
+  // Group matmul_v2 ops which multiply the same input by persistable,
+  // equally-shaped, untransposed 2D weights; members of a group are
+  // independent of each other by construction, since they only consume the
+  // shared input.
+  std::map<std::string, std::vector<Node*>> groups;
+  for (Node* node : graph->Nodes()) {
+    if (!node->IsOp() || node->Op()->Type() != "matmul_v2") continue;
+    auto* op = node->Op();
+    if (!(op->HasAttr("use_mkldnn") &&
+          BOOST_GET_CONST(bool, op->GetAttr("use_mkldnn")))) {
+      continue;
+    }
+    if (BOOST_GET_CONST(bool, op->GetAttr("trans_y"))) continue;
+    if (op->Input("X").size() != 1 || op->Input("Y").size() != 1 ||
+        op->Output("Out").size() != 1) {
+      continue;
+    }
+
+    auto* y_node = FindVarNode(node->inputs, op->Input("Y")[0]);
+    auto* out_node = FindVarNode(node->outputs, op->Output("Out")[0]);
+    if (y_node == nullptr || out_node == nullptr ||
+        !y_node->Var()->Persistable()) {
+      continue;
+    }
+    // The weights must not feed anything else, or they could not be folded
+    // into the concatenated tensor.
+    if (y_node->outputs.size() != 1) continue;
+
+    const auto y_shape = y_node->Var()->GetShape();
+    if (y_shape.size() != 2 || y_shape[0] <= 0 || y_shape[1] <= 0) continue;
+    const auto out_shape = out_node->Var()->GetShape();
+    if (out_shape.size() < 2 || out_shape.back() != y_shape[1]) continue;
+
+    std::string key = op->Input("X")[0];
+    key += "|trans_x:";
+    key += BOOST_GET_CONST(bool, op->GetAttr("trans_x")) ? "1" : "0";
+    key += "|y:" + std::to_string(y_shape[0]) + "x" +
+           std::to_string(y_shape[1]);
+    key += "|" + GetMKLDNNDataType(op);
+    groups[key].push_back(node);
+  }
+
+  int found_count = 0;
+  int group_idx = 0;
+  for (auto& group : groups) {
+    auto& ops = group.second;
+    if (ops.size() < 2) continue;
+    // Process in a deterministic order regardless of node iteration order.
+    std::sort(ops.begin(), ops.end(), [](const Node* a, const Node* b) {
+      return a->Op()->Output("Out")[0] < b->Op()->Output("Out")[0];
+    });
+
+    const int64_t num_branches = static_cast<int64_t>(ops.size());
+    auto* y0_node = FindVarNode(ops[0]->inputs, ops[0]->Op()->Input("Y")[0]);
+    const auto y_shape = y0_node->Var()->GetShape();
+    const int64_t k = y_shape[0];
+    const int64_t n = y_shape[1];
+
+    std::vector<const LoDTensor*> weights;
+    bool weights_ok = true;
+    for (auto* op_node : ops) {
+      auto* var = scope->FindVar(op_node->Op()->Input("Y")[0]);
+      const LoDTensor* weight =
+          var == nullptr ? nullptr : &var->Get<LoDTensor>();
+      if (weight == nullptr || !weight->IsInitialized() ||
+          framework::vectorize(weight->dims()) !=
+              std::vector<int64_t>({k, n}) ||
+          (!weights.empty() && weight->type() != weights.front()->type())) {
+        weights_ok = false;
+        break;
+      }
+      weights.push_back(weight);
+    }
+    if (!weights_ok) continue;
+
+    // Concatenate the weights column-wise into a new parameter.
+    const std::string w_cat_name =
+        name_scope_ + "/w_cat_" + std::to_string(group_idx);
+    VarDesc w_cat_desc(w_cat_name);
+    w_cat_desc.SetShape({k, n * num_branches});
+    w_cat_desc.SetDataType(y0_node->Var()->GetDataType());
+    w_cat_desc.SetPersistable(true);
+    auto* w_cat_node = graph->CreateVarNode(&w_cat_desc);
+
+    auto* w_cat = scope->Var(w_cat_name)->GetMutable<LoDTensor>();
+    w_cat->Resize({k, n * num_branches});
+    const auto dtype = weights.front()->type();
+    auto* dst = reinterpret_cast<uint8_t*>(
+        w_cat->mutable_data(platform::CPUPlace(), dtype));
+    const size_t row_bytes = n * framework::SizeOfType(dtype);
+    for (int64_t branch = 0; branch < num_branches; ++branch) {
+      const auto* src =
+          reinterpret_cast<const uint8_t*>(weights[branch]->data<void>());
+      for (int64_t row = 0; row < k; ++row) {
+        std::memcpy(dst + (row * num_branches + branch) * row_bytes,
+                    src + row * row_bytes, row_bytes);
+      }
+    }
+
+    auto* x_node = FindVarNode(ops[0]->inputs, ops[0]->Op()->Input("X")[0]);
+    auto* out0_node =
+        FindVarNode(ops[0]->outputs, ops[0]->Op()->Output("Out")[0]);
+
+    const std::string out_cat_name =
+        name_scope_ + "/out_cat_" + std::to_string(group_idx);
+    VarDesc out_cat_desc(out_cat_name);
+    auto out_cat_shape = out0_node->Var()->GetShape();
+    out_cat_shape.back() = n * num_branches;
+    out_cat_desc.SetShape(out_cat_shape);
+    out_cat_desc.SetDataType(out0_node->Var()->GetDataType());
+    out_cat_desc.SetPersistable(false);
+    auto* out_cat_node = graph->CreateVarNode(&out_cat_desc);
+
+    OpDesc matmul_desc;
+    matmul_desc.SetType("matmul_v2");
+    matmul_desc.SetAttrMap(ops[0]->Op()->GetAttrMap());
+    matmul_desc.SetInput("X", {x_node->Name()});
+    matmul_desc.SetInput("Y", {w_cat_name});
+    matmul_desc.SetOutput("Out", {out_cat_name});
+    auto* matmul_node = graph->CreateOpNode(&matmul_desc);
+
+    std::vector<std::string> out_names;
+    std::vector<Node*> out_nodes;
+    for (auto* op_node : ops) {
+      out_names.push_back(op_node->Op()->Output("Out")[0]);
+      out_nodes.push_back(FindVarNode(op_node->outputs, out_names.back()));
+    }
+
+    OpDesc split_desc;
+    split_desc.SetType("split");
+    split_desc.SetInput("X", {out_cat_name});
+    split_desc.SetOutput("Out", out_names);
+    split_desc.SetAttr("axis",
+                       static_cast<int>(out_cat_shape.size()) - 1);
+    split_desc.SetAttr("num", static_cast<int>(num_branches));
+    split_desc.SetAttr("sections", std::vector<int>{});
+    auto* split_node = graph->CreateOpNode(&split_desc);
+
+    IR_NODE_LINK_TO(x_node, matmul_node);
+    IR_NODE_LINK_TO(w_cat_node, matmul_node);
+    IR_NODE_LINK_TO(matmul_node, out_cat_node);
+    IR_NODE_LINK_TO(out_cat_node, split_node);
+    for (auto* out_node : out_nodes) {
+      IR_NODE_LINK_TO(split_node, out_node);
+    }
+
+    std::unordered_set<const Node*> nodes_to_remove;
+    for (auto* op_node : ops) {
+      nodes_to_remove.insert(op_node);
+      nodes_to_remove.insert(
+          FindVarNode(op_node->inputs, op_node->Op()->Input("Y")[0]));
+    }
+    GraphSafeRemoveNodes(graph, nodes_to_remove);
+
+    VLOG(4) << "Merged " << num_branches << " parallel matmul_v2 ops fed by "
+            << x_node->Name() << " into one batched matmul";
+    found_count += static_cast<int>(num_branches);
+    ++group_idx;
+  }
+
+  AddStatis(found_count);
+}
+
+}  // namespace ir
+}  // namespace framework
+}  // namespace paddle
+
+REGISTER_PASS(parallel_matmul_fuse_pass,
+              paddle::framework::ir::ParallelMatmulFusePass);
@@ -0,0 +1,42 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+#include <string>
+
+#include "paddle/fluid/framework/ir/fuse_pass_base.h"
+#include "paddle/fluid/framework/ir/graph.h"
+#include "paddle/fluid/framework/ir/pass.h"
+
+namespace paddle {
+namespace framework {
+namespace ir {
+/*
+ * Merge parallel matmul_v2 ops that multiply the same input with
+ * equally-shaped weights (e.g. the Q/K/V projections of an attention layer)
+ * into a single matmul against the concatenated weights followed by a split,
+ * so one primitive dispatch replaces several small ones.
+ */
+class Graph;
+
+class ParallelMatmulFusePass : public FusePassBase {
+ public:
+  virtual ~ParallelMatmulFusePass() {}
+
+ protected:
+  void ApplyImpl(ir::Graph* graph) const override;
+  const std::string name_scope_{"parallel_matmul_fuse"};
+};
+}  // namespace ir
+}  // namespace framework
+}  // namespace paddle
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <string>
 #include "paddle/fluid/framework/details/all_reduce_op_handle.h"
 #include "paddle/fluid/framework/details/container_cast.h"
@@ -20,6 +21,8 @@
 #include "paddle/fluid/framework/details/multi_devices_helper.h"
 #include "paddle/fluid/framework/ir/graph_helper.h"
 
+DECLARE_int32(grad_merge_allreduce_nchunks);
+
 namespace paddle {
 namespace framework {
 namespace ir {
@@ -90,16 +93,44 @@ class FuseAllReduceOpPass : public ir::Pass {
       for (auto &p_g : group_p_g) {
         group_all_reduce_ops.emplace_back(all_reduce_ops.at(p_g.second));
       }
+      // With gradient merge, one fused allreduce only starts after every
+      // gradient in the group has finished accumulating, so the whole merge
+      // window's communication bursts at the boundary step. Splitting the
+      // group into chunks lets a chunk whose accumulations complete early
+      // start its allreduce while the final micro batch is still in
+      // backward. The chunks keep the group order, so each of them still
+      // covers a contiguous range of the coalesced gradient buffer.
+      size_t nchunks = 1;
+      bool is_grad_merge =
+          dynamic_cast<details::GradMergeAllReduceOpHandle *>(
+              &group_all_reduce_ops.front()
+                   ->Wrapper<details::OpHandleBase>()) != nullptr;
+      if (is_grad_merge && FLAGS_grad_merge_allreduce_nchunks > 1) {
+        nchunks = std::min(
+            static_cast<size_t>(FLAGS_grad_merge_allreduce_nchunks),
+            group_size);
+        VLOG(6) << "Split grad merge allreduce group of size " << group_size
+                << " into " << nchunks << " chunks";
+      }
+      size_t chunk_begin = 0;
+      for (size_t chunk = 0; chunk < nchunks; ++chunk) {
+        size_t chunk_size =
+            group_size / nchunks + (chunk < group_size % nchunks ? 1 : 0);
+        std::vector<ir::Node *> chunk_all_reduce_ops(
+            group_all_reduce_ops.begin() + chunk_begin,
+            group_all_reduce_ops.begin() + chunk_begin + chunk_size);
+        chunk_begin += chunk_size;
 #if defined(PADDLE_WITH_NCCL) || defined(PADDLE_WITH_RCCL)
-      InsertFusedAllReduce(places, local_scopes, group_size,
-                           group_all_reduce_ops, multi_nccl_ctxs, &result);
+        InsertFusedAllReduce(places, local_scopes, chunk_size,
+                             chunk_all_reduce_ops, multi_nccl_ctxs, &result);
 #elif defined(PADDLE_WITH_XPU_BKCL)
-      InsertFusedAllReduce(places, local_scopes, group_size,
-                           group_all_reduce_ops, multi_bkcl_ctxs, &result);
+        InsertFusedAllReduce(places, local_scopes, chunk_size,
+                             chunk_all_reduce_ops, multi_bkcl_ctxs, &result);
 #else
-      InsertFusedAllReduce(places, local_scopes, group_size,
-                           group_all_reduce_ops, &result);
+        InsertFusedAllReduce(places, local_scopes, chunk_size,
+                             chunk_all_reduce_ops, &result);
 #endif
+      }
     }
   }
 
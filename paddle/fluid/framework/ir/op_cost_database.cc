@@ -0,0 +1,110 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/ir/op_cost_database.h"
+
+#include <fstream>
+
+#include "glog/logging.h"
+
+namespace paddle {
+namespace framework {
+
+const double OpCostDatabase::NOT_MEASURED = -1;
+
+OpCostDatabase& OpCostDatabase::Instance() {
+  static OpCostDatabase db;
+  return db;
+}
+
+void OpCostDatabase::Merge(OpCostRecord* record, double mean_time_ms,
+                           int64_t sample_count) {
+  int64_t total = record->sample_count + sample_count;
+  record->mean_time_ms = (record->mean_time_ms * record->sample_count +
+                          mean_time_ms * sample_count) /
+                         total;
+  record->sample_count = total;
+}
+
+void OpCostDatabase::Record(const std::string& key, double time_ms) {
+  std::string op_type = key.substr(0, key.find('|'));
+  std::lock_guard<std::mutex> guard(mutex_);
+  Merge(&records_[key], time_ms, 1);
+  Merge(&op_type_records_[op_type], time_ms, 1);
+}
+
+double OpCostDatabase::Lookup(const std::string& key) const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = records_.find(key);
+  return it == records_.end() ? NOT_MEASURED : it->second.mean_time_ms;
+}
+
+double OpCostDatabase::LookupByOpType(const std::string& op_type) const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = op_type_records_.find(op_type);
+  return it == op_type_records_.end() ? NOT_MEASURED
+                                      : it->second.mean_time_ms;
+}
+
+size_t OpCostDatabase::Size() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return records_.size();
+}
+
+void OpCostDatabase::Clear() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  records_.clear();
+  op_type_records_.clear();
+}
+
+void OpCostDatabase::Save(const std::string& path) const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  std::ofstream fout(path);
+  if (!fout) {
+    LOG(WARNING) << "Cannot open [" << path << "] to save op cost database";
+    return;
+  }
+  for (const auto& pair : records_) {
+    fout << pair.first << " " << pair.second.sample_count << " "
+         << pair.second.mean_time_ms << "\n";
+  }
+  VLOG(3) << "Saved " << records_.size() << " op cost records to " << path;
+}
+
+bool OpCostDatabase::Load(const std::string& path) {
+  std::ifstream fin(path);
+  if (!fin) {
+    LOG(WARNING) << "Cannot open [" << path << "] to load op cost database";
+    return false;
+  }
+  std::lock_guard<std::mutex> guard(mutex_);
+  std::string key;
+  int64_t sample_count;
+  double mean_time_ms;
+  size_t num_loaded = 0;
+  while (fin >> key >> sample_count >> mean_time_ms) {
+    if (sample_count <= 0) {
+      continue;
+    }
+    std::string op_type = key.substr(0, key.find('|'));
+    Merge(&records_[key], mean_time_ms, sample_count);
+    Merge(&op_type_records_[op_type], mean_time_ms, sample_count);
+    ++num_loaded;
+  }
+  VLOG(3) << "Loaded " << num_loaded << " op cost records from " << path;
+  return true;
+}
+
+}  // namespace framework
+}  // namespace paddle
@@ -0,0 +1,77 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace paddle {
+namespace framework {
+
+// Aggregated measurements of one op kernel, averaged over repeated runs.
+struct OpCostRecord {
+  double mean_time_ms{0.0};
+  int64_t sample_count{0};
+};
+
+// A process-wide database of measured per-op-kernel latencies. Entries are
+// keyed by a string built from op type, input shapes, dtype and place (see
+// OpCostKey in cost_model.h); the op type must be the key prefix up to the
+// first '|' so that a coarser per-op-type aggregate can be maintained for
+// consumers that do not know shapes ahead of time, such as the SSA graph
+// executors. The database can be saved to and loaded from a text file so
+// that measurements survive process restarts.
+class OpCostDatabase {
+ public:
+  static OpCostDatabase& Instance();
+
+  // Returned by Lookup/LookupByOpType when no measurement exists.
+  static const double NOT_MEASURED;
+
+  // Fold one measurement into the running mean of the keyed entry and of
+  // the per-op-type aggregate.
+  void Record(const std::string& key, double time_ms);
+
+  // Mean latency of the exact key, or NOT_MEASURED.
+  double Lookup(const std::string& key) const;
+
+  // Mean latency over all recorded shapes/dtypes of the op type, or
+  // NOT_MEASURED.
+  double LookupByOpType(const std::string& op_type) const;
+
+  size_t Size() const;
+
+  void Clear();
+
+  // Write all keyed entries as "key sample_count mean_time_ms" lines.
+  void Save(const std::string& path) const;
+
+  // Merge entries from a previously saved file into the database, combining
+  // duplicated keys by sample-count-weighted mean. Returns false if the
+  // file cannot be read.
+  bool Load(const std::string& path);
+
+ private:
+  static void Merge(OpCostRecord* record, double mean_time_ms,
+                    int64_t sample_count);
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, OpCostRecord> records_;
+  std::unordered_map<std::string, OpCostRecord> op_type_records_;
+};
+
+}  // namespace framework
+}  // namespace paddle
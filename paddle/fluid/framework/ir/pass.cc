@@ -50,6 +50,12 @@ Graph *Pass::Apply(Graph *graph) const {
                           "Required atrribute %s for graph is not set.", attr));
   }
   ApplyImpl(graph);
+  // A pass may rewrite op descs in place without changing the node set, which
+  // the graph modification generation cannot observe; drop the cached pattern
+  // detector node index so the next pass starts from a fresh traversal.
+  if (graph->Has(kGraphPatternDetectorNodeIndex)) {
+    graph->Erase(kGraphPatternDetectorNodeIndex);
+  }
   // TODO(panyx0718): Add more verifications.
   PADDLE_ENFORCE_EQ(
       HasCircle(*graph), false,
@@ -15,7 +15,11 @@ limitations under the License. */
 #include "paddle/fluid/framework/lod_tensor.h"
 
 #include <stdint.h>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
 
+#include "paddle/fluid/framework/data_type.h"
 #include "paddle/fluid/framework/version.h"
 
 namespace paddle {
@@ -347,6 +351,120 @@ void DeserializeFromStream(std::istream &is, LoDTensor *tensor,
   TensorFromStream(is, static_cast<Tensor *>(tensor), dev_ctx);
 }
 
+#ifndef _WIN32
+namespace {
+// Copies a POD field out of the mapped buffer and advances *offset,
+// enforcing that the read stays inside the mapping.
+template <typename T>
+void ReadFromMemoryMap(const char *base, size_t total_size, size_t *offset,
+                       T *out) {
+  PADDLE_ENFORCE_LE(
+      *offset + sizeof(T), total_size,
+      platform::errors::InvalidArgument(
+          "Unexpected end of the mapped model file, maybe the loaded file is "
+          "not a complete paddle model."));
+  std::memcpy(out, base + *offset, sizeof(T));
+  *offset += sizeof(T);
+}
+}  // namespace
+
+void DeserializeFromMemoryMap(
+    const std::shared_ptr<memory::allocation::MemoryMapFileAllocation> &mapped,
+    size_t *offset, LoDTensor *tensor) {
+  const char *base = static_cast<const char *>(mapped->ptr());
+  size_t total_size = mapped->size();
+  {
+    // the 1st field, unit32_t version for LoDTensor
+    uint32_t version;
+    ReadFromMemoryMap(base, total_size, offset, &version);
+    PADDLE_ENFORCE_EQ(framework::IsTensorVersionSupported(version), true,
+                      platform::errors::InvalidArgument(
+                          "Tensor version %u is not supported.", version));
+    PADDLE_ENFORCE_EQ(
+        version, 0U,
+        platform::errors::InvalidArgument(
+            "Deserialize to tensor failed, maybe the loaded file is "
+            "not a paddle model(expected file format: 0, but %u found).",
+            version));
+  }
+  {
+    // the 2st field, LoD information
+    uint64_t lod_level;
+    ReadFromMemoryMap(base, total_size, offset, &lod_level);
+    auto &lod = *tensor->mutable_lod();
+    lod.resize(lod_level);
+    for (uint64_t i = 0; i < lod_level; ++i) {
+      uint64_t size;
+      ReadFromMemoryMap(base, total_size, offset, &size);
+      PADDLE_ENFORCE_LE(
+          *offset + size, total_size,
+          platform::errors::InvalidArgument(
+              "Unexpected end of the mapped model file, maybe the loaded "
+              "file is not a complete paddle model."));
+      std::vector<size_t> tmp(size / sizeof(size_t));
+      std::memcpy(tmp.data(), base + *offset, size);
+      *offset += size;
+      lod[i] = tmp;
+    }
+  }
+  // the 3st filed, Tensor
+  {
+    uint32_t version;
+    ReadFromMemoryMap(base, total_size, offset, &version);
+    PADDLE_ENFORCE_EQ(
+        version, 0U,
+        platform::errors::InvalidArgument(
+            "tensor version %u is not supported, Only version 0 is supported.",
+            version));
+  }
+  proto::VarType::TensorDesc desc;
+  {
+    // int32_t size followed by the serialized TensorDesc
+    int32_t size;
+    ReadFromMemoryMap(base, total_size, offset, &size);
+    PADDLE_ENFORCE_LE(
+        *offset + static_cast<size_t>(size), total_size,
+        platform::errors::InvalidArgument(
+            "Unexpected end of the mapped model file, maybe the loaded file "
+            "is not a complete paddle model."));
+    PADDLE_ENFORCE_EQ(
+        desc.ParseFromArray(base + *offset, size), true,
+        platform::errors::InvalidArgument("Cannot parse tensor desc"));
+    *offset += static_cast<size_t>(size);
+  }
+  {
+    // the tensor payload, referenced in place when possible
+    std::vector<int64_t> dims;
+    dims.reserve(static_cast<size_t>(desc.dims().size()));
+    std::copy(desc.dims().begin(), desc.dims().end(),
+              std::back_inserter(dims));
+    tensor->Resize(framework::make_ddim(dims));
+    size_t elem_size = framework::SizeOfType(desc.data_type());
+    size_t data_size = static_cast<size_t>(tensor->numel()) * elem_size;
+    PADDLE_ENFORCE_LE(
+        *offset + data_size, total_size,
+        platform::errors::InvalidArgument(
+            "Unexpected end of the mapped model file, maybe the loaded file "
+            "is not a complete paddle model."));
+    const char *data = base + *offset;
+    // save_combine does not align the payloads, so only reference the
+    // mapping in place when the payload happens to be naturally aligned
+    // for its element type.
+    if (reinterpret_cast<uintptr_t>(data) % elem_size == 0) {
+      tensor->ResetHolderWithType(
+          std::make_shared<memory::allocation::MemoryMapSliceAllocation>(
+              mapped, *offset, data_size),
+          desc.data_type());
+    } else {
+      void *buf =
+          tensor->mutable_data(platform::CPUPlace(), desc.data_type());
+      std::memcpy(buf, data, data_size);
+    }
+    *offset += data_size;
+  }
+}
+#endif
+
 std::vector<LoDTensor> LoDTensor::SplitLoDTensor(
     const std::vector<platform::Place> places) const {
   PADDLE_ENFORCE_GT(places.size(), 0,
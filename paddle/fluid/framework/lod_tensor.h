@@ -24,6 +24,9 @@ limitations under the License. */
 #include "paddle/fluid/framework/mixed_vector.h"
 #include "paddle/fluid/framework/tensor.h"
 #include "paddle/fluid/framework/tensor_util.h"
+#ifndef _WIN32
+#include "paddle/fluid/memory/allocation/mmap_allocator.h"
+#endif
 #include "paddle/fluid/platform/enforce.h"
 #include "paddle/fluid/platform/place.h"
 
@@ -241,6 +244,20 @@ void DeserializeFromStream(std::istream& is, LoDTensor* tensor,
                            const size_t& seek,
                            const std::vector<int64_t>& shape);
 
+#ifndef _WIN32
+/*
+ * Deserialize the next LoDTensor from a memory mapped combined parameter
+ * file, starting at *offset and advancing it past the consumed record.
+ * The tensor holder is pointed straight at the mapped file when the payload
+ * is naturally aligned for its element type, so no data is copied and the
+ * pages stay shared with the page cache (copy-on-first-write); otherwise
+ * the payload is copied into a fresh CPU allocation. CPU place only.
+ */
+void DeserializeFromMemoryMap(
+    const std::shared_ptr<memory::allocation::MemoryMapFileAllocation>& mapped,
+    size_t* offset, LoDTensor* tensor);
+#endif
+
 /*
  * Convert between length-based LoD and offset-based LoD.
  * The implementation of LoDTensor class use offset-based LoD.
@@ -467,45 +467,133 @@ class Vector {
 
 #else  // PADDLE_WITH_CUDA
 
+// The CPU-only Vector shares its storage on copy, just like the CUDA
+// Vector above: copies are O(1) and the storage is only duplicated when
+// one of the owners mutates it (copy-on-write through COWPtr). LoD is a
+// vector of these, so sharing the LoD of a tensor through a long chain of
+// sequence ops no longer copies the level vectors.
 template <typename T>
-class CPUVector : public std::vector<T, std::allocator<T>> {
+class CPUVector {
  public:
-  CPUVector() : std::vector<T>() {}
+  using value_type = T;
+  using iterator = typename std::vector<T>::iterator;
+  using const_iterator = typename std::vector<T>::const_iterator;
+
+  CPUVector() : m_(new std::vector<T>()) {}
   CPUVector(size_t count, const T &value = T())  // NOLINT
-      : std::vector<T>(count, value) {}
-  CPUVector(std::initializer_list<T> init) : std::vector<T>(init) {}
-  CPUVector(const std::vector<T> &other) : std::vector<T>(other) {}  // NOLINT
-  CPUVector(const CPUVector<T> &other) : std::vector<T>(other) {}
-  CPUVector(CPUVector<T> &&other) : std::vector<T>(std::move(other)) {}
+      : m_(new std::vector<T>(count, value)) {}
+  CPUVector(std::initializer_list<T> init) : m_(new std::vector<T>(init)) {}
+  template <typename U>
+  CPUVector(const std::vector<U> &other)  // NOLINT
+      : m_(new std::vector<T>(other.begin(), other.end())) {}
   CPUVector(std::vector<T> &&other)  // NOLINT
-      : std::vector<T>(std::move(other)) {}
+      : m_(new std::vector<T>(std::move(other))) {}
+  CPUVector(const CPUVector<T> &other) : m_(other.m_) {}
+  CPUVector(CPUVector<T> &&other) : m_(std::move(other.m_)) {}
+
   CPUVector &operator=(const CPUVector &other) {
-    this->assign(other.begin(), other.end());
+    m_ = other.m_;
+    return *this;
+  }
+  CPUVector &operator=(CPUVector &&other) {
+    m_ = std::move(other.m_);
     return *this;
   }
   CPUVector &operator=(const std::vector<T> &other) {
-    this->assign(other.begin(), other.end());
+    m_ = details::COWPtr<std::vector<T>>(new std::vector<T>(other));
     return *this;
   }
 
   friend std::ostream &operator<<(std::ostream &os, const CPUVector<T> &other) {
-    std::stringstream ss;
     for (auto v : other) {
       os << v << " ";
     }
     return os;
   }
 
-  T &operator[](size_t id) { return this->at(id); }
+  size_t size() const { return m_.Data().size(); }
+  bool empty() const { return m_.Data().empty(); }
+  size_t capacity() const { return m_.Data().capacity(); }
+
+  T &operator[](size_t id) { return m_.MutableData()->at(id); }
+  const T &operator[](size_t id) const { return m_.Data().at(id); }
+  T &at(size_t id) { return m_.MutableData()->at(id); }
+  const T &at(size_t id) const { return m_.Data().at(id); }
+
+  iterator begin() { return m_.MutableData()->begin(); }
+  iterator end() { return m_.MutableData()->end(); }
+  const_iterator begin() const { return m_.Data().begin(); }
+  const_iterator end() const { return m_.Data().end(); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  T &front() { return m_.MutableData()->front(); }
+  T &back() { return m_.MutableData()->back(); }
+  const T &front() const { return m_.Data().front(); }
+  const T &back() const { return m_.Data().back(); }
+
+  T *data() { return m_.MutableData()->data(); }
+  const T *data() const { return m_.Data().data(); }
+
+  template <typename Iter>
+  void assign(Iter begin, Iter end) {
+    m_.MutableData()->assign(begin, end);
+  }
+
+  void push_back(T elem) { m_.MutableData()->push_back(elem); }
+  void pop_back() { m_.MutableData()->pop_back(); }
+
+  template <typename... Args>
+  void emplace_back(Args &&... args) {
+    m_.MutableData()->emplace_back(std::forward<Args>(args)...);
+  }
 
-  const T &operator[](size_t id) const { return this->at(id); }
+  // NOTE: the position based methods convert the position into an index
+  // first, because detaching the shared storage invalidates iterators that
+  // were obtained before the call.
+  iterator insert(const_iterator pos, const T &value) {
+    size_t idx = pos - m_.Data().cbegin();
+    auto *vec = m_.MutableData();
+    return vec->insert(vec->begin() + idx, value);
+  }
+
+  template <typename Iter>
+  iterator insert(const_iterator pos, Iter begin, Iter end) {
+    size_t idx = pos - m_.Data().cbegin();
+    auto *vec = m_.MutableData();
+    return vec->insert(vec->begin() + idx, begin, end);
+  }
+
+  iterator erase(const_iterator pos) {
+    size_t idx = pos - m_.Data().cbegin();
+    auto *vec = m_.MutableData();
+    return vec->erase(vec->begin() + idx);
+  }
 
   template <typename D>
   void Extend(const D &begin, const D &end) {
-    this->reserve(this->size() + size_t(end - begin));
-    this->insert(this->end(), begin, end);
+    auto *vec = m_.MutableData();
+    vec->reserve(vec->size() + size_t(end - begin));
+    vec->insert(vec->end(), begin, end);
   }
 
+  void resize(size_t size) {
+    if (m_.Data().size() != size) {
+      m_.MutableData()->resize(size);
+    }
+  }
+
+  void clear() { m_.MutableData()->clear(); }
+
+  void reserve(size_t size) { m_.MutableData()->reserve(size); }
+
+  operator std::vector<T>() const { return m_.Data(); }
+
+  bool operator==(const CPUVector<T> &other) const {
+    return m_.Data() == other.m_.Data();
+  }
+  bool operator!=(const CPUVector<T> &other) const { return !(*this == other); }
+
   const T *CUDAData(platform::Place place) const {
     PADDLE_THROW(platform::errors::Unavailable(
         "Vector::CUDAData() method is not supported in CPU-only version."));
@@ -533,7 +621,11 @@ class CPUVector : public std::vector<T, std::allocator<T>> {
     return this->data();
   }
 
-  const void *Handle() const { return static_cast<const void *>(this); }
+  const void *Handle() const { return &m_.Data(); }
+
+ private:
+  // CPUVector is an COW object.
+  mutable details::COWPtr<std::vector<T>> m_;
 };
 
 template <typename T>
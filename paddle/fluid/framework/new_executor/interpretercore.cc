@@ -18,10 +18,15 @@
 #include <unordered_set>
 
 #include "paddle/fluid/framework/details/share_tensor_buffer_functor.h"
+#include "paddle/fluid/platform/device_tracer.h"
 #include "paddle/fluid/platform/profiler.h"
 
 PADDLE_DEFINE_EXPORTED_bool(new_executor_use_inplace, true,
                             "Use inplace in new executor");
+PADDLE_DEFINE_EXPORTED_bool(
+    new_executor_use_infershape_cache, false,
+    "Skip InferShape in new executor when the input shapes of an "
+    "instruction are unchanged since the previous step");
 
 namespace paddle {
 namespace framework {
@@ -108,11 +113,12 @@ void InterpreterCore::Convert() {
   vec_instruction_.reserve(vec_func_list_.size());
   dependecy_count_.resize(vec_func_list_.size());
   vec_meta_info_.resize(global_scope_->var_list.size());
+  auto stream_hints = stream_analyzer_.PartitionComputeChains(vec_func_list_);
   for (size_t i = 0; i < vec_func_list_.size(); ++i) {
     Instruction temp_inst;
     auto* op_base = op_list_[i];
-    temp_inst.dev_ctx_ =
-        stream_analyzer_.ParseDeviceContext(vec_func_list_[i], *op_base);
+    temp_inst.dev_ctx_ = stream_analyzer_.ParseDeviceContext(
+        vec_func_list_[i], *op_base, stream_hints[i]);
     temp_inst.kernel_func_.compute_func_ = vec_func_list_[i].kernel_func_;
     temp_inst.kernel_func_.operator_base_ = op_base;
     temp_inst.input_index_ = vec_func_list_[i].input_index;
@@ -204,6 +210,13 @@ void InterpreterCore::Convert() {
                            platform::GenerateDeviceEventFlag());
   }
 
+  instruction_stats_.resize(vec_instruction_.size());
+  instruction_ready_ns_.assign(vec_instruction_.size(), 0);
+  for (size_t i = 0; i < vec_instruction_.size(); ++i) {
+    instruction_stats_[i].op_type =
+        vec_instruction_[i].kernel_func_.operator_base_->Type();
+  }
+
   if (FLAGS_new_executor_use_inplace) {
     BuildInplace();
   }
@@ -327,15 +340,73 @@ void InterpreterCore::BuildSkipShareLoDInfo() {
   }
 }
 
+// Collects the dims and LoD of every LoDTensor in var_map in deterministic
+// order. Returns false when a non-LoDTensor variable is met, in which case
+// the shape-signature cache can not be used for this instruction.
+static bool CollectTensorDims(const VariableValueMap& var_map,
+                              std::vector<DDim>* dims, std::vector<LoD>* lods) {
+  for (auto& var_name_item : var_map) {
+    for (auto* var : var_name_item.second) {
+      if (var == nullptr || !var->IsType<LoDTensor>()) {
+        return false;
+      }
+      auto& tensor = var->Get<LoDTensor>();
+      dims->emplace_back(tensor.dims());
+      lods->emplace_back(tensor.lod());
+    }
+  }
+  return true;
+}
+
 void InterpreterCore::RunInstruction(const Instruction& instr_node) {
   VLOG(3) << "RunInstruction:  "
           << instr_node.kernel_func_.operator_base_->Type();
 
-  {
+  bool skip_infershape = false;
+  auto& sig = instr_node.shape_signature_;
+  if (FLAGS_new_executor_use_infershape_cache && sig.cacheable_) {
+    std::vector<DDim> input_dims;
+    std::vector<LoD> input_lods;
+    if (!CollectTensorDims(instr_node.runtime_ctx_->inputs, &input_dims,
+                           &input_lods)) {
+      sig.cacheable_ = false;
+    } else if (sig.valid_ && input_dims == sig.input_dims_ &&
+               input_lods == sig.input_lods_) {
+      // Same signature as the previous step: restore the recorded output
+      // dims/LoD and skip InferShape.
+      size_t idx = 0;
+      for (auto& var_name_item : instr_node.runtime_ctx_->outputs) {
+        for (auto* var : var_name_item.second) {
+          auto* tensor = var->GetMutable<LoDTensor>();
+          tensor->Resize(sig.output_dims_[idx]);
+          tensor->set_lod(sig.output_lods_[idx]);
+          ++idx;
+        }
+      }
+      skip_infershape = true;
+    } else {
+      sig.input_dims_ = std::move(input_dims);
+      sig.input_lods_ = std::move(input_lods);
+      sig.valid_ = false;
+    }
+  }
+
+  if (!skip_infershape) {
     platform::RecordEvent infershape_event("InferShape");
     static_cast<const framework::OperatorWithKernel*>(
         instr_node.kernel_func_.operator_base_)
         ->InferShape(instr_node.infershape_ctx_.get());
+
+    if (FLAGS_new_executor_use_infershape_cache && sig.cacheable_) {
+      sig.output_dims_.clear();
+      sig.output_lods_.clear();
+      if (CollectTensorDims(instr_node.runtime_ctx_->outputs,
+                            &sig.output_dims_, &sig.output_lods_)) {
+        sig.valid_ = true;
+      } else {
+        sig.cacheable_ = false;
+      }
+    }
   }
 
   if (FLAGS_new_executor_use_inplace) {
@@ -362,6 +433,7 @@ void InterpreterCore::ExecuteInstructionList(
 
   for (size_t i = 0; i < dependecy_count_.size(); ++i) {
     if (dependecy_count_[i] == 0) {
+      instruction_ready_ns_[i] = platform::PosixInNsec();
       async_work_queue_.AddTask(vec_instr[i].type_,
                                 [&, i] { RunInstructionAsync(i); });
     }
@@ -374,6 +446,10 @@ void InterpreterCore::ExecuteInstructionList(
       platform::errors::Fatal(
           "Required op_run_number == %d, but received op_run_number = %d.",
           vec_instr.size(), op_run_number_.load()));
+
+  // Hand this step's deletion candidates to the collector thread, so the
+  // next step does not compete with frees in the op completion path.
+  gc_.ReclaimEpoch();
 }
 
 void InterpreterCore::RunNextInstructions(
@@ -381,7 +457,11 @@ void InterpreterCore::RunNextInstructions(
   auto& next_instr = instr.next_instruction_;
   auto& atomic_deps = async_work_queue_.AtomicDeps();
   auto IsReady = [&](size_t next_id) {
-    return atomic_deps[next_id]->fetch_sub(1, std::memory_order_relaxed) == 1;
+    if (atomic_deps[next_id]->fetch_sub(1, std::memory_order_relaxed) == 1) {
+      instruction_ready_ns_[next_id] = platform::PosixInNsec();
+      return true;
+    }
+    return false;
   };
 
   if (instr.type_ == OpFuncType::kQueueAsync) {
@@ -440,17 +520,31 @@ void InterpreterCore::RunInstructionAsync(size_t instr_id) {
     instr_id = ready_ops.front();
     ready_ops.pop();
     auto& instr_node = vec_instruction_[instr_id];
+    auto& stat = instruction_stats_[instr_id];
+    uint64_t picked_ns = platform::PosixInNsec();
+    if (instruction_ready_ns_[instr_id] != 0) {
+      stat.total_queue_ms =
+          stat.total_queue_ms +
+          (picked_ns - instruction_ready_ns_[instr_id]) / 1000000.0;
+    }
     platform::RecordEvent instruction_event(
         instr_node.kernel_func_.operator_base_->Type());
     event_manager_.WaitEvent(instr_node, place_);
 
+    uint64_t run_start_ns = platform::PosixInNsec();
     RunInstruction(instr_node);
+    double run_ms = (platform::PosixInNsec() - run_start_ns) / 1000000.0;
+    stat.run_count += 1;
+    stat.total_run_ms += run_ms;
+    stat.AddRunSample(run_ms);
 
     event_manager_.RecordEvent(instr_node, place_);
     op_run_number_.fetch_add(1, std::memory_order_relaxed);
 
     // GC infomation
+    uint64_t gc_start_ns = platform::PosixInNsec();
     CheckGC(instr_id, instr_node.gc_check_var_list);
+    stat.total_gc_ms += (platform::PosixInNsec() - gc_start_ns) / 1000000.0;
 
     RunNextInstructions(instr_node, &ready_ops);
   }
@@ -48,6 +48,12 @@ class InterpreterCore {
 
   const CostInfo& DryRun(const std::vector<framework::Tensor>& feed_tensors);
 
+  // per-instruction run count, run time, queue delay and GC time collected
+  // since this core was built, indexed by instruction id
+  const std::vector<InstructionStat>& InstructionStats() const {
+    return instruction_stats_;
+  }
+
  private:
   void Convert();
 
@@ -100,6 +106,11 @@ class InterpreterCore {
   InterpreterCoreGarbageCollector gc_;
   std::vector<paddle::platform::DeviceEvent> gc_event_;
   std::atomic<size_t> op_run_number_{0};
+
+  std::vector<InstructionStat> instruction_stats_;
+  // the moment each instruction became ready, used for the queue delay; the
+  // work queue task handoff orders the write before the read
+  std::vector<uint64_t> instruction_ready_ns_;
 };
 }  // namespace framework
 }  // namespace paddle
@@ -14,6 +14,12 @@
 
 #include "paddle/fluid/framework/new_executor/interpretercore_garbage_collector.h"
 #include "paddle/fluid/framework/garbage_collector.h"
+#include "paddle/fluid/platform/flags.h"
+
+PADDLE_DEFINE_EXPORTED_bool(
+    new_executor_deferred_gc, false,
+    "Batch deletion candidates into an epoch list and reclaim them on the "
+    "collector thread between steps instead of in the op completion path");
 
 namespace paddle {
 namespace framework {
@@ -22,6 +28,7 @@ InterpreterCoreGarbageCollector::InterpreterCoreGarbageCollector() {
   garbages_.reset(new GarbageQueue());
   max_memory_size_ = static_cast<size_t>(GetEagerDeletionThreshold());
   cur_memory_size_ = 0;
+  deferred_ = FLAGS_new_executor_deferred_gc;
 
   WorkQueueOptions options(/*num_threads*/ 1, /*allow_spinning*/ true,
                            /*track_task*/ false);
@@ -31,6 +38,17 @@ InterpreterCoreGarbageCollector::InterpreterCoreGarbageCollector() {
 void InterpreterCoreGarbageCollector::Add(
     std::shared_ptr<memory::Allocation> garbage,
     paddle::platform::DeviceEvent& event, const platform::DeviceContext* ctx) {
+  if (deferred_) {
+    if (!garbage) return;
+    // Only record the completion event here; the actual free happens in
+    // ReclaimEpoch() between steps.
+    event.Record(ctx);
+    event.SetFininshed();  // Only for CPU Event
+    std::lock_guard<paddle::memory::SpinLock> guard(spinlock_);
+    epoch_garbages_.push_back(std::move(garbage));
+    epoch_events_.push_back(&event);
+    return;
+  }
   if (max_memory_size_ <= 1) {
     Free(garbage, event, ctx);
   } else {
@@ -73,6 +91,39 @@ void InterpreterCoreGarbageCollector::Add(paddle::framework::Variable* var,
   }
 }
 
+void InterpreterCoreGarbageCollector::ReclaimEpoch() {
+  if (!deferred_) {
+    return;
+  }
+  GarbageQueue* garbages = nullptr;
+  std::vector<paddle::platform::DeviceEvent*>* events = nullptr;
+  {
+    std::lock_guard<paddle::memory::SpinLock> guard(spinlock_);
+    if (epoch_garbages_.empty()) {
+      return;
+    }
+    garbages = new GarbageQueue(std::move(epoch_garbages_));
+    events = new std::vector<paddle::platform::DeviceEvent*>(
+        std::move(epoch_events_));
+    epoch_garbages_.clear();
+    epoch_events_.clear();
+  }
+  queue_->AddTask([garbages, events]() {
+    for (auto* event : *events) {
+      while (!event->Query()) {
+#if defined(_WIN32)
+        SleepEx(50, FALSE);
+#else
+        sched_yield();
+#endif
+        continue;
+      }
+    }
+    delete garbages;
+    delete events;
+  });
+}
+
 void InterpreterCoreGarbageCollector::Free(GarbageQueue* garbages,
                                            paddle::platform::DeviceEvent& event,
                                            const platform::DeviceContext* ctx) {
@@ -43,6 +43,12 @@ class InterpreterCoreGarbageCollector {
            paddle::platform::DeviceEvent& event,  // NOLINT
            const platform::DeviceContext* ctx);
 
+  // In deferred mode (FLAGS_new_executor_deferred_gc) Add() only appends the
+  // garbage to the current epoch; this hands the whole epoch to the
+  // collector thread. Called between steps so op completion never pays for
+  // frees. No-op when deferred mode is off.
+  void ReclaimEpoch();
+
   DISABLE_COPY_AND_ASSIGN(InterpreterCoreGarbageCollector);
 
  private:
@@ -59,6 +65,9 @@ class InterpreterCoreGarbageCollector {
   size_t cur_memory_size_;
   std::unique_ptr<WorkQueue> queue_;
   paddle::memory::SpinLock spinlock_;
+  bool deferred_;
+  GarbageQueue epoch_garbages_;
+  std::vector<paddle::platform::DeviceEvent*> epoch_events_;
 };
 }  // namespace framework
 }  // namespace paddle
@@ -523,6 +523,21 @@ struct Instruction {
   OpFuncType type_;
 
   std::vector<std::pair<Variable*, Variable*>> vec_inplace_in_to_out_;
+
+  // Input shape signature observed by the previous step together with the
+  // output dims/LoD that InferShape produced for it. When the signature
+  // repeats, RunInstruction() restores the cached outputs and skips
+  // InferShape entirely. cacheable_ turns false once a non-LoDTensor
+  // input/output is seen, which forces the full InferShape path.
+  struct ShapeSignature {
+    bool valid_{false};
+    bool cacheable_{true};
+    std::vector<DDim> input_dims_;
+    std::vector<LoD> input_lods_;
+    std::vector<DDim> output_dims_;
+    std::vector<LoD> output_lods_;
+  };
+  mutable ShapeSignature shape_signature_;
 };
 
 struct OpFuncNode {
@@ -11,6 +11,7 @@
 
 #include <atomic>
 #include <cstdlib>
+#include <functional>
 #include <vector>
 #include "paddle/fluid/framework/new_executor/event_count.h"
 #include "paddle/fluid/framework/new_executor/run_queue.h"
@@ -67,9 +68,13 @@ class ThreadPoolTempl {
   typedef typename Environment::Task Task;
   typedef RunQueue<Task, 1024> Queue;
 
+  // on_thread_start, when provided, runs once on every worker thread before
+  // it starts processing tasks (e.g. to set CPU affinity).
   ThreadPoolTempl(int num_threads, bool allow_spinning,
+                  std::function<void(int)> on_thread_start = nullptr,
                   Environment env = Environment())
       : env_(env),
+        on_thread_start_(std::move(on_thread_start)),
         allow_spinning_(allow_spinning),
         global_steal_partition_(EncodePartition(0, num_threads_)),
         blocked_(0),
@@ -264,6 +269,7 @@ class ThreadPoolTempl {
   };
 
   Environment env_;
+  std::function<void(int)> on_thread_start_;
   const bool allow_spinning_;
   std::vector<std::vector<unsigned>> all_coprimes_;
   unsigned global_steal_partition_;
@@ -278,6 +284,9 @@ class ThreadPoolTempl {
 
   // Main worker thread loop.
   void WorkerLoop(int thread_id) {
+    if (on_thread_start_) {
+      on_thread_start_(thread_id);
+    }
     PerThread* pt = GetPerThread();
     pt->pool = this;
     pt->rand = GlobalThreadIdHash();
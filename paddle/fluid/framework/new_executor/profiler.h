@@ -13,6 +13,10 @@
 // limitations under the License.
 
 #pragma once
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include "paddle/fluid/framework/tensor.h"
 #include "paddle/fluid/framework/variable.h"
 #include "paddle/fluid/platform/gpu_info.h"
@@ -68,6 +72,47 @@ struct CostInfo {
   size_t device_memory_bytes{0};  // total allocated memory size
 };
 
+// Runtime statistics of one instruction, accumulated over interpreter steps.
+// An instruction runs at most once per step and two steps never overlap, so
+// one slot is never written concurrently and needs no synchronization.
+struct InstructionStat {
+  // size of the ring of recent run times kept for percentile estimation
+  static constexpr size_t kMaxSamples = 512;
+
+  std::string op_type;
+  size_t run_count{0};
+  double total_run_ms{0.};    // InferShape + kernel launch time
+  double total_queue_ms{0.};  // time between ready and picked up by a worker
+  double total_gc_ms{0.};     // time spent collecting unused variables
+
+  void AddRunSample(double run_ms) {
+    if (run_samples_.size() < kMaxSamples) {
+      run_samples_.push_back(run_ms);
+    } else {
+      run_samples_[next_sample_ % kMaxSamples] = run_ms;
+    }
+    ++next_sample_;
+  }
+
+  double MeanRunMs() const {
+    return run_count == 0 ? 0. : total_run_ms / run_count;
+  }
+
+  // Estimate the p-th run time percentile (p in [0, 1]) from the recent
+  // samples, e.g. PercentileRunMs(0.99) for the p99 latency.
+  double PercentileRunMs(double p) const {
+    if (run_samples_.empty()) return 0.;
+    std::vector<double> sorted = run_samples_;
+    std::sort(sorted.begin(), sorted.end());
+    size_t idx = static_cast<size_t>(p * (sorted.size() - 1));
+    return sorted[idx];
+  }
+
+ private:
+  std::vector<double> run_samples_;
+  size_t next_sample_{0};
+};
+
 class InterpreterProfiler {
  public:
   void Start() { timer_.Start(); }
@@ -70,6 +70,15 @@ const CostInfo& StandaloneExecutor::DryRun(
   return cost_info;
 }
 
+std::vector<InstructionStat> StandaloneExecutor::GetInstructionStats() {
+  std::vector<InstructionStat> result;
+  for (auto& item : interpretercores_) {
+    const auto& stats = item.second->InstructionStats();
+    result.insert(result.end(), stats.begin(), stats.end());
+  }
+  return result;
+}
+
 void StandaloneExecutor::BuildVariableOuterScope(
     const framework::ProgramDesc& pdesc, VariableScope* var_scope,
     Scope* outer_scope) {
@@ -48,6 +48,10 @@ class StandaloneExecutor : public ExecutorBase {
   const CostInfo& DryRun(const std::vector<std::string>& feed_names,
                          const std::vector<framework::Tensor>& feed_tensors);
 
+  // collect the per-instruction statistics of every interpreter core built
+  // so far
+  std::vector<InstructionStat> GetInstructionStats();
+
  private:
   void BuildVariableOuterScope(const framework::ProgramDesc& pdesc,
                                VariableScope* var_scope, Scope* outer_scope);
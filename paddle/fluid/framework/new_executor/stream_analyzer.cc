@@ -13,7 +13,14 @@
 // limitations under the License.
 
 #include "paddle/fluid/framework/new_executor/stream_analyzer.h"
+#include <unordered_map>
 #include <unordered_set>
+#include "paddle/fluid/platform/flags.h"
+
+PADDLE_DEFINE_EXPORTED_bool(
+    new_executor_multi_stream, false,
+    "Run independent device op chains on a small pool of compute streams "
+    "in the new executor");
 
 namespace paddle {
 namespace framework {
@@ -113,6 +120,70 @@ platform::DeviceContext* StreamAnalyzer::ParseDeviceContext(
   return dev_ctx;
 }
 
+platform::DeviceContext* StreamAnalyzer::ParseDeviceContext(
+    const OpFuncNode& op_func_node, const OperatorBase& op_base,
+    size_t stream_hint) {
+  auto* dev_ctx = ParseDeviceContext(op_func_node, op_base);
+  // Chain 0 keeps the default stream; memcpy ops already run on their
+  // dedicated transfer streams.
+  if (stream_hint == 0 || op_func_node.type_ != OpFuncType::kQueueAsync ||
+      dev_ctx != op_func_node.dev_ctx_ || !platform::is_gpu_place(place_)) {
+    return dev_ctx;
+  }
+  size_t pool_idx = (stream_hint - 1) % kNumComputeStreams;
+  while (compute_ctx_pools_.size() <= pool_idx) {
+    compute_ctx_pools_.emplace_back(
+        new platform::DeviceContextPool(std::vector<platform::Place>{place_}));
+  }
+  VLOG(3) << op_base.Type() << " runs on compute stream " << pool_idx;
+  return compute_ctx_pools_[pool_idx]->Get(place_);
+}
+
+std::vector<size_t> StreamAnalyzer::PartitionComputeChains(
+    const std::vector<OpFuncNode>& op_func_nodes) {
+  std::vector<size_t> chain_ids(op_func_nodes.size(), 0);
+  if (!FLAGS_new_executor_multi_stream || !platform::is_gpu_place(place_)) {
+    return chain_ids;
+  }
+  std::unordered_map<size_t, size_t> var_producer;
+  std::vector<bool> chain_extended(op_func_nodes.size(), false);
+  size_t num_chains = 0;
+  for (size_t i = 0; i < op_func_nodes.size(); ++i) {
+    const auto& node = op_func_nodes[i];
+    if (node.type_ == OpFuncType::kQueueAsync) {
+      int64_t inherited = -1;
+      for (auto& item : node.input_index) {
+        for (auto var_id : item.second) {
+          auto it = var_producer.find(var_id);
+          if (it == var_producer.end()) {
+            continue;
+          }
+          size_t producer = it->second;
+          if (op_func_nodes[producer].type_ == OpFuncType::kQueueAsync &&
+              !chain_extended[producer]) {
+            inherited = static_cast<int64_t>(chain_ids[producer]);
+            chain_extended[producer] = true;
+            break;
+          }
+        }
+        if (inherited >= 0) {
+          break;
+        }
+      }
+      chain_ids[i] = inherited >= 0 ? static_cast<size_t>(inherited)
+                                    : num_chains++;
+    }
+    for (auto& item : node.output_index) {
+      for (auto var_id : item.second) {
+        var_producer[var_id] = i;
+      }
+    }
+  }
+  VLOG(3) << "Partitioned " << op_func_nodes.size() << " ops into "
+          << num_chains << " compute chains";
+  return chain_ids;
+}
+
 /*
  * NOTE(dev): The following cases are considered as directly run:
  *
@@ -35,7 +35,24 @@ class StreamAnalyzer {
   platform::DeviceContext* ParseDeviceContext(const OpFuncNode& op_func_node,
                                               const OperatorBase& op_base);
 
+  // Multi-stream variant: ops whose stream_hint maps to a secondary compute
+  // stream get a device context from the compute pool, so independent
+  // chains overlap on the GPU. Schedule() then inserts DeviceEvent
+  // dependencies at the cross-stream join points as usual.
+  platform::DeviceContext* ParseDeviceContext(const OpFuncNode& op_func_node,
+                                              const OperatorBase& op_base,
+                                              size_t stream_hint);
+
+  // Partitions async (device) ops into producer-consumer chains. Each op
+  // inherits the chain of the first producer that has not been extended
+  // yet; ops starting a new branch open a new chain. Returns one chain id
+  // per op; all ids are 0 when multi-stream execution is disabled.
+  std::vector<size_t> PartitionComputeChains(
+      const std::vector<OpFuncNode>& op_func_nodes);
+
  private:
+  static constexpr size_t kNumComputeStreams = 4;
+
   std::vector<size_t> ParseEventVarIds(const Instruction& cur_instr,
                                        const Instruction& next_instr);
 
@@ -51,6 +68,8 @@ class StreamAnalyzer {
   platform::Place place_;
   platform::DeviceContextPool d2h_ctx_pool_;
   platform::DeviceContextPool h2d_ctx_pool_;
+  // Lazily created pools backing the secondary compute streams.
+  std::vector<std::unique_ptr<platform::DeviceContextPool>> compute_ctx_pools_;
   std::map<size_t, std::shared_ptr<platform::DeviceEvent>> var_id2event_;
 };
 
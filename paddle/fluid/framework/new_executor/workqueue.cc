@@ -13,6 +13,26 @@ namespace paddle {
 namespace framework {
 namespace {
 
+// Splits num_threads contiguously across NUMA nodes. Returns one
+// [start, end) thread-index range per node, or an empty vector when NUMA
+// partitioning is not worthwhile (single node or fewer threads than nodes).
+std::vector<std::pair<unsigned, unsigned>> ComputeNumaPartitions(
+    size_t num_threads) {
+  size_t num_nodes = GetNumaNodeCount();
+  if (num_nodes < 2 || num_threads < num_nodes) {
+    return {};
+  }
+  std::vector<std::pair<unsigned, unsigned>> partitions;
+  size_t start = 0;
+  for (size_t node = 0; node < num_nodes; ++node) {
+    size_t count = num_threads / num_nodes + (node < num_threads % num_nodes);
+    partitions.emplace_back(static_cast<unsigned>(start),
+                            static_cast<unsigned>(start + count));
+    start += count;
+  }
+  return partitions;
+}
+
 class WorkQueueImpl : public WorkQueue {
  public:
   explicit WorkQueueImpl(const WorkQueueOptions& options)
@@ -21,8 +41,37 @@ class WorkQueueImpl : public WorkQueue {
       void* storage = AlignedMalloc(sizeof(TaskTracker), alignof(TaskTracker));
       tracker_ = new (storage) TaskTracker;
     }
+    std::function<void(int)> on_thread_start = nullptr;
+    if (options_.numa_aware) {
+      numa_partitions_ = ComputeNumaPartitions(options_.num_threads);
+    }
+    if (!numa_partitions_.empty()) {
+      auto partitions = numa_partitions_;
+      on_thread_start = [partitions](int thread_id) {
+        for (size_t node = 0; node < partitions.size(); ++node) {
+          if (static_cast<unsigned>(thread_id) < partitions[node].second) {
+            BindCurrentThreadToNumaNode(node);
+            return;
+          }
+        }
+      };
+    }
     queue_ = new NonblockingThreadPool(options_.num_threads,
-                                       options_.allow_spinning);
+                                       options_.allow_spinning,
+                                       std::move(on_thread_start));
+    if (!numa_partitions_.empty()) {
+      // Local steal stays inside the thread's node; cross-node stealing
+      // happens only through the global steal pass once the local queues
+      // are empty.
+      std::vector<std::pair<unsigned, unsigned>> per_thread;
+      per_thread.reserve(options_.num_threads);
+      for (const auto& partition : numa_partitions_) {
+        for (unsigned i = partition.first; i < partition.second; ++i) {
+          per_thread.push_back(partition);
+        }
+      }
+      queue_->SetStealPartitions(per_thread);
+    }
   }
 
   virtual ~WorkQueueImpl() {
@@ -44,6 +93,23 @@ class WorkQueueImpl : public WorkQueue {
     queue_->AddTask(std::move(fn));
   }
 
+  void AddTask(std::function<void()> fn, size_t preferred_numa_node) override {
+    if (preferred_numa_node >= numa_partitions_.size()) {
+      AddTask(std::move(fn));
+      return;
+    }
+    if (tracker_ != nullptr) {
+      fn = [
+        task = std::move(fn), raii = CounterGuard<TaskTracker>(tracker_)
+      ]() mutable {
+        task();
+      };
+    }
+    const auto& partition = numa_partitions_[preferred_numa_node];
+    queue_->AddTaskWithHint(std::move(fn), static_cast<int>(partition.first),
+                            static_cast<int>(partition.second));
+  }
+
   void WaitQueueEmpty() override {
     if (tracker_ == nullptr) {
       PADDLE_THROW(
@@ -58,6 +124,8 @@ class WorkQueueImpl : public WorkQueue {
  private:
   NonblockingThreadPool* queue_;
   TaskTracker* tracker_;
+  // One [start, end) worker range per NUMA node; empty when not NUMA-aware.
+  std::vector<std::pair<unsigned, unsigned>> numa_partitions_;
 };
 
 class WorkQueueGroupImpl : public WorkQueueGroup {
@@ -27,9 +27,20 @@ struct WorkQueueOptions {
         allow_spinning(allow_spinning),
         track_task(track_task) {}
 
+  WorkQueueOptions(size_t num_threads, bool allow_spinning, bool track_task,
+                   bool numa_aware)
+      : num_threads(num_threads),
+        allow_spinning(allow_spinning),
+        track_task(track_task),
+        numa_aware(numa_aware) {}
+
   size_t num_threads;
   bool allow_spinning;
   bool track_task;
+  // Pin worker threads to NUMA nodes and keep work stealing inside a node
+  // until its queues are empty. Only effective on hosts with more than one
+  // node and num_threads >= number of nodes.
+  bool numa_aware{false};
 };
 
 class WorkQueue {
@@ -44,6 +55,13 @@ class WorkQueue {
 
   virtual void AddTask(std::function<void()> fn) = 0;
 
+  // Like AddTask, but prefer running on workers of the given NUMA node
+  // (e.g. the node owning the tensors the task touches). The hint is
+  // ignored when the queue is not NUMA-aware.
+  virtual void AddTask(std::function<void()> fn, size_t preferred_numa_node) {
+    AddTask(std::move(fn));
+  }
+
   // set WorkQueueOptions.track_task = true before call this
   // interface, otherwise will abort()
   virtual void WaitQueueEmpty() = 0;
@@ -15,6 +15,14 @@
 #include "paddle/fluid/framework/new_executor/workqueue_utils.h"
 #include <cstdint>
 #include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#if defined(__linux__)
+#include <sched.h>
+#endif
+#include "paddle/fluid/platform/cpu_info.h"
 
 namespace paddle {
 namespace framework {
@@ -43,6 +51,81 @@ void* AlignedMalloc(size_t size, size_t alignment) {
 #endif
 }
 
+namespace {
+
+// Parses a cpulist string like "0-3,8-11" into cpu ids.
+std::vector<int> ParseCpuList(const std::string& cpulist) {
+  std::vector<int> cpus;
+  std::stringstream ss(cpulist);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    size_t dash = range.find('-');
+    if (dash == std::string::npos) {
+      cpus.push_back(std::stoi(range));
+    } else {
+      int begin = std::stoi(range.substr(0, dash));
+      int end = std::stoi(range.substr(dash + 1));
+      for (int cpu = begin; cpu <= end; ++cpu) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+  return cpus;
+}
+
+std::vector<std::vector<int>> DetectNumaNodeCpus() {
+  std::vector<std::vector<int>> nodes;
+#if defined(__linux__)
+  for (size_t node = 0;; ++node) {
+    std::ifstream cpulist_file("/sys/devices/system/node/node" +
+                               std::to_string(node) + "/cpulist");
+    if (!cpulist_file.is_open()) {
+      break;
+    }
+    std::string cpulist;
+    std::getline(cpulist_file, cpulist);
+    if (cpulist.empty()) {
+      continue;
+    }
+    nodes.push_back(ParseCpuList(cpulist));
+  }
+#endif
+  if (nodes.empty()) {
+    // Unknown topology: treat the machine as one node with all CPUs.
+    std::vector<int> all_cpus;
+    size_t num_cpus = platform::CpuAvailableCoreCount();
+    for (size_t cpu = 0; cpu < num_cpus; ++cpu) {
+      all_cpus.push_back(static_cast<int>(cpu));
+    }
+    nodes.push_back(std::move(all_cpus));
+  }
+  return nodes;
+}
+
+}  // namespace
+
+const std::vector<std::vector<int>>& GetNumaNodeCpus() {
+  static const std::vector<std::vector<int>> nodes = DetectNumaNodeCpus();
+  return nodes;
+}
+
+size_t GetNumaNodeCount() { return GetNumaNodeCpus().size(); }
+
+void BindCurrentThreadToNumaNode(size_t node) {
+#if defined(__linux__)
+  const auto& nodes = GetNumaNodeCpus();
+  if (node >= nodes.size() || nodes[node].empty()) {
+    return;
+  }
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  for (int cpu : nodes[node]) {
+    CPU_SET(cpu, &cpuset);
+  }
+  sched_setaffinity(0, sizeof(cpuset), &cpuset);
+#endif
+}
+
 void AlignedFree(void* mem_ptr) {
 #if defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200112L
   free(mem_ptr);
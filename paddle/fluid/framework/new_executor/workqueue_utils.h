@@ -18,6 +18,7 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdlib>
+#include <vector>
 #include "paddle/fluid/platform/enforce.h"
 
 namespace paddle {
@@ -64,5 +65,16 @@ void* AlignedMalloc(size_t size, size_t alignment);
 
 void AlignedFree(void* memory_ptr);
 
+// NUMA topology helpers used by the NUMA-aware WorkQueue mode. On platforms
+// that do not expose the topology there is a single node covering all CPUs.
+size_t GetNumaNodeCount();
+
+// CPU ids grouped by NUMA node, indexed by node id.
+const std::vector<std::vector<int>>& GetNumaNodeCpus();
+
+// Restrict the calling thread to the CPUs of the given node. No-op when the
+// topology is unknown or the node id is out of range.
+void BindCurrentThreadToNumaNode(size_t node);
+
 }  // namespace framework
 }  // namespace paddle
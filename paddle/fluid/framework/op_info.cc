@@ -14,6 +14,8 @@ limitations under the License. */
 
 #include "paddle/fluid/framework/op_info.h"
 
+#include <mutex>  // NOLINT
+
 namespace paddle {
 namespace framework {
 
@@ -25,6 +27,31 @@ OpInfoMap& OpInfoMap::Instance() {
   return g_op_info_map;
 }
 
+void OpInfoMap::MaterializeIfNeeded(OpInfo* info) const {
+  // Materialization happens at most once per op type over the process
+  // lifetime, one global mutex is enough.
+  static std::mutex materialize_mtx;
+  std::lock_guard<std::mutex> guard(materialize_mtx);
+  if (info->materialized_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  if (info->deferred_proto_and_checker_filler_ != nullptr) {
+    // Clear the stub before running it so a throwing maker surfaces its
+    // error once instead of on every lookup.
+    auto filler = std::move(info->deferred_proto_and_checker_filler_);
+    info->deferred_proto_and_checker_filler_ = nullptr;
+    filler(info);
+  }
+  // Publish the proto_/checker_ writes to lock-free readers.
+  info->materialized_.store(true, std::memory_order_release);
+}
+
+void OpInfoMap::MaterializeAllOpInfos() {
+  for (auto& pair : map_) {
+    MaterializeIfNeeded(&pair.second);
+  }
+}
+
 std::vector<std::string> OpInfoMap::GetUseDefaultGradOpDescMakerOps() const {
   // Use set to sort op names
   std::set<std::string> result_ops;
@@ -13,6 +13,7 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #pragma once
+#include <atomic>
 #include <functional>
 #include <map>
 #include <string>
@@ -38,6 +39,29 @@ class InferShapeBase {
   virtual void operator()(InferShapeContext*) const = 0;
 };
 
+// Atomic flag that is copyable: OpInfo objects are inserted into OpInfoMap
+// by value during single-threaded static registration, before any concurrent
+// lookup can happen, so plain-load copies are safe.
+class CopyableAtomicBool {
+ public:
+  CopyableAtomicBool() = default;
+  CopyableAtomicBool(const CopyableAtomicBool& other)
+      : value_(other.value_.load(std::memory_order_relaxed)) {}
+  CopyableAtomicBool& operator=(const CopyableAtomicBool& other) {
+    value_.store(other.value_.load(std::memory_order_relaxed),
+                 std::memory_order_relaxed);
+    return *this;
+  }
+
+  bool load(std::memory_order order) const { return value_.load(order); }
+  void store(bool value, std::memory_order order) {
+    value_.store(value, order);
+  }
+
+ private:
+  std::atomic<bool> value_{false};
+};
+
 class OpInfo {
  public:
   OpCreator creator_;
@@ -58,6 +82,21 @@ class OpInfo {
   // the grad maker is the empty one.
   bool use_empty_grad_op_desc_maker_{false};
 
+  // Deferred construction of proto_ and checker_. Running the
+  // OpProtoAndCheckerMaker is by far the most expensive part of registering
+  // an operator (protobuf messages plus one std::function per attribute
+  // checker), so the registrar only records this stub at static
+  // initialization time and OpInfoMap runs it on the first lookup of the op
+  // type. Null once the proto and checker have been materialized.
+  std::function<void(OpInfo*)> deferred_proto_and_checker_filler_;
+
+  // Set with release semantics after proto_/checker_ are filled (or found
+  // not to need filling) and read with acquire on the lookup fast path, so
+  // lock-free readers that observe it also observe the proto_/checker_
+  // writes. The std::function above must only be touched under the
+  // materialization mutex.
+  CopyableAtomicBool materialized_;
+
   bool HasOpProtoAndChecker() const {
     return proto_ != nullptr && checker_ != nullptr;
   }
@@ -156,11 +195,19 @@ class OpInfoMap {
     auto it = map_.find(type);
     if (it == map_.end()) {
       return nullptr;
-    } else {
-      return &it->second;
     }
+    if (UNLIKELY(!it->second.materialized_.load(std::memory_order_acquire))) {
+      // The map itself is not const, only this accessor is.
+      MaterializeIfNeeded(const_cast<OpInfo*>(&it->second));
+    }
+    return &it->second;
   }
 
+  // Run the deferred proto/checker fillers of every registered op type, for
+  // callers that enumerate all op protos instead of looking types up one by
+  // one (e.g. core.get_all_op_protos).
+  void MaterializeAllOpInfos();
+
   const paddle::flat_hash_map<std::string, OpInfo>& map() const { return map_; }
 
   paddle::flat_hash_map<std::string, OpInfo>* mutable_map() { return &map_; }
@@ -169,6 +216,9 @@ class OpInfoMap {
 
  private:
   OpInfoMap() = default;
+
+  void MaterializeIfNeeded(OpInfo* info) const;
+
   paddle::flat_hash_map<std::string, OpInfo> map_;
 
   DISABLE_COPY_AND_ASSIGN(OpInfoMap);
@@ -15,6 +15,8 @@ limitations under the License. */
 #include "paddle/fluid/framework/operator.h"
 
 #include <glog/logging.h>
+#include <algorithm>
+#include <chrono>  // NOLINT
 #include <sstream>
 #include <string>
 
@@ -28,6 +30,7 @@ limitations under the License. */
 #include "paddle/fluid/framework/unused_var_check.h"
 #include "paddle/fluid/framework/var_type.h"
 #include "paddle/fluid/platform/enforce.h"
+#include "paddle/fluid/platform/op_latency_stats.h"
 #include "paddle/fluid/platform/profiler.h"
 
 namespace paddle {
@@ -47,6 +50,7 @@ class LoDTensor;
 DECLARE_bool(benchmark);
 DECLARE_bool(check_nan_inf);
 DECLARE_bool(enable_unused_var_check);
+DECLARE_bool(op_latency_stats);
 PADDLE_DEFINE_EXPORTED_int32(inner_op_parallelism, 0,
                              "number of threads for inner op");
 
@@ -235,7 +239,18 @@ void OperatorBase::Run(const Scope& scope, const platform::Place& place) {
       auto op_name = platform::OpName(outputs_, Type());
       platform::RecordEvent op_name_record_event(
           op_name, platform::EventRole::kUniqueOp);
-      RunImpl(scope, place);
+      if (FLAGS_op_latency_stats) {
+        auto start = std::chrono::steady_clock::now();
+        RunImpl(scope, place);
+        auto latency_ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start)
+                .count();
+        platform::OpLatencyRegistry::Instance().Record(
+            Type(), static_cast<uint64_t>(latency_ns));
+      } else {
+        RunImpl(scope, place);
+      }
     }
 
     VLOG(3) << GetExecutionPlace(place) << " " << DebugStringEx(&scope);
@@ -254,6 +269,31 @@ void OperatorBase::Run(const Scope& scope, const platform::Place& place) {
   }
 }
 
+const Attribute& OperatorBase::GetInternedAttr(
+    const InternedAttrName& name) const {
+  if (UNLIKELY(interned_attr_table_.empty() && !attrs_.empty())) {
+    interned_attr_table_.reserve(attrs_.size());
+    for (auto& pair : attrs_) {
+      interned_attr_table_.emplace_back(InternedAttrName(pair.first).id(),
+                                        &pair.second);
+    }
+    std::sort(interned_attr_table_.begin(), interned_attr_table_.end());
+  }
+  // Operators carry a handful of attributes, a linear scan over the sorted
+  // integer ids beats both hashing and binary search dispatch here.
+  for (auto& pair : interned_attr_table_) {
+    if (pair.first == name.id()) {
+      return *pair.second;
+    }
+    if (pair.first > name.id()) {
+      break;
+    }
+  }
+  PADDLE_THROW(platform::errors::NotFound(
+      "(%s) is not found in AttributeMap of operator %s.", name.name(),
+      Type()));
+}
+
 bool OperatorBase::HasInputs(const std::string& name) const {
   return inputs_.find(name) != inputs_.end();
 }
@@ -1163,6 +1203,11 @@ void OperatorWithKernel::RunImpl(const Scope& scope,
         ExecutionContext(*this, exec_scope, *dev_ctx, *runtime_ctx));
   }
 
+  if (platform::is_cpu_place(dev_ctx->GetPlace())) {
+    // Scratch workspace memory handed out during this kernel is dead now.
+    static_cast<platform::CPUDeviceContext*>(dev_ctx)->ResetWorkspace();
+  }
+
   if (!transfered_inplace_vars.empty()) {
     // there is inplace variable has been transferred.
     TransferInplaceVarsBack(scope, transfered_inplace_vars, *transfer_scope);
@@ -1214,16 +1259,20 @@ void OperatorWithKernel::ChooseKernel(const RuntimeContext& ctx,
   platform::DeviceContextPool& pool = platform::DeviceContextPool::Instance();
   auto* dev_ctx = pool.Get(place);
 
-  // check if op[type] has kernel registered.
-  auto& all_op_kernels = AllOpKernels();
-  auto kernels_iter = all_op_kernels.find(type_);
-  PADDLE_ENFORCE_NE(
-      kernels_iter, all_op_kernels.end(),
-      platform::errors::Unavailable(
-          "There are no kernels which are registered in the %s operator.",
-          type_));
+  // check if op[type] has kernel registered. The map node is stable after
+  // registration, so the lookup result is cached per operator instance.
+  if (kernels_map_cache_ == nullptr) {
+    auto& all_op_kernels = AllOpKernels();
+    auto kernels_iter = all_op_kernels.find(type_);
+    PADDLE_ENFORCE_NE(
+        kernels_iter, all_op_kernels.end(),
+        platform::errors::Unavailable(
+            "There are no kernels which are registered in the %s operator.",
+            type_));
+    kernels_map_cache_ = &kernels_iter->second;
+  }
 
-  OpKernelMap& kernels = kernels_iter->second;
+  OpKernelMap& kernels = *kernels_map_cache_;
 
   auto expected_kernel_key = this->GetExpectedKernelType(
       ExecutionContext(*this, scope, *dev_ctx, ctx));
@@ -1257,6 +1306,21 @@ void OperatorWithKernel::ChooseKernel(const RuntimeContext& ctx,
   VLOG(3) << "op type:" << type_
           << ", expected_kernel_key:" << expected_kernel_key;
 
+  // Fast path: the kernel for this (place, data type, layout) combination has
+  // already been resolved by a previous run, so the library/place fallback
+  // logic below does not need to be replayed.
+  {
+    std::lock_guard<std::mutex> lock(cache_update_mutex_);
+    for (auto& cached : kernel_selection_cache_) {
+      if (cached.expected_key_ == expected_kernel_key) {
+        kernel_type_.reset(new OpKernelType(cached.resolved_key_));
+        kernel_func_.reset(new OpKernelFunc(cached.func_));
+        return;
+      }
+    }
+  }
+  const OpKernelType lookup_kernel_key = expected_kernel_key;
+
   auto kernel_iter = kernels.find(expected_kernel_key);
 #ifdef PADDLE_WITH_MKLDNN
   // workaround for missing MKLDNN kernel when FLAGS_use_mkldnn env var is set
@@ -1296,6 +1360,8 @@ void OperatorWithKernel::ChooseKernel(const RuntimeContext& ctx,
                         KernelTypeToString(expected_kernel_key)));
 
   std::lock_guard<std::mutex> lock(cache_update_mutex_);
+  kernel_selection_cache_.push_back(
+      {lookup_kernel_key, expected_kernel_key, kernel_iter->second});
   if (kernel_type_.get() == nullptr || kernel_func_.get() == nullptr) {
     kernel_type_.reset(new OpKernelType(expected_kernel_key));
     kernel_func_.reset(new OpKernelFunc(kernel_iter->second));
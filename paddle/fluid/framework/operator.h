@@ -162,11 +162,20 @@ class OperatorBase {
   bool HasAttr(const std::string& name) const { return attrs_.count(name); }
   template <typename T>
   inline const T& Attr(const std::string& name) const {
+    auto it = attrs_.find(name);
     PADDLE_ENFORCE_NE(
-        attrs_.find(name), attrs_.end(),
+        it, attrs_.end(),
         platform::errors::NotFound("(%s) is not found in AttributeMap.", name));
-    return BOOST_GET_CONST(T, attrs_.at(name));
+    return BOOST_GET_CONST(T, it->second);
   }
+  // Fast path for hot attribute reads: resolves through the interned id of
+  // `name` with an integer search over this operator's few attributes
+  // instead of hashing the name.
+  template <typename T>
+  inline const T& Attr(const InternedAttrName& name) const {
+    return BOOST_GET_CONST(T, GetInternedAttr(name));
+  }
+  const Attribute& GetInternedAttr(const InternedAttrName& name) const;
   void SetAttr(const std::string& name, const Attribute& v) {
     PADDLE_ENFORCE_EQ(
         HasAttr(name), true,
@@ -174,6 +183,9 @@ class OperatorBase {
             "The attribute %s is not found in operator %s", name, Type()));
 
     attrs_[name] = v;
+    // the interned lookup table holds pointers into attrs_, rebuild it on
+    // the next interned access
+    interned_attr_table_.clear();
   }
   const AttributeMap& Attrs() const { return attrs_; }
 
@@ -234,6 +246,12 @@ class OperatorBase {
   // Whether this operator executes in an Executor.
   bool run_by_executor_{true};
 
+  // (interned id, attribute) pairs sorted by id, built lazily on the first
+  // interned attribute access. Mutable like the other per-instance caches,
+  // an operator instance is not run from several threads at once.
+  mutable std::vector<std::pair<size_t, const Attribute*>>
+      interned_attr_table_;
+
  private:
   void GenerateTemporaryNames();
   void CheckAllInputOutputSet() const;
@@ -281,6 +299,18 @@ class ExecutionContext {
     return op_.Attrs().at(name);
   }
 
+  // Interned fast path, see InternedAttrName. Contexts that carry their own
+  // attribute maps (e.g. the dygraph one) override this with a plain string
+  // lookup on those maps.
+  template <typename T>
+  inline const T& Attr(const InternedAttrName& name) const {
+    return BOOST_GET_CONST(T, GetAttr(name));
+  }
+
+  virtual const Attribute& GetAttr(const InternedAttrName& name) const {
+    return op_.GetInternedAttr(name);
+  }
+
   virtual bool HasInput(const std::string& name) const;
 
   virtual bool HasOutput(const std::string& name) const;
@@ -568,8 +598,21 @@ class OperatorWithKernel : public OperatorBase {
                                    const std::string& name) const;
 
  protected:
+  // Cached result of one kernel selection. expected_key_ is the key computed
+  // from GetExpectedKernelType() before any library/place fallback was
+  // applied, so steady-state runs can resolve the kernel with one comparison
+  // instead of re-walking AllOpKernels().
+  struct CachedKernel {
+    OpKernelType expected_key_;
+    OpKernelType resolved_key_;
+    OpKernelFunc func_;
+  };
+
   mutable std::unique_ptr<OpKernelType> kernel_type_;
   mutable std::unique_ptr<OpKernelFunc> kernel_func_;
+  // points into AllOpKernels(), which is stable after registration
+  mutable OpKernelMap* kernels_map_cache_ = nullptr;
+  mutable std::vector<CachedKernel> kernel_selection_cache_;
   mutable std::unique_ptr<RuntimeContext> runtime_ctx_;
   mutable const Scope* pre_scope_ = nullptr;
   mutable bool need_prepare_data_ = true;
@@ -15,7 +15,9 @@ limitations under the License. */
 #pragma once
 
 #include <algorithm>
+#include <istream>
 #include <mutex>
+#include <ostream>
 #include <unordered_map>
 #include <vector>
 #include "glog/logging.h"
@@ -42,6 +44,14 @@ class AlgorithmsCache {
   TAlgorithm GetAlgorithm(int64_t area, int search_times, int algorithmFlags,
                           std::function<TAlgorithm()> gen_func);
 
+  // Dumps the cached (signature hash, algorithm) pairs as binary so
+  // ConvSearchCache can persist search results across processes. Only
+  // meaningful for enum-like TAlgorithm.
+  void Serialize(std::ostream* os);
+
+  // Merges entries previously produced by Serialize into the cache.
+  void Deserialize(std::istream* is);
+
  private:
   std::unordered_map<int64_t, TAlgorithm> hash_;
   int search_times_;
@@ -158,5 +168,36 @@ TAlgorithm AlgorithmsCache<TAlgorithm>::GetAlgorithm(
   return algo;
 }
 
+template <typename TAlgorithm>
+void AlgorithmsCache<TAlgorithm>::Serialize(std::ostream* os) {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  uint64_t count = hash_.size();
+  os->write(reinterpret_cast<const char*>(&count), sizeof(count));
+  for (const auto& seed_algo : hash_) {
+    int64_t seed = seed_algo.first;
+    int32_t algo = static_cast<int32_t>(seed_algo.second);
+    os->write(reinterpret_cast<const char*>(&seed), sizeof(seed));
+    os->write(reinterpret_cast<const char*>(&algo), sizeof(algo));
+  }
+}
+
+template <typename TAlgorithm>
+void AlgorithmsCache<TAlgorithm>::Deserialize(std::istream* is) {
+  uint64_t count = 0;
+  is->read(reinterpret_cast<char*>(&count), sizeof(count));
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  for (uint64_t i = 0; i < count; ++i) {
+    int64_t seed = 0;
+    int32_t algo = 0;
+    is->read(reinterpret_cast<char*>(&seed), sizeof(seed));
+    is->read(reinterpret_cast<char*>(&algo), sizeof(algo));
+    if (!*is) {
+      LOG(WARNING) << "Truncated conv search cache entry, stop preloading.";
+      break;
+    }
+    hash_.emplace(seed, static_cast<TAlgorithm>(algo));
+  }
+}
+
 }  // namespace framework
 }  // namespace paddle
@@ -14,7 +14,9 @@
 
 #include "paddle/fluid/framework/paddle2cinn/cinn_cache_key.h"
 
+#include <iomanip>
 #include <map>
+#include <sstream>
 #include <string>
 
 #include "paddle/fluid/framework/ddim.h"
@@ -65,6 +67,24 @@ bool CinnCacheKey::operator==(const CinnCacheKey& other) const {
          feed_shapes_ == other.feed_shapes_;
 }
 
+std::string CinnCacheKey::Serialize() const {
+  std::string buffer = graph_serialize_str_;
+  for (const auto& name_shape : feed_shapes_) {
+    buffer += ";";
+    buffer += name_shape.first;
+    buffer += ":";
+    buffer += name_shape.second.to_str();
+  }
+  return buffer;
+}
+
+std::string CinnCacheKey::Digest() const {
+  std::ostringstream ss;
+  ss << std::hex << std::setfill('0') << std::setw(2 * sizeof(size_t))
+     << Hash()(*this);
+  return ss.str();
+}
+
 size_t CinnCacheKey::Hash::hash_combine(size_t seed, size_t value) {
   return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
 }
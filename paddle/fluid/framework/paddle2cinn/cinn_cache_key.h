@@ -15,6 +15,7 @@
 #pragma once
 
 #include <map>
+#include <string>
 
 #include "paddle/fluid/framework/ddim.h"
 #include "paddle/fluid/framework/ir/graph.h"
@@ -48,6 +49,14 @@ class CinnCacheKey {
   bool operator==(const CinnCacheKey& other) const;
   bool operator!=(const CinnCacheKey& other) const;
 
+  // Returns the raw key material (graph program bytes plus feed shapes).
+  // The on-disk cache stores it next to each entry to rule out digest
+  // collisions.
+  std::string Serialize() const;
+
+  // Returns a short hex digest of the key, used as the on-disk entry name.
+  std::string Digest() const;
+
   struct Hash {
     static size_t hash_combine(size_t seed, size_t value);
     size_t operator()(const CinnCacheKey& key) const;
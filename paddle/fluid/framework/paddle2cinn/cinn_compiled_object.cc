@@ -45,6 +45,17 @@ std::map<std::string, FetchType*> CinnCompiledObject::Run(
   return std::map<std::string, FetchType*>();
 }
 
+std::string CinnCompiledObject::Serialize() const {
+  // Compile stores no artifacts yet, so the payload is empty. To be
+  // extended together with Compile after CINN interface is ready; the disk
+  // cache treats the buffer as opaque bytes either way.
+  return std::string();
+}
+
+void CinnCompiledObject::Deserialize(const std::string& buffer) {
+  // To be extended together with Serialize after CINN interface is ready
+}
+
 }  // namespace paddle2cinn
 }  // namespace framework
 }  // namespace paddle
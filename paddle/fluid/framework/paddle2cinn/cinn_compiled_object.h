@@ -15,6 +15,7 @@
 #pragma once
 
 #include <map>
+#include <string>
 
 #include "paddle/fluid/framework/feed_fetch_type.h"
 #include "paddle/fluid/framework/ir/graph.h"
@@ -40,6 +41,13 @@ class CinnCompiledObject {
   std::map<std::string, FetchType*> Run(
       Scope* scope, std::map<std::string, const LoDTensor*>* feed_targets);
 
+  // Serializes the compiled artifacts to opaque bytes so CinnDiskCache can
+  // persist them across processes
+  std::string Serialize() const;
+
+  // Restores a compiled object from bytes produced by Serialize
+  void Deserialize(const std::string& buffer);
+
   // Converts compiled object to Paddle Graph
   // To be discussed
   // ir::Graph ToGraph();
@@ -0,0 +1,184 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/paddle2cinn/cinn_disk_cache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+#include "paddle/fluid/platform/port.h"
+
+DECLARE_string(cinn_cache_dir);
+
+namespace paddle {
+namespace framework {
+namespace paddle2cinn {
+
+namespace {
+
+// Bump whenever the on-disk entry layout or the compiled artifact format
+// changes; entries written under another version are ignored.
+constexpr char kCacheVersion[] = "cinn_cache_v1";
+
+bool ReadFileToString(const std::string &path, std::string *content) {
+  std::ifstream fin(path, std::ios::binary);
+  if (!fin) {
+    return false;
+  }
+  std::ostringstream ss;
+  ss << fin.rdbuf();
+  *content = ss.str();
+  return true;
+}
+
+bool WriteStringToFile(const std::string &path, const std::string &content) {
+  std::ofstream fout(path, std::ios::binary | std::ios::trunc);
+  if (!fout) {
+    return false;
+  }
+  fout << content;
+  return static_cast<bool>(fout);
+}
+
+#ifndef _WIN32
+// RAII flock holder. Lock failures only cost the caller the cross-process
+// exclusion, so they are not treated as errors.
+class FileLockGuard {
+ public:
+  FileLockGuard(const std::string &path, int operation) {
+    fd_ = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd_ != -1) {
+      flock(fd_, operation);
+    }
+  }
+
+  ~FileLockGuard() {
+    if (fd_ != -1) {
+      flock(fd_, LOCK_UN);
+      close(fd_);
+    }
+  }
+
+ private:
+  int fd_;
+};
+#endif
+
+}  // namespace
+
+CinnDiskCache &CinnDiskCache::Instance() {
+  static CinnDiskCache cache;
+  return cache;
+}
+
+std::string CinnDiskCache::PrepareRoot() {
+#ifdef _WIN32
+  return "";
+#else
+  const std::string &root = FLAGS_cinn_cache_dir;
+  if (root.empty()) {
+    return "";
+  }
+  MkDirRecursively(root.c_str());
+
+  std::string version_file = root + "/version";
+  FileLockGuard guard(root + "/.version.lock", LOCK_EX);
+  std::string version;
+  if (ReadFileToString(version_file, &version)) {
+    if (version != kCacheVersion) {
+      LOG_FIRST_N(WARNING, 1)
+          << "CINN disk cache at " << root << " has version '" << version
+          << "' but this build expects '" << kCacheVersion
+          << "', the cache will not be used.";
+      return "";
+    }
+  } else if (!WriteStringToFile(version_file, kCacheVersion)) {
+    return "";
+  }
+  return root;
+#endif
+}
+
+bool CinnDiskCache::Load(const CinnCacheKey &key,
+                         CinnCompiledObject *compiled_obj) {
+#ifdef _WIN32
+  return false;
+#else
+  std::string root = PrepareRoot();
+  if (root.empty()) {
+    return false;
+  }
+  std::string entry_dir = root + "/" + key.Digest();
+  FileLockGuard guard(entry_dir + ".lock", LOCK_SH);
+
+  std::string stored_key;
+  if (!ReadFileToString(entry_dir + "/key", &stored_key) ||
+      stored_key != key.Serialize()) {
+    return false;
+  }
+  std::string artifact;
+  if (!ReadFileToString(entry_dir + "/artifact", &artifact)) {
+    return false;
+  }
+  compiled_obj->Deserialize(artifact);
+  VLOG(3) << "Loaded compiled CINN subgraph from " << entry_dir;
+  return true;
+#endif
+}
+
+void CinnDiskCache::Store(const CinnCacheKey &key,
+                          const CinnCompiledObject &compiled_obj) {
+#ifndef _WIN32
+  std::string root = PrepareRoot();
+  if (root.empty()) {
+    return;
+  }
+  std::string entry_dir = root + "/" + key.Digest();
+  FileLockGuard guard(entry_dir + ".lock", LOCK_EX);
+
+  std::string stored_key;
+  if (ReadFileToString(entry_dir + "/key", &stored_key)) {
+    // Another process committed this entry first.
+    return;
+  }
+
+  std::string tmp_dir = entry_dir + ".tmp." + std::to_string(getpid());
+  MkDirRecursively(tmp_dir.c_str());
+  if (!WriteStringToFile(tmp_dir + "/artifact", compiled_obj.Serialize()) ||
+      !WriteStringToFile(tmp_dir + "/key", key.Serialize())) {
+    LOG(WARNING) << "Failed to stage CINN cache entry in " << tmp_dir;
+  } else if (rename(tmp_dir.c_str(), entry_dir.c_str()) == 0) {
+    VLOG(3) << "Stored compiled CINN subgraph to " << entry_dir;
+    return;
+  }
+  // Staging or commit failed; drop the temporary entry.
+  std::remove((tmp_dir + "/artifact").c_str());
+  std::remove((tmp_dir + "/key").c_str());
+  rmdir(tmp_dir.c_str());
+#endif
+}
+
+}  // namespace paddle2cinn
+}  // namespace framework
+}  // namespace paddle
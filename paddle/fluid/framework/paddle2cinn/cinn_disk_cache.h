@@ -0,0 +1,59 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+
+#include "paddle/fluid/framework/paddle2cinn/cinn_cache_key.h"
+#include "paddle/fluid/framework/paddle2cinn/cinn_compiled_object.h"
+
+namespace paddle {
+namespace framework {
+namespace paddle2cinn {
+
+// Host-wide persistent cache of compiled CINN subgraphs.
+//
+// Entries live under FLAGS_cinn_cache_dir, one directory per CinnCacheKey
+// digest, holding the serialized key (to rule out digest collisions) and
+// the compiled artifact bytes. A writer stages its entry in a temporary
+// directory and commits it with an atomic rename while holding an
+// exclusive file lock, so of N processes starting together on one host
+// only the first compiles a given subgraph and the rest load the committed
+// artifact. A version file at the cache root invalidates entries written
+// by incompatible builds. POSIX only; the cache is disabled on Windows or
+// when FLAGS_cinn_cache_dir is empty.
+class CinnDiskCache {
+ public:
+  static CinnDiskCache& Instance();
+
+  // Returns true and restores *compiled_obj when a valid entry for this
+  // key and cache version exists.
+  bool Load(const CinnCacheKey& key, CinnCompiledObject* compiled_obj);
+
+  // Persists a compiled object. Racing writers of the same key are
+  // serialized by the entry file lock and the first committed entry wins.
+  void Store(const CinnCacheKey& key, const CinnCompiledObject& compiled_obj);
+
+ private:
+  CinnDiskCache() = default;
+
+  // Returns the cache root, creating it and its version file on first use.
+  // An empty string means the cache is disabled.
+  std::string PrepareRoot();
+};
+
+}  // namespace paddle2cinn
+}  // namespace framework
+}  // namespace paddle
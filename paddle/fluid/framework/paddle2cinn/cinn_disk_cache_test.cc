@@ -0,0 +1,69 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _WIN32
+
+#include "paddle/fluid/framework/paddle2cinn/cinn_disk_cache.h"
+
+#include <map>
+
+#include "gflags/gflags.h"
+#include "gtest/gtest.h"
+#include "paddle/fluid/framework/ddim.h"
+#include "paddle/fluid/framework/ir/graph.h"
+#include "paddle/fluid/framework/program_desc.h"
+
+DECLARE_string(cinn_cache_dir);
+
+namespace paddle {
+namespace framework {
+namespace paddle2cinn {
+
+TEST(CinnDiskCacheTest, TestStoreLoad) {
+  FLAGS_cinn_cache_dir = "./cinn_disk_cache_test_dir";
+
+  ProgramDesc program;
+  auto *global_block = program.MutableBlock(0);
+  auto *x = global_block->Var("X");
+  x->SetType(proto::VarType::LOD_TENSOR);
+  ir::Graph graph(program);
+
+  DDim ddim = paddle::framework::make_ddim({1, 2, 3});
+  std::map<std::string, DDim> feed_shapes = {{"X", ddim}};
+  CinnCacheKey cache_key(graph, feed_shapes);
+
+  CinnCompiledObject compiled_obj;
+  CinnCompiledObject loaded_obj;
+
+  // Miss before the entry is stored, hit afterwards.
+  EXPECT_FALSE(CinnDiskCache::Instance().Load(cache_key, &loaded_obj));
+  CinnDiskCache::Instance().Store(cache_key, compiled_obj);
+  EXPECT_TRUE(CinnDiskCache::Instance().Load(cache_key, &loaded_obj));
+
+  // A different key stays a miss.
+  ProgramDesc empty_program;
+  ir::Graph empty_graph(empty_program);
+  CinnCacheKey other_key(empty_graph, feed_shapes);
+  EXPECT_FALSE(CinnDiskCache::Instance().Load(other_key, &loaded_obj));
+
+  // An empty cache dir disables the cache.
+  FLAGS_cinn_cache_dir = "";
+  EXPECT_FALSE(CinnDiskCache::Instance().Load(cache_key, &loaded_obj));
+}
+
+}  // namespace paddle2cinn
+}  // namespace framework
+}  // namespace paddle
+
+#endif
@@ -19,6 +19,7 @@
 #include <mutex>
 
 #include "paddle/fluid/framework/ir/graph.h"
+#include "paddle/fluid/framework/paddle2cinn/cinn_disk_cache.h"
 #include "paddle/fluid/framework/scope.h"
 #include "paddle/fluid/framework/tensor.h"
 
@@ -50,7 +51,12 @@ std::map<std::string, FetchType*> CinnRunner::Run(
     obj_to_run = cache_[cur_key];
   } else {
     obj_to_run = std::make_shared<CinnCompiledObject>();
-    obj_to_run->Compile(graph, feed_targets);
+    // Consult the host-wide persistent cache before compiling, so only the
+    // first process on a host pays compilation for this subgraph.
+    if (!CinnDiskCache::Instance().Load(cur_key, obj_to_run.get())) {
+      obj_to_run->Compile(graph, feed_targets);
+      CinnDiskCache::Instance().Store(cur_key, *obj_to_run);
+    }
     cache_[cur_key] = obj_to_run;
   }
   return obj_to_run->Run(scope, feed_targets);
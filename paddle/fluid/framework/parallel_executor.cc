@@ -47,6 +47,7 @@ DECLARE_double(eager_delete_tensor_gb);
 
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
 DECLARE_bool(sync_nccl_allreduce);
+DECLARE_int32(cuda_graph_auto_capture_warmup_steps);
 #endif
 
 #ifdef WITH_GPERFTOOLS
@@ -377,6 +378,47 @@ class ParallelExecutorPrivate {
     return iter != is_persistable_.end() && iter->second;
   }
 
+#ifdef PADDLE_WITH_CUDA
+  inline bool AutoCUDAGraphMode() const {
+    return build_strategy_.allow_cuda_graph_capture_ &&
+           FLAGS_cuda_graph_auto_capture_warmup_steps >= 0;
+  }
+
+  void InvalidateCUDAGraph() {
+    if (cuda_graph_) {
+      VLOG(3) << "Drop the captured CUDA Graph and restart warmup.";
+      cuda_graph_.reset();
+    }
+    cuda_graph_run_cnt_ = 0;
+  }
+
+  // Copies a fed tensor into the buffer the captured CUDA Graph reads.
+  // Returns false (and drops the graph) when the shape, dtype or lod
+  // changed, in which case the caller falls back to the normal feed path
+  // and the graph is captured again after warmup.
+  bool FeedInPlaceForCUDAGraph(size_t scope_idx, const std::string &name,
+                               const LoDTensor &tensor) {
+    bool is_persistable = IsPersistable(name);
+    auto *feed_scope =
+        is_persistable ? local_scopes_[scope_idx] : local_exec_scopes_[scope_idx];
+    auto *feed_var = feed_scope->FindVar(name);
+    auto *trg =
+        feed_var == nullptr ? nullptr : feed_var->GetMutable<LoDTensor>();
+    if (trg == nullptr || !trg->IsInitialized() ||
+        trg->dims() != tensor.dims() || trg->type() != tensor.type() ||
+        trg->lod() != tensor.lod()) {
+      InvalidateCUDAGraph();
+      return false;
+    }
+    TensorCopy(tensor, trg->place(), trg);
+    return true;
+  }
+
+  // Whole-iteration capture state of the automatic CUDA Graph mode.
+  std::unique_ptr<platform::CUDAGraph> cuda_graph_;
+  int64_t cuda_graph_run_cnt_{0};
+#endif
+
   BuildStrategy build_strategy_;
   std::vector<platform::Place> places_;
   std::vector<Scope *> local_scopes_;
@@ -920,6 +962,32 @@ FetchResultType ParallelExecutor::Run(
                                 member_->HasGarbageCollectors());
 
   VLOG(3) << "ParallelExecutor begin to run member_->executor_->Run";
+#ifdef PADDLE_WITH_CUDA
+  if (UNLIKELY(member_->AutoCUDAGraphMode() &&
+               !platform::IsCUDAGraphCapturing())) {
+    if (!fetch_tensors.empty()) {
+      // Fetching changes the lifetime of the fetched variables, so steps
+      // with fetches run outside the graph and drop an already captured one.
+      member_->InvalidateCUDAGraph();
+    } else if (member_->cuda_graph_) {
+      member_->cuda_graph_->Replay();
+      return return_merged ? FetchResultType(FetchList())
+                           : FetchResultType(FetchUnmergedList());
+    } else if (member_->cuda_graph_run_cnt_ <
+               std::max(FLAGS_cuda_graph_auto_capture_warmup_steps, 1)) {
+      ++member_->cuda_graph_run_cnt_;
+    } else {
+      // Warmed up: capture this whole iteration, then launch it once since
+      // capturing only records the work without executing it.
+      auto place = BOOST_GET_CONST(platform::CUDAPlace, member_->places_[0]);
+      platform::BeginCUDAGraphCapture(place, cudaStreamCaptureModeRelaxed);
+      auto fetch_data = member_->executor_->Run(fetch_tensors, return_merged);
+      member_->cuda_graph_ = platform::EndCUDAGraphCapture();
+      member_->cuda_graph_->Replay();
+      return fetch_data;
+    }
+  }
+#endif
   auto fetch_data = member_->executor_->Run(fetch_tensors, return_merged);
   return fetch_data;
 }
@@ -940,6 +1008,25 @@ void ParallelExecutor::RunWithoutFetch(
                                 member_->HasGarbageCollectors());
 
   VLOG(3) << "ParallelExecutor begin to run member_->executor_->Run";
+#ifdef PADDLE_WITH_CUDA
+  if (UNLIKELY(member_->AutoCUDAGraphMode() &&
+               !platform::IsCUDAGraphCapturing())) {
+    if (member_->cuda_graph_) {
+      member_->cuda_graph_->Replay();
+      return;
+    } else if (member_->cuda_graph_run_cnt_ <
+               std::max(FLAGS_cuda_graph_auto_capture_warmup_steps, 1)) {
+      ++member_->cuda_graph_run_cnt_;
+    } else {
+      auto place = BOOST_GET_CONST(platform::CUDAPlace, member_->places_[0]);
+      platform::BeginCUDAGraphCapture(place, cudaStreamCaptureModeRelaxed);
+      member_->executor_->Run(/*fetch_tensors*/ {}, /*return_merged*/ false);
+      member_->cuda_graph_ = platform::EndCUDAGraphCapture();
+      member_->cuda_graph_->Replay();
+      return;
+    }
+  }
+#endif
   member_->executor_->Run(/*fetch_tensors*/ {}, /*return_merged*/ false);
 }
 
@@ -966,6 +1053,26 @@ void ParallelExecutor::FeedTensorsIntoLocalScopes(
     return;
   }
 
+#ifdef PADDLE_WITH_CUDA
+  if (UNLIKELY(member_->cuda_graph_ != nullptr)) {
+    // An iteration graph is captured: write the new batch into the buffers
+    // the graph reads instead of rebinding the variables to the caller's
+    // tensors. A shape change drops the graph and falls through below.
+    bool in_place_ok = true;
+    for (size_t i = 0; i < tensors.size() && in_place_ok; ++i) {
+      for (auto &pair : tensors[i]) {
+        if (!member_->FeedInPlaceForCUDAGraph(i, pair.first, pair.second)) {
+          in_place_ok = false;
+          break;
+        }
+      }
+    }
+    if (in_place_ok) {
+      return;
+    }
+  }
+#endif
+
   if (!member_->AllowPartialFeed()) {
     PADDLE_ENFORCE_EQ(tensors.size(), member_->local_scopes_.size(),
                       platform::errors::Unimplemented(
@@ -1029,6 +1136,24 @@ void ParallelExecutor::FeedAndSplitTensorIntoLocalScopes(
     return;
   }
 
+#ifdef PADDLE_WITH_CUDA
+  if (UNLIKELY(member_->cuda_graph_ != nullptr)) {
+    // The automatic CUDA Graph mode only runs with one device, so the fed
+    // tensor is copied as a whole into the buffer the graph reads. A shape
+    // change drops the graph and falls through to the normal split path.
+    bool in_place_ok = true;
+    for (auto &pair : tensors) {
+      if (!member_->FeedInPlaceForCUDAGraph(0, pair.first, pair.second)) {
+        in_place_ok = false;
+        break;
+      }
+    }
+    if (in_place_ok) {
+      return;
+    }
+  }
+#endif
+
   size_t num_places = member_->places_.size();
   bool allow_partial_feed = member_->AllowPartialFeed();
 
@@ -0,0 +1,93 @@
+/* Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace paddle {
+namespace framework {
+
+// Counter-based Philox-4x32-10 generator (Salmon et al., "Parallel Random
+// Numbers: As Easy as 1, 2, 3"), the same construction the CUDA kernels
+// use through curandStatePhilox4_32_10_t. Each (seed, counter) pair maps
+// to four independent 32-bit values with no sequential state, so any
+// thread can jump to an arbitrary block of the stream in O(1) and a
+// parallel fill stays bit-reproducible for a fixed seed regardless of the
+// number of threads.
+class PhiloxEngine {
+ public:
+  explicit PhiloxEngine(uint64_t seed)
+      : key0_(static_cast<uint32_t>(seed)),
+        key1_(static_cast<uint32_t>(seed >> 32)) {}
+
+  // Returns the counter-th block of four 32-bit values of this seed's
+  // stream. Stateless, so it is safe to call concurrently.
+  std::array<uint32_t, 4> operator()(uint64_t counter) const {
+    uint32_t c0 = static_cast<uint32_t>(counter);
+    uint32_t c1 = static_cast<uint32_t>(counter >> 32);
+    uint32_t c2 = 0;
+    uint32_t c3 = 0;
+    uint32_t k0 = key0_;
+    uint32_t k1 = key1_;
+    for (int round = 0; round < 10; ++round) {
+      uint32_t hi0, lo0, hi1, lo1;
+      MulHiLo(kPhiloxM4x32A, c0, &hi0, &lo0);
+      MulHiLo(kPhiloxM4x32B, c2, &hi1, &lo1);
+      uint32_t n0 = hi1 ^ c1 ^ k0;
+      uint32_t n1 = lo1;
+      uint32_t n2 = hi0 ^ c3 ^ k1;
+      uint32_t n3 = lo0;
+      c0 = n0;
+      c1 = n1;
+      c2 = n2;
+      c3 = n3;
+      k0 += kPhiloxW32A;
+      k1 += kPhiloxW32B;
+    }
+    return {{c0, c1, c2, c3}};
+  }
+
+  // Maps one 32-bit value to a float in [0, 1) with 24 bits of
+  // resolution.
+  static float Uniform01(uint32_t x) {
+    return static_cast<float>(x >> 8) * (1.0f / 16777216.0f);
+  }
+
+  // Maps two 32-bit values to a double in [0, 1) with 53 bits of
+  // resolution.
+  static double Uniform01(uint32_t hi, uint32_t lo) {
+    uint64_t v = ((static_cast<uint64_t>(hi) << 32) | lo) >> 11;
+    return static_cast<double>(v) * (1.0 / 9007199254740992.0);
+  }
+
+ private:
+  static void MulHiLo(uint32_t a, uint32_t b, uint32_t* hi, uint32_t* lo) {
+    uint64_t product = static_cast<uint64_t>(a) * b;
+    *hi = static_cast<uint32_t>(product >> 32);
+    *lo = static_cast<uint32_t>(product);
+  }
+
+  static constexpr uint32_t kPhiloxM4x32A = 0xD2511F53;
+  static constexpr uint32_t kPhiloxM4x32B = 0xCD9E8D57;
+  static constexpr uint32_t kPhiloxW32A = 0x9E3779B9;
+  static constexpr uint32_t kPhiloxW32B = 0xBB67AE85;
+
+  uint32_t key0_;
+  uint32_t key1_;
+};
+
+}  // namespace framework
+}  // namespace paddle
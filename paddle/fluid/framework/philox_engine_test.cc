@@ -0,0 +1,53 @@
+/* Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include "paddle/fluid/framework/philox_engine.h"
+
+#include "gtest/gtest.h"
+
+namespace paddle {
+namespace framework {
+
+TEST(PhiloxEngine, Deterministic) {
+  PhiloxEngine engine_a(12345);
+  PhiloxEngine engine_b(12345);
+  for (uint64_t counter = 0; counter < 100; ++counter) {
+    EXPECT_EQ(engine_a(counter), engine_b(counter));
+  }
+  // Blocks can be drawn in any order with the same result.
+  EXPECT_EQ(engine_a(7), engine_b(7));
+}
+
+TEST(PhiloxEngine, DistinctBlocksAndSeeds) {
+  PhiloxEngine engine(12345);
+  PhiloxEngine other(54321);
+  EXPECT_NE(engine(0), engine(1));
+  EXPECT_NE(engine(0), other(0));
+}
+
+TEST(PhiloxEngine, UniformRange) {
+  PhiloxEngine engine(2021);
+  for (uint64_t counter = 0; counter < 1000; ++counter) {
+    auto block = engine(counter);
+    float f = PhiloxEngine::Uniform01(block[0]);
+    EXPECT_GE(f, 0.0f);
+    EXPECT_LT(f, 1.0f);
+    double d = PhiloxEngine::Uniform01(block[1], block[2]);
+    EXPECT_GE(d, 0.0);
+    EXPECT_LT(d, 1.0);
+  }
+}
+
+}  // namespace framework
+}  // namespace paddle
@@ -28,6 +28,8 @@ void PipelineTrainer::Initialize(const TrainerDesc& trainer_desc,
   const int num_pipeline_stages_ = section_params.num_pipeline_stages();
   const int pipeline_stage_ = section_params.pipeline_stage();
   const int schedule_mode_ = section_params.schedule_mode();
+  const int max_inflight_microbatches_ =
+      section_params.max_inflight_microbatches();
   num_microbatches_ = section_params.num_microbatches();
   VLOG(3) << "Number of microbatches per minibatch: " << num_microbatches_;
   trainer_desc_ = trainer_desc;
@@ -49,6 +51,7 @@ void PipelineTrainer::Initialize(const TrainerDesc& trainer_desc,
   this_worker->SetPipelineStageNum(num_pipeline_stages_);
   this_worker->SetPipelineStage(pipeline_stage_);
   this_worker->SetScheduleMode(schedule_mode_);
+  this_worker->SetMaxInflightMicrobatches(max_inflight_microbatches_);
   this_worker->Initialize(trainer_desc);
 }
 
@@ -12,6 +12,7 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License. */
 #include <time.h>
+#include <cstring>
 #include "paddle/fluid/framework/device_worker.h"
 
 namespace paddle {
@@ -57,7 +58,10 @@ void PullDenseWorker::Initialize(const TrainerDesc& param) {
     training_versions_[tid].resize(thread_num_, 0);
     last_versions_[tid] = 0;
     current_version_[tid] = 0;
+    issued_versions_[tid] = 0;
+    landed_versions_[tid] = 0;
   }
+  in_flight_tables_.clear();
   fleet_ptr_ = FleetWrapper::GetInstance();
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
   copy_streams_.clear();
@@ -98,6 +102,30 @@ void PullDenseWorker::CreatePinVar() {
 #endif
 }
 
+void PullDenseWorker::CreateShadowVar() {
+#if !(defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP) || \
+      defined(PADDLE_WITH_XPU))
+  // CPU counterpart of CreatePinVar: a staging block with the same "pin"
+  // naming, so the pserver writes land in the shadow tensors while
+  // training threads keep reading the live ones.
+  for (int i = 0; i < dwp_param_.program_config(0).pull_dense_table_id_size();
+       ++i) {
+    uint64_t tid = static_cast<uint64_t>(
+        dwp_param_.program_config(0).pull_dense_table_id(i));
+    for (size_t j = 0; j < dense_value_names_[tid].size(); j++) {
+      auto& name = dense_value_names_[tid][j];
+      Variable* var = root_scope_->FindVar(name);
+
+      LoDTensor* tensor = var->GetMutable<LoDTensor>();
+      auto* ptr = root_scope_->Var(name + "pin");
+      InitializeVariable(ptr, proto::VarType::LOD_TENSOR);
+      LoDTensor* shadow_tensor = ptr->GetMutable<LoDTensor>();
+      shadow_tensor->mutable_data<float>(tensor->dims(), platform::CPUPlace());
+    }
+  }
+#endif
+}
+
 void PullDenseWorker::Wait(std::vector<::std::future<int32_t>>* status_vec) {
   for (auto& t : *status_vec) {
     t.wait();
@@ -154,35 +182,95 @@ void PullDenseWorker::Stop() {
   if (running_) {
     running_ = false;
     t_.join();
+    // Land a prefetch that was still in flight when the loop stopped.
+    if (pull_dense_status_.size() != 0) {
+      Wait(&pull_dense_status_);
+      SwapShadowParams();
+    }
   }
 }
 
+void PullDenseWorker::SwapShadowParams() {
+  for (auto tid : in_flight_tables_) {
+#if !(defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP) || \
+      defined(PADDLE_WITH_XPU))
+    // Make the freshly pulled values visible: the pserver wrote into the
+    // shadow block, so the window where training threads can observe a
+    // half-updated parameter shrinks from a full pserver round-trip to
+    // one memcpy per variable.
+    for (size_t j = 0; j < dense_value_names_[tid].size(); ++j) {
+      auto& name = dense_value_names_[tid][j];
+      Variable* shadow_var = root_scope_->FindVar(name + "pin");
+      LoDTensor* shadow_tensor = shadow_var->GetMutable<LoDTensor>();
+      Variable* var = root_scope_->FindVar(name);
+      LoDTensor* tensor = var->GetMutable<LoDTensor>();
+      std::memcpy(tensor->data<float>(), shadow_tensor->data<float>(),
+                  sizeof(float) * tensor->numel());
+    }
+#endif
+    uint64_t staleness = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_for_version_);
+      landed_versions_[tid] = issued_versions_[tid];
+      auto& version = training_versions_[tid];
+      if (!version.empty()) {
+        staleness = *(std::min_element(version.begin(), version.end())) -
+                    landed_versions_[tid];
+      }
+    }
+    VLOG(3) << "landed dense pull for table " << tid << ", staleness "
+            << staleness << " steps";
+  }
+  in_flight_tables_.clear();
+}
+
+uint64_t PullDenseWorker::GetStaleness(uint64_t table_id) {
+  std::lock_guard<std::mutex> lock(mutex_for_version_);
+  auto& version = training_versions_[table_id];
+  if (version.empty()) {
+    return 0;
+  }
+  return *(std::min_element(version.begin(), version.end())) -
+         landed_versions_[table_id];
+}
+
 void PullDenseWorker::PullDense(bool force_update) {
-  pull_dense_status_.resize(0);
+  // Land the prefetch issued on the previous iteration first. It has had
+  // a whole sleep interval to complete, so the wait is normally free and
+  // the pserver round-trip stays hidden behind training.
+  if (pull_dense_status_.size() != 0) {
+    Wait(&pull_dense_status_);
+    SwapShadowParams();
+  }
   for (int i = 0; i < dwp_param_.program_config(0).pull_dense_table_id_size();
        ++i) {
     uint64_t tid = static_cast<uint64_t>(
         dwp_param_.program_config(0).pull_dense_table_id(i));
     if (force_update || CheckUpdateParam(tid)) {
-#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP) || \
-    defined(PADDLE_WITH_XPU)
       VLOG(3) << "pull dense " << force_update << " " << tid;
+      // Pull into the staging block ("pin" vars) on every build: training
+      // threads keep reading the live parameters until SwapShadowParams
+      // (or the device copies in Wait) publish the new version.
       fleet_ptr_->PullDenseVarsAsync(*root_scope_, tid, dense_value_names_[tid],
                                      &pull_dense_status_, false);
-#else
-      fleet_ptr_->PullDenseVarsAsync(*root_scope_, tid, dense_value_names_[tid],
-                                     &pull_dense_status_, true);
-#endif
+      {
+        std::lock_guard<std::mutex> lock(mutex_for_version_);
+        issued_versions_[tid] = current_version_[tid];
+      }
+      in_flight_tables_.push_back(tid);
       ResetThreadVersion(tid);
     }
   }
-  if (pull_dense_status_.size() != 0) {
+  // The initial pull must be visible before training threads start.
+  if (force_update && pull_dense_status_.size() != 0) {
     Wait(&pull_dense_status_);
+    SwapShadowParams();
   }
 }
 
 int PullDenseWorker::Start() {
   running_ = true;
+  CreateShadowVar();
   // before training, we can pull dense from pserver first.
   PullDense(true);
   t_ = std::thread(&PullDenseWorker::Run, this);
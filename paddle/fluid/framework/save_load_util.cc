@@ -248,7 +248,13 @@ bool SaveTensorToDisk(const std::string& file_name,
                       const std::map<std::string, Tensor*>& map_tensor) {
   MkDirRecursively(DirName(file_name).c_str());
 
-  std::ofstream fout(file_name, std::ios::binary);
+  // A large stream buffer batches the many small header writes into few
+  // filesystem calls, which matters on network filesystems. It must be
+  // installed before the file is opened to take effect.
+  std::vector<char> stream_buffer(4 << 20);
+  std::ofstream fout;
+  fout.rdbuf()->pubsetbuf(stream_buffer.data(), stream_buffer.size());
+  fout.open(file_name, std::ios::binary);
   PADDLE_ENFORCE_EQ(
       fout.is_open(), true,
       platform::errors::Unavailable("File (%s) open failed.", file_name));
@@ -321,6 +327,102 @@ bool SaveTensorToDisk(const std::string& file_name,
   return true;
 }
 
+AsyncCheckpointWriter* AsyncCheckpointWriter::GetInstance() {
+  static AsyncCheckpointWriter instance;
+  return &instance;
+}
+
+AsyncCheckpointWriter::~AsyncCheckpointWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+    cv_.notify_all();
+  }
+  if (writer_thread_ != nullptr && writer_thread_->joinable()) {
+    writer_thread_->join();
+  }
+}
+
+void AsyncCheckpointWriter::SaveTensorToDiskAsync(
+    const std::string& file_name,
+    const std::map<std::string, Tensor*>& map_tensor) {
+  CheckpointJob job;
+  job.file_name = file_name;
+  for (auto& itera : map_tensor) {
+    Tensor snapshot;
+    if (platform::is_gpu_place(itera.second->place())) {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+      // pinned memory keeps the blocking part of the snapshot at
+      // device-to-host copy speed
+      TensorCopySync(*itera.second, platform::CUDAPinnedPlace(), &snapshot);
+#else
+      PADDLE_THROW(platform::errors::Unavailable(
+          "Tensor is in CUDA device, but paddle not compiled with CUDA."));
+#endif
+    } else {
+      TensorCopySync(*itera.second, platform::CPUPlace(), &snapshot);
+    }
+    job.snapshots.emplace(itera.first, std::move(snapshot));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (writer_thread_ == nullptr) {
+    writer_thread_.reset(new std::thread(&AsyncCheckpointWriter::Run, this));
+  }
+  jobs_.emplace_back(std::move(job));
+  ++pending_;
+  cv_.notify_all();
+}
+
+void AsyncCheckpointWriter::Wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this] { return pending_ == 0; });
+  if (!error_.empty()) {
+    std::string error = error_;
+    error_.clear();
+    PADDLE_THROW(platform::errors::Unavailable(
+        "Async checkpoint write failed: %s", error));
+  }
+}
+
+void AsyncCheckpointWriter::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    cv_.wait(lock, [this] { return !jobs_.empty() || stop_; });
+    if (jobs_.empty()) {
+      if (stop_) {
+        break;
+      }
+      continue;
+    }
+    CheckpointJob job = std::move(jobs_.front());
+    jobs_.pop_front();
+    lock.unlock();
+
+    std::string error;
+    try {
+      std::map<std::string, Tensor*> snapshot_ptrs;
+      for (auto& item : job.snapshots) {
+        snapshot_ptrs[item.first] = &item.second;
+      }
+      SaveTensorToDisk(job.file_name, snapshot_ptrs);
+      VLOG(3) << "async checkpoint written to " << job.file_name;
+    } catch (std::exception& e) {
+      // keep the writer alive; the error is reported on the next Wait()
+      LOG(ERROR) << "Async checkpoint write to " << job.file_name
+                 << " failed: " << e.what();
+      error = e.what();
+    }
+
+    lock.lock();
+    if (!error.empty() && error_.empty()) {
+      error_ = error;
+    }
+    --pending_;
+    cv_.notify_all();
+  }
+}
+
 bool LoadTensorFromDisk(
     const std::string& file_name,
     std::map<std::string, std::shared_ptr<Tensor>>* map_tensor) {
@@ -14,11 +14,15 @@
 
 #pragma once
 
+#include <condition_variable>  // NOLINT
+#include <deque>
 #include <fstream>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
+#include <thread>  // NOLINT
 #include <vector>
 
 #include "paddle/fluid/framework/scope.h"
@@ -52,5 +56,46 @@ bool LoadTensorFromDisk(
     const std::string& file_name,
     std::map<std::string, std::shared_ptr<Tensor>>* map_tensor);
 
+// Asynchronous checkpoint service. SaveTensorToDiskAsync snapshots the
+// tensors on the calling thread (at most one device-to-pinned-host copy
+// per tensor) and returns; serialization and file writing happen on a
+// background thread, overlapping the next training steps. Checkpoints
+// are written in submission order into the same combined single-file
+// layout SaveTensorToDisk produces. Call Wait() before reading a
+// checkpoint back or shutting down; it also reports any write error of
+// the background thread.
+class AsyncCheckpointWriter {
+ public:
+  static AsyncCheckpointWriter* GetInstance();
+
+  ~AsyncCheckpointWriter();
+
+  void SaveTensorToDiskAsync(const std::string& file_name,
+                             const std::map<std::string, Tensor*>& map_tensor);
+
+  // Blocks until every queued checkpoint has been written.
+  void Wait();
+
+ private:
+  AsyncCheckpointWriter() {}
+
+  struct CheckpointJob {
+    std::string file_name;
+    std::map<std::string, Tensor> snapshots;
+  };
+
+  void Run();
+
+  std::deque<CheckpointJob> jobs_;
+  size_t pending_ = 0;
+  bool stop_ = false;
+  std::string error_;
+  std::unique_ptr<std::thread> writer_thread_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+
+  DISABLE_COPY_AND_ASSIGN(AsyncCheckpointWriter);
+};
+
 }  // namespace framework
 }  // namespace paddle
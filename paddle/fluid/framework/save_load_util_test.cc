@@ -71,5 +71,45 @@ TEST(test_save_load_util, test_save_load) {
     ASSERT_EQ(ptr_2[i], ptr_2_new[i]);
   }
 }
+
+TEST(test_save_load_util, test_async_checkpoint_writer) {
+  srand(time(NULL));
+  auto cpu_place = platform::CPUPlace();
+  Tensor tensor1;
+  tensor1.Resize({500, 1000});
+  auto src_data_1 = tensor1.mutable_data<float>(cpu_place);
+
+  for (int64_t i = 0; i < tensor1.numel(); ++i) {
+    float temp = (rand() % 10000) * 1.0 / 50000 - 1.0;  // NOLINT
+
+    src_data_1[i] = temp;
+  }
+
+  std::map<std::string, Tensor*> map_tensor;
+  map_tensor["t1"] = &tensor1;
+
+  auto* writer = AsyncCheckpointWriter::GetInstance();
+  writer->SaveTensorToDiskAsync("test_async_1", map_tensor);
+
+  // the snapshot was taken, mutating the source now must not affect the
+  // checkpoint being written
+  std::vector<float> expected(src_data_1, src_data_1 + tensor1.numel());
+  for (int64_t i = 0; i < tensor1.numel(); ++i) {
+    src_data_1[i] = 0.0f;
+  }
+
+  writer->Wait();
+
+  std::map<std::string, std::shared_ptr<Tensor>> load_map_tensor;
+  LoadTensorFromDisk("test_async_1", &load_map_tensor);
+
+  ASSERT_TRUE(load_map_tensor.find("t1") != load_map_tensor.end());
+  auto new_tensor_1 = load_map_tensor["t1"];
+  float* ptr_1_new = new_tensor_1->data<float>();
+
+  for (int64_t i = 0; i < tensor1.numel(); ++i) {
+    ASSERT_EQ(expected[i], ptr_1_new[i]);
+  }
+}
 }  // namespace framework
 }  // namespace paddle
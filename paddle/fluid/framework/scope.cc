@@ -60,11 +60,13 @@ std::unique_ptr<Scope> Scope::NewTmpScope() const {
 
 Variable* Scope::Var(const std::string& name) {
   SCOPE_VARS_WRITER_LOCK
+  InvalidateReadSnapshot();
   return VarInternal(name);
 }
 
 Variable* Scope::Var(std::string* name) {
   SCOPE_VARS_WRITER_LOCK
+  InvalidateReadSnapshot();
   auto new_name = std::to_string(reinterpret_cast<uintptr_t>(this)) + "." +
                   std::to_string(vars_.size());
   if (name != nullptr) {
@@ -74,6 +76,15 @@ Variable* Scope::Var(std::string* name) {
 }
 
 Variable* Scope::FindVar(const std::string& name) const {
+  // Lock-free fast path against the immutable snapshot, if one is valid.
+  auto* snapshot = snapshot_.load(std::memory_order_acquire);
+  if (snapshot != nullptr) {
+    auto it = snapshot->find(name);
+    if (it != snapshot->end()) {
+      return it->second;
+    }
+    return (parent_ == nullptr) ? nullptr : parent_->FindVar(name);
+  }
   SCOPE_VARS_READER_LOCK
   return FindVarInternal(name);
 }
@@ -86,6 +97,11 @@ Variable* Scope::GetVar(const std::string& name) const {
 }
 
 Variable* Scope::FindLocalVar(const std::string& name) const {
+  auto* snapshot = snapshot_.load(std::memory_order_acquire);
+  if (snapshot != nullptr) {
+    auto it = snapshot->find(name);
+    return it != snapshot->end() ? it->second : nullptr;
+  }
   SCOPE_VARS_READER_LOCK
   return FindVarLocally(name);
 }
@@ -142,6 +158,7 @@ void Scope::DeleteScope(Scope* scope) const {
 void Scope::EraseVars(const std::vector<std::string>& var_names) {
   std::set<std::string> var_set(var_names.begin(), var_names.end());
   SCOPE_VARS_WRITER_LOCK
+  InvalidateReadSnapshot();
   for (auto it = vars_.begin(); it != vars_.end();) {
     if (var_set.find(it->first) != var_set.end()) {
       it = vars_.erase(it);
@@ -154,11 +171,13 @@ void Scope::EraseVars(const std::vector<std::string>& var_names) {
 void Scope::Rename(const std::string& origin_name,
                    const std::string& new_name) const {
   SCOPE_VARS_WRITER_LOCK
+  InvalidateReadSnapshot();
   RenameInternal(origin_name, new_name);
 }
 
 std::string Scope::Rename(const std::string& origin_name) const {
   SCOPE_VARS_WRITER_LOCK
+  InvalidateReadSnapshot();
   auto new_name = string::Sprintf("%p.%d", this, vars_.size());
   RenameInternal(origin_name, new_name);
   return new_name;
@@ -214,6 +233,23 @@ Variable* Scope::FindVarInternal(const std::string& name) const {
   return (parent_ == nullptr) ? nullptr : parent_->FindVar(name);
 }
 
+void Scope::BuildReadSnapshot() const {
+  SCOPE_VARS_WRITER_LOCK
+  auto snapshot = std::unique_ptr<VarSnapshot>(new VarSnapshot());
+  snapshot->reserve(vars_.size());
+  for (auto& pair : vars_) {
+    (*snapshot)[pair.first] = pair.second.get();
+  }
+  snapshot_.store(snapshot.get(), std::memory_order_release);
+  retired_snapshots_.emplace_back(std::move(snapshot));
+}
+
+void Scope::InvalidateReadSnapshot() const {
+  if (snapshot_.load(std::memory_order_relaxed) != nullptr) {
+    snapshot_.store(nullptr, std::memory_order_release);
+  }
+}
+
 Variable* Scope::FindVarLocally(const std::string& name) const {
   auto it = vars_.find(name);
   if (it != vars_.end()) {
@@ -224,6 +260,7 @@ Variable* Scope::FindVarLocally(const std::string& name) const {
 
 void Scope::EraseVarsExcept(const std::unordered_set<Variable*>& vars) {
   SCOPE_VARS_WRITER_LOCK
+  InvalidateReadSnapshot();
   for (auto iter = vars_.begin(); iter != vars_.end();) {
     if (vars.count(iter->second.get()) != 0) {
       ++iter;
@@ -18,6 +18,7 @@ extern "C" {
 #include <xxhash.h>
 }
 
+#include <atomic>
 #include <list>
 #include <memory>
 #include <string>
@@ -29,6 +30,7 @@ extern "C" {
 #include "paddle/fluid/framework/rw_lock.h"
 #include "paddle/fluid/framework/variable.h"
 #include "paddle/fluid/platform/macros.h"
+#include "paddle/utils/flat_hash_map.h"
 
 namespace paddle {
 namespace framework {
@@ -118,6 +120,13 @@ class Scope {
   // Rename variable to a new name and return the new name
   std::string Rename(const std::string& origin_name) const;
 
+  /// Build an immutable snapshot of the current local variables. Until the
+  /// next mutation invalidates it, FindVar()/FindLocalVar() resolve names
+  /// against the snapshot without taking vars_lock_, so lookups from many
+  /// threads into a read-mostly parent scope (e.g. the scope holding shared
+  /// weights under multi-threaded inference) never contend on a lock.
+  void BuildReadSnapshot() const;
+
  protected:
   struct KeyHasher {
     std::size_t operator()(const std::string& key) const {
@@ -151,6 +160,17 @@ class Scope {
   // Called by FindVarInternal and Var.
   Variable* FindVarLocally(const std::string& name) const;
 
+  // Called by every mutating method while holding the writer lock.
+  void InvalidateReadSnapshot() const;
+
+  using VarSnapshot = paddle::flat_hash_map<std::string, Variable*>;
+
+  // Current lock-free lookup snapshot, nullptr when invalidated. Retired
+  // snapshots are kept alive until scope destruction because concurrent
+  // readers may still hold a pointer into them.
+  mutable std::atomic<const VarSnapshot*> snapshot_{nullptr};
+  mutable std::vector<std::unique_ptr<const VarSnapshot>> retired_snapshots_;
+
   // Scope in `kids_` are owned by this class.
   mutable std::list<Scope*> kids_;
   const Scope* parent_{nullptr};
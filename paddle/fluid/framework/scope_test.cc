@@ -53,6 +53,26 @@ TEST(Scope, FindVar) {
   EXPECT_NE(nullptr, ss.FindVar("a"));
 }
 
+TEST(Scope, ReadSnapshot) {
+  Scope s;
+  Variable* v = s.Var("a");
+
+  s.BuildReadSnapshot();
+  EXPECT_EQ(v, s.FindVar("a"));
+  EXPECT_EQ(nullptr, s.FindVar("b"));
+
+  // Any mutation invalidates the snapshot, so later lookups must observe it.
+  Variable* v2 = s.Var("b");
+  EXPECT_EQ(v2, s.FindVar("b"));
+  EXPECT_EQ(v, s.FindVar("a"));
+
+  s.BuildReadSnapshot();
+  EXPECT_EQ(v2, s.FindVar("b"));
+  s.EraseVars({"b"});
+  EXPECT_EQ(nullptr, s.FindVar("b"));
+  EXPECT_EQ(v, s.FindVar("a"));
+}
+
 TEST(Scope, FindScope) {
   Scope s;
   Scope& ss = s.NewScope();
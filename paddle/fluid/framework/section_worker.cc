@@ -157,6 +157,17 @@ void SectionWorker::Run1F1B(std::unique_ptr<GarbageCollector> &gc) {
   // num_pipeline_stages_ is the total number of pipeline stages and
   // pipeline_stage_ is the pipeline stage of the current device.
   auto startup_steps = num_pipeline_stages_ - pipeline_stage_ - 1;
+  if (max_inflight_microbatches_ > 0 &&
+      startup_steps > max_inflight_microbatches_ - 1) {
+    // The steady state keeps startup_steps + 1 micro batches alive on this
+    // stage, one activation set each. Capping the warmup depth bounds the
+    // activation memory of the stage at the cost of some extra pipeline
+    // bubble: the first backward has to wait for its gradient to travel
+    // through the not yet filled part of the pipeline.
+    VLOG(3) << "cap startup_steps from " << startup_steps << " to "
+            << max_inflight_microbatches_ - 1 << " for activation memory";
+    startup_steps = max_inflight_microbatches_ - 1;
+  }
   VLOG(3) << "startup_steps:" << startup_steps
           << ", num_stages: " << num_pipeline_stages_
           << ", stage:" << pipeline_stage_;
@@ -24,6 +24,25 @@ class Allocation;
 
 namespace paddle {
 namespace framework {
+
+namespace {
+// Storage for scalars and tiny tensors kept inside the Allocation object
+// itself. A small CPU tensor then costs one std::make_shared node (data,
+// Allocation and control block in a single heap chunk) and never goes
+// through the allocator facade. Sharing semantics are unchanged because the
+// buffer lives in the reference-counted Allocation, not in the Tensor.
+class SmallTensorAllocation : public memory::allocation::Allocation {
+ public:
+  static constexpr size_t kCapacity = 64;
+
+  explicit SmallTensorAllocation(const platform::Place& place)
+      : memory::allocation::Allocation(buf_, kCapacity, place) {}
+
+ private:
+  alignas(64) char buf_[kCapacity];
+};
+}  // namespace
+
 extern size_t SizeOfType(proto::VarType::Type type);
 void Tensor::check_memory_size() const {
   PADDLE_ENFORCE_NOT_NULL(holder_, platform::errors::PreconditionNotMet(
@@ -75,7 +94,12 @@ void* Tensor::mutable_data(const platform::Place& place,
       holder_->size() < size + offset_) {
     // Reset holder first before re-allocate to save memory
     holder_.reset();
-    holder_ = memory::AllocShared(place, size);
+    if (platform::is_cpu_place(place) &&
+        size <= SmallTensorAllocation::kCapacity) {
+      holder_ = std::make_shared<SmallTensorAllocation>(place);
+    } else {
+      holder_ = memory::AllocShared(place, size);
+    }
     offset_ = 0;
   }
   return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(holder_->ptr()) +
@@ -1140,6 +1140,127 @@ void TensorFromDLPack(const ::DLTensor& dl_tensor, framework::Tensor* dst) {
 #endif
 }
 
+namespace {  // NOLINT
+proto::VarType::Type DLDataTypeToVarType(DLDataType type) {
+  PADDLE_ENFORCE_LE(type.lanes, 1,
+                    platform::errors::Unimplemented(
+                        "Vector type is not supported currently."));
+  switch (type.bits) {
+    case 8:
+      if (type.code == kDLInt) return proto::VarType::INT8;
+      if (type.code == kDLUInt) return proto::VarType::UINT8;
+      break;
+    case 16:
+      if (type.code == kDLInt) return proto::VarType::INT16;
+      if (type.code == kDLFloat) return proto::VarType::FP16;
+      if (type.code == kDLBfloat) return proto::VarType::BF16;
+      break;
+    case 32:
+      if (type.code == kDLInt) return proto::VarType::INT32;
+      if (type.code == kDLFloat) return proto::VarType::FP32;
+      break;
+    case 64:
+      if (type.code == kDLInt) return proto::VarType::INT64;
+      if (type.code == kDLFloat) return proto::VarType::FP64;
+      if (type.code == kDLComplex) return proto::VarType::COMPLEX64;
+      break;
+    case 128:
+      if (type.code == kDLComplex) return proto::VarType::COMPLEX128;
+      break;
+    default:
+      break;
+  }
+  PADDLE_THROW(platform::errors::Unimplemented(
+      "DLDataType code <%d> is illegal when DLDataType.bits is <%d>.",
+      type.code, type.bits));
+}
+
+// DLPack marks a compact row-major layout either with a null strides
+// pointer or with strides that match the cumulative shape products.
+bool IsCompactDLTensor(const ::DLTensor& dl_tensor) {
+  if (dl_tensor.strides == nullptr) return true;
+  int64_t stride = 1;
+  for (int i = dl_tensor.ndim - 1; i >= 0; --i) {
+    if (dl_tensor.shape[i] != 1 && dl_tensor.strides[i] != stride) {
+      return false;
+    }
+    stride *= dl_tensor.shape[i];
+  }
+  return true;
+}
+
+// An allocation that aliases an external DLPack buffer. The producer's
+// deleter runs when the last tensor holding this allocation goes away.
+class DLPackExternalAllocation : public memory::Allocation {
+ public:
+  DLPackExternalAllocation(::DLManagedTensor* src, size_t size,
+                           const platform::Place& place)
+      : memory::Allocation(
+            static_cast<void*>(
+                static_cast<char*>(src->dl_tensor.data) +
+                src->dl_tensor.byte_offset),
+            size, place),
+        src_(src) {}
+
+  ~DLPackExternalAllocation() override {
+    if (src_->deleter != nullptr) {
+      src_->deleter(src_);
+    }
+  }
+
+ private:
+  ::DLManagedTensor* src_;
+};
+}  // namespace
+
+void TensorFromDLPack(::DLManagedTensor* src, framework::Tensor* dst) {
+  const auto& dl_tensor = src->dl_tensor;
+
+  platform::Place place;
+  if (dl_tensor.device.device_type == kDLCPU) {
+    place = platform::CPUPlace();
+  } else if (dl_tensor.device.device_type == kDLGPU) {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    place = platform::CUDAPlace(dl_tensor.device.device_id);
+#else
+    PADDLE_THROW(platform::errors::Unavailable(
+        "DLPack tensors on GPU are not supported in CPU only version."));
+#endif
+  } else if (dl_tensor.device.device_type == kDLCPUPinned) {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    place = platform::CUDAPinnedPlace();
+#else
+    PADDLE_THROW(platform::errors::Unavailable(
+        "DLPack tensors on pinned memory are not supported in CPU only "
+        "version."));
+#endif
+  } else {
+    PADDLE_THROW(platform::errors::Unimplemented(
+        "Unsupported DLPack device type %d.",
+        static_cast<int>(dl_tensor.device.device_type)));
+  }
+
+  if (!IsCompactDLTensor(dl_tensor)) {
+    // Strided producers still go through the copying import; consume the
+    // managed tensor once the data has been copied out.
+    TensorFromDLPack(dl_tensor, dst);
+    if (src->deleter != nullptr) {
+      src->deleter(src);
+    }
+    return;
+  }
+
+  std::vector<int64_t> vec;
+  std::copy(dl_tensor.shape, dl_tensor.shape + dl_tensor.ndim,
+            std::back_inserter(vec));
+  dst->Resize(framework::make_ddim(vec));
+
+  proto::VarType::Type dtype = DLDataTypeToVarType(dl_tensor.dtype);
+  size_t size = static_cast<size_t>(dst->numel()) * dl_tensor.dtype.bits / 8;
+  dst->ResetHolderWithType(
+      std::make_shared<DLPackExternalAllocation>(src, size, place), dtype);
+}
+
 template <typename T>
 std::string format_tensor(const framework::Tensor& tensor) {
   // TODO(zhiqiu): use the print option to format tensor.
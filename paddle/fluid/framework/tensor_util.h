@@ -126,6 +126,15 @@ void TensorIsfiniteV2(const framework::Tensor& tensor, framework::Tensor* out);
 // convert dlpack's DLTensor to tensor
 void TensorFromDLPack(const ::DLTensor& dl_tensor, framework::Tensor* dst);
 
+// Wrap an external DLManagedTensor as tensor storage without copying. The
+// tensor takes ownership of `src` and invokes its deleter when the last
+// holder reference goes away, so the producer's buffer stays alive for as
+// long as the tensor does. Only compact (row-major, stride-less) layouts
+// can be wrapped; strided inputs fall back to a copying import. Per the
+// DLPack capsule protocol the producer must have synchronized the buffer
+// before handing it over.
+void TensorFromDLPack(::DLManagedTensor* src, framework::Tensor* dst);
+
 //
 // The implementation of template functions.
 //
@@ -363,6 +363,31 @@ TEST(TensorFromDLPack, Tensor) {
 #endif
 }
 
+TEST(TensorFromDLPack, ZeroCopy) {
+  std::vector<int> src_vec = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  paddle::framework::Tensor cpu_tensor;
+
+  cpu_tensor.Resize(paddle::framework::make_ddim({3, 3}));
+  paddle::platform::CPUPlace cpu_place;
+  paddle::platform::CPUDeviceContext cpu_ctx(cpu_place);
+  paddle::framework::TensorFromVector<int>(src_vec, cpu_ctx, &cpu_tensor);
+
+  paddle::framework::DLPackTensor dlpack_tensor(cpu_tensor, 1);
+  ::DLManagedTensor* dmt = dlpack_tensor.ToDLManagedTensor();
+
+  paddle::framework::Tensor dst_tensor;
+  paddle::framework::TensorFromDLPack(dmt, &dst_tensor);
+
+  // The imported tensor aliases the producer's buffer.
+  auto cpu_ptr = cpu_tensor.data<int>();
+  auto dst_ptr = dst_tensor.data<int>();
+  EXPECT_EQ(dst_ptr, cpu_ptr);
+  EXPECT_EQ(dst_tensor.type(), paddle::framework::proto::VarType::INT32);
+  for (size_t i = 0; i < 9; ++i) {
+    EXPECT_EQ(dst_ptr[i], cpu_ptr[i]);
+  }
+}
+
 TEST(TensorContainsNAN, CPU) {
   {
     paddle::framework::Tensor src;
@@ -18,6 +18,7 @@
 
 #include "gflags/gflags.h"
 #include "glog/logging.h"
+#include "paddle/fluid/platform/cpu_info.h"
 #include "paddle/fluid/platform/enforce.h"
 
 DEFINE_int32(io_threadpool_size, 100,
@@ -37,8 +38,9 @@ ThreadPool* ThreadPool::GetInstance() {
 
 void ThreadPool::Init() {
   if (threadpool_.get() == nullptr) {
-    // TODO(Yancey1989): specify the max threads number
-    int num_threads = std::thread::hardware_concurrency();
+    // size from the cores this process may actually use (affinity mask and
+    // cgroup quota aware), not the raw hardware count
+    int num_threads = static_cast<int>(platform::CpuAvailableCoreCount());
     if (FLAGS_dist_threadpool_size > 0) {
       num_threads = FLAGS_dist_threadpool_size;
       VLOG(1) << "set dist_threadpool_size to " << num_threads;
@@ -120,6 +120,15 @@ static inline std::shared_ptr<imperative::VarBase> CastToType(
     const std::shared_ptr<VarBase>& var,
     const framework::proto::VarType::Type dst_type) {
   const auto& tracer = imperative::GetCurrentTracer();
+  // A var shared by several ops (e.g. a weight) is cast at most once per
+  // iteration: the memoized copy stays valid until the source tensor is
+  // modified inplace, e.g. by the optimizer update.
+  auto cached = var->SharedVar()->GetAmpCastCache(dst_type, tracer->HasGrad());
+  if (cached) {
+    VLOG(5) << "Reuse the cast cache of " << var->Name() << " for "
+            << framework::DataTypeToString(dst_type);
+    return cached;
+  }
   imperative::NameVarBaseMap ins = {{"X", {var}}};
   framework::AttributeMap attrs = {{"in_dtype", var->DataType()},
                                    {"out_dtype", dst_type}};
@@ -132,6 +141,7 @@ static inline std::shared_ptr<imperative::VarBase> CastToType(
     tracer->TraceOp("cast", ins, outs, std::move(attrs));
   }
 
+  var->SharedVar()->SetAmpCastCache(dst_type, tracer->HasGrad(), out);
   return out;
 }
 
@@ -15,7 +15,11 @@
 #include "paddle/fluid/imperative/basic_engine.h"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <sstream>
 #include <string>
@@ -24,14 +28,19 @@
 #include <utility>
 #include <vector>
 
+#include "ThreadPool.h"
+
 #include "paddle/fluid/imperative/gradient_accumulator.h"
 #include "paddle/fluid/imperative/layer.h"
 #include "paddle/fluid/imperative/op_base.h"
+#include "paddle/fluid/imperative/recompute_segment.h"
 #include "paddle/fluid/imperative/tracer.h"
 #include "paddle/fluid/operators/math/math_function.h"
 #include "paddle/fluid/platform/profiler.h"
 
 DECLARE_bool(sort_sum_gradient);
+DECLARE_int32(imperative_backward_threads);
+DECLARE_int32(imperative_hook_threads);
 
 namespace paddle {
 namespace imperative {
@@ -376,48 +385,61 @@ static void PerformBackwardInplace(const std::string& op_type,
   }
 }
 
-void BasicEngine::Execute() {
-  if (init_nodes_.empty()) {
-    return;
+size_t BasicEngine::ExecuteNode(const std::shared_ptr<GradOpNode>& node) {
+  // Restore the forward activations this node's grad ops read if they
+  // were dropped by a recompute segment. Recompute() is idempotent, so
+  // only the first node of a segment actually replays the forward ops.
+  if (node->GetRecomputeSegment() &&
+      node->GetRecomputeSegment()->NeedRecompute()) {
+    node->GetRecomputeSegment()->Recompute();
   }
 
-  PrepareDeps();
-  // Start execute Computation graph
-  std::queue<std::shared_ptr<GradOpNode>> q;
-  for (size_t i = 0; i < init_nodes_.size(); ++i) {
-    if (node_deps_[init_nodes_[i].get()] == 0) {
-      q.push(std::move(init_nodes_[i]));
-    }
-  }
+  auto& inplace_grad_name_map = node->InplaceGradNameMap();
 
-  size_t op_num = 0;
+  // The output grad var of Inplace grad op. Because Inplace grad op does not
+  // use the Inplace strategy, a new output grad var needs to be created.
+  std::vector<std::pair<std::shared_ptr<VariableWrapper>,
+                        std::shared_ptr<VariableWrapper>>>
+      inplace_output_grad_var_list;
+  std::vector<std::pair<GradientAccumulator*, std::shared_ptr<VariableWrapper>>>
+      need_accu_var_list;
+  // leaf_accumulators is only for leaf tensor(hooks/accumulate grad)
+  // It should be orderly and not repeated, because multiple cards must ensure
+  // that the order of vars is the same.
+  std::vector<GradientAccumulator*> leaf_accumulators;
 
-  while (!q.empty()) {
-    auto shared_cur_node = std::move(q.front());
-    q.pop();
+  size_t op_num = 0;
 
-    auto& inplace_grad_name_map = shared_cur_node->InplaceGradNameMap();
+  for (auto& cur_op : *node) {
+    platform::RecordEvent op_type_record_event(cur_op.Type());
 
-    for (auto& cur_op : *shared_cur_node) {
-      platform::RecordEvent op_type_record_event(cur_op.Type());
+    ++op_num;
 
-      ++op_num;
+    {
+      // Zero-filling ungenerated grad inputs and preparing temporary
+      // outputs read and mutate shared accumulator state, keep both under
+      // the accumulation lock when nodes run in parallel.
+      std::lock_guard<std::mutex> guard(accumulation_mutex_);
 
       // CheckBackWardInput
       CheckBackwardInputs(cur_op);
+    }
+
+    // Step 1: Run Backward OP
+    auto& bwd_ins = cur_op.GetInsMap();
+    auto& bwd_outs = cur_op.GetOutsMap();
 
-      // Step 1: Run Backward OP
-      auto& bwd_ins = cur_op.GetInsMap();
-      auto& bwd_outs = cur_op.GetOutsMap();
+    /**
+     * [ Why need temporary outputs here? ]
+     *
+     * - construct the temp output map, avoid to disrupt graph
+     * - replace the element in the map by temp var, because a
+     *   var may be coresponding to several grad var in one op
+     */
+    NameVarMap<VariableWrapper> tmp_outs(bwd_outs);
 
-      /**
-       * [ Why need temporary outputs here? ]
-       *
-       * - construct the temp output map, avoid to disrupt graph
-       * - replace the element in the map by temp var, because a
-       *   var may be coresponding to several grad var in one op
-       */
-      NameVarMap<VariableWrapper> tmp_outs(bwd_outs);
+    {
+      std::lock_guard<std::mutex> guard(accumulation_mutex_);
 
       for (auto& pair : tmp_outs) {
         if (!pair.second.IsGrad()) {
@@ -444,8 +466,7 @@ void BasicEngine::Execute() {
             bool flag_find_grad = false;
             VLOG(10) << "Find gradient of var (" << var->Name()
                      << ") with grad_node.";
-            for (auto& grad_pending_node :
-                 shared_cur_node->GradPendingNodes()) {
+            for (auto& grad_pending_node : node->GradPendingNodes()) {
               const auto& iter_grad_node =
                   accumulators_with_grad_node_.find(grad_pending_node);
               if (iter_grad_node != accumulators_with_grad_node_.end()) {
@@ -462,12 +483,12 @@ void BasicEngine::Execute() {
                     "Cannot find gradient of variable %s", var->Name()));
           }
 
-          // leaf_accumulators_ : hooks and accumulate-grad for leaf tensor,
+          // leaf_accumulators : hooks and accumulate-grad for leaf tensor,
           // it should be orderly and not reapeated.
           if (var->IsLeafGrad()) {
-            if (std::find(leaf_accumulators_.begin(), leaf_accumulators_.end(),
-                          iter->second.get()) == leaf_accumulators_.end()) {
-              leaf_accumulators_.push_back(iter->second.get());
+            if (std::find(leaf_accumulators.begin(), leaf_accumulators.end(),
+                          iter->second.get()) == leaf_accumulators.end()) {
+              leaf_accumulators.push_back(iter->second.get());
             }
 
             if (iter->second->HasInnerVar()) {
@@ -480,7 +501,7 @@ void BasicEngine::Execute() {
             tmp_var->SetType(var->Type());
             tmp_var->SetForwardDataType(var->ForwardDataType());
             var = tmp_var;
-            need_accu_var_list_.emplace_back(iter->second.get(), var);
+            need_accu_var_list.emplace_back(iter->second.get(), var);
             VLOG(10) << "create temporary var of " << var->Name()
                      << " for sum gradient within this graph!";
           } else if (!inplace_grad_name_map.empty() &&
@@ -495,7 +516,7 @@ void BasicEngine::Execute() {
                 auto tmp_var = std::make_shared<VariableWrapper>(var->Name());
                 tmp_var->SetType(var->Type());
                 tmp_var->SetForwardDataType(var->ForwardDataType());
-                inplace_output_grad_var_list_.emplace_back(var, tmp_var);
+                inplace_output_grad_var_list.emplace_back(var, tmp_var);
                 var = tmp_var;
                 VLOG(10) << "Inplace grad op does not use the Inplace "
                             "strategy, a temporary output var ("
@@ -506,83 +527,109 @@ void BasicEngine::Execute() {
           }
         }
       }
+    }
 
-      VLOG(4) << "Check whether there is any inplace operation affecting "
-                 "gradient calculation.";
-      for (auto& pair : bwd_ins) {
-        for (auto& var_wrapper : pair.second) {
-          auto wrapper_version_snapshot = var_wrapper->InplaceVersionSnapshot();
-          auto tensor_version =
-              var_wrapper->MutableVar()->CurrentInplaceVersion();
-          PADDLE_ENFORCE_EQ(
-              tensor_version, wrapper_version_snapshot,
-              platform::errors::PermissionDenied(
-                  "Tensor '%s' used in gradient computation in grad op '%s' "
-                  "has been "
-                  "modified by an inplace operation. "
-                  "Its version is %s but the expected version is %s. "
-                  "Please fix your code to void calling an inplace operator "
-                  "after using the Tensor which will used in gradient "
-                  "computation.",
-                  var_wrapper->Name(), cur_op.Type(), tensor_version,
-                  wrapper_version_snapshot));
-
-          VLOG(6) << " The version of Tensor '" << var_wrapper->Name()
-                  << "' is [ " << wrapper_version_snapshot << " ]";
-        }
+    VLOG(4) << "Check whether there is any inplace operation affecting "
+               "gradient calculation.";
+    for (auto& pair : bwd_ins) {
+      for (auto& var_wrapper : pair.second) {
+        auto wrapper_version_snapshot = var_wrapper->InplaceVersionSnapshot();
+        auto tensor_version =
+            var_wrapper->MutableVar()->CurrentInplaceVersion();
+        PADDLE_ENFORCE_EQ(
+            tensor_version, wrapper_version_snapshot,
+            platform::errors::PermissionDenied(
+                "Tensor '%s' used in gradient computation in grad op '%s' "
+                "has been "
+                "modified by an inplace operation. "
+                "Its version is %s but the expected version is %s. "
+                "Please fix your code to void calling an inplace operator "
+                "after using the Tensor which will used in gradient "
+                "computation.",
+                var_wrapper->Name(), cur_op.Type(), tensor_version,
+                wrapper_version_snapshot));
+
+        VLOG(6) << " The version of Tensor '" << var_wrapper->Name()
+                << "' is [ " << wrapper_version_snapshot << " ]";
       }
+    }
 
-      /**
-       * [ Why need temporary inputs here? ]
-       *
-       * - Hook execution should not change original input tensor.
-       *   User can register hook for Tensor's gradient, It is expected
-       *   that the hook only affects the gradient of the backward
-       *   propagation, and does not affect the gradient value input
-       *   as the hook.
-       * - use `tmp_ins_ptr`, only copy bwd_ins when the var in bwd_ins
-       *   hold hooks
-       */
-      auto tmp_ins_ptr = CallGradientHooks(bwd_ins, cur_op.Type());
-
-      if (!tmp_ins_ptr) {
-        PerformBackwardInplace(cur_op.Type(), bwd_ins, &tmp_outs);
-      }
+    /**
+     * [ Why need temporary inputs here? ]
+     *
+     * - Hook execution should not change original input tensor.
+     *   User can register hook for Tensor's gradient, It is expected
+     *   that the hook only affects the gradient of the backward
+     *   propagation, and does not affect the gradient value input
+     *   as the hook.
+     * - use `tmp_ins_ptr`, only copy bwd_ins when the var in bwd_ins
+     *   hold hooks
+     */
+    auto tmp_ins_ptr = CallGradientHooks(bwd_ins, cur_op.Type());
+
+    if (!tmp_ins_ptr) {
+      PerformBackwardInplace(cur_op.Type(), bwd_ins, &tmp_outs);
+    }
 
-      {
-        VLOG(3) << "Start to execute grad op " << cur_op.Type();
-        try {
-          if (tmp_ins_ptr == nullptr) {
-            OpBase::Run(cur_op.InnerOp(), bwd_ins, tmp_outs, cur_op.Attrs(),
-                        cur_op.DefaultAttrsMap(), cur_op.place());
-          } else {
-            OpBase::Run(cur_op.InnerOp(), *tmp_ins_ptr, tmp_outs,
-                        cur_op.Attrs(), cur_op.DefaultAttrsMap(),
-                        cur_op.place());
-          }
-        } catch (platform::EnforceNotMet& exception) {
-          Clear();
-          throw std::move(exception);
-        } catch (std::exception& ex) {
-          Clear();
-          PADDLE_THROW(platform::errors::External("%s", ex.what()));
+    {
+      VLOG(3) << "Start to execute grad op " << cur_op.Type();
+      try {
+        if (tmp_ins_ptr == nullptr) {
+          OpBase::Run(cur_op.InnerOp(), bwd_ins, tmp_outs, cur_op.Attrs(),
+                      cur_op.DefaultAttrsMap(), cur_op.place());
+        } else {
+          OpBase::Run(cur_op.InnerOp(), *tmp_ins_ptr, tmp_outs, cur_op.Attrs(),
+                      cur_op.DefaultAttrsMap(), cur_op.place());
         }
+      } catch (platform::EnforceNotMet& exception) {
+        throw std::move(exception);
+      } catch (std::exception& ex) {
+        PADDLE_THROW(platform::errors::External("%s", ex.what()));
       }
+    }
+
+    {
+      // Serialize gradient accumulation so that each GradientAccumulator
+      // keeps its per-variable ordering even when nodes run in parallel.
+      std::lock_guard<std::mutex> guard(accumulation_mutex_);
 
-      for (auto& pair : inplace_output_grad_var_list_) {
+      for (auto& pair : inplace_output_grad_var_list) {
         *pair.first = std::move(*pair.second);
       }
 
       // Step 2: Sum Gradient of This graph
-      for (auto& pair : need_accu_var_list_) {
+      for (auto& pair : need_accu_var_list) {
         pair.first->SumGrad(std::move(pair.second), cur_op.id());
       }
 
-      // Step 3: Call Hooks && Sum Gradient with Pre-Graph && Call BackwardHooks
-      for (auto* accumulator : leaf_accumulators_) {
+      // Step 3: Call Hooks && Sum Gradient with Pre-Graph && Call
+      // BackwardHooks
+      for (auto* accumulator : leaf_accumulators) {
         if (!accumulator->SumGradCompleted()) {
           continue;
         }
+        if (FLAGS_imperative_hook_threads > 0 &&
+            !accumulator->HasReduceHooks()) {
+          // The gradient hook chain of a leaf var only touches its own
+          // accumulator, so it can run on a worker and overlap with the
+          // remaining backward graph. Execute waits for every chain
+          // before it returns, so the optimizer always sees the hooked
+          // gradients. Python hooks acquire the GIL themselves.
+          //
+          // Reduce hooks are excluded: they feed the shared DataParallel
+          // Reducer, whose group state and allreduce issue order assume
+          // engine-thread serialization, so accumulators carrying them
+          // run their whole chain inline below.
+          if (hook_pool_ == nullptr) {
+            hook_pool_.reset(new ::ThreadPool(
+                static_cast<size_t>(FLAGS_imperative_hook_threads)));
+          }
+          hook_futures_.emplace_back(hook_pool_->enqueue([accumulator] {
+            accumulator->CallGradientHooks();
+            accumulator->AccumulateGrad();
+          }));
+          continue;
+        }
         // 1. Call Hooks for `inner_var_`
         accumulator->CallGradientHooks();
 
@@ -592,44 +639,196 @@ void BasicEngine::Execute() {
         // 3. Call backward Hooks for `var_`
         accumulator->CallReduceHooks();
       }
+    }
 
-      need_accu_var_list_.clear();
-      inplace_output_grad_var_list_.clear();
-      leaf_accumulators_.clear();
+    need_accu_var_list.clear();
+    inplace_output_grad_var_list.clear();
+    leaf_accumulators.clear();
 
-      if (!retain_graph_) {
-        VLOG(3) << "Remove op after op " << cur_op.Type() << " runs";
-        cur_op.ClearBackwardTrace();
-      }
+    if (!retain_graph_) {
+      VLOG(3) << "Remove op after op " << cur_op.Type() << " runs";
+      cur_op.ClearBackwardTrace();
     }
+  }
 
-    // Step 3: Collect ready ops
-    for (auto& grad_pending_node : shared_cur_node->GradPendingNodes()) {
-      PADDLE_ENFORCE_NOT_NULL(
-          grad_pending_node,
-          platform::errors::NotFound("Grad pending node is nullptr."));
-      auto iter = node_deps_.find(grad_pending_node.get());
-      if (iter == node_deps_.end()) {
-        continue;
+  return op_num;
+}
+
+size_t BasicEngine::ExecuteParallel(
+    std::queue<std::shared_ptr<GradOpNode>>* ready_nodes, size_t num_threads) {
+  ::ThreadPool pool(num_threads);
+
+  std::mutex mutex;  // guards node_deps_, in-flight count and the exception
+  std::condition_variable cv;
+  size_t num_inflight = 0;
+  std::exception_ptr eptr;
+  std::atomic<size_t> op_num{0};
+
+  // Dispatch one node to the pool. A finished worker decrements the
+  // dependency count of its pending nodes and schedules the ones that
+  // became ready, so independent branches of the graph run concurrently.
+  std::function<void(std::shared_ptr<GradOpNode>)> schedule =
+      [&](std::shared_ptr<GradOpNode> node) {
+        {
+          std::lock_guard<std::mutex> guard(mutex);
+          ++num_inflight;
+        }
+        pool.enqueue([&, node] {
+          bool failed;
+          {
+            std::lock_guard<std::mutex> guard(mutex);
+            failed = static_cast<bool>(eptr);
+          }
+          if (!failed) {
+            try {
+              op_num += ExecuteNode(node);
+
+              std::vector<std::shared_ptr<GradOpNode>> next_ready;
+              {
+                std::lock_guard<std::mutex> guard(mutex);
+                for (auto& grad_pending_node : node->GradPendingNodes()) {
+                  PADDLE_ENFORCE_NOT_NULL(grad_pending_node,
+                                          platform::errors::NotFound(
+                                              "Grad pending node is nullptr."));
+                  auto iter = node_deps_.find(grad_pending_node.get());
+                  if (iter == node_deps_.end()) {
+                    continue;
+                  }
+                  if (--(iter->second) == 0) {
+                    next_ready.emplace_back(grad_pending_node);
+                  }
+                }
+              }
+              for (auto& next_node : next_ready) {
+                schedule(std::move(next_node));
+              }
+            } catch (...) {
+              std::lock_guard<std::mutex> guard(mutex);
+              if (!eptr) {
+                eptr = std::current_exception();
+              }
+            }
+          }
+          {
+            std::lock_guard<std::mutex> guard(mutex);
+            --num_inflight;
+          }
+          cv.notify_one();
+        });
+      };
+
+  while (!ready_nodes->empty()) {
+    schedule(std::move(ready_nodes->front()));
+    ready_nodes->pop();
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&] { return num_inflight == 0; });
+  }
+
+  if (eptr) {
+    Clear();
+    std::rethrow_exception(eptr);
+  }
+
+  return op_num;
+}
+
+void BasicEngine::Execute() {
+  if (init_nodes_.empty()) {
+    return;
+  }
+
+  PrepareDeps();
+  // Start execute Computation graph
+  std::queue<std::shared_ptr<GradOpNode>> q;
+  for (size_t i = 0; i < init_nodes_.size(); ++i) {
+    if (node_deps_[init_nodes_[i].get()] == 0) {
+      q.push(std::move(init_nodes_[i]));
+    }
+  }
+
+  size_t op_num = 0;
+
+  if (FLAGS_imperative_backward_threads > 1) {
+    VLOG(3) << "Execute backward in parallel with "
+            << FLAGS_imperative_backward_threads << " threads";
+    op_num = ExecuteParallel(
+        &q, static_cast<size_t>(FLAGS_imperative_backward_threads));
+  } else {
+    while (!q.empty()) {
+      auto shared_cur_node = std::move(q.front());
+      q.pop();
+
+      try {
+        op_num += ExecuteNode(shared_cur_node);
+      } catch (...) {
+        Clear();
+        throw;
       }
 
-      if (--(iter->second) == 0) {
-        q.push(grad_pending_node);
+      // Collect ready ops
+      for (auto& grad_pending_node : shared_cur_node->GradPendingNodes()) {
+        PADDLE_ENFORCE_NOT_NULL(
+            grad_pending_node,
+            platform::errors::NotFound("Grad pending node is nullptr."));
+        auto iter = node_deps_.find(grad_pending_node.get());
+        if (iter == node_deps_.end()) {
+          continue;
+        }
+
+        if (--(iter->second) == 0) {
+          q.push(grad_pending_node);
+        }
       }
     }
   }
+
+  // Completion barrier: every asynchronous leaf hook chain must have
+  // finished before backward returns and the optimizer reads the
+  // gradients.
+  try {
+    WaitAsyncHooks();
+  } catch (...) {
+    Clear();
+    throw;
+  }
   Clear();
 
   VLOG(1) << "Backward op number: " << op_num;
 }
 
+void BasicEngine::WaitAsyncHooks() {
+  std::exception_ptr eptr;
+  for (auto& future : hook_futures_) {
+    try {
+      future.get();
+    } catch (...) {
+      if (!eptr) {
+        eptr = std::current_exception();
+      }
+    }
+  }
+  hook_futures_.clear();
+  if (eptr) {
+    std::rethrow_exception(eptr);
+  }
+}
+
 void BasicEngine::Clear() {
+  // Wait for in-flight asynchronous hook chains before the accumulators
+  // they reference are destroyed. Exceptions were either collected by
+  // WaitAsyncHooks already or are lost to the error being handled.
+  for (auto& future : hook_futures_) {
+    future.wait();
+  }
+  hook_futures_.clear();
+
   init_nodes_.clear();
   node_deps_.clear();
   accumulators_.clear();
   accumulators_with_grad_node_.clear();
-  need_accu_var_list_.clear();
-  leaf_accumulators_.clear();
 }
 
 }  // namespace imperative
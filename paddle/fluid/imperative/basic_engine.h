@@ -14,7 +14,11 @@
 
 #pragma once
 
+#include <ThreadPool.h>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <queue>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -39,6 +43,25 @@ class BasicEngine : public Engine {
  private:
   void PrepareDeps();
 
+  // Run all grad ops of one node, returns the number of ops executed.
+  // Reads of the accumulator maps are lock-free (they are frozen after
+  // PrepareDeps); everything that mutates shared gradient state runs
+  // under accumulation_mutex_, so independent nodes may execute on
+  // different threads.
+  size_t ExecuteNode(const std::shared_ptr<GradOpNode>& node);
+
+  // Dependency-counted execution of the whole graph on a thread pool:
+  // ready nodes are dispatched to workers and a node becomes ready when
+  // its last pending dependency completes, like the static-graph
+  // FastThreadedSSAGraphExecutor. Returns the number of ops executed.
+  size_t ExecuteParallel(std::queue<std::shared_ptr<GradOpNode>>* ready_nodes,
+                         size_t num_threads);
+
+  // Completion barrier for the asynchronous leaf hook chains dispatched
+  // when FLAGS_imperative_hook_threads > 0; rethrows the first hook
+  // exception after all chains finished.
+  void WaitAsyncHooks();
+
   void CheckBackwardInputs(const OpBase& op);
 
   void PrepareGradAccumulators(
@@ -63,17 +86,19 @@ class BasicEngine : public Engine {
   // `var` as the key.
   std::unordered_map<VariableWrapper*, std::unique_ptr<GradientAccumulator>>
       accumulators_;
-  // The output grad var of Inplace grad op. Because Inplace grad op does not
-  // use the Inplace strategy, a new output grad var needs to be created.
-  std::vector<std::pair<std::shared_ptr<VariableWrapper>,
-                        std::shared_ptr<VariableWrapper>>>
-      inplace_output_grad_var_list_;
-  std::vector<std::pair<GradientAccumulator*, std::shared_ptr<VariableWrapper>>>
-      need_accu_var_list_;
-  // leaf_accumulators_ is only for leaf tensor(hooks/accumulate grad)
-  // It should be orderly and not repeated, because multiple cards must ensure
-  // that the order of vars is the same.
-  std::vector<GradientAccumulator*> leaf_accumulators_;
+  // Serializes every mutation of shared gradient state (zero-filling of
+  // ungenerated grad inputs, temporary output preparation and gradient
+  // accumulation), so that each GradientAccumulator keeps its
+  // per-variable ordering even when nodes run in parallel. Only the grad
+  // kernels themselves and the input hooks run outside of it.
+  std::mutex accumulation_mutex_;
+
+  // Worker pool running the leaf hook chains (gradient hooks,
+  // cross-batch accumulation and reduce hooks) asynchronously when
+  // FLAGS_imperative_hook_threads > 0. Both members are only mutated
+  // under accumulation_mutex_ or after all workers finished.
+  std::unique_ptr<::ThreadPool> hook_pool_;
+  std::vector<std::future<void>> hook_futures_;
 
   bool retain_graph_;
 };
@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "paddle/fluid/imperative/layer.h"
+#include "paddle/fluid/imperative/object_pool.h"
 #include "paddle/fluid/imperative/op_base.h"
 #include "paddle/fluid/imperative/type_defs.h"
 #include "paddle/fluid/platform/enforce.h"
@@ -150,7 +151,10 @@ class GradOpBaseMakerBase {
   }
 
   static std::shared_ptr<GradOpNode> NewGradNode() {
-    return std::make_shared<GradOpNode>();
+    // Grad nodes are created for every traced op and die at backward
+    // completion, so recycle them through the pool instead of hammering
+    // the global allocator.
+    return ObjectPool<GradOpNode>::Acquire();
   }
 
   const std::map<std::string, std::string>& GetInplaceMap() const {
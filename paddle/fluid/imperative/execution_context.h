@@ -114,6 +114,14 @@ class DygraphExecutionContext : public framework::ExecutionContext {
     return it->second;
   }
 
+  // The dygraph context keeps its attributes in attrs_/default_attrs_
+  // rather than in the wrapped operator, so the interned fast path has to
+  // fall back to the string lookup on those maps.
+  const framework::Attribute& GetAttr(
+      const framework::InternedAttrName& name) const override {
+    return GetAttr(name.name());
+  }
+
   std::vector<std::string> InNameList() const override {
     std::vector<std::string> vec_temp;
     vec_temp.reserve(var_base_map_in_.size());
@@ -18,6 +18,7 @@
 #include <memory>
 #include <utility>
 
+#include "paddle/fluid/framework/data_type.h"
 #include "paddle/fluid/framework/lod_tensor.h"
 #include "paddle/fluid/framework/selected_rows.h"
 #include "paddle/fluid/imperative/layer.h"
@@ -31,6 +32,10 @@
 #ifdef PADDLE_WITH_XPU
 #include "xpu/refactor/math.h"
 #endif
+#ifdef PADDLE_WITH_MKLDNN
+#include "paddle/fluid/operators/mkldnn/axpy_handler.h"
+#include "paddle/fluid/platform/bfloat16.h"
+#endif
 #ifdef PADDLE_WITH_ASCEND_CL
 #include "paddle/fluid/operators/npu_op_runner.h"
 #endif
@@ -283,6 +288,19 @@ void TensorAdd(const framework::Variable& src, framework::Variable* dst) {
 
 #undef PADDLE_TENSOR_ADD
 
+#ifdef PADDLE_WITH_MKLDNN
+  if (data_type == framework::DataTypeTrait<platform::bfloat16>::DataType() &&
+      platform::is_cpu_place(place)) {
+    // Accumulate src into dst in place with a single oneDNN reorder carrying
+    // a sum post-op; no intermediate tensor is materialized.
+    operators::OneDNNAXPYHandler<platform::bfloat16> axpy(
+        numel, platform::bfloat16(1.0f));
+    axpy(src_tensor.data<platform::bfloat16>(),
+         dst_tensor->mutable_data<platform::bfloat16>(place));
+    return;
+  }
+#endif
+
   if (data_type == framework::proto::VarType::FP16) {
     if (platform::is_gpu_place(place)) {
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
@@ -641,6 +659,111 @@ void EagerGradientAccumulator::SumGrad(std::shared_ptr<VariableWrapper> var,
   IncreaseCurCnt();
 }
 
+struct FusedDenseSumForCPU {
+  FusedDenseSumForCPU(const std::vector<const framework::Tensor*>& srcs,
+                      framework::Tensor* dst)
+      : srcs_(srcs), dst_(dst) {}
+
+  template <typename T>
+  void apply() const {
+    std::vector<const T*> src_data;
+    src_data.reserve(srcs_.size());
+    for (auto* src : srcs_) {
+      src_data.emplace_back(src->data<T>());
+    }
+    auto* dst_data = dst_->data<T>();
+    int64_t numel = dst_->numel();
+    for (int64_t i = 0; i < numel; ++i) {
+      T sum = src_data[0][i];
+      for (size_t j = 1; j < src_data.size(); ++j) {
+        sum += src_data[j][i];
+      }
+      dst_data[i] = sum;
+    }
+  }
+
+  const std::vector<const framework::Tensor*>& srcs_;
+  framework::Tensor* dst_;
+};
+
+void FusedDenseSumCPU(const std::vector<const framework::Tensor*>& srcs,
+                      framework::Tensor* dst) {
+  framework::VisitDataTypeSmall(dst->type(), FusedDenseSumForCPU(srcs, dst));
+}
+
+bool SortedGradientAccumulator::TryFusedDenseSum(VariableWrapper* dst_var) {
+  if (CurCnt() != 0) {
+    // the destination already holds a partial sum of this graph
+    return false;
+  }
+
+  std::vector<const framework::Tensor*> srcs;
+  srcs.reserve(tmp_grad_vars_.size());
+  for (auto& var_info : tmp_grad_vars_) {
+    if (!var_info.var) {
+      continue;
+    }
+    if (!var_info.var->Var().IsType<framework::LoDTensor>()) {
+      return false;
+    }
+    auto& tensor = var_info.var->Var().Get<framework::LoDTensor>();
+    if (!tensor.IsInitialized()) {
+      return false;
+    }
+    srcs.emplace_back(&tensor);
+  }
+  if (srcs.size() < 2) {
+    return false;
+  }
+
+  auto dtype = srcs[0]->type();
+  if (dtype != framework::proto::VarType::FP32 &&
+      dtype != framework::proto::VarType::FP64) {
+    return false;
+  }
+  auto sum_place = srcs[0]->place();
+  for (size_t i = 1; i < srcs.size(); ++i) {
+    if (srcs[i]->type() != dtype || srcs[i]->numel() != srcs[0]->numel() ||
+        !platform::is_same_place(srcs[i]->place(), sum_place)) {
+      return false;
+    }
+  }
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (!platform::is_cpu_place(sum_place) &&
+      !platform::is_gpu_place(sum_place)) {
+    return false;
+  }
+#else
+  if (!platform::is_cpu_place(sum_place)) {
+    return false;
+  }
+#endif
+
+  auto* dst_tensor = dst_var->MutableVar()->GetMutable<framework::LoDTensor>();
+  dst_tensor->Resize(srcs[0]->dims());
+  dst_tensor->set_lod(srcs[0]->lod());
+  dst_tensor->mutable_data(sum_place, dtype);
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (platform::is_gpu_place(sum_place)) {
+    FusedDenseSumGPU(srcs, dst_tensor);
+  } else {
+    FusedDenseSumCPU(srcs, dst_tensor);
+  }
+#else
+  FusedDenseSumCPU(srcs, dst_tensor);
+#endif
+  VLOG(6) << "Fuse " << srcs.size() << " dense gradient contributions of "
+          << dst_var->Name() << " into one sum pass";
+
+  for (auto& var_info : tmp_grad_vars_) {
+    if (var_info.var) {
+      var_info.var = nullptr;
+      IncreaseCurCnt();
+    }
+  }
+  return true;
+}
+
 void SortedGradientAccumulator::SumGrad(std::shared_ptr<VariableWrapper> var,
                                         size_t trace_id, bool unchange_input) {
   auto* dst_var = Var();
@@ -693,46 +816,54 @@ void SortedGradientAccumulator::SumGrad(std::shared_ptr<VariableWrapper> var,
           IncreaseCurCnt();
         }
 
-        for (auto& var_info : tmp_grad_vars_) {
-          if (!var_info.var) {
-            continue;
-          }
-
-          PADDLE_ENFORCE_EQ(var_info.var->Var().IsType<framework::LoDTensor>(),
-                            true, platform::errors::PermissionDenied(
-                                      "Gradient var must be LoDTensor"));
-          if (CurCnt() == 0) {
-            MoveOrCopyVar(dst_var->MutableVar(), var_info.var->MutableVar(),
-                          var_info.unchange_input);
-          } else {
-            VariableWrapperAdd(var_info.var, dst_var, var_info.unchange_input);
+        if (!TryFusedDenseSum(dst_var)) {
+          for (auto& var_info : tmp_grad_vars_) {
+            if (!var_info.var) {
+              continue;
+            }
+
+            PADDLE_ENFORCE_EQ(
+                var_info.var->Var().IsType<framework::LoDTensor>(), true,
+                platform::errors::PermissionDenied(
+                    "Gradient var must be LoDTensor"));
+            if (CurCnt() == 0) {
+              MoveOrCopyVar(dst_var->MutableVar(), var_info.var->MutableVar(),
+                            var_info.unchange_input);
+            } else {
+              VariableWrapperAdd(var_info.var, dst_var,
+                                 var_info.unchange_input);
+            }
+
+            var_info.var = nullptr;
+            // Increase count
+            IncreaseCurCnt();
           }
-
-          var_info.var = nullptr;
-          // Increase count
-          IncreaseCurCnt();
         }
       } else {
 #endif
-        for (auto& var_info : tmp_grad_vars_) {
-          if (!var_info.var) {
-            continue;
-          }
-          PADDLE_ENFORCE_EQ(
-              var_info.var->Var().IsType<framework::LoDTensor>() ||
-                  var_info.var->Var().IsType<framework::SelectedRows>(),
-              true, platform::errors::PermissionDenied("The type of Gradient "
-                                                       "var must be LoDTensor "
-                                                       "or SelectedRows"));
-          if (CurCnt() == 0) {
-            MoveOrCopyVar(dst_var->MutableVar(), var_info.var->MutableVar(),
-                          var_info.unchange_input);
-          } else {
-            VariableWrapperAdd(var_info.var, dst_var, var_info.unchange_input);
+        if (!TryFusedDenseSum(dst_var)) {
+          for (auto& var_info : tmp_grad_vars_) {
+            if (!var_info.var) {
+              continue;
+            }
+            PADDLE_ENFORCE_EQ(
+                var_info.var->Var().IsType<framework::LoDTensor>() ||
+                    var_info.var->Var().IsType<framework::SelectedRows>(),
+                true, platform::errors::PermissionDenied(
+                          "The type of Gradient "
+                          "var must be LoDTensor "
+                          "or SelectedRows"));
+            if (CurCnt() == 0) {
+              MoveOrCopyVar(dst_var->MutableVar(), var_info.var->MutableVar(),
+                            var_info.unchange_input);
+            } else {
+              VariableWrapperAdd(var_info.var, dst_var,
+                                 var_info.unchange_input);
+            }
+            var_info.var = nullptr;
+            // Increase count
+            IncreaseCurCnt();
           }
-          var_info.var = nullptr;
-          // Increase count
-          IncreaseCurCnt();
         }
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
       }
@@ -0,0 +1,82 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/imperative/gradient_accumulator.h"
+
+#include <vector>
+
+#include "paddle/fluid/framework/data_type.h"
+#include "paddle/fluid/memory/malloc.h"
+#include "paddle/fluid/memory/memcpy.h"
+#include "paddle/fluid/platform/device_context.h"
+
+namespace paddle {
+namespace imperative {
+
+template <typename T>
+__global__ void FusedDenseSumCUDAKernel(const T **srcs, T *dst, int64_t numel,
+                                        size_t src_num) {
+  for (int64_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < numel;
+       idx += static_cast<int64_t>(gridDim.x) * blockDim.x) {
+    T sum = srcs[0][idx];
+    for (size_t j = 1; j < src_num; ++j) {
+      sum += srcs[j][idx];
+    }
+    dst[idx] = sum;
+  }
+}
+
+struct FusedDenseSumForGPU {
+  FusedDenseSumForGPU(const std::vector<const framework::Tensor *> &srcs,
+                      framework::Tensor *dst)
+      : srcs_(srcs), dst_(dst) {}
+
+  template <typename T>
+  void apply() const {
+    auto place = BOOST_GET_CONST(platform::CUDAPlace, dst_->place());
+    auto *dev_ctx = static_cast<platform::CUDADeviceContext *>(
+        platform::DeviceContextPool::Instance().Get(place));
+
+    std::vector<const T *> src_data;
+    src_data.reserve(srcs_.size());
+    for (auto *src : srcs_) {
+      src_data.emplace_back(src->data<T>());
+    }
+
+    // ship the source pointer array to the device, like sum_op.cu does
+    auto src_ptr_bytes = src_data.size() * sizeof(const T *);
+    auto tmp_src_ptrs = memory::Alloc(*dev_ctx, src_ptr_bytes);
+    memory::Copy(place, tmp_src_ptrs->ptr(), platform::CPUPlace(),
+                 src_data.data(), src_ptr_bytes, dev_ctx->stream());
+
+    int64_t numel = dst_->numel();
+    constexpr int64_t kThreadsPerBlock = 512;
+    int64_t grids = (numel + kThreadsPerBlock - 1) / kThreadsPerBlock;
+    FusedDenseSumCUDAKernel<T><<<grids, kThreadsPerBlock, 0,
+                                 dev_ctx->stream()>>>(
+        reinterpret_cast<const T **>(tmp_src_ptrs->ptr()), dst_->data<T>(),
+        numel, src_data.size());
+  }
+
+  const std::vector<const framework::Tensor *> &srcs_;
+  framework::Tensor *dst_;
+};
+
+void FusedDenseSumGPU(const std::vector<const framework::Tensor *> &srcs,
+                      framework::Tensor *dst) {
+  framework::VisitDataTypeSmall(dst->type(), FusedDenseSumForGPU(srcs, dst));
+}
+
+}  // namespace imperative
+}  // namespace paddle
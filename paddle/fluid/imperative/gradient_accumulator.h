@@ -18,12 +18,27 @@
 #include <utility>
 #include <vector>
 
+#include "paddle/fluid/framework/tensor.h"
 #include "paddle/fluid/imperative/hooks.h"
 #include "paddle/fluid/imperative/layer.h"
 
 namespace paddle {
 namespace imperative {
 
+// Fused N-way dense gradient sum: writes every element of `dst` exactly
+// once from the contributions in `srcs`, instead of accumulating them
+// pairwise with N-1 full passes over the tensor. All tensors must hold
+// the same number of elements of the same dtype and `dst` must already
+// be allocated on the same place as the sources.
+void FusedDenseSumCPU(const std::vector<const framework::Tensor*>& srcs,
+                      framework::Tensor* dst);
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+// Single-kernel CUDA implementation, defined in gradient_accumulator.cu.
+void FusedDenseSumGPU(const std::vector<const framework::Tensor*>& srcs,
+                      framework::Tensor* dst);
+#endif
+
 class GradientAccumulator {
  public:
   explicit GradientAccumulator(VariableWrapper* var) {
@@ -123,6 +138,9 @@ class GradientAccumulator {
 
   void CallReduceHooks();
 
+  // Whether any reduce / allreduce hook is registered on the leaf var.
+  bool HasReduceHooks() const { return var_->HasVoidHook(); }
+
  protected:
   VariableWrapper* var_;
   // NOTE: only gradient accumulater of leaf tensor should hold
@@ -148,6 +166,13 @@ class SortedGradientAccumulator : public GradientAccumulator {
                bool unchange_input) override;
 
  private:
+  // Sum all pending dense contributions in tmp_grad_vars_ into `dst_var`
+  // with one fused pass (see FusedDenseSumCPU/GPU) and mark them as
+  // processed. Returns false and leaves the destination untouched when
+  // the fused path does not apply, in which case the caller falls back
+  // to pairwise accumulation.
+  bool TryFusedDenseSum(VariableWrapper* dst_var);
+
   struct SavedVarInfo {
     SavedVarInfo(std::shared_ptr<VariableWrapper>&& v, size_t id,
                  bool enable_unchange_input)
@@ -0,0 +1,240 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/imperative/jit/hot_loop_capturer.h"
+
+#include <functional>
+#include <utility>
+
+#include "paddle/fluid/framework/new_executor/standalone_executor.h"
+#include "paddle/fluid/framework/scope.h"
+#include "paddle/fluid/imperative/layer.h"
+
+namespace paddle {
+namespace imperative {
+namespace jit {
+
+static size_t CombineHash(size_t seed, size_t value) {
+  return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+HotLoopCapturer::~HotLoopCapturer() = default;
+
+void HotLoopCapturer::NoteOp(const std::string& type,
+                             const NameVarBaseMap& ins,
+                             const NameVarBaseMap& outs, bool require_grad) {
+  size_t sig = std::hash<std::string>()(type);
+  for (auto& pair : ins) {
+    sig = CombineHash(sig, std::hash<std::string>()(pair.first));
+    for (auto& var : pair.second) {
+      if (!var) {
+        continue;
+      }
+      const auto& inner_var = var->Var();
+      if (inner_var.IsInitialized() &&
+          inner_var.IsType<framework::LoDTensor>()) {
+        const auto& tensor = inner_var.Get<framework::LoDTensor>();
+        if (tensor.IsInitialized()) {
+          sig = CombineHash(sig, static_cast<size_t>(tensor.type()));
+        }
+        for (auto d : framework::vectorize<int64_t>(tensor.dims())) {
+          sig = CombineHash(sig, static_cast<size_t>(d));
+        }
+      }
+    }
+  }
+  cur_signature_ = CombineHash(cur_signature_, sig);
+  if (require_grad) {
+    cur_iter_capturable_ = false;
+  }
+
+  if (state_ == State::kCapturing) {
+    for (auto& pair : ins) {
+      for (auto& var : pair.second) {
+        if (var && produced_vars_.count(var.get()) == 0 &&
+            external_input_set_.insert(var.get()).second) {
+          external_inputs_.emplace_back(var);
+        }
+      }
+    }
+    for (auto& pair : outs) {
+      for (auto& var : pair.second) {
+        if (var) {
+          produced_vars_.insert(var.get());
+          if (output_var_set_.insert(var.get()).second) {
+            output_vars_.emplace_back(var);
+          }
+        }
+      }
+    }
+  }
+}
+
+bool HotLoopCapturer::OnIterationEnd() {
+  size_t sig = cur_signature_;
+  bool capturable = cur_iter_capturable_;
+  cur_signature_ = 0;
+  cur_iter_capturable_ = true;
+
+  switch (state_) {
+    case State::kReady:
+      if (sig != captured_signature_) {
+        VLOG(3) << "Hot loop diverged, drop the captured program and fall "
+                   "back to observing";
+        DropCapture();
+        last_signature_ = sig;
+        repeat_count_ = capturable ? 1 : 0;
+      }
+      return false;
+    case State::kCapturing:
+      // the capture iteration was not recorded (the program desc tracer
+      // was busy with an explicit trace); fall back to observing
+      state_ = State::kObserving;
+      last_signature_ = sig;
+      repeat_count_ = capturable ? 1 : 0;
+      return false;
+    case State::kObserving:
+    default:
+      if (capturable && sig != 0 && sig == last_signature_) {
+        ++repeat_count_;
+      } else {
+        last_signature_ = sig;
+        repeat_count_ = capturable ? 1 : 0;
+      }
+      if (repeat_count_ >= capture_threshold_) {
+        VLOG(3) << "Hot loop detected after " << repeat_count_
+                << " stable iterations, capturing the next one";
+        state_ = State::kCapturing;
+        produced_vars_.clear();
+        external_inputs_.clear();
+        external_input_set_.clear();
+        output_vars_.clear();
+        output_var_set_.clear();
+        return true;
+      }
+      return false;
+  }
+}
+
+void HotLoopCapturer::FinishCapture(ProgramDescTracer* tracer,
+                                    const platform::Place& place) {
+  PADDLE_ENFORCE_EQ(state_ == State::kCapturing, true,
+                    platform::errors::PreconditionNotMet(
+                        "FinishCapture is only valid after OnIterationEnd "
+                        "started a capture iteration."));
+  size_t sig = cur_signature_;
+  bool capturable = cur_iter_capturable_;
+  cur_signature_ = 0;
+  cur_iter_capturable_ = true;
+
+  state_ = State::kObserving;
+  if (!capturable || sig != last_signature_) {
+    VLOG(3) << "Hot loop changed during the capture iteration, fall back to "
+               "observing";
+    last_signature_ = sig;
+    repeat_count_ = capturable ? 1 : 0;
+    return;
+  }
+
+  // only outputs that are still referenced outside the iteration can be
+  // observed after a replay
+  std::vector<std::shared_ptr<VarBase>> fetch_vars;
+  for (auto& weak_var : output_vars_) {
+    auto var = weak_var.lock();
+    if (var) {
+      fetch_vars.emplace_back(std::move(var));
+    }
+  }
+
+  auto traced = tracer->CreateProgramDesc(external_inputs_, "feed_",
+                                          fetch_vars, "fetch_", "tmp_");
+  program_ = std::move(std::get<0>(traced));
+  feed_names_ = std::move(std::get<1>(traced));
+  fetch_names_ = std::move(std::get<2>(traced));
+  persistable_vars_ = std::move(std::get<3>(traced));
+  place_ = place;
+
+  startup_program_.reset(new framework::ProgramDesc());
+  scope_.reset(new framework::Scope());
+  for (auto& var : persistable_vars_) {
+    const auto& src = var->Var().Get<framework::LoDTensor>();
+    auto* dst = scope_->Var(var->Name())->GetMutable<framework::LoDTensor>();
+    dst->ShareDataWith(src);
+    dst->set_lod(src.lod());
+  }
+  executor_.reset(new framework::StandaloneExecutor(
+      place_, *startup_program_, *program_, scope_.get()));
+
+  captured_signature_ = sig;
+  state_ = State::kReady;
+  VLOG(2) << "Captured hot loop with " << feed_names_.size() << " feeds, "
+          << fetch_names_.size() << " fetches and "
+          << persistable_vars_.size() << " persistable vars";
+
+  produced_vars_.clear();
+  external_inputs_.clear();
+  external_input_set_.clear();
+  output_vars_.clear();
+  output_var_set_.clear();
+}
+
+std::vector<std::shared_ptr<VarBase>> HotLoopCapturer::Replay(
+    const std::vector<std::shared_ptr<VarBase>>& feed_vars) {
+  PADDLE_ENFORCE_EQ(state_ == State::kReady, true,
+                    platform::errors::PreconditionNotMet(
+                        "Replay is only valid after a hot loop has been "
+                        "captured."));
+  PADDLE_ENFORCE_EQ(
+      feed_vars.size(), feed_names_.size(),
+      platform::errors::InvalidArgument(
+          "Replay expects %d feed vars, but %d are given.",
+          feed_names_.size(), feed_vars.size()));
+  std::vector<framework::Tensor> feed_tensors;
+  feed_tensors.reserve(feed_vars.size());
+  for (auto& var : feed_vars) {
+    PADDLE_ENFORCE_NOT_NULL(var, platform::errors::InvalidArgument(
+                                     "Replay feed var is NULL."));
+    feed_tensors.emplace_back(var->Var().Get<framework::LoDTensor>());
+  }
+  auto fetch_list = executor_->Run(feed_names_, feed_tensors, fetch_names_);
+
+  std::vector<std::shared_ptr<VarBase>> results;
+  results.reserve(fetch_list.size());
+  for (size_t i = 0; i < fetch_list.size(); ++i) {
+    auto& fetched = BOOST_GET(framework::LoDTensor, fetch_list[i]);
+    auto out = std::make_shared<VarBase>(false, fetch_names_[i]);
+    out->SetOverridedStopGradient(true);
+    auto* out_tensor = out->MutableVar()->GetMutable<framework::LoDTensor>();
+    out_tensor->ShareDataWith(fetched);
+    out_tensor->set_lod(fetched.lod());
+    results.emplace_back(std::move(out));
+  }
+  return results;
+}
+
+void HotLoopCapturer::DropCapture() {
+  executor_.reset();
+  scope_.reset();
+  program_.reset();
+  startup_program_.reset();
+  feed_names_.clear();
+  fetch_names_.clear();
+  persistable_vars_.clear();
+  captured_signature_ = 0;
+  state_ = State::kObserving;
+}
+
+}  // namespace jit
+}  // namespace imperative
+}  // namespace paddle
@@ -0,0 +1,131 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "paddle/fluid/imperative/jit/program_desc_tracer.h"
+#include "paddle/fluid/imperative/type_defs.h"
+#include "paddle/fluid/platform/macros.h"
+#include "paddle/fluid/platform/place.h"
+
+namespace paddle {
+namespace framework {
+class ProgramDesc;
+class Scope;
+class StandaloneExecutor;
+}  // namespace framework
+namespace imperative {
+class VarBase;
+}  // namespace imperative
+}  // namespace paddle
+
+namespace paddle {
+namespace imperative {
+namespace jit {
+
+// Watches the dygraph op stream for a steady-state loop. Every op reported
+// through NoteOp is folded into a per-iteration signature (op type + input
+// shapes + dtypes); iterations are delimited by the caller through
+// Tracer::MarkLoopIterationEnd. Once the same signature has repeated for
+// `capture_threshold` consecutive iterations, the next iteration is
+// recorded into a ProgramDesc via ProgramDescTracer and handed to the new
+// executor (InterpreterCore) for replay. An iteration whose signature later
+// diverges from the captured one drops the program and falls back to
+// observing; eager execution is never bypassed implicitly, so divergence
+// costs nothing beyond the discarded capture.
+//
+// Iterations that create grad nodes are never captured: a loop that still
+// builds a backward graph cannot be replayed by the static executor.
+class HotLoopCapturer {
+  DISABLE_COPY_AND_ASSIGN(HotLoopCapturer);
+
+ public:
+  enum class State { kObserving, kCapturing, kReady };
+
+  explicit HotLoopCapturer(size_t capture_threshold)
+      : capture_threshold_(capture_threshold) {}
+
+  ~HotLoopCapturer();
+
+  State GetState() const { return state_; }
+
+  bool IsReady() const { return state_ == State::kReady; }
+
+  // Folds one traced op into the current iteration signature. During a
+  // capture iteration it also tracks which inputs come from outside the
+  // iteration (replay feeds) and which outputs may be observed after it
+  // (replay fetches).
+  void NoteOp(const std::string& type, const NameVarBaseMap& ins,
+              const NameVarBaseMap& outs, bool require_grad);
+
+  // Closes the current iteration. Returns true when the next iteration
+  // should be recorded through the program desc tracer.
+  bool OnIterationEnd();
+
+  // Builds the replay program and executor from the ops the program desc
+  // tracer recorded during the capture iteration.
+  void FinishCapture(ProgramDescTracer* tracer, const platform::Place& place);
+
+  // Replays the captured program with the given external inputs, in
+  // FeedVarNames() order, and returns the fetched vars in FetchVarNames()
+  // order. Only valid while IsReady().
+  std::vector<std::shared_ptr<VarBase>> Replay(
+      const std::vector<std::shared_ptr<VarBase>>& feed_vars);
+
+  const std::vector<std::string>& FeedVarNames() const { return feed_names_; }
+
+  const std::vector<std::string>& FetchVarNames() const {
+    return fetch_names_;
+  }
+
+ private:
+  void DropCapture();
+
+  size_t capture_threshold_;
+  State state_{State::kObserving};
+
+  // signature of the iteration currently being accumulated
+  size_t cur_signature_{0};
+  bool cur_iter_capturable_{true};
+  // last completed iteration
+  size_t last_signature_{0};
+  size_t repeat_count_{0};
+  size_t captured_signature_{0};
+
+  // bookkeeping for the capture iteration only
+  std::set<const VarBase*> produced_vars_;
+  std::vector<std::shared_ptr<VarBase>> external_inputs_;
+  std::set<const VarBase*> external_input_set_;
+  std::vector<std::weak_ptr<VarBase>> output_vars_;
+  std::set<const VarBase*> output_var_set_;
+
+  // replay state
+  platform::Place place_;
+  std::unique_ptr<framework::ProgramDesc> program_;
+  std::unique_ptr<framework::ProgramDesc> startup_program_;
+  std::vector<std::string> feed_names_;
+  std::vector<std::string> fetch_names_;
+  std::vector<std::shared_ptr<VarBase>> persistable_vars_;
+  std::unique_ptr<framework::Scope> scope_;
+  std::unique_ptr<framework::StandaloneExecutor> executor_;
+};
+
+}  // namespace jit
+}  // namespace imperative
+}  // namespace paddle
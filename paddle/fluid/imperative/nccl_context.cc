@@ -70,15 +70,20 @@ void NCCLParallelContext::Init() {
   BcastNCCLId(nccl_ids, 0, server_fd);
 
   int gpu_id = BOOST_GET_CONST(platform::CUDAPlace, place_).device;
+  VLOG(0) << "init nccl context nranks: " << strategy_.nranks_
+          << " local rank: " << strategy_.local_rank_ << " gpu id: " << gpu_id
+          << " ring num: " << strategy_.nrings_;
+  // it will assign nccl_comm in CUDADeviceContext within ring_id. All rings
+  // are bootstrapped in one nccl group, so their handshakes overlap instead
+  // of running one ring after another.
+  std::vector<ncclUniqueId *> nccl_id_ptrs;
   for (int ring_id = 0; ring_id < strategy_.nrings_; ring_id++) {
-    VLOG(0) << "init nccl context nranks: " << strategy_.nranks_
-            << " local rank: " << strategy_.local_rank_ << " gpu id: " << gpu_id
-            << " ring id: " << ring_id;
-    // it will assign nccl_comm in CUDADeviceContext within ring_id
-    platform::NCCLCommContext::Instance().CreateComm(
-        &nccl_ids[ring_id], strategy_.nranks_, strategy_.local_rank_, gpu_id,
-        ring_id);
+    nccl_id_ptrs.push_back(&nccl_ids[ring_id]);
+  }
+  platform::NCCLCommContext::Instance().CreateComms(
+      nccl_id_ptrs, strategy_.nranks_, strategy_.local_rank_, gpu_id);
 
+  for (int ring_id = 0; ring_id < strategy_.nrings_; ring_id++) {
     compute_events_.emplace_back(
         platform::CudaEventResourcePool::Instance().New(
             BOOST_GET_CONST(platform::CUDAPlace, place_).device));
@@ -0,0 +1,79 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace paddle {
+namespace imperative {
+
+// A pool of default-constructed objects shared by all tracer threads.
+// Acquire() hands out a shared_ptr whose deleter calls T::Reuse() and
+// returns the object to the pool instead of freeing it, so the containers
+// inside a pooled object keep their capacity across iterations. An object
+// is recycled when its last reference dies, which for grad nodes is at
+// backward completion or when the forward graph is released. T must
+// provide Reuse(), dropping all state while keeping allocated capacity.
+template <typename T>
+class ObjectPool {
+ public:
+  static std::shared_ptr<T> Acquire() {
+    auto& pool = Instance();
+    std::unique_ptr<T> obj;
+    {
+      std::lock_guard<std::mutex> guard(pool.mutex_);
+      if (!pool.free_list_.empty()) {
+        obj = std::move(pool.free_list_.back());
+        pool.free_list_.pop_back();
+      }
+    }
+    if (!obj) {
+      obj.reset(new T());
+    }
+    return std::shared_ptr<T>(obj.release(), [](T* ptr) { Release(ptr); });
+  }
+
+ private:
+  ObjectPool() = default;
+
+  static ObjectPool& Instance() {
+    // Leaked on purpose: recycling deleters held by long-lived graphs may
+    // run during program exit, after function-local statics are destroyed.
+    static ObjectPool* pool = new ObjectPool();
+    return *pool;
+  }
+
+  static void Release(T* ptr) {
+    std::unique_ptr<T> obj(ptr);
+    obj->Reuse();
+    auto& pool = Instance();
+    std::lock_guard<std::mutex> guard(pool.mutex_);
+    // The cap keeps one very large graph from pinning its peak node count
+    // forever.
+    if (pool.free_list_.size() < kMaxPooledObjects) {
+      pool.free_list_.emplace_back(std::move(obj));
+    }
+  }
+
+  static constexpr size_t kMaxPooledObjects = 8192;
+
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<T>> free_list_;
+};
+
+}  // namespace imperative
+}  // namespace paddle
@@ -25,10 +25,13 @@
 #include "paddle/fluid/imperative/type_defs.h"
 #include "paddle/fluid/imperative/variable_wrapper.h"
 #include "paddle/fluid/platform/place.h"
+#include "paddle/utils/small_map.h"
 
 namespace paddle {
 namespace imperative {
 
+class RecomputeSegment;
+
 // TODO(zjl): to support py_func layer
 class OpBase {
  public:
@@ -201,8 +204,22 @@ class OpBase {
 
 class GradOpNode {
  public:
+  // Inplace ops rarely map more than a couple of grad var names, so the
+  // map stays inline and costs no heap allocation per traced op.
+  using InplaceNameMap = paddle::SmallMap<std::string, std::string, 2>;
+
   GradOpNode() = default;
 
+  // Drop all traced state but keep allocated capacity, so that nodes
+  // recycled through ObjectPool do not have to grow their containers
+  // again on the next iteration.
+  void Reuse() {
+    ops_.clear();
+    grad_pending_nodes_.clear();
+    inplace_grad_name_map_.clear();
+    recompute_segment_.reset();
+  }
+
   void reserve(size_t size) { ops_.reserve(size); }
 
   size_t size() const { return ops_.size(); }
@@ -259,7 +276,7 @@ class GradOpNode {
     }
   }
 
-  const std::map<std::string, std::string>& InplaceGradNameMap() const {
+  const InplaceNameMap& InplaceGradNameMap() const {
     return inplace_grad_name_map_;
   }
 
@@ -267,6 +284,14 @@ class GradOpNode {
     return grad_pending_nodes_;
   }
 
+  void SetRecomputeSegment(const std::shared_ptr<RecomputeSegment>& segment) {
+    recompute_segment_ = segment;
+  }
+
+  const std::shared_ptr<RecomputeSegment>& GetRecomputeSegment() const {
+    return recompute_segment_;
+  }
+
  private:
   DISABLE_COPY_AND_ASSIGN(GradOpNode);
 
@@ -275,7 +300,10 @@ class GradOpNode {
   std::vector<std::shared_ptr<GradOpNode>> grad_pending_nodes_;
   // Mapping relationship between grad output and grad input of the grad node of
   // Inplace op.
-  std::map<std::string, std::string> inplace_grad_name_map_;
+  InplaceNameMap inplace_grad_name_map_;
+  // The forward segment whose dropped activations must be recomputed
+  // before this node's grad ops may run (see RecomputeSegment).
+  std::shared_ptr<RecomputeSegment> recompute_segment_;
 };
 
 }  // namespace imperative
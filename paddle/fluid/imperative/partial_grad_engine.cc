@@ -26,6 +26,7 @@
 #include <vector>
 #include "paddle/fluid/imperative/gradient_accumulator.h"
 #include "paddle/fluid/imperative/layer.h"
+#include "paddle/fluid/imperative/object_pool.h"
 #include "paddle/fluid/imperative/op_base.h"
 #include "paddle/fluid/imperative/tracer.h"
 #include "paddle/fluid/operators/math/math_function.h"
@@ -939,7 +940,7 @@ void PartialGradTask::RunEachOp(OpBase *op) {
           accumulator_info->GradVarBase()->MutableGradVarBase();
       sum_grad_var_grad->SetOverridedStopGradient(false);
 
-      auto assign_node = std::make_shared<GradOpNode>();
+      auto assign_node = ObjectPool<GradOpNode>::Acquire();
       sum_grad_var_grad->SetGradNode(assign_node);
 
       VLOG(10) << "Add " << partial_grad_grads.size() << " assign op for "
@@ -14,6 +14,8 @@
 
 #include "paddle/fluid/imperative/prepared_operator.h"
 
+#include <sstream>
+
 #include "paddle/fluid/framework/data_type_transform.h"
 #include "paddle/fluid/framework/details/nan_inf_utils.h"
 #include "paddle/fluid/imperative/infer_shape_context.h"
@@ -21,6 +23,7 @@
 #include "paddle/fluid/platform/xpu/xpu_op_list.h"
 #endif
 DECLARE_bool(check_nan_inf);
+DECLARE_bool(dygraph_prepared_op_cache);
 
 namespace paddle {
 namespace imperative {
@@ -81,12 +84,138 @@ PreparedOp::PreparedOp(const framework::OperatorBase& op,
                        const framework::RuntimeContext& ctx,
                        const framework::OpKernelType& kernel_type,
                        const framework::OperatorWithKernel::OpKernelFunc& func,
-                       platform::DeviceContext* dev_ctx)
+                       platform::DeviceContext* dev_ctx,
+                       PreparedOpCacheEntry* cache_entry)
     : op_(op),
       ctx_(ctx),
       kernel_type_(kernel_type),
       func_(func),
-      dev_ctx_(dev_ctx) {}
+      dev_ctx_(dev_ctx),
+      cache_entry_(cache_entry) {}
+
+// Serializes an attribute into the cache key. Returns false for
+// attributes whose value cannot be represented as a stable string, which
+// makes the whole Prepare call uncacheable.
+class AttrCacheKeyVisitor : public boost::static_visitor<bool> {
+ public:
+  explicit AttrCacheKeyVisitor(std::string* key) : key_(key) {}
+
+  bool operator()(boost::blank) const { return true; }
+
+  bool operator()(const std::string& v) const {
+    key_->append(v);
+    key_->push_back(',');
+    return true;
+  }
+
+  bool operator()(const std::vector<std::string>& v) const {
+    for (auto& e : v) {
+      key_->append(e);
+      key_->push_back(',');
+    }
+    return true;
+  }
+
+  bool operator()(const std::vector<bool>& v) const {
+    for (bool e : v) {
+      Append(static_cast<int>(e));
+    }
+    return true;
+  }
+
+  bool operator()(framework::BlockDesc*) const { return false; }
+
+  bool operator()(const std::vector<framework::BlockDesc*>&) const {
+    return false;
+  }
+
+  template <typename T>
+  bool operator()(const std::vector<T>& v) const {
+    for (auto& e : v) {
+      Append(e);
+    }
+    return true;
+  }
+
+  template <typename T>
+  bool operator()(T v) const {
+    Append(v);
+    return true;
+  }
+
+ private:
+  template <typename T>
+  void Append(T v) const {
+    key_->append(std::to_string(v));
+    key_->push_back(',');
+  }
+
+  std::string* key_;
+};
+
+// Builds the key identifying one trace site: op type + per-slot input
+// dims/dtype/layout + attributes + place. Returns false when the call
+// cannot be cached, i.e. when some input is not a plain LoDTensor, when
+// an input carries LoD information (InferShape would propagate it), or
+// when an attribute cannot be serialized.
+template <typename VarType>
+static bool BuildPreparedOpCacheKey(const framework::OperatorWithKernel& op,
+                                    const NameVarMap<VarType>& ins,
+                                    const framework::AttributeMap& attrs,
+                                    const platform::Place& place,
+                                    std::string* key) {
+  key->reserve(128);
+  key->append(op.Type());
+  key->push_back('|');
+  for (auto& name_pair : ins) {
+    key->append(name_pair.first);
+    key->push_back(':');
+    for (auto& var : name_pair.second) {
+      if (var == nullptr) {
+        key->push_back('_');
+        continue;
+      }
+      auto& variable = var->Var();
+      if (!variable.IsInitialized()) {
+        key->push_back('~');
+        continue;
+      }
+      if (!variable.template IsType<framework::LoDTensor>()) {
+        return false;
+      }
+      auto& tensor = variable.template Get<framework::LoDTensor>();
+      if (!tensor.lod().empty()) {
+        return false;
+      }
+      auto dims = tensor.dims();
+      for (int i = 0; i < dims.size(); ++i) {
+        key->append(std::to_string(dims[i]));
+        key->push_back('x');
+      }
+      key->append(std::to_string(static_cast<int>(var->DataType())));
+      key->push_back('/');
+      key->append(std::to_string(static_cast<int>(tensor.layout())));
+      if (!tensor.IsInitialized()) {
+        key->push_back('~');
+      }
+      key->push_back(';');
+    }
+    key->push_back('|');
+  }
+  AttrCacheKeyVisitor visitor(key);
+  for (auto& attr_pair : attrs) {
+    key->append(attr_pair.first);
+    key->push_back('=');
+    if (!boost::apply_visitor(visitor, attr_pair.second)) {
+      return false;
+    }
+  }
+  key->push_back('|');
+  std::ostringstream place_os;
+  place_os << place;
+  key->append(place_os.str());
+  return true;
+}
 
 template <typename VarType>
 PreparedOp PrepareImpl(const NameVarMap<VarType>& ins,
@@ -100,6 +229,28 @@ PreparedOp PrepareImpl(const NameVarMap<VarType>& ins,
 
   framework::RuntimeContext ctx({}, {});
 
+  // One cache per thread, so the backward worker threads of
+  // FLAGS_imperative_backward_threads never contend on it. Node
+  // references stay valid across rehash, so entry pointers can be kept
+  // by the returned PreparedOp.
+  static thread_local std::unordered_map<std::string, PreparedOpCacheEntry>
+      prepared_op_cache;
+
+  std::string cache_key;
+  bool cacheable =
+      FLAGS_dygraph_prepared_op_cache &&
+      BuildPreparedOpCacheKey<VarType>(op, ins, attrs, place, &cache_key);
+  if (cacheable) {
+    auto cache_iter = prepared_op_cache.find(cache_key);
+    if (cache_iter != prepared_op_cache.end()) {
+      VLOG(6) << "Hit prepared op cache: op " << op.Type() << ", key "
+              << cache_key;
+      auto& entry = cache_iter->second;
+      return PreparedOp(op, ctx, entry.kernel_type, entry.func, entry.dev_ctx,
+                        &entry);
+    }
+  }
+
 #ifdef PADDLE_WITH_MKLDNN
   // MKLDNN variant of code reads attributes in some of GetKernelTypeForVar and
   // GetKernelType functions, so we need to copy the attributes there.
@@ -162,7 +313,18 @@ PreparedOp PrepareImpl(const NameVarMap<VarType>& ins,
     dev_ctx = pool.Get(expected_kernel_key.place_);
   }
 
-  return PreparedOp(op, ctx, expected_kernel_key, kernel_iter->second, dev_ctx);
+  PreparedOpCacheEntry* cache_entry = nullptr;
+  if (cacheable) {
+    // insert only after the kernel lookup succeeded, so a throwing
+    // Prepare never leaves a half-filled entry behind
+    cache_entry = &prepared_op_cache[cache_key];
+    cache_entry->kernel_type = expected_kernel_key;
+    cache_entry->func = kernel_iter->second;
+    cache_entry->dev_ctx = dev_ctx;
+  }
+
+  return PreparedOp(op, ctx, expected_kernel_key, kernel_iter->second, dev_ctx,
+                    cache_entry);
 }
 
 PreparedOp PreparedOp::Prepare(const NameVarMap<VarBase>& ins,
@@ -184,21 +346,80 @@ PreparedOp PreparedOp::Prepare(const NameVarMap<VariableWrapper>& ins,
                                       default_attrs);
 }
 
+// Resizes the output tensors from the dims recorded for this signature,
+// skipping the InferShape call entirely.
+template <typename VarType>
+static void ApplyCachedOutputDims(const PreparedOpCacheEntry& cache_entry,
+                                  const NameVarMap<VarType>& outs) {
+  for (auto& name_pair : outs) {
+    auto dims_iter = cache_entry.out_dims.find(name_pair.first);
+    if (dims_iter == cache_entry.out_dims.end()) {
+      continue;
+    }
+    auto& dims = dims_iter->second;
+    for (size_t i = 0; i < name_pair.second.size() && i < dims.size(); ++i) {
+      auto& var = name_pair.second[i];
+      if (var == nullptr) {
+        continue;
+      }
+      var->MutableVar()->template GetMutable<framework::LoDTensor>()->Resize(
+          dims[i]);
+    }
+  }
+}
+
+// Records the dims InferShape produced so later iterations with the same
+// signature can replay them. Signatures with non-LoDTensor outputs are
+// marked uncacheable and keep running InferShape.
+template <typename VarType>
+static void RecordOutputDims(const NameVarMap<VarType>& outs,
+                             PreparedOpCacheEntry* cache_entry) {
+  for (auto& name_pair : outs) {
+    auto& dims = cache_entry->out_dims[name_pair.first];
+    dims.clear();
+    for (auto& var : name_pair.second) {
+      if (var == nullptr) {
+        dims.emplace_back();
+        continue;
+      }
+      auto& variable = var->Var();
+      if (!variable.IsInitialized() ||
+          !variable.template IsType<framework::LoDTensor>()) {
+        cache_entry->out_dims_not_cacheable = true;
+        cache_entry->out_dims.clear();
+        return;
+      }
+      dims.emplace_back(variable.template Get<framework::LoDTensor>().dims());
+    }
+  }
+  cache_entry->has_out_dims = true;
+}
+
 template <typename VarType>
 static void PreparedOpRunImpl(
     const framework::OperatorBase& op, const framework::RuntimeContext& ctx,
     const framework::OpKernelType& kernel_type,
     const framework::OperatorWithKernel::OpKernelFunc& func,
-    platform::DeviceContext* dev_ctx, const NameVarMap<VarType>& ins,
-    const NameVarMap<VarType>& outs, const framework::AttributeMap& attrs,
+    platform::DeviceContext* dev_ctx, PreparedOpCacheEntry* cache_entry,
+    const NameVarMap<VarType>& ins, const NameVarMap<VarType>& outs,
+    const framework::AttributeMap& attrs,
     const framework::AttributeMap& default_attrs) {
   // TODO(zjl): remove scope in dygraph
   framework::Scope scope;
 
-  DygraphInferShapeContext<VarType> infer_shape_ctx(&ins, &outs, &attrs,
-                                                    &default_attrs, op.Type());
-  static_cast<const framework::OperatorWithKernel&>(op).InferShape(
-      &infer_shape_ctx);
+  if (cache_entry != nullptr && cache_entry->has_out_dims) {
+    VLOG(6) << "Skip InferShape of op " << op.Type()
+            << " with cached output dims";
+    ApplyCachedOutputDims<VarType>(*cache_entry, outs);
+  } else {
+    DygraphInferShapeContext<VarType> infer_shape_ctx(
+        &ins, &outs, &attrs, &default_attrs, op.Type());
+    static_cast<const framework::OperatorWithKernel&>(op).InferShape(
+        &infer_shape_ctx);
+    if (cache_entry != nullptr && !cache_entry->out_dims_not_cacheable) {
+      RecordOutputDims<VarType>(outs, cache_entry);
+    }
+  }
 
   func(DygraphExecutionContext<VarType>(op, scope, *dev_ctx, ctx, ins, outs,
                                         attrs, default_attrs));
@@ -229,8 +450,8 @@ void PreparedOp::Run(const NameVarMap<VarBase>& ins,
                      const NameVarMap<VarBase>& outs,
                      const framework::AttributeMap& attrs,
                      const framework::AttributeMap& default_attrs) {
-  PreparedOpRunImpl<VarBase>(op_, ctx_, kernel_type_, func_, dev_ctx_, ins,
-                             outs, attrs, default_attrs);
+  PreparedOpRunImpl<VarBase>(op_, ctx_, kernel_type_, func_, dev_ctx_,
+                             cache_entry_, ins, outs, attrs, default_attrs);
 }
 
 void PreparedOp::Run(const NameVarMap<VariableWrapper>& ins,
@@ -238,7 +459,8 @@ void PreparedOp::Run(const NameVarMap<VariableWrapper>& ins,
                      const framework::AttributeMap& attrs,
                      const framework::AttributeMap& default_attrs) {
   PreparedOpRunImpl<VariableWrapper>(op_, ctx_, kernel_type_, func_, dev_ctx_,
-                                     ins, outs, attrs, default_attrs);
+                                     cache_entry_, ins, outs, attrs,
+                                     default_attrs);
 }
 
 }  // namespace imperative
@@ -15,6 +15,7 @@
 #pragma once
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -139,13 +140,31 @@ std::shared_ptr<NameVarMap<VarType>> PrepareData(
   return tmp_ins_ptr;
 }
 
+// Cached result of PreparedOp::Prepare for one trace site, keyed by op
+// type, input shape/dtype signature, attributes and place (see
+// FLAGS_dygraph_prepared_op_cache). The kernel choice is filled at
+// Prepare time; the output dims inferred by the first Run with this
+// signature are replayed by later Runs instead of a full InferShape.
+struct PreparedOpCacheEntry {
+  framework::OpKernelType kernel_type{framework::proto::VarType::RAW,
+                                      platform::CPUPlace()};
+  framework::OperatorWithKernel::OpKernelFunc func;
+  platform::DeviceContext* dev_ctx{nullptr};
+  std::unordered_map<std::string, std::vector<framework::DDim>> out_dims;
+  bool has_out_dims{false};
+  // set when some output is not a plain LoDTensor, so dims cannot be
+  // replayed safely and InferShape always runs for this signature
+  bool out_dims_not_cacheable{false};
+};
+
 class PreparedOp {
  public:
   PreparedOp(const framework::OperatorBase& op,
              const framework::RuntimeContext& ctx,
              const framework::OpKernelType& kernel_type,
              const framework::OperatorWithKernel::OpKernelFunc& func,
-             platform::DeviceContext* dev_ctx);
+             platform::DeviceContext* dev_ctx,
+             PreparedOpCacheEntry* cache_entry = nullptr);
 
   static PreparedOp Prepare(const NameVarMap<VarBase>& ins,
                             const NameVarMap<VarBase>& outs,
@@ -178,6 +197,9 @@ class PreparedOp {
   framework::OpKernelType kernel_type_;
   framework::OperatorWithKernel::OpKernelFunc func_;
   platform::DeviceContext* dev_ctx_;
+  // not owned, lives in the thread local cache of Prepare; nullptr when
+  // FLAGS_dygraph_prepared_op_cache is off or the call is not cacheable
+  PreparedOpCacheEntry* cache_entry_;
 };
 
 }  // namespace imperative
@@ -0,0 +1,108 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/imperative/recompute_segment.h"
+
+#include <unordered_set>
+
+#include "paddle/fluid/imperative/layer.h"
+#include "paddle/fluid/imperative/op_base.h"
+#include "paddle/fluid/imperative/variable_wrapper.h"
+
+namespace paddle {
+namespace imperative {
+
+static NameVarMap<VariableWrapper> ToVariableWrapperMap(
+    const NameVarBaseMap& map) {
+  NameVarMap<VariableWrapper> result;
+  for (auto& pair : map) {
+    auto& dst = result[pair.first];
+    dst.reserve(pair.second.size());
+    for (auto& var : pair.second) {
+      dst.emplace_back(var ? var->SharedVar() : nullptr);
+    }
+  }
+  return result;
+}
+
+void RecomputeSegment::RecordOp(std::unique_ptr<framework::OperatorBase> op,
+                                const NameVarBaseMap& ins,
+                                const NameVarBaseMap& outs,
+                                const framework::AttributeMap& attrs,
+                                const framework::AttributeMap& default_attrs,
+                                const platform::Place& place) {
+  RecordedOp recorded;
+  recorded.op = std::move(op);
+  recorded.ins = ToVariableWrapperMap(ins);
+  recorded.outs = ToVariableWrapperMap(outs);
+  recorded.attrs = attrs;
+  recorded.default_attrs = default_attrs;
+  recorded.place = place;
+  ops_.emplace_back(std::move(recorded));
+}
+
+void RecomputeSegment::DropIntermediates(
+    const std::vector<std::shared_ptr<VariableWrapper>>& outputs) {
+  std::unordered_set<VariableWrapper*> kept;
+  for (auto& out : outputs) {
+    kept.insert(out.get());
+  }
+
+  // A var whose first appearance in the segment is as an input comes
+  // from outside (an inplace op lists it as both input and output), so
+  // only vars first seen as outputs are segment intermediates.
+  std::unordered_set<VariableWrapper*> seen;
+  size_t dropped_num = 0;
+  for (auto& recorded : ops_) {
+    for (auto& pair : recorded.ins) {
+      for (auto& var : pair.second) {
+        if (var) {
+          seen.insert(var.get());
+        }
+      }
+    }
+    for (auto& pair : recorded.outs) {
+      for (auto& var : pair.second) {
+        if (!var || kept.count(var.get()) || !seen.insert(var.get()).second) {
+          continue;
+        }
+        auto* variable = var->MutableVar();
+        if (variable->IsType<framework::LoDTensor>() &&
+            variable->Get<framework::LoDTensor>().IsInitialized()) {
+          variable->GetMutable<framework::LoDTensor>()->clear();
+          ++dropped_num;
+        }
+      }
+    }
+  }
+  need_recompute_ = dropped_num > 0;
+  VLOG(3) << "Recompute segment dropped " << dropped_num
+          << " intermediate tensors of " << ops_.size() << " ops";
+}
+
+void RecomputeSegment::Recompute() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (!need_recompute_) {
+    return;
+  }
+  VLOG(3) << "Recompute segment replays " << ops_.size() << " ops";
+  for (auto& recorded : ops_) {
+    OpBase::Run(*recorded.op, recorded.ins, recorded.outs, recorded.attrs,
+                recorded.default_attrs, recorded.place);
+  }
+  need_recompute_ = false;
+}
+
+}  // namespace imperative
+}  // namespace paddle
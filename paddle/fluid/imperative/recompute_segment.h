@@ -0,0 +1,92 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "paddle/fluid/framework/operator.h"
+#include "paddle/fluid/imperative/type_defs.h"
+#include "paddle/fluid/platform/macros.h"
+#include "paddle/fluid/platform/place.h"
+
+namespace paddle {
+namespace imperative {
+
+class VarBase;
+class VariableWrapper;
+
+// A segment of forward ops whose intermediate activations are dropped
+// after the forward pass and recomputed on demand when the backward pass
+// first needs them, trading extra forward compute for activation memory.
+//
+// The tracer records every op traced between BeginRecomputeSegment and
+// EndRecomputeSegment into a segment and attaches the segment to the
+// grad nodes it creates for them. EndRecomputeSegment releases the
+// storage of every tensor produced inside the segment except the given
+// segment outputs; BasicEngine calls Recompute() before executing a
+// grad node that belongs to the segment, which re-runs the recorded ops
+// once and restores the dropped tensors in place. The restored tensors
+// are then freed progressively by the normal backward trace cleanup.
+//
+// NOTE: ops inside a segment are re-executed verbatim, so the segment
+// must be deterministic; stateful ops such as dropout produce a
+// different mask on replay and should not be placed inside a segment.
+class RecomputeSegment {
+ public:
+  RecomputeSegment() = default;
+
+  void RecordOp(std::unique_ptr<framework::OperatorBase> op,
+                const NameVarBaseMap& ins, const NameVarBaseMap& outs,
+                const framework::AttributeMap& attrs,
+                const framework::AttributeMap& default_attrs,
+                const platform::Place& place);
+
+  // Releases the storage of every tensor first produced inside the
+  // segment, except the given segment outputs. Vars that enter the
+  // segment from outside (including inplace-modified ones) are kept.
+  void DropIntermediates(
+      const std::vector<std::shared_ptr<VariableWrapper>>& outputs);
+
+  // Re-executes the recorded ops to restore the dropped tensors.
+  // Thread safe and idempotent: concurrent callers replay it once.
+  void Recompute();
+
+  bool NeedRecompute() const { return need_recompute_; }
+
+  size_t OpNum() const { return ops_.size(); }
+
+ private:
+  struct RecordedOp {
+    std::unique_ptr<framework::OperatorBase> op;
+    NameVarMap<VariableWrapper> ins;
+    NameVarMap<VariableWrapper> outs;
+    framework::AttributeMap attrs;
+    framework::AttributeMap default_attrs;
+    platform::Place place;
+  };
+
+  std::vector<RecordedOp> ops_;
+  std::atomic<bool> need_recompute_{false};
+  std::mutex mutex_;
+
+  DISABLE_COPY_AND_ASSIGN(RecomputeSegment);
+};
+
+}  // namespace imperative
+}  // namespace paddle
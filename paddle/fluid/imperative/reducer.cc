@@ -15,6 +15,9 @@
 #include "paddle/fluid/imperative/reducer.h"
 
 #include <iostream>
+#include <numeric>
+
+#include "gflags/gflags.h"
 
 #include "paddle/fluid/imperative/layer.h"
 #include "paddle/fluid/string/string_helper.h"
@@ -24,6 +27,9 @@
 
 #include "paddle/fluid/imperative/parallel_context.h"
 
+DECLARE_int32(imperative_reducer_rebalance_steps);
+DECLARE_uint64(imperative_allreduce_chunk_bytes);
+
 namespace paddle {
 namespace imperative {
 
@@ -55,6 +61,25 @@ void Group::DivNRanks(const platform::DeviceContext &context, int64_t nranks) {
   }
 }
 
+#if !(defined(PADDLE_WITH_NCCL) || defined(PADDLE_WITH_RCCL))
+// The CUDA implementation lives in reducer.cu; the hook is only
+// meaningful for GPU gradients communicated through NCCL.
+framework::Variable *Fp16CompressCommHook::Compress(
+    framework::Variable *src, const platform::DeviceContext &context) {
+  PADDLE_THROW(platform::errors::Unimplemented(
+      "The fp16 compressed communication hook is only supported with "
+      "NCCL."));
+}
+
+void Fp16CompressCommHook::Decompress(framework::Variable *comm_out,
+                                      framework::Variable *dst,
+                                      const platform::DeviceContext &context) {
+  PADDLE_THROW(platform::errors::Unimplemented(
+      "The fp16 compressed communication hook is only supported with "
+      "NCCL."));
+}
+#endif
+
 template <typename DeviceContext, typename T>
 static void ConcatTensorsForAllReduce(
     const DeviceContext &context,
@@ -323,6 +348,27 @@ Reducer::Reducer(const std::vector<std::shared_ptr<imperative::VarBase>> &vars,
 
   // Initialize local used vars
   local_used_vars_.resize(vars_.size(), 0);
+
+  // for measuring gradient arrival times during rebalance warmup
+  var_arrival_time_sum_ms_.resize(vars_.size(), 0.0);
+}
+
+void Reducer::SetCommHook(const std::string &hook_type) {
+  PADDLE_ENFORCE_EQ(
+      hook_type.empty() || hook_type == "fp16", true,
+      platform::errors::InvalidArgument(
+          "Unsupported communication hook type \"%s\", only \"fp16\" is "
+          "built in.",
+          hook_type));
+  comm_hook_type_ = hook_type;
+  for (auto &group : groups_) {
+    if (group.is_sparse_) {
+      continue;
+    }
+    group.comm_hook_ = comm_hook_type_ == "fp16"
+                           ? std::make_shared<Fp16CompressCommHook>()
+                           : nullptr;
+  }
 }
 
 void Reducer::InitializeDenseGroups(
@@ -412,6 +458,9 @@ void Reducer::InitializeGroups(
       auto tensor = group.dense_contents_.GetMutable<framework::LoDTensor>();
       tensor->Resize(framework::make_ddim({group.all_length_}))
           .mutable_data(place_, group.dtype_);
+      if (comm_hook_type_ == "fp16") {
+        group.comm_hook_ = std::make_shared<Fp16CompressCommHook>();
+      }
     }
 
     // map variables to this group by VariableLocator
@@ -547,6 +596,9 @@ void Reducer::PrepareForBackward(
   VLOG(3) << "after forward, then reset count for backward.";
   grad_need_hooks_ = true;
   next_group_ = 0;
+  if (NeedRebalanceGroup()) {
+    backward_start_time_ = std::chrono::steady_clock::now();
+  }
   std::for_each(groups_.begin(), groups_.end(), [](Group &group) {
     group.pending_ = group.variable_indices_.size();
     group.sparse_contents_ = nullptr;
@@ -686,6 +738,13 @@ void Reducer::MarkVarReady(const size_t var_index, const bool is_used_var) {
     vars_marked_ready_[var_index] = true;
   }
 
+  if (NeedRebalanceGroup()) {
+    var_arrival_time_sum_ms_[var_index] +=
+        std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - backward_start_time_)
+            .count();
+  }
+
   if (!group.is_sparse_) {
     // process dense group
     const auto inside_group_index = var_locator.inside_group_index;
@@ -850,9 +909,46 @@ void Reducer::FusedAllReduceSchedule(const int run_order, Group &group,
 #endif
 
     group.DivNRanks(dev_context, nranks_);
-    // Start allreduce
-    parallel_ctx_->AllReduceByStream(
-        group.dense_contents_, &(group.dense_contents_), run_order, false);
+    // Start allreduce. The gradients are pre-scaled by 1/nranks above,
+    // so a compressed hook sums already-bounded values on the wire.
+    framework::Variable *comm_var = &group.dense_contents_;
+    if (group.comm_hook_) {
+      comm_var = group.comm_hook_->Compress(comm_var, dev_context);
+    }
+    auto *contents_tensor = comm_var->GetMutable<framework::LoDTensor>();
+    const auto comm_dtype = contents_tensor->type();
+    const uint64_t group_bytes =
+        static_cast<uint64_t>(contents_tensor->numel()) *
+        framework::SizeOfType(comm_dtype);
+    if (FLAGS_imperative_allreduce_chunk_bytes > 0 &&
+        group_bytes > FLAGS_imperative_allreduce_chunk_bytes) {
+      // An oversized fused buffer (typically a single huge parameter that
+      // monopolizes its group) is communicated in several bounded collective
+      // calls. Each chunk aliases a slice of the fused buffer and is reduced
+      // in place on the same ring, so no extra copy or cross stream
+      // synchronization is needed.
+      const int64_t chunk_numel = (std::max)(
+          static_cast<int64_t>(FLAGS_imperative_allreduce_chunk_bytes /
+                               framework::SizeOfType(comm_dtype)),
+          static_cast<int64_t>(1));
+      const int64_t total_numel = contents_tensor->numel();
+      VLOG(3) << "dense group [" << curr_group_index << "] allreduce in "
+              << (total_numel + chunk_numel - 1) / chunk_numel << " chunks";
+      for (int64_t offset = 0; offset < total_numel; offset += chunk_numel) {
+        const int64_t end = (std::min)(offset + chunk_numel, total_numel);
+        framework::Variable chunk;
+        chunk.GetMutable<framework::LoDTensor>()->ShareDataWith(
+            contents_tensor->Slice(offset, end));
+        parallel_ctx_->AllReduceByStream(chunk, &chunk, run_order, false);
+      }
+    } else {
+      parallel_ctx_->AllReduceByStream(*comm_var, comm_var, run_order, false);
+    }
+
+    if (group.comm_hook_) {
+      group.comm_hook_->Decompress(comm_var, &group.dense_contents_,
+                                   dev_context);
+    }
 
     // Select communication stream to split tensors
     // group.dense_contents_ ---> group.dense_tensors
@@ -882,6 +978,94 @@ std::vector<std::vector<size_t>> Reducer::RebuildGruops() {
   return rebuild_group_indices;
 }
 
+bool Reducer::NeedRebalanceGroup() {
+  return FLAGS_imperative_reducer_rebalance_steps > 0 && !has_rebalanced_group_;
+}
+
+// Re-partition the groups from the gradient arrival times accumulated
+// during the warmup iterations. Variables are ordered by mean arrival
+// time and a dense group is closed once it covers its share of the
+// backward timeline or reaches the steady-state size limit, so every
+// allreduce gets a comparable amount of computation to overlap with.
+// The sparse parameter still occupies a group exclusively and dense
+// parameters of different data types are never mixed.
+std::vector<std::vector<size_t>> Reducer::RebalanceGroupIndices() {
+  std::vector<size_t> order(vars_.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this](size_t x, size_t y) {
+    return var_arrival_time_sum_ms_[x] < var_arrival_time_sum_ms_[y];
+  });
+  VLOG(3) << "The order of parameter mean arrival: "
+          << string::join_strings(order, ',');
+
+  size_t dense_group_num = 0;
+  for (const auto &group : groups_) {
+    if (!group.is_sparse_) {
+      ++dense_group_num;
+    }
+  }
+  const double min_time = var_arrival_time_sum_ms_[order.front()];
+  const double max_time = var_arrival_time_sum_ms_[order.back()];
+  if (dense_group_num == 0 || max_time <= min_time) {
+    VLOG(3) << "Arrival times show no spread, keep the current groups";
+    return {};
+  }
+  const double target_span = (max_time - min_time) / dense_group_num;
+
+  struct OpenGroup {
+    std::vector<size_t> var_indices;
+    double start_time = 0.0;
+    size_t size = 0;
+  };
+
+  std::vector<std::vector<size_t>> res;
+  // Key: the var type
+  // Value: the group being filled with vars of that type
+  std::unordered_map<std::string, OpenGroup> open_groups;
+  size_t assigned_num = 0;
+  for (const auto var_index : order) {
+    if (is_sparse_gradient_[var_index]) {
+      // we keep sparse var a single group
+      res.push_back({var_index});
+      ++assigned_num;
+      continue;
+    }
+    const auto &var = vars_[var_index];
+    if (!var->Var().IsType<framework::LoDTensor>()) {
+      VLOG(3) << "var " << var->Name()
+              << " is not tensor or selected_rows, so skip it";
+      continue;
+    }
+    const auto var_dtype = var->DataType();
+    auto &open_group = open_groups[framework::DataTypeToString(var_dtype)];
+    if (open_group.var_indices.empty()) {
+      open_group.start_time = var_arrival_time_sum_ms_[var_index];
+    }
+    open_group.var_indices.push_back(var_index);
+    open_group.size += framework::SizeOfType(var_dtype) *
+                       var->Var().Get<framework::LoDTensor>().numel();
+    ++assigned_num;
+    if (var_arrival_time_sum_ms_[var_index] - open_group.start_time >=
+            target_span ||
+        open_group.size >= group_size_limits_.back()) {
+      res.emplace_back(std::move(open_group.var_indices));
+      open_group = OpenGroup();
+    }
+  }
+  // add the final groups
+  for (auto &e : open_groups) {
+    if (!e.second.var_indices.empty()) {
+      res.emplace_back(std::move(e.second.var_indices));
+    }
+  }
+
+  if (assigned_num != vars_.size()) {
+    VLOG(3) << "Some vars hold no tensor yet, keep the current groups";
+    return {};
+  }
+  return res;
+}
+
 void Reducer::ProcessUnusedDenseVars() {
   // The calculation stream must be used here to
   // avoid conflicts with communication.
@@ -991,6 +1175,19 @@ void Reducer::FinalizeBackward() {
     InitializeGroups(group_indices_);
   }
 
+  if (NeedRebalanceGroup() &&
+      ++rebalance_step_count_ >=
+          static_cast<size_t>(FLAGS_imperative_reducer_rebalance_steps)) {
+    VLOG(3) << "Start rebalancing the groups after " << rebalance_step_count_
+            << " warmup steps";
+    auto rebalance_group_indices = RebalanceGroupIndices();
+    if (!rebalance_group_indices.empty()) {
+      group_indices_ = std::move(rebalance_group_indices);
+      InitializeGroups(group_indices_);
+    }
+    has_rebalanced_group_ = true;
+  }
+
   if (find_unused_vars_each_step_) {
 // TODO(liuyuhui) support xpu about Tensorcopy/TensorFromVector/TensorToVector
 #if defined(PADDLE_WITH_NCCL) || defined(PADDLE_WITH_RCCL) || \
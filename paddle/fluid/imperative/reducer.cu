@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "paddle/fluid/imperative/reducer.h"
+#include "paddle/fluid/platform/float16.h"
 
 namespace paddle {
 namespace imperative {
@@ -24,6 +25,40 @@ void Group::DivNRanks(framework::Tensor *tensor, int64_t nranks,
       dtype_, DivNRanksForAllReduce<platform::CUDADeviceContext>(tensor, nranks,
                                                                  context));
 }
+
+framework::Variable *Fp16CompressCommHook::Compress(
+    framework::Variable *src, const platform::DeviceContext &context) {
+  const auto &src_tensor = src->Get<framework::LoDTensor>();
+  PADDLE_ENFORCE_EQ(
+      src_tensor.type(), framework::proto::VarType::FP32,
+      platform::errors::InvalidArgument(
+          "The fp16 compressed communication hook only supports fp32 "
+          "gradients, but the fused buffer dtype is %s.",
+          framework::DataTypeToString(src_tensor.type())));
+  auto *dst_tensor = fp16_contents_.GetMutable<framework::LoDTensor>();
+  dst_tensor->Resize(src_tensor.dims());
+  auto *dst_data =
+      dst_tensor->mutable_data<platform::float16>(context.GetPlace());
+  platform::ForRange<platform::CUDADeviceContext> for_range(
+      static_cast<const platform::CUDADeviceContext &>(context),
+      static_cast<size_t>(src_tensor.numel()));
+  for_range(CastCommFunctor<float, platform::float16>(src_tensor.data<float>(),
+                                                      dst_data));
+  return &fp16_contents_;
+}
+
+void Fp16CompressCommHook::Decompress(framework::Variable *comm_out,
+                                      framework::Variable *dst,
+                                      const platform::DeviceContext &context) {
+  const auto &comm_tensor = comm_out->Get<framework::LoDTensor>();
+  auto *dst_tensor = dst->GetMutable<framework::LoDTensor>();
+  auto *dst_data = dst_tensor->mutable_data<float>(context.GetPlace());
+  platform::ForRange<platform::CUDADeviceContext> for_range(
+      static_cast<const platform::CUDADeviceContext &>(context),
+      static_cast<size_t>(comm_tensor.numel()));
+  for_range(CastCommFunctor<platform::float16, float>(
+      comm_tensor.data<platform::float16>(), dst_data));
+}
 #endif
 
 }  // namespace imperative
@@ -15,6 +15,7 @@
 #pragma once
 #include <ThreadPool.h>
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -81,6 +82,51 @@ struct DivNRanksForAllReduce {
   }
 };
 
+template <typename T, typename CommT>
+struct CastCommFunctor {
+  CastCommFunctor(const T* input, CommT* output)
+      : input_(input), output_(output) {}
+  HOSTDEVICE void operator()(size_t idx) const {
+    output_[idx] = static_cast<CommT>(input_[idx]);
+  }
+  const T* input_;
+  CommT* output_;
+};
+
+// A pluggable communication hook applied to the fused dense buffer of a
+// group around its allreduce. Compress returns the variable that should
+// be communicated instead of the fused buffer, Decompress restores the
+// communicated result into the fused buffer afterwards.
+class GroupCommHook {
+ public:
+  virtual ~GroupCommHook() {}
+
+  virtual framework::Variable* Compress(
+      framework::Variable* src, const platform::DeviceContext& context) = 0;
+
+  virtual void Decompress(framework::Variable* comm_out,
+                          framework::Variable* dst,
+                          const platform::DeviceContext& context) = 0;
+};
+
+// Built-in compressed communication hook: fp32 gradients are cast to
+// float16 on the wire, halving the communicated bytes. The gradients are
+// pre-scaled by 1/nranks in fp32 before compression, which avoids
+// overflow during the low precision summation, and the summed result is
+// restored into the fp32 fused buffer afterwards.
+class Fp16CompressCommHook : public GroupCommHook {
+ public:
+  framework::Variable* Compress(
+      framework::Variable* src,
+      const platform::DeviceContext& context) override;
+
+  void Decompress(framework::Variable* comm_out, framework::Variable* dst,
+                  const platform::DeviceContext& context) override;
+
+ private:
+  framework::Variable fp16_contents_;
+};
+
 class Group {
  public:
   // Here, we use dense_contents_ & sparse_contents_ to
@@ -106,6 +152,9 @@ class Group {
   // external message of group
   framework::proto::VarType::Type dtype_;
 
+  // optional hook compressing the fused buffer around the allreduce
+  std::shared_ptr<GroupCommHook> comm_hook_;
+
   // context is used to select the stream for concat
   void ConcatTensors(const platform::DeviceContext& context);
 
@@ -165,6 +214,10 @@ class Reducer {
     return !has_rebuilt_group_ && !find_unused_vars_each_step_;
   }
 
+  std::vector<std::vector<size_t>> RebalanceGroupIndices();
+
+  bool NeedRebalanceGroup();
+
   void ProcessUnusedDenseVars();
 
   bool HasGrad(size_t var_index);
@@ -172,6 +225,12 @@ class Reducer {
   void TraverseBackwardGraph(
       const std::vector<std::shared_ptr<imperative::VarBase>>& outputs);
 
+  // Attach a built-in compressed communication hook to every dense
+  // group. Currently only "fp16" is supported and the empty string
+  // removes the hook; hooks are re-attached automatically when the
+  // groups are rebuilt.
+  void SetCommHook(const std::string& hook_type);
+
  private:
   std::vector<std::shared_ptr<imperative::VarBase>> vars_;
   std::vector<std::vector<size_t>> group_indices_;
@@ -193,6 +252,19 @@ class Reducer {
   std::vector<int64_t> rebuild_var_indices_;
   const std::vector<size_t> group_size_limits_;
 
+  // the type of the communication hook attached to dense groups
+  std::string comm_hook_type_;
+
+  // Following variables are to help rebalance group. During the first
+  // FLAGS_imperative_reducer_rebalance_steps iterations the arrival time
+  // of every gradient is accumulated, then the groups are re-partitioned
+  // once so that each group covers a comparable span of the backward
+  // timeline.
+  bool has_rebalanced_group_{false};
+  size_t rebalance_step_count_{0};
+  std::vector<double> var_arrival_time_sum_ms_;
+  std::chrono::steady_clock::time_point backward_start_time_;
+
   // Following variables are to help unused vars
   std::unordered_map<GradOpNode*, size_t> node_deps_;
   std::unordered_map<VariableWrapper*, size_t> var_index_map_;
@@ -0,0 +1,371 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _WIN32
+
+#include "paddle/fluid/imperative/shared_memory_tensor_queue.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "glog/logging.h"
+#include "paddle/fluid/framework/data_type.h"
+#include "paddle/fluid/platform/enforce.h"
+
+namespace paddle {
+namespace imperative {
+
+namespace {
+
+constexpr size_t kIpcNameLen = 64;
+
+struct TensorDesc {
+  char ipc_name[kIpcNameLen];
+  uint64_t segment_size;
+  int64_t dims[framework::DDim::kMaxRank];
+  int32_t rank;
+  int32_t dtype;
+};
+
+struct SegmentDesc {
+  char ipc_name[kIpcNameLen];
+  uint64_t segment_size;
+};
+
+// Lives at the start of the control segment, followed by the descriptor
+// ring (`capacity` TensorDescs) and the free ring (`2 * capacity`
+// SegmentDescs, kept as a stack).
+struct QueueControl {
+  pthread_mutex_t mutex;
+  pthread_cond_t not_empty;
+  pthread_cond_t not_full;
+  uint32_t capacity;
+  uint32_t head;
+  uint32_t size;
+  uint32_t free_size;
+};
+
+inline TensorDesc *DescRing(QueueControl *control) {
+  return reinterpret_cast<TensorDesc *>(control + 1);
+}
+
+inline SegmentDesc *FreeRing(QueueControl *control) {
+  return reinterpret_cast<SegmentDesc *>(DescRing(control) +
+                                         control->capacity);
+}
+
+inline size_t FreeRingCapacity(const QueueControl *control) {
+  return 2 * control->capacity;
+}
+
+inline size_t ControlSegmentSize(size_t capacity) {
+  return sizeof(QueueControl) + capacity * sizeof(TensorDesc) +
+         2 * capacity * sizeof(SegmentDesc);
+}
+
+void LockControl(QueueControl *control) {
+  int ret = pthread_mutex_lock(&control->mutex);
+#ifdef __linux__
+  if (ret == EOWNERDEAD) {
+    // A worker died while holding the lock; the robust mutex lets us
+    // recover instead of deadlocking the whole pipeline.
+    pthread_mutex_consistent(&control->mutex);
+    ret = 0;
+  }
+#endif
+  PADDLE_ENFORCE_EQ(ret, 0, platform::errors::Unavailable(
+                                "Fail to lock the shared memory tensor queue, "
+                                "error code is %d.",
+                                ret));
+}
+
+void CopyIpcName(char *dst, const std::string &name) {
+  PADDLE_ENFORCE_LT(name.size(), kIpcNameLen,
+                    platform::errors::InvalidArgument(
+                        "Shared memory name %s is too long.", name));
+  strncpy(dst, name.c_str(), kIpcNameLen);
+}
+
+}  // namespace
+
+// Aliases a shared memory segment as a tensor holder. When the last
+// reference dies the segment name goes back to the queue's free ring,
+// unless ownership was handed over to the descriptor ring by Push().
+class SharedMemoryTensorQueue::SegmentHolder
+    : public memory::allocation::Allocation {
+ public:
+  SegmentHolder(
+      std::shared_ptr<memory::allocation::MemoryMapWriterAllocation> segment,
+      std::shared_ptr<SharedMemoryTensorQueue> queue)
+      : Allocation(segment->ptr(), segment->size(), segment->place()),
+        segment_(std::move(segment)),
+        queue_(std::move(queue)) {}
+
+  ~SegmentHolder() override {
+    if (!detached_) {
+      queue_->ReleaseSegment(segment_);
+    }
+  }
+
+  const std::shared_ptr<memory::allocation::MemoryMapWriterAllocation>
+      &segment() const {
+    return segment_;
+  }
+
+  void Detach() { detached_ = true; }
+
+ private:
+  std::shared_ptr<memory::allocation::MemoryMapWriterAllocation> segment_;
+  std::shared_ptr<SharedMemoryTensorQueue> queue_;
+  bool detached_{false};
+};
+
+std::shared_ptr<SharedMemoryTensorQueue> SharedMemoryTensorQueue::Create(
+    size_t capacity) {
+  PADDLE_ENFORCE_GT(capacity, 0, platform::errors::InvalidArgument(
+                                     "The capacity of a shared memory tensor "
+                                     "queue must be positive."));
+  auto segment = memory::allocation::AllocateMemoryMapWriterAllocation(
+      ControlSegmentSize(capacity));
+  memory::allocation::MemoryMapFdSet::Instance().Insert(segment->ipc_name());
+
+  auto *control = static_cast<QueueControl *>(segment->ptr());
+  memset(control, 0, sizeof(QueueControl));
+  control->capacity = static_cast<uint32_t>(capacity);
+
+  pthread_mutexattr_t mutex_attr;
+  pthread_mutexattr_init(&mutex_attr);
+  pthread_mutexattr_setpshared(&mutex_attr, PTHREAD_PROCESS_SHARED);
+#ifdef __linux__
+  pthread_mutexattr_setrobust(&mutex_attr, PTHREAD_MUTEX_ROBUST);
+#endif
+  pthread_mutex_init(&control->mutex, &mutex_attr);
+  pthread_mutexattr_destroy(&mutex_attr);
+
+  pthread_condattr_t cond_attr;
+  pthread_condattr_init(&cond_attr);
+  pthread_condattr_setpshared(&cond_attr, PTHREAD_PROCESS_SHARED);
+  pthread_cond_init(&control->not_empty, &cond_attr);
+  pthread_cond_init(&control->not_full, &cond_attr);
+  pthread_condattr_destroy(&cond_attr);
+
+  return std::shared_ptr<SharedMemoryTensorQueue>(
+      new SharedMemoryTensorQueue(std::move(segment), /*owner=*/true));
+}
+
+std::shared_ptr<SharedMemoryTensorQueue> SharedMemoryTensorQueue::Attach(
+    const std::string &ipc_name, size_t capacity) {
+  auto segment = memory::allocation::RebuildMemoryMapWriterAllocation(
+      ipc_name, ControlSegmentSize(capacity));
+  auto *control = static_cast<QueueControl *>(segment->ptr());
+  PADDLE_ENFORCE_EQ(
+      control->capacity, capacity,
+      platform::errors::InvalidArgument(
+          "Attached the shared memory tensor queue %s with capacity %d, but "
+          "it was created with capacity %d.",
+          ipc_name, capacity, control->capacity));
+  return std::shared_ptr<SharedMemoryTensorQueue>(
+      new SharedMemoryTensorQueue(std::move(segment), /*owner=*/false));
+}
+
+SharedMemoryTensorQueue::SharedMemoryTensorQueue(
+    std::shared_ptr<memory::allocation::MemoryMapWriterAllocation>
+        control_segment,
+    bool owner)
+    : control_segment_(std::move(control_segment)), owner_(owner) {}
+
+SharedMemoryTensorQueue::~SharedMemoryTensorQueue() {
+  if (!owner_) {
+    return;
+  }
+  // Unlink every shared memory file the queue still knows about. Unlinking
+  // does not invalidate live mappings, it only forbids reopening by name.
+  auto *control = static_cast<QueueControl *>(control_segment_->ptr());
+  LockControl(control);
+  for (uint32_t i = 0; i < control->size; ++i) {
+    auto &desc = DescRing(control)[(control->head + i) % control->capacity];
+    shm_unlink(desc.ipc_name);
+  }
+  for (uint32_t i = 0; i < control->free_size; ++i) {
+    shm_unlink(FreeRing(control)[i].ipc_name);
+  }
+  pthread_mutex_unlock(&control->mutex);
+  {
+    std::lock_guard<std::mutex> guard(mappings_mutex_);
+    for (auto &item : mappings_) {
+      shm_unlink(item.first.c_str());
+    }
+  }
+  shm_unlink(control_segment_->ipc_name().c_str());
+  memory::allocation::MemoryMapFdSet::Instance().Remove(
+      control_segment_->ipc_name());
+}
+
+std::shared_ptr<memory::allocation::MemoryMapWriterAllocation>
+SharedMemoryTensorQueue::MapSegment(const std::string &ipc_name, size_t size) {
+  std::lock_guard<std::mutex> guard(mappings_mutex_);
+  auto iter = mappings_.find(ipc_name);
+  if (iter != mappings_.end()) {
+    return iter->second;
+  }
+  auto segment =
+      memory::allocation::RebuildMemoryMapWriterAllocation(ipc_name, size);
+  mappings_.emplace(ipc_name, segment);
+  return segment;
+}
+
+std::shared_ptr<memory::allocation::MemoryMapWriterAllocation>
+SharedMemoryTensorQueue::AcquireSegment(size_t size) {
+  auto *control = static_cast<QueueControl *>(control_segment_->ptr());
+  while (true) {
+    SegmentDesc taken;
+    bool found = false;
+    LockControl(control);
+    auto *free_ring = FreeRing(control);
+    int64_t best = -1;
+    for (uint32_t i = 0; i < control->free_size; ++i) {
+      if (free_ring[i].segment_size >= size &&
+          (best < 0 ||
+           free_ring[i].segment_size < free_ring[best].segment_size)) {
+        best = i;
+      }
+    }
+    if (best >= 0) {
+      taken = free_ring[best];
+      free_ring[best] = free_ring[--control->free_size];
+      found = true;
+    }
+    pthread_mutex_unlock(&control->mutex);
+
+    if (!found) {
+      break;
+    }
+    try {
+      return MapSegment(taken.ipc_name, taken.segment_size);
+    } catch (...) {
+      // The creating worker may have exited and unlinked the file; drop
+      // the stale entry and look for another one.
+      VLOG(3) << "Drop stale shared memory segment " << taken.ipc_name;
+    }
+  }
+
+  auto segment = memory::allocation::AllocateMemoryMapWriterAllocation(size);
+  memory::allocation::MemoryMapFdSet::Instance().Insert(segment->ipc_name());
+  std::lock_guard<std::mutex> guard(mappings_mutex_);
+  mappings_.emplace(segment->ipc_name(), segment);
+  return segment;
+}
+
+void SharedMemoryTensorQueue::ReleaseSegment(
+    const std::shared_ptr<memory::allocation::MemoryMapWriterAllocation>
+        &segment) {
+  auto *control = static_cast<QueueControl *>(control_segment_->ptr());
+  LockControl(control);
+  if (control->free_size < FreeRingCapacity(control)) {
+    auto &desc = FreeRing(control)[control->free_size++];
+    CopyIpcName(desc.ipc_name, segment->ipc_name());
+    desc.segment_size = segment->size();
+  } else {
+    // The segment stays mapped in its creator and is unlinked at queue
+    // destruction, it is just no longer recycled.
+    VLOG(3) << "Free ring is full, stop recycling " << segment->ipc_name();
+  }
+  pthread_mutex_unlock(&control->mutex);
+}
+
+framework::LoDTensor SharedMemoryTensorQueue::AcquireTensor(
+    const framework::DDim &dims, framework::proto::VarType::Type dtype) {
+  size_t size = framework::product(dims) * framework::SizeOfType(dtype);
+  auto segment = AcquireSegment(size);
+  framework::LoDTensor tensor;
+  tensor.Resize(dims);
+  tensor.ResetHolderWithType(
+      std::make_shared<SegmentHolder>(std::move(segment), shared_from_this()),
+      dtype);
+  return tensor;
+}
+
+void SharedMemoryTensorQueue::Push(const framework::LoDTensor &tensor) {
+  PADDLE_ENFORCE_EQ(tensor.IsInitialized(), true,
+                    platform::errors::InvalidArgument(
+                        "Cannot push an uninitialized tensor into the shared "
+                        "memory tensor queue."));
+  PADDLE_ENFORCE_EQ(tensor.lod().empty(), true,
+                    platform::errors::Unimplemented(
+                        "The shared memory tensor queue does not carry LoD."));
+
+  std::shared_ptr<memory::allocation::MemoryMapWriterAllocation> segment;
+  auto *holder = dynamic_cast<SegmentHolder *>(tensor.Holder().get());
+  if (holder != nullptr) {
+    // The data already lives in a segment, publish it without copying.
+    segment = holder->segment();
+    holder->Detach();
+  } else {
+    PADDLE_ENFORCE_EQ(platform::is_cpu_place(tensor.place()), true,
+                      platform::errors::InvalidArgument(
+                          "Only CPU tensors can be pushed into the shared "
+                          "memory tensor queue."));
+    size_t size = tensor.numel() * framework::SizeOfType(tensor.type());
+    segment = AcquireSegment(size);
+    memcpy(segment->ptr(), tensor.data<void>(), size);
+  }
+
+  auto *control = static_cast<QueueControl *>(control_segment_->ptr());
+  LockControl(control);
+  while (control->size == control->capacity) {
+    pthread_cond_wait(&control->not_full, &control->mutex);
+  }
+  auto &desc =
+      DescRing(control)[(control->head + control->size) % control->capacity];
+  CopyIpcName(desc.ipc_name, segment->ipc_name());
+  desc.segment_size = segment->size();
+  desc.rank = tensor.dims().size();
+  for (int i = 0; i < desc.rank; ++i) {
+    desc.dims[i] = tensor.dims()[i];
+  }
+  desc.dtype = static_cast<int32_t>(tensor.type());
+  ++control->size;
+  pthread_cond_signal(&control->not_empty);
+  pthread_mutex_unlock(&control->mutex);
+}
+
+void SharedMemoryTensorQueue::Pop(framework::LoDTensor *tensor) {
+  auto *control = static_cast<QueueControl *>(control_segment_->ptr());
+  LockControl(control);
+  while (control->size == 0) {
+    pthread_cond_wait(&control->not_empty, &control->mutex);
+  }
+  TensorDesc desc = DescRing(control)[control->head];
+  control->head = (control->head + 1) % control->capacity;
+  --control->size;
+  pthread_cond_signal(&control->not_full);
+  pthread_mutex_unlock(&control->mutex);
+
+  auto segment = MapSegment(desc.ipc_name, desc.segment_size);
+  tensor->Resize(framework::make_ddim(
+      std::vector<int64_t>(desc.dims, desc.dims + desc.rank)));
+  tensor->ResetHolderWithType(
+      std::make_shared<SegmentHolder>(std::move(segment), shared_from_this()),
+      static_cast<framework::proto::VarType::Type>(desc.dtype));
+}
+
+}  // namespace imperative
+}  // namespace paddle
+
+#endif
@@ -0,0 +1,113 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _WIN32
+
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "paddle/fluid/framework/lod_tensor.h"
+#include "paddle/fluid/memory/allocation/mmap_allocator.h"
+
+namespace paddle {
+namespace imperative {
+
+/**
+ * A fixed-capacity cross-process tensor queue backed by shared memory.
+ *
+ * Batch tensors are written by DataLoader worker processes directly into
+ * mmap segments and rebuilt by the trainer process as LoDTensors aliasing
+ * the same pages, so crossing the process boundary costs neither
+ * serialization nor a batch memcpy. A producer obtains a tensor living in
+ * a (recycled when possible) segment via AcquireTensor(), fills it and
+ * publishes it with Push(); a consumer receives it with Pop(). Once the
+ * consumer-side tensor dies, the segment name returns to a free ring in
+ * the control segment and is reused by later AcquireTensor() calls, so a
+ * steady-state pipeline creates no new shared memory files.
+ *
+ * Push() also accepts tensors that do not live in a segment and copies
+ * them once on the producer side. The producer must not touch a tensor
+ * after pushing it. LoD is not carried across the queue.
+ */
+class SharedMemoryTensorQueue
+    : public std::enable_shared_from_this<SharedMemoryTensorQueue> {
+ public:
+  // Create the queue and its control segment (consumer/trainer side).
+  static std::shared_ptr<SharedMemoryTensorQueue> Create(size_t capacity);
+
+  // Attach to an existing queue by the name of its control segment
+  // (producer/worker side). `capacity` must match the creator's.
+  static std::shared_ptr<SharedMemoryTensorQueue> Attach(
+      const std::string &ipc_name, size_t capacity);
+
+  ~SharedMemoryTensorQueue();
+
+  const std::string &ipc_name() const { return control_segment_->ipc_name(); }
+
+  // Return a tensor whose holder is a shared memory segment, so the
+  // producer writes batch data in place and Push() is zero-copy.
+  framework::LoDTensor AcquireTensor(const framework::DDim &dims,
+                                     framework::proto::VarType::Type dtype);
+
+  // Publish a tensor. Blocks while the queue is full.
+  void Push(const framework::LoDTensor &tensor);
+
+  // Receive the oldest published tensor. Blocks while the queue is empty.
+  void Pop(framework::LoDTensor *tensor);
+
+ private:
+  class SegmentHolder;
+
+  SharedMemoryTensorQueue(
+      std::shared_ptr<memory::allocation::MemoryMapWriterAllocation>
+          control_segment,
+      bool owner);
+
+  // Take a suitable segment from the shared free ring or create a new one.
+  std::shared_ptr<memory::allocation::MemoryMapWriterAllocation>
+  AcquireSegment(size_t size);
+
+  // Map a segment by name, served from the process-local mapping cache.
+  std::shared_ptr<memory::allocation::MemoryMapWriterAllocation> MapSegment(
+      const std::string &ipc_name, size_t size);
+
+  // Called when the last tensor referencing a segment dies.
+  void ReleaseSegment(
+      const std::shared_ptr<memory::allocation::MemoryMapWriterAllocation>
+          &segment);
+
+  std::shared_ptr<memory::allocation::MemoryMapWriterAllocation>
+      control_segment_;
+  // Whether this process created the queue and is responsible for
+  // unlinking the shared memory files at destruction.
+  bool owner_;
+  // Every segment this process has mapped, kept alive so recycled
+  // segments are never remapped. Bounded by the number of distinct
+  // segments, which the free ring bounds in steady state.
+  std::unordered_map<
+      std::string,
+      std::shared_ptr<memory::allocation::MemoryMapWriterAllocation>>
+      mappings_;
+  std::mutex mappings_mutex_;
+};
+
+}  // namespace imperative
+}  // namespace paddle
+
+#endif
@@ -0,0 +1,246 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Microbenchmarks for the dygraph framework overhead: the fixed per-op cost
+// of Tracer::TraceOp (attr checking, grad-node construction, PreparedOp
+// dispatch) and of BasicEngine backward setup plus gradient accumulation.
+// Tiny CPU tensors are used on purpose so the kernels themselves are almost
+// free and the measured time is dominated by the framework.
+//
+// The tests always log the per-op cost; they only fail when a baseline file
+// (--dygraph_benchmark_baseline) or an absolute budget
+// (--dygraph_per_op_budget_us) is supplied, so the default CI run stays
+// immune to machine noise while release qualification can enforce budgets.
+
+#include <paddle/fluid/framework/op_registry.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/fluid/imperative/basic_engine.h"
+#include "paddle/fluid/imperative/tracer.h"
+#include "paddle/fluid/inference/utils/benchmark_harness.h"
+#include "paddle/fluid/platform/timer.h"
+
+DEFINE_string(dygraph_benchmark_output, "",
+              "File the per-op overhead records are appended to as JSON "
+              "lines, empty disables recording.");
+DEFINE_string(dygraph_benchmark_baseline, "",
+              "JSON-lines baseline produced by a previous run with "
+              "--dygraph_benchmark_output; when set, a p99 regression beyond "
+              "the tolerance fails the test.");
+DEFINE_double(dygraph_benchmark_tolerance, 0.2,
+              "Allowed relative p99 slowdown against the baseline.");
+DEFINE_double(dygraph_per_op_budget_us, 0.0,
+              "Absolute per-op overhead budget in microseconds, 0 disables "
+              "the check.");
+
+namespace paddle {
+namespace imperative {
+
+using vb_vector = std::vector<std::shared_ptr<imperative::VarBase>>;
+
+using var_pair = std::pair<std::string, vb_vector>;
+
+constexpr int kWarmupOps = 200;
+constexpr int kChunks = 50;
+constexpr int kOpsPerChunk = 100;
+
+static std::shared_ptr<imperative::VarBase> NewVarBase(
+    const std::string& name, const framework::DDim& dims, float value,
+    const platform::CPUPlace& place) {
+  std::shared_ptr<imperative::VarBase> var(
+      new imperative::VarBase(true, name));
+  auto* tensor = var->MutableVar()->GetMutable<framework::LoDTensor>();
+  tensor->Resize(dims);
+  auto* data = tensor->mutable_data<float>(place);
+  for (int64_t i = 0; i < tensor->numel(); ++i) {
+    data[i] = value;
+  }
+  return var;
+}
+
+// Turns the per-chunk timings into a tracked record, logs it, and applies
+// the optional baseline / budget checks. chunk_latencies_ms holds the
+// per-op latency of each measured chunk.
+static void ReportPerOpCost(const std::string& config,
+                            const std::vector<double>& chunk_latencies_ms) {
+  inference::BenchmarkRecord record;
+  record.model_name = "dygraph_overhead";
+  record.config = config;
+  record.batch_size = 1;
+  record.num_threads = 1;
+  record.SetLatencies(chunk_latencies_ms);
+  record.peak_mem_kb = inference::ProcessPeakMemoryKB();
+
+  double per_op_us = record.latency_avg * 1000.0;
+  LOG(INFO) << config << ": " << per_op_us << " us per op (p99 "
+            << record.latency_p99 * 1000.0 << " us)";
+  if (!FLAGS_dygraph_benchmark_output.empty()) {
+    record.AppendToFile(FLAGS_dygraph_benchmark_output);
+  }
+  if (!FLAGS_dygraph_benchmark_baseline.empty()) {
+    inference::BenchmarkBaseline baseline;
+    ASSERT_TRUE(baseline.Load(FLAGS_dygraph_benchmark_baseline));
+    std::string message;
+    EXPECT_TRUE(baseline.CheckRegression(
+        record, FLAGS_dygraph_benchmark_tolerance, &message))
+        << message;
+  }
+  if (FLAGS_dygraph_per_op_budget_us > 0.0) {
+    EXPECT_LE(per_op_us, FLAGS_dygraph_per_op_budget_us) << config;
+  }
+}
+
+// Measures the forward dispatch path (TraceOp + PreparedOp::Run) for one op
+// type. With trace_backward set the grad-node construction cost is included
+// as well, which is what a training step actually pays.
+static void BenchmarkForward(const std::string& op_type,
+                             const imperative::NameVarBaseMap& ins,
+                             const imperative::NameVarBaseMap& outs,
+                             const framework::AttributeMap& attrs,
+                             bool trace_backward, const std::string& config) {
+  imperative::Tracer tracer;
+  platform::CPUPlace place;
+  for (int i = 0; i < kWarmupOps; ++i) {
+    tracer.TraceOp(op_type, ins, outs, attrs, place, trace_backward);
+  }
+  std::vector<double> chunk_latencies_ms;
+  chunk_latencies_ms.reserve(kChunks);
+  platform::Timer timer;
+  for (int c = 0; c < kChunks; ++c) {
+    timer.Reset();
+    timer.Start();
+    for (int i = 0; i < kOpsPerChunk; ++i) {
+      tracer.TraceOp(op_type, ins, outs, attrs, place, trace_backward);
+    }
+    timer.Pause();
+    chunk_latencies_ms.push_back(timer.ElapsedMS() / kOpsPerChunk);
+  }
+  ReportPerOpCost(config, chunk_latencies_ms);
+}
+
+TEST(benchmark_dygraph_overhead, elementwise_add_forward) {
+  platform::CPUPlace place;
+  auto x = NewVarBase("x", framework::make_ddim({2, 2}), 1.0f, place);
+  auto y = NewVarBase("y", framework::make_ddim({2, 2}), 2.0f, place);
+  std::shared_ptr<imperative::VarBase> out(
+      new imperative::VarBase(true, "out"));
+  imperative::NameVarBaseMap ins = {var_pair("X", vb_vector(1, x)),
+                                    var_pair("Y", vb_vector(1, y))};
+  imperative::NameVarBaseMap outs = {var_pair("Out", vb_vector(1, out))};
+  framework::AttributeMap attrs;
+  attrs["use_mkldnn"] = false;
+  BenchmarkForward("elementwise_add", ins, outs, attrs, false,
+                   "elementwise_add_fwd");
+}
+
+TEST(benchmark_dygraph_overhead, mul_forward) {
+  platform::CPUPlace place;
+  auto x = NewVarBase("x", framework::make_ddim({2, 2}), 1.0f, place);
+  auto y = NewVarBase("y", framework::make_ddim({2, 2}), 2.0f, place);
+  std::shared_ptr<imperative::VarBase> out(
+      new imperative::VarBase(true, "out"));
+  imperative::NameVarBaseMap ins = {var_pair("X", vb_vector(1, x)),
+                                    var_pair("Y", vb_vector(1, y))};
+  imperative::NameVarBaseMap outs = {var_pair("Out", vb_vector(1, out))};
+  framework::AttributeMap attrs;
+  attrs["use_mkldnn"] = false;
+  BenchmarkForward("mul", ins, outs, attrs, false, "mul_fwd");
+}
+
+TEST(benchmark_dygraph_overhead, reduce_sum_forward) {
+  platform::CPUPlace place;
+  auto x = NewVarBase("x", framework::make_ddim({2, 2}), 1.0f, place);
+  std::shared_ptr<imperative::VarBase> out(
+      new imperative::VarBase(true, "out"));
+  imperative::NameVarBaseMap ins = {var_pair("X", vb_vector(1, x))};
+  imperative::NameVarBaseMap outs = {var_pair("Out", vb_vector(1, out))};
+  framework::AttributeMap attrs;
+  BenchmarkForward("reduce_sum", ins, outs, attrs, false, "reduce_sum_fwd");
+}
+
+TEST(benchmark_dygraph_overhead, elementwise_add_forward_with_grad_record) {
+  platform::CPUPlace place;
+  auto x = NewVarBase("x", framework::make_ddim({2, 2}), 1.0f, place);
+  auto y = NewVarBase("y", framework::make_ddim({2, 2}), 2.0f, place);
+  x->SetOverridedStopGradient(false);
+  y->SetOverridedStopGradient(false);
+  std::shared_ptr<imperative::VarBase> out(
+      new imperative::VarBase(true, "out"));
+  imperative::NameVarBaseMap ins = {var_pair("X", vb_vector(1, x)),
+                                    var_pair("Y", vb_vector(1, y))};
+  imperative::NameVarBaseMap outs = {var_pair("Out", vb_vector(1, out))};
+  framework::AttributeMap attrs;
+  attrs["use_mkldnn"] = false;
+  BenchmarkForward("elementwise_add", ins, outs, attrs, true,
+                   "elementwise_add_fwd_record_grad");
+}
+
+// Measures BasicEngine setup plus execution per backward op. The chain keeps
+// feeding the same y into every elementwise_add, so y's grad receives one
+// contribution per op and the GradientAccumulator path is on the critical
+// path of the measurement, just like a shared embedding or bias in a real
+// model.
+TEST(benchmark_dygraph_overhead, elementwise_add_backward_chain) {
+  constexpr int kBackwardChunks = 20;
+  imperative::Tracer tracer;
+  platform::CPUPlace place;
+  framework::AttributeMap attrs;
+  attrs["use_mkldnn"] = false;
+
+  std::vector<double> chunk_latencies_ms;
+  chunk_latencies_ms.reserve(kBackwardChunks);
+  platform::Timer timer;
+  // Warmup chunk plus measured chunks; the first result is dropped.
+  for (int c = 0; c < kBackwardChunks + 1; ++c) {
+    auto cur = NewVarBase("x", framework::make_ddim({2, 2}), 1.0f, place);
+    auto y = NewVarBase("y", framework::make_ddim({2, 2}), 2.0f, place);
+    cur->SetOverridedStopGradient(false);
+    y->SetOverridedStopGradient(false);
+    for (int i = 0; i < kOpsPerChunk; ++i) {
+      std::shared_ptr<imperative::VarBase> out(
+          new imperative::VarBase(true, "out_" + std::to_string(i)));
+      imperative::NameVarBaseMap ins = {var_pair("X", vb_vector(1, cur)),
+                                        var_pair("Y", vb_vector(1, y))};
+      imperative::NameVarBaseMap outs = {var_pair("Out", vb_vector(1, out))};
+      tracer.TraceOp("elementwise_add", ins, outs, attrs, place, true);
+      cur = out;
+    }
+    timer.Reset();
+    timer.Start();
+    std::vector<std::shared_ptr<imperative::VarBase>> tensors{cur};
+    std::vector<std::shared_ptr<imperative::VarBase>> grad_tensors{nullptr};
+    imperative::BasicEngine engine;
+    engine.Init(tensors, grad_tensors);
+    engine.Execute();
+    timer.Pause();
+    if (c > 0) {
+      chunk_latencies_ms.push_back(timer.ElapsedMS() / kOpsPerChunk);
+    }
+  }
+  ReportPerOpCost("elementwise_add_bwd_chain", chunk_latencies_ms);
+}
+
+}  // namespace imperative
+}  // namespace paddle
+
+USE_OP(mul);
+USE_OP(mul_grad);
+USE_OP(reduce_sum);
+USE_OP(elementwise_add);
+USE_OP(elementwise_add_grad);
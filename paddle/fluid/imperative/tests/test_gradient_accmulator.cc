@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <memory>
+#include <string>
 #include <type_traits>
 #include <vector>
 #include "gtest/gtest.h"
@@ -354,6 +355,52 @@ static void TestGradientAccumulatorTestUnchangeInput(
   }
 }
 
+static void TestFusedDenseSum(const platform::Place& place) {
+  framework::DDim dim{10, 20};
+  constexpr size_t kContributorNum = 4;
+
+  // the sorted accumulator sums dense contributors with one fused pass,
+  // the eager one adds them pairwise; both must produce the same result
+  auto sorted_var = std::make_shared<VariableWrapper>("sorted_grad");
+  sorted_var->SetOverridedStopGradient(false);
+  auto sorted_accum = CreateAccumulator(sorted_var, true);
+
+  auto eager_var = std::make_shared<VariableWrapper>("eager_grad");
+  eager_var->SetOverridedStopGradient(false);
+  auto eager_accum = CreateAccumulator(eager_var, false);
+
+  for (size_t i = 0; i < kContributorNum; ++i) {
+    sorted_accum->IncreaseRefCnt();
+    eager_accum->IncreaseRefCnt();
+  }
+
+  for (size_t i = 0; i < kContributorNum; ++i) {
+    auto var = RandomTensor<float>(dim, place);
+    auto sorted_wrapper =
+        std::make_shared<VariableWrapper>("tmp_sorted_" + std::to_string(i));
+    auto eager_wrapper =
+        std::make_shared<VariableWrapper>("tmp_eager_" + std::to_string(i));
+    CopyVar(var, sorted_wrapper->MutableVar());
+    CopyVar(var, eager_wrapper->MutableVar());
+    sorted_accum->SumGrad(sorted_wrapper, i, false);
+    eager_accum->SumGrad(eager_wrapper, i, false);
+  }
+
+  ASSERT_TRUE(sorted_accum->SumGradCompleted());
+  ASSERT_TRUE(eager_accum->SumGradCompleted());
+  sorted_accum->AccumulateGrad();
+  eager_accum->AccumulateGrad();
+
+  ASSERT_TRUE(IsEqualVar(sorted_var->Var(), eager_var->Var()));
+}
+
+TEST(test_gradient_accumulator, test_fused_dense_sum) {
+  TestFusedDenseSum(platform::CPUPlace());
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  TestFusedDenseSum(platform::CUDAPlace(0));
+#endif
+}
+
 TEST(test_gradient_accumulator, test_unchange_input) {
   for (auto sort_gradient : {false, true}) {
     TestGradientAccumulatorTestUnchangeInput(platform::CPUPlace(),
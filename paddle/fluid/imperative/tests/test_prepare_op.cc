@@ -25,6 +25,8 @@
 #include "paddle/fluid/imperative/prepared_operator.h"
 #include "paddle/fluid/imperative/type_defs.h"
 
+DECLARE_bool(dygraph_prepared_op_cache);
+
 namespace imperative = paddle::imperative;
 namespace platform = paddle::platform;
 namespace framework = paddle::framework;
@@ -209,6 +211,56 @@ TEST(test_prepare_op, test_prepare_data_same_place) {
   TestPrepareDataSamePlace({});
 }
 
+TEST(test_prepare_op, test_prepared_op_cache) {
+  FLAGS_dygraph_prepared_op_cache = true;
+
+  platform::CPUPlace place;
+  std::vector<float> src_data(10, 2.0);
+  std::vector<int64_t> dims = {2, 5};
+  const std::string op_type = "relu";
+  const auto& info = framework::OpInfoMap::Instance().Get(op_type);
+  framework::AttributeMap attr_map;
+  if (info.Checker()) info.Checker()->Check(&attr_map);
+
+  // run the same op with the same input signature twice; the second run
+  // takes the cached kernel and replays the cached output dims
+  for (size_t step = 0; step < 2; ++step) {
+    std::shared_ptr<imperative::VarBase> vin(
+        new imperative::VarBase(false, "vin"));
+    std::shared_ptr<imperative::VarBase> vout(
+        new imperative::VarBase(false, "vout"));
+    auto* vin_tensor = vin->MutableVar()->GetMutable<framework::LoDTensor>();
+    vin_tensor->Resize(framework::make_ddim(dims));
+    auto* vin_mutable_tensor = vin_tensor->mutable_data<float>(place);
+    paddle::memory::Copy(place, vin_mutable_tensor, place, src_data.data(),
+                         sizeof(float) * src_data.size());
+
+    var_pair x_pair = var_pair("X", vb_vector(1, vin));
+    var_pair out_pair = var_pair("Out", vb_vector(1, vout));
+    imperative::NameVarBaseMap ins = {x_pair};
+    imperative::NameVarBaseMap outs = {out_pair};
+    framework::VariableNameMap var_in_map =
+        CreateVarNameMap(info, op_type, ins, true);
+    framework::VariableNameMap var_out_map =
+        CreateVarNameMap(info, op_type, outs, false);
+    auto op = framework::OpRegistry::CreateOp(op_type, var_in_map, var_out_map,
+                                              attr_map);
+
+    auto prepared_op = PreparedOp::Prepare(
+        ins, outs, dynamic_cast<framework::OperatorWithKernel&>(*op), place,
+        attr_map, {});
+    prepared_op.Run(ins, outs, attr_map, {});
+
+    auto& vout_tensor = vout->Var().Get<framework::LoDTensor>();
+    ASSERT_EQ(vout_tensor.dims(), framework::make_ddim(dims));
+    for (int i = 0; i < vout_tensor.numel(); ++i) {
+      ASSERT_EQ(vout_tensor.data<float>()[i], 2.0);
+    }
+  }
+
+  FLAGS_dygraph_prepared_op_cache = false;
+}
+
 #ifdef PADDLE_WITH_MKLDNN
 TEST(test_prepare_op, test_prepare_data_cpu_mkldnn) {
   TestPrepareDataSamePlace({{"use_mkldnn", true}});
@@ -28,6 +28,8 @@
 #include "paddle/fluid/imperative/tracer.h"
 #include "paddle/fluid/memory/memcpy.h"
 
+DECLARE_int32(imperative_backward_threads);
+
 namespace imperative = paddle::imperative;
 namespace platform = paddle::platform;
 namespace framework = paddle::framework;
@@ -85,6 +87,63 @@ TEST(test_tracer, test_trace_op) {
   }
 }
 
+TEST(test_tracer, test_amp_cast_cache_invalidated_by_op_write) {
+  imperative::Tracer tracer;
+  std::shared_ptr<imperative::VarBase> param(
+      new imperative::VarBase(true, "param"));
+  std::shared_ptr<imperative::VarBase> grad(
+      new imperative::VarBase(true, "grad"));
+  std::shared_ptr<imperative::VarBase> lr(new imperative::VarBase(true, "lr"));
+  platform::CPUPlace place;
+  std::vector<float> param_data(10, 1.0);
+  std::vector<float> grad_data(10, 1.0);
+  std::vector<float> lr_data(1, 0.5);
+  std::vector<int64_t> dims = {2, 5};
+
+  auto* param_tensor = param->MutableVar()->GetMutable<framework::LoDTensor>();
+  param_tensor->Resize(framework::make_ddim(dims));
+  auto* mutable_param = param_tensor->mutable_data<float>(place);
+  paddle::memory::Copy(place, mutable_param, place, param_data.data(),
+                       sizeof(float) * param_data.size());
+  auto* grad_tensor = grad->MutableVar()->GetMutable<framework::LoDTensor>();
+  grad_tensor->Resize(framework::make_ddim(dims));
+  auto* mutable_grad = grad_tensor->mutable_data<float>(place);
+  paddle::memory::Copy(place, mutable_grad, place, grad_data.data(),
+                       sizeof(float) * grad_data.size());
+  auto* lr_tensor = lr->MutableVar()->GetMutable<framework::LoDTensor>();
+  lr_tensor->Resize(framework::make_ddim({1}));
+  auto* mutable_lr = lr_tensor->mutable_data<float>(place);
+  paddle::memory::Copy(place, mutable_lr, place, lr_data.data(),
+                       sizeof(float) * lr_data.size());
+
+  // A cached low-precision copy, as AMP auto cast would leave behind after
+  // the forward pass.
+  std::shared_ptr<imperative::VarBase> cast_out(
+      new imperative::VarBase(true, "param_fp16"));
+  param->SharedVar()->SetAmpCastCache(framework::proto::VarType::FP16, false,
+                                      cast_out);
+  ASSERT_EQ(param->SharedVar()->GetAmpCastCache(framework::proto::VarType::FP16,
+                                                false),
+            cast_out);
+
+  imperative::NameVarBaseMap ins = {var_pair("Param", vb_vector(1, param)),
+                                    var_pair("Grad", vb_vector(1, grad)),
+                                    var_pair("LearningRate", vb_vector(1, lr))};
+  imperative::NameVarBaseMap outs = {var_pair("ParamOut", vb_vector(1, param))};
+  framework::AttributeMap attrs;
+  tracer.TraceOp("sgd", ins, outs, attrs, place, false);
+
+  // The optimizer wrote Param in place without bumping the inplace version,
+  // so the stale cast must have been dropped explicitly.
+  ASSERT_EQ(param->SharedVar()->GetAmpCastCache(framework::proto::VarType::FP16,
+                                                false),
+            nullptr);
+  const auto& param_out = param->Var().Get<framework::LoDTensor>();
+  for (int i = 0; i < param_out.numel(); i++) {
+    ASSERT_EQ(param_out.data<float>()[i], 0.5);
+  }
+}
+
 TEST(test_tracer, test_trace_op_with_backward) {
   // Doing an mul
   imperative::Tracer tracer;
@@ -333,6 +392,181 @@ TEST(test_tracer, test_expected_place) {
   }
 }
 
+TEST(test_tracer, test_parallel_backward) {
+  // Two independent mul branches summed together, so backward has
+  // independent branches that may run on different threads.
+  imperative::Tracer tracer;
+  platform::CPUPlace place;
+  std::vector<float> src_data(4, 2.0);
+  std::vector<int64_t> dims = {2, 2};
+
+  auto create_var = [&](const std::string& name) {
+    std::shared_ptr<imperative::VarBase> var(
+        new imperative::VarBase(true, name));
+    var->SetOverridedStopGradient(false);
+    auto* tensor = var->MutableVar()->GetMutable<framework::LoDTensor>();
+    tensor->Resize(framework::make_ddim(dims));
+    auto* data = tensor->mutable_data<float>(place);
+    paddle::memory::Copy(place, data, place, src_data.data(),
+                         sizeof(float) * src_data.size());
+    return var;
+  };
+
+  auto x_in = create_var("x_in");
+  auto y_in = create_var("y_in");
+  auto a_in = create_var("a_in");
+  auto b_in = create_var("b_in");
+  std::shared_ptr<imperative::VarBase> branch0(
+      new imperative::VarBase(true, "branch0"));
+  std::shared_ptr<imperative::VarBase> branch1(
+      new imperative::VarBase(true, "branch1"));
+  std::shared_ptr<imperative::VarBase> vout(
+      new imperative::VarBase(true, "vout"));
+
+  framework::AttributeMap mul_attr_map;
+  mul_attr_map["use_mkldnn"] = false;
+  tracer.TraceOp("mul", {{"X", vb_vector(1, x_in)}, {"Y", vb_vector(1, y_in)}},
+                 {{"Out", vb_vector(1, branch0)}}, mul_attr_map, place, true);
+  tracer.TraceOp("mul", {{"X", vb_vector(1, a_in)}, {"Y", vb_vector(1, b_in)}},
+                 {{"Out", vb_vector(1, branch1)}}, mul_attr_map, place, true);
+  tracer.TraceOp("elementwise_add",
+                 {{"X", vb_vector(1, branch0)}, {"Y", vb_vector(1, branch1)}},
+                 {{"Out", vb_vector(1, vout)}}, mul_attr_map, place, true);
+
+  FLAGS_imperative_backward_threads = 4;
+  std::vector<std::shared_ptr<imperative::VarBase>> tensors{vout};
+  std::vector<std::shared_ptr<imperative::VarBase>> grad_tensors{nullptr};
+  imperative::BasicEngine engine;
+  engine.Init(tensors, grad_tensors);
+  engine.Execute();
+  FLAGS_imperative_backward_threads = 1;
+
+  for (auto& var : {x_in, y_in, a_in, b_in}) {
+    framework::LoDTensor grad;
+    framework::TensorCopySync(var->GradVar().Get<framework::LoDTensor>(),
+                              place, &grad);
+    for (int i = 0; i < grad.numel(); ++i) {
+      ASSERT_EQ(grad.data<float>()[i], 4.0);
+    }
+  }
+}
+
+TEST(test_tracer, test_hot_loop_capture) {
+  imperative::Tracer tracer;
+  tracer.EnableHotLoopCapture(2);
+  platform::CPUPlace place;
+  std::vector<float> src_data(10, 2.0);
+  std::vector<int64_t> dims1 = {2, 5};
+  std::vector<int64_t> dims2 = {5, 2};
+
+  auto create_var = [&](const std::string& name,
+                        const std::vector<int64_t>& dims) {
+    std::shared_ptr<imperative::VarBase> var(
+        new imperative::VarBase(false, name));
+    auto* tensor = var->MutableVar()->GetMutable<framework::LoDTensor>();
+    tensor->Resize(framework::make_ddim(dims));
+    auto* data = tensor->mutable_data<float>(place);
+    paddle::memory::Copy(place, data, place, src_data.data(),
+                         sizeof(float) * src_data.size());
+    return var;
+  };
+
+  auto x_in = create_var("x_in", dims1);
+  auto y_in = create_var("y_in", dims2);
+  std::shared_ptr<imperative::VarBase> vout(
+      new imperative::VarBase(false, "vout"));
+
+  framework::AttributeMap mul_attr_map;
+  mul_attr_map["use_mkldnn"] = false;
+  auto* capturer = tracer.GetHotLoopCapturer();
+  ASSERT_TRUE(capturer != nullptr);
+
+  // two stable iterations arm the capturer, the third one is captured
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_FALSE(capturer->IsReady());
+    tracer.TraceOp("mul",
+                   {{"X", vb_vector(1, x_in)}, {"Y", vb_vector(1, y_in)}},
+                   {{"Out", vb_vector(1, vout)}}, mul_attr_map, place, false);
+    tracer.MarkLoopIterationEnd();
+  }
+  ASSERT_TRUE(capturer->IsReady());
+  ASSERT_EQ(capturer->FeedVarNames().size(), 2UL);
+  ASSERT_EQ(capturer->FetchVarNames().size(), 1UL);
+  ASSERT_FALSE(tracer.IsProgramDescTracingEnabled());
+
+  // a diverging iteration drops the capture and falls back to observing
+  auto vadd = create_var("vadd", dims1);
+  tracer.TraceOp("elementwise_add",
+                 {{"X", vb_vector(1, x_in)}, {"Y", vb_vector(1, x_in)}},
+                 {{"Out", vb_vector(1, vadd)}}, mul_attr_map, place, false);
+  tracer.MarkLoopIterationEnd();
+  ASSERT_FALSE(capturer->IsReady());
+}
+
+TEST(test_tracer, test_recompute_segment) {
+  // Two chained muls inside a recompute segment: the intermediate is
+  // dropped after forward and restored by replay during backward.
+  imperative::Tracer tracer;
+  platform::CPUPlace place;
+  std::vector<float> src_data(4, 2.0);
+  std::vector<int64_t> dims = {2, 2};
+
+  auto create_var = [&](const std::string& name) {
+    std::shared_ptr<imperative::VarBase> var(
+        new imperative::VarBase(true, name));
+    var->SetOverridedStopGradient(false);
+    auto* tensor = var->MutableVar()->GetMutable<framework::LoDTensor>();
+    tensor->Resize(framework::make_ddim(dims));
+    auto* data = tensor->mutable_data<float>(place);
+    paddle::memory::Copy(place, data, place, src_data.data(),
+                         sizeof(float) * src_data.size());
+    return var;
+  };
+
+  auto x_in = create_var("x_in");
+  auto y_in = create_var("y_in");
+  std::shared_ptr<imperative::VarBase> vmid(
+      new imperative::VarBase(true, "vmid"));
+  std::shared_ptr<imperative::VarBase> vout(
+      new imperative::VarBase(true, "vout"));
+
+  framework::AttributeMap mul_attr_map;
+  mul_attr_map["use_mkldnn"] = false;
+  tracer.BeginRecomputeSegment();
+  tracer.TraceOp("mul", {{"X", vb_vector(1, x_in)}, {"Y", vb_vector(1, y_in)}},
+                 {{"Out", vb_vector(1, vmid)}}, mul_attr_map, place, true);
+  tracer.TraceOp("mul", {{"X", vb_vector(1, vmid)}, {"Y", vb_vector(1, y_in)}},
+                 {{"Out", vb_vector(1, vout)}}, mul_attr_map, place, true);
+  tracer.EndRecomputeSegment({vout});
+
+  // the intermediate activation is dropped, the segment output is kept
+  ASSERT_FALSE(vmid->Var().Get<framework::LoDTensor>().IsInitialized());
+  ASSERT_TRUE(vout->Var().Get<framework::LoDTensor>().IsInitialized());
+
+  std::vector<std::shared_ptr<imperative::VarBase>> tensors{vout};
+  std::vector<std::shared_ptr<imperative::VarBase>> grad_tensors{nullptr};
+  imperative::BasicEngine engine;
+  engine.Init(tensors, grad_tensors);
+  engine.Execute();
+
+  // backward replayed the segment and restored the intermediate
+  ASSERT_TRUE(vmid->Var().Get<framework::LoDTensor>().IsInitialized());
+
+  // out = (x * y) * y with all-2.0 2x2 inputs, so dx = 16, dy = 32
+  framework::LoDTensor x_grad;
+  framework::TensorCopySync(x_in->GradVar().Get<framework::LoDTensor>(), place,
+                            &x_grad);
+  for (int i = 0; i < x_grad.numel(); ++i) {
+    ASSERT_EQ(x_grad.data<float>()[i], 16.0);
+  }
+  framework::LoDTensor y_grad;
+  framework::TensorCopySync(y_in->GradVar().Get<framework::LoDTensor>(), place,
+                            &y_grad);
+  for (int i = 0; i < y_grad.numel(); ++i) {
+    ASSERT_EQ(y_grad.data<float>()[i], 32.0);
+  }
+}
+
 TEST(test_tracer, test_var_without_grad_var) {
   // Doing an mul
   imperative::Tracer tracer;
@@ -538,3 +772,4 @@ USE_OP(mul_grad);
 USE_OP(reduce_sum);
 USE_OP(reduce_sum_grad);
 USE_OP(elementwise_add);
+USE_OP(sgd);
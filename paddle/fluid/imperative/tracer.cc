@@ -19,6 +19,7 @@
 #include "paddle/fluid/framework/op_registry.h"
 #include "paddle/fluid/imperative/amp_auto_cast.h"
 #include "paddle/fluid/imperative/op_base.h"
+#include "paddle/fluid/imperative/recompute_segment.h"
 #include "paddle/fluid/platform/denormal.h"
 #include "paddle/fluid/platform/profiler.h"
 #include "paddle/fluid/string/string_helper.h"
@@ -227,17 +228,67 @@ void Tracer::TraceOp(const std::string& type, const NameVarBaseMap& ins,
         "Operator %s raises an unknown exception.", type));
   }
 
+  // Writing a var invalidates its cached low-precision copy, otherwise AMP
+  // would keep feeding a stale cast after e.g. an optimizer parameter update.
+  for (auto& pair : outs) {
+    for (auto& var : pair.second) {
+      if (var) {
+        var->SharedVar()->ClearAmpCastCache();
+      }
+    }
+  }
+
   if (enable_program_desc_tracing_) {
     VLOG(5) << "Trace op " << type << " into ProgramDesc";
     program_desc_tracer_->InsertOp(type, new_ins, outs, attrs);
   }
 
-  if (ComputeRequiredGrad(new_ins, outs, trace_backward)) {
+  const bool require_grad = ComputeRequiredGrad(new_ins, outs, trace_backward);
+  if (hot_loop_capturer_ != nullptr) {
+    hot_loop_capturer_->NoteOp(type, new_ins, outs, require_grad);
+  }
+  if (require_grad) {
     CreateGradOpNode(*op, new_ins, outs, attrs, default_attrs, place,
                      inplace_map);
   } else {
     VLOG(3) << "No Grad to track for Op: " << type;
   }
+
+  if (recompute_segment_ != nullptr) {
+    if (require_grad) {
+      // Attach the segment to the grad node just created, so that the
+      // backward pass replays the segment before running this op's grads.
+      for (auto& pair : outs) {
+        for (auto& var : pair.second) {
+          if (var && var->GradNode()) {
+            var->GradNode()->SetRecomputeSegment(recompute_segment_);
+          }
+        }
+      }
+    }
+    recompute_segment_->RecordOp(std::move(op), new_ins, outs, attrs,
+                                 default_attrs, place);
+  }
+}
+
+void Tracer::MarkLoopIterationEnd() {
+  if (hot_loop_capturer_ == nullptr) {
+    return;
+  }
+  if (hot_loop_capture_owns_tracing_) {
+    hot_loop_capturer_->FinishCapture(program_desc_tracer_.get(),
+                                      expected_place_);
+    enable_program_desc_tracing_ = false;
+    hot_loop_capture_owns_tracing_ = false;
+    program_desc_tracer_->Reset();
+    return;
+  }
+  // record the next iteration unless an explicit trace is already running
+  if (hot_loop_capturer_->OnIterationEnd() && !enable_program_desc_tracing_) {
+    program_desc_tracer_->Reset();
+    enable_program_desc_tracing_ = true;
+    hot_loop_capture_owns_tracing_ = true;
+  }
 }
 
 void Tracer::TraceOp(const std::string& type, const NameVarBaseMap& ins,
@@ -251,6 +302,35 @@ void Tracer::SetExpectedPlace(platform::Place place) {
   expected_place_ = place;
 }
 
+void Tracer::BeginRecomputeSegment() {
+  PADDLE_ENFORCE_EQ(
+      recompute_segment_ == nullptr, true,
+      platform::errors::PermissionDenied(
+          "Cannot begin a recompute segment inside another recompute "
+          "segment, nested segments are not supported."));
+  VLOG(3) << "Begin recompute segment";
+  recompute_segment_ = std::make_shared<RecomputeSegment>();
+}
+
+void Tracer::EndRecomputeSegment(
+    const std::vector<std::shared_ptr<VarBase>>& outputs) {
+  PADDLE_ENFORCE_EQ(recompute_segment_ != nullptr, true,
+                    platform::errors::PermissionDenied(
+                        "Cannot end a recompute segment, no segment has "
+                        "been begun."));
+  // stop recording before dropping anything
+  auto segment = std::move(recompute_segment_);
+  std::vector<std::shared_ptr<VariableWrapper>> kept;
+  kept.reserve(outputs.size());
+  for (auto& out : outputs) {
+    if (out) {
+      kept.emplace_back(out->SharedVar());
+    }
+  }
+  VLOG(3) << "End recompute segment with " << segment->OpNum() << " ops";
+  segment->DropIntermediates(kept);
+}
+
 bool Tracer::ComputeRequiredGrad(const NameVarBaseMap& ins,
                                  const NameVarBaseMap& outs,
                                  bool trace_backward) {
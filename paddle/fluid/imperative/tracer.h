@@ -25,6 +25,7 @@
 #include "paddle/fluid/framework/garbage_collector.h"
 #include "paddle/fluid/imperative/amp_auto_cast.h"
 #include "paddle/fluid/imperative/basic_engine.h"
+#include "paddle/fluid/imperative/jit/hot_loop_capturer.h"
 #include "paddle/fluid/imperative/jit/program_desc_tracer.h"
 #include "paddle/fluid/imperative/layer.h"
 #include "paddle/fluid/platform/macros.h"
@@ -34,6 +35,8 @@ namespace imperative {
 
 enum class AmpLevel;
 
+class RecomputeSegment;
+
 using GarbageCollectorMap =
     std::map<platform::Place,
              std::unique_ptr<paddle::framework::GarbageCollector>>;
@@ -87,6 +90,25 @@ class Tracer {
     return program_desc_tracer_.get();
   }
 
+  // Enable auto-capture of steady-state loops: once the traced op stream
+  // has repeated the same signature for `capture_threshold` consecutive
+  // iterations (delimited by MarkLoopIterationEnd), the next iteration is
+  // captured into a program that can be replayed through the new executor.
+  // See jit::HotLoopCapturer.
+  void EnableHotLoopCapture(size_t capture_threshold = 3) {
+    hot_loop_capturer_.reset(new jit::HotLoopCapturer(capture_threshold));
+  }
+
+  void DisableHotLoopCapture() { hot_loop_capturer_.reset(); }
+
+  jit::HotLoopCapturer* GetHotLoopCapturer() {
+    return hot_loop_capturer_.get();
+  }
+
+  // Marks the end of one user-level loop iteration for hot-loop capture.
+  // No-op unless EnableHotLoopCapture has been called.
+  void MarkLoopIterationEnd();
+
   // Note(Aurelius84): The `tmp` is used as prefix key while naming a temporary
   // intermediate var both in imperative and static mode. But the
   // `UniqueNameGenerator` in C++ and `unique_name.py` in Python doesn't share
@@ -112,6 +134,16 @@ class Tracer {
 
   AmpLevel GetAmpLevel() const { return amp_level_; }
 
+  // Start recording the traced ops into a recompute segment. Ops traced
+  // until EndRecomputeSegment keep no intermediate activations after the
+  // forward pass; they are re-executed on demand during backward.
+  void BeginRecomputeSegment();
+
+  // Stop recording and drop every tensor produced inside the segment
+  // except the given segment outputs.
+  void EndRecomputeSegment(
+      const std::vector<std::shared_ptr<VarBase>>& outputs);
+
   paddle::framework::GarbageCollector* MutableGarbageCollectorIfNotExists(
       const platform::Place& place);
 
@@ -119,11 +151,17 @@ class Tracer {
   std::unique_ptr<BasicEngine> basic_engine_;
   std::unique_ptr<jit::ProgramDescTracer> program_desc_tracer_;
   bool enable_program_desc_tracing_{false};
+  std::unique_ptr<jit::HotLoopCapturer> hot_loop_capturer_;
+  // whether program desc tracing was turned on by the hot-loop capturer
+  // (as opposed to an explicit SetEnableProgramDescTracing call)
+  bool hot_loop_capture_owns_tracing_{false};
   std::unique_ptr<UniqueNameGenerator> generator_;
   platform::Place expected_place_;
   GarbageCollectorMap gcs_;
   static thread_local bool has_grad_;
   AmpLevel amp_level_{AmpLevel::O0};
+  // The recompute segment currently being recorded, if any
+  std::shared_ptr<RecomputeSegment> recompute_segment_;
 };
 
 // To access static variable current_tracer
@@ -233,6 +233,39 @@ class VariableWrapper {
     return;
   }
 
+  // Following methods cache the low precision copy made by AMP auto cast
+  // (see AutoCastInputs), so that a var shared by several ops is cast at
+  // most once per iteration. The cached copy is dropped once the source
+  // tensor is modified inplace (e.g. by the optimizer update), or when
+  // the gradient requirement of the cast changes.
+  std::shared_ptr<VarBase> GetAmpCastCache(
+      framework::proto::VarType::Type dst_type, bool trace_backward) {
+    if (amp_cast_cache_ && amp_cast_dtype_ == dst_type &&
+        amp_cast_trace_backward_ == trace_backward &&
+        amp_cast_version_ == var_.CurrentInplaceVersion()) {
+      return amp_cast_cache_;
+    }
+    return nullptr;
+  }
+
+  void SetAmpCastCache(framework::proto::VarType::Type dst_type,
+                       bool trace_backward,
+                       const std::shared_ptr<VarBase>& val) {
+    amp_cast_cache_ = val;
+    amp_cast_dtype_ = dst_type;
+    amp_cast_trace_backward_ = trace_backward;
+    amp_cast_version_ = var_.CurrentInplaceVersion();
+  }
+
+  // Called whenever an op writes this var. Optimizer updates (sgd, adam,
+  // momentum, ...) modify parameters through ParamOut without bumping the
+  // inplace version, so the version check above alone cannot see them.
+  void ClearAmpCastCache() {
+    if (amp_cast_cache_) {
+      amp_cast_cache_ = nullptr;
+    }
+  }
+
   /* Hook related methods */
   bool HasVariableWrapperHook() const { return !var_hooks_.empty(); }
 
@@ -307,6 +340,13 @@ class VariableWrapper {
   // compute of Paddle Quantum
   std::map<paddle::framework::OpKernelType, std::shared_ptr<VariableWrapper>>
       var_cache;
+  // Used for caching the low precision copy made by AMP auto cast, so
+  // that a var shared by several ops is cast at most once per iteration
+  std::shared_ptr<VarBase> amp_cast_cache_;
+  framework::proto::VarType::Type amp_cast_dtype_{
+      static_cast<framework::proto::VarType::Type>(-1)};
+  uint32_t amp_cast_version_{0};
+  bool amp_cast_trace_backward_{false};
   // add this property for users may set stop_gradient themselves and this
   // should override the frameworks setting (-1) unset, (1) true, (0) false
   int overrided_stop_gradient_{-1};
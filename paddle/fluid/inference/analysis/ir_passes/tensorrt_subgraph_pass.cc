@@ -83,11 +83,33 @@ void analysis::TensorRtSubgraphPass::ApplyImpl(
              new std::vector<std::string>(repetitive_params));
 }
 
+// Fold the dynamic shape ranges into one string, so that serialized engines
+// are keyed by the shape profile they were built with and an engine cached
+// for one profile is never reused for another.
+std::string GenerateShapeRangeKey(
+    const std::map<std::string, std::vector<int>> &min_input_shape,
+    const std::map<std::string, std::vector<int>> &max_input_shape,
+    const std::map<std::string, std::vector<int>> &opt_input_shape) {
+  std::string key;
+  for (auto *shapes : {&min_input_shape, &max_input_shape, &opt_input_shape}) {
+    for (const auto &it : *shapes) {
+      key += it.first + ":";
+      for (int d : it.second) {
+        key += std::to_string(d) + ",";
+      }
+      key += ";";
+    }
+    key += "#";
+  }
+  return key;
+}
+
 std::string GenerateEngineKey(const std::set<std::string> &engine_inputs,
                               const std::set<std::string> &engine_outputs,
                               const std::string &predictor_id,
                               const std::string &max_batch_size,
                               const std::string &precision,
+                              const std::string &shape_range_key,
                               const bool for_calibration) {
   std::string engine_hash_key = "";
   for (auto name : engine_inputs) {
@@ -102,6 +124,8 @@ std::string GenerateEngineKey(const std::set<std::string> &engine_inputs,
   if (!for_calibration) {
     engine_hash_key += "#";
     engine_hash_key += max_batch_size;
+    engine_hash_key += "#";
+    engine_hash_key += shape_range_key;
   }
   engine_hash_key += "#";
   engine_hash_key += precision;
@@ -283,14 +307,17 @@ void TensorRtSubgraphPass::CreateTensorRTOp(
   // when running in the 'use_serialize' mode, there is a bug.
   // serialization is affected by max_batch_size, but calibration is not.
   // So we use seperate engine keys in serialization and calibration.
+  auto shape_range_key =
+      GenerateShapeRangeKey(min_input_shape, max_input_shape, opt_input_shape);
   auto engine_key = GenerateEngineKey(
       input_names_with_id, output_names_with_id, std::to_string(0),
       std::to_string(max_batch_size),
-      std::to_string(static_cast<int>(precision_mode)), false);
-  auto calibration_engine_key =
-      GenerateEngineKey(input_names_with_id, output_names_with_id,
-                        std::to_string(0), std::to_string(max_batch_size),
-                        std::to_string(static_cast<int>(precision_mode)), true);
+      std::to_string(static_cast<int>(precision_mode)), shape_range_key,
+      false);
+  auto calibration_engine_key = GenerateEngineKey(
+      input_names_with_id, output_names_with_id, std::to_string(0),
+      std::to_string(max_batch_size),
+      std::to_string(static_cast<int>(precision_mode)), shape_range_key, true);
   auto predictor_id = Get<int>("predictor_id");
 
   // Get "" when there is no cached calibration table data.
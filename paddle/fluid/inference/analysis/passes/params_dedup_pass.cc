@@ -0,0 +1,126 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/inference/analysis/passes/params_dedup_pass.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "paddle/fluid/framework/data_type.h"
+#include "paddle/fluid/framework/lod_tensor.h"
+#include "paddle/fluid/framework/tensor_util.h"
+#include "paddle/fluid/inference/analysis/argument.h"
+
+namespace paddle {
+namespace inference {
+namespace analysis {
+
+namespace {
+
+// 64-bit FNV-1a over the tensor bytes.
+uint64_t HashTensorBytes(const void *data, size_t len) {
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < len; ++i) {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+}  // namespace
+
+void ParamsDedupPass::RunImpl(Argument *argument) {
+  if (!argument->scope_valid()) return;
+  auto *scope = argument->scope_ptr();
+
+  // A candidate is the first tensor seen with its content. For weights that
+  // do not live on the CPU, the bytes are staged to the host once for
+  // hashing and comparison; the staged copies are released when the pass
+  // returns.
+  struct Candidate {
+    framework::LoDTensor *tensor;
+    std::shared_ptr<framework::LoDTensor> host;
+    std::string name;
+  };
+  std::vector<Candidate> candidates;
+  std::unordered_map<uint64_t, std::vector<size_t>> buckets;
+
+  // Sort the names so the choice of the canonical tensor is deterministic.
+  std::vector<std::string> all_vars = scope->LocalVarNames();
+  std::sort(all_vars.begin(), all_vars.end());
+
+  size_t aliased_num = 0;
+  size_t saved_bytes = 0;
+  for (auto &var_name : all_vars) {
+    auto *var = scope->FindLocalVar(var_name);
+    if (var == nullptr || !var->IsType<framework::LoDTensor>()) continue;
+    auto *t = var->GetMutable<framework::LoDTensor>();
+    if (!t->IsInitialized() || t->numel() == 0) continue;
+
+    size_t byte_len =
+        static_cast<size_t>(t->numel()) * framework::SizeOfType(t->type());
+    const void *host_data = nullptr;
+    std::shared_ptr<framework::LoDTensor> host;
+    if (platform::is_cpu_place(t->place())) {
+      host_data = t->data<void>();
+    } else {
+      host = std::make_shared<framework::LoDTensor>();
+      TensorCopySync(*t, platform::CPUPlace(), host.get());
+      host_data = host->data<void>();
+    }
+
+    auto &bucket = buckets[HashTensorBytes(host_data, byte_len)];
+    bool aliased = false;
+    for (size_t idx : bucket) {
+      auto &c = candidates[idx];
+      if (c.tensor->type() != t->type() || c.tensor->dims() != t->dims()) {
+        continue;
+      }
+      const void *c_data =
+          c.host ? c.host->data<void>() : c.tensor->data<void>();
+      if (std::memcmp(c_data, host_data, byte_len) != 0) continue;
+      // The content is identical, so point this var at the canonical
+      // allocation and drop its own. Inference never writes weights, so
+      // the sharing is not observable.
+      VLOG(3) << "Aliasing weight " << var_name << " to identical weight "
+              << c.name;
+      t->ShareDataWith(*c.tensor);
+      ++aliased_num;
+      saved_bytes += byte_len;
+      aliased = true;
+      break;
+    }
+    if (!aliased) {
+      bucket.push_back(candidates.size());
+      candidates.push_back({t, host, var_name});
+    }
+  }
+
+  if (aliased_num > 0) {
+    LOG(INFO) << "Aliased " << aliased_num
+              << " weight tensors with identical content, saving "
+              << saved_bytes / 1048576.0 << " MB";
+  }
+}
+
+std::string ParamsDedupPass::repr() const { return "params-dedup-pass"; }
+
+}  // namespace analysis
+}  // namespace inference
+}  // namespace paddle
@@ -94,6 +94,14 @@ void AnalysisConfig::DisableGpu() {
   Update();
 }
 
+void AnalysisConfig::SetExecStream(void* stream) {
+  PADDLE_ENFORCE_NOT_NULL(stream, platform::errors::InvalidArgument(
+                                      "The external stream must not be null, "
+                                      "please re-check the argument."));
+  exec_stream_ = stream;
+  use_external_stream_ = true;
+}
+
 void AnalysisConfig::DisableFCPadding() {
   use_fc_padding_ = false;
 
@@ -149,11 +157,21 @@ AnalysisConfig::AnalysisConfig(const AnalysisConfig &other) {
   CP_MEMBER(use_fc_padding_);
   // GPU related.
   CP_MEMBER(use_gpu_);
+  CP_MEMBER(use_external_stream_);
+  CP_MEMBER(exec_stream_);
   CP_MEMBER(use_cudnn_);
   CP_MEMBER(gpu_device_id_);
   CP_MEMBER(memory_pool_init_size_mb_);
 
   CP_MEMBER(enable_memory_optim_);
+  CP_MEMBER(enable_dynamic_memory_optim_);
+  CP_MEMBER(dynamic_memory_optim_history_window_);
+  // optimized program cache related.
+  CP_MEMBER(enable_optimized_program_cache_);
+  // dynamic batching related.
+  CP_MEMBER(enable_dynamic_batching_);
+  CP_MEMBER(dynamic_batching_max_batch_size_);
+  CP_MEMBER(dynamic_batching_timeout_us_);
   // TensorRT related.
   CP_MEMBER(use_tensorrt_);
   CP_MEMBER(tensorrt_workspace_size_);
@@ -170,6 +188,10 @@ AnalysisConfig::AnalysisConfig(const AnalysisConfig &other) {
   CP_MEMBER(trt_allow_build_at_runtime_);
   CP_MEMBER(collect_shape_range_info_);
   CP_MEMBER(shape_range_info_path_);
+  CP_MEMBER(monitor_shape_range_info_);
+  CP_MEMBER(shape_range_flush_interval_runs_);
+  CP_MEMBER(trt_auto_shape_profile_);
+  CP_MEMBER(trt_shape_profile_warmup_runs_);
   // Dlnne related
   CP_MEMBER(use_dlnne_);
   CP_MEMBER(dlnne_min_subgraph_size_);
@@ -222,6 +244,8 @@ AnalysisConfig::AnalysisConfig(const AnalysisConfig &other) {
   CP_MEMBER(specify_input_name_);
 
   CP_MEMBER(cpu_math_library_num_threads_);
+  CP_MEMBER(cpu_thread_affinity_core_ids_);
+  CP_MEMBER(cpu_thread_affinity_numa_node_);
 
   CP_MEMBER(serialized_info_cache_);
 
@@ -646,6 +670,30 @@ void AnalysisConfig::SetCpuMathLibraryNumThreads(
   Update();
 }
 
+void AnalysisConfig::SetCpuThreadAffinity(const std::vector<int> &core_ids) {
+  PADDLE_ENFORCE_EQ(core_ids.empty(), false,
+                    platform::errors::InvalidArgument(
+                        "The core_ids of SetCpuThreadAffinity should not be "
+                        "empty, please re-check the argument."));
+  for (int core_id : core_ids) {
+    PADDLE_ENFORCE_GE(core_id, 0,
+                      platform::errors::InvalidArgument(
+                          "The core ids of SetCpuThreadAffinity should be "
+                          "non-negative, but got %d.",
+                          core_id));
+  }
+  cpu_thread_affinity_core_ids_ = core_ids;
+}
+
+void AnalysisConfig::SetCpuThreadAffinityNumaNode(int numa_node) {
+  PADDLE_ENFORCE_GE(numa_node, 0,
+                    platform::errors::InvalidArgument(
+                        "The numa_node of SetCpuThreadAffinityNumaNode should "
+                        "be non-negative, but got %d.",
+                        numa_node));
+  cpu_thread_affinity_numa_node_ = numa_node;
+}
+
 float AnalysisConfig::fraction_of_gpu_memory_for_pool() const {
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
   // Get the GPU memory details and calculate the fraction of memory for the
@@ -675,6 +723,33 @@ bool AnalysisConfig::enable_memory_optim() const {
   return enable_memory_optim_;
 }
 
+void AnalysisConfig::EnableDynamicMemoryOptim(int history_window) {
+  PADDLE_ENFORCE_GT(history_window, 0,
+                    platform::errors::InvalidArgument(
+                        "The history window of the runtime activation-buffer "
+                        "planner should be positive, but received %d.",
+                        history_window));
+  enable_dynamic_memory_optim_ = true;
+  dynamic_memory_optim_history_window_ = history_window;
+}
+
+void AnalysisConfig::EnableDynamicBatching(int max_batch_size,
+                                           int batch_timeout_us) {
+  PADDLE_ENFORCE_GT(max_batch_size, 0,
+                    platform::errors::InvalidArgument(
+                        "The max batch size of dynamic batching should be "
+                        "positive, but received %d.",
+                        max_batch_size));
+  PADDLE_ENFORCE_GE(batch_timeout_us, 0,
+                    platform::errors::InvalidArgument(
+                        "The timeout of dynamic batching should not be "
+                        "negative, but received %d.",
+                        batch_timeout_us));
+  enable_dynamic_batching_ = true;
+  dynamic_batching_max_batch_size_ = max_batch_size;
+  dynamic_batching_timeout_us_ = batch_timeout_us;
+}
+
 void AnalysisConfig::SetModelBuffer(const char *prog_buffer,
                                     size_t prog_buffer_size,
                                     const char *param_buffer,
@@ -753,6 +828,17 @@ std::string AnalysisConfig::Summary() {
   // cpu info
   os.InsertRow(
       {"cpu_math_thread", std::to_string(cpu_math_library_num_threads_)});
+  if (!cpu_thread_affinity_core_ids_.empty()) {
+    std::string core_list;
+    for (int core_id : cpu_thread_affinity_core_ids_) {
+      core_list += (core_list.empty() ? "" : ",") + std::to_string(core_id);
+    }
+    os.InsertRow({"cpu_thread_affinity_cores", core_list});
+  }
+  if (cpu_thread_affinity_numa_node_ >= 0) {
+    os.InsertRow({"cpu_thread_affinity_numa_node",
+                  std::to_string(cpu_thread_affinity_numa_node_)});
+  }
   os.InsertRow({"enable_mkldnn", use_mkldnn_ ? "true" : "false"});
   os.InsertRow(
       {"mkldnn_cache_capacity", std::to_string(mkldnn_cache_capacity_)});
@@ -799,6 +885,9 @@ std::string AnalysisConfig::Summary() {
       os.InsertRow({"tensorrt_tuned_dynamic_shape", trt_tuned_dynamic_shape_
                                                         ? shape_range_info_path_
                                                         : "false"});
+      os.InsertRow({"tensorrt_auto_shape_profile",
+                    trt_auto_shape_profile_ ? shape_range_info_path_
+                                            : "false"});
 
       os.InsertRow({"tensorrt_use_oss", trt_use_oss_ ? "true" : "false"});
       os.InsertRow({"tensorrt_use_dla", trt_use_dla_ ? "true" : "false"});
@@ -826,10 +915,22 @@ std::string AnalysisConfig::Summary() {
   os.InsertRow({"ir_optim", enable_ir_optim_ ? "true" : "false"});
   os.InsertRow({"ir_debug", ir_debug_ ? "true" : "false"});
   os.InsertRow({"memory_optim", enable_memory_optim_ ? "true" : "false"});
+  os.InsertRow({"dynamic_memory_optim",
+                enable_dynamic_memory_optim_ ? "true" : "false"});
+  os.InsertRow({"optimized_program_cache",
+                enable_optimized_program_cache_ ? "true" : "false"});
+  if (enable_dynamic_batching_) {
+    os.InsertRow({"dynamic_batching_max_batch_size",
+                  std::to_string(dynamic_batching_max_batch_size_)});
+    os.InsertRow({"dynamic_batching_timeout_us",
+                  std::to_string(dynamic_batching_timeout_us_)});
+  }
   os.InsertRow({"enable_profile", with_profile_ ? "true" : "false"});
   os.InsertRow({"enable_log", with_glog_info_ ? "true" : "false"});
   os.InsertRow({"collect_shape_range_info",
                 collect_shape_range_info_ ? shape_range_info_path_ : "false"});
+  os.InsertRow({"monitor_shape_range_info",
+                monitor_shape_range_info_ ? shape_range_info_path_ : "false"});
 
   return os.PrintTable();
 }
@@ -911,6 +1012,22 @@ bool AnalysisConfig::shape_range_info_collected() {
   return collect_shape_range_info_;
 }
 
+void AnalysisConfig::EnableShapeRangeMonitoring(
+    const std::string &shape_range_info_path, int flush_interval_runs) {
+  PADDLE_ENFORCE_EQ(shape_range_info_path.empty(), false,
+                    platform::errors::InvalidArgument(
+                        "The shape_range_info_path should not be empty, please "
+                        "re-check the argument."));
+  PADDLE_ENFORCE_GE(flush_interval_runs, 1,
+                    platform::errors::InvalidArgument(
+                        "The flush_interval_runs should be at least 1, but "
+                        "received %d.",
+                        flush_interval_runs));
+  monitor_shape_range_info_ = true;
+  shape_range_info_path_ = shape_range_info_path;
+  shape_range_flush_interval_runs_ = flush_interval_runs;
+}
+
 void AnalysisConfig::EnableTunedTensorRtDynamicShape(
     const std::string &shape_range_info_path, bool allow_build_at_runtime) {
   shape_range_info_path_ = shape_range_info_path;
@@ -925,4 +1042,23 @@ bool AnalysisConfig::tuned_tensorrt_dynamic_shape() {
 bool AnalysisConfig::trt_allow_build_at_runtime() {
   return trt_allow_build_at_runtime_;
 }
+
+void AnalysisConfig::EnableTensorRtAutoShapeProfile(
+    const std::string &shape_range_info_path, int warmup_runs) {
+  PADDLE_ENFORCE_EQ(shape_range_info_path.empty(), false,
+                    platform::errors::InvalidArgument(
+                        "The shape_range_info_path should not be empty, please "
+                        "re-check the argument."));
+  PADDLE_ENFORCE_GT(warmup_runs, 0,
+                    platform::errors::InvalidArgument(
+                        "The warmup_runs of the automatic TensorRT shape "
+                        "profile should be positive, but got %d.",
+                        warmup_runs));
+  trt_auto_shape_profile_ = true;
+  trt_shape_profile_warmup_runs_ = warmup_runs;
+  shape_range_info_path_ = shape_range_info_path;
+  // The tuned engine takes minutes to build, serialize it to the
+  // optimization cache so that restarts only deserialize.
+  trt_use_static_engine_ = true;
+}
 }  // namespace paddle
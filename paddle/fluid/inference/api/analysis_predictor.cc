@@ -17,14 +17,20 @@
 #include <glog/logging.h>
 
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
 #include <fstream>
 #include <memory>
 #include <set>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "paddle/fluid/extension/include/ext_op_meta_info.h"
+#include "paddle/fluid/framework/data_type.h"
 #include "paddle/fluid/framework/feed_fetch_method.h"
 #include "paddle/fluid/framework/feed_fetch_type.h"
 #include "paddle/fluid/framework/ir/fuse_pass_base.h"
@@ -164,6 +170,9 @@ bool AnalysisPredictor::Init(
 
   // no matter with or without MKLDNN
   paddle::platform::SetNumThreads(config_.cpu_math_library_num_threads());
+  ApplyCpuThreadAffinity();
+
+  ResolveTensorRtShapeProfile();
 
   if (!PrepareScope(parent_scope)) {
     return false;
@@ -175,6 +184,12 @@ bool AnalysisPredictor::Init(
     return false;
   }
 
+  // The parameter scope is frozen from here on: every later variable
+  // (feed/fetch, activations) lives in sub_scope_. Publish a read snapshot
+  // so concurrent Run() threads resolve shared weights without taking the
+  // scope lock; a stray mutation simply invalidates it.
+  scope_->BuildReadSnapshot();
+
   // Prepare executor, create local variables.
   if (!PrepareExecutor()) {
     return true;
@@ -186,6 +201,19 @@ bool AnalysisPredictor::Init(
   return true;
 }
 
+framework::Scope *SubScopePool::CheckOut() {
+  std::lock_guard<std::mutex> lk(mutex_);
+  if (scopes_.empty()) return nullptr;
+  auto *scope = scopes_.back();
+  scopes_.pop_back();
+  return scope;
+}
+
+void SubScopePool::Return(framework::Scope *scope) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  scopes_.push_back(scope);
+}
+
 bool AnalysisPredictor::PrepareScope(
     const std::shared_ptr<framework::Scope> &parent_scope) {
   if (parent_scope) {
@@ -199,9 +227,20 @@ bool AnalysisPredictor::PrepareScope(
     paddle::framework::InitDevices();
     // TODO(wilber): we need to release memory occupied by weights.
     scope_.reset(new paddle::framework::Scope());
+    sub_scope_pool_.reset(new SubScopePool);
     status_is_cloned_ = false;
   }
-  sub_scope_ = &scope_->NewScope();
+  // Reuse a retired activation scope when one is pooled; its variables and
+  // warm buffers are kept, CreateVariables on it later is a no-op for the
+  // variables that already exist.
+  if (sub_scope_pool_) {
+    sub_scope_ = sub_scope_pool_->CheckOut();
+  }
+  if (sub_scope_) {
+    VLOG(3) << "reuse a pooled sub scope for predictor " << predictor_id_;
+  } else {
+    sub_scope_ = &scope_->NewScope();
+  }
   return true;
 }
 bool AnalysisPredictor::PrepareProgram(
@@ -217,13 +256,29 @@ bool AnalysisPredictor::PrepareProgram(
     // So in both case, create persistable variables at first.
     executor_->CreateVariables(*inference_program_, 0, true, sub_scope_);
 
-    // if enable_ir_optim_ is false,
-    // the analysis pass(op fuse, graph analysis, trt subgraph, mkldnn etc) will
-    // not be executed.
-    OptimizeInferenceProgram();
+    // When the optimized program cache holds an entry for this model and
+    // config, the post-analysis program and its transformed parameters are
+    // loaded from disk and the whole analysis pipeline is skipped. The path
+    // must be computed before the analysis runs, because the config releases
+    // part of its storage afterwards.
+    std::string cache_prefix = GetOptimizedProgramCachePath();
+    if (!cache_prefix.empty() && LoadOptimizedProgramCache(cache_prefix)) {
+      LOG(INFO) << "Loaded the optimized program from cache " << cache_prefix
+                << ", the analysis passes are skipped.";
+    } else {
+      // if enable_ir_optim_ is false,
+      // the analysis pass(op fuse, graph analysis, trt subgraph, mkldnn etc)
+      // will not be executed.
+      OptimizeInferenceProgram();
+      if (!cache_prefix.empty()) {
+        SaveOptimizedProgramCache(cache_prefix);
+      }
+    }
   } else {
     // If the program is passed from external, no need to optimize it, this
-    // logic is used in the clone scenario.
+    // logic is used in the clone scenario. The parameters already live in the
+    // shared parameter scope and must not be created (or loaded) again, so
+    // only the non-persistable variables are created in sub_scope_ below.
     inference_program_ = program;
   }
 
@@ -340,7 +395,13 @@ static void DisablePrepareDataOpt(
 }
 
 bool AnalysisPredictor::PrepareExecutor() {
-  DisablePrepareDataOpt(inference_program_, 0, false);
+  // The pass below annotates the ProgramDesc. A cloned predictor shares the
+  // ProgramDesc with the predictor it was cloned from, which has already run
+  // the pass, so re-running it would only re-walk the whole program and write
+  // to a structure that other predictors may be reading concurrently.
+  if (!status_is_cloned_) {
+    DisablePrepareDataOpt(inference_program_, 0, false);
+  }
 
   executor_->Prepare(sub_scope_, *inference_program_, 0,
                      config_.use_feed_fetch_ops_);
@@ -412,6 +473,9 @@ bool AnalysisPredictor::Run(const std::vector<PaddleTensor> &inputs,
                             std::vector<PaddleTensor> *output_data,
                             int batch_size) {
   paddle::platform::SetNumThreads(config_.cpu_math_library_num_threads());
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  BindExternalStream();
+#endif
 #ifdef PADDLE_WITH_MKLDNN
   if (config_.use_mkldnn_) MkldnnPreSet(inputs);
 #endif
@@ -449,6 +513,10 @@ bool AnalysisPredictor::Run(const std::vector<PaddleTensor> &inputs,
   }
   tensor_array_batch_cleaner_.ResetNoTensorVars();
 
+  if (config_.dynamic_memory_optim_enabled()) {
+    ShrinkActivationBuffers();
+  }
+
   // recover the cpu_math_library_num_threads to 1, in order to avoid thread
   // conflict when integrating it into deployment service.
   paddle::platform::SetNumThreads(1);
@@ -972,8 +1040,106 @@ std::unique_ptr<ZeroCopyTensor> AnalysisPredictor::GetOutputTensor(
   return res;
 }
 
+namespace {
+
+std::string StandbyInputVarName(const std::string &name) {
+  return "__standby__" + name;
+}
+
+}  // namespace
+
+std::unique_ptr<ZeroCopyTensor> AnalysisPredictor::GetStandbyInputTensor(
+    const std::string &name) {
+  PADDLE_ENFORCE_NOT_NULL(
+      executor_->scope()->FindVar(name),
+      platform::errors::PreconditionNotMet(
+          "The variable named %s is not found in the scope of the exector.",
+          name));
+  const std::string standby_name = StandbyInputVarName(name);
+  if (executor_->scope()->FindVar(standby_name) == nullptr) {
+    // The standby variable only lives in the runtime scope. It is not part
+    // of the program, so the executor never touches it; it is only swapped
+    // with the real input variable in SwapStandbyInputs.
+    sub_scope_->Var(standby_name)->GetMutable<framework::LoDTensor>();
+  }
+  standby_input_names_.insert(name);
+  std::unique_ptr<ZeroCopyTensor> res(
+      new ZeroCopyTensor(static_cast<void *>(executor_->scope())));
+  res->input_or_output_ = true;
+  res->SetName(standby_name);
+  if (platform::is_cpu_place(place_)) {
+    res->SetPlace(PaddlePlace::kCPU);
+  } else if (platform::is_gpu_place(place_)) {
+    auto gpu_place = BOOST_GET_CONST(platform::CUDAPlace, place_);
+    res->SetPlace(PaddlePlace::kGPU, gpu_place.GetDeviceId());
+  } else {
+    PADDLE_THROW(platform::errors::Unimplemented(
+        "Asynchronous input binding is only supported on CPU and GPU "
+        "places now."));
+  }
+  return res;
+}
+
+void *AnalysisPredictor::GetInputCopyStream() {
+#if defined(PADDLE_WITH_CUDA)
+  if (!platform::is_gpu_place(place_)) {
+    return nullptr;
+  }
+  if (input_copy_stream_ == nullptr) {
+    cudaStream_t copy_stream;
+    cudaEvent_t copy_done;
+    cudaEvent_t compute_done;
+    cudaStreamCreateWithFlags(&copy_stream, cudaStreamNonBlocking);
+    cudaEventCreateWithFlags(&copy_done, cudaEventDisableTiming);
+    cudaEventCreateWithFlags(&compute_done, cudaEventDisableTiming);
+    input_copy_stream_ = copy_stream;
+    input_copy_done_event_ = copy_done;
+    compute_done_event_ = compute_done;
+  }
+  return input_copy_stream_;
+#else
+  return nullptr;
+#endif
+}
+
+void AnalysisPredictor::SwapStandbyInputs() {
+#if defined(PADDLE_WITH_CUDA)
+  if (input_copy_stream_ == nullptr || standby_input_names_.empty()) {
+    return;
+  }
+  auto *dev_ctx = static_cast<const platform::CUDADeviceContext *>(
+      platform::DeviceContextPool::Instance().Get(place_));
+  // Handshake: the compute stream may only read the swapped-in buffers
+  // after the asynchronous H2D copies issued on the copy stream have
+  // landed. Both the record and the wait run on the device, so the host
+  // never blocks here.
+  cudaEventRecord(static_cast<cudaEvent_t>(input_copy_done_event_),
+                  static_cast<cudaStream_t>(input_copy_stream_));
+  cudaStreamWaitEvent(dev_ctx->stream(),
+                      static_cast<cudaEvent_t>(input_copy_done_event_), 0);
+  for (const auto &name : standby_input_names_) {
+    auto *standby = executor_->scope()
+                        ->FindVar(StandbyInputVarName(name))
+                        ->GetMutable<framework::LoDTensor>();
+    if (!standby->IsInitialized()) {
+      continue;
+    }
+    auto *input =
+        executor_->scope()->FindVar(name)->GetMutable<framework::LoDTensor>();
+    // O(1) swap of the underlying buffers: the buffer the previous batch
+    // read from becomes the standby buffer of the next staging round, so
+    // the two buffer sets alternate between runs.
+    std::swap(*input, *standby);
+  }
+#endif
+}
+
 bool AnalysisPredictor::ZeroCopyRun() {
   paddle::platform::SetNumThreads(config_.cpu_math_library_num_threads());
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  BindExternalStream();
+#endif
+  SwapStandbyInputs();
 #ifdef PADDLE_WITH_MKLDNN
   if (config_.use_mkldnn_) {
     std::vector<std::vector<int>> shape_vector;
@@ -988,14 +1154,50 @@ bool AnalysisPredictor::ZeroCopyRun() {
 
   executor_->Run();
 
+#if defined(PADDLE_WITH_CUDA)
+  if (input_copy_stream_ != nullptr) {
+    // The standby buffer of this batch may only be overwritten once the
+    // kernels that read it have finished, so the copy stream waits on the
+    // compute stream; the host can start staging the next batch with
+    // CopyFromCpuAsync right away.
+    auto *dev_ctx = static_cast<const platform::CUDADeviceContext *>(
+        platform::DeviceContextPool::Instance().Get(place_));
+    cudaEventRecord(static_cast<cudaEvent_t>(compute_done_event_),
+                    dev_ctx->stream());
+    cudaStreamWaitEvent(static_cast<cudaStream_t>(input_copy_stream_),
+                        static_cast<cudaEvent_t>(compute_done_event_), 0);
+  }
+#endif
+
   if (config_.shape_range_info_collected()) {
     CollectShapeRangeInfo();
+    if (config_.trt_auto_shape_profile_enabled() && !shape_profile_serialized_ &&
+        ++shape_profile_run_count_ >= config_.trt_shape_profile_warmup_runs()) {
+      // Persist the profile as soon as the warmup window closes, so a
+      // restart picks it up even when this process never exits cleanly. The
+      // destructor refreshes the file with all collected samples.
+      StatisticShapeRangeInfo();
+      shape_profile_serialized_ = true;
+      LOG(INFO) << "The TensorRT shape profile has been written to "
+                << config_.shape_range_info_path()
+                << "; restart the predictor to build the tuned engine.";
+    }
+  } else if (config_.shape_range_monitoring_enabled()) {
+    UpdateShapeRangeStats();
+    if (++shape_stats_run_count_ % config_.shape_range_flush_interval_runs() ==
+        0) {
+      FlushShapeRangeStats();
+    }
   }
 
   // Fix TensorArray reuse not cleaned bug.
   tensor_array_batch_cleaner_.CollectTensorArrays(sub_scope_);
   tensor_array_batch_cleaner_.ResetTensorArray();
 
+  if (config_.dynamic_memory_optim_enabled()) {
+    ShrinkActivationBuffers();
+  }
+
   // recover the cpu_math_library_num_threads to 1, in order to avoid thread
   // conflict when integrating it into deployment service.
   paddle::platform::SetNumThreads(1);
@@ -1011,6 +1213,56 @@ bool AnalysisPredictor::ZeroCopyRun() {
   return true;
 }
 
+void AnalysisPredictor::ApplyCpuThreadAffinity() {
+  std::vector<int> core_ids = config_.cpu_thread_affinity_core_ids();
+  if (core_ids.empty() && config_.cpu_thread_affinity_numa_node() >= 0) {
+    core_ids =
+        platform::GetNumaNodeCores(config_.cpu_thread_affinity_numa_node());
+    if (core_ids.empty()) {
+      LOG(WARNING) << "NUMA node " << config_.cpu_thread_affinity_numa_node()
+                   << " exposes no cores, the compute threads stay unbound.";
+      return;
+    }
+  }
+  if (core_ids.empty()) return;
+  platform::SetThreadAffinity(core_ids);
+}
+
+void AnalysisPredictor::ResolveTensorRtShapeProfile() {
+  if (!config_.trt_auto_shape_profile_enabled() ||
+      !config_.tensorrt_engine_enabled()) {
+    return;
+  }
+  const std::string &path = config_.shape_range_info_path();
+  if (inference::analysis::PathExists(path)) {
+    LOG(INFO) << "The TensorRT shape profile is found at " << path
+              << ", the engine is built with the tuned dynamic shapes.";
+    config_.EnableTunedTensorRtDynamicShape(path, true);
+  } else {
+    LOG(INFO) << "No TensorRT shape profile at " << path
+              << " yet. The input shapes of the warmup runs are recorded "
+                 "there; restart the predictor afterwards to build the tuned "
+                 "engine.";
+    config_.CollectShapeRangeInfo(path);
+  }
+}
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+void AnalysisPredictor::BindExternalStream() {
+  if (!config_.external_stream_enabled() || !config_.use_gpu()) {
+    return;
+  }
+  auto &pool = paddle::platform::DeviceContextPool::Instance();
+  auto gpu_place = BOOST_GET_CONST(paddle::platform::CUDAPlace, place_);
+  auto *dev_ctx = static_cast<paddle::platform::CUDADeviceContext *>(
+      pool.Get(gpu_place));
+  // Rebinding is a no-op when this thread already runs on the stream, so
+  // calling it on every Run only costs a map lookup and a compare.
+  dev_ctx->SetThreadLocalStream(
+      reinterpret_cast<gpuStream_t>(config_.GetExecStream()));
+}
+#endif
+
 void AnalysisPredictor::CollectShapeRangeInfo() {
   // if use gpu, sync first.
   if (config_.use_gpu()) {
@@ -1041,6 +1293,73 @@ void AnalysisPredictor::CollectShapeRangeInfo() {
   }
 }
 
+void AnalysisPredictor::UpdateShapeRangeStats() {
+  // Cap on distinct values tracked per dimension; once it is hit only the
+  // min/max keep following new values and the opt shape is picked among the
+  // values seen so far.
+  constexpr size_t kShapeFreqCap = 64;
+  std::vector<std::string> var_names = sub_scope_->LocalVarNames();
+  for (const auto &name : var_names) {
+    auto *var = sub_scope_->GetVar(name);
+    if (!var->IsType<framework::LoDTensor>()) {
+      continue;
+    }
+    framework::DDim dim = var->Get<framework::LoDTensor>().dims();
+    auto &stats = shape_stats_[name];
+    if (stats.min_shape.empty()) {
+      stats.min_shape.resize(dim.size());
+      stats.max_shape.resize(dim.size());
+      stats.frequency.resize(dim.size());
+      for (int d = 0; d < dim.size(); ++d) {
+        stats.min_shape[d] = stats.max_shape[d] = dim[d];
+        stats.frequency[d][dim[d]] = 1;
+      }
+      continue;
+    }
+    if (static_cast<int>(stats.min_shape.size()) != dim.size()) {
+      // The rank changed between runs; keep the stats of the first observed
+      // rank, matching what the serialized profile can express.
+      continue;
+    }
+    for (int d = 0; d < dim.size(); ++d) {
+      int32_t value = dim[d];
+      if (value < stats.min_shape[d]) stats.min_shape[d] = value;
+      if (value > stats.max_shape[d]) stats.max_shape[d] = value;
+      auto &freq = stats.frequency[d];
+      auto it = freq.find(value);
+      if (it != freq.end()) {
+        ++it->second;
+      } else if (freq.size() < kShapeFreqCap) {
+        freq[value] = 1;
+      }
+    }
+  }
+}
+
+void AnalysisPredictor::FlushShapeRangeStats() {
+  std::map<std::string, std::vector<int32_t>> min_shapes;
+  std::map<std::string, std::vector<int32_t>> max_shapes;
+  std::map<std::string, std::vector<int32_t>> opt_shapes;
+  for (const auto &it : shape_stats_) {
+    const auto &stats = it.second;
+    std::vector<int32_t> opt_shape(stats.min_shape.size());
+    for (size_t d = 0; d < opt_shape.size(); ++d) {
+      int64_t best_count = 0;
+      for (const auto &value_count : stats.frequency[d]) {
+        if (value_count.second > best_count) {
+          best_count = value_count.second;
+          opt_shape[d] = value_count.first;
+        }
+      }
+    }
+    min_shapes[it.first] = stats.min_shape;
+    max_shapes[it.first] = stats.max_shape;
+    opt_shapes[it.first] = opt_shape;
+  }
+  inference::SerializeShapeRangeInfo(config_.shape_range_info_path(),
+                                     min_shapes, max_shapes, opt_shapes);
+}
+
 void AnalysisPredictor::StatisticShapeRangeInfo() {
   std::map<std::string, std::vector<int32_t>> min_shapes;
   std::map<std::string, std::vector<int32_t>> max_shapes;
@@ -1188,6 +1507,160 @@ bool AnalysisPredictor::LoadParameters() {
   return true;
 }
 
+std::string AnalysisPredictor::GetOptimizedProgramCachePath() {
+  if (!config_.optimized_program_cache_enabled()) {
+    return "";
+  }
+  if (config_.tensorrt_engine_enabled() || config_.lite_engine_enabled() ||
+      config_.dlnne_enabled() || config_.mkldnn_quantizer_enabled()) {
+    LOG(WARNING) << "The optimized program cache does not support subgraph "
+                    "engines or the MKLDNN quantizer, the cache is disabled.";
+    return "";
+  }
+
+  std::string root;
+  if (!config_.opt_cache_dir_.empty()) {
+    root = config_.opt_cache_dir_;
+    if (!inference::analysis::PathExists(root)) {
+      PADDLE_ENFORCE_NE(MKDIR(root.c_str()), -1,
+                        platform::errors::PreconditionNotMet(
+                            "Can not create optimize cache directory: %s, "
+                            "Make sure you have permission to write",
+                            root));
+    }
+    root += "/";
+  } else if (!config_.model_dir().empty()) {
+    root = inference::analysis::GetOrCreateModelOptCacheDir(
+        config_.model_dir());
+  } else if (!config_.model_from_memory() && !config_.prog_file().empty()) {
+    root = inference::analysis::GetOrCreateModelOptCacheDir(
+        inference::analysis::GetDirRoot(config_.prog_file()));
+  } else {
+    LOG(WARNING) << "The optimized program cache needs a directory to write "
+                    "to. Set one with AnalysisConfig::SetOptimCacheDir when "
+                    "the model is loaded from memory.";
+    return "";
+  }
+
+  // The key covers the model program, the config fields that influence the
+  // analysis and the pass list, so a change of any of them selects another
+  // cache entry and the stale one is simply never read again.
+  std::string key = inference_program_->Proto()->SerializeAsString();
+  key += config_.SerializeInfoCache();
+  for (const auto &pass : config_.pass_builder()->AllPasses()) {
+    key += pass;
+  }
+  return root + string::Sprintf(
+                    "opt_program_%016llx",
+                    static_cast<unsigned long long>(
+                        std::hash<std::string>()(key)));  // NOLINT
+}
+
+bool AnalysisPredictor::LoadOptimizedProgramCache(
+    const std::string &path_prefix) {
+  std::string program_path = path_prefix + ".model";
+  std::string params_path = path_prefix + ".params";
+  if (!inference::analysis::FileExists(program_path) ||
+      !inference::analysis::FileExists(params_path)) {
+    return false;
+  }
+
+  std::ifstream fin(program_path, std::ios::in | std::ios::binary);
+  std::string pb_content;
+  fin.seekg(0, std::ios::end);
+  pb_content.resize(fin.tellg());
+  fin.seekg(0, std::ios::beg);
+  if (pb_content.empty()) {
+    return false;
+  }
+  fin.read(&(pb_content.at(0)), pb_content.size());
+  fin.close();
+  framework::proto::ProgramDesc proto;
+  if (!proto.ParseFromString(pb_content)) {
+    LOG(WARNING) << "The cached optimized program " << program_path
+                 << " is corrupted and will be regenerated.";
+    return false;
+  }
+  inference_program_.reset(new framework::ProgramDesc(proto));
+
+  // The analysis passes may have introduced parameters that do not exist in
+  // the original model (e.g. folded weights), so the persistable variables
+  // of the optimized program are created before they are filled from the
+  // cached parameter file.
+  executor_->CreateVariables(*inference_program_, 0, true, sub_scope_);
+
+  std::unique_ptr<framework::ProgramDesc> load_program(
+      new framework::ProgramDesc());
+  framework::BlockDesc *load_block = load_program->MutableBlock(0);
+  std::vector<std::string> params;
+  for (auto *var : inference_program_->Block(0).AllVars()) {
+    if (IsPersistable(var)) {
+      framework::VarDesc *new_var = load_block->Var(var->Name());
+      new_var->SetShape(var->GetShape());
+      new_var->SetDataType(var->GetDataType());
+      new_var->SetType(var->GetType());
+      new_var->SetLoDLevel(var->GetLoDLevel());
+      new_var->SetPersistable(true);
+      params.push_back(new_var->Name());
+    }
+  }
+  // The save side stores the parameters sorted by name, the load order has
+  // to match it.
+  std::sort(params.begin(), params.end());
+  framework::OpDesc *op = load_block->AppendOp();
+  op->SetType("load_combine");
+  op->SetOutput("Out", params);
+  op->SetAttr("file_path", params_path);
+  op->CheckAttrs();
+
+  framework::NaiveExecutor e(place_);
+  e.Prepare(scope_.get(), *load_program, 0, false);
+  e.Run();
+  VLOG(3) << "get " << scope_->LocalVarNames().size()
+          << " vars after loading the optimized program cache";
+
+  return true;
+}
+
+void AnalysisPredictor::SaveOptimizedProgramCache(
+    const std::string &path_prefix) {
+  std::ofstream outfile(path_prefix + ".model",
+                        std::ios::out | std::ios::binary);
+  if (!outfile.is_open()) {
+    LOG(WARNING) << "Can not write the optimized program cache to "
+                 << path_prefix << ".model, the cache is skipped.";
+    return;
+  }
+  outfile << GetSerializedProgram();
+  outfile.close();
+
+  framework::ProgramDesc save_program;
+  auto *save_block = save_program.MutableBlock(0);
+  std::vector<std::string> save_var_list;
+  for (framework::VarDesc *var : inference_program_->Block(0).AllVars()) {
+    if (IsPersistable(var)) {
+      framework::VarDesc *new_var = save_block->Var(var->Name());
+      new_var->SetShape(var->GetShape());
+      new_var->SetDataType(var->GetDataType());
+      new_var->SetType(var->GetType());
+      new_var->SetLoDLevel(var->GetLoDLevel());
+      new_var->SetPersistable(true);
+      save_var_list.push_back(new_var->Name());
+    }
+  }
+  std::sort(save_var_list.begin(), save_var_list.end());
+  auto *op = save_block->AppendOp();
+  op->SetType("save_combine");
+  op->SetInput("X", save_var_list);
+  op->SetAttr("file_path", path_prefix + ".params");
+  op->CheckAttrs();
+
+  platform::CPUPlace place;
+  framework::Executor exe(place);
+  exe.Run(save_program, scope(), 0, true, true);
+  LOG(INFO) << "Saved the optimized program cache to " << path_prefix;
+}
+
 uint64_t AnalysisPredictor::TryShrinkMemory() {
   ClearIntermediateTensor();
   return paddle::memory::Release(place_);
@@ -1212,6 +1685,44 @@ void AnalysisPredictor::ClearIntermediateTensor() {
   }
 }
 
+void AnalysisPredictor::ShrinkActivationBuffers() {
+  const size_t window =
+      static_cast<size_t>(config_.dynamic_memory_optim_history_window());
+  const auto &global_block = inference_program_->MutableBlock(0);
+  for (auto *var : global_block->AllVars()) {
+    if (IsPersistable(var)) continue;
+    const std::string name = var->Name();
+    if (name == "feed" || name == "fetch") continue;
+    auto *variable = executor_->scope()->FindVar(name);
+    if (variable == nullptr || !variable->IsType<framework::LoDTensor>()) {
+      continue;
+    }
+    auto *t = variable->GetMutable<framework::LoDTensor>();
+    if (!t->IsInitialized()) continue;
+
+    size_t required = t->numel() * framework::SizeOfType(t->type());
+    auto &history = activation_size_history_[name];
+    history.push_back(required);
+    if (history.size() > window) {
+      history.pop_front();
+    }
+    size_t high_water_mark =
+        *std::max_element(history.begin(), history.end());
+
+    // The buffer was grown by an earlier, larger batch that the recent
+    // traffic no longer reaches. Releasing it hands the memory back to the
+    // pooled allocator, which keeps freed chunks bucketed by size, so the
+    // next batch of any recent size is serviced from the pool without a
+    // fresh device/host allocation.
+    if (t->memory_size() > high_water_mark) {
+      VLOG(3) << "Shrink activation buffer: " << name << " held "
+              << t->memory_size() << " bytes, high-water mark "
+              << high_water_mark;
+      t->clear();
+    }
+  }
+}
+
 #if PADDLE_WITH_TENSORRT
 bool AnalysisPredictor::SaveTrtCalibToDisk() {
   PADDLE_ENFORCE_EQ(config_.tensorrt_engine_enabled(), true,
@@ -1279,7 +1790,14 @@ AnalysisPredictor::~AnalysisPredictor() {
                               "./profile.log");
   }
   if (sub_scope_) {
-    scope_->DeleteScope(sub_scope_);
+    if (sub_scope_pool_) {
+      // Keep the scope warm for the next clone instead of destroying it. The
+      // tensors keep their allocations, so the activation buffers are already
+      // right-sized when the scope is checked out again.
+      sub_scope_pool_->Return(sub_scope_);
+    } else {
+      scope_->DeleteScope(sub_scope_);
+    }
   }
 
 #if PADDLE_WITH_MKLDNN
@@ -1291,14 +1809,34 @@ AnalysisPredictor::~AnalysisPredictor() {
 
   if (config_.shape_range_info_collected()) {
     StatisticShapeRangeInfo();
+  } else if (config_.shape_range_monitoring_enabled() &&
+             shape_stats_run_count_ > 0) {
+    FlushShapeRangeStats();
   }
 
+#if defined(PADDLE_WITH_CUDA)
+  if (input_copy_stream_ != nullptr) {
+    cudaStreamSynchronize(static_cast<cudaStream_t>(input_copy_stream_));
+    cudaStreamDestroy(static_cast<cudaStream_t>(input_copy_stream_));
+    cudaEventDestroy(static_cast<cudaEvent_t>(input_copy_done_event_));
+    cudaEventDestroy(static_cast<cudaEvent_t>(compute_done_event_));
+  }
+#endif
+
   memory::Release(place_);
 }
 
 std::unique_ptr<PaddlePredictor> AnalysisPredictor::Clone() {
   std::lock_guard<std::mutex> lk(clone_mutex_);
+  // The clone references this predictor's parameter scope and optimized
+  // ProgramDesc instead of loading and optimizing the model again. Only the
+  // feed/fetch structures and the sub scope holding the intermediate
+  // activations are private to the clone, so N predictors serving the same
+  // model cost one copy of the weights plus N activation footprints. The
+  // shared scope is treated as read-only after initialization; it stays
+  // alive until the last predictor referencing it is destroyed.
   auto *x = new AnalysisPredictor(config_);
+  x->sub_scope_pool_ = sub_scope_pool_;
   x->Init(scope_, inference_program_);
   return std::unique_ptr<PaddlePredictor>(x);
 }
@@ -1532,5 +2070,321 @@ Predictor *PredictorPool::Retrive(size_t idx) {
   }
   return preds_[idx - 1].get();
 }
+
+struct DynamicBatcher::Impl {
+  // One waiting caller. The request lives on the caller's stack; the worker
+  // only touches it between being queued and done being set.
+  struct Request {
+    const std::vector<paddle::PaddleTensor> *inputs;
+    std::vector<paddle::PaddleTensor> *outputs;
+    int rows;
+    bool done{false};
+    bool ok{false};
+  };
+
+  std::shared_ptr<Predictor> predictor;
+  int max_batch_size;
+  int batch_timeout_us;
+
+  std::mutex mutex;
+  std::condition_variable pending_cv;
+  std::condition_variable done_cv;
+  std::deque<Request *> pending;
+  bool stop{false};
+  std::thread worker;
+
+  int PendingRowsLocked() const {
+    int rows = 0;
+    for (auto *req : pending) {
+      rows += req->rows;
+    }
+    return rows;
+  }
+
+  // Concatenate the inputs of the gathered requests along the batch
+  // dimension, run the predictor once and hand every request its rows of
+  // the outputs. Throws on malformed requests.
+  void Execute(const std::vector<Request *> &batch) {
+    const auto &lead = *batch.front()->inputs;
+    int batch_rows = 0;
+    for (auto *req : batch) {
+      PADDLE_ENFORCE_EQ(
+          req->inputs->size(), lead.size(),
+          paddle::platform::errors::InvalidArgument(
+              "All requests to DynamicBatcher should provide the same "
+              "inputs, but one request has %d inputs and another %d.",
+              req->inputs->size(), lead.size()));
+      batch_rows += req->rows;
+    }
+
+    std::vector<char> buffer;
+    for (size_t i = 0; i < lead.size(); ++i) {
+      const auto &first = lead[i];
+      PADDLE_ENFORCE_EQ(first.lod.empty(), true,
+                        paddle::platform::errors::Unimplemented(
+                            "DynamicBatcher does not support LoD inputs."));
+      std::vector<int> shape = first.shape;
+      size_t total_bytes = 0;
+      for (auto *req : batch) {
+        const auto &t = (*req->inputs)[i];
+        PADDLE_ENFORCE_EQ(
+            t.name, first.name,
+            paddle::platform::errors::InvalidArgument(
+                "All requests to DynamicBatcher should provide the same "
+                "inputs in the same order, but input %d is named (%s) in "
+                "one request and (%s) in another.",
+                i, first.name, t.name));
+        PADDLE_ENFORCE_EQ(t.dtype == first.dtype, true,
+                          paddle::platform::errors::InvalidArgument(
+                              "The data type of input (%s) differs between "
+                              "batched requests.",
+                              t.name));
+        PADDLE_ENFORCE_EQ(
+            t.shape.size() == shape.size() &&
+                std::equal(t.shape.begin() + 1, t.shape.end(),
+                           shape.begin() + 1),
+            true,
+            paddle::platform::errors::InvalidArgument(
+                "The trailing dimensions of input (%s) differ between "
+                "batched requests. Variable-length inputs should be padded "
+                "before they are submitted to DynamicBatcher.",
+                t.name));
+        PADDLE_ENFORCE_EQ(t.shape[0], req->rows,
+                          paddle::platform::errors::InvalidArgument(
+                              "All inputs of one request should have the "
+                              "same batch dimension, but input (%s) has %d "
+                              "rows while the first input has %d.",
+                              t.name, t.shape[0], req->rows));
+        total_bytes += t.data.length();
+      }
+
+      buffer.resize(total_bytes);
+      size_t offset = 0;
+      for (auto *req : batch) {
+        const auto &t = (*req->inputs)[i];
+        std::memcpy(buffer.data() + offset, t.data.data(), t.data.length());
+        offset += t.data.length();
+      }
+
+      shape[0] = batch_rows;
+      auto handle = predictor->GetInputHandle(first.name);
+      handle->Reshape(shape);
+      FeedBuffer(handle.get(), first.dtype, buffer.data());
+    }
+
+    PADDLE_ENFORCE_EQ(predictor->Run(), true,
+                      paddle::platform::errors::External(
+                          "The predictor of DynamicBatcher failed to run."));
+
+    for (auto *req : batch) {
+      req->outputs->clear();
+    }
+    for (const auto &name : predictor->GetOutputNames()) {
+      auto handle = predictor->GetOutputHandle(name);
+      std::vector<int> shape = handle->shape();
+      auto dtype = handle->type();
+      PADDLE_ENFORCE_EQ(
+          !shape.empty() && shape[0] == batch_rows, true,
+          paddle::platform::errors::InvalidArgument(
+              "The batch dimension of output (%s) does not match the %d "
+              "batched input rows, so the output cannot be scattered back "
+              "to the callers.",
+              name, batch_rows));
+      size_t numel = 1;
+      for (int d : shape) {
+        numel *= d;
+      }
+      size_t row_bytes = numel / batch_rows * paddle::PaddleDtypeSize(dtype);
+      buffer.resize(numel * paddle::PaddleDtypeSize(dtype));
+      FetchBuffer(handle.get(), dtype, buffer.data());
+
+      size_t offset = 0;
+      for (auto *req : batch) {
+        paddle::PaddleTensor out;
+        out.name = name;
+        out.shape = shape;
+        out.shape[0] = req->rows;
+        out.dtype = dtype;
+        out.data.Resize(req->rows * row_bytes);
+        std::memcpy(out.data.data(), buffer.data() + offset,
+                    req->rows * row_bytes);
+        offset += req->rows * row_bytes;
+        req->outputs->push_back(std::move(out));
+      }
+    }
+  }
+
+  static void FeedBuffer(Tensor *handle, paddle::PaddleDType dtype,
+                         const void *data) {
+    switch (dtype) {
+      case paddle::PaddleDType::FLOAT32:
+        handle->CopyFromCpu(static_cast<const float *>(data));
+        break;
+      case paddle::PaddleDType::INT64:
+        handle->CopyFromCpu(static_cast<const int64_t *>(data));
+        break;
+      case paddle::PaddleDType::INT32:
+        handle->CopyFromCpu(static_cast<const int32_t *>(data));
+        break;
+      case paddle::PaddleDType::UINT8:
+        handle->CopyFromCpu(static_cast<const uint8_t *>(data));
+        break;
+      default:
+        PADDLE_THROW(paddle::platform::errors::Unimplemented(
+            "DynamicBatcher supports FLOAT32, INT64, INT32 and UINT8 "
+            "inputs now."));
+    }
+  }
+
+  static void FetchBuffer(Tensor *handle, paddle::PaddleDType dtype,
+                          void *data) {
+    switch (dtype) {
+      case paddle::PaddleDType::FLOAT32:
+        handle->CopyToCpu(static_cast<float *>(data));
+        break;
+      case paddle::PaddleDType::INT64:
+        handle->CopyToCpu(static_cast<int64_t *>(data));
+        break;
+      case paddle::PaddleDType::INT32:
+        handle->CopyToCpu(static_cast<int32_t *>(data));
+        break;
+      case paddle::PaddleDType::UINT8:
+        handle->CopyToCpu(static_cast<uint8_t *>(data));
+        break;
+      default:
+        PADDLE_THROW(paddle::platform::errors::Unimplemented(
+            "DynamicBatcher supports FLOAT32, INT64, INT32 and UINT8 "
+            "outputs now."));
+    }
+  }
+
+  void Loop() {
+    for (;;) {
+      std::vector<Request *> batch;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        pending_cv.wait(lock, [this] { return stop || !pending.empty(); });
+        if (stop) {
+          break;
+        }
+        // Give later requests a chance to join the batch, but never hold the
+        // first one past its latency budget.
+        auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::microseconds(batch_timeout_us);
+        while (!stop && PendingRowsLocked() < max_batch_size &&
+               pending_cv.wait_until(lock, deadline) !=
+                   std::cv_status::timeout) {
+        }
+        if (stop) {
+          break;
+        }
+        int rows = 0;
+        while (!pending.empty()) {
+          Request *req = pending.front();
+          if (!batch.empty() && rows + req->rows > max_batch_size) {
+            break;
+          }
+          rows += req->rows;
+          batch.push_back(req);
+          pending.pop_front();
+        }
+      }
+
+      bool ok = true;
+      try {
+        Execute(batch);
+      } catch (const std::exception &e) {
+        LOG(ERROR) << "DynamicBatcher failed to run a batch: " << e.what();
+        ok = false;
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto *req : batch) {
+          req->ok = ok;
+          req->done = true;
+        }
+      }
+      done_cv.notify_all();
+    }
+
+    // Fail whatever is still queued so no caller blocks forever.
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (auto *req : pending) {
+        req->ok = false;
+        req->done = true;
+      }
+      pending.clear();
+    }
+    done_cv.notify_all();
+  }
+};
+
+DynamicBatcher::DynamicBatcher(const Config &config)
+    : DynamicBatcher(CreatePredictor(config),
+                     config.dynamic_batching_max_batch_size(),
+                     config.dynamic_batching_timeout_us()) {}
+
+DynamicBatcher::DynamicBatcher(std::shared_ptr<Predictor> predictor,
+                               int max_batch_size, int batch_timeout_us)
+    : impl_(new Impl) {
+  PADDLE_ENFORCE_NOT_NULL(predictor,
+                          paddle::platform::errors::InvalidArgument(
+                              "The predictor of DynamicBatcher should not be "
+                              "null."));
+  PADDLE_ENFORCE_GT(max_batch_size, 0,
+                    paddle::platform::errors::InvalidArgument(
+                        "The max batch size of DynamicBatcher should be "
+                        "positive, but received %d.",
+                        max_batch_size));
+  PADDLE_ENFORCE_GE(batch_timeout_us, 0,
+                    paddle::platform::errors::InvalidArgument(
+                        "The timeout of DynamicBatcher should not be "
+                        "negative, but received %d.",
+                        batch_timeout_us));
+  impl_->predictor = std::move(predictor);
+  impl_->max_batch_size = max_batch_size;
+  impl_->batch_timeout_us = batch_timeout_us;
+  impl_->worker = std::thread(&Impl::Loop, impl_.get());
+}
+
+DynamicBatcher::~DynamicBatcher() {
+  {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    impl_->stop = true;
+  }
+  impl_->pending_cv.notify_all();
+  impl_->worker.join();
+}
+
+bool DynamicBatcher::Run(const std::vector<paddle::PaddleTensor> &inputs,
+                         std::vector<paddle::PaddleTensor> *outputs) {
+  PADDLE_ENFORCE_NOT_NULL(outputs,
+                          paddle::platform::errors::InvalidArgument(
+                              "The outputs of DynamicBatcher::Run should not "
+                              "be null."));
+  PADDLE_ENFORCE_EQ(inputs.empty(), false,
+                    paddle::platform::errors::InvalidArgument(
+                        "The inputs of DynamicBatcher::Run should not be "
+                        "empty."));
+  PADDLE_ENFORCE_EQ(inputs[0].shape.empty(), false,
+                    paddle::platform::errors::InvalidArgument(
+                        "The inputs of DynamicBatcher::Run should carry a "
+                        "batch dimension."));
+
+  Impl::Request req;
+  req.inputs = &inputs;
+  req.outputs = outputs;
+  req.rows = inputs[0].shape[0];
+
+  std::unique_lock<std::mutex> lock(impl_->mutex);
+  PADDLE_ENFORCE_EQ(impl_->stop, false,
+                    paddle::platform::errors::PreconditionNotMet(
+                        "The DynamicBatcher has been shut down."));
+  impl_->pending.push_back(&req);
+  impl_->pending_cv.notify_one();
+  impl_->done_cv.wait(lock, [&req] { return req.done; });
+  return req.ok;
+}
 }  // namespace services
 }  // namespace paddle_infer
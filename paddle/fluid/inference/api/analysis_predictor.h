@@ -14,9 +14,13 @@
 
 #pragma once
 #include <algorithm>
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "paddle/fluid/framework/naive_executor.h"
 #include "paddle/fluid/framework/op_compatible_info.h"
@@ -53,6 +57,34 @@ using inference::analysis::Analyzer;
 using framework::proto::ProgramDesc;
 using framework::NaiveExecutor;
 
+///
+/// \class SubScopePool
+///
+/// \brief Pool of retired activation scopes, shared by all predictors cloned
+/// from the same root. A destroyed predictor returns its sub scope -- with
+/// the variables and the right-sized activation buffers of previous runs
+/// intact -- instead of deleting it, and the next clone checks the scope out
+/// instead of building a fresh one. Services that create a short-lived clone
+/// per request thereby skip the per-request variable creation and the
+/// allocation warmup. The pooled scopes stay children of the shared root
+/// scope and are released together with it.
+///
+class SubScopePool {
+ public:
+  /// \brief Take a warm scope out of the pool.
+  /// \return A pooled scope, or nullptr if the pool is empty.
+  framework::Scope *CheckOut();
+
+  /// \brief Put a retired sub scope back into the pool. The pool does not
+  /// own the scope; its parent scope does.
+  /// \param[in] scope The retired activation scope.
+  void Return(framework::Scope *scope);
+
+ private:
+  std::mutex mutex_;
+  std::vector<framework::Scope *> scopes_;
+};
+
 ///
 /// \class AnalysisPredictor
 ///
@@ -165,6 +197,31 @@ class AnalysisPredictor : public PaddlePredictor {
   ///
   std::map<std::string, std::vector<int64_t>> GetInputTensorShape() override;
 
+  ///
+  /// \brief Get the standby buffer of an input tensor for asynchronous
+  /// binding. While one batch is executing, the next batch can already be
+  /// staged into the standby buffer with Tensor::CopyFromCpuAsync() on
+  /// GetInputCopyStream(), so the H2D transfer overlaps the compute. The
+  /// next ZeroCopyRun() swaps the standby buffer in after an event
+  /// handshake with the copy stream; the buffer that is swapped out becomes
+  /// the new standby buffer, so the two buffer sets alternate between runs.
+  ///
+  /// \param[in] name input name
+  /// \return standby input tensor
+  ///
+  std::unique_ptr<ZeroCopyTensor> GetStandbyInputTensor(
+      const std::string &name);
+
+  ///
+  /// \brief Get the dedicated H2D copy stream used for asynchronous input
+  /// binding. The stream and its handshake events are created lazily on the
+  /// first call.
+  ///
+  /// \return the copy stream (cudaStream_t), or nullptr when the predictor
+  /// does not run on a CUDA place
+  ///
+  void *GetInputCopyStream();
+
   ///
   /// \brief Run the prediction engine
   ///
@@ -221,6 +278,11 @@ class AnalysisPredictor : public PaddlePredictor {
   ///
   /// \brief Clone to get the new predictor. thread safe.
   ///
+  /// The weights and the optimized program are shared with this predictor,
+  /// only the feed/fetch structures and the intermediate activations are
+  /// duplicated, so cloning is the cheap way to serve one model from many
+  /// threads.
+  ///
   /// \return get a new predictor
   ///
   std::unique_ptr<PaddlePredictor> Clone() override;
@@ -300,6 +362,32 @@ class AnalysisPredictor : public PaddlePredictor {
   ///
   bool LoadParameters();
 
+  ///
+  /// \brief Get the path prefix of the optimized program cache entry for the
+  /// loaded model and the current config. The key hashes the model program,
+  /// the config and the pass list, so any change of them invalidates the
+  /// cache.
+  ///
+  /// \return The path prefix, or an empty string when the cache is disabled
+  /// or cannot be used with the current config
+  ///
+  std::string GetOptimizedProgramCachePath();
+  ///
+  /// \brief Load the post-analysis program and its transformed parameters
+  /// from the optimized program cache, replacing the analysis pipeline.
+  ///
+  /// \param[in] path_prefix the cache entry path prefix
+  /// \return Whether the cache entry was present and loaded successfully
+  ///
+  bool LoadOptimizedProgramCache(const std::string &path_prefix);
+  ///
+  /// \brief Serialize the post-analysis program and its transformed
+  /// parameters to the optimized program cache.
+  ///
+  /// \param[in] path_prefix the cache entry path prefix
+  ///
+  void SaveOptimizedProgramCache(const std::string &path_prefix);
+
   ///
   /// \brief Prepare input data, only used in Run()
   ///
@@ -385,6 +473,56 @@ class AnalysisPredictor : public PaddlePredictor {
   void StatisticShapeRangeInfo();
   void CollectShapeRangeInfo();
 
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  ///
+  /// \brief Bind the external stream from the config to the calling
+  /// thread's device context, so this Run is issued on the caller's
+  /// stream. No-op when no external stream is configured or the thread is
+  /// already bound.
+  ///
+  void BindExternalStream();
+#endif
+
+  ///
+  /// \brief Update the bounded per-tensor shape statistics of the
+  /// monitoring mode with the shapes of the current run. O(dims) integer
+  /// updates per tensor, no per-run allocation once the maps are warm.
+  ///
+  void UpdateShapeRangeStats();
+
+  ///
+  /// \brief Rewrite shape_range_info_path_ with the min/max/opt profile
+  /// derived from the monitoring statistics.
+  ///
+  void FlushShapeRangeStats();
+
+  ///
+  /// \brief Decide how the automatic TensorRT shape profile is applied:
+  /// switch to tuned dynamic shapes when the recorded profile exists,
+  /// otherwise record the input shapes of the warmup runs.
+  ///
+  void ResolveTensorRtShapeProfile();
+
+  ///
+  /// \brief Pin the compute threads to the core list or NUMA node the
+  /// config asks for, so co-located instances run on isolated core sets.
+  ///
+  void ApplyCpuThreadAffinity();
+
+  ///
+  /// \brief Release activation buffers that have grown beyond the high-water
+  /// mark of the recent runs back to the memory pool. Called after every run
+  /// when AnalysisConfig::EnableDynamicMemoryOptim is set.
+  ///
+  void ShrinkActivationBuffers();
+
+  ///
+  /// \brief Swap the staged standby input buffers in before a run. Performs
+  /// the event handshake that orders the compute stream after the
+  /// asynchronous copies issued on GetInputCopyStream().
+  ///
+  void SwapStandbyInputs();
+
  private:
   AnalysisConfig config_;
   Argument argument_;
@@ -392,6 +530,9 @@ class AnalysisPredictor : public PaddlePredictor {
   platform::Place place_;
   std::shared_ptr<framework::Scope> scope_;
   framework::Scope *sub_scope_{nullptr};
+  // Shared with every predictor cloned from the same root, retired sub
+  // scopes are recycled through it instead of being destroyed.
+  std::shared_ptr<SubScopePool> sub_scope_pool_;
   std::shared_ptr<framework::ProgramDesc> inference_program_;
   framework::OpCompatibleMap op_compatible_map_;
   std::vector<framework::OpDesc *> feeds_;
@@ -418,9 +559,25 @@ class AnalysisPredictor : public PaddlePredictor {
   // A mutex help to make Clone thread safe.
   std::mutex clone_mutex_;
 
+  // For asynchronous input binding. The stream and events are opaque
+  // (cudaStream_t / cudaEvent_t) so that CUDA headers are not pulled into
+  // this header; they stay nullptr unless GetInputCopyStream is called on a
+  // CUDA place.
+  void *input_copy_stream_{nullptr};
+  void *input_copy_done_event_{nullptr};
+  void *compute_done_event_{nullptr};
+  // Inputs that have a standby buffer, filled by GetStandbyInputTensor.
+  std::set<std::string> standby_input_names_;
+
   // For memory optimization.
+  // The bytes each activation needed in the most recent runs, bounded by the
+  // history window of the runtime activation-buffer planner.
+  std::unordered_map<std::string, std::deque<size_t>> activation_size_history_;
   const size_t max_shape_collect_count_{1000};
   int need_collect_var_shapes_{-1};  // -1 for default, 0 for false, 1 for true.
+  // Bookkeeping of the automatic TensorRT shape profile warmup window.
+  int shape_profile_run_count_{0};
+  bool shape_profile_serialized_{false};
   std::vector<std::map<std::string, std::vector<int>>> batch_var_shapes_;
   int predictor_id_;
 
@@ -429,6 +586,18 @@ class AnalysisPredictor : public PaddlePredictor {
   bool status_is_cloned_{false};
 
   std::map<std::string, std::vector<std::vector<int32_t>>> shape_info_;
+
+  // Bounded per-tensor shape statistics of the monitoring mode: per-dim
+  // min/max plus a capped value histogram used to pick the opt shape.
+  // Memory stays O(tensors * dims * histogram cap) however many runs are
+  // observed, unlike shape_info_ which grows with every run.
+  struct ShapeRangeStats {
+    std::vector<int32_t> min_shape;
+    std::vector<int32_t> max_shape;
+    std::vector<std::map<int32_t, int64_t>> frequency;
+  };
+  std::map<std::string, ShapeRangeStats> shape_stats_;
+  int64_t shape_stats_run_count_{0};
 };
 
 }  // namespace paddle
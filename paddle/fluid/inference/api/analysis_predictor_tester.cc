@@ -119,6 +119,42 @@ TEST(AnalysisPredictor, analysis_on) {
   inference::CompareTensor(outputs.front(), naive_outputs.front());
 }
 
+TEST(AnalysisPredictor, optimized_program_cache) {
+  auto make_config = [] {
+    AnalysisConfig config;
+    config.SetModel(FLAGS_dirname);
+    config.SwitchIrOptim(true);
+    config.DisableGpu();
+    config.EnableOptimizedProgramCache();
+    return config;
+  };
+
+  // 1. Dummy Input Data
+  int64_t data[4] = {1, 2, 3, 4};
+  PaddleTensor tensor;
+  tensor.shape = std::vector<int>({4, 1});
+  tensor.data.Reset(data, sizeof(data));
+  tensor.dtype = PaddleDType::INT64;
+  std::vector<PaddleTensor> inputs(4, tensor);
+
+  // 2. The first predictor runs the analysis passes and fills the cache.
+  std::vector<PaddleTensor> outputs;
+  {
+    auto predictor = CreatePaddlePredictor<AnalysisConfig>(make_config());
+    ASSERT_TRUE(predictor->Run(inputs, &outputs));
+  }
+
+  // 3. The second predictor loads the optimized program from the cache and
+  // must produce the same result.
+  std::vector<PaddleTensor> cached_outputs;
+  {
+    auto predictor = CreatePaddlePredictor<AnalysisConfig>(make_config());
+    ASSERT_TRUE(predictor->Run(inputs, &cached_outputs));
+  }
+  ASSERT_EQ(outputs.size(), cached_outputs.size());
+  inference::CompareTensor(outputs.front(), cached_outputs.front());
+}
+
 TEST(AnalysisPredictor, ZeroCopy) {
   AnalysisConfig config;
   config.SetModel(FLAGS_dirname);
@@ -159,6 +195,54 @@ TEST(AnalysisPredictor, ZeroCopy) {
   predictor->TryShrinkMemory();
 }
 
+#if defined(PADDLE_WITH_CUDA)
+TEST(AnalysisPredictor, async_input_binding) {
+  AnalysisConfig config;
+  config.SetModel(FLAGS_dirname);
+  config.SwitchUseFeedFetchOps(false);
+  config.EnableUseGpu(100, 0);
+  auto predictor = CreatePaddlePredictor<AnalysisConfig>(config);
+  auto* analysis_predictor = static_cast<AnalysisPredictor*>(predictor.get());
+
+  std::vector<std::string> names{"firstw", "secondw", "thirdw", "forthw"};
+  std::vector<int64_t> data{0, 1, 2, 3};
+
+  // Reference run with synchronous input binding.
+  for (auto& name : names) {
+    auto w = predictor->GetInputTensor(name);
+    w->Reshape({4, 1});
+    w->CopyFromCpu(data.data());
+  }
+  ASSERT_TRUE(predictor->ZeroCopyRun());
+  auto out = predictor->GetOutputTensor("fc_1.tmp_2");
+  int out_num = 1;
+  for (int d : out->shape()) out_num *= d;
+  std::vector<float> ref_data(out_num);
+  out->CopyToCpu(ref_data.data());
+
+  // Stage the same batch into the standby buffers on the copy stream; the
+  // event handshake in ZeroCopyRun must make it visible to the next run.
+  void* copy_stream = analysis_predictor->GetInputCopyStream();
+  ASSERT_NE(copy_stream, nullptr);
+  for (auto& name : names) {
+    auto w = analysis_predictor->GetStandbyInputTensor(name);
+    w->Reshape({4, 1});
+    w->CopyFromCpuAsync(data.data(), copy_stream);
+  }
+  ASSERT_TRUE(predictor->ZeroCopyRun());
+
+  out = predictor->GetOutputTensor("fc_1.tmp_2");
+  out_num = 1;
+  for (int d : out->shape()) out_num *= d;
+  std::vector<float> async_data(out_num);
+  out->CopyToCpu(async_data.data());
+  ASSERT_EQ(async_data.size(), ref_data.size());
+  for (size_t i = 0; i < ref_data.size(); ++i) {
+    EXPECT_NEAR(ref_data[i], async_data[i], 1e-5);
+  }
+}
+#endif
+
 TEST(AnalysisPredictor, CollectShapeRangeInfo) {
   AnalysisConfig config;
   config.SetModel(FLAGS_dirname);
@@ -207,6 +291,52 @@ TEST(AnalysisPredictor, CollectShapeRangeInfo) {
   // ASSERT_EQ(min_shape.size(), 14u);
 }
 
+TEST(AnalysisPredictor, ShapeRangeMonitoring) {
+  AnalysisConfig config;
+  config.SetModel(FLAGS_dirname);
+  config.SwitchUseFeedFetchOps(false);
+  std::string shape_range_path = FLAGS_dirname + "/shape_range_monitor.pbtxt";
+  config.EnableShapeRangeMonitoring(shape_range_path, /*flush_interval_runs=*/2);
+  ASSERT_TRUE(config.shape_range_monitoring_enabled());
+  LOG(INFO) << config.Summary();
+  auto predictor = CreatePaddlePredictor<AnalysisConfig>(config);
+
+  // Run with two different batch sizes so the recorded range is non-trivial.
+  for (int batch : {4, 2, 4, 4}) {
+    auto w0 = predictor->GetInputTensor("firstw");
+    auto w1 = predictor->GetInputTensor("secondw");
+    auto w2 = predictor->GetInputTensor("thirdw");
+    auto w3 = predictor->GetInputTensor("forthw");
+    w0->Reshape({batch, 1});
+    w1->Reshape({batch, 1});
+    w2->Reshape({batch, 1});
+    w3->Reshape({batch, 1});
+    auto* w0_data = w0->mutable_data<int64_t>(PaddlePlace::kCPU);
+    auto* w1_data = w1->mutable_data<int64_t>(PaddlePlace::kCPU);
+    auto* w2_data = w2->mutable_data<int64_t>(PaddlePlace::kCPU);
+    auto* w3_data = w3->mutable_data<int64_t>(PaddlePlace::kCPU);
+    for (int i = 0; i < batch; i++) {
+      w0_data[i] = i;
+      w1_data[i] = i;
+      w2_data[i] = i;
+      w3_data[i] = i;
+    }
+    ASSERT_TRUE(predictor->ZeroCopyRun());
+  }
+
+  // Four runs with flush interval 2 must have flushed the profile.
+  std::map<std::string, std::vector<int32_t>> min_shape;
+  std::map<std::string, std::vector<int32_t>> max_shape;
+  std::map<std::string, std::vector<int32_t>> opt_shape;
+  inference::DeserializeShapeRangeInfo(shape_range_path, &min_shape, &max_shape,
+                                       &opt_shape);
+  ASSERT_GT(min_shape.size(), 0u);
+  ASSERT_NE(min_shape.find("firstw"), min_shape.end());
+  EXPECT_EQ(min_shape["firstw"][0], 2);
+  EXPECT_EQ(max_shape["firstw"][0], 4);
+  EXPECT_EQ(opt_shape["firstw"][0], 4);
+}
+
 TEST(AnalysisPredictor, Clone) {
   AnalysisConfig config;
   config.SetModel(FLAGS_dirname);
@@ -405,4 +535,45 @@ TEST(Predictor, Run) {
   predictor->TryShrinkMemory();
 }
 
+TEST(DynamicBatcher, Run) {
+  Config config;
+  config.SetModel(FLAGS_dirname);
+  config.EnableDynamicBatching(/*max_batch_size=*/8, /*batch_timeout_us=*/500);
+
+  services::DynamicBatcher batcher(config);
+
+  auto make_request = [] {
+    std::vector<paddle::PaddleTensor> inputs(4);
+    const std::vector<std::string> names = {"firstw", "secondw", "thirdw",
+                                            "forthw"};
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      inputs[i].name = names[i];
+      inputs[i].shape = {4, 1};
+      inputs[i].dtype = paddle::PaddleDType::INT64;
+      inputs[i].data.Resize(4 * sizeof(int64_t));
+      auto* data = static_cast<int64_t*>(inputs[i].data.data());
+      for (int j = 0; j < 4; ++j) {
+        data[j] = j;
+      }
+    }
+    return inputs;
+  };
+
+  // Submit concurrent requests so the batcher can coalesce them.
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 2; ++t) {
+    threads.emplace_back([&] {
+      auto inputs = make_request();
+      std::vector<paddle::PaddleTensor> outputs;
+      ASSERT_TRUE(batcher.Run(inputs, &outputs));
+      ASSERT_FALSE(outputs.empty());
+      // Every caller gets back only its own rows.
+      EXPECT_EQ(outputs.front().shape[0], 4);
+    });
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+}
+
 }  // namespace paddle_infer
@@ -142,7 +142,7 @@ DataType Tensor::type() const {
 PlaceType Tensor::place() const { return place_; }
 
 template <typename T>
-void Tensor::CopyFromCpu(const T *data) {
+void Tensor::CopyFromCpuImpl(const T *data, void *exec_stream) {
   EAGER_GET_TENSOR(paddle::framework::LoDTensor);
   PADDLE_ENFORCE_GE(tensor->numel(), 0,
                     paddle::platform::errors::PreconditionNotMet(
@@ -163,9 +163,25 @@ void Tensor::CopyFromCpu(const T *data) {
     auto *dev_ctx = static_cast<const paddle::platform::CUDADeviceContext *>(
         pool.Get(gpu_place));
 
-    paddle::memory::Copy(gpu_place, static_cast<void *>(t_data),
-                         paddle::platform::CPUPlace(), data, ele_size,
-                         dev_ctx->stream());
+    if (nullptr != exec_stream) {
+      // Asynchronous binding: the copy is enqueued on the caller's stream
+      // and is not ordered against the compute stream here. The caller must
+      // synchronize the two streams before the tensor is read, e.g. via the
+      // event handshake in AnalysisPredictor::ZeroCopyRun.
+#ifdef PADDLE_WITH_HIP
+      paddle::memory::Copy(gpu_place, static_cast<void *>(t_data),
+                           paddle::platform::CPUPlace(), data, ele_size,
+                           static_cast<hipStream_t>(exec_stream));
+#else
+      paddle::memory::Copy(gpu_place, static_cast<void *>(t_data),
+                           paddle::platform::CPUPlace(), data, ele_size,
+                           static_cast<cudaStream_t>(exec_stream));
+#endif
+    } else {
+      paddle::memory::Copy(gpu_place, static_cast<void *>(t_data),
+                           paddle::platform::CPUPlace(), data, ele_size,
+                           dev_ctx->stream());
+    }
 #else
     PADDLE_THROW(paddle::platform::errors::Unavailable(
         "Can not create tensor with CUDA place because paddle is not compiled "
@@ -204,6 +220,20 @@ void Tensor::CopyFromCpu(const T *data) {
   }
 }
 
+template <typename T>
+void Tensor::CopyFromCpu(const T *data) {
+  CopyFromCpuImpl<T>(data, nullptr);
+}
+
+template <typename T>
+void Tensor::CopyFromCpuAsync(const T *data, void *exec_stream) {
+  PADDLE_ENFORCE_NOT_NULL(
+      exec_stream, paddle::platform::errors::PreconditionNotMet(
+                       "The exec_stream of CopyFromCpuAsync can not be "
+                       "nullptr, use CopyFromCpu instead."));
+  CopyFromCpuImpl<T>(data, exec_stream);
+}
+
 void Tensor::CopyStringsFromCpu(const paddle_infer::Strings *data) {
   EAGER_GET_TENSOR(paddle_infer::Strings);
   PADDLE_ENFORCE_GE(tensor->size(), 0,
@@ -324,6 +354,32 @@ template PD_INFER_DECL void Tensor::CopyFromCpu<uint8_t>(const uint8_t *data);
 template PD_INFER_DECL void Tensor::CopyFromCpu<int8_t>(const int8_t *data);
 template PD_INFER_DECL void Tensor::CopyFromCpu<float16>(const float16 *data);
 
+template PD_INFER_DECL void Tensor::CopyFromCpuAsync<float>(const float *data,
+                                                            void *exec_stream);
+template PD_INFER_DECL void Tensor::CopyFromCpuAsync<int64_t>(
+    const int64_t *data, void *exec_stream);
+template PD_INFER_DECL void Tensor::CopyFromCpuAsync<int32_t>(
+    const int32_t *data, void *exec_stream);
+template PD_INFER_DECL void Tensor::CopyFromCpuAsync<uint8_t>(
+    const uint8_t *data, void *exec_stream);
+template PD_INFER_DECL void Tensor::CopyFromCpuAsync<int8_t>(
+    const int8_t *data, void *exec_stream);
+template PD_INFER_DECL void Tensor::CopyFromCpuAsync<float16>(
+    const float16 *data, void *exec_stream);
+
+template PD_INFER_DECL void Tensor::CopyFromCpuImpl<float>(const float *data,
+                                                           void *exec_stream);
+template PD_INFER_DECL void Tensor::CopyFromCpuImpl<int64_t>(
+    const int64_t *data, void *exec_stream);
+template PD_INFER_DECL void Tensor::CopyFromCpuImpl<int32_t>(
+    const int32_t *data, void *exec_stream);
+template PD_INFER_DECL void Tensor::CopyFromCpuImpl<uint8_t>(
+    const uint8_t *data, void *exec_stream);
+template PD_INFER_DECL void Tensor::CopyFromCpuImpl<int8_t>(
+    const int8_t *data, void *exec_stream);
+template PD_INFER_DECL void Tensor::CopyFromCpuImpl<float16>(
+    const float16 *data, void *exec_stream);
+
 template PD_INFER_DECL void Tensor::CopyToCpu<float>(float *data) const;
 template PD_INFER_DECL void Tensor::CopyToCpu<int64_t>(int64_t *data) const;
 template PD_INFER_DECL void Tensor::CopyToCpu<int32_t>(int32_t *data) const;
@@ -14,11 +14,16 @@
 
 #include "paddle/fluid/inference/api/mkldnn_quantizer.h"
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <map>
 #include <numeric>
+#include <random>
+#include <thread>  // NOLINT
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 #include "paddle/fluid/framework/eigen.h"
 #include "paddle/fluid/framework/ir/fuse_pass_base.h"
 #include "paddle/fluid/framework/ir/graph.h"
@@ -27,10 +32,19 @@
 #include "paddle/fluid/framework/type_defs.h"
 #include "paddle/fluid/inference/analysis/analyzer.h"
 #include "paddle/fluid/inference/api/analysis_predictor.h"
+#include "paddle/fluid/platform/flags.h"
 #include "paddle/fluid/platform/mkldnn_helper.h"
 #include "paddle/fluid/platform/place.h"
 #include "paddle/fluid/string/pretty_log.h"
 
+PADDLE_DEFINE_EXPORTED_int64(
+    mkldnn_quantizer_max_samples, 0,
+    "Bound the number of elements per tensor considered by the INT8 "
+    "calibration algorithms that are insensitive to element order (MAX, "
+    "KL); larger tensors are reservoir-sampled down to this many elements. "
+    "Per-channel algorithms always see the full tensor. Not positive means "
+    "no sampling.");
+
 namespace paddle {
 
 using platform::CPUPlace;
@@ -61,6 +75,31 @@ static void check_tensor(const LoDTensor& tensor) {
                                                  "Tensor dimension is empty."));
 }
 
+// Reservoir-sample (algorithm R) a large tensor down to max_samples elements.
+// The seed is fixed so calibration stays reproducible between runs.
+static LoDTensor SampleTensor(const LoDTensor& var_tensor,
+                              int64_t max_samples) {
+  LoDTensor sample;
+  sample.Resize({max_samples});
+  auto* sample_data = sample.mutable_data<float>(CPUPlace());
+  const auto* data = var_tensor.data<float>();
+  std::copy(data, data + max_samples, sample_data);
+  std::minstd_rand rng(42);
+  for (int64_t i = max_samples; i < var_tensor.numel(); ++i) {
+    std::uniform_int_distribution<int64_t> dist(0, i);
+    const int64_t j = dist(rng);
+    if (j < max_samples) sample_data[j] = data[i];
+  }
+  return sample;
+}
+
+static bool ShouldSample(ScaleAlgo rule, const LoDTensor& var_tensor) {
+  return FLAGS_mkldnn_quantizer_max_samples > 0 &&
+         (rule == ScaleAlgo::MAX || rule == ScaleAlgo::KL) &&
+         var_tensor.type() == framework::proto::VarType::FP32 &&
+         var_tensor.numel() > FLAGS_mkldnn_quantizer_max_samples;
+}
+
 void AnalysisPredictor::MkldnnQuantizer::CalculateScalesForRNNWeights(
     const paddle::framework::OpDesc* op, bool gru) {
   const auto& wx_names = op->Input("WeightX");
@@ -161,9 +200,98 @@ void AnalysisPredictor::MkldnnQuantizer::CalculateScalesForOpOutputs(
   }
 }
 
+void AnalysisPredictor::MkldnnQuantizer::PrecomputeIndependentScales() {
+  struct ScaleTask {
+    std::string var_name;
+    ScaleAlgo rule;
+    const LoDTensor* tensor;
+    bool is_unsigned;
+    std::pair<bool, LoDTensor> result;
+  };
+
+  // Gather, in the same order as the serial walk, every scale whose
+  // algorithm only looks at the tensor data. Scales that are derived from
+  // other scales (transpose2/reshape2/pool2d/concat outputs) and the RNN
+  // weights (which pair two tensors) are left to the serial walk.
+  std::vector<ScaleTask> tasks;
+  std::unordered_set<std::string> seen;
+  auto gather = [&](const std::string& op_type, const std::string& conn_name,
+                    const std::string& var_name, bool is_unsigned) {
+    if (seen.count(var_name) != 0) return;
+    auto rule = qconfig_->scale_algo(op_type, conn_name);
+    if (rule == ScaleAlgo::NONE) return;
+    auto* var = predictor_.sub_scope_->FindVar(var_name);
+    check_var(var, var_name);
+    LoDTensor* var_tensor = var->GetMutable<LoDTensor>();
+    if (var_tensor->numel() <= 0) return;  // let the serial walk report it
+    seen.insert(var_name);
+    tasks.push_back({var_name, rule, var_tensor, is_unsigned, {}});
+  };
+
+  for (const auto* op : predictor_.inference_program_->Block(0).AllOps()) {
+    if (!platform::HasOpINT8DataType(op)) continue;
+    const bool is_rnn = op->Type() == "fusion_gru" ||
+                        op->Type() == "multi_gru" ||
+                        op->Type() == "fusion_lstm";
+    for (auto const& input : op->Inputs()) {
+      if (is_rnn && (input.first == "WeightX" || input.first == "WeightH")) {
+        continue;
+      }
+      for (const auto& var_name : input.second) {
+        gather(op->Type(), input.first, var_name, /* is_unsigned = */ false);
+      }
+    }
+    for (auto const& output : op->Outputs()) {
+      if (op->Type() == "transpose2" || op->Type() == "reshape2" ||
+          op->Type() == "pool2d" || op->Type() == "concat") {
+        continue;
+      }
+      bool is_unsigned = false;
+      if (op->Type() == "conv2d" || op->Type() == "fc") {
+        std::string fuse_activation =
+            op->GetAttrIfExists<std::string>("fuse_activation");
+        is_unsigned = (fuse_activation == "relu" || fuse_activation == "relu6");
+      } else if (op->Type() == "relu") {
+        is_unsigned = true;
+      }
+      for (const auto& var_name : output.second) {
+        gather(op->Type(), output.first, var_name, is_unsigned);
+      }
+    }
+  }
+  if (tasks.empty()) return;
+
+  const size_t num_threads = std::min<size_t>(
+      tasks.size(), std::max(1u, std::thread::hardware_concurrency()));
+  std::atomic<size_t> next_task(0);
+  std::vector<std::exception_ptr> errors(num_threads);
+  std::vector<std::thread> workers;
+  for (size_t tid = 0; tid < num_threads; ++tid) {
+    workers.emplace_back([&, tid]() {
+      try {
+        size_t i;
+        while ((i = next_task.fetch_add(1)) < tasks.size()) {
+          auto& task = tasks[i];
+          task.result = ComputeScale(task.rule, *task.tensor, task.is_unsigned);
+        }
+      } catch (...) {
+        errors[tid] = std::current_exception();
+      }
+    });
+  }
+  for (auto& worker : workers) worker.join();
+  for (auto& error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+
+  for (auto& task : tasks) {
+    scales_[task.var_name] = std::move(task.result);
+  }
+}
+
 bool AnalysisPredictor::MkldnnQuantizer::CalculateScales() {
   PrettyLogH1("--- Calculating scales for quantization");
-  std::map<std::string, std::map<std::string, LoDTensor>> gathered_data;
+  PrecomputeIndependentScales();
   for (const auto* op : predictor_.inference_program_->Block(0).AllOps()) {
     if (platform::HasOpINT8DataType(op)) {
       // handle inputs first to let is_unsigned be inferred for the outputs
@@ -188,21 +316,26 @@ void AnalysisPredictor::MkldnnQuantizer::CalculateSingleScale(
           "%s of connection %s should not be empty.",
           var_name, op_type_name, conn_name));
 
+  scales_[var_name] = ComputeScale(rule, var_tensor, is_unsigned);
+}
+
+std::pair<bool, LoDTensor> AnalysisPredictor::MkldnnQuantizer::ComputeScale(
+    ScaleAlgo rule, const LoDTensor& var_tensor, bool is_unsigned) const {
+  if (ShouldSample(rule, var_tensor)) {
+    auto sample = SampleTensor(var_tensor, FLAGS_mkldnn_quantizer_max_samples);
+    return ComputeScale(rule, sample, is_unsigned);
+  }
   switch (rule) {
     case ScaleAlgo::MAX:
-      scales_[var_name] = GetMaxScalingFactor(var_tensor, is_unsigned);
-      break;
+      return GetMaxScalingFactor(var_tensor, is_unsigned);
     case ScaleAlgo::MAX_CH:
-      scales_[var_name] = GetMaxChScalingFactor(var_tensor, is_unsigned,
-                                                /*is_transposed*/ false);
-      break;
+      return GetMaxChScalingFactor(var_tensor, is_unsigned,
+                                   /*is_transposed*/ false);
     case ScaleAlgo::MAX_CH_T:
-      scales_[var_name] = GetMaxChScalingFactor(var_tensor, is_unsigned,
-                                                /*is_transposed*/ true);
-      break;
+      return GetMaxChScalingFactor(var_tensor, is_unsigned,
+                                   /*is_transposed*/ true);
     case ScaleAlgo::KL:
-      scales_[var_name] = GetKLScalingFactor(var_tensor, is_unsigned);
-      break;
+      return GetKLScalingFactor(var_tensor, is_unsigned);
     default:
       throw std::runtime_error(
           "MkldnnQuantizer: Unexpected ScaleAlgo specified.");
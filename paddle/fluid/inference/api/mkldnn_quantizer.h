@@ -61,6 +61,15 @@ class AnalysisPredictor::MkldnnQuantizer {
   bool RunWarmup() const;
   // Gather data from variables and calculate scales for them.
   bool CalculateScales();
+  // Precompute, across worker threads, every scale whose algorithm depends
+  // only on the tensor data, so that the serial dependency-resolving walk in
+  // CalculateScales mostly reuses ready results.
+  void PrecomputeIndependentScales();
+  // Compute a scale with the given rule; shared by the serial path and the
+  // calibration worker threads.
+  std::pair<bool, framework::LoDTensor> ComputeScale(
+      ScaleAlgo rule, const framework::LoDTensor& var_tensor,
+      bool is_unsigned) const;
   // Calculate a scale for tensor based on ScaleAlgo rules.
   void CalculateSingleScale(const std::string& op_name,
                             const std::string& conn_name,
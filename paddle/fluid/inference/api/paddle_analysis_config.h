@@ -206,6 +206,29 @@ struct PD_INFER_DECL AnalysisConfig {
   ///
   void DisableGpu();
 
+  ///
+  /// \brief Bind an externally owned CUDA stream to this predictor. All GPU
+  /// work the predictor issues runs on the given stream, so pre-processing,
+  /// inference and post-processing kernels of a serving pipeline are
+  /// stream-ordered with no cross-stream event synchronization. The caller
+  /// keeps ownership of the stream and must keep it alive for the lifetime
+  /// of the predictor. The binding is per calling thread; run the predictor
+  /// from the thread that owns the request context.
+  ///
+  /// \param stream a cudaStream_t (or hipStream_t) passed as void*.
+  ///
+  void SetExecStream(void* stream);
+
+  ///
+  /// \brief A boolean state telling whether an external stream is bound.
+  ///
+  bool external_stream_enabled() const { return use_external_stream_; }
+
+  ///
+  /// \brief Get the bound external stream, nullptr when none is set.
+  ///
+  void* GetExecStream() const { return exec_stream_; }
+
   ///
   /// \brief Turn on XPU.
   ///
@@ -458,6 +481,68 @@ struct PD_INFER_DECL AnalysisConfig {
   ///
   bool shape_range_info_collected();
 
+  ///
+  /// \brief Keep per-tensor shape statistics up to date on every run with
+  /// bounded overhead, unlike CollectShapeRangeInfo which stores every
+  /// observed shape and is meant for dedicated profiling runs. Only the
+  /// per-dimension min/max and a capped value histogram are maintained, and
+  /// the derived min/max/opt profile is rewritten to shape_range_info_path
+  /// every flush_interval_runs runs, so TensorRT profile generation and
+  /// memory planning can feed on real traffic.
+  ///
+  /// \param shape_range_info_path the path the shape profile is flushed to.
+  /// \param flush_interval_runs how many runs pass between two flushes.
+  ///
+  void EnableShapeRangeMonitoring(const std::string& shape_range_info_path,
+                                  int flush_interval_runs = 1024);
+
+  ///
+  /// \brief A boolean state telling whether shape range monitoring is
+  /// enabled.
+  ///
+  bool shape_range_monitoring_enabled() const {
+    return monitor_shape_range_info_;
+  }
+
+  ///
+  /// \brief Get the flush interval of the shape range monitoring mode.
+  ///
+  int shape_range_flush_interval_runs() const {
+    return shape_range_flush_interval_runs_;
+  }
+
+  ///
+  /// \brief Capture the TensorRT shape profile automatically. When the shape
+  /// info file does not exist yet, the predictor records the actual input
+  /// shapes and persists the derived min/max/opt profile once the warmup
+  /// window closes; on the next start the profile is found, the engine is
+  /// built with tuned dynamic shapes and serialized to the optimization
+  /// cache, keyed by the model and the shape profile, so later restarts
+  /// deserialize it instead of rebuilding.
+  ///
+  /// \param shape_range_info_path the path the shape profile is recorded to
+  /// and read back from.
+  /// \param warmup_runs how many runs to record before the profile is
+  /// persisted.
+  ///
+  void EnableTensorRtAutoShapeProfile(const std::string& shape_range_info_path,
+                                      int warmup_runs = 100);
+
+  ///
+  /// \brief A boolean state telling whether the automatic TensorRT shape
+  /// profile is enabled.
+  ///
+  bool trt_auto_shape_profile_enabled() const {
+    return trt_auto_shape_profile_;
+  }
+
+  ///
+  /// \brief Get the warmup window of the automatic TensorRT shape profile.
+  ///
+  int trt_shape_profile_warmup_runs() const {
+    return trt_shape_profile_warmup_runs_;
+  }
+
   ///
   /// \brief Prevent ops running in Paddle-TRT
   /// NOTE: just experimental, not an official stable API, easy to be broken.
@@ -564,6 +649,39 @@ struct PD_INFER_DECL AnalysisConfig {
     return cpu_math_library_num_threads_;
   }
 
+  ///
+  /// \brief Bind the compute threads of this predictor to an explicit core
+  /// list. Co-located predictor instances can then run on disjoint core
+  /// sets without external numactl setup. Only effective on Linux.
+  ///
+  /// \param core_ids the cores the compute threads are pinned to.
+  ///
+  void SetCpuThreadAffinity(const std::vector<int>& core_ids);
+
+  ///
+  /// \brief Bind the compute threads of this predictor to the cores of one
+  /// NUMA node, so memory stays node local. Only effective on Linux.
+  ///
+  /// \param numa_node the NUMA node whose cores are used.
+  ///
+  void SetCpuThreadAffinityNumaNode(int numa_node);
+
+  ///
+  /// \brief Get the core list the compute threads are bound to, empty when
+  /// no explicit core list was set.
+  ///
+  const std::vector<int>& cpu_thread_affinity_core_ids() const {
+    return cpu_thread_affinity_core_ids_;
+  }
+
+  ///
+  /// \brief Get the NUMA node the compute threads are bound to, -1 when no
+  /// node was set.
+  ///
+  int cpu_thread_affinity_numa_node() const {
+    return cpu_thread_affinity_numa_node_;
+  }
+
   ///
   /// \brief Transform the AnalysisConfig to NativeConfig.
   ///
@@ -662,6 +780,98 @@ struct PD_INFER_DECL AnalysisConfig {
   ///
   bool enable_memory_optim() const;
 
+  ///
+  /// \brief Turn on the runtime activation-buffer planner for dynamically
+  /// shaped models. After every run the predictor records how many bytes each
+  /// activation actually needed, keeps a high-water mark over the last
+  /// history_window runs, and releases buffers that have grown beyond that
+  /// mark back to the memory pool, which recycles them by size. Resident
+  /// memory then follows the running maximum of recent batches instead of
+  /// accumulating every variable's all-time worst case.
+  ///
+  /// \param history_window The number of recent runs the high-water mark
+  /// covers.
+  ///
+  void EnableDynamicMemoryOptim(int history_window = 16);
+  ///
+  /// \brief A boolean state telling whether the runtime activation-buffer
+  /// planner is enabled.
+  ///
+  /// \return bool Whether the runtime activation-buffer planner is enabled.
+  ///
+  bool dynamic_memory_optim_enabled() const {
+    return enable_dynamic_memory_optim_;
+  }
+  ///
+  /// \brief Get the number of recent runs the high-water mark covers.
+  ///
+  /// \return int The history window of the runtime activation-buffer planner.
+  ///
+  int dynamic_memory_optim_history_window() const {
+    return dynamic_memory_optim_history_window_;
+  }
+
+  ///
+  /// \brief Turn on the optimized program cache.
+  /// After the first start the post-analysis program and its transformed
+  /// parameters are serialized to disk, keyed by a hash of the model and the
+  /// pass configuration; later starts load them directly and skip the whole
+  /// analysis pipeline. The cache is invalidated automatically when the model
+  /// or the pass list changes. It is stored in the directory set with
+  /// SetOptimCacheDir, or in a _opt_cache directory next to the model. Not
+  /// supported together with the TensorRT, Lite or DLNNE subgraph engines or
+  /// the MKLDNN quantizer.
+  ///
+  /// \param x Whether to enable the optimized program cache.
+  ///
+  void EnableOptimizedProgramCache(bool x = true) {
+    enable_optimized_program_cache_ = x;
+  }
+  ///
+  /// \brief A boolean state telling whether the optimized program cache is
+  /// enabled.
+  ///
+  /// \return bool Whether the optimized program cache is enabled.
+  ///
+  bool optimized_program_cache_enabled() const {
+    return enable_optimized_program_cache_;
+  }
+
+  ///
+  /// \brief Turn on server-side dynamic batching and set its limits.
+  /// The settings are consumed by paddle_infer::services::DynamicBatcher,
+  /// which coalesces concurrent single requests into one batched run of the
+  /// predictor.
+  ///
+  /// \param max_batch_size The largest number of samples merged into one run.
+  /// \param batch_timeout_us How long an incomplete batch may wait for more
+  /// requests before it is flushed, in microseconds.
+  ///
+  void EnableDynamicBatching(int max_batch_size = 16,
+                             int batch_timeout_us = 2000);
+  ///
+  /// \brief A boolean state telling whether dynamic batching is enabled.
+  ///
+  /// \return bool Whether dynamic batching is enabled.
+  ///
+  bool dynamic_batching_enabled() const { return enable_dynamic_batching_; }
+  ///
+  /// \brief Get the largest number of samples merged into one batched run.
+  ///
+  /// \return int The maximum batch size of dynamic batching.
+  ///
+  int dynamic_batching_max_batch_size() const {
+    return dynamic_batching_max_batch_size_;
+  }
+  ///
+  /// \brief Get the latency budget of an incomplete batch in microseconds.
+  ///
+  /// \return int The timeout of dynamic batching.
+  ///
+  int dynamic_batching_timeout_us() const {
+    return dynamic_batching_timeout_us_;
+  }
+
   ///
   /// \brief Turn on profiling report.
   /// If not turned on, no profiling report will be generated.
@@ -738,6 +948,10 @@ struct PD_INFER_DECL AnalysisConfig {
   bool use_gpu_{false};
   int gpu_device_id_{0};
   uint64_t memory_pool_init_size_mb_{100};  // initial size is 100MB.
+  // Externally owned CUDA stream the predictor runs on, nullptr when the
+  // internally owned per-device stream is used.
+  bool use_external_stream_{false};
+  void* exec_stream_{nullptr};
   bool thread_local_stream_{false};
 
   bool use_cudnn_{false};
@@ -785,12 +999,33 @@ struct PD_INFER_DECL AnalysisConfig {
   bool collect_shape_range_info_{false};
   std::string shape_range_info_path_;
 
+  // Always-on shape statistics: bounded per-tensor min/max/histogram
+  // updated every run and periodically flushed to shape_range_info_path_.
+  bool monitor_shape_range_info_{false};
+  int shape_range_flush_interval_runs_{1024};
+
+  // Automatic shape profile capture: record the shapes of the first
+  // trt_shape_profile_warmup_runs_ runs when no profile exists yet, switch
+  // to the tuned dynamic shapes when it does.
+  bool trt_auto_shape_profile_{false};
+  int trt_shape_profile_warmup_runs_{100};
+
   // dlnne related.
   bool use_dlnne_{false};
   int dlnne_min_subgraph_size_{3};
 
   // memory reuse related.
   bool enable_memory_optim_{false};
+  bool enable_dynamic_memory_optim_{false};
+  int dynamic_memory_optim_history_window_{16};
+
+  // optimized program cache related.
+  bool enable_optimized_program_cache_{false};
+
+  // dynamic batching related.
+  bool enable_dynamic_batching_{false};
+  int dynamic_batching_max_batch_size_{16};
+  int dynamic_batching_timeout_us_{2000};
 
   bool use_mkldnn_{false};
   std::unordered_set<std::string> mkldnn_enabled_op_types_;
@@ -804,6 +1039,10 @@ struct PD_INFER_DECL AnalysisConfig {
   bool specify_input_name_{false};
 
   int cpu_math_library_num_threads_{1};
+  // Instance partitioning: the cores / NUMA node the compute threads of
+  // this predictor are pinned to. Empty and -1 leave the threads unbound.
+  std::vector<int> cpu_thread_affinity_core_ids_;
+  int cpu_thread_affinity_numa_node_{-1};
 
   bool with_profile_{false};
 
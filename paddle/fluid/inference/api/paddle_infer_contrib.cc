@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "paddle/fluid/inference/api/paddle_infer_contrib.h"
+#include "paddle/fluid/framework/data_type.h"
+#include "paddle/fluid/framework/lod_tensor.h"
 #include "paddle/fluid/framework/scope.h"
 #include "paddle/fluid/memory/memcpy.h"
 #include "paddle/fluid/platform/device_context.h"
@@ -176,6 +178,55 @@ void TensorUtils::CopyTensor(Tensor* p_dst, const Tensor& src) {
   CopyTensorImpl(p_dst, src, nullptr, nullptr, nullptr);
 }
 
+void TensorUtils::ShareExternalData(Tensor* p_tensor, void* data,
+                                    const std::vector<int>& shape,
+                                    DataType dtype) {
+  PADDLE_ENFORCE_NOT_NULL(data,
+                          paddle::platform::errors::InvalidArgument(
+                              "The external data pointer of ShareExternalData "
+                              "shouldn't be nullptr"));
+  paddle::framework::proto::VarType::Type proto_type;
+  switch (dtype) {
+    case DataType::FLOAT32:
+      proto_type = paddle::framework::proto::VarType::FP32;
+      break;
+    case DataType::FLOAT16:
+      proto_type = paddle::framework::proto::VarType::FP16;
+      break;
+    case DataType::INT64:
+      proto_type = paddle::framework::proto::VarType::INT64;
+      break;
+    case DataType::INT32:
+      proto_type = paddle::framework::proto::VarType::INT32;
+      break;
+    case DataType::UINT8:
+      proto_type = paddle::framework::proto::VarType::UINT8;
+      break;
+    case DataType::INT8:
+      proto_type = paddle::framework::proto::VarType::INT8;
+      break;
+    default:
+      PADDLE_THROW(paddle::platform::errors::Unimplemented(
+          "Only INT32, INT64, UINT8, INT8, FLOAT16 and "
+          "FLOAT32 is supported in ShareExternalData."));
+  }
+  auto* scope = static_cast<paddle::framework::Scope*>(p_tensor->scope_);
+  auto* var = scope->FindVar(p_tensor->name_);
+  PADDLE_ENFORCE_NOT_NULL(
+      var, paddle::platform::errors::PreconditionNotMet(
+               "No tensor called [%s] in the runtime scope", p_tensor->name_));
+  auto* tensor = var->GetMutable<paddle::framework::LoDTensor>();
+  auto ddim = paddle::framework::make_ddim(shape);
+  tensor->Resize(ddim);
+  size_t byte_size = paddle::framework::product(ddim) *
+                     paddle::framework::SizeOfType(proto_type);
+  // The tensor does not own the external buffer: the holder only aliases
+  // it, so binding never copies and the caller keeps ownership.
+  auto holder = std::make_shared<paddle::memory::Allocation>(
+      data, byte_size, paddle::platform::CPUPlace());
+  tensor->ResetHolderWithType(std::move(holder), proto_type);
+}
+
 void TensorUtils::CopyTensorAsync(Tensor* p_dst, const Tensor& src,
                                   void* exec_stream) {
   CopyTensorImpl(p_dst, src, exec_stream, nullptr, nullptr);
@@ -30,6 +30,14 @@ class TensorUtils {
   static void CopyTensorAsync(Tensor* p_dst, const Tensor& src, CallbackFunc cb,
                               void* cb_params);
 
+  /// \brief Share a persistent caller-owned host buffer as the underlying
+  /// storage of the tensor. No data is copied, so the call is cheap enough
+  /// to repeat per request; re-share only when the shape changes. The
+  /// buffer must stay valid and large enough for everything written to the
+  /// tensor while it is bound.
+  static void ShareExternalData(Tensor* p_tensor, void* data,
+                                const std::vector<int>& shape, DataType dtype);
+
  private:
   static void CopyTensorImpl(Tensor* p_dst, const Tensor& src,
                              void* exec_stream, CallbackFunc cb,
@@ -198,6 +198,53 @@ class PD_INFER_DECL PredictorPool {
   std::shared_ptr<Predictor> main_pred_;
   std::vector<std::unique_ptr<Predictor>> preds_;
 };
+
+///
+/// \class DynamicBatcher
+///
+/// \brief DynamicBatcher coalesces single requests issued from many threads
+/// into one batched run of a shared Predictor. A request blocks until either
+/// enough samples have gathered to fill a batch or the latency budget has
+/// expired; the gathered inputs are then concatenated along the batch
+/// dimension, the predictor runs once, and every caller receives its own rows
+/// of the outputs. The batch limits are configured with
+/// AnalysisConfig::EnableDynamicBatching.
+///
+class PD_INFER_DECL DynamicBatcher {
+ public:
+  DynamicBatcher() = delete;
+  DynamicBatcher(const DynamicBatcher&) = delete;
+  DynamicBatcher& operator=(const DynamicBatcher&) = delete;
+
+  /// \brief Construct a batcher that owns a predictor created from \param
+  /// config. The batch limits are read from the config.
+  explicit DynamicBatcher(const Config& config);
+
+  /// \brief Construct a batcher serving an existing predictor, with the batch
+  /// limits given explicitly.
+  DynamicBatcher(std::shared_ptr<Predictor> predictor, int max_batch_size,
+                 int batch_timeout_us);
+
+  ~DynamicBatcher();
+
+  ///
+  /// \brief Submit one request and wait for its outputs. Thread safe.
+  /// All requests must provide the same named inputs in the same order; the
+  /// first dimension of every input is the batch dimension and the remaining
+  /// dimensions must match between requests, so variable-length inputs have
+  /// to be padded by the caller before submitting.
+  ///
+  /// \param[in] inputs the named input tensors of this request.
+  /// \param[out] outputs this request's rows of every output tensor.
+  /// \return Whether the request ran successfully.
+  ///
+  bool Run(const std::vector<paddle::PaddleTensor>& inputs,
+           std::vector<paddle::PaddleTensor>* outputs);
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
 }  // namespace services
 
 }  // namespace paddle_infer
@@ -132,7 +132,11 @@ GpuPassStrategy::GpuPassStrategy() : PassStrategy({}) {
   passes_.assign({
     //   "identity_scale_op_clean_pass",             //
     "is_test_pass",                                  //
+        // must run before simplify_with_basic_ops_pass rewrites the
+        // dropout ops it matches on.
+        "bias_dropout_residual_layer_norm_fuse_pass",  //
         "simplify_with_basic_ops_pass",              //
+        "constant_folding_pass",                     //
         "conv_affine_channel_fuse_pass",             //
         "conv_eltwiseadd_affine_channel_fuse_pass",  //
         "conv_bn_fuse_pass",                         //
@@ -188,6 +192,7 @@ CpuPassStrategy::CpuPassStrategy() : PassStrategy({}) {
   // NOTE the large fusions should be located in the front, so that they will
   // not be damaged by smaller ones.
   passes_.assign({"simplify_with_basic_ops_pass",  //
+                  "constant_folding_pass",         //
                   "layer_norm_fuse_pass",
                   "attention_lstm_fuse_pass",       //
                   "seqconv_eltadd_relu_fuse_pass",  //
@@ -247,12 +252,24 @@ void CpuPassStrategy::EnableMKLDNN() {
              "conv_swish_mkldnn_fuse_pass",                //
              "conv_hard_swish_mkldnn_fuse_pass",           //
              "scale_matmul_fuse_pass",                     //
+             // Rewrites non-broadcasting matmul_v2 (as emitted by attention
+             // blocks) into matmul, so the two fuse passes below can fold
+             // the surrounding reshape2/transpose2 pairs.
+             "map_matmul_v2_to_matmul_pass",               //
              "reshape_transpose_matmul_mkldnn_fuse_pass",  //
              "matmul_transpose_reshape_fuse_pass",         //
+             "parallel_matmul_fuse_pass",                  //
              // Disabled due to topology-dependent speed-up
              // "fc_mkldnn_pass",
              // "fc_act_mkldnn_fuse_pass",
              "batch_norm_act_fuse_pass",
+             // Runs after the fuse passes so already fused operators keep
+             // their oneDNN placement and only the remaining layout-agnostic
+             // chains get converted.
+             "mkldnn_layout_propagation_pass",
+             // Must stay after every pass that recomputes conv weights,
+             // since it replaces them with oneDNN-blocked data.
+             "conv_weights_prepack_mkldnn_pass",
              // TODO(intel): Please fix the bug on windows.
              // https://github.com/PaddlePaddle/Paddle/issues/29710
              // "mkldnn_inplace_pass",  // This pass should be activated after
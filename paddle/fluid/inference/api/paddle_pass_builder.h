@@ -106,8 +106,8 @@ class PD_INFER_DECL PaddlePassBuilder {
   /// \cond Protected
   std::vector<std::string> analysis_passes_{
       {"ir_graph_build_pass", "ir_graph_clean_pass", "ir_analysis_pass",
-       "ir_params_sync_among_devices_pass", "adjust_cudnn_workspace_size_pass",
-       "inference_op_replace_pass"}};
+       "ir_params_sync_among_devices_pass", "params_dedup_pass",
+       "adjust_cudnn_workspace_size_pass", "inference_op_replace_pass"}};
   std::vector<std::string> passes_;
   /// \endcond
 };
@@ -92,6 +92,18 @@ class PD_INFER_DECL Tensor {
   template <typename T>
   void CopyFromCpu(const T* data);
 
+  /// \brief Copy the host memory to tensor data asynchronously.
+  /// Unlike CopyFromCpu, the copy is only enqueued on the given stream and
+  /// may still be in flight when this call returns, so the host buffer must
+  /// stay valid until the stream has been synchronized with (pinned host
+  /// memory is recommended for a truly asynchronous transfer).
+  /// \param data The pointer of the data, from which the tensor will copy.
+  /// \param exec_stream The stream the copy is issued on (only a GPU CUDA
+  /// stream is supported now), typically
+  /// AnalysisPredictor::GetInputCopyStream().
+  template <typename T>
+  void CopyFromCpuAsync(const T* data, void* exec_stream);
+
   /// \brief Experimental interface.
   /// It's usually used to set the input tensor data with Strings data type.
   /// \param data The pointer of the data, from which the tensor will copy.
@@ -152,6 +164,9 @@ class PD_INFER_DECL Tensor {
   void CopyToCpuImpl(T* data, void* stream = nullptr, CallbackFunc cb = nullptr,
                      void* cb_params = nullptr) const;
 
+  template <typename T>
+  void CopyFromCpuImpl(const T* data, void* exec_stream);
+
   std::string name_;
   // The corresponding tensor pointer inside Paddle workspace is cached for
   // performance.
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "paddle/fluid/inference/capi_exp/pd_tensor.h"
+#include "paddle/fluid/inference/api/paddle_infer_contrib.h"
 #include "paddle/fluid/inference/api/paddle_inference_api.h"
 #include "paddle/fluid/inference/capi_exp/pd_types.h"
 #include "paddle/fluid/inference/capi_exp/pd_utils.h"
@@ -39,6 +40,18 @@ void PD_TensorReshape(__pd_keep PD_Tensor* pd_tensor, size_t shape_size,
   tensor->Reshape(shapes);
 }
 
+void PD_TensorShareExternalData(__pd_keep PD_Tensor* pd_tensor, void* data,
+                                PD_DataType data_type, size_t shape_size,
+                                int32_t* shape) {
+  CHECK_AND_CONVERT_PD_TENSOR;
+  std::vector<int> shapes(shape_size);
+  for (size_t index = 0; index < shape_size; ++index) {
+    shapes[index] = shape[index];
+  }
+  paddle_infer::contrib::TensorUtils::ShareExternalData(
+      tensor.get(), data, shapes, paddle_infer::CvtToCxxDatatype(data_type));
+}
+
 #define REPEAT_ALL_DATA_TYPE(func)                             \
   func(float, Float) func(int64_t, Int64) func(int32_t, Int32) \
       func(uint8_t, Uint8) func(int8_t, Int8)
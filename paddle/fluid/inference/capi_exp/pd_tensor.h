@@ -55,6 +55,24 @@ PADDLE_CAPI_EXPORT extern void PD_TensorReshape(__pd_keep PD_Tensor* pd_tensor,
                                                 size_t shape_size,
                                                 int32_t* shape);
 
+///
+/// \brief Share a persistent caller-owned host buffer as the underlying
+/// storage of the tensor. Subsequent PD_PredictorRun calls read (input
+/// tensor) or write (output tensor) the buffer in place, so no copy
+/// happens at the API boundary. Binding never copies data, re-bind only
+/// when the shape changes. The buffer must stay valid and large enough
+/// for everything written to the tensor while it is bound.
+///
+/// \param[in] pd_tensor tensor.
+/// \param[in] data The caller-owned buffer to share.
+/// \param[in] data_type The data type of the buffer.
+/// \param[in] shape_size The size of shape.
+/// \param[in] shape The shape of the buffer.
+///
+PADDLE_CAPI_EXPORT extern void PD_TensorShareExternalData(
+    __pd_keep PD_Tensor* pd_tensor, void* data, PD_DataType data_type,
+    size_t shape_size, int32_t* shape);
+
 ///
 /// \brief Get the memory pointer in CPU or GPU with 'float' data type.
 /// Please Reshape the tensor first before call this.
@@ -38,6 +38,7 @@
 #include "paddle/fluid/inference/tests/api/config_printer.h"
 #include "paddle/fluid/inference/tests/test_helper.h"
 #include "paddle/fluid/inference/utils/benchmark.h"
+#include "paddle/fluid/inference/utils/benchmark_harness.h"
 #include "paddle/fluid/platform/profiler.h"
 
 DEFINE_string(model_name, "", "model name");
@@ -63,6 +64,13 @@ DEFINE_bool(use_analysis, true,
             "Running the inference program in analysis mode.");
 DEFINE_bool(record_benchmark, false,
             "Record benchmark after profiling the model");
+DEFINE_string(benchmark_output, "benchmark_record.jsonl",
+              "File the JSON-lines benchmark records are appended to.");
+DEFINE_string(benchmark_baseline, "",
+              "JSON-lines file from a previous run to compare recorded "
+              "benchmarks against; a p99 latency regression fails the test.");
+DEFINE_double(benchmark_tolerance, 0.1,
+              "Allowed relative p99 latency increase over the baseline.");
 DEFINE_double(accuracy, 1e-3, "Result Accuracy.");
 DEFINE_double(quantized_accuracy, 1e-2, "Result Quantized Accuracy.");
 DEFINE_bool(zero_copy, false, "Use ZeroCopy to speedup Feed/Fetch.");
@@ -507,6 +515,8 @@ void PredictionRun(PaddlePredictor *predictor,
             << ", run " << num_times << " times...";
   Timer run_timer;
   double elapsed_time = 0;
+  std::vector<double> batch_latencies;
+  batch_latencies.reserve(iterations);
 #ifdef WITH_GPERFTOOLS
   ProfilerStart("paddle_inference.prof");
 #endif
@@ -517,7 +527,9 @@ void PredictionRun(PaddlePredictor *predictor,
       for (int j = 0; j < num_times; j++) {
         predictor->Run(inputs[i], &(*outputs)[i], FLAGS_batch_size);
       }
-      elapsed_time += run_timer.toc();
+      double iter_time = run_timer.toc();
+      elapsed_time += iter_time;
+      batch_latencies.push_back(iter_time / num_times);
 
       predicted_num += FLAGS_batch_size;
       if (predicted_num % 100 == 0) {
@@ -531,7 +543,9 @@ void PredictionRun(PaddlePredictor *predictor,
       for (int j = 0; j < num_times; j++) {
         predictor->ZeroCopyRun();
       }
-      elapsed_time += run_timer.toc();
+      double iter_time = run_timer.toc();
+      elapsed_time += iter_time;
+      batch_latencies.push_back(iter_time / num_times);
 
       predicted_num += FLAGS_batch_size;
       if (predicted_num % 100 == 0) {
@@ -557,6 +571,27 @@ void PredictionRun(PaddlePredictor *predictor,
     benchmark.SetBatchSize(FLAGS_batch_size);
     benchmark.SetLatency(batch_latency);
     benchmark.PersistToFile("benchmark_record.txt");
+
+    BenchmarkRecord record;
+    record.model_name = FLAGS_model_name;
+    record.config = FLAGS_enable_int8 ? "int8"
+                                      : FLAGS_enable_bf16 ? "bf16" : "fp32";
+    record.batch_size = FLAGS_batch_size;
+    record.num_threads = num_threads;
+    record.SetLatencies(batch_latencies);
+    record.peak_mem_kb = ProcessPeakMemoryKB();
+    record.AppendToFile(FLAGS_benchmark_output);
+
+    if (!FLAGS_benchmark_baseline.empty()) {
+      BenchmarkBaseline baseline;
+      ASSERT_TRUE(baseline.Load(FLAGS_benchmark_baseline))
+          << "Can not load baseline file " << FLAGS_benchmark_baseline;
+      std::string message;
+      EXPECT_TRUE(baseline.CheckRegression(record, FLAGS_benchmark_tolerance,
+                                           &message))
+          << message;
+      LOG(INFO) << message;
+    }
   }
 }
 
@@ -0,0 +1,179 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/inference/utils/benchmark_harness.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+
+#include "paddle/fluid/platform/enforce.h"
+
+namespace paddle {
+namespace inference {
+
+double Percentile(std::vector<double> sorted_values, double q) {
+  if (sorted_values.empty()) return 0.;
+  std::sort(sorted_values.begin(), sorted_values.end());
+  double pos = q * (sorted_values.size() - 1);
+  size_t lo = static_cast<size_t>(std::floor(pos));
+  size_t hi = static_cast<size_t>(std::ceil(pos));
+  double frac = pos - lo;
+  return sorted_values[lo] * (1. - frac) + sorted_values[hi] * frac;
+}
+
+int64_t ProcessPeakMemoryKB() {
+#ifdef __linux__
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, 6, "VmHWM:") == 0) {
+      std::istringstream fields(line.substr(6));
+      int64_t kb = 0;
+      fields >> kb;
+      return kb;
+    }
+  }
+#endif
+  return 0;
+}
+
+std::string BenchmarkRecord::Key() const {
+  std::stringstream ss;
+  ss << model_name << "/" << config << "/bs" << batch_size << "/t"
+     << num_threads;
+  return ss.str();
+}
+
+void BenchmarkRecord::SetLatencies(const std::vector<double> &latencies_ms) {
+  if (latencies_ms.empty()) return;
+  latency_avg =
+      std::accumulate(latencies_ms.begin(), latencies_ms.end(), 0.) /
+      latencies_ms.size();
+  latency_p50 = Percentile(latencies_ms, 0.50);
+  latency_p90 = Percentile(latencies_ms, 0.90);
+  latency_p99 = Percentile(latencies_ms, 0.99);
+  if (latency_avg > 0.) qps = batch_size * 1000.0 / latency_avg;
+}
+
+std::string BenchmarkRecord::ToJsonLine() const {
+  std::stringstream ss;
+  ss << "{\"model\": \"" << model_name << "\", \"config\": \"" << config
+     << "\", \"batch_size\": " << batch_size
+     << ", \"num_threads\": " << num_threads
+     << ", \"latency_avg\": " << latency_avg
+     << ", \"latency_p50\": " << latency_p50
+     << ", \"latency_p90\": " << latency_p90
+     << ", \"latency_p99\": " << latency_p99 << ", \"qps\": " << qps
+     << ", \"peak_mem_kb\": " << peak_mem_kb << "}";
+  return ss.str();
+}
+
+namespace {
+
+// Extracts the value following "\"key\": " in a JSON line written by
+// ToJsonLine. Quotes of string values are stripped by the caller.
+bool ExtractField(const std::string &line, const std::string &key,
+                  std::string *value) {
+  std::string needle = "\"" + key + "\": ";
+  size_t pos = line.find(needle);
+  if (pos == std::string::npos) return false;
+  pos += needle.size();
+  size_t end = line.find_first_of(",}", pos);
+  if (end == std::string::npos) return false;
+  *value = line.substr(pos, end - pos);
+  return true;
+}
+
+bool ExtractString(const std::string &line, const std::string &key,
+                   std::string *value) {
+  if (!ExtractField(line, key, value)) return false;
+  if (value->size() < 2 || value->front() != '"' || value->back() != '"')
+    return false;
+  *value = value->substr(1, value->size() - 2);
+  return true;
+}
+
+template <typename T>
+bool ExtractNumber(const std::string &line, const std::string &key, T *value) {
+  std::string field;
+  if (!ExtractField(line, key, &field)) return false;
+  std::istringstream ss(field);
+  ss >> *value;
+  return !ss.fail();
+}
+
+}  // namespace
+
+bool BenchmarkRecord::FromJsonLine(const std::string &line,
+                                   BenchmarkRecord *record) {
+  return ExtractString(line, "model", &record->model_name) &&
+         ExtractString(line, "config", &record->config) &&
+         ExtractNumber(line, "batch_size", &record->batch_size) &&
+         ExtractNumber(line, "num_threads", &record->num_threads) &&
+         ExtractNumber(line, "latency_avg", &record->latency_avg) &&
+         ExtractNumber(line, "latency_p50", &record->latency_p50) &&
+         ExtractNumber(line, "latency_p90", &record->latency_p90) &&
+         ExtractNumber(line, "latency_p99", &record->latency_p99) &&
+         ExtractNumber(line, "qps", &record->qps) &&
+         ExtractNumber(line, "peak_mem_kb", &record->peak_mem_kb);
+}
+
+void BenchmarkRecord::AppendToFile(const std::string &path) const {
+  std::ofstream file(path, std::ios::app);
+  PADDLE_ENFORCE_EQ(file.is_open(), true,
+                    platform::errors::Unavailable(
+                        "Can not open %s to add benchmark record.", path));
+  file << ToJsonLine() << '\n';
+}
+
+bool BenchmarkBaseline::Load(const std::string &path) {
+  std::ifstream file(path);
+  if (!file.is_open()) return false;
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty()) continue;
+    BenchmarkRecord record;
+    if (BenchmarkRecord::FromJsonLine(line, &record)) {
+      // Later lines win, so an appended rerun supersedes older results.
+      records_[record.Key()] = record;
+    }
+  }
+  return true;
+}
+
+bool BenchmarkBaseline::CheckRegression(const BenchmarkRecord &current,
+                                        double tolerance,
+                                        std::string *message) const {
+  auto it = records_.find(current.Key());
+  std::stringstream ss;
+  if (it == records_.end()) {
+    ss << current.Key() << ": no baseline, recorded as new";
+    if (message) *message = ss.str();
+    return true;
+  }
+  const BenchmarkRecord &base = it->second;
+  double limit = base.latency_p99 * (1. + tolerance);
+  bool ok = current.latency_p99 <= limit;
+  ss << current.Key() << ": p99 " << current.latency_p99 << " ms vs baseline "
+     << base.latency_p99 << " ms (limit " << limit << " ms) -> "
+     << (ok ? "OK" : "REGRESSION");
+  if (message) *message = ss.str();
+  return ok;
+}
+
+}  // namespace inference
+}  // namespace paddle
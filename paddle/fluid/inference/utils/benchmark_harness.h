@@ -0,0 +1,86 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace inference {
+
+/*
+ * One measurement of a model under one configuration, designed for
+ * release-over-release tracking: instead of a single mean latency it keeps
+ * the latency distribution (percentiles), the throughput and the process
+ * peak memory, and serializes to one JSON line so results from a whole
+ * model corpus can be concatenated and diffed mechanically.
+ */
+struct BenchmarkRecord {
+  std::string model_name;
+  // Configuration tag, e.g. "fp32", "mkldnn_bf16", "mkldnn_int8".
+  std::string config;
+  int batch_size{0};
+  int num_threads{1};
+  // Latencies in milliseconds per batch.
+  double latency_avg{0.};
+  double latency_p50{0.};
+  double latency_p90{0.};
+  double latency_p99{0.};
+  // Samples per second.
+  double qps{0.};
+  // Peak resident memory of the process in KB, 0 if unknown.
+  int64_t peak_mem_kb{0};
+
+  // Key identifying the (model, config, shape) cell a baseline is matched on.
+  std::string Key() const;
+
+  // Fills the latency fields and qps from raw per-batch timings.
+  void SetLatencies(const std::vector<double> &latencies_ms);
+
+  std::string ToJsonLine() const;
+  static bool FromJsonLine(const std::string &line, BenchmarkRecord *record);
+
+  void AppendToFile(const std::string &path) const;
+};
+
+// q in [0, 1]; interpolates between adjacent samples like numpy's default.
+double Percentile(std::vector<double> sorted_values, double q);
+
+// Peak resident set size of the current process in KB (VmHWM). Returns 0 on
+// platforms where it cannot be read.
+int64_t ProcessPeakMemoryKB();
+
+/*
+ * Baseline results loaded from a file of JSON lines produced by
+ * BenchmarkRecord::AppendToFile in a previous run. CheckRegression flags a
+ * record whose p99 latency exceeds the baseline by more than the given
+ * relative tolerance; records with no matching baseline pass and are
+ * reported as new.
+ */
+class BenchmarkBaseline {
+ public:
+  bool Load(const std::string &path);
+
+  size_t size() const { return records_.size(); }
+
+  bool CheckRegression(const BenchmarkRecord &current, double tolerance,
+                       std::string *message) const;
+
+ private:
+  std::map<std::string, BenchmarkRecord> records_;
+};
+
+}  // namespace inference
+}  // namespace paddle
@@ -0,0 +1,84 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/inference/utils/benchmark_harness.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace paddle {
+namespace inference {
+
+TEST(BenchmarkHarness, Percentile) {
+  std::vector<double> values{5., 1., 3., 2., 4.};
+  EXPECT_DOUBLE_EQ(Percentile(values, 0.), 1.);
+  EXPECT_DOUBLE_EQ(Percentile(values, 0.5), 3.);
+  EXPECT_DOUBLE_EQ(Percentile(values, 1.), 5.);
+  EXPECT_DOUBLE_EQ(Percentile(values, 0.25), 2.);
+  EXPECT_DOUBLE_EQ(Percentile({}, 0.5), 0.);
+}
+
+TEST(BenchmarkHarness, JsonRoundTrip) {
+  BenchmarkRecord record;
+  record.model_name = "resnet50";
+  record.config = "mkldnn_bf16";
+  record.batch_size = 16;
+  record.num_threads = 4;
+  record.SetLatencies({10., 12., 11., 30., 12.});
+  record.peak_mem_kb = 1024;
+
+  BenchmarkRecord parsed;
+  ASSERT_TRUE(BenchmarkRecord::FromJsonLine(record.ToJsonLine(), &parsed));
+  EXPECT_EQ(parsed.model_name, record.model_name);
+  EXPECT_EQ(parsed.config, record.config);
+  EXPECT_EQ(parsed.batch_size, record.batch_size);
+  EXPECT_EQ(parsed.num_threads, record.num_threads);
+  EXPECT_NEAR(parsed.latency_p99, record.latency_p99, 1e-4);
+  EXPECT_NEAR(parsed.qps, record.qps, 1e-2);
+  EXPECT_EQ(parsed.peak_mem_kb, record.peak_mem_kb);
+  EXPECT_EQ(parsed.Key(), record.Key());
+}
+
+TEST(BenchmarkHarness, BaselineComparison) {
+  BenchmarkRecord base;
+  base.model_name = "ernie";
+  base.config = "fp32";
+  base.batch_size = 1;
+  base.num_threads = 1;
+  base.SetLatencies({10., 10., 10.});
+  base.AppendToFile("benchmark_baseline_test.jsonl");
+
+  BenchmarkBaseline baseline;
+  ASSERT_TRUE(baseline.Load("benchmark_baseline_test.jsonl"));
+  ASSERT_EQ(baseline.size(), 1UL);
+
+  BenchmarkRecord current = base;
+  std::string message;
+  current.SetLatencies({10.5, 10.5, 10.5});
+  EXPECT_TRUE(baseline.CheckRegression(current, 0.1, &message)) << message;
+  current.SetLatencies({12., 12., 12.});
+  EXPECT_FALSE(baseline.CheckRegression(current, 0.1, &message)) << message;
+
+  // Unknown cells pass and are reported as new.
+  current.model_name = "unknown_model";
+  EXPECT_TRUE(baseline.CheckRegression(current, 0.1, &message));
+}
+
+TEST(BenchmarkHarness, PeakMemory) {
+#ifdef __linux__
+  EXPECT_GT(ProcessPeakMemoryKB(), 0);
+#endif
+}
+
+}  // namespace inference
+}  // namespace paddle
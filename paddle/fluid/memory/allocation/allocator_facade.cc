@@ -34,6 +34,7 @@
 #include "paddle/fluid/platform/gpu_info.h"
 #endif
 #ifdef PADDLE_WITH_CUDA
+#include "paddle/fluid/memory/allocation/cuda_malloc_async_allocator.h"
 #include "paddle/fluid/platform/cuda_graph.h"
 #endif
 #ifdef PADDLE_WITH_XPU
@@ -167,6 +168,22 @@ class AllocatorFacadePrivate {
         break;
       }
 
+      case AllocatorStrategy::kCUDAMallocAsync: {
+        InitNaiveBestFitCPUAllocator();
+#ifdef PADDLE_WITH_CUDA
+        for (int dev_id = 0; dev_id < platform::GetCUDADeviceCount();
+             ++dev_id) {
+          InitCUDAMallocAsyncAllocator(platform::CUDAPlace(dev_id));
+        }
+        InitNaiveBestFitCUDAPinnedAllocator();
+#else
+        PADDLE_THROW(platform::errors::Unavailable(
+            "The cuda_malloc_async allocator strategy is only supported when "
+            "PaddlePaddle is compiled with CUDA."));
+#endif
+        break;
+      }
+
       default: {
         PADDLE_THROW(platform::errors::InvalidArgument(
             "Unsupported allocator strategy: %d", static_cast<int>(strategy_)));
@@ -215,6 +232,13 @@ class AllocatorFacadePrivate {
     return iter->second;
   }
 
+  inline AutoGrowthBestFitAllocator* GetAutoGrowthAllocator(
+      const platform::Place& place) {
+    auto iter = auto_growth_allocators_.find(place);
+    return iter == auto_growth_allocators_.end() ? nullptr
+                                                 : iter->second.get();
+  }
+
  private:
   void InitSystemAllocators() {
     if (!system_allocators_.empty()) return;
@@ -256,6 +280,12 @@ class AllocatorFacadePrivate {
     allocators_[p] = std::make_shared<ThreadLocalCUDAAllocator>(p);
   }
 
+#ifdef PADDLE_WITH_CUDA
+  void InitCUDAMallocAsyncAllocator(platform::CUDAPlace p) {
+    allocators_[p] = std::make_shared<CUDAMallocAsyncAllocator>(p);
+  }
+#endif
+
   void InitAutoGrowthCUDAAllocator(platform::CUDAPlace p,
                                    bool allow_free_idle_chunk) {
     auto cuda_allocator = std::make_shared<CUDAAllocator>(p);
@@ -290,8 +320,12 @@ class AllocatorFacadePrivate {
       VLOG(10) << "not use AlignedAllocator with alignment: " << alignment;
       underlying_allocator = cuda_allocator;
     }
-    allocators_[p] = std::make_shared<AutoGrowthBestFitAllocator>(
+    auto auto_growth_allocator = std::make_shared<AutoGrowthBestFitAllocator>(
         underlying_allocator, alignment, 0, allow_free_idle_chunk);
+    allocators_[p] = auto_growth_allocator;
+    // Keep the unwrapped allocator reachable so the facade can drive its
+    // compaction service through any wrapper (e.g. RetryAllocator).
+    auto_growth_allocators_[p] = auto_growth_allocator;
   }
 #endif
 
@@ -422,6 +456,8 @@ class AllocatorFacadePrivate {
 
  private:
   AllocatorMap allocators_;
+  std::map<platform::Place, std::shared_ptr<AutoGrowthBestFitAllocator>>
+      auto_growth_allocators_;
 #ifdef PADDLE_WITH_CUDA
   std::unordered_map<CUDAGraphID, std::unique_ptr<AllocatorFacadePrivate>>
       cuda_graph_allocator_map_;
@@ -467,6 +503,34 @@ const std::shared_ptr<Allocator>& AllocatorFacade::GetAllocator(
   return m_->GetAllocator(place, /* A non-zero num to choose allocator_ */ 1);
 }
 
+void AllocatorFacade::TriggerDefrag(const platform::Place& place) {
+  auto* allocator = m_->GetAutoGrowthAllocator(place);
+  if (allocator != nullptr) {
+    allocator->TriggerDefrag();
+  }
+}
+
+uint64_t AllocatorFacade::DefraggedBytes(const platform::Place& place) {
+  auto* allocator = m_->GetAutoGrowthAllocator(place);
+  return allocator != nullptr ? allocator->DefraggedBytes() : 0;
+}
+
+AllocatorStats AllocatorFacade::GetStats(const platform::Place& place) {
+  AllocatorStats stats;
+  auto* allocator = m_->GetAutoGrowthAllocator(place);
+  if (allocator != nullptr) {
+    allocator->GetStats(&stats);
+  }
+  return stats;
+}
+
+std::vector<std::string> AllocatorFacade::GetAllocEventLog(
+    const platform::Place& place) {
+  auto* allocator = m_->GetAutoGrowthAllocator(place);
+  return allocator != nullptr ? allocator->EventLog()
+                              : std::vector<std::string>();
+}
+
 #ifdef PADDLE_WITH_CUDA
 void AllocatorFacade::PrepareMemoryPoolForCUDAGraph(CUDAGraphID id) {
   return m_->PrepareMemoryPoolForCUDAGraph(id);
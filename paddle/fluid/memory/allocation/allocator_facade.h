@@ -14,7 +14,10 @@
 
 #pragma once
 #include <memory>
+#include <string>
+#include <vector>
 #include "paddle/fluid/memory/allocation/allocator.h"
+#include "paddle/fluid/memory/allocation/allocator_stats.h"
 #ifdef PADDLE_WITH_ASCEND_CL
 #include "paddle/fluid/memory/allocation/npu_pinned_allocator.h"
 #endif
@@ -57,6 +60,25 @@ class AllocatorFacade {
   uint64_t Release(const platform::Place& place);
   const std::shared_ptr<Allocator>& GetAllocator(const platform::Place& place);
 
+  // Wake the background compaction service of the auto_growth allocator of
+  // `place` for one extra pass. No-op for other strategies or when
+  // FLAGS_auto_growth_defrag_interval_ms is not positive.
+  void TriggerDefrag(const platform::Place& place);
+
+  // Total bytes the compaction service has returned to the device so far,
+  // 0 for other strategies.
+  uint64_t DefraggedBytes(const platform::Place& place);
+
+  // Telemetry snapshot of the auto_growth allocator of `place`: usage,
+  // chunk and free-block accounting plus growth/retry counters. All zero
+  // for other strategies.
+  AllocatorStats GetStats(const platform::Place& place);
+
+  // Bounded event log of the auto_growth allocator of `place`, recording
+  // chunk growth and failed-then-retried allocations. Empty for other
+  // strategies.
+  std::vector<std::string> GetAllocEventLog(const platform::Place& place);
+
 #ifdef PADDLE_WITH_CUDA
   void PrepareMemoryPoolForCUDAGraph(CUDAGraphID id);
   void RemoveMemoryPoolOfCUDAGraph(CUDAGraphID id);
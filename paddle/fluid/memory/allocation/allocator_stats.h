@@ -0,0 +1,49 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+// Telemetry snapshot of one auto_growth allocator, see
+// AllocatorFacade::GetStats. All byte counts refer to the aligned sizes the
+// allocator works with internally.
+struct AllocatorStats {
+  // bytes currently handed out to live allocations
+  uint64_t current_usage{0};
+  // high-water mark of current_usage
+  uint64_t peak_usage{0};
+  // chunks currently held from the underlying allocator and their total size
+  uint64_t chunk_count{0};
+  uint64_t chunk_bytes{0};
+  // free blocks cached in the pool; chunk_bytes - free_block_bytes -
+  // current_usage quantifies fragmentation lost to block splitting
+  uint64_t free_block_count{0};
+  uint64_t free_block_bytes{0};
+  // bucket i counts the free blocks whose size is in [2^i, 2^(i+1))
+  std::vector<uint64_t> free_block_histogram;
+  // chunk growth events since the allocator was created
+  uint64_t growth_count{0};
+  // allocations that only succeeded after freeing idle chunks
+  uint64_t retry_count{0};
+};
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
@@ -36,9 +36,13 @@ static AllocatorStrategy GetStrategyFromFlag() {
     return AllocatorStrategy::kThreadLocal;
   }
 
+  if (FLAGS_allocator_strategy == "cuda_malloc_async") {
+    return AllocatorStrategy::kCUDAMallocAsync;
+  }
+
   PADDLE_THROW(platform::errors::InvalidArgument(
       "Unsupported allocator strategy: %s, condicates are naive_best_fit, "
-      "auto_growth or thread_local.",
+      "auto_growth, thread_local or cuda_malloc_async.",
       FLAGS_allocator_strategy));
 }
 
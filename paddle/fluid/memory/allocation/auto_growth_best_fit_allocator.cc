@@ -15,7 +15,10 @@
 #include "paddle/fluid/memory/allocation/auto_growth_best_fit_allocator.h"
 
 #include <algorithm>
+#include <chrono>  // NOLINT
+#include <ctime>
 #include <mutex>  // NOLINT
+#include <set>
 #include "paddle/fluid/memory/allocation/aligned_allocator.h"
 #include "paddle/fluid/platform/flags.h"
 
@@ -26,6 +29,22 @@ PADDLE_DEFINE_EXPORTED_READONLY_bool(
     "allocation request. If true, no allocation would be cached. This "
     "flag only works when FLAGS_allocator_strategy=auto_growth.");
 
+PADDLE_DEFINE_EXPORTED_READONLY_bool(
+    auto_growth_thread_local_cache, false,
+    "Whether to cache freed blocks in a per-thread free list bucketed by "
+    "size, so most allocations are satisfied without taking the shared "
+    "allocator lock. The cache is flushed back to the shared free-block "
+    "map once it exceeds its per-thread budget. This flag only works "
+    "when FLAGS_allocator_strategy=auto_growth.");
+
+PADDLE_DEFINE_EXPORTED_int64(
+    auto_growth_defrag_interval_ms, 0,
+    "Interval in milliseconds of the background compaction service, which "
+    "returns fully idle chunks to the underlying allocator without "
+    "stalling allocating threads. Not positive means the service is "
+    "disabled. This flag only works when "
+    "FLAGS_allocator_strategy=auto_growth.");
+
 PADDLE_DEFINE_EXPORTED_READONLY_bool(
     free_when_no_cache_hit, false,
     "Whether to free idle chunks when no cache hit. If true, idle "
@@ -37,18 +56,159 @@ namespace paddle {
 namespace memory {
 namespace allocation {
 
+namespace {
+
+// Registry of currently alive allocators. The thread-exit flush below and
+// the allocator destructor synchronize through it, so a thread dying after
+// its allocator (or the other way round) never touches freed state. Leaked
+// on purpose: exiting threads may outlive static destruction.
+struct LiveAllocatorRegistry {
+  std::mutex mutex_;
+  std::set<const AutoGrowthBestFitAllocator *> live_;
+};
+
+LiveAllocatorRegistry &GetLiveAllocatorRegistry() {
+  static LiveAllocatorRegistry *registry = new LiveAllocatorRegistry;
+  return *registry;
+}
+
+// Per-thread cache of freed blocks bucketed by their aligned size. Cached
+// blocks stay marked in-use in the owning allocator, so the shared
+// free-block map is untouched until the cache is flushed — over budget or,
+// at the latest, when the thread exits and the cache destructor returns the
+// blocks to the owner.
+struct ThreadLocalBlockCache {
+  static constexpr size_t kBudget = size_t(16) << 20;  // 16 MiB per thread
+
+  AutoGrowthBestFitAllocator *owner_{nullptr};
+  std::map<size_t, std::vector<Allocation *>> buckets_;
+  size_t total_bytes_{0};
+
+  ~ThreadLocalBlockCache() {
+    if (total_bytes_ > 0) {
+      AutoGrowthBestFitAllocator::ReturnCachedBlocksOnThreadExit(owner_,
+                                                                 &buckets_);
+    }
+  }
+};
+
+ThreadLocalBlockCache &GetThreadLocalBlockCache(
+    AutoGrowthBestFitAllocator *allocator) {
+  static thread_local std::map<const void *, ThreadLocalBlockCache> caches;
+  auto &cache = caches[allocator];
+  cache.owner_ = allocator;
+  return cache;
+}
+
+}  // namespace
+
 AutoGrowthBestFitAllocator::AutoGrowthBestFitAllocator(
     const std::shared_ptr<Allocator> &underlying_allocator, size_t alignment,
     size_t chunk_size, bool allow_free_idle_chunk)
     : underlying_allocator_(underlying_allocator),
       alignment_(alignment),
       chunk_size_(std::max(AlignedSize(chunk_size, alignment), alignment)),
-      allow_free_idle_chunk_(allow_free_idle_chunk) {}
+      allow_free_idle_chunk_(allow_free_idle_chunk) {
+  {
+    auto &registry = GetLiveAllocatorRegistry();
+    std::lock_guard<std::mutex> guard(registry.mutex_);
+    registry.live_.insert(this);
+  }
+  if (FLAGS_auto_growth_defrag_interval_ms > 0 && allow_free_idle_chunk_) {
+    defrag_thread_ = std::thread(&AutoGrowthBestFitAllocator::DefragLoop, this,
+                                 FLAGS_auto_growth_defrag_interval_ms);
+  }
+}
+
+AutoGrowthBestFitAllocator::~AutoGrowthBestFitAllocator() {
+  {
+    // Unregister first: a thread exiting from here on sees the allocator as
+    // dead and only reclaims its cached wrappers.
+    auto &registry = GetLiveAllocatorRegistry();
+    std::lock_guard<std::mutex> guard(registry.mutex_);
+    registry.live_.erase(this);
+  }
+  if (defrag_thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> guard(defrag_mutex_);
+      defrag_stopped_ = true;
+    }
+    defrag_cv_.notify_all();
+    defrag_thread_.join();
+  }
+}
+
+void AutoGrowthBestFitAllocator::TriggerDefrag() {
+  {
+    std::lock_guard<std::mutex> guard(defrag_mutex_);
+    defrag_requested_ = true;
+  }
+  defrag_cv_.notify_all();
+}
+
+void AutoGrowthBestFitAllocator::DefragLoop(int64_t interval_ms) {
+  std::unique_lock<std::mutex> lock(defrag_mutex_);
+  while (!defrag_stopped_) {
+    defrag_cv_.wait_for(lock, std::chrono::milliseconds(interval_ms), [this] {
+      return defrag_stopped_ || defrag_requested_;
+    });
+    if (defrag_stopped_) {
+      break;
+    }
+    defrag_requested_ = false;
+    lock.unlock();
+    DefragmentOnce();
+    lock.lock();
+  }
+}
+
+uint64_t AutoGrowthBestFitAllocator::DefragmentOnce() {
+  // Adjacent free blocks are already merged eagerly in FreeBlockLocked, so
+  // compaction only has to hand fully idle chunks back to the driver.
+  std::list<Chunk> idle_chunks;
+  {
+    std::lock_guard<SpinLock> guard(spinlock_);
+    for (auto chunk_it = chunks_.begin(); chunk_it != chunks_.end();) {
+      auto &blocks = chunk_it->blocks_;
+      auto next_it = std::next(chunk_it);
+      if (blocks.size() == 1 && blocks.begin()->is_free_) {
+        auto &block = *blocks.begin();
+        free_blocks_.erase(std::make_pair(block.size_, block.ptr_));
+        idle_chunks.splice(idle_chunks.end(), chunks_, chunk_it);
+      }
+      chunk_it = next_it;
+    }
+  }
+  uint64_t bytes = 0;
+  for (auto &chunk : idle_chunks) {
+    bytes += chunk.allocation_->size();
+  }
+  // The underlying free (e.g. cudaFree) runs here, outside spinlock_.
+  idle_chunks.clear();
+  if (bytes > 0) {
+    defragged_bytes_ += bytes;
+    VLOG(2) << "Defragmented " << bytes << " bytes, " << defragged_bytes_
+            << " bytes in total";
+  }
+  return bytes;
+}
 
 Allocation *AutoGrowthBestFitAllocator::AllocateImpl(size_t unaligned_size) {
   size_t size = AlignedSize(unaligned_size, alignment_);
   VLOG(10) << "Allocate " << unaligned_size << " bytes, aligned to " << size;
 
+  if (FLAGS_auto_growth_thread_local_cache) {
+    auto &cache = GetThreadLocalBlockCache(this);
+    auto bucket_it = cache.buckets_.find(size);
+    if (bucket_it != cache.buckets_.end() && !bucket_it->second.empty()) {
+      auto *cached = bucket_it->second.back();
+      bucket_it->second.pop_back();
+      cache.total_bytes_ -= size;
+      VLOG(10) << "Allocate " << size << " bytes from thread-local cache";
+      return cached;
+    }
+  }
+
   std::lock_guard<SpinLock> guard(spinlock_);
   auto iter = free_blocks_.lower_bound(std::make_pair(size, nullptr));
   BlockIt block_it;
@@ -81,10 +241,21 @@ Allocation *AutoGrowthBestFitAllocator::AllocateImpl(size_t unaligned_size) {
       chunks_.emplace_back(underlying_allocator_->Allocate(realloc_size));
     } catch (BadAlloc &ex) {
       if (FLAGS_free_when_no_cache_hit) throw ex;
-      FreeIdleChunks();
+      uint64_t freed_bytes = FreeIdleChunks();
+      ++retry_count_;
+      AppendEventLocked("retry: request of " + std::to_string(size) +
+                        " bytes failed, freed " + std::to_string(freed_bytes) +
+                        " idle bytes and retried");
       chunks_.emplace_back(underlying_allocator_->Allocate(realloc_size));
     }
 
+    ++growth_count_;
+    AppendEventLocked("grow: chunk of " +
+                      std::to_string(chunks_.rbegin()->allocation_->size()) +
+                      " bytes (" + std::to_string(chunks_.size()) +
+                      " chunks now) for a request of " + std::to_string(size) +
+                      " bytes");
+
     auto *chunk = &(*chunks_.rbegin());
     realloc_size = chunk->allocation_->size();
     uint8_t *p = reinterpret_cast<uint8_t *>(chunk->allocation_->ptr());
@@ -100,15 +271,73 @@ Allocation *AutoGrowthBestFitAllocator::AllocateImpl(size_t unaligned_size) {
     VLOG(2) << "Not found and reallocate " << realloc_size << "("
             << static_cast<void *>(p) << "), and remaining " << remaining_size;
   }
+  current_bytes_ += size;
+  if (current_bytes_ > peak_bytes_) {
+    peak_bytes_ = current_bytes_;
+  }
   return new BlockAllocation(block_it);
 }
 
 void AutoGrowthBestFitAllocator::FreeImpl(Allocation *allocation) {
   VLOG(10) << "Free " << allocation->size() << " bytes";
+  if (FLAGS_auto_growth_thread_local_cache && !FLAGS_free_idle_chunk) {
+    auto &cache = GetThreadLocalBlockCache(this);
+    size_t size = allocation->size();
+    cache.buckets_[size].push_back(allocation);
+    cache.total_bytes_ += size;
+    if (cache.total_bytes_ > ThreadLocalBlockCache::kBudget) {
+      // Over budget: give everything back to the shared structure so the
+      // blocks can merge and serve other threads.
+      std::lock_guard<SpinLock> guard(spinlock_);
+      for (auto &bucket : cache.buckets_) {
+        for (auto *cached : bucket.second) {
+          FreeBlockLocked(cached);
+        }
+      }
+      cache.buckets_.clear();
+      cache.total_bytes_ = 0;
+    }
+    return;
+  }
   std::lock_guard<SpinLock> guard(spinlock_);
+  FreeBlockLocked(allocation);
+
+  if (FLAGS_free_idle_chunk) {
+    FreeIdleChunks();
+  }
+}
+
+void AutoGrowthBestFitAllocator::ReturnCachedBlocksOnThreadExit(
+    AutoGrowthBestFitAllocator *allocator,
+    std::map<size_t, std::vector<Allocation *>> *buckets) {
+  auto &registry = GetLiveAllocatorRegistry();
+  // Holding the registry mutex across the flush keeps the allocator alive
+  // for its duration: the destructor unregisters under the same mutex.
+  std::lock_guard<std::mutex> registry_guard(registry.mutex_);
+  if (registry.live_.count(allocator) == 0) {
+    // The allocator died first and took its chunks with it; the wrappers
+    // are all that is left to reclaim.
+    for (auto &bucket : *buckets) {
+      for (auto *cached : bucket.second) {
+        delete cached;
+      }
+    }
+    return;
+  }
+  std::lock_guard<SpinLock> guard(allocator->spinlock_);
+  for (auto &bucket : *buckets) {
+    for (auto *cached : bucket.second) {
+      allocator->FreeBlockLocked(cached);
+    }
+  }
+}
+
+void AutoGrowthBestFitAllocator::FreeBlockLocked(Allocation *allocation) {
   auto block_it = static_cast<BlockAllocation *>(allocation)->block_it_;
   auto &blocks = block_it->chunk_->blocks_;
 
+  current_bytes_ -= block_it->size_;
+
   block_it->is_free_ = true;
 
   if (block_it != blocks.begin()) {
@@ -136,12 +365,47 @@ void AutoGrowthBestFitAllocator::FreeImpl(Allocation *allocation) {
                        block_it);
 
   delete allocation;
+}
 
-  if (FLAGS_free_idle_chunk) {
-    FreeIdleChunks();
+void AutoGrowthBestFitAllocator::AppendEventLocked(const std::string &event) {
+  constexpr size_t kMaxEvents = 64;
+  event_log_.push_back(std::to_string(static_cast<int64_t>(time(nullptr))) +
+                       " " + event);
+  if (event_log_.size() > kMaxEvents) {
+    event_log_.pop_front();
   }
 }
 
+void AutoGrowthBestFitAllocator::GetStats(AllocatorStats *stats) {
+  std::lock_guard<SpinLock> guard(spinlock_);
+  stats->current_usage = current_bytes_;
+  stats->peak_usage = peak_bytes_;
+  stats->chunk_count = chunks_.size();
+  stats->chunk_bytes = 0;
+  for (auto &chunk : chunks_) {
+    stats->chunk_bytes += chunk.allocation_->size();
+  }
+  stats->free_block_count = free_blocks_.size();
+  stats->free_block_bytes = 0;
+  stats->free_block_histogram.assign(8 * sizeof(size_t), 0);
+  for (auto &pair : free_blocks_) {
+    size_t block_size = pair.first.first;
+    stats->free_block_bytes += block_size;
+    size_t bucket = 0;
+    while ((block_size >> (bucket + 1)) != 0) {
+      ++bucket;
+    }
+    ++stats->free_block_histogram[bucket];
+  }
+  stats->growth_count = growth_count_;
+  stats->retry_count = retry_count_;
+}
+
+std::vector<std::string> AutoGrowthBestFitAllocator::EventLog() {
+  std::lock_guard<SpinLock> guard(spinlock_);
+  return std::vector<std::string>(event_log_.begin(), event_log_.end());
+}
+
 uint64_t AutoGrowthBestFitAllocator::FreeIdleChunks() {
   if (!allow_free_idle_chunk_) {
     return 0;
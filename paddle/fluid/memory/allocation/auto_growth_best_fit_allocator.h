@@ -14,13 +14,20 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <deque>
 #include <list>
 #include <map>
 #include <memory>
 #include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
 #include <utility>
+#include <vector>
 
 #include "paddle/fluid/memory/allocation/allocator.h"
+#include "paddle/fluid/memory/allocation/allocator_stats.h"
 #include "paddle/fluid/memory/allocation/spin_lock.h"
 
 namespace paddle {
@@ -33,8 +40,35 @@ class AutoGrowthBestFitAllocator : public Allocator {
       const std::shared_ptr<Allocator> &underlying_allocator, size_t alignment,
       size_t chunk_size = 0, bool allow_free_idle_chunk = true);
 
+  ~AutoGrowthBestFitAllocator();
+
   bool IsAllocThreadSafe() const override { return true; }
 
+  // Wake the background compaction thread for one extra pass. No-op when
+  // FLAGS_auto_growth_defrag_interval_ms is not positive.
+  void TriggerDefrag();
+
+  // Total bytes the compaction service has returned to the underlying
+  // allocator so far.
+  uint64_t DefraggedBytes() const { return defragged_bytes_; }
+
+  // Fill a telemetry snapshot of the pool: usage, chunk and free-block
+  // accounting plus the growth/retry counters.
+  void GetStats(AllocatorStats *stats);
+
+  // Copy of the bounded event log recording chunk growth and
+  // failed-then-retried allocations, oldest entry first.
+  std::vector<std::string> EventLog();
+
+  // Called from the per-thread block cache destructor when a thread exits
+  // with cached blocks. Returns them to the shared free-block map if the
+  // allocator is still alive, otherwise only reclaims the wrappers; the
+  // live-allocator registry makes this safe against the allocator being
+  // destroyed before (or concurrently with) the exiting thread.
+  static void ReturnCachedBlocksOnThreadExit(
+      AutoGrowthBestFitAllocator *allocator,
+      std::map<size_t, std::vector<Allocation *>> *buckets);
+
  protected:
   Allocation *AllocateImpl(size_t size) override;
 
@@ -81,6 +115,21 @@ class AutoGrowthBestFitAllocator : public Allocator {
 
   using BlockIt = List<Block>::iterator;
 
+  // Returns the freed block to the shared free-block map, merging with its
+  // free neighbours. The caller must hold spinlock_.
+  void FreeBlockLocked(Allocation *allocation);
+
+  // Append an entry to the bounded event log. The caller must hold
+  // spinlock_.
+  void AppendEventLocked(const std::string &event);
+
+  // One compaction pass: detach fully idle chunks under spinlock_, then
+  // return them to the underlying allocator with the lock released so
+  // allocations are never stalled behind a (possibly slow) device free.
+  uint64_t DefragmentOnce();
+
+  void DefragLoop(int64_t interval_ms);
+
   std::shared_ptr<Allocator> underlying_allocator_;
   std::map<std::pair<size_t, void *>, BlockIt> free_blocks_;
   std::list<Chunk> chunks_;
@@ -89,6 +138,24 @@ class AutoGrowthBestFitAllocator : public Allocator {
   bool allow_free_idle_chunk_;
 
   SpinLock spinlock_;
+
+  // Telemetry, all guarded by spinlock_. Blocks parked in the thread-local
+  // cache still count as in use, they are only given back in
+  // FreeBlockLocked.
+  uint64_t current_bytes_{0};
+  uint64_t peak_bytes_{0};
+  uint64_t growth_count_{0};
+  uint64_t retry_count_{0};
+  std::deque<std::string> event_log_;
+
+  // Background compaction service, only started when
+  // FLAGS_auto_growth_defrag_interval_ms > 0.
+  std::thread defrag_thread_;
+  std::mutex defrag_mutex_;
+  std::condition_variable defrag_cv_;
+  bool defrag_requested_{false};
+  bool defrag_stopped_{false};
+  std::atomic<uint64_t> defragged_bytes_{0};
 };
 
 }  // namespace allocation
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <cstdlib>
+#include <thread>  // NOLINT
 
 #include "paddle/fluid/memory/allocation/aligned_allocator.h"
 #include "paddle/fluid/memory/allocation/auto_growth_best_fit_allocator.h"
@@ -21,6 +22,7 @@
 
 DECLARE_bool(free_idle_chunk);
 DECLARE_bool(free_when_no_cache_hit);
+DECLARE_bool(auto_growth_thread_local_cache);
 
 namespace paddle {
 namespace memory {
@@ -171,6 +173,37 @@ TEST(test_auto_growth_allocator, test_free_when_no_cache_hit) {
   TestFreeWhenNoCacheHit(true);
 }
 
+TEST(test_auto_growth_allocator, test_thread_cache_flush_on_thread_exit) {
+  FLAGS_free_idle_chunk = false;
+  FLAGS_free_when_no_cache_hit = false;
+  FLAGS_auto_growth_thread_local_cache = true;
+
+  auto recorded_allocator = std::make_shared<RecordedAllocator>();
+  size_t alignment = 4096;
+  size_t memory_size = 8192;
+  auto underlying_allocator =
+      std::make_shared<AlignedAllocator>(recorded_allocator, alignment);
+  auto ag_allocator = std::make_shared<AutoGrowthBestFitAllocator>(
+      underlying_allocator, alignment);
+
+  std::thread worker([&] {
+    // Freed into the worker's thread-local cache, not the shared free map.
+    auto allocation = ag_allocator->Allocate(memory_size);
+    allocation.reset();
+  });
+  worker.join();
+
+  // The exiting worker must have flushed its cache back, so this request is
+  // served from the shared free-block map instead of growing a new chunk.
+  auto allocation = ag_allocator->Allocate(memory_size);
+  ASSERT_EQ(recorded_allocator->AllocatedSize(), memory_size + alignment);
+
+  // Free through the locked path so nothing stays cached on the main thread
+  // past the allocator's lifetime.
+  FLAGS_auto_growth_thread_local_cache = false;
+  allocation.reset();
+}
+
 }  // namespace allocation
 }  // namespace memory
 }  // namespace paddle
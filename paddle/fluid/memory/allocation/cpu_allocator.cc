@@ -15,13 +15,32 @@
 #include "paddle/fluid/memory/allocation/cpu_allocator.h"
 
 #include <stdlib.h>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 
 #include "paddle/fluid/platform/enforce.h"
+#include "paddle/fluid/platform/flags.h"
+
+PADDLE_DEFINE_EXPORTED_READONLY_bool(
+    use_numa_aware_cpu_allocator, false,
+    "Whether to back each CPU allocation by fresh anonymous pages instead "
+    "of the process heap. Fresh pages are physically placed by the "
+    "kernel's first-touch policy, i.e. on the NUMA node of the thread "
+    "that first writes them, so workers pinned to a node keep their "
+    "tensor traffic node-local. Only effective on Linux.");
 
 namespace paddle {
 namespace memory {
 namespace allocation {
 
+#ifdef __linux__
+static size_t RoundedMapSize(size_t size) {
+  return (size + CPUAllocator::kAlignment - 1) &
+         ~(CPUAllocator::kAlignment - 1);
+}
+#endif
+
 bool CPUAllocator::IsAllocThreadSafe() const { return true; }
 
 void CPUAllocator::FreeImpl(Allocation *allocation) {
@@ -29,6 +48,13 @@ void CPUAllocator::FreeImpl(Allocation *allocation) {
 #ifdef _WIN32
   _aligned_free(p);
 #else
+#ifdef __linux__
+  if (FLAGS_use_numa_aware_cpu_allocator) {
+    munmap(p, RoundedMapSize(allocation->size()));
+    delete allocation;
+    return;
+  }
+#endif
   free(p);
 #endif
   delete allocation;
@@ -39,6 +65,22 @@ Allocation *CPUAllocator::AllocateImpl(size_t size) {
 #ifdef _WIN32
   p = _aligned_malloc(size, kAlignment);
 #else
+#ifdef __linux__
+  if (FLAGS_use_numa_aware_cpu_allocator) {
+    // The heap recycles pages that may already be resident on another NUMA
+    // node. A private anonymous mapping is not physically allocated until
+    // first touch, which the kernel serves from the touching thread's node,
+    // so the consumer of this allocation determines its placement. mmap
+    // returns page-aligned memory, which satisfies kAlignment.
+    p = mmap(nullptr, RoundedMapSize(size), PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    PADDLE_ENFORCE_NE(
+        p, MAP_FAILED,
+        platform::errors::ResourceExhausted(
+            "Fail to mmap memory of %ld size, error code is %d.", size, errno));
+    return new Allocation(p, size, platform::CPUPlace());
+  }
+#endif
   int error = posix_memalign(&p, kAlignment, size);
   PADDLE_ENFORCE_EQ(
       error, 0,
@@ -0,0 +1,120 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/memory/allocation/cuda_malloc_async_allocator.h"
+
+#ifdef PADDLE_WITH_CUDA
+#include <cuda.h>
+#include <cuda_runtime.h>
+#endif
+
+#include <string>
+#include "paddle/fluid/platform/cuda_device_guard.h"
+#include "paddle/fluid/platform/enforce.h"
+#include "paddle/fluid/platform/gpu_info.h"
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+#if defined(PADDLE_WITH_CUDA) && CUDA_VERSION >= 11020
+
+CUDAMallocAsyncAllocator::CUDAMallocAsyncAllocator(
+    const platform::CUDAPlace& place)
+    : place_(place) {
+  platform::CUDADeviceGuard guard(place_.device);
+  int supported = 0;
+  PADDLE_ENFORCE_CUDA_SUCCESS(cudaDeviceGetAttribute(
+      &supported, cudaDevAttrMemoryPoolsSupported, place_.device));
+  PADDLE_ENFORCE_EQ(
+      supported, 1,
+      platform::errors::Unavailable(
+          "GPU %d does not support the stream-ordered memory pool "
+          "(cudaMallocAsync). Please use another allocator strategy, e.g. "
+          "`export FLAGS_allocator_strategy=auto_growth`.",
+          place_.device));
+}
+
+bool CUDAMallocAsyncAllocator::IsAllocThreadSafe() const { return true; }
+
+void CUDAMallocAsyncAllocator::FreeImpl(Allocation* allocation) {
+  PADDLE_ENFORCE_EQ(
+      BOOST_GET_CONST(platform::CUDAPlace, allocation->place()), place_,
+      platform::errors::PermissionDenied(
+          "GPU memory is freed in incorrect device. This may be a bug"));
+  platform::CUDADeviceGuard guard(place_.device);
+  // Freeing is ordered on the default stream, matching AllocateImpl, so the
+  // pool may reuse the block for subsequent allocations without a device
+  // synchronization.
+  PADDLE_ENFORCE_CUDA_SUCCESS(
+      cudaFreeAsync(allocation->ptr(), /*hStream=*/nullptr));
+  delete allocation;
+}
+
+Allocation* CUDAMallocAsyncAllocator::AllocateImpl(size_t size) {
+  std::call_once(once_flag_, [this] { platform::SetDeviceId(place_.device); });
+
+  void* ptr;
+  auto result = cudaMallocAsync(&ptr, size, /*hStream=*/nullptr);
+  if (LIKELY(result == cudaSuccess)) {
+    return new Allocation(ptr, size, platform::Place(place_));
+  }
+  // Reset the error state so later CUDA calls do not observe this failure.
+  cudaGetLastError();
+
+  size_t avail = 0, total = 0;
+  cudaMemGetInfo(&avail, &total);
+  size_t allocated = total - avail;
+
+  PADDLE_THROW_BAD_ALLOC(platform::errors::ResourceExhausted(
+      "\n\nOut of memory error on GPU %d. "
+      "Cannot allocate %s memory on GPU %d, %s memory has been allocated and "
+      "available memory is only %s.\n\n"
+      "Please check whether there is any other process using GPU %d.\n"
+      "1. If yes, please stop them, or start PaddlePaddle on another GPU.\n"
+      "2. If no, please decrease the batch size of your model.\n\n",
+      place_.device, string::HumanReadableSize(size), place_.device,
+      string::HumanReadableSize(allocated), string::HumanReadableSize(avail),
+      place_.device));
+}
+
+#else
+
+CUDAMallocAsyncAllocator::CUDAMallocAsyncAllocator(
+    const platform::CUDAPlace& place)
+    : place_(place) {
+  PADDLE_THROW(platform::errors::Unavailable(
+      "The cuda_malloc_async allocator strategy requires PaddlePaddle to be "
+      "compiled with CUDA >= 11.2."));
+}
+
+bool CUDAMallocAsyncAllocator::IsAllocThreadSafe() const { return true; }
+
+void CUDAMallocAsyncAllocator::FreeImpl(Allocation* allocation) {
+  PADDLE_THROW(platform::errors::Unavailable(
+      "The cuda_malloc_async allocator strategy requires PaddlePaddle to be "
+      "compiled with CUDA >= 11.2."));
+}
+
+Allocation* CUDAMallocAsyncAllocator::AllocateImpl(size_t size) {
+  PADDLE_THROW(platform::errors::Unavailable(
+      "The cuda_malloc_async allocator strategy requires PaddlePaddle to be "
+      "compiled with CUDA >= 11.2."));
+}
+
+#endif
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
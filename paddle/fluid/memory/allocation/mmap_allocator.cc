@@ -19,6 +19,7 @@
 #include <fcntl.h>
 #include <stdlib.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <random>
 #include <string>
 
@@ -84,6 +85,21 @@ std::shared_ptr<MemoryMapWriterAllocation> AllocateMemoryMapWriterAllocation(
   return std::make_shared<MemoryMapWriterAllocation>(ptr, size, ipc_name);
 }
 
+std::shared_ptr<MemoryMapWriterAllocation> RebuildMemoryMapWriterAllocation(
+    const std::string &ipc_name, size_t size) {
+  int fd = shm_open(ipc_name.c_str(), O_RDWR, 0644);
+  PADDLE_ENFORCE_NE(
+      fd, -1, platform::errors::Unavailable("File descriptor %s open failed",
+                                            ipc_name.c_str()));
+
+  void *ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  PADDLE_ENFORCE_NE(ptr, MAP_FAILED,
+                    platform::errors::Unavailable(
+                        "Memory map failed when rebuild shared memory."));
+  close(fd);
+  return std::make_shared<MemoryMapWriterAllocation>(ptr, size, ipc_name);
+}
+
 std::shared_ptr<MemoryMapReaderAllocation> RebuildMemoryMapReaderAllocation(
     const std::string &ipc_name, size_t size) {
   int fd = shm_open(ipc_name.c_str(), O_RDONLY, 0644);
@@ -99,6 +115,39 @@ std::shared_ptr<MemoryMapReaderAllocation> RebuildMemoryMapReaderAllocation(
   return std::make_shared<MemoryMapReaderAllocation>(ptr, size, ipc_name);
 }
 
+MemoryMapFileAllocation::~MemoryMapFileAllocation() {
+  PADDLE_ENFORCE_NE(
+      munmap(this->ptr(), this->size()), -1,
+      platform::errors::Unavailable("could not unmap the file %s",
+                                    this->file_name()));
+  VLOG(3) << "~MemoryMapFileAllocation: " << this->file_name();
+}
+
+std::shared_ptr<MemoryMapFileAllocation> AllocateMemoryMapFileAllocation(
+    const std::string &file_name) {
+  int fd = open(file_name.c_str(), O_RDONLY);
+  PADDLE_ENFORCE_NE(
+      fd, -1, platform::errors::Unavailable("File descriptor %s open failed",
+                                            file_name.c_str()));
+  struct stat file_stat;
+  PADDLE_ENFORCE_EQ(
+      fstat(fd, &file_stat), 0,
+      platform::errors::Unavailable("Could not stat the file %s", file_name));
+  size_t size = static_cast<size_t>(file_stat.st_size);
+  PADDLE_ENFORCE_GT(size, 0,
+                    platform::errors::Unavailable(
+                        "The file %s to be mapped is empty.", file_name));
+
+  void *ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  PADDLE_ENFORCE_NE(
+      ptr, MAP_FAILED,
+      platform::errors::Unavailable("Memory map failed for file %s",
+                                    file_name));
+  close(fd);
+
+  return std::make_shared<MemoryMapFileAllocation>(ptr, size, file_name);
+}
+
 MemoryMapFdSet &MemoryMapFdSet::Instance() {  // NOLINT
   static MemoryMapFdSet set;
   return set;
@@ -61,9 +61,55 @@ class MemoryMapReaderAllocation : public Allocation {
 std::shared_ptr<MemoryMapWriterAllocation> AllocateMemoryMapWriterAllocation(
     size_t size);
 
+// Map an existing shared memory file for read-write access. Unlike the
+// reader variant below, destruction only unmaps and never unlinks the
+// file, so the segment can be remapped and recycled by other processes.
+std::shared_ptr<MemoryMapWriterAllocation> RebuildMemoryMapWriterAllocation(
+    const std::string &ipc_name, size_t size);
+
 std::shared_ptr<MemoryMapReaderAllocation> RebuildMemoryMapReaderAllocation(
     const std::string &ipc_name, size_t size);
 
+// A private (copy-on-write) mapping of a regular on-disk file, e.g. a
+// combined parameter file written by the save_combine operator. The pages
+// stay backed by the kernel page cache until they are written, so several
+// processes mapping the same file share one physical copy of the data.
+class MemoryMapFileAllocation : public Allocation {
+ public:
+  explicit MemoryMapFileAllocation(void *ptr, size_t size,
+                                   std::string file_name)
+      : Allocation(ptr, size, platform::CPUPlace()),
+        file_name_(std::move(file_name)) {}
+
+  inline const std::string &file_name() const { return file_name_; }
+
+  ~MemoryMapFileAllocation() override;
+
+ private:
+  std::string file_name_;
+};
+
+// A view over a slice of a MemoryMapFileAllocation. It lets a tensor hold
+// its payload inside the mapped file directly, and keeps the whole mapping
+// alive for as long as any such tensor references it.
+class MemoryMapSliceAllocation : public Allocation {
+ public:
+  MemoryMapSliceAllocation(std::shared_ptr<MemoryMapFileAllocation> mapped,
+                           size_t offset, size_t size)
+      : Allocation(static_cast<char *>(mapped->ptr()) + offset, size,
+                   platform::CPUPlace()),
+        mapped_(std::move(mapped)) {}
+
+ private:
+  std::shared_ptr<MemoryMapFileAllocation> mapped_;
+};
+
+// Map an existing regular file copy-on-write. The mapping is readable and
+// writable, but writes stay private to the calling process and are never
+// flushed back to the file.
+std::shared_ptr<MemoryMapFileAllocation> AllocateMemoryMapFileAllocation(
+    const std::string &file_name);
+
 class MemoryMapFdSet {
  public:
   static MemoryMapFdSet &Instance();  // NOLINT
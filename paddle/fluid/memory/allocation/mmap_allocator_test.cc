@@ -16,6 +16,9 @@
 
 #include "paddle/fluid/memory/allocation/mmap_allocator.h"
 
+#include <cstdio>
+#include <fstream>
+
 #include "gtest/gtest.h"
 
 namespace paddle {
@@ -45,6 +48,37 @@ TEST(MemoryMapAllocation, test_allocation_base) {
   }
 }
 
+TEST(MemoryMapAllocation, test_file_allocation_copy_on_write) {
+  std::string file_name = "./mmap_file_allocation_test.bin";
+  // 1. write a file
+  {
+    std::ofstream fout(file_name, std::ios::binary);
+    for (int32_t i = 0; i < 1024; ++i) {
+      fout.write(reinterpret_cast<const char*>(&i), sizeof(i));
+    }
+  }
+  // 2. map it and check the content
+  {
+    auto mmap_file_holder = AllocateMemoryMapFileAllocation(file_name);
+    ASSERT_EQ(mmap_file_holder->size(), 1024 * sizeof(int32_t));
+    auto* ptr = static_cast<int32_t*>(mmap_file_holder->ptr());
+    for (int32_t i = 0; i < 1024; ++i) {
+      ASSERT_EQ(ptr[i], i);
+    }
+    // 3. writes stay private to the mapping
+    ptr[0] = -1;
+    ASSERT_EQ(ptr[0], -1);
+  }
+  // 4. the file itself is unchanged
+  {
+    std::ifstream fin(file_name, std::ios::binary);
+    int32_t first = 0;
+    fin.read(reinterpret_cast<char*>(&first), sizeof(first));
+    ASSERT_EQ(first, 0);
+  }
+  std::remove(file_name.c_str());
+}
+
 }  // namespace allocation
 }  // namespace memory
 }  // namespace paddle
@@ -14,23 +14,179 @@ limitations under the License. */
 
 #include "paddle/fluid/memory/memcpy.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <functional>
+#include <mutex>  // NOLINT
+#include <queue>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "paddle/fluid/platform/cpu_info.h"
 #include "paddle/fluid/platform/device_context.h"
 #include "paddle/fluid/platform/enforce.h"
+#include "paddle/fluid/platform/flags.h"
 #include "paddle/fluid/platform/profiler.h"
 
 #ifdef PADDLE_WITH_XPU
 #include "paddle/fluid/platform/xpu/xpu_header.h"
 #endif
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+PADDLE_DEFINE_EXPORTED_int64(
+    parallel_memcpy_min_bytes, 0,
+    "Host to host copies of at least this many bytes are split across a "
+    "small internal thread pool, so feed/fetch of large batches scales "
+    "with memory bandwidth instead of one core. Not positive disables "
+    "parallel copies.");
+
 namespace paddle {
 namespace memory {
 
+namespace {
+
+// Every worker copies at least this much, so small copies are not
+// shredded into cache-unfriendly slivers.
+constexpr size_t kMinBytesPerCopyThread = size_t(8) << 20;
+// Above this size streaming stores are used: such copies do not fit in
+// the last level cache anyway, so bypassing it keeps the working set of
+// the computation resident.
+constexpr size_t kNonTemporalCopyBytes = size_t(64) << 20;
+
+void CopyChunk(uint8_t* dst, const uint8_t* src, size_t num,
+               bool non_temporal) {
+#ifdef __SSE2__
+  if (non_temporal) {
+    size_t head = (16 - reinterpret_cast<uintptr_t>(dst) % 16) % 16;
+    head = std::min(head, num);
+    std::memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    num -= head;
+    size_t vec = num / 64 * 64;
+    for (size_t i = 0; i < vec; i += 64) {
+      __m128i v0 =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+      __m128i v1 =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 16));
+      __m128i v2 =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 32));
+      __m128i v3 =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 48));
+      _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i), v0);
+      _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 16), v1);
+      _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 32), v2);
+      _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 48), v3);
+    }
+    _mm_sfence();
+    std::memcpy(dst + vec, src + vec, num - vec);
+    return;
+  }
+#endif
+  std::memcpy(dst, src, num);
+}
+
+// Minimal fork-join pool dedicated to host copies. memory/ sits below the
+// executor layers, so it cannot reuse their work queues; a handful of
+// lazily started threads is enough to saturate memory bandwidth.
+class CopyThreadPool {
+ public:
+  static CopyThreadPool& Instance() {
+    static CopyThreadPool pool;
+    return pool;
+  }
+
+  size_t NumThreads() const { return threads_.size(); }
+
+  void ParallelFor(size_t n, const std::function<void(size_t)>& fn) {
+    std::atomic<size_t> remaining(n - 1);
+    std::mutex done_mutex;
+    std::condition_variable done_cv;
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      for (size_t i = 1; i < n; ++i) {
+        tasks_.push([&, i] {
+          fn(i);
+          if (remaining.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> done_guard(done_mutex);
+            done_cv.notify_one();
+          }
+        });
+      }
+    }
+    cv_.notify_all();
+    fn(0);
+    std::unique_lock<std::mutex> done_lock(done_mutex);
+    done_cv.wait(done_lock, [&] { return remaining.load() == 0; });
+  }
+
+ private:
+  CopyThreadPool() {
+    size_t num_threads = std::min<size_t>(
+        8, std::max<size_t>(2, platform::CpuAvailableCoreCount() / 2));
+    for (size_t i = 0; i < num_threads; ++i) {
+      threads_.emplace_back([this] { WorkerLoop(); });
+      threads_.back().detach();
+    }
+  }
+
+  void WorkerLoop() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return !tasks_.empty(); });
+        task = std::move(tasks_.front());
+        tasks_.pop();
+      }
+      task();
+    }
+  }
+
+  std::vector<std::thread> threads_;
+  std::queue<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+void ParallelCopy(void* dst, const void* src, size_t num) {
+  auto& pool = CopyThreadPool::Instance();
+  size_t num_parts = std::min(pool.NumThreads() + 1,
+                              std::max<size_t>(1, num / kMinBytesPerCopyThread));
+  bool non_temporal = num >= kNonTemporalCopyBytes;
+  if (num_parts <= 1) {
+    CopyChunk(static_cast<uint8_t*>(dst), static_cast<const uint8_t*>(src),
+              num, non_temporal);
+    return;
+  }
+  // 64-byte part boundaries keep the streaming loop on cache lines.
+  size_t part_size = (num / num_parts + 63) / 64 * 64;
+  pool.ParallelFor(num_parts, [&](size_t part) {
+    size_t offset = part * part_size;
+    if (offset >= num) return;
+    size_t bytes = std::min(part_size, num - offset);
+    CopyChunk(static_cast<uint8_t*>(dst) + offset,
+              static_cast<const uint8_t*>(src) + offset, bytes, non_temporal);
+  });
+}
+
+}  // namespace
+
 template <>
 void Copy<platform::CPUPlace, platform::CPUPlace>(platform::CPUPlace, void* dst,
                                                   platform::CPUPlace,
                                                   const void* src, size_t num) {
   if (UNLIKELY(num == 0)) return;
   VLOG(4) << "src: " << src << ", dst: " << dst << ", num: " << num;
+  if (FLAGS_parallel_memcpy_min_bytes > 0 &&
+      num >= static_cast<size_t>(FLAGS_parallel_memcpy_min_bytes)) {
+    ParallelCopy(dst, src, num);
+    return;
+  }
   std::memcpy(dst, src, num);
 }
 
@@ -24,6 +24,7 @@ limitations under the License. */
 namespace cub = hipcub;
 #endif
 #include "paddle/fluid/framework/op_registry.h"
+#include "paddle/fluid/memory/malloc.h"
 #include "paddle/fluid/operators/argsort_op.h"
 #include "paddle/fluid/operators/transpose_op.h"
 #include "paddle/fluid/platform/cuda_device_function.h"
@@ -171,18 +172,20 @@ void ArgFullSort(const platform::CUDADeviceContext& ctx, const Tensor* input,
   }
   PADDLE_ENFORCE_CUDA_SUCCESS(err);
 
-  Tensor temp_storage;
-  temp_storage.mutable_data<uint8_t>(ctx.GetPlace(), temp_storage_bytes);
+  // Draw the workspace from the stream-aware device allocator, which keeps
+  // freed blocks cached, so repeated argsorts of the same shape reuse one
+  // allocation instead of growing a fresh temp tensor per call.
+  auto temp_storage = memory::Alloc(ctx, temp_storage_bytes);
 
   if (descending) {
     err = cub::DeviceSegmentedRadixSort::SortPairsDescending(
-        temp_storage.data<uint8_t>(), temp_storage_bytes, inp, sorted_out_ptr,
+        temp_storage->ptr(), temp_storage_bytes, inp, sorted_out_ptr,
         input_indices.data<IndType>(), sorted_indices_ptr, num_cols * num_rows,
         num_rows, segment_offsets_t, segment_offsets_t + 1, 0, sizeof(T) * 8,
         cu_stream);
   } else {
     err = cub::DeviceSegmentedRadixSort::SortPairs(
-        temp_storage.data<uint8_t>(), temp_storage_bytes, inp, sorted_out_ptr,
+        temp_storage->ptr(), temp_storage_bytes, inp, sorted_out_ptr,
         input_indices.data<IndType>(), sorted_indices_ptr, num_cols * num_rows,
         num_rows, segment_offsets_t, segment_offsets_t + 1, 0, sizeof(T) * 8,
         cu_stream);
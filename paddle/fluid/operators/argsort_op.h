@@ -14,6 +14,7 @@ limitations under the License. */
 
 #pragma once
 #include <algorithm>
+#include <numeric>
 #include <utility>
 #include <vector>
 #include "paddle/fluid/framework/eigen.h"
@@ -37,34 +38,27 @@ template <typename T, typename Type>
 static void FullSort(Type input_height, Type input_width, int input_dim,
                      const framework::Tensor* input, T* t_out, Type* t_indices,
                      bool descending) {
+  const T* input_data = input->data<T>();
 #ifdef PADDLE_WITH_MKLML
 #pragma omp parallel for
 #endif
   for (Type i = 0; i < input_height; ++i) {
-    std::vector<std::pair<T, Type>> col_vec;
-    col_vec.reserve(input_width);
-    if (input_dim == 1) {
-      auto e_input = EigenVector<T>::Flatten(*input);
-      for (Type j = 0; j < input_width; ++j) {
-        col_vec.push_back(std::pair<T, Type>(e_input(j), j));
-      }
-    } else {
-      auto e_input = EigenMatrix<T>::Reshape(*input, input_dim - 1);
-      for (Type j = 0; j < input_width; ++j) {
-        col_vec.push_back(std::pair<T, Type>(e_input(i, j), j));
-      }
-    }
-    std::sort(col_vec.begin(), col_vec.end(),
-              [&](const std::pair<T, Type>& l, const std::pair<T, Type>& r) {
-                if (descending)
-                  return l.first > r.first;
-                else
-                  return l.first < r.first;
-              });
+    // Sort an index array over the row values instead of materializing
+    // (value, index) pairs: half the per-element footprint and no copy
+    // pass before the sort.
+    const T* row_data = input_data + i * input_width;
+    std::vector<Type> sorted_idx(input_width);
+    std::iota(sorted_idx.begin(), sorted_idx.end(), static_cast<Type>(0));
+    std::sort(sorted_idx.begin(), sorted_idx.end(), [&](Type l, Type r) {
+      if (descending)
+        return row_data[l] > row_data[r];
+      else
+        return row_data[l] < row_data[r];
+    });
 
     for (Type j = 0; j < input_width; ++j) {
-      t_out[i * input_width + j] = col_vec[j].first;
-      t_indices[i * input_width + j] = col_vec[j].second;
+      t_out[i * input_width + j] = row_data[sorted_idx[j]];
+      t_indices[i * input_width + j] = sorted_idx[j];
     }
   }
 }
@@ -13,11 +13,16 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #include "paddle/fluid/operators/benchmark/op_tester.h"
+#include <cmath>
 #include <fstream>
+#include <iterator>
+#include <numeric>
+#include <set>
 #include "gflags/gflags.h"
 #include "gtest/gtest.h"
 #include "paddle/fluid/framework/op_info.h"
 #include "paddle/fluid/framework/op_registry.h"
+#include "paddle/fluid/framework/program_desc.h"
 #include "paddle/fluid/framework/variable_helper.h"
 #include "paddle/fluid/platform/init.h"
 #include "paddle/fluid/platform/profiler.h"
@@ -30,6 +35,19 @@ namespace benchmark {
 
 DEFINE_string(op_config_list, "", "Path of op config file.");
 DEFINE_int32(specified_config_id, -1, "Test the specified op config.");
+DEFINE_string(extract_op_configs_from, "",
+              "Path of a serialized ProgramDesc whose ops are extracted into "
+              "op configs and benchmarked.");
+DEFINE_string(extracted_config_path, "extracted_op_configs.txt",
+              "Path to write the op configs extracted from a ProgramDesc.");
+DEFINE_string(benchmark_baseline, "",
+              "Path of the baseline latency file used to flag regressions.");
+DEFINE_string(benchmark_output, "",
+              "Path to write the measured latencies, in the baseline file "
+              "format.");
+DEFINE_double(benchmark_threshold, 0.1,
+              "Allowed relative slowdown against the baseline before a "
+              "config is flagged as a regression.");
 
 void OpTester::Init(const std::string &filename) {
   Init(OpTesterConfig(filename));
@@ -72,7 +90,6 @@ void OpTester::Run() {
   // Warm up
   RunImpl();
 
-  platform::Timer timer;
   if (config_.profile) {
     if (platform::is_cpu_place(place_)) {
       platform::EnableProfiler(platform::ProfilerState::kCPU);
@@ -85,24 +102,71 @@ void OpTester::Run() {
           "'CUDAPlace' is not supported in CPU only device."));
 #endif
     }
+  }
 
+  if (config_.max_repeat > config_.repeat) {
+    RunRepeatsUntilStable();
+  } else {
+    platform::Timer timer;
     timer.Start();
     for (int i = config_.repeat; i > 0; --i) {
       RunImpl();
     }
     timer.Pause();
+    config_.runtime = timer.ElapsedMS() / config_.repeat;
+    LOG(INFO) << "=== Run " << config_.repeat
+              << " times, latency: " << config_.runtime << " ms ===";
+  }
+
+  if (config_.profile) {
     platform::DisableProfiler(platform::EventSortingKey::kDefault,
                               "op_tester_profiler");
-  } else {
+  }
+}
+
+void OpTester::RunRepeatsUntilStable() {
+  // Run batches of config_.repeat iterations until the relative standard
+  // error of the batch means drops below kMaxRelativeError, so that short
+  // kernels get enough repeats to give a stable latency while long kernels
+  // are not measured longer than necessary.
+  const double kMaxRelativeError = 0.02;
+  const size_t kMinBatches = 3;
+
+  std::vector<double> batch_ms;
+  int total_repeats = 0;
+  while (total_repeats < config_.max_repeat) {
+    platform::Timer timer;
     timer.Start();
     for (int i = config_.repeat; i > 0; --i) {
       RunImpl();
     }
     timer.Pause();
+    batch_ms.push_back(timer.ElapsedMS() / config_.repeat);
+    total_repeats += config_.repeat;
+
+    if (batch_ms.size() < kMinBatches) {
+      continue;
+    }
+    double mean = std::accumulate(batch_ms.begin(), batch_ms.end(), 0.0) /
+                  batch_ms.size();
+    if (mean <= 0.0) {
+      break;
+    }
+    double variance = 0.0;
+    for (auto ms : batch_ms) {
+      variance += (ms - mean) * (ms - mean);
+    }
+    variance /= (batch_ms.size() - 1);
+    double relative_error = std::sqrt(variance / batch_ms.size()) / mean;
+    if (relative_error < kMaxRelativeError) {
+      break;
+    }
   }
-  config_.runtime = timer.ElapsedMS() / config_.repeat;
-  LOG(INFO) << "=== Run " << config_.repeat
-            << " times, latency: " << config_.runtime << " ms ===";
+
+  config_.runtime = std::accumulate(batch_ms.begin(), batch_ms.end(), 0.0) /
+                    batch_ms.size();
+  LOG(INFO) << "=== Run " << total_repeats << " times in " << batch_ms.size()
+            << " batches, latency: " << config_.runtime << " ms ===";
 }
 
 void OpTester::RunImpl() {
@@ -111,17 +175,6 @@ void OpTester::RunImpl() {
   scope_->DropKids();
 }
 
-std::vector<std::string> OpTester::GetOpProtoInputNames() {
-  std::vector<std::string> input_names;
-  const framework::proto::OpProto &proto =
-      framework::OpInfoMap::Instance().Get(type_).Proto();
-  for (int i = 0; i != proto.inputs_size(); ++i) {
-    const auto &input = proto.inputs(i);
-    input_names.push_back(input.name());
-  }
-  return input_names;
-}
-
 std::vector<std::string> OpTester::GetOpProtoOutputNames() {
   std::vector<std::string> output_names;
   const framework::proto::OpProto &proto =
@@ -170,9 +223,16 @@ framework::proto::VarType::Type OpTester::TransToVarType(std::string str) {
 }
 
 void OpTester::CreateInputVarDesc() {
-  std::vector<std::string> input_names = GetOpProtoInputNames();
-  for (auto &name : input_names) {
+  const framework::proto::OpProto &proto =
+      framework::OpInfoMap::Instance().Get(type_).Proto();
+  for (int i = 0; i != proto.inputs_size(); ++i) {
+    const std::string &name = proto.inputs(i).name();
     const OpInputConfig *input = config_.GetInput(name);
+    if (input == nullptr && proto.inputs(i).dispensable()) {
+      // Dispensable inputs that the config does not provide are left unset,
+      // as they would be in a real program.
+      continue;
+    }
     PADDLE_ENFORCE_NOT_NULL(
         input, platform::errors::NotFound(
                    "The input %s of operator %s is not correctlly provided.",
@@ -205,6 +265,19 @@ void OpTester::CreateOutputVarDesc() {
   }
 }
 
+// Attr values of list types are comma-separated in the config file, e.g.
+//   strides: 2,2
+template <typename T>
+static std::vector<T> ParseValueList(const std::string &value_str) {
+  std::vector<T> values;
+  std::string token;
+  std::istringstream token_stream(value_str);
+  while (std::getline(token_stream, token, ',')) {
+    values.push_back(StringTo<T>(token));
+  }
+  return values;
+}
+
 void OpTester::CreateOpDesc() {
   op_desc_.SetType(config_.op_type);
   std::unordered_map<std::string, framework::proto::AttrType> attr_types =
@@ -219,8 +292,10 @@ void OpTester::CreateOpDesc() {
     const std::string &value_str = item.second;
     const framework::proto::AttrType &type = attr_types[name];
     switch (type) {
-      case framework::proto::AttrType::BOOLEAN:
-        break;
+      case framework::proto::AttrType::BOOLEAN: {
+        bool value = (value_str == "true" || value_str == "1");
+        op_desc_.SetAttr(name, value);
+      } break;
       case framework::proto::AttrType::INT: {
         int value = StringTo<int>(value_str);
         op_desc_.SetAttr(name, {value});
@@ -232,18 +307,21 @@ void OpTester::CreateOpDesc() {
       case framework::proto::AttrType::STRING: {
         op_desc_.SetAttr(name, {value_str});
       } break;
-      case framework::proto::AttrType::BOOLEANS:
-      case framework::proto::AttrType::INTS:
-      case framework::proto::AttrType::FLOATS:
-      case framework::proto::AttrType::STRINGS:
-        PADDLE_THROW(platform::errors::Unimplemented(
-            "Unsupported STRINGS type in OpTester yet."));
-        break;
+      case framework::proto::AttrType::INTS: {
+        op_desc_.SetAttr(name, ParseValueList<int>(value_str));
+      } break;
+      case framework::proto::AttrType::FLOATS: {
+        op_desc_.SetAttr(name, ParseValueList<float>(value_str));
+      } break;
       case framework::proto::AttrType::LONG: {
         int64_t value = StringTo<int64_t>(value_str);
         op_desc_.SetAttr(name, value);
       } break;
-      case framework::proto::AttrType::LONGS:
+      case framework::proto::AttrType::LONGS: {
+        op_desc_.SetAttr(name, ParseValueList<int64_t>(value_str));
+      } break;
+      case framework::proto::AttrType::BOOLEANS:
+      case framework::proto::AttrType::STRINGS:
       default:
         PADDLE_THROW(platform::errors::Unimplemented(
             "Unsupport attr type %d in OpTester.", type));
@@ -488,6 +566,270 @@ std::string OpTester::DebugString() {
   return ss.str();
 }
 
+static std::string DimsToString(const std::vector<int64_t> &dims) {
+  std::stringstream ss;
+  for (size_t i = 0; i < dims.size(); ++i) {
+    if (i > 0) {
+      ss << "x";
+    }
+    ss << dims[i];
+  }
+  return ss.str();
+}
+
+static std::string VarDTypeToString(framework::proto::VarType::Type type) {
+  switch (type) {
+    case framework::proto::VarType::INT32:
+      return "int32";
+    case framework::proto::VarType::INT64:
+      return "int64";
+    case framework::proto::VarType::FP32:
+      return "fp32";
+    case framework::proto::VarType::FP64:
+      return "fp64";
+    default:
+      return "";
+  }
+}
+
+template <typename T>
+static std::string JoinValueList(const std::vector<T> &values) {
+  std::stringstream ss;
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (i > 0) {
+      ss << ",";
+    }
+    ss << values[i];
+  }
+  return ss.str();
+}
+
+static void ExtractOpAttrs(const framework::OpDesc &op,
+                           OpTesterConfig *config) {
+  const std::vector<std::string> skipped_attrs = {
+      framework::OpProtoAndCheckerMaker::OpRoleAttrName(),
+      framework::OpProtoAndCheckerMaker::OpRoleVarAttrName(),
+      framework::OpProtoAndCheckerMaker::OpNamescopeAttrName(),
+      framework::OpProtoAndCheckerMaker::OpCreationCallstackAttrName(),
+      framework::OpProtoAndCheckerMaker::OpWithQuantAttrName()};
+  for (auto &name : op.AttrNames()) {
+    if (Has(skipped_attrs, name)) {
+      continue;
+    }
+    const auto &attr = op.GetAttr(name);
+    switch (op.GetAttrType(name)) {
+      case framework::proto::AttrType::BOOLEAN:
+        config->attrs[name] = BOOST_GET_CONST(bool, attr) ? "1" : "0";
+        break;
+      case framework::proto::AttrType::INT:
+        config->attrs[name] = std::to_string(BOOST_GET_CONST(int, attr));
+        break;
+      case framework::proto::AttrType::FLOAT:
+        config->attrs[name] = std::to_string(BOOST_GET_CONST(float, attr));
+        break;
+      case framework::proto::AttrType::LONG:
+        config->attrs[name] = std::to_string(BOOST_GET_CONST(int64_t, attr));
+        break;
+      case framework::proto::AttrType::STRING: {
+        const auto &value = BOOST_GET_CONST(std::string, attr);
+        if (!value.empty() &&
+            value.find_first_of(" \t\n") == std::string::npos) {
+          config->attrs[name] = value;
+        }
+      } break;
+      case framework::proto::AttrType::INTS: {
+        const auto &values = BOOST_GET_CONST(std::vector<int>, attr);
+        if (!values.empty()) {
+          config->attrs[name] = JoinValueList(values);
+        }
+      } break;
+      case framework::proto::AttrType::FLOATS: {
+        const auto &values = BOOST_GET_CONST(std::vector<float>, attr);
+        if (!values.empty()) {
+          config->attrs[name] = JoinValueList(values);
+        }
+      } break;
+      case framework::proto::AttrType::LONGS: {
+        const auto &values = BOOST_GET_CONST(std::vector<int64_t>, attr);
+        if (!values.empty()) {
+          config->attrs[name] = JoinValueList(values);
+        }
+      } break;
+      default:
+        // Attr types the tester cannot parse keep their default values.
+        break;
+    }
+  }
+}
+
+// Build OpTesterConfigs for every benchmarkable op in a serialized
+// ProgramDesc, taking shapes and attributes from the real model. Ops whose
+// inputs are not dense tensors of a supported dtype are skipped, duplicated
+// configs are extracted only once.
+static std::vector<OpTesterConfig> ExtractOpConfigsFromProgram(
+    const std::string &model_path) {
+  std::ifstream fin(model_path, std::ios::in | std::ios::binary);
+  PADDLE_ENFORCE_EQ(
+      static_cast<bool>(fin), true,
+      platform::errors::InvalidArgument("OpTester cannot open model file %s.",
+                                        model_path.c_str()));
+  std::string buffer((std::istreambuf_iterator<char>(fin)),
+                     std::istreambuf_iterator<char>());
+  framework::ProgramDesc program(buffer);
+
+  std::vector<OpTesterConfig> configs;
+  std::set<std::string> signatures;
+  for (size_t i = 0; i < program.Size(); ++i) {
+    const auto &block = program.Block(i);
+    for (auto *op : block.AllOps()) {
+      if (op->Type() == "feed" || op->Type() == "fetch" ||
+          !framework::OpInfoMap::Instance().Has(op->Type())) {
+        continue;
+      }
+
+      OpTesterConfig config;
+      config.op_type = op->Type();
+      bool benchmarkable = true;
+      for (auto &name : op->InputNames()) {
+        const auto &args = op->Input(name);
+        if (args.empty()) {
+          continue;
+        }
+        auto *var = block.FindVarRecursive(args[0]);
+        if (var == nullptr ||
+            var->GetType() != framework::proto::VarType::LOD_TENSOR) {
+          benchmarkable = false;
+          break;
+        }
+        OpInputConfig input;
+        input.name = name;
+        input.dtype = VarDTypeToString(var->GetDataType());
+        for (auto d : var->GetShape()) {
+          // Unknown dims (e.g. the batch dim) default to 1.
+          input.dims.push_back(d > 0 ? d : 1);
+        }
+        if (input.dtype.empty() || input.dims.empty()) {
+          benchmarkable = false;
+          break;
+        }
+        config.inputs.push_back(input);
+      }
+      if (!benchmarkable || config.inputs.empty()) {
+        continue;
+      }
+
+      ExtractOpAttrs(*op, &config);
+      if (signatures.insert(config.ToString()).second) {
+        configs.push_back(config);
+      }
+    }
+  }
+  return configs;
+}
+
+static bool OpProtoHasAttr(const std::string &op_type,
+                           const std::string &attr_name) {
+  const framework::proto::OpProto &proto =
+      framework::OpInfoMap::Instance().Get(op_type).Proto();
+  for (int i = 0; i != proto.attrs_size(); ++i) {
+    if (proto.attrs(i).name() == attr_name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Expand one config into a variant per registered kernel backend of the op:
+// plain CPU, oneDNN (when the op has a use_mkldnn attribute and a kMKLDNN
+// kernel) and CUDA.
+static std::vector<OpTesterConfig> ExpandKernelVariants(
+    const OpTesterConfig &base) {
+  bool has_cpu = false;
+  bool has_gpu = false;
+  bool has_mkldnn = false;
+  auto &all_kernels = framework::OperatorWithKernel::AllOpKernels();
+  auto it = all_kernels.find(base.op_type);
+  if (it == all_kernels.end()) {
+    // Ops without kernels can run on any place.
+    has_cpu = true;
+  } else {
+    for (auto &kernel_pair : it->second) {
+      const auto &kernel_type = kernel_pair.first;
+      if (platform::is_gpu_place(kernel_type.place_)) {
+        has_gpu = true;
+      } else {
+        has_cpu = true;
+      }
+      if (kernel_type.library_type_ == framework::LibraryType::kMKLDNN) {
+        has_mkldnn = true;
+      }
+    }
+  }
+
+  std::vector<OpTesterConfig> variants;
+  if (has_cpu) {
+    OpTesterConfig config = base;
+    config.device_id = -1;
+    if (OpProtoHasAttr(base.op_type, "use_mkldnn")) {
+      config.attrs["use_mkldnn"] = "0";
+    }
+    variants.push_back(config);
+  }
+#ifdef PADDLE_WITH_MKLDNN
+  if (has_mkldnn && OpProtoHasAttr(base.op_type, "use_mkldnn")) {
+    OpTesterConfig config = base;
+    config.device_id = -1;
+    config.attrs["use_mkldnn"] = "1";
+    variants.push_back(config);
+  }
+#endif
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (has_gpu) {
+    OpTesterConfig config = base;
+    config.device_id = 0;
+    variants.push_back(config);
+  }
+#endif
+  return variants;
+}
+
+// One whitespace-free key per measured variant, used to match the baseline
+// file entries.
+static std::string ConfigSignature(const OpTesterConfig &config) {
+  std::stringstream ss;
+  ss << config.op_type;
+  for (auto &input : config.inputs) {
+    ss << "/" << input.name << ":" << DimsToString(input.dims);
+  }
+  ss << "/" << (config.device_id >= 0 ? "GPU" : "CPU");
+  auto it = config.attrs.find("use_mkldnn");
+  if (it != config.attrs.end() && it->second == "1") {
+    ss << "/MKLDNN";
+  }
+  return ss.str();
+}
+
+// The baseline file holds one "<signature> <latency_ms>" pair per line, as
+// written through --benchmark_output.
+static std::unordered_map<std::string, double> LoadBaseline(
+    const std::string &path) {
+  std::unordered_map<std::string, double> baseline;
+  if (path.empty()) {
+    return baseline;
+  }
+  std::ifstream fin(path);
+  PADDLE_ENFORCE_EQ(static_cast<bool>(fin), true,
+                    platform::errors::InvalidArgument(
+                        "OpTester cannot open baseline file %s.",
+                        path.c_str()));
+  std::string signature;
+  double runtime = 0.0;
+  while (fin >> signature >> runtime) {
+    baseline[signature] = runtime;
+  }
+  return baseline;
+}
+
 TEST(op_tester, base) {
   if (!FLAGS_op_config_list.empty()) {
     std::ifstream fin(FLAGS_op_config_list, std::ios::in | std::ios::binary);
@@ -530,6 +872,90 @@ TEST(op_tester, base) {
   }
 }
 
+TEST(op_tester, regression_suite) {
+  if (FLAGS_extract_op_configs_from.empty() &&
+      FLAGS_benchmark_baseline.empty() && FLAGS_benchmark_output.empty()) {
+    // The suite only runs when explicitly requested, the base test above
+    // keeps the historical behavior of --op_config_list.
+    return;
+  }
+
+  std::vector<OpTesterConfig> op_configs;
+  if (!FLAGS_extract_op_configs_from.empty()) {
+    op_configs = ExtractOpConfigsFromProgram(FLAGS_extract_op_configs_from);
+    if (!FLAGS_extracted_config_path.empty()) {
+      std::ofstream fout(FLAGS_extracted_config_path);
+      for (auto &config : op_configs) {
+        fout << config.ToString();
+      }
+      LOG(INFO) << "Extracted " << op_configs.size() << " op configs of "
+                << FLAGS_extract_op_configs_from << " to "
+                << FLAGS_extracted_config_path;
+    }
+  } else {
+    PADDLE_ENFORCE_EQ(FLAGS_op_config_list.empty(), false,
+                      platform::errors::InvalidArgument(
+                          "The regression suite needs --op_config_list or "
+                          "--extract_op_configs_from to provide op configs."));
+    std::ifstream fin(FLAGS_op_config_list, std::ios::in | std::ios::binary);
+    PADDLE_ENFORCE_EQ(
+        static_cast<bool>(fin), true,
+        platform::errors::InvalidArgument("OpTester cannot open file %s",
+                                          FLAGS_op_config_list.c_str()));
+    while (!fin.eof()) {
+      OpTesterConfig config;
+      if (config.Init(fin)) {
+        op_configs.push_back(config);
+      }
+    }
+  }
+
+  auto baseline = LoadBaseline(FLAGS_benchmark_baseline);
+  std::ofstream result_out;
+  if (!FLAGS_benchmark_output.empty()) {
+    result_out.open(FLAGS_benchmark_output);
+  }
+
+  for (auto &base_config : op_configs) {
+    for (auto &config : ExpandKernelVariants(base_config)) {
+      if (config.repeat <= 1) {
+        config.repeat = 10;
+      }
+      if (config.max_repeat < config.repeat) {
+        config.max_repeat = 100 * config.repeat;
+      }
+
+      OpTester tester;
+      try {
+        tester.Init(config);
+        tester.Run();
+      } catch (platform::EnforceNotMet &e) {
+        // Extracted configs may hit ops the tester cannot feed yet, they
+        // are reported but do not abort the whole suite.
+        LOG(WARNING) << "Skip " << ConfigSignature(config) << ": "
+                     << e.what();
+        continue;
+      }
+
+      double runtime = tester.Config().runtime;
+      std::string signature = ConfigSignature(config);
+      if (result_out.is_open()) {
+        result_out << signature << " " << runtime << "\n";
+      }
+
+      auto iter = baseline.find(signature);
+      if (iter != baseline.end() &&
+          runtime > iter->second * (1.0 + FLAGS_benchmark_threshold)) {
+        ADD_FAILURE() << "Performance regression on " << signature << ": "
+                      << runtime << " ms against baseline " << iter->second
+                      << " ms.";
+      } else {
+        LOG(INFO) << signature << ": " << runtime << " ms";
+      }
+    }
+  }
+}
+
 }  // namespace benchmark
 }  // namespace operators
 }  // namespace paddle
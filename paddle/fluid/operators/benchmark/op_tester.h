@@ -38,8 +38,9 @@ class OpTester {
 
   std::string DebugString();
 
+  const OpTesterConfig &Config() const { return config_; }
+
  private:
-  std::vector<std::string> GetOpProtoInputNames();
   std::vector<std::string> GetOpProtoOutputNames();
   std::unordered_map<std::string, framework::proto::AttrType>
   GetOpProtoAttrNames();
@@ -58,6 +59,7 @@ class OpTester {
                    const std::string &initializer, const std::string &filename);
 
   void RunImpl();
+  void RunRepeatsUntilStable();
 
  private:
   OpTesterConfig config_;
@@ -159,6 +159,27 @@ void OpInputConfig::ParseLoD(std::istream& is) {
   }
 }
 
+std::string OpInputConfig::ToString() const {
+  std::stringstream ss;
+  ss << "  input {\n";
+  ss << "    name: " << name << "\n";
+  ss << "    dtype: " << dtype << "\n";
+  ss << "    initializer: " << initializer << "\n";
+  if (!filename.empty()) {
+    ss << "    filename " << filename << "\n";
+  }
+  ss << "    dims: ";
+  for (size_t i = 0; i < dims.size(); ++i) {
+    if (i > 0) {
+      ss << "x";
+    }
+    ss << dims[i];
+  }
+  ss << "\n";
+  ss << "  }\n";
+  return ss.str();
+}
+
 OpTesterConfig::OpTesterConfig(const std::string& filename) {
   std::ifstream fin(filename, std::ios::in | std::ios::binary);
   PADDLE_ENFORCE_EQ(
@@ -181,6 +202,8 @@ bool OpTesterConfig::Init(std::istream& is) {
         is >> device_id;
       } else if (sep == "repeat" || sep == "repeat:") {
         is >> repeat;
+      } else if (sep == "max_repeat" || sep == "max_repeat:") {
+        is >> max_repeat;
       } else if (sep == "profile" || sep == "profile:") {
         is >> profile;
       } else if (sep == "print_debug_string" || sep == "print_debug_string:") {
@@ -225,6 +248,29 @@ bool OpTesterConfig::ParseAttrs(std::istream& is) {
   return true;
 }
 
+std::string OpTesterConfig::ToString() const {
+  std::stringstream ss;
+  ss << "{\n";
+  ss << "  op_type: " << op_type << "\n";
+  ss << "  device_id: " << device_id << "\n";
+  ss << "  repeat: " << repeat << "\n";
+  if (max_repeat > 0) {
+    ss << "  max_repeat: " << max_repeat << "\n";
+  }
+  for (const auto& input : inputs) {
+    ss << input.ToString();
+  }
+  if (!attrs.empty()) {
+    ss << "  attrs {\n";
+    for (const auto& item : attrs) {
+      ss << "    " << item.first << ": " << item.second << "\n";
+    }
+    ss << "  }\n";
+  }
+  ss << "}\n";
+  return ss.str();
+}
+
 const OpInputConfig* OpTesterConfig::GetInput(const std::string& name) {
   for (size_t i = 0; i < inputs.size(); ++i) {
     if (inputs[i].name == name) {
@@ -33,6 +33,9 @@ struct OpInputConfig {
   void ParseDims(std::istream& is);
   void ParseLoD(std::istream& is);
 
+  // Serialize into the format that OpInputConfig(std::istream&) parses.
+  std::string ToString() const;
+
   std::string name;
   std::string dtype{"fp32"};  // int32/int, int64/long, fp32/float, fp64/double
   std::string initializer{"random"};  // random, natural, zeros, file
@@ -51,11 +54,19 @@ struct OpTesterConfig {
 
   const OpInputConfig* GetInput(const std::string& name);
 
+  // Serialize into the format that Init(std::istream&) parses, so extracted
+  // config corpora can be written back to disk.
+  std::string ToString() const;
+
   std::string op_type;
   std::vector<OpInputConfig> inputs;
   std::unordered_map<std::string, std::string> attrs;
   int device_id{-1};  // CPU: -1
   int repeat{1};
+  // When max_repeat > repeat, Run() repeats batches of `repeat` iterations
+  // until the measured latency is statistically stable or max_repeat
+  // iterations have been executed.
+  int max_repeat{0};
   int profile{0};
   int print_debug_string{0};
   double runtime{0.0};
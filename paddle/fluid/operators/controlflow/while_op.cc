@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
+#include <mutex>
+
 #include "paddle/fluid/framework/executor.h"
 #include "paddle/fluid/framework/op_registry.h"
 #include "paddle/fluid/framework/operator.h"
@@ -91,7 +94,10 @@ class WhileOp : public framework::OperatorBase {
     auto step_scopes =
         scope.FindVar(Output(kStepScopes))->GetMutable<StepScopeVar>();
 
-    if (step_scopes->size() > 0) {
+    // In the is_test case the single step scope is recycled across runs, so
+    // only drop the recorded scopes when the backward pass needs a fresh
+    // history.
+    if (!is_test && step_scopes->size() > 0) {
       platform::DeviceContextPool::Instance().Get(dev_place)->Wait();
       for (auto &s : *step_scopes) {
         if (scope.HasKid(s)) {
@@ -101,15 +107,23 @@ class WhileOp : public framework::OperatorBase {
       step_scopes->clear();
     }
 
-    PADDLE_ENFORCE_EQ(step_scopes->size(), 0,
-                      platform::errors::PreconditionNotMet(
-                          "The Output(StepScope) of WhileOp should be empty."));
-
     bool cond_data = GetCondData(cond);
     auto &skip_vars = Attr<std::vector<std::string>>(kSkipEagerDeletionVars);
     VLOG(2) << GetSkipEagerDeletionVarsDebugString(skip_vars);
 
-    auto ctx = executor.Prepare(*program, block->ID(), skip_vars);
+    // The step block, its attributes and this op's place do not change
+    // between runs, so the prepared context (the constructed operators of the
+    // body, with their kernel caches) is built once per op instance instead
+    // of once per run.
+    std::shared_ptr<framework::ExecutorPrepareContext> ctx;
+    {
+      std::lock_guard<std::mutex> lk(cached_ctx_mutex_);
+      if (!cached_ctx_ || !platform::is_same_place(cached_place_, dev_place)) {
+        cached_ctx_ = executor.Prepare(*program, block->ID(), skip_vars);
+        cached_place_ = dev_place;
+      }
+      ctx = cached_ctx_;
+    }
     if (!is_test) {
       while (cond_data) {
         auto &current_scope = scope.NewScope();
@@ -144,8 +158,21 @@ class WhileOp : public framework::OperatorBase {
             GetCondData(scope.FindVar(Input(kCondition))->Get<LoDTensor>());
       }
     } else {
-      auto &current_scope = scope.NewScope();
-      executor.CreateVariables(*program, &current_scope, block->ID());
+      // Without backward there is no need for a scope per iteration, and the
+      // scope of the previous run can be recycled as well: it is recorded in
+      // the step-scope var so its lifetime is bound to the outer scope, and
+      // HasKid guards against the caller having dropped it. Reuse keeps the
+      // body's tensor allocations warm across runs.
+      framework::Scope *current_scope_p = nullptr;
+      if (!step_scopes->empty() && scope.HasKid(step_scopes->front())) {
+        current_scope_p = step_scopes->front();
+      } else {
+        step_scopes->clear();
+        current_scope_p = &scope.NewScope();
+        step_scopes->push_back(current_scope_p);
+        executor.CreateVariables(*program, current_scope_p, block->ID());
+      }
+      auto &current_scope = *current_scope_p;
       while (cond_data) {
         for (auto &name : current_scope.LocalVarNames()) {
           auto *var = current_scope.Var(name);
@@ -165,9 +192,12 @@ class WhileOp : public framework::OperatorBase {
         cond_data =
             GetCondData(scope.FindVar(Input(kCondition))->Get<LoDTensor>());
       }
-      scope.DeleteScope(&current_scope);
     }
   }
+
+  mutable std::mutex cached_ctx_mutex_;
+  mutable std::shared_ptr<framework::ExecutorPrepareContext> cached_ctx_;
+  mutable platform::Place cached_place_;
 };
 
 class WhileOpMaker : public framework::OpProtoAndCheckerMaker {
@@ -156,8 +156,11 @@ class MultiClassNMSKernel : public framework::OpKernel<T> {
     T adaptive_threshold = nms_threshold;
     const T* bbox_data = bbox.data<T>();
 
-    while (sorted_indices.size() != 0) {
-      const int idx = sorted_indices.front().second;
+    // Walk the sorted candidates with a cursor instead of erasing the
+    // front of the vector, which shifted every remaining element and made
+    // the loop quadratic in the number of candidates.
+    for (size_t i = 0; i < sorted_indices.size(); ++i) {
+      const int idx = sorted_indices[i].second;
       bool keep = true;
       for (size_t k = 0; k < selected_indices->size(); ++k) {
         if (keep) {
@@ -183,10 +186,9 @@ class MultiClassNMSKernel : public framework::OpKernel<T> {
       }
       if (keep) {
         selected_indices->push_back(idx);
-      }
-      sorted_indices.erase(sorted_indices.begin());
-      if (keep && eta < 1 && adaptive_threshold > 0.5) {
-        adaptive_threshold *= eta;
+        if (eta < 1 && adaptive_threshold > 0.5) {
+          adaptive_threshold *= eta;
+        }
       }
     }
   }
@@ -208,9 +210,17 @@ class MultiClassNMSKernel : public framework::OpKernel<T> {
     int num_det = 0;
 
     int64_t class_num = scores_size == 3 ? scores.dims()[0] : scores.dims()[1];
-    Tensor bbox_slice, score_slice;
+    // Classes are suppressed independently, so distribute them across the
+    // host threads. Each iteration works on its own slice tensors and
+    // writes its own result slot, and the per-class results are merged
+    // into the map afterwards, keeping the output deterministic.
+    std::vector<std::vector<int>> indices_per_class(class_num);
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for schedule(dynamic)
+#endif
     for (int64_t c = 0; c < class_num; ++c) {
       if (c == background_label) continue;
+      Tensor bbox_slice, score_slice;
       if (scores_size == 3) {
         score_slice = scores.Slice(c, c + 1);
         bbox_slice = bboxes;
@@ -221,17 +231,23 @@ class MultiClassNMSKernel : public framework::OpKernel<T> {
         SliceOneClass<T>(dev_ctx, bboxes, c, &bbox_slice);
       }
       NMSFast(bbox_slice, score_slice, score_threshold, nms_threshold, nms_eta,
-              nms_top_k, &((*indices)[c]), normalized);
+              nms_top_k, &indices_per_class[c], normalized);
       if (scores_size == 2) {
-        std::stable_sort((*indices)[c].begin(), (*indices)[c].end());
+        std::stable_sort(indices_per_class[c].begin(),
+                         indices_per_class[c].end());
       }
-      num_det += (*indices)[c].size();
+    }
+    for (int64_t c = 0; c < class_num; ++c) {
+      if (c == background_label) continue;
+      num_det += indices_per_class[c].size();
+      (*indices)[c] = std::move(indices_per_class[c]);
     }
 
     *num_nmsed_out = num_det;
     const T* scores_data = scores.data<T>();
     if (keep_top_k > -1 && num_det > keep_top_k) {
       const T* sdata;
+      Tensor score_slice;
       std::vector<std::pair<float, std::pair<int, int>>> score_index_pairs;
       for (const auto& it : *indices) {
         int label = it.first;
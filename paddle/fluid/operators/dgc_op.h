@@ -174,6 +174,14 @@ class DGCOpKernel : public framework::OpKernel<T> {
     gather_buff->mutable_data<T>(framework::DDim{2 * k * nranks},
                                  ctx.GetPlace());
 
+    // NOTE: the top-k selection engine lives entirely inside the external
+    // dgc library (a prebuilt binary, see cmake/external/dgc.cmake): k_select
+    // both picks the k largest |v| entries and zeroes them out of u/v, and
+    // sparseReduce on the allgather side decodes the 2*k encode buffer it
+    // produces. A cheaper selection strategy (e.g. estimating the k-th value
+    // from a sample and selecting by comparison in one pass) therefore has to
+    // be implemented in that library; reimplementing it here would require
+    // matching the encode layout of a closed binary.
     int buf_size = paddle::communication::dgc::get_buffer_size(k);
     auto tmp_ious_data = memory::Alloc(dev_ctx, buf_size);
     void* buf = reinterpret_cast<void*>(tmp_ious_data->ptr());
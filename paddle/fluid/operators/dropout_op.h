@@ -21,6 +21,7 @@ limitations under the License. */
 #include "paddle/fluid/framework/eigen.h"
 #include "paddle/fluid/framework/generator.h"
 #include "paddle/fluid/framework/op_registry.h"
+#include "paddle/fluid/framework/philox_engine.h"
 
 namespace paddle {
 namespace operators {
@@ -72,6 +73,41 @@ class CPUDropoutKernel : public framework::OpKernel<T> {
       }
       auto engine = framework::GetCPURandomEngine(seed_data);
 
+#ifdef PADDLE_WITH_MKLML
+      if (size >= 8192) {
+        // Counter-based parallel mask generation: each Philox block is
+        // addressed by its index, so threads draw disjoint ranges of the
+        // stream independently and a fixed seed reproduces the same mask
+        // at any thread count.
+        uint64_t philox_seed = static_cast<uint64_t>(seed_data);
+        if (philox_seed == 0) {
+          philox_seed = (*engine)();
+        }
+        framework::PhiloxEngine philox(philox_seed);
+        const int64_t num_blocks = (static_cast<int64_t>(size) + 3) / 4;
+#pragma omp parallel for
+        for (int64_t b = 0; b < num_blocks; ++b) {
+          auto block = philox(b);
+          int64_t i = b * 4;
+          int64_t end = std::min<int64_t>(i + 4, size);
+          for (int64_t j = 0; i + j < end; ++j) {
+            if (framework::PhiloxEngine::Uniform01(block[j]) < dropout_prob) {
+              mask_data[i + j] = 0;
+              y_data[i + j] = 0;
+            } else {
+              mask_data[i + j] = 1;
+              if (upscale_in_train) {
+                y_data[i + j] =
+                    x_data[i + j] / static_cast<T>(1.0f - dropout_prob);
+              } else {
+                y_data[i + j] = x_data[i + j];
+              }
+            }
+          }
+        }
+        return;
+      }
+#endif
       std::uniform_real_distribution<float> dist(0, 1);
 
       for (size_t i = 0; i < size; ++i) {
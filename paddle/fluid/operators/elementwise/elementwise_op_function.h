@@ -247,6 +247,94 @@ inline void GetBroadcastDimsArrays(const framework::DDim &x_dims,
   }
 }
 
+// Collapse adjacent output dimensions that share the same broadcast pattern
+// (both inputs advance, only X advances, or only Y advances) and drop unit
+// dimensions. Most real broadcasts (outer-dim, inner-dim and per-channel)
+// collapse to at most three dimensions, which the fixed-rank kernels below
+// handle with contiguous inner loops. Returns the collapsed rank; the stride
+// of a broadcast input is 0 in the dimensions where it does not advance, and
+// the innermost stride of every operand is either 0 or 1.
+inline int CollapseBroadcastDims(const int *x_dims_array,
+                                 const int *y_dims_array,
+                                 const int *out_dims_array, int max_dim,
+                                 int64_t *dims, int64_t *x_strides,
+                                 int64_t *y_strides) {
+  std::vector<int> pattern(max_dim);
+  int rank = 0;
+  int prev = -1;
+  for (int i = 0; i < max_dim; ++i) {
+    const int od = out_dims_array[i];
+    if (od == 1) {
+      continue;
+    }
+    // 0: both advance, 1: only X advances, 2: only Y advances
+    const int pat = x_dims_array[i] == od ? (y_dims_array[i] == od ? 0 : 1) : 2;
+    if (pat == prev) {
+      dims[rank - 1] *= od;
+    } else {
+      dims[rank] = od;
+      pattern[rank] = pat;
+      ++rank;
+      prev = pat;
+    }
+  }
+  int64_t x_stride = 1;
+  int64_t y_stride = 1;
+  for (int i = rank - 1; i >= 0; --i) {
+    x_strides[i] = pattern[i] == 2 ? 0 : x_stride;
+    y_strides[i] = pattern[i] == 1 ? 0 : y_stride;
+    if (pattern[i] != 2) {
+      x_stride *= dims[i];
+    }
+    if (pattern[i] != 1) {
+      y_stride *= dims[i];
+    }
+  }
+  return rank;
+}
+
+// Innermost broadcast loop: both strides are 0 or 1, so each of the three
+// cases reads contiguously (or holds a scalar) and vectorizes.
+template <typename Functor, typename T, typename OutType>
+inline void BroadcastInnerLoopCPU(const T *x, const T *y, OutType *out,
+                                  int64_t n, int64_t x_stride,
+                                  int64_t y_stride, Functor func,
+                                  const bool is_xsize_larger) {
+  if (x_stride != 0 && y_stride != 0) {
+    if (is_xsize_larger) {
+      for (int64_t i = 0; i < n; ++i) {
+        out[i] = func(x[i], y[i]);
+      }
+    } else {
+      for (int64_t i = 0; i < n; ++i) {
+        out[i] = func(y[i], x[i]);
+      }
+    }
+  } else if (y_stride == 0) {
+    const T y_val = y[0];
+    if (is_xsize_larger) {
+      for (int64_t i = 0; i < n; ++i) {
+        out[i] = func(x[i], y_val);
+      }
+    } else {
+      for (int64_t i = 0; i < n; ++i) {
+        out[i] = func(y_val, x[i]);
+      }
+    }
+  } else {
+    const T x_val = x[0];
+    if (is_xsize_larger) {
+      for (int64_t i = 0; i < n; ++i) {
+        out[i] = func(x_val, y[i]);
+      }
+    } else {
+      for (int64_t i = 0; i < n; ++i) {
+        out[i] = func(y[i], x_val);
+      }
+    }
+  }
+}
+
 template <typename Functor, typename T, typename OutType = T>
 void CommonForwardBroadcastCPU(const framework::Tensor *x,
                                const framework::Tensor *y, framework::Tensor *z,
@@ -264,6 +352,40 @@ void CommonForwardBroadcastCPU(const framework::Tensor *x,
                                       "The input Y should not be empty."));
   OutType *out_data = z->mutable_data<OutType>(ctx.GetPlace());
 
+  std::vector<int64_t> dims(max_dim), x_strides(max_dim), y_strides(max_dim);
+  const int rank =
+      CollapseBroadcastDims(x_dims_array, y_dims_array, out_dims_array,
+                            max_dim, dims.data(), x_strides.data(),
+                            y_strides.data());
+  switch (rank) {
+    case 1:
+      BroadcastInnerLoopCPU(x_data, y_data, out_data, dims[0], x_strides[0],
+                            y_strides[0], func, is_xsize_larger);
+      return;
+    case 2:
+      for (int64_t i = 0; i < dims[0]; ++i) {
+        BroadcastInnerLoopCPU(x_data + i * x_strides[0],
+                              y_data + i * y_strides[0], out_data + i * dims[1],
+                              dims[1], x_strides[1], y_strides[1], func,
+                              is_xsize_larger);
+      }
+      return;
+    case 3:
+      for (int64_t i = 0; i < dims[0]; ++i) {
+        for (int64_t j = 0; j < dims[1]; ++j) {
+          BroadcastInnerLoopCPU(
+              x_data + i * x_strides[0] + j * x_strides[1],
+              y_data + i * y_strides[0] + j * y_strides[1],
+              out_data + (i * dims[1] + j) * dims[2], dims[2], x_strides[2],
+              y_strides[2], func, is_xsize_larger);
+        }
+      }
+      return;
+    default:
+      break;
+  }
+
+  // more than three collapsed dimensions: fall back to the generic index walk
   const int out_size = std::accumulate(out_dims_array, out_dims_array + max_dim,
                                        1, std::multiplies<int>());
   int x_index, y_index;
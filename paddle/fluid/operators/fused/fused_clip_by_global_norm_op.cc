@@ -0,0 +1,130 @@
+/* Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <algorithm>
+#include <cmath>
+
+#include "paddle/fluid/framework/eigen.h"
+#include "paddle/fluid/framework/op_registry.h"
+#include "paddle/fluid/framework/tensor.h"
+
+namespace paddle {
+namespace operators {
+
+class FusedClipByGlobalNormOp : public framework::OperatorWithKernel {
+ public:
+  using framework::OperatorWithKernel::OperatorWithKernel;
+
+  void InferShape(framework::InferShapeContext* ctx) const override {
+    PADDLE_ENFORCE_EQ(
+        ctx->Inputs("X").size(), ctx->Outputs("Out").size(),
+        platform::errors::InvalidArgument(
+            "The input(X) and output(Out) should have same size in "
+            "Operator(fused_clip_by_global_norm), size of input(X) is %d "
+            "and size of output(Out) is %d.",
+            ctx->Inputs("X").size(), ctx->Outputs("Out").size()));
+    auto x_dims = ctx->GetInputsDim("X");
+    ctx->SetOutputsDim("Out", x_dims);
+    ctx->SetOutputDim("GlobalNorm", {1});
+  }
+
+ protected:
+  framework::OpKernelType GetExpectedKernelType(
+      const framework::ExecutionContext& ctx) const override {
+    return framework::OpKernelType(
+        OperatorWithKernel::IndicateVarDataType(ctx, "X"), ctx.GetPlace());
+  }
+};
+
+class FusedClipByGlobalNormOpMaker : public framework::OpProtoAndCheckerMaker {
+ public:
+  void Make() override {
+    AddInput("X",
+             "(Tensors) The input tensors of fused_clip_by_global_norm "
+             "operator, usually the gradients of all parameters.")
+        .AsDuplicable();
+    AddOutput("Out",
+              "(Tensors) The clipped output tensors of "
+              "fused_clip_by_global_norm operator.")
+        .AsDuplicable();
+    AddOutput("GlobalNorm",
+              "(Tensor) 1-dim tensor, the global l2 norm over all inputs.");
+    AddAttr<float>("clip_norm", "(float) The maximum global norm value.");
+    AddComment(R"DOC(
+fused_clip_by_global_norm operator.
+
+Given a tensor list X, compute the global l2 norm over all elements of all
+tensors and scale every tensor by clip_norm / max(global_norm, clip_norm):
+
+$$global\_norm = \sqrt{\sum_i \|X_i\|_2^2}$$
+$$Out_i = X_i * \frac{clip\_norm}{\max(global\_norm, clip\_norm)}$$
+
+Unlike clipping with per-tensor squared_l2_norm ops, all tensors are
+processed by a handful of multi-tensor kernels and the scale stays on the
+device, so the number of kernel launches does not grow with the number of
+tensors and no host synchronization is needed.
+)DOC");
+  }
+};
+
+template <typename T>
+class FusedClipByGlobalNormCpuKernel : public framework::OpKernel<T> {
+ public:
+  void Compute(const framework::ExecutionContext& ctx) const {
+    auto& dev_ctx = ctx.template device_context<platform::CPUDeviceContext>();
+    auto xs = ctx.MultiInput<framework::Tensor>("X");
+    auto outs = ctx.MultiOutput<framework::Tensor>("Out");
+    auto* global_norm = ctx.Output<framework::Tensor>("GlobalNorm");
+    auto clip_norm = static_cast<T>(ctx.Attr<float>("clip_norm"));
+
+    auto& dev = *dev_ctx.eigen_device();
+    T sum_square = static_cast<T>(0);
+    for (auto* x : xs) {
+      auto eigen_x = framework::EigenVector<T>::Flatten(*x);
+      framework::Tensor square_sum_t;
+      square_sum_t.Resize({1});
+      auto* square_sum_data = square_sum_t.mutable_data<T>(ctx.GetPlace());
+      auto eigen_square_sum = framework::EigenScalar<T>::From(square_sum_t);
+      eigen_square_sum.device(dev) = eigen_x.square().sum();
+      sum_square += square_sum_data[0];
+    }
+
+    T norm = std::sqrt(sum_square);
+    T* global_norm_data = global_norm->mutable_data<T>(ctx.GetPlace());
+    global_norm_data[0] = norm;
+    T scale = clip_norm / std::max(norm, clip_norm);
+
+    for (size_t i = 0; i < xs.size(); ++i) {
+      auto eigen_x = framework::EigenVector<T>::Flatten(*xs[i]);
+      outs[i]->mutable_data<T>(ctx.GetPlace());
+      auto eigen_out = framework::EigenVector<T>::Flatten(*outs[i]);
+      eigen_out.device(dev) = eigen_x * scale;
+    }
+  }
+};
+
+}  // namespace operators
+}  // namespace paddle
+
+namespace ops = paddle::operators;
+
+REGISTER_OPERATOR(
+    fused_clip_by_global_norm, ops::FusedClipByGlobalNormOp,
+    ops::FusedClipByGlobalNormOpMaker,
+    paddle::framework::EmptyGradOpMaker<paddle::framework::OpDesc>,
+    paddle::framework::EmptyGradOpMaker<paddle::imperative::OpBase>);
+
+REGISTER_OP_CPU_KERNEL(fused_clip_by_global_norm,
+                       ops::FusedClipByGlobalNormCpuKernel<float>,
+                       ops::FusedClipByGlobalNormCpuKernel<double>);
@@ -0,0 +1,198 @@
+/* Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <algorithm>
+
+#ifdef __NVCC__
+#include "cub/cub.cuh"
+#endif
+#ifdef __HIPCC__
+#include <hipcub/hipcub.hpp>
+namespace cub = hipcub;
+#endif
+
+#include "paddle/fluid/framework/op_registry.h"
+#include "paddle/fluid/framework/tensor.h"
+#include "paddle/fluid/memory/memory.h"
+#include "paddle/fluid/operators/amp/fp16_type_traits.h"
+#include "paddle/fluid/platform/cuda_primitives.h"
+#include "paddle/fluid/platform/float16.h"
+
+namespace paddle {
+namespace operators {
+
+static constexpr int kBlockSize = 512;
+
+template <typename MT>
+__global__ void InitSumSquare(MT* sum_square) {
+  *sum_square = static_cast<MT>(0);
+}
+
+// Accumulate the squared l2 norm over all tensors into *sum_square. The
+// tensor boundaries are described by the starts array, like in the
+// CheckFiniteAndUnscale kernel.
+template <typename T, typename MT>
+__global__ void MultiTensorSumSquare(const T** xs, int64_t size,
+                                     int64_t* starts, MT* sum_square) {
+  const int64_t tid = threadIdx.x + blockIdx.x * blockDim.x;
+
+  extern __shared__ int64_t s_starts[];
+  for (int i = threadIdx.x; i <= size; i += blockDim.x) {
+    s_starts[i] = starts[i];
+  }
+  __syncthreads();
+
+  const int64_t num = s_starts[size];
+  int xs_index = 0;
+  MT local_sum = static_cast<MT>(0);
+  for (int64_t idx = tid; idx < num; idx += gridDim.x * blockDim.x) {
+    int next_xs_index = xs_index;
+    while (idx >= s_starts[next_xs_index]) next_xs_index++;
+    xs_index = next_xs_index - 1;
+
+    MT val = static_cast<MT>(xs[xs_index][idx - s_starts[xs_index]]);
+    local_sum += val * val;
+  }
+
+  typedef cub::BlockReduce<MT, kBlockSize> BlockReduce;
+  __shared__ typename BlockReduce::TempStorage temp_storage;
+  MT block_sum = BlockReduce(temp_storage).Sum(local_sum);
+  if (threadIdx.x == 0) {
+    platform::CudaAtomicAdd(sum_square, block_sum);
+  }
+}
+
+template <typename MT>
+__global__ void GlobalNormAndScale(MT clip_norm, const MT* sum_square,
+                                   MT* global_norm, MT* scale) {
+  MT norm = sqrt(*sum_square);
+  *global_norm = norm;
+  *scale = clip_norm / (norm > clip_norm ? norm : clip_norm);
+}
+
+template <typename T, typename MT>
+__global__ void MultiTensorScale(const T** xs, int64_t size, int64_t* starts,
+                                 const MT* scale, T** outs) {
+  const int64_t tid = threadIdx.x + blockIdx.x * blockDim.x;
+
+  extern __shared__ int64_t s_starts[];
+  for (int i = threadIdx.x; i <= size; i += blockDim.x) {
+    s_starts[i] = starts[i];
+  }
+  __syncthreads();
+
+  const int64_t num = s_starts[size];
+  int xs_index = 0;
+  const MT local_scale = *scale;
+  for (int64_t idx = tid; idx < num; idx += gridDim.x * blockDim.x) {
+    int next_xs_index = xs_index;
+    while (idx >= s_starts[next_xs_index]) next_xs_index++;
+    xs_index = next_xs_index - 1;
+
+    int64_t in_idx = idx - s_starts[xs_index];
+    outs[xs_index][in_idx] =
+        static_cast<T>(static_cast<MT>(xs[xs_index][in_idx]) * local_scale);
+  }
+}
+
+template <typename T>
+class FusedClipByGlobalNormGpuKernel : public framework::OpKernel<T> {
+  using MPDType = typename details::MPTypeTrait<T>::Type;
+
+ public:
+  void Compute(const framework::ExecutionContext& ctx) const {
+    auto& dev_ctx = ctx.template device_context<platform::CUDADeviceContext>();
+    auto xs = ctx.MultiInput<framework::Tensor>("X");
+    auto outs = ctx.MultiOutput<framework::Tensor>("Out");
+    auto* global_norm = ctx.Output<framework::Tensor>("GlobalNorm");
+    auto clip_norm = static_cast<MPDType>(ctx.Attr<float>("clip_norm"));
+
+    MPDType* global_norm_data =
+        global_norm->mutable_data<MPDType>(dev_ctx.GetPlace());
+
+    size_t xs_size = xs.size();
+    if (xs_size == 0) return;
+
+    framework::Tensor sum_square =
+        ctx.AllocateTmpTensor<MPDType, platform::CUDADeviceContext>({1},
+                                                                    dev_ctx);
+    MPDType* sum_square_data = sum_square.template data<MPDType>();
+    framework::Tensor scale =
+        ctx.AllocateTmpTensor<MPDType, platform::CUDADeviceContext>({1},
+                                                                    dev_ctx);
+    MPDType* scale_data = scale.template data<MPDType>();
+
+    InitSumSquare<MPDType><<<1, 1, 0, dev_ctx.stream()>>>(sum_square_data);
+
+    const auto& cpu_place = platform::CPUPlace();
+    // calculate each tensor's start index and copy to device
+    auto h_starts_tensor =
+        memory::Alloc(cpu_place, (xs_size + 1) * sizeof(int64_t));
+    int64_t* h_starts = reinterpret_cast<int64_t*>(h_starts_tensor->ptr());
+
+    auto d_starts_tensor =
+        memory::Alloc(dev_ctx, (xs_size + 1) * sizeof(int64_t));
+    int64_t* d_starts = reinterpret_cast<int64_t*>(d_starts_tensor->ptr());
+
+    h_starts[0] = 0;
+    for (size_t i = 1; i <= xs_size; i++) {
+      h_starts[i] = h_starts[i - 1] + xs[i - 1]->numel();
+    }
+    int64_t total_num = h_starts[xs_size];
+    memory::Copy(BOOST_GET_CONST(platform::CUDAPlace, dev_ctx.GetPlace()),
+                 d_starts, cpu_place, h_starts, (xs_size + 1) * sizeof(int64_t),
+                 dev_ctx.stream());
+
+    // copy each tensor's data address to device
+    auto h_mem = memory::Alloc(cpu_place, 2 * xs_size * sizeof(T*));
+    const T** h_xs = reinterpret_cast<const T**>(h_mem->ptr());
+    T** h_outs = reinterpret_cast<T**>(h_mem->ptr()) + xs_size;
+
+    auto d_mem = memory::Alloc(dev_ctx, 2 * xs_size * sizeof(T*));
+    const T** d_xs = reinterpret_cast<const T**>(d_mem->ptr());
+    T** d_outs = reinterpret_cast<T**>(d_mem->ptr()) + xs_size;
+
+    for (size_t i = 0; i < xs_size; ++i) {
+      h_xs[i] = xs[i]->data<T>();
+      h_outs[i] = outs[i]->mutable_data<T>(dev_ctx.GetPlace());
+    }
+    memory::Copy(BOOST_GET_CONST(platform::CUDAPlace, dev_ctx.GetPlace()), d_xs,
+                 cpu_place, h_xs, 2 * xs_size * sizeof(T*), dev_ctx.stream());
+
+    int64_t elements_per_block =
+        kBlockSize * 20;  // each thread deal with 20 number
+    int blocks_per_grid =
+        (total_num + elements_per_block - 1) / elements_per_block;
+    size_t shared_size = (xs_size + 1) * sizeof(int64_t);
+
+    MultiTensorSumSquare<T, MPDType><<<blocks_per_grid, kBlockSize, shared_size,
+                                       dev_ctx.stream()>>>(
+        d_xs, xs_size, d_starts, sum_square_data);
+    GlobalNormAndScale<MPDType><<<1, 1, 0, dev_ctx.stream()>>>(
+        clip_norm, sum_square_data, global_norm_data, scale_data);
+    MultiTensorScale<T, MPDType><<<blocks_per_grid, kBlockSize, shared_size,
+                                   dev_ctx.stream()>>>(
+        d_xs, xs_size, d_starts, scale_data, d_outs);
+  }
+};
+
+}  // namespace operators
+}  // namespace paddle
+
+namespace ops = paddle::operators;
+namespace plat = paddle::platform;
+REGISTER_OP_CUDA_KERNEL(fused_clip_by_global_norm,
+                        ops::FusedClipByGlobalNormGpuKernel<float>,
+                        ops::FusedClipByGlobalNormGpuKernel<double>,
+                        ops::FusedClipByGlobalNormGpuKernel<plat::float16>);
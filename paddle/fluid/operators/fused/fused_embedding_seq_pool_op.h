@@ -14,10 +14,16 @@ limitations under the License. */
 
 #pragma once
 
+#include <algorithm>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
+#ifdef PADDLE_WITH_MKLML
+#include <omp.h>
+#endif
+
 #include "paddle/fluid/framework/eigen.h"
 #include "paddle/fluid/framework/lod_tensor.h"
 #include "paddle/fluid/framework/op_registry.h"
@@ -42,37 +48,50 @@ void prepare_csr_data(const std::vector<uint64_t> &offset,
                       const int64_t *ids_data, const size_t idx_width,
                       T *csr_vals, int *csr_colmuns, int *csr_row_idx,
                       int64_t padding_idx = kNoPadding) {
-  int val_idx = 0;
-  int row_idx = 0;
-  csr_row_idx[0] = 0;
-
-  std::map<int, int> ids_map;
-
-  // for each sequence in batch
-  for (size_t i = 0; i < offset.size() - 1; ++i) {
-    for (size_t idx = 0; idx < idx_width; ++idx) {
-      ids_map.clear();
-
-      // construct a map for creating csr
-      for (size_t j = offset[i]; j < offset[i + 1]; ++j) {
-        auto ids_value = ids_data[idx + j * idx_width];
-        if (ids_value != padding_idx) {
-          unsigned int word_idx = static_cast<unsigned int>(ids_value);
-          ++ids_map[word_idx];
-        }
+  // Rows of the CSR matrix are independent, so build them in parallel:
+  // each (sequence, idx) row sorts its ids in a flat scratch vector and
+  // run-length encodes the duplicates, which keeps the same ascending
+  // column order the old per-row std::map produced without its node
+  // allocations, and a serial pass concatenates the rows afterwards.
+  const size_t num_rows = (offset.size() - 1) * idx_width;
+  std::vector<std::vector<std::pair<int, int>>> row_entries(num_rows);
+
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+  for (size_t r = 0; r < num_rows; ++r) {
+    const size_t i = r / idx_width;
+    const size_t idx = r % idx_width;
+    std::vector<int> row_ids;
+    row_ids.reserve(offset[i + 1] - offset[i]);
+    for (size_t j = offset[i]; j < offset[i + 1]; ++j) {
+      auto ids_value = ids_data[idx + j * idx_width];
+      if (ids_value != padding_idx) {
+        row_ids.push_back(static_cast<unsigned int>(ids_value));
       }
-
-      VLOG(4) << "====sequence %d====" << i;
-      for (std::map<int, int>::const_iterator it = ids_map.begin();
-           it != ids_map.end(); ++it) {
-        VLOG(4) << it->first << " => " << it->second;
-        csr_vals[val_idx] = it->second;
-        csr_colmuns[val_idx] = it->first;
-        ++val_idx;
+    }
+    std::sort(row_ids.begin(), row_ids.end());
+    auto &entries = row_entries[r];
+    for (size_t j = 0; j < row_ids.size();) {
+      size_t run_end = j + 1;
+      while (run_end < row_ids.size() && row_ids[run_end] == row_ids[j]) {
+        ++run_end;
       }
-      csr_row_idx[row_idx + 1] = csr_row_idx[row_idx] + ids_map.size();
-      ++row_idx;
+      entries.emplace_back(row_ids[j], static_cast<int>(run_end - j));
+      j = run_end;
+    }
+  }
+
+  int val_idx = 0;
+  csr_row_idx[0] = 0;
+  for (size_t r = 0; r < num_rows; ++r) {
+    for (const auto &entry : row_entries[r]) {
+      csr_vals[val_idx] = entry.second;
+      csr_colmuns[val_idx] = entry.first;
+      ++val_idx;
     }
+    csr_row_idx[r + 1] =
+        csr_row_idx[r] + static_cast<int>(row_entries[r].size());
   }
 }
 #else
@@ -104,11 +123,18 @@ struct EmbeddingVSumFunctor {
 
     jit::emb_seq_pool_attr_t attr(table_height, table_width, 0, idx_width,
                                   out_width, jit::SeqPoolType::kSum);
+    // The kernel cache lookup hashes the whole attribute; only repeat it
+    // when the sequence length actually changes.
+    typename jit::EmbSeqPoolTuple<T>::func_type emb_seqpool = nullptr;
+    int64_t last_height = -1;
     for (size_t i = 0; i != ids_lod.size() - 1; ++i) {
       attr.index_height = ids_lod[i + 1] - ids_lod[i];
-      auto emb_seqpool =
-          jit::KernelFuncs<jit::EmbSeqPoolTuple<T>, platform::CPUPlace>::Cache()
-              .At(attr);
+      if (attr.index_height != last_height) {
+        emb_seqpool = jit::KernelFuncs<jit::EmbSeqPoolTuple<T>,
+                                       platform::CPUPlace>::Cache()
+                          .At(attr);
+        last_height = attr.index_height;
+      }
       emb_seqpool(table, ids + ids_lod[i] * idx_width, output + i * out_width,
                   &attr);
     }
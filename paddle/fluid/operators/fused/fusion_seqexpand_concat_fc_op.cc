@@ -195,7 +195,10 @@ class FusionSeqExpandConcatFCOpKernel : public framework::OpKernel<T> {
 
     std::function<void(const int, const T*, T*)> fc_act;
     auto& fc_act_str = ctx.Attr<std::string>("fc_activation");
-    if (platform::MayIUse(platform::avx)) {
+    if (platform::MayIUse(platform::avx512f)) {
+      math::VecActivations<T, platform::avx512f> act_functor;
+      fc_act = act_functor(fc_act_str);
+    } else if (platform::MayIUse(platform::avx)) {
       math::VecActivations<T, platform::avx> act_functor;
       fc_act = act_functor(fc_act_str);
     } else {
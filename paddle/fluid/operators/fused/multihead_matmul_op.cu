@@ -219,6 +219,11 @@ class MultiHeadMatMulV2Kernel : public framework::OpKernel<T> {
     Tensor multihead_temp_tensor;
     // B * head_number * S * S * 1 + B * S * 3 * N * H
     int scratch_size = batch * head_number * seq_len * seq_len * 1;
+    if (math::UseTiledAttention(seq_len, head_size)) {
+      // The tiled attention path never materializes the S x S score
+      // matrix, so the quadratic scratch buffer can be dropped.
+      scratch_size = 0;
+    }
     multihead_temp_tensor.Resize({scratch_size + temp_out_tensor.numel()});
     auto *multihead_temp_data =
         multihead_temp_tensor.mutable_data<T>(context.GetPlace());
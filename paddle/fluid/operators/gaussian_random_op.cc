@@ -12,11 +12,13 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License. */
 
+#include <cmath>
 #include <random>
 
 #include "paddle/fluid/framework/generator.h"
 #include "paddle/fluid/framework/op_registry.h"
 #include "paddle/fluid/framework/op_version_registry.h"
+#include "paddle/fluid/framework/philox_engine.h"
 #include "paddle/fluid/operators/fill_constant_op.h"
 #ifdef PADDLE_WITH_MKLDNN
 #include "paddle/fluid/platform/mkldnn_helper.h"
@@ -40,6 +42,38 @@ class CPUGaussianRandomKernel : public framework::OpKernel<T> {
     int64_t size = tensor->numel();
     T* data = tensor->mutable_data<T>(context.GetPlace());
     unsigned int seed = static_cast<unsigned int>(context.Attr<int>("seed"));
+#ifdef PADDLE_WITH_MKLML
+    if (size >= 8192) {
+      // Counter-based parallel fill: each Philox block is addressed by
+      // its index, so threads sample disjoint ranges independently and a
+      // fixed seed reproduces the same tensor at any thread count. One
+      // block yields two normal values through Box-Muller.
+      uint64_t philox_seed = seed;
+      if (philox_seed == 0) {
+        auto seed_engine = framework::GetCPURandomEngine(0);
+        philox_seed = (*seed_engine)();
+      }
+      framework::PhiloxEngine philox(philox_seed);
+      const int64_t num_blocks = (size + 1) / 2;
+      constexpr double kTwoPi = 6.283185307179586;
+#pragma omp parallel for
+      for (int64_t b = 0; b < num_blocks; ++b) {
+        auto block = philox(b);
+        // 1.0 - u maps [0, 1) to (0, 1] so the log argument is nonzero.
+        double u1 =
+            1.0 - framework::PhiloxEngine::Uniform01(block[0], block[1]);
+        double u2 = framework::PhiloxEngine::Uniform01(block[2], block[3]);
+        double radius = std::sqrt(-2.0 * std::log(u1));
+        int64_t i = b * 2;
+        data[i] = static_cast<T>(mean + std * radius * std::cos(kTwoPi * u2));
+        if (i + 1 < size) {
+          data[i + 1] =
+              static_cast<T>(mean + std * radius * std::sin(kTwoPi * u2));
+        }
+      }
+      return;
+    }
+#endif
     auto engine = framework::GetCPURandomEngine(seed);
 
     for (int64_t i = 0; i < size; ++i) {
@@ -11,6 +11,7 @@
 
 #pragma once
 #include <algorithm>
+#include <cstring>
 #include <string>
 #include <vector>
 #include "paddle/fluid/framework/op_registry.h"
@@ -98,6 +99,39 @@ static void NearestNeighborInterpolate(const Tensor& input, Tensor* output,
                                        const int out_h, const int out_w,
                                        const bool align_corners,
                                        const DataLayout& data_layout) {
+  if (data_layout == DataLayout::kNHWC) {
+    // NHWC keeps the c channels of one pixel contiguous, so each output
+    // pixel is a single contiguous copy of its source pixel. Precompute the
+    // source coordinates once per row/column and parallelize across output
+    // rows.
+    const int in_h = input.dims()[1];
+    const int in_w = input.dims()[2];
+    std::vector<int> vin_k(out_h), vin_l(out_w);
+    for (int k = 0; k < out_h; k++) {
+      vin_k[k] = (align_corners) ? static_cast<int>(ratio_h * k + 0.5)
+                                 : static_cast<int>(ratio_h * k);
+    }
+    for (int l = 0; l < out_w; l++) {
+      vin_l[l] = (align_corners) ? static_cast<int>(ratio_w * l + 0.5)
+                                 : static_cast<int>(ratio_w * l);
+    }
+    const T* in_data = input.data<T>();
+    T* out_data = output->data<T>();
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+    for (int idx = 0; idx < n * out_h; ++idx) {
+      const int i = idx / out_h;
+      const int k = idx % out_h;
+      const T* in_row = in_data + (i * in_h + vin_k[k]) * in_w * c;
+      T* out_row = out_data + (i * out_h + k) * out_w * c;
+      for (int l = 0; l < out_w; l++) {
+        std::memcpy(out_row + l * c, in_row + vin_l[l] * c, sizeof(T) * c);
+      }
+    }
+    return;
+  }
+
   auto input_t = EigenTensor<T, 4>::From(input);
   auto output_t = EigenTensor<T, 4>::From(*output);
   for (int k = 0; k < out_h; k++) {  // loop for images
@@ -283,6 +317,41 @@ static void BilinearInterpolation(const Tensor& input, Tensor* output,
     }
   }
 
+  if (data_layout == DataLayout::kNHWC) {
+    // NHWC keeps the c channels of one pixel contiguous, so interpolate
+    // whole pixels at a time: the innermost channel loop runs over
+    // unit-stride data and vectorizes, instead of striding by h * w as the
+    // channel-outer loop below would.
+    const T* in_data = input.data<T>();
+    T* out_data = output->data<T>();
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+    for (int idx = 0; idx < n * out_h; ++idx) {
+      const int i = idx / out_h;
+      const int k = idx % out_h;
+      const T* in_n = in_data + (i * in_h + vy_n[k]) * in_w * c;
+      const T* in_s = in_data + (i * in_h + vy_s[k]) * in_w * c;
+      T* out_row = out_data + (i * out_h + k) * out_w * c;
+      for (int l = 0; l < out_w; l++) {
+        const T* p_nw = in_n + vx_w[l] * c;
+        const T* p_ne = in_n + vx_e[l] * c;
+        const T* p_sw = in_s + vx_w[l] * c;
+        const T* p_se = in_s + vx_e[l] * c;
+        const float w_nw = vd_s[k] * vd_e[l];
+        const float w_ne = vd_s[k] * vd_w[l];
+        const float w_sw = vd_n[k] * vd_e[l];
+        const float w_se = vd_n[k] * vd_w[l];
+        T* out_pix = out_row + l * c;
+        for (int j = 0; j < c; j++) {
+          out_pix[j] = static_cast<T>(p_nw[j] * w_nw + p_sw[j] * w_sw +
+                                      p_ne[j] * w_ne + p_se[j] * w_se);
+        }
+      }
+    }
+    return;
+  }
+
 #ifdef PADDLE_WITH_MKLML
 #pragma omp parallel for collapse(4)
 #endif
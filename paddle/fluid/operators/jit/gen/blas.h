@@ -68,6 +68,7 @@ class VXXJitCode : public JitCode {
     return base;
   }
   void genCode() override;
+  bool IsRelocatable() const override { return true; }
 
  private:
   int num_;
@@ -116,6 +117,7 @@ class NCHW16CMulNCJitCode : public JitCode {
     this->genCode();
   }
   void genCode() override;
+  bool IsRelocatable() const override { return true; }
 };
 
 }  // namespace gen
@@ -53,6 +53,7 @@ class EmbSeqPoolJitCode : public JitCode {
     return base;
   }
   void genCode() override;
+  bool IsRelocatable() const override { return true; }
 
  private:
   int tbl_w_;
@@ -48,6 +48,7 @@ class HOPVJitCode : public JitCode {
     return base;
   }
   void genCode() override;
+  bool IsRelocatable() const override { return true; }
 
  protected:
   template <typename JMM>
@@ -0,0 +1,167 @@
+/* Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "paddle/fluid/operators/jit/gen/layernorm.h"
+
+#include <cstring>
+
+#include "paddle/fluid/operators/jit/registry.h"
+#include "paddle/fluid/platform/cpu_info.h"
+
+namespace paddle {
+namespace operators {
+namespace jit {
+namespace gen {
+
+void LayerNormJitCode::genCode() {
+  constexpr int block = ZMM_FLOAT_BLOCK;
+  const int num_blocks = d_ / block;
+  const int rest = d_ % block;
+  const int row_bytes = d_ * sizeof(float);
+
+  // The height is the seventh integer argument, which does not fit in
+  // registers; read it from the stack before anything else is pushed on it.
+  mov(reg_height, ptr[rsp + 8]);
+
+  // epsilon arrives in xmm0, broadcast it before xmm0 is used as scratch
+  vbroadcastss(zmm_eps, Xbyak::Xmm(0));
+  // 1 / d is a generation time constant; embed it as an immediate so the
+  // generated code stays position independent
+  const float reverse_d = 1.f / d_;
+  int reverse_d_bits;
+  std::memcpy(&reverse_d_bits, &reverse_d, sizeof(reverse_d));
+  mov(eax, reverse_d_bits);
+  vmovd(xmm_rev, eax);
+  vbroadcastss(zmm_rev, xmm_rev);
+  if (rest > 0) {
+    mov(eax, (1 << rest) - 1);
+    kmovw(k1, eax);
+  }
+
+  test(reg_height, reg_height);
+  jle("l_end", T_NEAR);
+
+  L("l_row");
+  // first pass: accumulate sum and sum of squares of the row
+  vxorps(zmm_sum, zmm_sum, zmm_sum);
+  vxorps(zmm_sq, zmm_sq, zmm_sq);
+  xor_(reg_off, reg_off);
+  if (num_blocks > 0) {
+    mov(reg_j, num_blocks);
+    L("l_sum");
+    vmovups(zmm_t0, ptr[param_x + reg_off]);
+    vaddps(zmm_sum, zmm_sum, zmm_t0);
+    vfmadd231ps(zmm_sq, zmm_t0, zmm_t0);
+    add(reg_off, block * sizeof(float));
+    dec(reg_j);
+    jnz("l_sum", T_NEAR);
+  }
+  if (rest > 0) {
+    vmovups(zmm_t0 | k1 | T_z, ptr[param_x + reg_off]);
+    vaddps(zmm_sum, zmm_sum, zmm_t0);
+    vfmadd231ps(zmm_sq, zmm_t0, zmm_t0);
+  }
+
+  // reduce both accumulators to scalars
+  vextractf64x4(ymm_t6, zmm_sum, 1);
+  vaddps(ymm_sum, ymm_sum, ymm_t6);
+  vextractf128(xmm_t6, ymm_sum, 1);
+  vaddps(xmm_sum, xmm_sum, xmm_t6);
+  vhaddps(xmm_sum, xmm_sum, xmm_sum);
+  vhaddps(xmm_sum, xmm_sum, xmm_sum);
+  vextractf64x4(ymm_t6, zmm_sq, 1);
+  vaddps(ymm_sq, ymm_sq, ymm_t6);
+  vextractf128(xmm_t6, ymm_sq, 1);
+  vaddps(xmm_sq, xmm_sq, xmm_t6);
+  vhaddps(xmm_sq, xmm_sq, xmm_sq);
+  vhaddps(xmm_sq, xmm_sq, xmm_sq);
+
+  // mean = sum / d, var = sum_sq / d - mean^2
+  vmulss(xmm_mean, xmm_sum, xmm_rev);
+  vmovss(ptr[param_mean], xmm_mean);
+  vmulss(xmm_sq, xmm_sq, xmm_rev);
+  vmulss(xmm_t6, xmm_mean, xmm_mean);
+  vsubss(xmm_sq, xmm_sq, xmm_t6);
+  vmovss(ptr[param_var], xmm_sq);
+  vaddss(xmm_std, xmm_sq, xmm_eps);
+  vsqrtss(xmm_std, xmm_std, xmm_std);
+  vbroadcastss(zmm_std, xmm_std);
+  vbroadcastss(zmm_mean, xmm_mean);
+
+  // second pass: normalize and apply the optional scale and bias
+  xor_(reg_off, reg_off);
+  if (num_blocks > 0) {
+    mov(reg_j, num_blocks);
+    L("l_norm");
+    vmovups(zmm_t0, ptr[param_x + reg_off]);
+    vsubps(zmm_t0, zmm_t0, zmm_mean);
+    vdivps(zmm_t0, zmm_t0, zmm_std);
+    test(param_scale, param_scale);
+    jz("l_no_scale", T_NEAR);
+    vmulps(zmm_t0, zmm_t0, ptr[param_scale + reg_off]);
+    L("l_no_scale");
+    test(param_bias, param_bias);
+    jz("l_no_bias", T_NEAR);
+    vaddps(zmm_t0, zmm_t0, ptr[param_bias + reg_off]);
+    L("l_no_bias");
+    vmovups(ptr[param_out + reg_off], zmm_t0);
+    add(reg_off, block * sizeof(float));
+    dec(reg_j);
+    jnz("l_norm", T_NEAR);
+  }
+  if (rest > 0) {
+    vmovups(zmm_t0 | k1 | T_z, ptr[param_x + reg_off]);
+    vsubps(zmm_t0, zmm_t0, zmm_mean);
+    vdivps(zmm_t0, zmm_t0, zmm_std);
+    test(param_scale, param_scale);
+    jz("l_no_scale_rest", T_NEAR);
+    vmulps(zmm_t0 | k1 | T_z, zmm_t0, ptr[param_scale + reg_off]);
+    L("l_no_scale_rest");
+    test(param_bias, param_bias);
+    jz("l_no_bias_rest", T_NEAR);
+    vaddps(zmm_t0 | k1 | T_z, zmm_t0, ptr[param_bias + reg_off]);
+    L("l_no_bias_rest");
+    vmovups(ptr[param_out + reg_off] | k1, zmm_t0);
+  }
+
+  add(param_x, row_bytes);
+  add(param_out, row_bytes);
+  add(param_mean, sizeof(float));
+  add(param_var, sizeof(float));
+  dec(reg_height);
+  jnz("l_row", T_NEAR);
+
+  L("l_end");
+  ret();
+}
+
+class LayerNormCreator : public JitCodeCreator<int> {
+ public:
+  bool CanBeUsed(const int& d) const override {
+    return platform::MayIUse(platform::avx512f) && d >= ZMM_FLOAT_BLOCK;
+  }
+  size_t CodeSize(const int& d) const override { return 96 + 150 * 8; }
+  std::unique_ptr<GenBase> CreateJitCode(const int& attr) const override {
+    return make_unique<LayerNormJitCode>(attr, CodeSize(attr));
+  }
+};
+
+}  // namespace gen
+}  // namespace jit
+}  // namespace operators
+}  // namespace paddle
+
+namespace gen = paddle::operators::jit::gen;
+
+REGISTER_JITKERNEL_GEN(kLayerNorm, gen::LayerNormCreator);
@@ -0,0 +1,88 @@
+/* Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <string>
+#include "glog/logging.h"
+#include "paddle/fluid/operators/jit/gen/jitcode.h"
+#include "paddle/fluid/platform/enforce.h"
+
+namespace paddle {
+namespace operators {
+namespace jit {
+namespace gen {
+
+// Fused layer normalization over rows of width d_: mean and variance are
+// accumulated in a single read pass (sum and sum of squares), then a second
+// pass normalizes and applies the optional scale and bias. The row tail is
+// handled with an opmask register, so any d_ >= ZMM_FLOAT_BLOCK works.
+class LayerNormJitCode : public JitCode {
+ public:
+  explicit LayerNormJitCode(int d, size_t code_size = 256 * 1024,
+                            void* code_ptr = nullptr)
+      : JitCode(code_size, code_ptr), d_(d) {
+    PADDLE_ENFORCE_GE(d, ZMM_FLOAT_BLOCK,
+                      platform::errors::InvalidArgument(
+                          "The width of LayerNorm should be at least %d of "
+                          "current size %d.",
+                          ZMM_FLOAT_BLOCK, d));
+    this->genCode();
+  }
+
+  std::string name() const override {
+    return "LayerNormJitCode_D" + std::to_string(d_);
+  }
+  void genCode() override;
+  bool IsRelocatable() const override { return true; }
+
+ private:
+  int d_;
+
+  reg64_t param_x{abi_param1};
+  reg64_t param_out{abi_param2};
+  reg64_t param_mean{abi_param3};
+  reg64_t param_var{abi_param4};
+  reg64_t param_scale{abi_param5};
+  reg64_t param_bias{abi_param6};
+
+  reg32_t reg_height{r10d};
+  reg32_t reg_j{r11d};
+  reg64_t reg_off{rax};
+
+  zmm_t zmm_t0 = zmm_t(0);
+  zmm_t zmm_sum = zmm_t(1);
+  zmm_t zmm_sq = zmm_t(2);
+  zmm_t zmm_mean = zmm_t(3);
+  zmm_t zmm_std = zmm_t(4);
+  zmm_t zmm_rev = zmm_t(5);
+  zmm_t zmm_eps = zmm_t(7);
+
+  ymm_t ymm_sum = ymm_t(1);
+  ymm_t ymm_sq = ymm_t(2);
+  ymm_t ymm_t6 = ymm_t(6);
+
+  xmm_t xmm_sum = xmm_t(1);
+  xmm_t xmm_sq = xmm_t(2);
+  xmm_t xmm_mean = xmm_t(3);
+  xmm_t xmm_std = xmm_t(4);
+  xmm_t xmm_rev = xmm_t(5);
+  xmm_t xmm_t6 = xmm_t(6);
+  xmm_t xmm_eps = xmm_t(7);
+};
+
+}  // namespace gen
+}  // namespace jit
+}  // namespace operators
+}  // namespace paddle
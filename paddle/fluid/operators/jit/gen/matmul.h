@@ -47,6 +47,7 @@ class MatMulJitCode : public JitCode {
     return base;
   }
   void genCode() override;
+  bool IsRelocatable() const override { return true; }
 
  private:
   int m_, n_, k_;
@@ -35,6 +35,7 @@ class SgdJitCode : public JitCode {
 
   DECLARE_JIT_CODE(SgdJitCode);
   void genCode() override;
+  bool IsRelocatable() const override { return true; }
   void mainCode(int num_regs);
 
  private:
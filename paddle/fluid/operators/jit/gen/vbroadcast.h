@@ -34,6 +34,7 @@ class VBroadcastJitCode : public JitCode {
 
   DECLARE_JIT_CODE(VBroadcastJitCode);
   void genCode() override;
+  bool IsRelocatable() const override { return true; }
 
  private:
   int w_;
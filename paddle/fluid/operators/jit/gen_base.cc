@@ -14,16 +14,24 @@
 
 #include "paddle/fluid/operators/jit/gen_base.h"
 
+#include <cstdio>  // for rename
 #include <fstream>
 #include "paddle/fluid/memory/allocation/cpu_allocator.h"  // for posix_memalign
 #include "paddle/fluid/platform/cpu_info.h"
 #include "paddle/fluid/platform/enforce.h"
 
 #ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #define posix_memalign_free free
 #endif
 
 DEFINE_bool(dump_jitcode, false, "Whether to dump the jitcode to file");
+DEFINE_string(jitcode_cache_dir, "",
+              "Directory used as a persistent cache of jit generated kernels. "
+              "Empty (the default) disables the cache.");
 
 namespace paddle {
 namespace operators {
@@ -60,6 +68,85 @@ void* GenBase::operator new(size_t size) {
 
 void GenBase::operator delete(void* ptr) { posix_memalign_free(ptr); }
 
+LoadedGenBase::~LoadedGenBase() {
+#ifndef _WIN32
+  if (code_) {
+    munmap(code_, size_);
+  }
+#endif
+}
+
+namespace {
+
+// Bitmask of the ISA extensions available on this machine. Code generated
+// for one instruction set must not be reused on a machine with another one,
+// so the mask is part of the cache file name.
+size_t CpuFeatureMask() {
+  size_t mask = 0;
+  for (int isa = platform::sse42; isa <= platform::avx512_bf16; ++isa) {
+    if (platform::MayIUse(static_cast<platform::cpu_isa_t>(isa))) {
+      mask |= (1ULL << isa);
+    }
+  }
+  return mask;
+}
+
+std::string JitCodeCachePath(KernelType kt, int64_t attr_key) {
+  std::ostringstream path;
+  path << FLAGS_jitcode_cache_dir << "/jitcode_" << static_cast<int>(kt) << "_"
+       << attr_key << "_" << std::hex << CpuFeatureMask() << ".bin";
+  return path.str();
+}
+
+}  // namespace
+
+bool JitCodeCacheEnabled() { return !FLAGS_jitcode_cache_dir.empty(); }
+
+std::unique_ptr<GenBase> LoadJitCode(KernelType kt, int64_t attr_key) {
+#ifndef _WIN32
+  const std::string path = JitCodeCachePath(kt, attr_key);
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return nullptr;
+  }
+  void* code =
+      mmap(nullptr, st.st_size, PROT_READ | PROT_EXEC, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (code == MAP_FAILED) {
+    return nullptr;
+  }
+  VLOG(6) << "Loaded jitcode from " << path;
+  return std::unique_ptr<GenBase>(
+      new LoadedGenBase(code, static_cast<size_t>(st.st_size)));
+#else
+  return nullptr;
+#endif
+}
+
+void SaveJitCode(KernelType kt, int64_t attr_key, const GenBase& kernel) {
+#ifndef _WIN32
+  const std::string path = JitCodeCachePath(kt, attr_key);
+  // Write to a process-private file first so that concurrent processes
+  // sharing the cache directory never observe a partially written blob.
+  const std::string tmp_path = path + "." + std::to_string(getpid()) + ".tmp";
+  std::ofstream fout(tmp_path, std::ios::out | std::ios::binary);
+  if (!fout.is_open()) {
+    return;
+  }
+  fout.write(reinterpret_cast<const char*>(kernel.getCodeInternal()),
+             kernel.getSize());
+  fout.close();
+  if (fout.fail() || rename(tmp_path.c_str(), path.c_str()) != 0) {
+    remove(tmp_path.c_str());
+  }
+#endif
+}
+
 std::vector<int> packed_groups(int n, int k, int* block_out, int* rest_out) {
   int block;
   int max_num_regs;
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>  // for unique_ptr
 #include <string>
 #include <vector>
@@ -22,6 +23,7 @@
 #include "paddle/fluid/operators/jit/kernel_base.h"
 
 DECLARE_bool(dump_jitcode);
+DECLARE_string(jitcode_cache_dir);
 
 namespace paddle {
 namespace operators {
@@ -33,6 +35,11 @@ class GenBase : public Kernel {
   virtual std::string name() const = 0;
   virtual size_t getSize() const = 0;
   virtual const unsigned char* getCodeInternal() const = 0;
+  // Whether the generated code references only its own instructions and
+  // stack, so the raw blob stays valid when mapped at a different address
+  // in another process. Generators which embed absolute addresses, e.g. of
+  // the activation constant tables, must keep the default.
+  virtual bool IsRelocatable() const { return false; }
   const char* ImplType() const override { return "JitCode"; }
   template <typename Func>
   Func getCode() const {
@@ -54,6 +61,33 @@ class GenBase : public Kernel {
   void dumpCode(const unsigned char* code) const;
 };
 
+// A kernel restored from the persistent jitcode cache. The code blob is
+// mapped directly from the cache file as executable memory and unmapped
+// on destruction.
+class LoadedGenBase : public GenBase {
+ public:
+  LoadedGenBase(void* code, size_t size) : code_(code), size_(size) {}
+  ~LoadedGenBase();
+  std::string name() const override { return "LoadedJitCode"; }
+  size_t getSize() const override { return size_; }
+  const unsigned char* getCodeInternal() const override {
+    return static_cast<const unsigned char*>(code_);
+  }
+  bool IsRelocatable() const override { return true; }
+
+ private:
+  void* code_;
+  size_t size_;
+};
+
+// Persistent on-disk cache of generated kernels, disabled unless
+// FLAGS_jitcode_cache_dir points to an existing writable directory. Cache
+// files are keyed by kernel type, attribute key and the CPU feature mask,
+// and only kernels whose generator reports IsRelocatable() are stored.
+bool JitCodeCacheEnabled();
+std::unique_ptr<GenBase> LoadJitCode(KernelType kt, int64_t attr_key);
+void SaveJitCode(KernelType kt, int64_t attr_key, const GenBase& kernel);
+
 // Creator is used to creat the jitcode and save in pool.
 // Every JitCode should have one creator.
 class GenCreator {
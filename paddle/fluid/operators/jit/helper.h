@@ -47,6 +47,16 @@ GetJitCode(const typename KernelTuple::attr_type& attr) {
     return codes.AllKernels().at(key).get();
   }
 
+  // Check the persistent cache before spending time regenerating the code.
+  if (JitCodeCacheEnabled()) {
+    auto loaded = LoadJitCode(KernelTuple::kernel_type, key);
+    if (loaded) {
+      auto res = loaded.get();
+      codes.Insert(key, std::move(loaded));
+      return res;
+    }
+  }
+
   // creator is not related with attr, so can use KernelKey as key
   KernelKey kkey(KernelTuple::kernel_type, PlaceType());
   // pool: (KernelKey(type, place), vector<GenCreatorPtr>)
@@ -60,6 +70,10 @@ GetJitCode(const typename KernelTuple::attr_type& attr) {
         auto p = i->CreateJitCode(attr);
         if (p) {
           auto res = p.get();
+          // Only position independent code is valid in another process.
+          if (JitCodeCacheEnabled() && p->IsRelocatable()) {
+            SaveJitCode(KernelTuple::kernel_type, key, *p);
+          }
           codes.Insert(key, std::move(p));
           return res;
         }
@@ -0,0 +1,436 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include "paddle/fluid/framework/ddim.h"
+
+// CPU backend of the data mover primitives. The API mirrors
+// datamover_primitives.h so that a kernel written against these building
+// blocks compiles for both devices. On CPU one logical thread processes the
+// whole NX * NY tile, so the thread offset of the CUDA backend is always
+// zero and the contiguous loads and stores become plain memcpy, which the
+// compiler turns into vector moves.
+
+namespace paddle {
+namespace operators {
+namespace kernel_primitives {
+namespace details {
+
+template <typename T, int VecSize>
+struct alignas(sizeof(T) * VecSize) VectorType {
+  T val[VecSize];
+};
+
+/**
+ * Configuration of broadcast. Calculate the input data index according to the
+ * index of the output data. if input or output shape is [dim0, dim1] then dims
+ * must be [dim1, dim0]. On CPU the hardware divider is fast, so plain
+ * division replaces the multiply-shift trick of the CUDA backend.
+ */
+template <int kDims>
+struct BroadcastConfig {
+  uint32_t divisors[kDims];
+  uint32_t strides[framework::DDim::kMaxRank];
+  BroadcastConfig() {}
+
+  BroadcastConfig(const std::vector<int64_t>& out_dims,
+                  const std::vector<int64_t>& in_dims, int dim_size) {
+    std::vector<uint32_t> strides_in;
+    std::vector<uint32_t> divisors_in;
+    // for divisors
+    divisors_in.resize(dim_size);
+    for (int i = 0; i < dim_size; ++i) {
+      divisors_in[i] = static_cast<uint32_t>(out_dims[i]);
+    }
+    // for strides
+    strides_in.resize(dim_size, 1);
+    for (int i = 0; i < dim_size; ++i) {
+      strides_in[i] = in_dims[i] == 1 ? 0 : strides_in[i];
+      strides_in[i] =
+          (i != 0 && strides_in[i] != 0)
+              ? std::accumulate(in_dims.begin(), in_dims.begin() + i, 1,
+                                std::multiplies<int64_t>())
+              : strides_in[i];
+    }
+
+    memcpy(strides, strides_in.data(), kDims * sizeof(uint32_t));
+    memcpy(divisors, divisors_in.data(), kDims * sizeof(uint32_t));
+  }
+};
+
+}  // namespace details
+
+/**
+ * @brief Read 2D data from global memory to register according to Tx type, and
+ * store it as Ty type into register.
+ *
+ * @template paraments
+ * Tx: The type of data stored in the global memory.
+ * Ty: The type of data that needs to be stored in registers.
+ * NX: The number of data columns loaded by each thread.
+ * NY: The number of data rows loaded by each thread.
+ * BlockSize: Unused on CPU, kept for signature compatibility with the CUDA
+ * backend.
+ * IsBoundary: Indicates whether to perform access out-of-bounds judgment.
+ * When the number of data processed by the tile is less than NX x NY,
+ * boundary judgment is required to avoid memory access crossing the boundary.
+ *
+ * @param：
+ * dst: The register pointer of the thread, the size is NX * NY.
+ * src: The data pointer of the current tile.
+ * size_nx: The maximum offset of the current tile is size_nx elements in the
+ * lowest dimension. The parameters are only calculated when isboundary = true.
+ * size_ny: The maximum offset of the current tile is size_ny elements in the
+ * first dimension. The parameters are only calculated when isboundary = true.
+ * stride_nx: Each read one element stride stride_nx elements in the last dim.
+ * stride_ny: Each read one element stride stride_ny elements in the first dim.
+ */
+template <typename Tx, typename Ty, int NX, int NY, int BlockSize,
+          bool IsBoundary = false>
+inline void ReadData(Ty* dst, const Tx* __restrict__ src, int size_nx,
+                     int size_ny, int stride_nx, int stride_ny) {
+  for (int idx = 0; idx < NX; ++idx) {
+    if (IsBoundary) {
+      if (idx * stride_nx >= size_nx) {
+        break;
+      }
+    }
+    for (int idy = 0; idy < NY; ++idy) {
+      if (IsBoundary) {
+        if (idy * stride_ny >= size_ny) {
+          break;
+        }
+      }
+      dst[idy * NX + idx] =
+          static_cast<Ty>(src[idx * stride_nx + idy * stride_ny]);
+    }
+  }
+}
+
+/**
+ * @brief Initialize register with init_data.
+ *
+ * @template paraments
+ * T: Data type of register.
+ * NX: Number of data to initialize.
+ *
+ * @param：
+ * dst: The register pointer of the thread, the size is NX.
+ * init_data: Initial value.
+ */
+template <typename T, int NX>
+inline void Init(T* dst, T init_data) {
+  for (int i = 0; i < NX; i++) {
+    dst[i] = init_data;
+  }
+}
+
+/**
+ * @brief Read 1D data from global memory to register. The tile is contiguous,
+ * so the full read is a single memcpy that compiles to vector loads.
+ *
+ * @template paraments
+ * T: The type of data.
+ * NX: Each thread load NX data from global memory continuously.
+ * NY: Each thread need to load NY rows, only NY = 1 was supported.
+ * BlockSize: Unused on CPU, kept for signature compatibility with the CUDA
+ * backend.
+ * IsBoundary: Whether to make an out-of-bounds judgment on access to memory.
+ * When the number of data processed by this tile is less than NX x NY,
+ * boundary judgment is required to avoid memory access crossing the boundary.
+ *
+ * @param：
+ * dst: The register pointer of the thread, the size is NX * NY.
+ * src: The data pointer of the current tile.
+ * num: The current tile needs to load num data continuously.
+ */
+template <typename T, int NX, int NY, int BlockSize, bool IsBoundary = false>
+inline void ReadData(T* dst, const T* __restrict__ src, int num) {
+  if (IsBoundary) {  // num < NX
+    for (int idx = 0; idx < NX; ++idx) {
+      if (idx < num) {
+        dst[idx] = src[idx];
+      }
+    }
+  } else {  // num >= NX
+    std::memcpy(dst, src, NX * sizeof(T));
+  }
+}
+
+/**
+ * @brief Read 2D data from global memory to registers with broadcast form.
+ *
+ * @template paraments
+ * T: The type of data stored in the global memory.
+ * NX: The number of data columns loaded by each thread.
+ * NY: The number of data rows loaded by each thread.
+ * BlockSize: Unused on CPU, kept for signature compatibility with the CUDA
+ * backend.
+ * Rank: The shape size of out. eg in[1, 35], out[32, 35] then shape size is 2.
+ * IsBoundary: Indicates whether to perform access out-of-bounds judgment.
+ *
+ * @param：
+ * dst: The register pointer of the thread, the size is NX * NY.
+ * src: The original input data pointer of this kernel.
+ * block_offset: The data offset of this tile.
+ * config: Calculation configuration of broadcast. It is used to calculate the
+ * coordinate mapping relationship between output data and input data.
+ * total_num_output: Total number of original output.
+ * stride_nx: Each read one element stride stride_nx elements in the last dim.
+ * stride_ny: Each read one element stride stride_ny elements in the first dim.
+ */
+template <typename T, int NX, int NY, int BlockSize, int Rank,
+          bool IsBoundary = false>
+inline void ReadDataBc(T* dst, const T* __restrict__ src, uint32_t block_offset,
+                       details::BroadcastConfig<Rank> config,
+                       int total_num_output, int stride_nx, int stride_ny) {
+  uint32_t index_src = 0;
+
+  for (int ny = 0; ny < NY; ++ny) {
+    for (uint32_t nx = 0; nx < NX; ++nx) {
+      uint32_t index_output = block_offset + ny * stride_ny + nx * stride_nx;
+      index_src = 0;
+      if (IsBoundary) {
+        if (index_output >= static_cast<uint32_t>(total_num_output)) {
+          break;
+        }
+      }
+      for (int i = 0; i < Rank; ++i) {
+        uint32_t quotient = index_output / config.divisors[i];
+        index_src += (index_output - quotient * config.divisors[i]) *
+                     config.strides[i];
+        index_output = quotient;
+      }
+      dst[nx + ny * NX] = src[index_src];
+    }
+  }
+}
+
+/**
+ * @brief Read 2D data from global memory to register with reduce form.
+ *
+ * @template paraments
+ * T: The type of data.
+ * NX: The number of data columns loaded by each thread.
+ * NY: The number of data rows loaded by each thread.
+ * BlockSize: Unused on CPU, kept for signature compatibility with the CUDA
+ * backend.
+ * Rank: The shape size of out. eg in[1, 35], out[32, 35] then shape size is 2.
+ * IndexCal: Functor mapping a flat output index to the input index.
+ * IsBoundary: Indicates whether to perform access out-of-bounds judgment.
+ *
+ * @param
+ * dst: The register pointer of the thread, the size is NX * NY.
+ * src: The input data pointer of this tile.
+ * block_offset: The data offset of this tile.
+ * index_cal: Calculation configuration of Reduce. It is used to calculate the
+ * coordinate mapping relationship between output data and input data.
+ * size_nx: The current tile needs to load size_nx columns of data, this
+ * parameter will participate in the calculation when isboundary = true.
+ * size_ny: The current tile needs to load size_ny rows of data, this parameter
+ * will participate in the calculation when isboundary = true.
+ * stride_nx: Each read one element stride stride_nx columns.
+ * stride_ny: Each read one element stride stride_ny raws.
+ * reduce_last_dim: Used to indicate whether the dimension of reduce contains
+ * the lowest dimension.
+ */
+template <typename T, int NX, int NY, int BlockSize, int Rank,
+          typename IndexCal, bool IsBoundary = false>
+inline void ReadDataReduce(T* dst, const T* __restrict__ src, int block_offset,
+                           const IndexCal& index_cal, int size_nx, int size_ny,
+                           int stride_nx, int stride_ny,
+                           bool reduce_last_dim) {
+  int thread_offset = 0;
+
+  if (NX == 1) {
+    for (int ny = 0; ny < NY; ++ny) {
+      if (IsBoundary) {
+        if (thread_offset >= size_ny) {
+          break;
+        }
+      }
+      uint32_t index_src = index_cal(thread_offset + block_offset);
+      dst[ny] = src[index_src];
+      thread_offset += stride_ny;
+    }
+  } else {
+    for (int nx = 0; nx < NX; ++nx) {
+      for (int ny = 0; ny < NY; ++ny) {
+        if (IsBoundary) {
+          if ((thread_offset >= size_ny) || (nx * stride_nx >= size_nx)) {
+            break;
+          }
+        }
+        uint32_t index_src = index_cal(thread_offset + block_offset);
+        dst[nx + ny * NX] = src[index_src];
+        thread_offset += stride_ny;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Write 1D data from registers to global memory. The tile is
+ * contiguous, so the full write is a single memcpy that compiles to vector
+ * stores.
+ *
+ * @template paraments
+ * T: The type of data.
+ * NX: The number of data continuously writed by each thread.
+ * NY: The number of data rows loaded by each thread, only NY = 1 was supported.
+ * BlockSize: Unused on CPU, kept for signature compatibility with the CUDA
+ * backend.
+ * IsBoundary: Indicates whether to perform access out-of-bounds judgment.
+ *
+ * @param：
+ * dst: The data pointer of the current tile.
+ * src: The register pointer, the size is NX * NY.
+ * num: The current tile needs to store num elements continuously.
+ */
+template <typename T, int NX, int NY, int BlockSize, bool IsBoundary = false>
+inline void WriteData(T* dst, T* __restrict__ src, int num) {
+  if (IsBoundary) {
+    for (int idx = 0; idx < NX; ++idx) {
+      if (idx < num) {
+        dst[idx] = src[idx];
+      }
+    }
+  } else {
+    std::memcpy(dst, src, NX * sizeof(T));
+  }
+}
+
+/**
+ * @brief Write 2D data from register to global memory according to Tx type, and
+ * store it as Ty type.
+ *
+ * @template paraments
+ * Tx: The type of data that needs to be stored in registers.
+ * Ty: The type of data that stored in the global memory.
+ * NX: The number of data columns loaded by each thread.
+ * NY: The number of data rows loaded by each thread.
+ * BlockSize: Unused on CPU, kept for signature compatibility with the CUDA
+ * backend.
+ * IsBoundary: Indicates whether to perform access out-of-bounds judgment.
+ *
+ * @param：
+ * dst: The data pointer of the current tile.
+ * src: The register pointer of the thread, the size is NX * NY.
+ * size_nx: The maximum offset of the current tile is size_nx elements in the
+ * lowest dimension. The parameters are only calculated when isboundary = true.
+ * size_ny: The maximum offset of the current tile is size_ny elements in the
+ * first dimension. The parameters are only calculated when isboundary = true.
+ * stride_nx: Each read one element stride stride_nx elements in the last dim.
+ * stride_ny: Each read one element stride stride_ny elements in the first dim.
+ */
+template <typename Tx, typename Ty, int NX, int NY, int BlockSize,
+          bool IsBoundary = false>
+inline void WriteData(Ty* dst, const Tx* __restrict__ src, int size_nx,
+                      int size_ny, int stride_nx, int stride_ny) {
+  for (int idx = 0; idx < NX; ++idx) {
+    if (IsBoundary) {
+      if (idx * stride_nx >= size_nx) {
+        break;
+      }
+    }
+    for (int idy = 0; idy < NY; ++idy) {
+      if (IsBoundary) {
+        if (idy * stride_ny >= size_ny) {
+          break;
+        }
+      }
+      dst[idx * stride_nx + idy * stride_ny] =
+          static_cast<Ty>(src[idy * NX + idx]);
+    }
+  }
+}
+
+/**
+ * @brief Initialize register with init_data.
+ *
+ * @template paraments
+ * T: Data type of register.
+ * NX: Number of data to initialize.
+ *
+ * @param：
+ * dst: The register pointer of the thread, the size is NX.
+ * init_data: The register pointer of init data, the size is NX.
+ */
+template <typename T, int NX, bool IsBoundary = false>
+inline void Init(T* dst, T* init_data, int num) {
+  for (int i = 0; i < NX; i++) {
+    if (IsBoundary) {
+      if (i >= num) {
+        break;
+      }
+    }
+    dst[i] = init_data[i];
+  }
+}
+
+/**
+ * @brief Read 1D data from global memory to register with broadcast form.
+ *
+ * @template paraments
+ * T: The type of data stored in the global memory.
+ * NX: The number of data continuously loaded by each thread.
+ * NY: The number of data rows loaded by each thread, only NY = 1 was supported.
+ * BlockSize: Unused on CPU, kept for signature compatibility with the CUDA
+ * backend.
+ * Rank: The shape size of out. eg in[1, 35], out[32, 35] then shape size is 2.
+ * IsBoundary: Indicates whether to perform access out-of-bounds judgment.
+ *
+ * @param：
+ * dst: The register pointer of the thread, the size is NX * NY.
+ * src: The original input data pointer of kernel.
+ * block_offset: The data offset of this tile.
+ * config: Calculation configuration of broadcast. It is used to calculate the
+ * coordinate mapping relationship between output data and input data.
+ * total_num_output: Total number of original output.
+ */
+template <typename T, int NX, int NY, int BlockSize, int Rank,
+          bool IsBoundary = false>
+inline void ReadDataBc(T* dst, const T* __restrict__ src, uint32_t block_offset,
+                       details::BroadcastConfig<Rank> config,
+                       int total_num_output) {
+  uint32_t index_src = 0;
+
+  for (uint32_t nx = 0; nx < NX; ++nx) {
+    uint32_t index_output = block_offset + nx;
+    index_src = 0;
+    if (IsBoundary) {
+      if (index_output >= static_cast<uint32_t>(total_num_output)) {
+        break;
+      }
+    }
+    for (int i = 0; i < Rank; ++i) {
+      uint32_t quotient = index_output / config.divisors[i];
+      index_src +=
+          (index_output - quotient * config.divisors[i]) * config.strides[i];
+      index_output = quotient;
+    }
+    dst[nx] = src[index_src];
+  }
+}
+
+}  // namespace kernel_primitives
+}  // namespace operators
+}  // namespace paddle
@@ -14,10 +14,18 @@
 
 #pragma once
 
+// The CUDA and CPU backends implement the same primitive API, so a kernel
+// written against these building blocks compiles for both devices. The CUDA
+// headers contain device code and can only be parsed by the device compiler.
+#if defined(__NVCC__) || defined(__HIPCC__)
 #include "paddle/fluid/operators/kernel_primitives/compute_primitives.h"
 #include "paddle/fluid/operators/kernel_primitives/datamover_primitives.h"
 #include "paddle/fluid/operators/kernel_primitives/functor_primitives.h"
 #include "paddle/fluid/operators/kernel_primitives/helper_primitives.h"
+#else
+#include "paddle/fluid/operators/kernel_primitives/compute_primitives_cpu.h"
+#include "paddle/fluid/operators/kernel_primitives/datamover_primitives_cpu.h"
+#endif
 
 namespace paddle {
 namespace operators {
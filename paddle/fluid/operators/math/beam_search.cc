@@ -227,8 +227,6 @@ class BeamSearchFunctor<platform::CPUDeviceContext, T> {
       const framework::LoDTensor *pre_scores, const framework::LoDTensor *ids,
       const framework::LoDTensor *scores, size_t lod_level, size_t beam_size,
       int end_id, bool is_accumulated) {
-    std::vector<std::vector<Item>> result;
-
     // find the current candidates
     auto abs_lod = framework::ToAbsOffset(scores->lod());
 
@@ -244,7 +242,15 @@ class BeamSearchFunctor<platform::CPUDeviceContext, T> {
       seq_width *= scores->dims()[i];
     }
 
-    for (size_t seq_id = 0; seq_id < num_seqs; ++seq_id) {
+    // The top beam of each source sentence is selected independently, so the
+    // sentences of the batch are partitioned over the thread pool instead of
+    // being scanned one after another.
+    std::vector<std::vector<Item>> result(num_seqs);
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+    for (int64_t seq_id = 0; seq_id < static_cast<int64_t>(num_seqs);
+         ++seq_id) {
       size_t seq_offset_start = abs_lod[lod_level][seq_id];
       size_t seq_offset_end = abs_lod[lod_level][seq_id + 1];
 
@@ -273,7 +279,7 @@ class BeamSearchFunctor<platform::CPUDeviceContext, T> {
         }
       }
 
-      result.emplace_back(top_beam);
+      result[seq_id] = std::move(top_beam);
     }
 
     if (FLAGS_v == 3) {
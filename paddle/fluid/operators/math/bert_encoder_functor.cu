@@ -470,6 +470,112 @@ __global__ void SoftmaxKernelWithEltaddForLarge2(
 #endif
 }
 
+// Tiled attention with online softmax renormalization. One block owns one
+// query row and streams K tiles through shared memory, so the S x S score
+// matrix is never materialized; the running softmax maximum and sum are
+// renormalized as each tile arrives. Layouts match the batched-GEMM path:
+// q/k/v are [B, N, S, H], bias_qk is [B, N, S, S], and the output row is
+// written back over the query row once the block is done with it.
+template <typename T, int TPB, int KTILE>
+__global__ void TiledAttentionKernel(const T *q_buf, const T *k_buf,
+                                     const T *v_buf, const T *bias_qk, T *dst,
+                                     int seq_len, int head_size, float scale) {
+  constexpr int kMaxDimsPerThread = 2;
+  extern __shared__ float smem[];
+  float *q_smem = smem;                        // head_size
+  float *k_smem = q_smem + head_size;          // KTILE * head_size
+  float *scores = k_smem + KTILE * head_size;  // KTILE
+
+  const int query_id = blockIdx.x;
+  const int bh = blockIdx.y;
+  const T *q_row = q_buf + (bh * seq_len + query_id) * head_size;
+  const T *k_base = k_buf + bh * seq_len * head_size;
+  const T *v_base = v_buf + bh * seq_len * head_size;
+  const T *bias_row = bias_qk + (bh * seq_len + query_id) * seq_len;
+  T *dst_row = dst + (bh * seq_len + query_id) * head_size;
+
+  // The scale of the QK product is folded into the cached query row.
+  for (int i = threadIdx.x; i < head_size; i += TPB) {
+    q_smem[i] = static_cast<float>(q_row[i]) * scale;
+  }
+
+  float acc[kMaxDimsPerThread];
+#pragma unroll
+  for (int d = 0; d < kMaxDimsPerThread; ++d) {
+    acc[d] = 0.f;
+  }
+  float m = -1e20f;
+  float l = 0.f;
+
+  for (int tile = 0; tile < seq_len; tile += KTILE) {
+    const int nk = min(KTILE, seq_len - tile);
+    __syncthreads();
+    for (int i = threadIdx.x; i < nk * head_size; i += TPB) {
+      k_smem[i] = static_cast<float>(k_base[tile * head_size + i]);
+    }
+    __syncthreads();
+    for (int j = threadIdx.x; j < nk; j += TPB) {
+      float dot = 0.f;
+      for (int i = 0; i < head_size; ++i) {
+        dot += q_smem[i] * k_smem[j * head_size + i];
+      }
+      scores[j] = dot + static_cast<float>(bias_row[tile + j]);
+    }
+    __syncthreads();
+    // Every thread rescans the staged scores so all of them hold the same
+    // running maximum and sum without extra block reductions.
+    float tile_max = -1e20f;
+    for (int j = 0; j < nk; ++j) {
+      tile_max = fmaxf(tile_max, scores[j]);
+    }
+    const float new_m = fmaxf(m, tile_max);
+    const float rescale = __expf(m - new_m);
+    m = new_m;
+    l *= rescale;
+#pragma unroll
+    for (int d = 0; d < kMaxDimsPerThread; ++d) {
+      acc[d] *= rescale;
+    }
+    for (int j = 0; j < nk; ++j) {
+      const float p = __expf(scores[j] - m);
+      l += p;
+      const T *v_row = v_base + (tile + j) * head_size;
+      int h = threadIdx.x;
+#pragma unroll
+      for (int d = 0; d < kMaxDimsPerThread; ++d, h += TPB) {
+        if (h < head_size) {
+          acc[d] += p * static_cast<float>(v_row[h]);
+        }
+      }
+    }
+  }
+
+  const float inv_sum = 1.f / (l + 1e-6f);
+  int h = threadIdx.x;
+#pragma unroll
+  for (int d = 0; d < kMaxDimsPerThread; ++d, h += TPB) {
+    if (h < head_size) {
+      dst_row[h] = static_cast<T>(acc[d] * inv_sum);
+    }
+  }
+}
+
+template <typename T>
+inline void TiledAttention(const platform::CUDADeviceContext &context,
+                           int head_num, int seq_len, int size_per_head,
+                           int batch_size, const T *q_buf, const T *k_buf,
+                           const T *v_buf, const T *bias_qk, T *dst,
+                           float scale) {
+  constexpr int kTPB = 128;
+  constexpr int kKTile = 32;
+  const dim3 grid(seq_len, batch_size * head_num);
+  const int smem_size =
+      (size_per_head * (kKTile + 1) + kKTile) * sizeof(float);
+  TiledAttentionKernel<T, kTPB, kKTile><<<grid, kTPB, smem_size,
+                                          context.stream()>>>(
+      q_buf, k_buf, v_buf, bias_qk, dst, seq_len, size_per_head, scale);
+}
+
 template <typename T>
 inline void MatMulWithHeadQK(const platform::CUDADeviceContext &context,
                              int head_num, int seq_len, int size_per_head,
@@ -571,6 +677,13 @@ void MultiHeadGPUComputeFunctor<T>::operator()(
   T *qptr = tptr;
   T *kptr = qptr + tsize;
   T *vptr = kptr + tsize;
+  if (UseTiledAttention(seq_len, head_size)) {
+    // Long sequences stream K/V tiles with online softmax; qkptr is never
+    // touched, so callers may skip the S x S scratch allocation entirely.
+    TiledAttention<T>(dev_ctx, head_num, seq_len, head_size, batch, qptr, kptr,
+                      vptr, bias_qk_ptr, static_cast<float>(alpha));
+    return;
+  }
   // batch gemm stride, softmaxwithscale.
   MatMulWithHeadQK<T>(dev_ctx, head_num, seq_len, head_size, batch, false, true,
                       qptr, kptr, qkptr, bias_qk_ptr, alpha, beta);
@@ -80,6 +80,14 @@ class EmbEltwiseLayerNormFunctor {
 //             matmul
 //               |
 
+// True when MultiHeadGPUComputeFunctor takes the tiled online-softmax
+// attention path, which streams K/V tiles through shared memory and never
+// materializes the S x S score matrix, so the batch * head * S * S scratch
+// buffer (qkptr) is not needed.
+inline bool UseTiledAttention(int seq_len, int head_size) {
+  return seq_len > 1024 && head_size <= 256;
+}
+
 template <typename T>
 class MultiHeadGPUComputeFunctor {
  public:
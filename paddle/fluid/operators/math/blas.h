@@ -120,6 +120,14 @@ class Blas {
   template <typename T>
   void GEMM_FREE(T* data) const;
 
+  // Computes C = A * B where B is the packed image of the weight matrix
+  // produced by GEMM_PACK. Using the packed image saves the internal
+  // re-packing cblas_?gemm performs on every call, which pays off when the
+  // same weight matrix is multiplied many times (inference).
+  template <typename T>
+  void PackedGEMM(int M, int N, int K, const T* A, const T* packed_B,
+                  T* C) const;
+
   template <typename T>
   void CSRMM(const char* transa, const int* m, const int* n, const int* k,
              const T* alpha, const char* matdescra, const T* val,
@@ -290,6 +298,11 @@ class BlasT : private Blas<DeviceContext> {
     Base()->template GEMM_FREE<T>(args...);
   }
 
+  template <typename... ARGS>
+  void PackedGEMM(ARGS... args) const {
+    Base()->template PackedGEMM<T>(args...);
+  }
+
   template <typename... ARGS>
   void CSRMM(ARGS... args) const {
     Base()->template CSRMM<T>(args...);
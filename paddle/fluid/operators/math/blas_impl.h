@@ -804,6 +804,16 @@ template <typename T>
 void Blas<platform::CPUDeviceContext>::GEMM_FREE(T *data) const {
   CBlas<T>::GEMM_FREE(data);
 }
+
+template <>
+template <typename T>
+void Blas<platform::CPUDeviceContext>::PackedGEMM(int M, int N, int K,
+                                                  const T *A,
+                                                  const T *packed_B,
+                                                  T *C) const {
+  CBlas<T>::GEMM_COMPUTE(CblasRowMajor, CblasNoTrans, CblasPacked, M, N, K, A,
+                         K, packed_B, N, static_cast<T>(0), C, N);
+}
 #endif
 
 template <>
@@ -0,0 +1,140 @@
+/* Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+namespace paddle {
+namespace operators {
+namespace math {
+
+// Cache-blocked multithreaded transpose of a batch of row-major
+// rows x cols matrices. The matrix is cut into square tiles small enough
+// that the tile plus its transposed destination stay L1-resident, tiles
+// are distributed over the host threads, and the float tile interior is
+// turned with 8x8 in-register AVX transposes. Eigen's shuffle, which the
+// generic Transpose functor lowers to, walks one output element at a
+// time on a single thread and misses on every strided read.
+
+constexpr int64_t kTransposeTileSize = 32;
+
+template <typename T>
+inline void TransposeTileScalar(const T* src, int64_t src_stride, T* dst,
+                                int64_t dst_stride, int64_t m, int64_t n) {
+  for (int64_t i = 0; i < m; ++i) {
+    for (int64_t j = 0; j < n; ++j) {
+      dst[j * dst_stride + i] = src[i * src_stride + j];
+    }
+  }
+}
+
+template <typename T>
+inline void TransposeTile(const T* src, int64_t src_stride, T* dst,
+                          int64_t dst_stride, int64_t m, int64_t n) {
+  TransposeTileScalar(src, src_stride, dst, dst_stride, m, n);
+}
+
+#ifdef __AVX__
+// Turns a full 8x8 float block entirely in registers.
+inline void Transpose8x8(const float* src, int64_t src_stride, float* dst,
+                         int64_t dst_stride) {
+  __m256 r0 = _mm256_loadu_ps(src + 0 * src_stride);
+  __m256 r1 = _mm256_loadu_ps(src + 1 * src_stride);
+  __m256 r2 = _mm256_loadu_ps(src + 2 * src_stride);
+  __m256 r3 = _mm256_loadu_ps(src + 3 * src_stride);
+  __m256 r4 = _mm256_loadu_ps(src + 4 * src_stride);
+  __m256 r5 = _mm256_loadu_ps(src + 5 * src_stride);
+  __m256 r6 = _mm256_loadu_ps(src + 6 * src_stride);
+  __m256 r7 = _mm256_loadu_ps(src + 7 * src_stride);
+  __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+  __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+  __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+  __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+  __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+  __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+  __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+  __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+  __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+  __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+  __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+  __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+  _mm256_storeu_ps(dst + 0 * dst_stride, _mm256_permute2f128_ps(s0, s4, 0x20));
+  _mm256_storeu_ps(dst + 1 * dst_stride, _mm256_permute2f128_ps(s1, s5, 0x20));
+  _mm256_storeu_ps(dst + 2 * dst_stride, _mm256_permute2f128_ps(s2, s6, 0x20));
+  _mm256_storeu_ps(dst + 3 * dst_stride, _mm256_permute2f128_ps(s3, s7, 0x20));
+  _mm256_storeu_ps(dst + 4 * dst_stride, _mm256_permute2f128_ps(s0, s4, 0x31));
+  _mm256_storeu_ps(dst + 5 * dst_stride, _mm256_permute2f128_ps(s1, s5, 0x31));
+  _mm256_storeu_ps(dst + 6 * dst_stride, _mm256_permute2f128_ps(s2, s6, 0x31));
+  _mm256_storeu_ps(dst + 7 * dst_stride, _mm256_permute2f128_ps(s3, s7, 0x31));
+}
+
+inline void TransposeTile(const float* src, int64_t src_stride, float* dst,
+                          int64_t dst_stride, int64_t m, int64_t n) {
+  int64_t i = 0;
+  for (; i + 8 <= m; i += 8) {
+    int64_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+      Transpose8x8(src + i * src_stride + j, src_stride,
+                   dst + j * dst_stride + i, dst_stride);
+    }
+    if (j < n) {
+      TransposeTileScalar(src + i * src_stride + j, src_stride,
+                          dst + j * dst_stride + i, dst_stride, 8, n - j);
+    }
+  }
+  if (i < m) {
+    TransposeTileScalar(src + i * src_stride, src_stride, dst + i, dst_stride,
+                        m - i, n);
+  }
+}
+#endif
+
+template <typename T>
+void TransposeBlocked2D(const T* src, T* dst, int64_t num_batches,
+                        int64_t rows, int64_t cols) {
+  const int64_t row_tiles = (rows + kTransposeTileSize - 1) / kTransposeTileSize;
+  const int64_t col_tiles = (cols + kTransposeTileSize - 1) / kTransposeTileSize;
+  const int64_t total_tiles = num_batches * row_tiles * col_tiles;
+  const int64_t matrix_size = rows * cols;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+  for (int64_t t = 0; t < total_tiles; ++t) {
+    const int64_t b = t / (row_tiles * col_tiles);
+    const int64_t rt = (t / col_tiles) % row_tiles;
+    const int64_t ct = t % col_tiles;
+    const int64_t i0 = rt * kTransposeTileSize;
+    const int64_t j0 = ct * kTransposeTileSize;
+    const int64_t m = std::min(kTransposeTileSize, rows - i0);
+    const int64_t n = std::min(kTransposeTileSize, cols - j0);
+    const T* src_b = src + b * matrix_size;
+    T* dst_b = dst + b * matrix_size;
+    TransposeTile(src_b + i0 * cols + j0, cols, dst_b + j0 * rows + i0, rows,
+                  m, n);
+  }
+}
+
+}  // namespace math
+}  // namespace operators
+}  // namespace paddle
@@ -35,15 +35,16 @@ struct bloomfilter {
   uint64_t count;
   unsigned char bit_vector[1];
 };
-int bloomfilter_get(const struct bloomfilter *bloomfilter, const void *key,
-                    size_t len);
-int bloomfilter_check(struct bloomfilter *filter);
+inline int bloomfilter_get(const struct bloomfilter *bloomfilter,
+                           const void *key, size_t len);
+inline int bloomfilter_check(struct bloomfilter *filter);
 
 #define bit_get(v, n) ((v)[(n) >> 3] & (0x1 << (0x7 - ((n)&0x7))))
+#define bit_set(v, n) ((v)[(n) >> 3] |= (0x1 << (0x7 - ((n)&0x7))))
 #define ROTL64(x, r) (((x) << (r)) | ((x) >> (64 - (r))))
 #define BIG_CONSTANT(x) (x##LLU)
 
-uint64_t fmix64(uint64_t k) {
+inline uint64_t fmix64(uint64_t k) {
   k ^= k >> 33;
   k *= BIG_CONSTANT(0xff51afd7ed558ccd);
   k ^= k >> 33;
@@ -52,8 +53,8 @@ uint64_t fmix64(uint64_t k) {
   return k;
 }
 
-void murmurhash3_x64_128(const void *key, const int len, const uint32_t seed,
-                         void *out) {
+inline void murmurhash3_x64_128(const void *key, const int len,
+                                const uint32_t seed, void *out) {
   const uint8_t *data = (const uint8_t *)key;
   const int nblocks = len / 16;
 
@@ -146,7 +147,7 @@ void murmurhash3_x64_128(const void *key, const int len, const uint32_t seed,
   reinterpret_cast<uint64_t *>(out)[1] = h2;
 }
 
-int bloomfilter_check(struct bloomfilter *filter) {
+inline int bloomfilter_check(struct bloomfilter *filter) {
   if (filter->magic_num == BLOOMFILTER_MAGIC_NUM_NEW) {
     return 1;
   } else {
@@ -155,8 +156,8 @@ int bloomfilter_check(struct bloomfilter *filter) {
   }
 }
 
-int bloomfilter_get(const struct bloomfilter *bloomfilter, const void *key,
-                    size_t len) {
+inline int bloomfilter_get(const struct bloomfilter *bloomfilter,
+                           const void *key, size_t len) {
   uint32_t i;
   uint64_t result[2];
 
@@ -174,6 +175,39 @@ int bloomfilter_get(const struct bloomfilter *bloomfilter, const void *key,
   return 1;
 }
 
+// allocates an empty filter with m bits and k hash rounds, returns 1 on
+// success; release with free()
+inline int bloomfilter_init(struct bloomfilter **bloomfilter, uint64_t m,
+                            uint64_t k) {
+  size_t size = sizeof(struct bloomfilter) + ((m + 7) >> 3);
+  struct bloomfilter *filter = (struct bloomfilter *)malloc(size);
+  if (filter == NULL) {
+    return 0;
+  }
+  memset(filter, 0, size);
+  filter->magic_num = BLOOMFILTER_MAGIC_NUM_NEW;
+  filter->m = m;
+  filter->k = k;
+  filter->count = 0;
+  *bloomfilter = filter;
+  return 1;
+}
+
+inline void bloomfilter_set(struct bloomfilter *bloomfilter, const void *key,
+                            size_t len) {
+  uint32_t i;
+  uint64_t result[2];
+
+  for (i = 0; i < bloomfilter->k; i++) {
+    murmurhash3_x64_128(key, len, i, &result);
+    result[0] %= bloomfilter->m;
+    result[1] %= bloomfilter->m;
+    bit_set(bloomfilter->bit_vector, result[0]);
+    bit_set(bloomfilter->bit_vector, result[1]);
+  }
+  bloomfilter->count++;
+}
+
 }  // namespace math
 }  // namespace operators
 }  // namespace paddle
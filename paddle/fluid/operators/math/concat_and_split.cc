@@ -29,6 +29,10 @@ namespace paddle {
 namespace operators {
 namespace math {
 
+// Copies smaller than this (in elements) are not worth spreading over the
+// thread pool, the omp fork/join overhead dominates.
+constexpr int64_t kMinParallelCopySize = 1 << 15;
+
 /*
  * All tensors' dimension should be the same and the values of
  * each dimension must be the same, except the axis dimension.
@@ -57,17 +61,62 @@ class ConcatFunctor<platform::CPUDeviceContext, T> {
     }
     auto cpu_place = BOOST_GET_CONST(platform::CPUPlace, context.GetPlace());
 
-    // computation
+    if (out_rows == 1) {
+      // When there is a single output row, each input maps to one contiguous
+      // range of the output. If the inputs are consecutive pieces of one
+      // allocation (e.g. produced by a preceding coalesced allocation or
+      // split), the concat degenerates to a view of that allocation and no
+      // copy is needed at all.
+      bool adjacent = num > 0 && input[0].IsInitialized();
+      const T* expect = adjacent ? input[0].data<T>() : nullptr;
+      for (size_t i = 0; i < num && adjacent; ++i) {
+        adjacent = input[i].Holder() == input[0].Holder() &&
+                   input[i].data<T>() == expect;
+        expect += input_cols[i];
+      }
+      if (adjacent) {
+        auto out_dims = output->dims();
+        output->ShareDataWith(input[0]);
+        output->Resize(out_dims);
+        return;
+      }
+
+      auto output_data = output->data<T>();
+      std::vector<int64_t> input_offsets(num);
+      int64_t col_idx = 0;
+      for (size_t j = 0; j < num; ++j) {
+        input_offsets[j] = col_idx;
+        col_idx += input_cols[j];
+      }
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for if (out_cols > kMinParallelCopySize)
+#endif
+      for (size_t j = 0; j < num; ++j) {
+        memory::Copy(cpu_place, output_data + input_offsets[j], cpu_place,
+                     input[j].data<T>(), sizeof(T) * input_cols[j]);
+      }
+      return;
+    }
+
+    // computation. The row loop is the outer one so that each thread writes
+    // one contiguous slice of the output.
     auto output_data = output->data<T>();
+    std::vector<int64_t> input_offsets(num);
     int64_t col_idx = 0;
     for (size_t j = 0; j < num; ++j) {
-      int64_t col_len = input_cols[j];
-      auto input_data = input[j].data<T>();
-      for (int64_t k = 0; k < out_rows; ++k) {
-        memory::Copy(cpu_place, output_data + k * out_cols + col_idx, cpu_place,
-                     input_data + k * col_len, sizeof(T) * col_len);
+      input_offsets[j] = col_idx;
+      col_idx += input_cols[j];
+    }
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for if (out_rows * out_cols > kMinParallelCopySize)
+#endif
+    for (int64_t k = 0; k < out_rows; ++k) {
+      for (size_t j = 0; j < num; ++j) {
+        int64_t col_len = input_cols[j];
+        memory::Copy(cpu_place, output_data + k * out_cols + input_offsets[j],
+                     cpu_place, input[j].data<T>() + k * col_len,
+                     sizeof(T) * col_len);
       }
-      col_idx += col_len;
     }
   }
 };
@@ -108,19 +157,46 @@ class SplitFunctor<platform::CPUDeviceContext, T> {
     }
     auto cpu_place = BOOST_GET_CONST(platform::CPUPlace, context.GetPlace());
 
-    // computation
+    std::vector<int64_t> output_offsets(num);
+    int64_t col_idx = 0;
+    for (size_t j = 0; j < num; ++j) {
+      output_offsets[j] = col_idx;
+      col_idx += output_cols[j];
+    }
+
+    if (input_rows == 1) {
+      // Single input row: each output is one contiguous range of the input,
+      // so partition the copies over the outputs.
+      const T* src_ptr = input.data<T>();
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for if (input_cols > kMinParallelCopySize)
+#endif
+      for (size_t j = 0; j < num; ++j) {
+        auto* out_tensor = outputs->at(j);
+        if (out_tensor != nullptr) {
+          memory::Copy(cpu_place, out_tensor->data<T>(), cpu_place,
+                       src_ptr + output_offsets[j],
+                       sizeof(T) * output_cols[j]);
+        }
+      }
+      return;
+    }
+
+    // computation. The row loop is the outer one so that each thread reads
+    // one contiguous slice of the input.
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for if (input_rows * input_cols > kMinParallelCopySize)
+#endif
     for (int k = 0; k < input_rows; ++k) {
       const T* src_ptr = input.data<T>() + k * input_cols;
-      int col_idx = 0;
       for (size_t j = 0; j < num; ++j) {
         int col_len = output_cols[j];
         auto* out_tensor = outputs->at(j);
         if (out_tensor != nullptr) {
           T* dst_ptr = out_tensor->data<T>() + k * col_len;
-          memory::Copy(cpu_place, dst_ptr, cpu_place, src_ptr + col_idx,
-                       sizeof(T) * col_len);
+          memory::Copy(cpu_place, dst_ptr, cpu_place,
+                       src_ptr + output_offsets[j], sizeof(T) * col_len);
         }
-        col_idx += col_len;
       }
     }
   }
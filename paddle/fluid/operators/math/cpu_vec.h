@@ -13,10 +13,12 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #pragma once
+#include <algorithm>
 #include <cmath>
 #include <functional>
 #include <string>
 
+#include "paddle/fluid/platform/bfloat16.h"
 #include "paddle/fluid/platform/cpu_info.h"
 #include "paddle/fluid/platform/enforce.h"
 
@@ -132,8 +134,26 @@ inline void vec_scal<float, platform::avx2>(const int n, const float a,
 template <>
 inline void vec_scal<float, platform::avx512f>(const int n, const float a,
                                                const float* x, float* y) {
-  // TODO(TJ): enable me
+#ifdef __AVX512F__
+  constexpr int block = ZMM_FLOAT_BLOCK;
+  if (n < block) {
+    vec_scal<float, platform::avx2>(n, a, x, y);
+    return;
+  }
+  const int rest = n % block;
+  const int end = n - rest;
+  int i = 0;
+  __m512 scalar = _mm512_set1_ps(a);
+  for (i = 0; i < end; i += block) {
+    _mm512_storeu_ps(y + i, _mm512_mul_ps(_mm512_loadu_ps(x + i), scalar));
+  }
+  // can not continue move step if src and dst are inplace
+  for (i = n - rest; i < n; ++i) {
+    y[i] = a * x[i];
+  }
+#else
   vec_scal<float, platform::avx2>(n, a, x, y);
+#endif
 }
 
 template <typename T, platform::cpu_isa_t isa = platform::isa_any>
@@ -177,6 +197,32 @@ inline void vec_sum<float, platform::avx>(const size_t n, const float* x,
 #endif
 }
 
+template <>
+inline void vec_sum<float, platform::avx512f>(const size_t n, const float* x,
+                                              float* s) {
+#ifdef __AVX512F__
+  constexpr unsigned int block = ZMM_FLOAT_BLOCK;
+  if (n < block) {
+    vec_sum<float, platform::avx>(n, x, s);
+    return;
+  }
+
+  unsigned int i = 0, end = 0;
+  end = n & ~(block - 1);
+  __m512 tmp = _mm512_setzero_ps();
+  for (i = 0; i < end; i += block) {
+    tmp = _mm512_add_ps(tmp, _mm512_loadu_ps(x + i));
+  }
+  s[0] = _mm512_reduce_add_ps(tmp);
+
+  for (; i < n; i++) {
+    s[0] += x[i];
+  }
+#else
+  vec_sum<float, platform::avx>(n, x, s);
+#endif
+}
+
 template <typename T, platform::cpu_isa_t isa = platform::isa_any>
 inline void vec_mul(const size_t n, const T* x, const T* y, T* z) {
   for (size_t i = 0; i < n; ++i) {
@@ -209,6 +255,31 @@ inline void vec_mul<float, platform::avx>(const size_t n, const float* x,
 #endif
 }
 
+template <>
+inline void vec_mul<float, platform::avx512f>(const size_t n, const float* x,
+                                              const float* y, float* z) {
+#ifdef __AVX512F__
+  constexpr unsigned int block = ZMM_FLOAT_BLOCK;
+  if (n < block) {
+    vec_mul<float, platform::avx>(n, x, y, z);
+    return;
+  }
+
+  unsigned int i = 0, end = 0;
+  end = n & ~(block - 1);
+  for (i = 0; i < end; i += block) {
+    _mm512_storeu_ps(
+        z + i, _mm512_mul_ps(_mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i)));
+  }
+
+  for (; i < n; i++) {
+    z[i] = x[i] * y[i];
+  }
+#else
+  vec_mul<float, platform::avx>(n, x, y, z);
+#endif
+}
+
 template <typename T, platform::cpu_isa_t isa = platform::isa_any>
 inline void vec_mul_reduce(const size_t n, const T* x, const T* y, T* z) {
   z[0] = x[0] * y[0];
@@ -250,6 +321,33 @@ inline void vec_mul_reduce<float, platform::avx>(const size_t n, const float* x,
 #endif
 }
 
+template <>
+inline void vec_mul_reduce<float, platform::avx512f>(const size_t n,
+                                                     const float* x,
+                                                     const float* y, float* z) {
+#ifdef __AVX512F__
+  constexpr unsigned int block = ZMM_FLOAT_BLOCK;
+  if (n < block) {
+    vec_mul_reduce<float, platform::avx>(n, x, y, z);
+    return;
+  }
+
+  unsigned int i = 0, end = 0;
+  end = n & ~(block - 1);
+  __m512 tmp = _mm512_setzero_ps();
+  for (i = 0; i < end; i += block) {
+    tmp = _mm512_fmadd_ps(_mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i), tmp);
+  }
+  z[0] = _mm512_reduce_add_ps(tmp);
+
+  for (; i < n; i++) {
+    z[0] += x[i] * y[i];
+  }
+#else
+  vec_mul_reduce<float, platform::avx>(n, x, y, z);
+#endif
+}
+
 template <typename T, platform::cpu_isa_t isa = platform::isa_any>
 inline void vec_bias_sub(const int n, const T a, const T* x, T* y) {
   for (int i = 0; i < n; ++i) {
@@ -300,8 +398,26 @@ inline void vec_bias_sub<float, platform::avx2>(const int n, const float a,
 template <>
 inline void vec_bias_sub<float, platform::avx512f>(const int n, const float a,
                                                    const float* x, float* y) {
-  // TODO(TJ): enable me
+#ifdef __AVX512F__
+  constexpr int block = ZMM_FLOAT_BLOCK;
+  if (n < block) {
+    vec_bias_sub<float, platform::avx2>(n, a, x, y);
+    return;
+  }
+  const int rest = n % block;
+  const int end = n - rest;
+  int i = 0;
+  __m512 bias = _mm512_set1_ps(a);
+  for (i = 0; i < end; i += block) {
+    _mm512_storeu_ps(y + i, _mm512_sub_ps(bias, _mm512_loadu_ps(x + i)));
+  }
+  // can not continue move step if src and dst are inplace
+  for (i = n - rest; i < n; ++i) {
+    y[i] = a - x[i];
+  }
+#else
   vec_bias_sub<float, platform::avx2>(n, a, x, y);
+#endif
 }
 
 // out = x*y + (1-x)*z
@@ -360,8 +476,33 @@ template <>
 inline void vec_cross<float, platform::avx512f>(const int n, const float* x,
                                                 const float* y, const float* z,
                                                 float* out) {
-  // TODO(TJ): enable me
+#ifdef __AVX512F__
+  constexpr int block = ZMM_FLOAT_BLOCK;
+  if (n < block) {
+    vec_cross<float, platform::avx>(n, x, y, z, out);
+    return;
+  }
+  const int rest = n % block;
+  const int end = n - rest;
+  int i = 0;
+  __m512 bias = _mm512_set1_ps(1.f);
+  __m512 tmpx, tmpy, tmpz;
+  for (i = 0; i < end; i += block) {
+    tmpx = _mm512_loadu_ps(x + i);
+    tmpy = _mm512_loadu_ps(y + i);
+    tmpz = _mm512_loadu_ps(z + i);
+    tmpy = _mm512_mul_ps(tmpx, tmpy);
+    tmpx = _mm512_sub_ps(bias, tmpx);
+    tmpz = _mm512_fmadd_ps(tmpx, tmpz, tmpy);
+    _mm512_storeu_ps(out + i, tmpz);
+  }
+  // can not continue move step if src and dst are inplace
+  for (i = n - rest; i < n; ++i) {
+    out[i] = x[i] * y[i] + (1.f - x[i]) * z[i];
+  }
+#else
   vec_cross<float, platform::avx>(n, x, y, z, out);
+#endif
 }
 
 template <typename T, platform::cpu_isa_t isa = platform::isa_any>
@@ -397,6 +538,32 @@ inline void vec_clip<float, platform::avx>(const size_t n, const float a,
 #endif
 }
 
+template <>
+inline void vec_clip<float, platform::avx512f>(const size_t n, const float a,
+                                               const float* x, float* y) {
+#ifdef __AVX512F__
+  constexpr unsigned int block = ZMM_FLOAT_BLOCK;
+  if (n < block) {
+    vec_clip<float, platform::avx>(n, a, x, y);
+    return;
+  }
+
+  unsigned int i = 0, end = 0;
+  end = n & ~(block - 1);
+  __m512 threshold = _mm512_set1_ps(a);
+
+  for (i = 0; i < end; i += block) {
+    _mm512_storeu_ps(y + i, _mm512_max_ps(_mm512_loadu_ps(x + i), threshold));
+  }
+
+  for (; i < n; i++) {
+    y[i] = x[i] < a ? a : x[i];
+  }
+#else
+  vec_clip<float, platform::avx>(n, a, x, y);
+#endif
+}
+
 template <typename T, platform::cpu_isa_t isa = platform::isa_any>
 inline void vec_add_bias(const int n, const T a, const T* x, T* y) {
   for (int i = 0; i < n; ++i) {
@@ -447,8 +614,26 @@ inline void vec_add_bias<float, platform::avx2>(const int n, const float a,
 template <>
 inline void vec_add_bias<float, platform::avx512f>(const int n, const float a,
                                                    const float* x, float* y) {
-  // TODO(TJ): enable me
+#ifdef __AVX512F__
+  constexpr int block = ZMM_FLOAT_BLOCK;
+  if (n < block) {
+    vec_add_bias<float, platform::avx2>(n, a, x, y);
+    return;
+  }
+  const int rest = n % block;
+  const int end = n - rest;
+  int i = 0;
+  __m512 bias = _mm512_set1_ps(a);
+  for (i = 0; i < end; i += block) {
+    _mm512_storeu_ps(y + i, _mm512_add_ps(_mm512_loadu_ps(x + i), bias));
+  }
+  // can not continue move step if src and dst are inplace
+  for (i = n - rest; i < n; ++i) {
+    y[i] = x[i] + a;
+  }
+#else
   vec_add_bias<float, platform::avx2>(n, a, x, y);
+#endif
 }
 
 template <typename T, platform::cpu_isa_t isa = platform::isa_any>
@@ -539,8 +724,60 @@ inline void vec_sigmoid<float, platform::avx2>(const int n, const float* x,
 template <>
 inline void vec_sigmoid<float, platform::avx512f>(const int n, const float* x,
                                                   float* y) {
-  // TODO(TJ): enable me
+#ifdef __AVX512F__
+  constexpr int block = ZMM_FLOAT_BLOCK;
+  if (n < block) {
+    vec_sigmoid<float, platform::avx2>(n, x, y);
+    return;
+  }
+  const int rest = n % block;
+  const int end = n - rest;
+  int i = 0;
+  __m512 max = _mm512_set1_ps(SIGMOID_THRESHOLD_MAX);
+  __m512 min = _mm512_set1_ps(SIGMOID_THRESHOLD_MIN);
+  __m512 zeros = _mm512_setzero_ps();
+  __m512 tmp;
+#define MOVE_ONE_STEP              \
+  tmp = _mm512_loadu_ps(x + i);    \
+  tmp = _mm512_max_ps(tmp, min);   \
+  tmp = _mm512_min_ps(tmp, max);   \
+  tmp = _mm512_sub_ps(zeros, tmp); \
+  _mm512_storeu_ps(y + i, tmp)
+  for (i = 0; i < end; i += block) {
+    MOVE_ONE_STEP;
+  }
+#undef MOVE_ONE_STEP
+  if (rest != 0) {
+    // can not continue move step since the src and dst address could be equal
+    const float xmin = SIGMOID_THRESHOLD_MIN;
+    const float xmax = SIGMOID_THRESHOLD_MAX;
+    for (i = n - rest; i < n; ++i) {
+      y[i] = 0.f - ((x[i] < xmin) ? xmin : ((x[i] > xmax) ? xmax : x[i]));
+    }
+  }
+
+  vec_exp<float>(n, y, y);
+
+  __m512 ones = _mm512_set1_ps(1.0f);
+#define MOVE_ONE_STEP             \
+  tmp = _mm512_loadu_ps(y + i);   \
+  tmp = _mm512_add_ps(ones, tmp); \
+  tmp = _mm512_div_ps(ones, tmp); \
+  _mm512_storeu_ps(y + i, tmp)
+  for (i = 0; i < end; i += block) {
+    MOVE_ONE_STEP;
+  }
+#undef MOVE_ONE_STEP
+  if (rest == 0) {
+    return;
+  }
+  // can not continue move step
+  for (i = n - rest; i < n; ++i) {
+    y[i] = 1.f / (1.f + y[i]);
+  }
+#else
   vec_sigmoid<float, platform::avx2>(n, x, y);
+#endif
 }
 
 template <typename T, platform::cpu_isa_t isa = platform::isa_any>
@@ -602,12 +839,80 @@ inline void vec_relu<float, platform::avx2>(const int n, const float* x,
 template <>
 inline void vec_relu<float, platform::avx512f>(const int n, const float* x,
                                                float* y) {
-  // TODO(TJ): enable me
+#ifdef __AVX512F__
+  constexpr int block = ZMM_FLOAT_BLOCK;
+  if (n < block * 4) {
+    vec_relu<float, platform::avx2>(n, x, y);
+    return;
+  }
+
+  const int rest = n % block;
+  const int end = n - rest;
+  int i = 0;
+  __m512 zeros = _mm512_setzero_ps();
+  __m512 tmp;
+#define MOVE_ONE_STEP              \
+  tmp = _mm512_loadu_ps(x + i);    \
+  tmp = _mm512_max_ps(tmp, zeros); \
+  _mm512_storeu_ps(y + i, tmp)
+  for (i = 0; i < end; i += block) {
+    MOVE_ONE_STEP;
+  }
+  if (rest == 0) {
+    return;
+  }
+  i = n - block;
+  MOVE_ONE_STEP;
+#undef MOVE_ONE_STEP
+
+#else
   vec_relu<float, platform::avx2>(n, x, y);
+#endif
 }
 
 // TODO(TJ): optimize double of sigmoid, tanh and relu if necessary
 
+// bfloat16 activations are computed in float: convert one block at a time,
+// run the avx512f float kernel on it and convert the result back. bfloat16
+// is a plain truncation of float, so the casts compile down to 16-bit
+// shifts which the compiler vectorizes, while the math itself runs at full
+// zmm width.
+template <typename Func>
+inline void vec_bf16_in_fp32(const int n, const platform::bfloat16* x,
+                             platform::bfloat16* y, Func kernel) {
+  constexpr int block = 256;
+  float fx[block];
+  float fy[block];
+  for (int i = 0; i < n; i += block) {
+    const int len = std::min(block, n - i);
+    for (int j = 0; j < len; ++j) {
+      fx[j] = static_cast<float>(x[i + j]);
+    }
+    kernel(len, fx, fy);
+    for (int j = 0; j < len; ++j) {
+      y[i + j] = platform::bfloat16(fy[j]);
+    }
+  }
+}
+
+template <>
+inline void vec_sigmoid<platform::bfloat16, platform::avx512f>(
+    const int n, const platform::bfloat16* x, platform::bfloat16* y) {
+  vec_bf16_in_fp32(n, x, y, vec_sigmoid<float, platform::avx512f>);
+}
+
+template <>
+inline void vec_tanh<platform::bfloat16, platform::avx512f>(
+    const int n, const platform::bfloat16* x, platform::bfloat16* y) {
+  vec_bf16_in_fp32(n, x, y, vec_tanh<float, platform::avx512f>);
+}
+
+template <>
+inline void vec_relu<platform::bfloat16, platform::avx512f>(
+    const int n, const platform::bfloat16* x, platform::bfloat16* y) {
+  vec_bf16_in_fp32(n, x, y, vec_relu<float, platform::avx512f>);
+}
+
 template <typename T, platform::cpu_isa_t isa = platform::isa_any>
 class VecActivations {
  public:
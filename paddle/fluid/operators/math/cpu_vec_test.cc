@@ -140,6 +140,43 @@ TEST(CpuVecTest, relu) {
   TestAndBench<double>(30, vec_relu<double>, ref_relu<double>);
 }
 
+// bfloat16 kernels are checked against the float reference evaluated on the
+// same (already truncated) inputs, with a tolerance of one bfloat16 ulp of
+// the activation input range.
+void TestBf16Kernel(
+    const int n,
+    std::function<void(const int, const paddle::platform::bfloat16*,
+                       paddle::platform::bfloat16*)>
+        tgt,
+    std::function<void(const int, const float*, float*)> ref) {
+  using paddle::platform::bfloat16;
+  std::vector<float> x(n), yref(n);
+  std::vector<bfloat16> bx(n), ytgt(n);
+  RandomVec<float>(n, x.data());
+  for (int i = 0; i < n; ++i) {
+    bx[i] = bfloat16(x[i]);
+    x[i] = static_cast<float>(bx[i]);
+  }
+  tgt(n, bx.data(), ytgt.data());
+  ref(n, x.data(), yref.data());
+  for (int i = 0; i < n; ++i) {
+    EXPECT_NEAR(static_cast<float>(ytgt[i]), yref[i], 1e-1);
+  }
+}
+
+TEST(CpuVecTest, bf16_activations) {
+  namespace platform = paddle::platform;
+  using namespace paddle::operators::math;  // NOLINT
+  for (auto sz : {1, 2, 15, 16, 30, 32, 128, 200, 512}) {
+    TestBf16Kernel(sz, vec_sigmoid<platform::bfloat16, platform::avx512f>,
+                   ref_sigmoid<float>);
+    TestBf16Kernel(sz, vec_tanh<platform::bfloat16, platform::avx512f>,
+                   ref_tanh<float>);
+    TestBf16Kernel(sz, vec_relu<platform::bfloat16, platform::avx512f>,
+                   ref_relu<float>);
+  }
+}
+
 template <typename T>
 void compare_sum(size_t n, std::function<void(const size_t, const T*, T*)> tgt,
                  std::function<void(const size_t, const T*, T*)> ref) {
@@ -14,13 +14,74 @@ limitations under the License. */
 
 #include "paddle/fluid/operators/math/fc.h"
 
+#include <mutex>
+#include <unordered_map>
+
+#include "gflags/gflags.h"
 #include "paddle/fluid/operators/jit/kernels.h"
 #include "paddle/fluid/operators/math/blas.h"
+#include "paddle/fluid/platform/macros.h"
+
+#ifdef PADDLE_WITH_MKLML
+DECLARE_bool(enable_fc_packed_weight_cache);
+#endif
 
 namespace paddle {
 namespace operators {
 namespace math {
 
+#ifdef PADDLE_WITH_MKLML
+namespace {
+
+// Packed weight images keyed by the weight data pointer. FC weights are
+// constant during inference, so each matrix is packed once and every
+// subsequent forward pass reuses the image instead of letting cblas_?gemm
+// re-pack it internally. Entries live for the whole process, like the jit
+// code pools do.
+template <typename T>
+class PackedWeightCache {
+ public:
+  static PackedWeightCache& Instance() {
+    static PackedWeightCache cache;
+    return cache;
+  }
+
+  template <typename BlasT>
+  const T* Get(const BlasT& blas, const T* W, int N, int K) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = cache_.find(W);
+    if (it != cache_.end()) {
+      if (it->second.n == N && it->second.k == K) {
+        return it->second.data;
+      }
+      // The weight allocation was reused for a matrix of another shape.
+      blas.GEMM_FREE(it->second.data);
+      cache_.erase(it);
+    }
+    T* packed = blas.GEMM_ALLOC(CblasBMatrix, 1, N, K);
+    blas.GEMM_PACK(CblasBMatrix, CblasNoTrans, 1, N, K, static_cast<T>(1.0), W,
+                   N, packed);
+    cache_.emplace(W, Entry{packed, N, K});
+    return packed;
+  }
+
+ private:
+  struct Entry {
+    T* data;
+    int n;
+    int k;
+  };
+
+  PackedWeightCache() = default;
+  DISABLE_COPY_AND_ASSIGN(PackedWeightCache);
+
+  std::mutex mutex_;
+  std::unordered_map<const T*, Entry> cache_;
+};
+
+}  // namespace
+#endif
+
 template <typename T>
 class FCFunctor<platform::CPUDeviceContext, T> {
  public:
@@ -46,7 +107,16 @@ class FCFunctor<platform::CPUDeviceContext, T> {
       blas.GEMM(false, false, M, N, K, static_cast<T>(1.0), X1_data, KK, W, NN,
                 static_cast<T>(0.0), Y1_data, NN);
     } else {
+#ifdef PADDLE_WITH_MKLML
+      if (FLAGS_enable_fc_packed_weight_cache) {
+        const T* packed_W = PackedWeightCache<T>::Instance().Get(blas, W, N, K);
+        blas.PackedGEMM(M, N, K, X, packed_W, Y);
+      } else {
+        blas.MatMul(M, N, K, X, W, Y);
+      }
+#else
       blas.MatMul(M, N, K, X, W, Y);
+#endif
     }
     if (B == NULL) {
       if (padding_weights) {
@@ -16,6 +16,11 @@ limitations under the License. */
 
 #include <glog/logging.h>
 #include "paddle/fluid/framework/generator.h"
+#include "paddle/fluid/framework/philox_engine.h"
+
+#ifdef PADDLE_WITH_MKLML
+#include <omp.h>
+#endif
 
 namespace paddle {
 namespace operators {
@@ -23,6 +28,12 @@ namespace math {
 
 Sampler::~Sampler() {}
 
+void Sampler::SampleBatch(int64_t n, int64_t *out) const {
+  for (int64_t i = 0; i < n; ++i) {
+    out[i] = Sample();
+  }
+}
+
 UniformSampler::UniformSampler(int64_t range, unsigned int seed)
     : Sampler(range, seed), inv_range_(1.0 / (range + 1)) {
   random_engine_ = framework::GetCPURandomEngine(seed_);
@@ -89,6 +100,30 @@ int64_t CustomSampler::Sample() const {
   }
 }
 
+void CustomSampler::SampleBatch(int64_t n, int64_t *out) const {
+  framework::PhiloxEngine engine(static_cast<uint64_t>(seed_));
+  const uint64_t base = batch_counter_;
+  batch_counter_ += static_cast<uint64_t>(n);
+  const uint64_t num_buckets = static_cast<uint64_t>(range_) + 1;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+  for (int64_t i = 0; i < n; ++i) {
+    // One Philox block per draw: 64 bits pick the bucket, 32 bits flip the
+    // alias coin. The bias of the modulo is negligible against 2^64.
+    auto block = engine(base + static_cast<uint64_t>(i));
+    uint64_t bits =
+        (static_cast<uint64_t>(block[0]) << 32) | static_cast<uint64_t>(block[1]);
+    int64_t index = static_cast<int64_t>(bits % num_buckets);
+    float p = framework::PhiloxEngine::Uniform01(block[2]);
+    if (p > alias_probs_[index] && alias_[index] != exceptional_val) {
+      out[i] = alias_[index];
+    } else {
+      out[i] = index;
+    }
+  }
+}
+
 float CustomSampler::Probability(int64_t value) const { return probs_[value]; }
 
 }  // namespace math
@@ -50,6 +50,10 @@ class Sampler {
   // Sample a single value
   virtual int64_t Sample() const = 0;
 
+  // Sample n values into out. The default implementation just loops over
+  // Sample(); subclasses may override it with a batched draw.
+  virtual void SampleBatch(int64_t n, int64_t* out) const;
+
   // The probability that a single call to Sample() returns the given value.
   virtual float Probability(int64_t value) const = 0;
 
@@ -115,6 +119,11 @@ class CustomSampler : public Sampler {
 
   int64_t Sample() const override;
 
+  // Batched alias-method draw: one counter-based RNG block per output, so
+  // the loop parallelizes over threads with independent streams and the
+  // result is reproducible for a fixed seed regardless of thread count.
+  void SampleBatch(int64_t n, int64_t* out) const override;
+
   float Probability(int64_t value) const override;
 
  private:
@@ -125,6 +134,8 @@ class CustomSampler : public Sampler {
   std::shared_ptr<std::mt19937_64> random_engine_;
   std::shared_ptr<std::uniform_real_distribution<>> real_dist_;
   std::shared_ptr<std::uniform_int_distribution<>> int_dist_;
+  // Next unused counter of the batched stream; advanced by SampleBatch.
+  mutable uint64_t batch_counter_ = 0;
 };
 
 }  // namespace math
@@ -14,6 +14,9 @@ limitations under the License. */
 
 #include "paddle/fluid/operators/math/selected_rows_functor.h"
 
+#include <algorithm>
+#include <utility>
+
 #ifdef PADDLE_WITH_MKLDNN
 #include "paddle/fluid/operators/mkldnn/axpy_handler.h"
 #endif
@@ -316,60 +319,64 @@ typename std::enable_if<std::is_integral<T>::value>::type elementwise_add_to(
   }
 }
 
+// References to all input rows, sorted by row id so that duplicates form
+// consecutive runs. merge_offsets[i] is the index of the first reference
+// belonging to the i-th merged output row, with a trailing sentinel.
 template <typename T>
-typename std::enable_if<std::is_same<T, platform::bfloat16>::value>::type
-add_sparse_inputs(const std::vector<const framework::SelectedRows*>& inputs,
-                  const std::unordered_map<int64_t, size_t>& rows_to_id,
-                  int64_t input_width,
-                  const platform::CPUDeviceContext& context, T* out_data) {
-#ifndef PADDLE_WITH_MKLDNN
-  auto blas = math::GetBlas<platform::CPUDeviceContext, T>(context);
-#endif
-  for (auto* input : inputs) {
-    if (input->rows().size() == 0) {
-      continue;
-    }
-    auto* input_data = input->value().data<T>();
-    auto& input_rows = input->rows();
+using RowRefs = std::vector<std::pair<int64_t, const T*>>;
 
+template <typename T>
+typename std::enable_if<std::is_same<T, platform::bfloat16>::value>::type
+accumulate_merged_rows(const platform::CPUDeviceContext& context,
+                       const RowRefs<T>& row_refs,
+                       const std::vector<size_t>& merge_offsets,
+                       int64_t input_width, T* out_data) {
+  auto cpu_place = BOOST_GET_CONST(platform::CPUPlace, context.GetPlace());
+  int64_t merged_num = static_cast<int64_t>(merge_offsets.size()) - 1;
 #ifdef PADDLE_WITH_MKLDNN
-    OneDNNAXPYHandler<T> axpy_handler(input_width, T(1.f));
-    for (size_t i = 0; i < input_rows.size(); i++) {
-      size_t out_i = rows_to_id.at(input_rows[i]);
-      axpy_handler(&input_data[i * input_width],
-                   &out_data[out_i * input_width]);
+  OneDNNAXPYHandler<T> axpy_handler(input_width, T(1.f));
+  for (int64_t i = 0; i < merged_num; ++i) {
+    T* dst = out_data + i * input_width;
+    memory::Copy(cpu_place, dst, cpu_place, row_refs[merge_offsets[i]].second,
+                 sizeof(T) * input_width);
+    for (size_t r = merge_offsets[i] + 1; r < merge_offsets[i + 1]; ++r) {
+      axpy_handler(row_refs[r].second, dst);
     }
+  }
 #else
-    for (size_t i = 0; i < input_rows.size(); i++) {
-      size_t out_i = rows_to_id.at(input_rows[i]);
+  auto blas = math::GetBlas<platform::CPUDeviceContext, T>(context);
+  for (int64_t i = 0; i < merged_num; ++i) {
+    T* dst = out_data + i * input_width;
+    memory::Copy(cpu_place, dst, cpu_place, row_refs[merge_offsets[i]].second,
+                 sizeof(T) * input_width);
+    for (size_t r = merge_offsets[i] + 1; r < merge_offsets[i + 1]; ++r) {
       elementwise_add_to<T>(&blas, static_cast<size_t>(input_width),
-                            &input_data[i * input_width],
-                            &out_data[out_i * input_width]);
+                            row_refs[r].second, dst);
     }
-#endif
   }
+#endif
 }
 
 template <typename T>
 typename std::enable_if<!std::is_same<T, platform::bfloat16>::value>::type
-add_sparse_inputs(const std::vector<const framework::SelectedRows*>& inputs,
-                  const std::unordered_map<int64_t, size_t>& rows_to_id,
-                  int64_t input_width,
-                  const platform::CPUDeviceContext& context, T* out_data) {
-  VLOG(4) << "[CPU] add_sparse_inputs <" << typeid(T).name();
+accumulate_merged_rows(const platform::CPUDeviceContext& context,
+                       const RowRefs<T>& row_refs,
+                       const std::vector<size_t>& merge_offsets,
+                       int64_t input_width, T* out_data) {
+  VLOG(4) << "[CPU] accumulate_merged_rows <" << typeid(T).name();
+  auto cpu_place = BOOST_GET_CONST(platform::CPUPlace, context.GetPlace());
   auto blas = math::GetBlas<platform::CPUDeviceContext, T>(context);
-  for (auto* input : inputs) {
-    if (input->rows().size() == 0) {
-      continue;
-    }
-    auto* input_data = input->value().data<T>();
-    auto& input_rows = input->rows();
-
-    for (size_t i = 0; i < input_rows.size(); i++) {
-      size_t out_i = rows_to_id.at(input_rows[i]);
+  int64_t merged_num = static_cast<int64_t>(merge_offsets.size()) - 1;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+  for (int64_t i = 0; i < merged_num; ++i) {
+    T* dst = out_data + i * input_width;
+    memory::Copy(cpu_place, dst, cpu_place, row_refs[merge_offsets[i]].second,
+                 sizeof(T) * input_width);
+    for (size_t r = merge_offsets[i] + 1; r < merge_offsets[i + 1]; ++r) {
       elementwise_add_to<T>(&blas, static_cast<size_t>(input_width),
-                            &input_data[i * input_width],
-                            &out_data[out_i * input_width]);
+                            row_refs[r].second, dst);
     }
   }
 }
@@ -415,7 +422,6 @@ struct MergeAdd<platform::CPUDeviceContext, T> {
     auto input_width = has_value_input->value().dims()[1];
     auto input_height = has_value_input->height();
     framework::SelectedRows& out = *output;
-    std::set<int64_t> merged_row_set;
     size_t row_num = 0;
     for (auto* input : inputs) {
       if (input->rows().size() == 0) {
@@ -429,20 +435,50 @@ struct MergeAdd<platform::CPUDeviceContext, T> {
                         platform::errors::InvalidArgument(
                             "All inputs should have same height."));
       row_num += input->rows().size();
-      merged_row_set.insert(input->rows().begin(), input->rows().end());
     }
 
+    // Sort references to all input rows by row id so that duplicated ids
+    // form consecutive runs. This replaces the std::set / unordered_map
+    // bookkeeping, whose per-row pointer chasing dominates merges of large
+    // embedding gradients, and also detects duplication as a by-product.
+    RowRefs<T> row_refs;
+    row_refs.reserve(row_num);
+    for (auto* input : inputs) {
+      if (input->rows().size() == 0) {
+        continue;
+      }
+      auto* input_data = input->value().data<T>();
+      auto& input_rows = input->rows();
+      for (size_t i = 0; i < input_rows.size(); ++i) {
+        row_refs.emplace_back(input_rows[i], input_data + i * input_width);
+      }
+    }
+    std::sort(row_refs.begin(), row_refs.end(),
+              [](const std::pair<int64_t, const T*>& a,
+                 const std::pair<int64_t, const T*>& b) {
+                return a.first < b.first;
+              });
+
+    std::vector<int64_t> merge_rows;
+    std::vector<size_t> merge_offsets;
+    for (size_t i = 0; i < row_refs.size(); ++i) {
+      if (i == 0 || row_refs[i].first != row_refs[i - 1].first) {
+        merge_rows.push_back(row_refs[i].first);
+        merge_offsets.push_back(i);
+      }
+    }
+    merge_offsets.push_back(row_refs.size());
+
     out.set_height(input_height);
     out.mutable_value()->mutable_data<T>(
         framework::make_ddim(
-            {static_cast<int64_t>(merged_row_set.size()), input_width}),
+            {static_cast<int64_t>(merge_rows.size()), input_width}),
         context.GetPlace());
     auto* out_data = out.mutable_value()->data<T>();
 
-    if (merged_row_set.size() == row_num && !sorted_result) {
+    if (merge_rows.size() == row_num && !sorted_result) {
       // no duplicated ids, just concat the result together
-      std::vector<int64_t> merge_rows;
-      merge_rows.reserve(row_num);
+      merge_rows.clear();
       // concat rows
       for (auto* in : inputs) {
         merge_rows.insert(merge_rows.end(), in->rows().begin(),
@@ -462,24 +498,13 @@ struct MergeAdd<platform::CPUDeviceContext, T> {
         copied_numel += in_numel;
       }
     } else {
-      std::vector<int64_t> merge_rows(merged_row_set.begin(),
-                                      merged_row_set.end());
-
-      if (sorted_result) {
-        std::sort(merge_rows.begin(), merge_rows.end());
-      }
-
+      // The merged ids come out of the sort in increasing order, which is
+      // what the std::set based implementation produced as well.
       out.set_rows(merge_rows);
-
-      math::SetConstant<platform::CPUDeviceContext, T> constant_functor;
-      constant_functor(context, out.mutable_value(), static_cast<T>(0.f));
-
-      std::unordered_map<int64_t, size_t> rows_to_id;
-      for (size_t i = 0; i < merge_rows.size(); ++i) {
-        rows_to_id[merge_rows[i]] = i;
-      }
-
-      add_sparse_inputs<T>(inputs, rows_to_id, input_width, context, out_data);
+      // The first reference of each run initializes the output row, so no
+      // zero-fill pass is needed before the accumulation.
+      accumulate_merged_rows<T>(context, row_refs, merge_offsets, input_width,
+                                out_data);
     }
   }
 };
@@ -13,11 +13,14 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include "paddle/fluid/operators/jit/kernels.h"
 #include "paddle/fluid/operators/math/blas.h"
 #include "paddle/fluid/operators/math/math_function.h"
 #include "paddle/fluid/operators/math/sequence_pooling.h"
+#include "paddle/fluid/platform/bfloat16.h"
 
 namespace paddle {
 namespace operators {
@@ -74,6 +77,12 @@ class MaxSeqPoolFunctor {
 
     int64_t num_seq = out_dims[0];
     int64_t dim = output->numel() / num_seq;
+    // Each sequence owns a disjoint row of the output and of the index,
+    // so sequences can be pooled independently; the running maximum and
+    // its position are tracked in the same pass.
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
     for (int64_t i = 0; i < num_seq; ++i) {
       if (starts[i] == starts[i + 1]) {
         for (int64_t k = 0; k < dim; ++k) {
@@ -133,6 +142,9 @@ class MaxSeqPoolFunctor<T, true> {
 
     int64_t num_seq = out_dims[0];
     int64_t dim = output->numel() / num_seq;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
     for (int64_t i = 0; i < num_seq; ++i) {
       if (starts[i] == starts[i + 1]) {
         for (int64_t k = 0; k < dim; ++k) {
@@ -334,61 +346,96 @@ class SequencePoolFunctor<platform::CPUDeviceContext, T> {
     }
     auto lod_level = input.lod().size();
     auto lod = input.lod()[lod_level - 1];
-    if (pooltype == "SUM") {
+    if (pooltype == "SUM" || pooltype == "AVERAGE" || pooltype == "SQRT") {
       auto place = context.GetPlace();
       PADDLE_ENFORCE_EQ(
           platform::is_cpu_place(place), true,
           platform::errors::InvalidArgument(
-              "Sequence_pool should run on CPU Device when pooltype is SUM"));
+              "Sequence_pool should run on CPU Device when pooltype is SUM, "
+              "AVERAGE or SQRT"));
       const T* src = input.data<T>();
       T* dst = output->mutable_data<T>(place);
+      const bool is_sum = (pooltype == "SUM");
+      const bool is_avg = (pooltype == "AVERAGE");
+      if (std::is_same<T, platform::bfloat16>::value) {
+        // There is no bf16 jit seqpool kernel; accumulate each column in
+        // fp32 and round once at the end so long sequences do not drift.
+        const int w = static_cast<int>(input.numel() / input.dims()[0]);
+        int64_t seq_num = static_cast<int64_t>(lod.size()) - 1;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+        for (int64_t i = 0; i < seq_num; ++i) {
+          int64_t h = static_cast<int64_t>(lod[i + 1] - lod[i]);
+          T* seq_dst = dst + i * w;
+          if (h == 0) {
+            for (int j = 0; j < w; ++j) {
+              seq_dst[j] = pad_value;
+            }
+            continue;
+          }
+          const T* seq_src = src + lod[i] * w;
+          std::vector<float> acc(w, 0.f);
+          for (int64_t j = 0; j < h; ++j) {
+            for (int k = 0; k < w; ++k) {
+              acc[k] += static_cast<float>(seq_src[j * w + k]);
+            }
+          }
+          float scale = 1.f;
+          if (is_avg) {
+            scale = 1.f / static_cast<float>(h);
+          } else if (!is_sum) {
+            scale = 1.f / std::sqrt(static_cast<float>(h));
+          }
+          for (int k = 0; k < w; ++k) {
+            seq_dst[k] = static_cast<T>(acc[k] * scale);
+          }
+        }
+        return;
+      }
+      // All three reductions share the vectorized sum kernel; AVERAGE and
+      // SQRT scale the pooled row afterwards. The jit kAvg/kSqrt variants
+      // stage their scale through a scratch slot inside the generated
+      // code, so they are not reentrant and cannot be called from
+      // multiple threads.
       jit::seq_pool_attr_t attr(
           static_cast<int>(input.numel() / input.dims()[0]),
           jit::SeqPoolType::kSum);
       auto seqpool =
           jit::KernelFuncs<jit::SeqPoolTuple<T>, platform::CPUPlace>::Cache()
               .At(attr);
-      for (int i = 0; i < static_cast<int>(lod.size()) - 1; ++i) {
+      int64_t seq_num = static_cast<int64_t>(lod.size()) - 1;
+      // Sequences write disjoint output rows, so they are pooled in
+      // parallel; each iteration carries its own attr since the height
+      // differs per sequence.
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for firstprivate(attr)
+#endif
+      for (int64_t i = 0; i < seq_num; ++i) {
         attr.h = static_cast<int>(lod[i + 1] - lod[i]);
+        T* seq_dst = dst + i * attr.w;
         if (attr.h == 0) {
           for (int j = 0; j < attr.w; ++j) {
-            dst[j] = pad_value;
+            seq_dst[j] = pad_value;
           }
-        } else {
-          seqpool(src, dst, &attr);
+          continue;
         }
-        dst += attr.w;
-        src += attr.h * attr.w;
-      }
-      return;
-    }
-    auto& place = *context.eigen_device();
-    for (int i = 0; i < static_cast<int>(lod.size()) - 1; ++i) {
-      Tensor out_t = output->Slice(i, i + 1);
-      int64_t w = input.numel() / input.dims()[0];
-      if (lod[i] == lod[i + 1]) {
-        for (int j = 0; j < w; ++j) {
-          out_t.data<T>()[j] = pad_value;
+        seqpool(src + lod[i] * attr.w, seq_dst, &attr);
+        if (!is_sum) {
+          double denom = is_avg ? static_cast<double>(attr.h)
+                                : std::sqrt(static_cast<double>(attr.h));
+          T scale = static_cast<T>(1.0 / denom);
+          for (int j = 0; j < attr.w; ++j) {
+            seq_dst[j] *= scale;
+          }
         }
-        continue;
-      }
-      Tensor in_t =
-          input.Slice(static_cast<int>(lod[i]), static_cast<int>(lod[i + 1]));
-      int64_t h = static_cast<int64_t>(lod[i + 1] - lod[i]);
-      auto in_e = EigenMatrix<T>::From(in_t, framework::make_ddim({h, w}));
-      auto out_e = EigenVector<T>::Flatten(out_t);
-      if (pooltype == "AVERAGE") {
-        out_e.device(place) = in_e.mean(Eigen::array<int, 1>({{0}}));
-      } else if (pooltype == "SQRT") {
-        out_e.device(place) = in_e.sum(Eigen::array<int, 1>({{0}})) /
-                              std::sqrt(static_cast<T>(h));
-      } else {
-        PADDLE_THROW(platform::errors::InvalidArgument(
-            "unsupported pooling pooltype: %s. Only support \"AVERAGE\" and "
-            "\"SQRT\"",
-            pooltype));
       }
+      return;
     }
+    PADDLE_THROW(platform::errors::InvalidArgument(
+        "unsupported pooling pooltype: %s. Only support \"MAX\", \"LAST\", "
+        "\"FIRST\", \"SUM\", \"AVERAGE\" and \"SQRT\"",
+        pooltype));
   }
 };
 
@@ -455,6 +502,10 @@ class SequencePoolGradFunctor<platform::CPUDeviceContext, T> {
 
 template class SequencePoolFunctor<platform::CPUDeviceContext, float>;
 template class SequencePoolFunctor<platform::CPUDeviceContext, double>;
+// bf16 forward pooling for the oneDNN inference pipeline; training
+// (the grad functor) stays fp32.
+template class SequencePoolFunctor<platform::CPUDeviceContext,
+                                   platform::bfloat16>;
 template class SequencePoolGradFunctor<platform::CPUDeviceContext, float>;
 template class SequencePoolGradFunctor<platform::CPUDeviceContext, double>;
 
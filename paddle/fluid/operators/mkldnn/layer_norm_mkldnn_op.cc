@@ -12,6 +12,8 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License. */
 
+#include <cstring>
+
 #include "paddle/fluid/operators/layer_norm_op.h"
 #include "paddle/fluid/platform/mkldnn_reuse.h"
 
@@ -43,6 +45,13 @@ class LayerNormMKLDNNHandler : public platform::MKLDNNHandlerNoCachingT<
     }
   }
 
+  using platform::MKLDNNHandlerNoCachingT<
+      T, dnnl::layer_normalization_forward>::AcquireSrcMemory;
+
+  std::shared_ptr<dnnl::memory> AcquireSrcMemory(void* ptr) {
+    return this->AcquireMemoryFromPrimitive(this->fwd_pd_->src_desc(), ptr);
+  }
+
   std::shared_ptr<dnnl::memory> AcquireScaleShiftMemory(
       std::vector<float>& scaleshift_data) {
     // scaleshift_data comes from temporary buffer so we need to copy it into
@@ -103,6 +112,13 @@ class LayerNormMKLDNNOpKernel : public paddle::framework::OpKernel<T> {
       flags |= dnnl::normalization_flags::use_scale_shift;
     }
 
+    if (is_test &&
+        platform::CanBucketShape(src_tz, static_cast<int>(src_tz.size()) - 1,
+                                 x->format())) {
+      ComputeBucketed(ctx, dev_ctx, x, scale, bias, y, epsilon, flags);
+      return;
+    }
+
     LayerNormMKLDNNHandler<T> handler(src_tz, epsilon, flags, is_test,
                                       x->format(), mkldnn_engine,
                                       ctx.GetPlace());
@@ -156,6 +172,65 @@ class LayerNormMKLDNNOpKernel : public paddle::framework::OpKernel<T> {
     y->set_layout(DataLayout::kMKLDNN);
     y->set_format(platform::GetMKLDNNFormat(*dst_memory));
   }
+
+ private:
+  void ComputeBucketed(const framework::ExecutionContext& ctx,
+                       const platform::MKLDNNDeviceContext& dev_ctx,
+                       const Tensor* x, const Tensor* scale, const Tensor* bias,
+                       Tensor* y, const float epsilon,
+                       const dnnl::normalization_flags flags) const {
+    const auto& mkldnn_engine = dev_ctx.GetEngine();
+    const int64_t cols = x->dims()[x->dims().size() - 1];
+    const int64_t rows = x->numel() / cols;
+    const int64_t bucketed_rows = platform::BucketRows(rows);
+
+    // The primitive normalizes scratch memory covering the bucketed shape in
+    // place; the padded rows are zeroed once so they stay finite and their
+    // results are never copied out.
+    auto* scratch = static_cast<T*>(
+        dev_ctx.AllocateWorkspace(bucketed_rows * cols * sizeof(T)));
+    std::memcpy(scratch, x->data<T>(), x->numel() * sizeof(T));
+    std::memset(scratch + rows * cols, 0,
+                (bucketed_rows - rows) * cols * sizeof(T));
+
+    LayerNormMKLDNNHandler<T> handler(
+        std::vector<int64_t>{bucketed_rows, cols}, epsilon, flags,
+        /* is_test = */ true, MKLDNNMemoryFormat::nc, mkldnn_engine,
+        ctx.GetPlace());
+
+    auto src_memory = handler.AcquireSrcMemory(static_cast<void*>(scratch));
+    auto layer_norm_p = handler.AcquireForwardPrimitive();
+
+    auto& astream = platform::MKLDNNDeviceContext::tls().get_stream();
+    std::unordered_map<int, dnnl::memory> args;
+    args.insert({DNNL_ARG_SRC, *src_memory});
+    args.insert({DNNL_ARG_DST, *src_memory});
+
+    std::shared_ptr<mkldnn::memory> scaleshift_memory;
+    if (scale && bias) {
+      auto scale_tz = paddle::framework::vectorize(scale->dims());
+      const unsigned int C = scale_tz[0];
+
+      std::vector<float> scaleshift_data;
+      scaleshift_data.reserve(2 * C);
+      scaleshift_data.insert(scaleshift_data.begin(), scale->data<float>(),
+                             scale->data<float>() + C);
+      scaleshift_data.insert(scaleshift_data.end(), bias->data<float>(),
+                             bias->data<float>() + C);
+
+      scaleshift_memory = handler.AcquireScaleShiftMemory(scaleshift_data);
+      args.insert({DNNL_ARG_SCALE_SHIFT, *scaleshift_memory});
+    }
+
+    layer_norm_p->execute(astream, args);
+    astream.wait();
+
+    T* y_data = y->mutable_data<T>(ctx.GetPlace());
+    std::memcpy(y_data, scratch, y->numel() * sizeof(T));
+
+    y->set_layout(DataLayout::kMKLDNN);
+    y->set_format(x->format());
+  }
 };
 
 }  // namespace operators
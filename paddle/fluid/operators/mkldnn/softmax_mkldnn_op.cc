@@ -12,6 +12,8 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License. */
 
+#include <cstring>
+
 #include "paddle/fluid/operators/softmax_op.h"
 #include "paddle/fluid/platform/mkldnn_reuse.h"
 
@@ -54,6 +56,28 @@ class SoftmaxMKLDNNHandler
                                             axis);
   }
 
+  // Shape-bucketed variant: the primitive is built for a flattened 2D shape
+  // whose row count has been rounded up to the bucket boundary, and executes
+  // on scratch memory instead of the tensors themselves.
+  SoftmaxMKLDNNHandler(const mkldnn::engine mkldnn_engine,
+                       platform::Place cpu_place,
+                       const std::vector<int64_t>& bucketed_tz)
+      : platform::MKLDNNHandlerNoCachingT<T, mkldnn::softmax_forward,
+                                          mkldnn::softmax_backward>(
+            mkldnn_engine, cpu_place) {
+    auto md = memory::desc(bucketed_tz, platform::MKLDNNGetDataType<T>(),
+                           MKLDNNMemoryFormat::nc);
+    this->AcquireForwardPrimitiveDescriptor(prop_kind::forward_scoring, md,
+                                            /* axis = */ 1);
+  }
+
+  using platform::MKLDNNHandlerNoCachingT<
+      T, mkldnn::softmax_forward, mkldnn::softmax_backward>::AcquireSrcMemory;
+
+  std::shared_ptr<mkldnn::memory> AcquireSrcMemory(void* ptr) {
+    return this->AcquireMemoryFromPrimitive(this->fwd_pd_->src_desc(), ptr);
+  }
+
   SoftmaxMKLDNNHandler(const framework::ExecutionContext& ctx,
                        const mkldnn::engine mkldnn_engine,
                        platform::Place cpu_place, const Tensor* out,
@@ -98,6 +122,12 @@ class SoftmaxMKLDNNKernel : public paddle::framework::OpKernel<T> {
 
     const int axis = CanonicalAxis(ctx.Attr<int>("axis"), input->dims().size());
 
+    const auto src_tz = framework::vectorize(input->dims());
+    if (platform::CanBucketShape(src_tz, axis, input->format())) {
+      ComputeBucketed(ctx, dev_ctx, mkldnn_engine, input, output);
+      return;
+    }
+
     SoftmaxMKLDNNHandler<T> handler(mkldnn_engine, ctx.GetPlace(), input,
                                     output, axis);
 
@@ -125,6 +155,48 @@ class SoftmaxMKLDNNKernel : public paddle::framework::OpKernel<T> {
     // Softmax output format is the same as input one
     output->set_format(input->format());
   }
+
+ private:
+  void ComputeBucketed(const paddle::framework::ExecutionContext& ctx,
+                       const MKLDNNDeviceContext& dev_ctx,
+                       const mkldnn::engine mkldnn_engine, const Tensor* input,
+                       Tensor* output) const {
+    const int64_t cols = input->dims()[input->dims().size() - 1];
+    const int64_t rows = input->numel() / cols;
+    const int64_t bucketed_rows = platform::BucketRows(rows);
+
+    // The primitive runs in place on scratch memory covering the bucketed
+    // shape; the padded rows are zeroed once so they stay finite and their
+    // results are never copied out.
+    auto* scratch = static_cast<T*>(
+        dev_ctx.AllocateWorkspace(bucketed_rows * cols * sizeof(T)));
+    std::memcpy(scratch, input->data<T>(), input->numel() * sizeof(T));
+    std::memset(scratch + rows * cols, 0,
+                (bucketed_rows - rows) * cols * sizeof(T));
+
+    SoftmaxMKLDNNHandler<T> handler(mkldnn_engine, ctx.GetPlace(),
+                                    std::vector<int64_t>{bucketed_rows, cols});
+    auto softmax_memory_p = handler.AcquireSrcMemory(scratch);
+    auto softmax_p = handler.AcquireForwardPrimitive();
+
+    auto& astream = paddle::platform::MKLDNNDeviceContext::tls().get_stream();
+    softmax_p->execute(astream, {{DNNL_ARG_SRC, *softmax_memory_p},
+                                 {DNNL_ARG_DST, *softmax_memory_p}});
+    astream.wait();
+
+    T* output_data = output->mutable_data<T>(ctx.GetPlace());
+    std::memcpy(output_data, scratch, output->numel() * sizeof(T));
+
+    const bool is_test = ctx.Attr<bool>("is_test");
+    if (!is_test) {
+      std::for_each(output_data, &output_data[output->numel()], [](T& val) {
+        val = std::max(val, static_cast<T>(exp(-64)));
+      });
+    }
+
+    output->set_layout(framework::DataLayout::kMKLDNN);
+    output->set_format(input->format());
+  }
 };
 
 template <typename T>
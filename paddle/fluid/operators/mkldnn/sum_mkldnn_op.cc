@@ -50,7 +50,7 @@ class SumMKLDNNHandler
  public:
   SumMKLDNNHandler(mkldnn::engine engine, platform::Place cpu_place,
                    const std::vector<framework::Variable*>& in_vars,
-                   framework::LoDTensor* z)
+                   framework::LoDTensor* z, bool in_place)
 
       : platform::MKLDNNHandlerNoCachingT<T, dnnl::sum>(engine, cpu_place),
         num_inputs_(0) {
@@ -70,8 +70,14 @@ class SumMKLDNNHandler
     }
     std::vector<float> scales(num_inputs_, 1.0);
 
-    auto dst_md = mkldnn::memory::desc(dst_tz, platform::MKLDNNGetDataType<T>(),
-                                       MKLDNNMemoryFormat::any);
+    // For in-place execution the sum primitive accumulates directly into
+    // src[0] provided dst has the very same memory descriptor, so instead of
+    // letting oneDNN pick a layout (and reordering the result back into the
+    // input buffer afterwards) we pin dst to the first input's format.
+    auto dst_md = in_place ? srcs_md[0]
+                           : mkldnn::memory::desc(
+                                 dst_tz, platform::MKLDNNGetDataType<T>(),
+                                 MKLDNNMemoryFormat::any);
 
     this->AcquireForwardPrimitiveDescriptor(dst_md, scales, srcs_md);
   }
@@ -94,10 +100,6 @@ class SumMKLDNNHandler
 
   using platform::MKLDNNHandlerNoCachingT<T, dnnl::sum>::AcquireDstMemory;
 
-  std::shared_ptr<mkldnn::memory> AcquireDstMemory(void) {
-    return this->AcquireMemoryFromPrimitive(this->fwd_pd_->dst_desc());
-  }
-
   inline int GetNumInputs(void) { return num_inputs_; }
 
  private:
@@ -122,7 +124,8 @@ class SumMKLDNNOpKernel : public paddle::framework::OpKernel<T> {
 
     bool in_place = (input0.numel() > 0) && input0.IsSharedBufferWith(*output);
 
-    SumMKLDNNHandler<T> handler(mkldnn_engine, ctx.GetPlace(), in_vars, output);
+    SumMKLDNNHandler<T> handler(mkldnn_engine, ctx.GetPlace(), in_vars, output,
+                                in_place);
 
     // Create list of SRC MEMs
     std::vector<std::shared_ptr<mkldnn::memory>> srcs_mem;
@@ -137,8 +140,11 @@ class SumMKLDNNOpKernel : public paddle::framework::OpKernel<T> {
       ++input_index;
     }
 
-    auto dst_mem = in_place ? handler.AcquireDstMemory()
-                            : handler.AcquireDstMemory(output);
+    // For in-place execution dst shares both the buffer and the memory
+    // descriptor with src[0], which oneDNN sum supports natively, so the
+    // primitive accumulates straight into the input with no intermediate
+    // tensor and no reorder afterwards.
+    auto dst_mem = handler.AcquireDstMemory(output);
 
     auto sum_p = handler.AcquireForwardPrimitive();
 
@@ -152,26 +158,6 @@ class SumMKLDNNOpKernel : public paddle::framework::OpKernel<T> {
     sum_p->execute(astream, args);
     astream.wait();
 
-    // For in-place execution which sum does not have we need to fake it
-    // so from oneDNN dst memory we reorder data into input
-    if (in_place) {
-      auto& in_out = in_vars[0]->Get<framework::LoDTensor>();
-      auto output_tz = framework::vectorize<int64_t>(output->dims());
-      platform::ReorderMKLDNNHandler reorder_handler(
-          output_tz, output->type(), framework::ToMKLDNNDataType(in_out.type()),
-          dev_ctx.GetEngine());
-
-      auto target_mem = reorder_handler.AcquireDstMemory(
-          output, in_out.format(), ctx.GetPlace());
-
-      auto reorder_p = reorder_handler.AcquireReorder(target_mem, dst_mem);
-      {
-        platform::RecordEvent record_reorder("int_reorder",
-                                             platform::EventRole::kUniqueOp);
-        reorder_p->execute(astream, *dst_mem, *target_mem);
-        astream.wait();
-      }
-    }
     output->set_layout(framework::DataLayout::kMKLDNN);
     output->set_format(platform::GetMKLDNNFormat(*dst_mem));
   }
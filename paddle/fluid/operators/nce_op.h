@@ -54,6 +54,15 @@ void PrepareSamples(const framework::ExecutionContext &context,
       sample_labels->mutable_data<int64_t>(context.GetPlace());
 
   int num_label = label_dims.size() == 2 ? label_dims[1] : 1;
+  int num_neg = sample_labels_dims[1] - num_label;
+  // Draw every negative of the batch in one batched call, so samplers with
+  // a vectorized SampleBatch overload (e.g. CustomSampler) amortize the
+  // per-draw cost, then scatter them behind the true labels of each row.
+  std::vector<int64_t> neg_samples;
+  if (custom_neg_classes.empty() && num_neg > 0) {
+    neg_samples.resize(label_dims[0] * num_neg);
+    sampler->SampleBatch(neg_samples.size(), neg_samples.data());
+  }
   int index = 0;
   for (int64_t i = 0; i < label_dims[0]; ++i) {
     int j = 0;
@@ -67,7 +76,7 @@ void PrepareSamples(const framework::ExecutionContext &context,
     } else {
       for (; j < sample_labels_dims[1]; ++j) {
         // TODO(wanghaoshuang): support more distribution sampling
-        sample_labels_data[index++] = sampler->Sample();
+        sample_labels_data[index++] = neg_samples[i * num_neg + (j - num_label)];
       }
     }
   }
@@ -0,0 +1,203 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/operators/amp/fp16_type_traits.h"
+#include "paddle/fluid/operators/optimizers/merged_adam_op.h"
+#include "paddle/fluid/platform/float16.h"
+
+namespace paddle {
+namespace operators {
+
+template <typename T, typename MT>
+__global__ void MergedAdamKernelREG(
+    MT beta1, MT beta2, MT epsilon, MT beta1_pow_, MT beta2_pow_,
+    const MT* moment1, MT* moment1_out, const MT* moment2, MT* moment2_out,
+    const MT* lr_, const T* grad, const T* param, T* param_out,
+    const MT* master_param, MT* master_param_out, int ndim) {
+  MT lr = *lr_;
+  MT beta1_pow = beta1_pow_;
+  MT beta2_pow = beta2_pow_;
+
+  lr *= sqrt(static_cast<MT>(1.0) - beta2_pow) /
+        (static_cast<MT>(1.0) - beta1_pow);
+
+  int id = blockIdx.x * blockDim.x + threadIdx.x;
+
+  for (; id < ndim; id += gridDim.x * blockDim.x) {
+    MT p = master_param ? master_param[id] : static_cast<MT>(param[id]);
+    MT g = static_cast<MT>(grad[id]);
+    MT mom1 = moment1[id];
+    MT mom2 = moment2[id];
+    mom1 = beta1 * mom1 + (static_cast<MT>(1.0) - beta1) * g;
+    mom2 = beta2 * mom2 + (static_cast<MT>(1.0) - beta2) * g * g;
+    p -= lr * (mom1 /
+               (sqrt(mom2) + epsilon * sqrt(static_cast<MT>(1.0) - beta2_pow)));
+
+    moment1_out[id] = mom1;
+    moment2_out[id] = mom2;
+    param_out[id] = static_cast<T>(p);
+    if (master_param_out) {
+      master_param_out[id] = p;
+    }
+  }
+}
+
+template <typename T, typename MT>
+__global__ void MergedAdamKernelMEM(
+    MT beta1, MT beta2, MT epsilon, const MT* beta1_pow_, const MT* beta2_pow_,
+    const MT* moment1, MT* moment1_out, const MT* moment2, MT* moment2_out,
+    const MT* lr_, const T* grad, const T* param, T* param_out,
+    const MT* master_param, MT* master_param_out, int ndim) {
+  MT lr = *lr_;
+  MT beta1_pow = *beta1_pow_;
+  MT beta2_pow = *beta2_pow_;
+
+  lr *= sqrt(static_cast<MT>(1.0) - beta2_pow) /
+        (static_cast<MT>(1.0) - beta1_pow);
+
+  int id = blockIdx.x * blockDim.x + threadIdx.x;
+
+  for (; id < ndim; id += gridDim.x * blockDim.x) {
+    MT p = master_param ? master_param[id] : static_cast<MT>(param[id]);
+    MT g = static_cast<MT>(grad[id]);
+    MT mom1 = static_cast<MT>(moment1[id]);
+    MT mom2 = static_cast<MT>(moment2[id]);
+    mom1 = beta1 * mom1 + (static_cast<MT>(1.0) - beta1) * g;
+    mom2 = beta2 * mom2 + (static_cast<MT>(1.0) - beta2) * g * g;
+    p -= lr * (mom1 /
+               (sqrt(mom2) + epsilon * sqrt(static_cast<MT>(1.0) - beta2_pow)));
+
+    moment1_out[id] = mom1;
+    moment2_out[id] = mom2;
+    param_out[id] = static_cast<T>(p);
+    if (master_param_out) {
+      master_param_out[id] = p;
+    }
+  }
+}
+
+template <typename T>
+__global__ void MergedAdamUpdateBetaPow(T beta1, T beta2, const T* beta1_pow_,
+                                        const T* beta2_pow_, T* beta1_pow_out,
+                                        T* beta2_pow_out) {
+  *beta1_pow_out = beta1 * beta1_pow_[0];
+  *beta2_pow_out = beta2 * beta2_pow_[0];
+}
+
+template <typename T>
+class MergedAdamOpCUDAKernel : public framework::OpKernel<T> {
+ public:
+  void Compute(const framework::ExecutionContext& ctx) const override {
+    using MPDType = typename details::MPTypeTrait<T>::Type;
+
+    MergedAdamParamPack pack(ctx);
+    size_t n = pack.params.size();
+
+    MPDType beta1 = static_cast<MPDType>(ctx.Attr<float>("beta1"));
+    MPDType beta2 = static_cast<MPDType>(ctx.Attr<float>("beta2"));
+    MPDType epsilon = static_cast<MPDType>(ctx.Attr<float>("epsilon"));
+    bool use_global_beta_pow = ctx.Attr<bool>("use_global_beta_pow");
+    VLOG(4) << "use_global_beta_pow:" << use_global_beta_pow;
+
+    const bool multi_precision = ctx.Attr<bool>("multi_precision");
+    auto master_params = ctx.MultiInput<framework::Tensor>("MasterParam");
+    auto master_params_out =
+        ctx.MultiOutput<framework::Tensor>("MasterParamOut");
+    if (multi_precision) {
+      PADDLE_ENFORCE_EQ(
+          n, master_params.size(),
+          platform::errors::InvalidArgument("Input(MasterParam) number must be "
+                                            "equal to Input(Param) number."));
+      PADDLE_ENFORCE_EQ(n, master_params_out.size(),
+                        platform::errors::InvalidArgument(
+                            "Output(MasterParamOut) number must be equal to "
+                            "Input(MasterParam) number."));
+    } else {
+      master_params.clear();
+      master_params_out.clear();
+    }
+
+    auto& dev_ctx = ctx.template device_context<platform::CUDADeviceContext>();
+
+    for (size_t i = 0; i < n; ++i) {
+      const MPDType* master_in_data =
+          multi_precision ? master_params[i]->data<MPDType>() : nullptr;
+      MPDType* master_out_data =
+          multi_precision
+              ? master_params_out[i]->mutable_data<MPDType>(ctx.GetPlace())
+              : nullptr;
+
+      int threads = 512;
+      int blocks = (pack.params[i]->numel() + threads - 1) / threads;
+
+      if (pack.beta1_pows[i]->place() == platform::CPUPlace() &&
+          pack.beta2_pows[i]->place() == platform::CPUPlace()) {
+        // Compute with betapow in REG
+        MergedAdamKernelREG<T, MPDType><<<blocks, threads, 0,
+                                          dev_ctx.stream()>>>(
+            beta1, beta2, epsilon, *pack.beta1_pows[i]->data<MPDType>(),
+            *pack.beta2_pows[i]->data<MPDType>(),
+            pack.moments1[i]->data<MPDType>(),
+            pack.moments1_out[i]->mutable_data<MPDType>(ctx.GetPlace()),
+            pack.moments2[i]->data<MPDType>(),
+            pack.moments2_out[i]->mutable_data<MPDType>(ctx.GetPlace()),
+            pack.lrs[i]->data<MPDType>(), pack.grads[i]->data<T>(),
+            pack.params[i]->data<T>(),
+            pack.params_out[i]->mutable_data<T>(ctx.GetPlace()), master_in_data,
+            master_out_data, pack.params[i]->numel());
+        if (!use_global_beta_pow) {
+          // Cpu update
+          pack.beta1_pows_out[i]->mutable_data<MPDType>(
+              platform::CPUPlace())[0] =
+              beta1 * pack.beta1_pows[i]->data<MPDType>()[0];
+          pack.beta2_pows_out[i]->mutable_data<MPDType>(
+              platform::CPUPlace())[0] =
+              beta2 * pack.beta2_pows[i]->data<MPDType>()[0];
+        }
+      } else {
+        MergedAdamKernelMEM<T, MPDType><<<blocks, threads, 0,
+                                          dev_ctx.stream()>>>(
+            beta1, beta2, epsilon, pack.beta1_pows[i]->data<MPDType>(),
+            pack.beta2_pows[i]->data<MPDType>(),
+            pack.moments1[i]->data<MPDType>(),
+            pack.moments1_out[i]->mutable_data<MPDType>(ctx.GetPlace()),
+            pack.moments2[i]->data<MPDType>(),
+            pack.moments2_out[i]->mutable_data<MPDType>(ctx.GetPlace()),
+            pack.lrs[i]->data<MPDType>(), pack.grads[i]->data<T>(),
+            pack.params[i]->data<T>(),
+            pack.params_out[i]->mutable_data<T>(ctx.GetPlace()), master_in_data,
+            master_out_data, pack.params[i]->numel());
+        if (!use_global_beta_pow) {
+          // Update with gpu
+          MergedAdamUpdateBetaPow<MPDType><<<1, 32, 0, dev_ctx.stream()>>>(
+              beta1, beta2, pack.beta1_pows[i]->data<MPDType>(),
+              pack.beta2_pows[i]->data<MPDType>(),
+              pack.beta1_pows_out[i]->mutable_data<MPDType>(ctx.GetPlace()),
+              pack.beta2_pows_out[i]->mutable_data<MPDType>(ctx.GetPlace()));
+        }
+      }
+    }
+  }
+};
+
+}  // namespace operators
+}  // namespace paddle
+
+namespace ops = paddle::operators;
+namespace plat = paddle::platform;
+
+REGISTER_OP_CUDA_KERNEL(merged_adam,
+                        ops::MergedAdamOpCUDAKernel<plat::float16>,
+                        ops::MergedAdamOpCUDAKernel<float>,
+                        ops::MergedAdamOpCUDAKernel<double>);
@@ -0,0 +1,148 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vector>
+
+#include "paddle/fluid/framework/op_registry.h"
+#include "paddle/fluid/framework/operator.h"
+#include "paddle/fluid/framework/tensor.h"
+#include "paddle/fluid/operators/optimizers/adam_op.h"
+
+namespace paddle {
+namespace operators {
+
+// Gathers the duplicable inputs and outputs of merged_adam and checks that
+// every list has one entry per parameter and that the in-place pairs refer
+// to the same tensors. Shared by the CPU and CUDA kernels.
+struct MergedAdamParamPack {
+  std::vector<const framework::Tensor*> params;
+  std::vector<const framework::Tensor*> grads;
+  std::vector<const framework::Tensor*> lrs;
+  std::vector<const framework::Tensor*> moments1;
+  std::vector<const framework::Tensor*> moments2;
+  std::vector<const framework::Tensor*> beta1_pows;
+  std::vector<const framework::Tensor*> beta2_pows;
+  std::vector<framework::Tensor*> params_out;
+  std::vector<framework::Tensor*> moments1_out;
+  std::vector<framework::Tensor*> moments2_out;
+  std::vector<framework::Tensor*> beta1_pows_out;
+  std::vector<framework::Tensor*> beta2_pows_out;
+
+  explicit MergedAdamParamPack(const framework::ExecutionContext& ctx) {
+    params = ctx.MultiInput<framework::Tensor>("Param");
+    grads = ctx.MultiInput<framework::Tensor>("Grad");
+    lrs = ctx.MultiInput<framework::Tensor>("LearningRate");
+    moments1 = ctx.MultiInput<framework::Tensor>("Moment1");
+    moments2 = ctx.MultiInput<framework::Tensor>("Moment2");
+    beta1_pows = ctx.MultiInput<framework::Tensor>("Beta1Pow");
+    beta2_pows = ctx.MultiInput<framework::Tensor>("Beta2Pow");
+    params_out = ctx.MultiOutput<framework::Tensor>("ParamOut");
+    moments1_out = ctx.MultiOutput<framework::Tensor>("Moment1Out");
+    moments2_out = ctx.MultiOutput<framework::Tensor>("Moment2Out");
+    beta1_pows_out = ctx.MultiOutput<framework::Tensor>("Beta1PowOut");
+    beta2_pows_out = ctx.MultiOutput<framework::Tensor>("Beta2PowOut");
+
+    size_t n = params.size();
+#define PADDLE_CHECK_MERGED_ADAM_SIZE(member, name)                          \
+  PADDLE_ENFORCE_EQ(n, member.size(),                                        \
+                    platform::errors::InvalidArgument(                       \
+                        "The size of %s must be equal to Input(Param) "      \
+                        "number %d, but received %d.",                       \
+                        name, n, member.size()))
+    PADDLE_CHECK_MERGED_ADAM_SIZE(grads, "Input(Grad)");
+    PADDLE_CHECK_MERGED_ADAM_SIZE(lrs, "Input(LearningRate)");
+    PADDLE_CHECK_MERGED_ADAM_SIZE(moments1, "Input(Moment1)");
+    PADDLE_CHECK_MERGED_ADAM_SIZE(moments2, "Input(Moment2)");
+    PADDLE_CHECK_MERGED_ADAM_SIZE(beta1_pows, "Input(Beta1Pow)");
+    PADDLE_CHECK_MERGED_ADAM_SIZE(beta2_pows, "Input(Beta2Pow)");
+    PADDLE_CHECK_MERGED_ADAM_SIZE(params_out, "Output(ParamOut)");
+    PADDLE_CHECK_MERGED_ADAM_SIZE(moments1_out, "Output(Moment1Out)");
+    PADDLE_CHECK_MERGED_ADAM_SIZE(moments2_out, "Output(Moment2Out)");
+    PADDLE_CHECK_MERGED_ADAM_SIZE(beta1_pows_out, "Output(Beta1PowOut)");
+    PADDLE_CHECK_MERGED_ADAM_SIZE(beta2_pows_out, "Output(Beta2PowOut)");
+#undef PADDLE_CHECK_MERGED_ADAM_SIZE
+
+    for (size_t i = 0; i < n; ++i) {
+      PADDLE_ENFORCE_EQ(
+          params[i], params_out[i],
+          platform::errors::InvalidArgument(
+              "Input(Param) and Output(ParamOut) must be the same Tensors."));
+      PADDLE_ENFORCE_EQ(moments1[i], moments1_out[i],
+                        platform::errors::InvalidArgument(
+                            "Input(Moment1) and Output(Moment1Out) must be "
+                            "the same Tensors."));
+      PADDLE_ENFORCE_EQ(moments2[i], moments2_out[i],
+                        platform::errors::InvalidArgument(
+                            "Input(Moment2) and Output(Moment2Out) must be "
+                            "the same Tensors."));
+    }
+  }
+};
+
+template <typename DeviceContext, typename T>
+class MergedAdamOpKernel : public framework::OpKernel<T> {
+ public:
+  void Compute(const framework::ExecutionContext& ctx) const override {
+    PADDLE_ENFORCE_EQ(ctx.Attr<bool>("multi_precision"), false,
+                      platform::errors::Unimplemented(
+                          "The multi_precision mode of merged_adam is only "
+                          "implemented on GPU."));
+    MergedAdamParamPack pack(ctx);
+    size_t n = pack.params.size();
+
+    T beta1 = static_cast<T>(ctx.Attr<float>("beta1"));
+    T beta2 = static_cast<T>(ctx.Attr<float>("beta2"));
+    T epsilon = static_cast<T>(ctx.Attr<float>("epsilon"));
+    bool use_global_beta_pow = ctx.Attr<bool>("use_global_beta_pow");
+    VLOG(4) << "use_global_beta_pow:" << use_global_beta_pow;
+
+    // The output tensors alias the inputs, so mutable_data does not
+    // allocate and the per-parameter updates are independent; build the
+    // functors first and run them in one parallel loop.
+    std::vector<AdamFunctor<T, CPUAdam>> functors;
+    std::vector<int64_t> numels(n);
+    functors.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      functors.emplace_back(
+          beta1, beta2, epsilon, pack.beta1_pows[i]->data<T>(),
+          pack.beta2_pows[i]->data<T>(), pack.moments1[i]->data<T>(),
+          pack.moments1_out[i]->mutable_data<T>(ctx.GetPlace()),
+          pack.moments2[i]->data<T>(),
+          pack.moments2_out[i]->mutable_data<T>(ctx.GetPlace()),
+          pack.lrs[i]->data<T>(), pack.grads[i]->data<T>(),
+          pack.params[i]->data<T>(),
+          pack.params_out[i]->mutable_data<T>(ctx.GetPlace()));
+      numels[i] = pack.params[i]->numel();
+    }
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < n; ++i) {
+      functors[i](numels[i]);
+    }
+    if (!use_global_beta_pow) {
+      for (size_t i = 0; i < n; ++i) {
+        pack.beta1_pows_out[i]->mutable_data<T>(ctx.GetPlace())[0] =
+            beta1 * pack.beta1_pows[i]->data<T>()[0];
+        pack.beta2_pows_out[i]->mutable_data<T>(ctx.GetPlace())[0] =
+            beta2 * pack.beta2_pows[i]->data<T>()[0];
+      }
+    }
+  }
+};
+
+}  // namespace operators
+}  // namespace paddle
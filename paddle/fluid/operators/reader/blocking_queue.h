@@ -14,9 +14,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <condition_variable>  // NOLINT
 #include <deque>
 #include <utility>
+#include <vector>
 
 #include "paddle/fluid/platform/enforce.h"
 
@@ -91,6 +93,36 @@ class BlockingQueue {
     return true;
   }
 
+  // Moves all elements of *elems into the queue, amortizing the lock and
+  // condition variable traffic over the whole batch. Waits for capacity
+  // in between; returns false if the queue is closed or killed before
+  // every element has been enqueued.
+  bool SendBatch(std::vector<T>* elems) {
+    size_t sent = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (sent < elems->size()) {
+      send_cv_.wait(
+          lock, [&] { return queue_.size() < capacity_ || closed_ || killed_; });
+      if (killed_) {
+        VLOG(3)
+            << "WARNING:: Sending an element to a killed reader::BlokcingQueue";
+        return false;
+      }
+      if (closed_) {
+        VLOG(5)
+            << "WARNING: Sending an element to a closed reader::BlokcingQueue.";
+        return false;
+      }
+      while (sent < elems->size() && queue_.size() < capacity_) {
+        queue_.emplace_back(std::move((*elems)[sent]));
+        ++sent;
+      }
+      receive_cv_.notify_all();
+    }
+    elems->clear();
+    return true;
+  }
+
   bool Receive(T* elem) {
     std::unique_lock<std::mutex> lock(mutex_);
     receive_cv_.wait(lock,
@@ -116,6 +148,39 @@ class BlockingQueue {
     }
   }
 
+  // Pops up to max_num elements in one lock acquisition. Blocks until at
+  // least one element is available; returns the number of elements
+  // received, which is 0 iff the queue is closed and drained.
+  size_t ReceiveBatch(std::vector<T>* elems, size_t max_num) {
+    PADDLE_ENFORCE_NOT_NULL(
+        elems, platform::errors::InvalidArgument(
+                   "The holder to receive queue data is null pointer."));
+    elems->clear();
+    std::unique_lock<std::mutex> lock(mutex_);
+    receive_cv_.wait(lock,
+                     [&] { return !queue_.empty() || closed_ || killed_; });
+    EnforceNotKilled();
+    if (queue_.empty()) {
+      PADDLE_ENFORCE_EQ(closed_, true,
+                        platform::errors::PermissionDenied(
+                            "Blocking queue status error, if queue is empty "
+                            "when pop data, it should be closed."));
+      VLOG(3) << "queue is closed! return nothing.";
+      return 0;
+    }
+    size_t num = (std::min)(max_num, queue_.size());
+    for (size_t i = 0; i < num; ++i) {
+      if (LIKELY(!speed_test_mode_)) {
+        elems->emplace_back(std::move(queue_.front()));
+        queue_.pop_front();
+      } else {
+        elems->push_back(queue_[i]);
+      }
+    }
+    send_cv_.notify_all();
+    return num;
+  }
+
   void ReOpen() {
     std::lock_guard<std::mutex> lock(mutex_);
     EnforceNotKilled();
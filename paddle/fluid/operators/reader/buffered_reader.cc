@@ -13,7 +13,12 @@
 // limitations under the License.
 
 #include "paddle/fluid/operators/reader/buffered_reader.h"
+#include <chrono>  // NOLINT
 #include "paddle/fluid/platform/profiler.h"
+#include "paddle/fluid/platform/timer.h"
+
+DECLARE_int32(buffered_reader_prefetch_depth);
+DECLARE_int32(buffered_reader_auto_tune_depth);
 
 namespace paddle {
 namespace operators {
@@ -28,6 +33,13 @@ BufferedReader::~BufferedReader() {
     }
     position_.pop();
   }
+  if (total_batches_ != 0) {
+    VLOG(1) << "BufferedReader stats: " << total_batches_ << " batches, "
+            << starved_batches_ << " starved, trainer waited "
+            << data_wait_us_ / 1000 << " ms for data, upstream reader took "
+            << decode_us_ / 1000 << " ms, final prefetch depth "
+            << buffer_size_;
+  }
 }
 
 BufferedReader::BufferedReader(
@@ -37,8 +49,21 @@ BufferedReader::BufferedReader(
       thread_pool_(1),
       place_(place),
       buffer_size_(buffer_size),
+      max_buffer_size_(buffer_size),
       pin_memory_(pin_memory) {
   VLOG(1) << "BufferedReader";
+  if (FLAGS_buffered_reader_prefetch_depth > 0) {
+    buffer_size_ = static_cast<size_t>(FLAGS_buffered_reader_prefetch_depth);
+    max_buffer_size_ = buffer_size_;
+  }
+  if (static_cast<size_t>(FLAGS_buffered_reader_auto_tune_depth) >
+      max_buffer_size_) {
+    max_buffer_size_ =
+        static_cast<size_t>(FLAGS_buffered_reader_auto_tune_depth);
+  }
+  // Buffers and events are sized for the deepest pipeline the auto-tuner
+  // may reach, so growing buffer_size_ later never reallocates any vector
+  // that the worker thread indexes concurrently.
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
   if (platform::is_gpu_place(place_) && !pin_memory) {
     int dev_idx = BOOST_GET_CONST(platform::CUDAPlace, place_).device;
@@ -46,11 +71,12 @@ BufferedReader::BufferedReader(
         ((platform::CUDADeviceContext *)(platform::DeviceContextPool::Instance()
                                              .Get(place_)))
             ->stream();
-    events_.resize(buffer_size);
+    events_.resize(max_buffer_size_);
     for (auto &event : events_) {
       event = platform::CudaEventResourcePool::Instance().New(dev_idx);
     }
-    stream_ = platform::CudaStreamResourcePool::Instance().New(dev_idx);
+    stream_ = platform::CudaStreamResourcePool::Instance().New(
+        dev_idx, platform::StreamTier::kCopy);
   }
 #endif
 
@@ -61,16 +87,17 @@ BufferedReader::BufferedReader(
         ((platform::NPUDeviceContext *)(platform::DeviceContextPool::Instance()
                                             .Get(place_)))
             ->stream();
-    events_.resize(buffer_size);
+    events_.resize(max_buffer_size_);
     for (auto &event : events_) {
       event = platform::NpuEventResourcePool::Instance().New(dev_idx);
     }
     stream_ = platform::NpuStreamResourcePool::Instance().New(dev_idx);
   }
 #endif
-  cpu_buffer_.resize(buffer_size);
-  cuda_buffer_.resize(buffer_size);
-  npu_buffer_.resize(buffer_size);
+  cpu_buffer_.resize(max_buffer_size_);
+  cuda_buffer_.resize(max_buffer_size_);
+  npu_buffer_.resize(max_buffer_size_);
+  cuda_pinned_buffer_.resize(max_buffer_size_);
   ReadTillBufferFullAsync();
 }
 
@@ -83,7 +110,16 @@ void BufferedReader::ReadTillBufferFullAsync() {
 void BufferedReader::ReadAsync(size_t i) {
   position_.emplace(thread_pool_.enqueue([this, i]() -> size_t {
     TensorVec &cpu = cpu_buffer_[i];
-    reader_->ReadNext(&cpu);
+    {
+      platform::RecordEvent record_event("BufferedReader:ReadNext");
+      platform::Timer timer;
+      timer.Start();
+      reader_->ReadNext(&cpu);
+      timer.Pause();
+      // only the single worker thread writes decode_us_; the destructor
+      // reads it after every enqueued future has been drained
+      decode_us_ += static_cast<uint64_t>(timer.ElapsedUS());
+    }
 
     if (cpu.empty()) {
       return -1UL;
@@ -147,6 +183,11 @@ void BufferedReader::ReadAsync(size_t i) {
         // TensorCopySync would block other stream, because TensorCopySync
         // issues the copying command to the default stream, it will make two
         // commands from different streams cannot run concurrently.
+        TensorVec &cuda_pinned = cuda_pinned_buffer_[i];
+        if (cuda_pinned.size() < cpu.size()) {
+          cuda_pinned.resize(cpu.size());
+        }
+
         std::vector<void *> gpu_ptrs;
         gpu_ptrs.reserve(cpu.size());
         for (size_t i = 0; i < cpu.size(); ++i) {
@@ -188,8 +229,12 @@ void BufferedReader::ReadAsync(size_t i) {
                          BOOST_GET_CONST(platform::CUDAPlace, cpu_place),
                          cpu_ptr, size, stream_.get());
           } else {
+            // Stage the copy through the slot's pinned tensor. It stays
+            // alive until the tail synchronization below, so there is no
+            // need to synchronize per tensor and the H2D copies of one
+            // batch overlap on the dedicated stream.
             platform::CUDAPinnedPlace cuda_pinned_place;
-            framework::LoDTensor cuda_pinned_tensor;
+            auto &cuda_pinned_tensor = cuda_pinned[i];
             cuda_pinned_tensor.Resize(cpu[i].dims());
             auto cuda_pinned_ptr = cuda_pinned_tensor.mutable_data(
                 cuda_pinned_place, cpu[i].type());
@@ -199,11 +244,6 @@ void BufferedReader::ReadAsync(size_t i) {
             memory::Copy(BOOST_GET_CONST(platform::CUDAPlace, place_), gpu_ptr,
                          cuda_pinned_place, cuda_pinned_ptr, size,
                          stream_.get());
-#ifdef PADDLE_WITH_HIP
-            PADDLE_ENFORCE_CUDA_SUCCESS(hipStreamSynchronize(stream_.get()));
-#else
-            PADDLE_ENFORCE_CUDA_SUCCESS(cudaStreamSynchronize(stream_.get()));
-#endif
           }
           cuda[i].set_lod(cpu[i].lod());
         }
@@ -271,6 +311,29 @@ void BufferedReader::ReadAsync(size_t i) {
   }));
 }
 
+void BufferedReader::TuneBufferDepth(bool starved) {
+  ++window_batches_;
+  if (starved) {
+    ++window_starved_;
+  }
+  constexpr size_t kTuneWindow = 64;
+  if (window_batches_ < kTuneWindow) {
+    return;
+  }
+  // Deepen the pipeline when at least half of the last window arrived
+  // before the worker finished the next batch, i.e. training is
+  // input-bound and one more in-flight batch may hide the gap.
+  if (window_starved_ * 2 >= kTuneWindow && buffer_size_ < max_buffer_size_) {
+    VLOG(3) << "BufferedReader is input-bound (" << window_starved_ << "/"
+            << kTuneWindow << " starved batches), growing prefetch depth to "
+            << buffer_size_ + 1;
+    ReadAsync(buffer_size_);
+    ++buffer_size_;
+  }
+  window_batches_ = 0;
+  window_starved_ = 0;
+}
+
 void BufferedReader::ShutdownImpl() {
   VLOG(1) << "ShutdownImpl";
   reader_->Shutdown();
@@ -290,6 +353,19 @@ void BufferedReader::ReadNextImpl(std::vector<framework::LoDTensor> *out) {
     out->clear();
     return;
   }
+  bool starved = position_.front().wait_for(std::chrono::seconds(0)) !=
+                 std::future_status::ready;
+  if (starved) {
+    platform::RecordEvent record_event("BufferedReader:WaitForData");
+    platform::Timer timer;
+    timer.Start();
+    position_.front().wait();
+    timer.Pause();
+    data_wait_us_ += static_cast<uint64_t>(timer.ElapsedUS());
+    ++starved_batches_;
+  }
+  ++total_batches_;
+  TuneBufferDepth(starved);
   size_t i = position_.front().get();
   position_.pop();
 
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <queue>
@@ -49,6 +50,12 @@ class BufferedReader : public framework::DecoratedReader {
 
   void ReadAsync(size_t i);
 
+  // Watermark based auto-tuner: counts how often ReadNextImpl arrives
+  // before the next batch is ready and, when starvation dominates a
+  // window, rotates one more preallocated slot into the pipeline until
+  // FLAGS_buffered_reader_auto_tune_depth is reached.
+  void TuneBufferDepth(bool starved);
+
  protected:
   void ShutdownImpl() override;
   void StartImpl() override;
@@ -57,11 +64,27 @@ class BufferedReader : public framework::DecoratedReader {
  private:
   ThreadPool thread_pool_;
   platform::Place place_;
-  const size_t buffer_size_;
+  // current prefetch depth; can grow up to max_buffer_size_ when the
+  // auto-tuner detects that training is input-bound
+  size_t buffer_size_;
+  // all buffers and events are allocated for this many slots up front,
+  // so deepening the pipeline never reallocates under the worker thread
+  size_t max_buffer_size_;
   bool pin_memory_;
 
   std::queue<std::future<size_t>> position_;
 
+  // instrumentation: how long the trainer blocked waiting for data and
+  // how long the worker spent in the upstream reader; a summary is
+  // logged on destruction, the per-batch spans show up in the profiler
+  // as BufferedReader:WaitForData and BufferedReader:ReadNext
+  uint64_t data_wait_us_{0};
+  uint64_t decode_us_{0};
+  size_t total_batches_{0};
+  size_t starved_batches_{0};
+  size_t window_batches_{0};
+  size_t window_starved_{0};
+
   // The buffer for reading data.
   // NOTE: the simplest way to implement buffered reader is do not use any
   // buffer, just read async and create futures as buffer size. However, to
@@ -70,6 +93,11 @@ class BufferedReader : public framework::DecoratedReader {
   std::vector<TensorVec> cpu_buffer_;
   std::vector<TensorVec> cuda_buffer_;
   std::vector<TensorVec> npu_buffer_;
+  // Ring of pinned staging tensors for CPU -> GPU copies, one entry per
+  // buffer slot. The tensors keep their pinned holders across batches, so
+  // once they have grown to the observed batch sizes the steady state does
+  // no pinned allocation at all.
+  std::vector<TensorVec> cuda_pinned_buffer_;
   size_t prev_pos_{-1UL};
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
   gpuStream_t compute_stream_;
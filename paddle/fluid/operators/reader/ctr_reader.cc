@@ -0,0 +1,499 @@
+// Copyright (c) 2018 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/operators/reader/ctr_reader.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <utility>
+
+namespace paddle {
+namespace operators {
+namespace reader {
+
+std::ostream& operator<<(std::ostream& os, const DataDesc& data_desc) {
+  os << "data_desc:\n";
+  os << "\tbatch_size -> " << data_desc.batch_size_ << "\n";
+  os << "\tfile_type -> " << data_desc.file_type_ << "\n";
+  os << "\tfile_format -> " << data_desc.file_format_ << "\n";
+  os << "\tfile_names -> {";
+  for (auto& file_name : data_desc.file_names_) {
+    os << file_name << ",";
+  }
+  os << "}\n";
+  os << "\tdense_slot_index -> {";
+  for (auto& slot : data_desc.dense_slot_index_) {
+    os << slot << ",";
+  }
+  os << "}\n";
+  os << "\tsparse_slot_index_ -> {";
+  for (auto& slot : data_desc.sparse_slot_index_) {
+    os << slot << ",";
+  }
+  os << "}\n";
+  os << "\tsparse_slot_ids_ -> {";
+  for (auto& slot : data_desc.sparse_slot_ids_) {
+    os << slot << ",";
+  }
+  os << "}\n";
+  return os;
+}
+
+static inline void string_split(const std::string& s, const char sep,
+                                std::vector<std::string>* ret) {
+  size_t begin = 0;
+  size_t end = s.find(sep);
+  while (end != std::string::npos) {
+    ret->push_back(s.substr(begin, end - begin));
+    begin = end + 1;
+    end = s.find(sep, begin);
+  }
+  if (begin < s.length()) {
+    ret->push_back(s.substr(begin));
+  }
+}
+
+// Sequential line source over one shard. The shard is consumed in fixed
+// size chunks; each call returns the complete lines of one chunk and
+// carries the trailing partial line over to the next call.
+class LineStream {
+ public:
+  virtual ~LineStream() {}
+
+  // Fills *block with the complete lines of the next chunk. Returns false
+  // when the shard is exhausted; *block may still contain the final lines.
+  bool NextBlock(LineBlock* block) {
+    block->clear();
+    size_t n = ReadChunk(buf_.data(), buf_.size());
+    if (n == 0) {
+      if (!tail_.empty()) {
+        block->push_back(std::move(tail_));
+        tail_.clear();
+      }
+      return false;
+    }
+    size_t begin = 0;
+    for (size_t i = 0; i < n; ++i) {
+      if (buf_[i] == '\n') {
+        tail_.append(buf_.data() + begin, i - begin);
+        if (!tail_.empty()) {
+          block->push_back(std::move(tail_));
+        }
+        tail_.clear();
+        begin = i + 1;
+      }
+    }
+    tail_.append(buf_.data() + begin, n - begin);
+    return true;
+  }
+
+ protected:
+  // Returns the number of bytes read, 0 at end of file.
+  virtual size_t ReadChunk(char* buf, size_t len) = 0;
+
+ private:
+  // 1MB of decompressed data per block bounds the channel memory while
+  // still amortizing the queue synchronization over many lines.
+  static constexpr size_t kChunkBytes = 1 << 20;
+  std::vector<char> buf_ = std::vector<char>(kChunkBytes);
+  std::string tail_;
+};
+
+class PlainFileLineStream : public LineStream {
+ public:
+  explicit PlainFileLineStream(const std::string& file_name)
+      : fin_(file_name, std::ios::binary) {
+    PADDLE_ENFORCE_EQ(fin_.good(), true,
+                      platform::errors::NotFound(
+                          "The file %s could not be opened.", file_name));
+  }
+
+ protected:
+  size_t ReadChunk(char* buf, size_t len) override {
+    fin_.read(buf, len);
+    return static_cast<size_t>(fin_.gcount());
+  }
+
+ private:
+  std::ifstream fin_;
+};
+
+class GzipFileLineStream : public LineStream {
+ public:
+  explicit GzipFileLineStream(const std::string& file_name)
+      : file_(gzopen(file_name.c_str(), "rb")) {
+    PADDLE_ENFORCE_NOT_NULL(
+        file_, platform::errors::NotFound(
+                   "The gzip file %s could not be opened.", file_name));
+  }
+
+  ~GzipFileLineStream() override {
+    if (file_ != nullptr) {
+      gzclose(file_);
+    }
+  }
+
+ protected:
+  size_t ReadChunk(char* buf, size_t len) override {
+    int n = gzread(file_, buf, static_cast<unsigned int>(len));
+    PADDLE_ENFORCE_GE(n, 0, platform::errors::Unavailable(
+                                "gzread failed with error code %d.", n));
+    return static_cast<size_t>(n);
+  }
+
+ private:
+  gzFile file_;
+};
+
+static std::unique_ptr<LineStream> OpenShard(const std::string& file_name,
+                                             const std::string& file_type) {
+  if (file_type == "gzip") {
+    return std::unique_ptr<LineStream>(new GzipFileLineStream(file_name));
+  } else if (file_type == "plain") {
+    return std::unique_ptr<LineStream>(new PlainFileLineStream(file_name));
+  }
+  PADDLE_THROW(platform::errors::InvalidArgument(
+      "File type %s is not supported, should be gzip or plain.", file_type));
+}
+
+// Claims shards from the shared cursor until every shard has been read,
+// so threads that finish short shards immediately steal the next one and
+// the long tail is all that remains serialized.
+static void DecompressThread(const DataDesc& data_desc,
+                             std::atomic<size_t>* next_file,
+                             std::atomic<int>* active_decompressors,
+                             std::shared_ptr<BlockingQueue<LineBlock>> channel,
+                             size_t thread_id) {
+  VLOG(3) << "decompress thread " << thread_id << " start";
+  for (;;) {
+    size_t file_idx = next_file->fetch_add(1);
+    if (file_idx >= data_desc.file_names_.size()) {
+      break;
+    }
+    const std::string& file_name = data_desc.file_names_[file_idx];
+    VLOG(3) << "decompress thread " << thread_id << " reads " << file_name;
+    auto stream = OpenShard(file_name, data_desc.file_type_);
+    LineBlock block;
+    bool more = true;
+    while (more) {
+      more = stream->NextBlock(&block);
+      if (!block.empty() && !channel->Send(std::move(block))) {
+        VLOG(3) << "block channel is closed, decompress thread "
+                << thread_id << " stop";
+        if (active_decompressors->fetch_sub(1) == 1) {
+          channel->Close();
+        }
+        return;
+      }
+    }
+  }
+  VLOG(3) << "decompress thread " << thread_id << " stop";
+  if (active_decompressors->fetch_sub(1) == 1) {
+    channel->Close();
+  }
+}
+
+// label slot1:feasign slot2:feasign ...
+static inline void parse_svm_line(
+    const std::string& line,
+    const std::unordered_map<std::string, size_t>& slot_to_index,
+    int64_t* label, std::vector<std::vector<int64_t>>* slot_to_data) {
+  std::vector<std::string> ret;
+  string_split(line, ' ', &ret);
+  *label = std::strtol(ret[0].c_str(), nullptr, 10) > 0;
+  for (size_t i = 1; i < ret.size(); ++i) {
+    const std::string& item = ret[i];
+    std::vector<std::string> feasign_and_slot;
+    string_split(item, ':', &feasign_and_slot);
+    if (feasign_and_slot.size() == 2) {
+      auto it = slot_to_index.find(feasign_and_slot[0]);
+      if (it != slot_to_index.end()) {
+        int64_t feasign =
+            std::strtoll(feasign_and_slot[1].c_str(), nullptr, 10);
+        (*slot_to_data)[it->second].push_back(feasign);
+      }
+    }
+  }
+}
+
+// Assembles one batch of svm instances: a LoDTensor of feasigns per
+// sparse slot, the label tensor last.
+static void PushSvmBatch(
+    const DataDesc& data_desc,
+    const std::vector<std::vector<std::vector<int64_t>>>& batch_data,
+    const std::vector<int64_t>& batch_label,
+    std::shared_ptr<LoDTensorBlockingQueue> queue) {
+  std::vector<framework::LoDTensor> lod_datas;
+  size_t slot_num = data_desc.sparse_slot_ids_.size();
+  for (size_t slot_idx = 0; slot_idx < slot_num; ++slot_idx) {
+    std::vector<size_t> lod_data{0};
+    std::vector<int64_t> batch_feasign;
+    for (size_t i = 0; i < batch_data.size(); ++i) {
+      auto& feasign = batch_data[i][slot_idx];
+      lod_data.push_back(lod_data.back() + feasign.size());
+      batch_feasign.insert(batch_feasign.end(), feasign.begin(),
+                           feasign.end());
+    }
+    framework::LoDTensor lod_tensor;
+    framework::LoD lod{lod_data};
+    lod_tensor.set_lod(lod);
+    int64_t* tensor_data = lod_tensor.mutable_data<int64_t>(
+        framework::make_ddim(
+            {1, static_cast<int64_t>(batch_feasign.size())}),
+        platform::CPUPlace());
+    memcpy(tensor_data, batch_feasign.data(),
+           batch_feasign.size() * sizeof(int64_t));
+    lod_datas.push_back(lod_tensor);
+  }
+
+  framework::LoDTensor label_tensor;
+  int64_t* label_tensor_data = label_tensor.mutable_data<int64_t>(
+      framework::make_ddim({1, static_cast<int64_t>(batch_label.size())}),
+      platform::CPUPlace());
+  memcpy(label_tensor_data, batch_label.data(),
+         batch_label.size() * sizeof(int64_t));
+  lod_datas.push_back(label_tensor);
+
+  queue->Push(lod_datas);
+  VLOG(4) << "push one svm data, queue_size=" << queue->Size();
+}
+
+static void ParseSvmThread(const DataDesc& data_desc,
+                           std::shared_ptr<BlockingQueue<LineBlock>> channel,
+                           std::atomic<int>* active_parsers,
+                           std::shared_ptr<LoDTensorBlockingQueue> queue,
+                           size_t thread_id) {
+  VLOG(3) << "parse thread " << thread_id << " start";
+  size_t slot_num = data_desc.sparse_slot_ids_.size();
+  std::unordered_map<std::string, size_t> slot_to_index;
+  for (size_t i = 0; i < slot_num; ++i) {
+    slot_to_index[data_desc.sparse_slot_ids_[i]] = i;
+  }
+
+  std::vector<std::vector<std::vector<int64_t>>> batch_data;
+  std::vector<int64_t> batch_label;
+  batch_data.reserve(data_desc.batch_size_);
+  batch_label.reserve(data_desc.batch_size_);
+
+  LineBlock block;
+  while (channel->Receive(&block)) {
+    for (auto& line : block) {
+      int64_t label;
+      std::vector<std::vector<int64_t>> slot_to_data(slot_num);
+      parse_svm_line(line, slot_to_index, &label, &slot_to_data);
+      batch_data.push_back(std::move(slot_to_data));
+      batch_label.push_back(label);
+      if (batch_data.size() == static_cast<size_t>(data_desc.batch_size_)) {
+        PushSvmBatch(data_desc, batch_data, batch_label, queue);
+        batch_data.clear();
+        batch_label.clear();
+      }
+    }
+  }
+  if (!batch_data.empty()) {
+    PushSvmBatch(data_desc, batch_data, batch_label, queue);
+  }
+  VLOG(3) << "parse thread " << thread_id << " stop";
+  if (active_parsers->fetch_sub(1) == 1) {
+    queue->Close();
+  }
+}
+
+// label col1 col2 ..., dense columns hold one float, sparse columns hold
+// comma separated feasigns
+static void PushCsvBatch(const DataDesc& data_desc,
+                         const std::vector<std::vector<std::string>>& batch,
+                         std::shared_ptr<LoDTensorBlockingQueue> queue) {
+  std::vector<framework::LoDTensor> lod_datas;
+  size_t batch_size = batch.size();
+
+  // first insert tensor for each dense_slot
+  for (auto dense_slot_index : data_desc.dense_slot_index_) {
+    framework::LoDTensor lod_tensor;
+    float* tensor_data = lod_tensor.mutable_data<float>(
+        framework::make_ddim({static_cast<int64_t>(batch_size), 1}),
+        platform::CPUPlace());
+    for (size_t i = 0; i < batch_size; ++i) {
+      tensor_data[i] =
+          std::strtof(batch[i][dense_slot_index].c_str(), nullptr);
+    }
+    lod_datas.push_back(lod_tensor);
+  }
+
+  // second insert tensor for each sparse_slot
+  for (auto sparse_slot_index : data_desc.sparse_slot_index_) {
+    std::vector<size_t> lod_data{0};
+    std::vector<int64_t> batch_feasign;
+    for (size_t i = 0; i < batch_size; ++i) {
+      std::vector<std::string> feasigns;
+      string_split(batch[i][sparse_slot_index], ',', &feasigns);
+      lod_data.push_back(lod_data.back() + feasigns.size());
+      for (auto& f : feasigns) {
+        batch_feasign.push_back(std::strtoll(f.c_str(), nullptr, 10));
+      }
+    }
+    framework::LoDTensor lod_tensor;
+    framework::LoD lod{lod_data};
+    lod_tensor.set_lod(lod);
+    int64_t* tensor_data = lod_tensor.mutable_data<int64_t>(
+        framework::make_ddim(
+            {1, static_cast<int64_t>(batch_feasign.size())}),
+        platform::CPUPlace());
+    memcpy(tensor_data, batch_feasign.data(),
+           batch_feasign.size() * sizeof(int64_t));
+    lod_datas.push_back(lod_tensor);
+  }
+
+  // insert label tensor last
+  framework::LoDTensor label_tensor;
+  int64_t* label_tensor_data = label_tensor.mutable_data<int64_t>(
+      framework::make_ddim({static_cast<int64_t>(batch_size), 1}),
+      platform::CPUPlace());
+  for (size_t i = 0; i < batch_size; ++i) {
+    label_tensor_data[i] = std::strtol(batch[i][0].c_str(), nullptr, 10) > 0;
+  }
+  lod_datas.push_back(label_tensor);
+
+  queue->Push(lod_datas);
+  VLOG(4) << "push one csv data, queue_size=" << queue->Size();
+}
+
+static void ParseCsvThread(const DataDesc& data_desc,
+                           std::shared_ptr<BlockingQueue<LineBlock>> channel,
+                           std::atomic<int>* active_parsers,
+                           std::shared_ptr<LoDTensorBlockingQueue> queue,
+                           size_t thread_id) {
+  VLOG(3) << "parse thread " << thread_id << " start";
+  std::vector<std::vector<std::string>> batch;
+  batch.reserve(data_desc.batch_size_);
+
+  LineBlock block;
+  while (channel->Receive(&block)) {
+    for (auto& line : block) {
+      std::vector<std::string> columns;
+      string_split(line, ' ', &columns);
+      if (columns.empty()) {
+        continue;
+      }
+      batch.push_back(std::move(columns));
+      if (batch.size() == static_cast<size_t>(data_desc.batch_size_)) {
+        PushCsvBatch(data_desc, batch, queue);
+        batch.clear();
+      }
+    }
+  }
+  if (!batch.empty()) {
+    PushCsvBatch(data_desc, batch, queue);
+  }
+  VLOG(3) << "parse thread " << thread_id << " stop";
+  if (active_parsers->fetch_sub(1) == 1) {
+    queue->Close();
+  }
+}
+
+CTRReader::CTRReader(const std::shared_ptr<LoDTensorBlockingQueue>& queue,
+                     int thread_num, const DataDesc& data_desc)
+    : framework::FileReader({}, {}, {}),
+      thread_num_(std::max(thread_num, 1)),
+      data_desc_(data_desc) {
+  PADDLE_ENFORCE_GT(data_desc.file_names_.size(), 0,
+                    platform::errors::InvalidArgument(
+                        "The file list of CTRReader is empty."));
+  PADDLE_ENFORCE_NOT_NULL(queue, platform::errors::InvalidArgument(
+                                     "The queue of CTRReader is null."));
+  PADDLE_ENFORCE_EQ(
+      data_desc.file_format_ == "svm" || data_desc.file_format_ == "csv", true,
+      platform::errors::InvalidArgument(
+          "File format %s is not supported, should be svm or csv.",
+          data_desc.file_format_));
+  queue_ = queue;
+  StartThreads();
+}
+
+CTRReader::~CTRReader() { Shutdown(); }
+
+void CTRReader::ReadNextImpl(std::vector<framework::LoDTensor>* out) {
+  bool success;
+  *out = queue_->Pop(&success);
+  if (!success) out->clear();
+}
+
+void CTRReader::ShutdownImpl() {
+  VLOG(3) << "Shutdown reader";
+  if (block_channel_ != nullptr) {
+    block_channel_->Close();
+  }
+  queue_->Close();
+  JoinThreads();
+}
+
+void CTRReader::StartImpl() {
+  VLOG(3) << "Start reader";
+  queue_->ReOpen();
+  StartThreads();
+}
+
+void CTRReader::StartThreads() {
+  // one block per in-flight chunk plus some slack, so a stalled parser
+  // pool backpressures the decompressors instead of buffering a shard
+  block_channel_.reset(
+      new BlockingQueue<LineBlock>(static_cast<size_t>(thread_num_) * 4));
+  next_file_ = 0;
+
+  size_t decompress_num =
+      std::min(static_cast<size_t>(thread_num_), data_desc_.file_names_.size());
+  active_decompressors_ = static_cast<int>(decompress_num);
+  active_parsers_ = thread_num_;
+
+  for (size_t i = 0; i < decompress_num; ++i) {
+    decompress_threads_.emplace_back(
+        new std::thread(DecompressThread, std::ref(data_desc_), &next_file_,
+                        &active_decompressors_, block_channel_, i));
+  }
+  for (int i = 0; i < thread_num_; ++i) {
+    if (data_desc_.file_format_ == "svm") {
+      parse_threads_.emplace_back(
+          new std::thread(ParseSvmThread, std::ref(data_desc_), block_channel_,
+                          &active_parsers_, queue_, i));
+    } else {
+      parse_threads_.emplace_back(
+          new std::thread(ParseCsvThread, std::ref(data_desc_), block_channel_,
+                          &active_parsers_, queue_, i));
+    }
+  }
+}
+
+void CTRReader::JoinThreads() {
+  for (auto& thread : decompress_threads_) {
+    if (thread->joinable()) {
+      thread->join();
+    }
+  }
+  for (auto& thread : parse_threads_) {
+    if (thread->joinable()) {
+      thread->join();
+    }
+  }
+  decompress_threads_.clear();
+  parse_threads_.clear();
+}
+
+}  // namespace reader
+}  // namespace operators
+}  // namespace paddle
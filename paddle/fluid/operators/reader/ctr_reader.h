@@ -0,0 +1,113 @@
+// Copyright (c) 2018 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "paddle/fluid/framework/reader.h"
+#include "paddle/fluid/operators/reader/blocking_queue.h"
+#include "paddle/fluid/operators/reader/lod_tensor_blocking_queue.h"
+
+namespace paddle {
+namespace operators {
+namespace reader {
+
+struct DataDesc {
+  DataDesc(int batch_size, const std::vector<std::string>& file_names,
+           const std::string& file_type, const std::string& file_format,
+           const std::vector<int>& dense_slot_index,
+           const std::vector<int>& sparse_slot_index,
+           const std::vector<std::string>& sparse_slot_ids)
+      : batch_size_(batch_size),
+        file_names_(file_names),
+        file_type_(file_type),
+        file_format_(file_format),
+        dense_slot_index_(dense_slot_index),
+        sparse_slot_index_(sparse_slot_index),
+        sparse_slot_ids_(sparse_slot_ids) {}
+
+  const int batch_size_;
+  const std::vector<std::string> file_names_;
+  const std::string file_type_;    // gzip or plain
+  const std::string file_format_;  // svm or csv
+  // used for csv data format
+  const std::vector<int> dense_slot_index_;
+  const std::vector<int> sparse_slot_index_;
+  // used for svm data format
+  const std::vector<std::string> sparse_slot_ids_;
+};
+
+std::ostream& operator<<(std::ostream& os, const DataDesc& data_desc);
+
+// A block of complete lines cut out of one decompressed chunk of a shard.
+using LineBlock = std::vector<std::string>;
+
+// CTRReader ingests a list of (possibly gzip compressed) CTR log shards
+// and feeds batches into a LoDTensorBlockingQueue.
+//
+// Ingestion is a two stage pipeline so that epoch time tracks the total
+// number of bytes instead of the largest shard:
+//   1. decompress threads claim shards from a shared cursor (work
+//      stealing, so short shards free their thread for the long tail),
+//      stream each shard in fixed size chunks and publish blocks of
+//      complete lines into a bounded block channel;
+//   2. thread_num parse threads drain the channel, parse blocks from any
+//      shard and assemble batches, so a single oversized shard is parsed
+//      by the whole pool instead of one thread.
+// Plain gzip members are not seekable, therefore decompression itself
+// stays sequential per shard; the chunking bounds memory and keeps the
+// parse pool busy from the first chunk on.
+class CTRReader : public framework::FileReader {
+ public:
+  CTRReader(const std::shared_ptr<LoDTensorBlockingQueue>& queue,
+            int thread_num, const DataDesc& data_desc);
+
+  ~CTRReader() override;
+
+ protected:
+  void ReadNextImpl(std::vector<framework::LoDTensor>* out) override;
+
+  void ShutdownImpl() override;
+
+  void StartImpl() override;
+
+ private:
+  void StartThreads();
+
+  void JoinThreads();
+
+  const int thread_num_;
+  const DataDesc data_desc_;
+  std::shared_ptr<LoDTensorBlockingQueue> queue_;
+
+  std::shared_ptr<BlockingQueue<LineBlock>> block_channel_;
+  // next unclaimed shard; decompress threads fetch_add on it
+  std::atomic<size_t> next_file_{0};
+  // the last decompress thread to finish closes block_channel_
+  std::atomic<int> active_decompressors_{0};
+  // the last parse thread to finish closes queue_
+  std::atomic<int> active_parsers_{0};
+
+  std::vector<std::unique_ptr<std::thread>> decompress_threads_;
+  std::vector<std::unique_ptr<std::thread>> parse_threads_;
+};
+
+}  // namespace reader
+}  // namespace operators
+}  // namespace paddle
@@ -49,6 +49,18 @@ class LoDTensorBlockingQueue {
     return lod_tensor_vec;
   }
 
+  // Batched transfer: moves a group of samples under one lock
+  // acquisition, so producers and the consumer stop paying one
+  // mutex round trip per sample.
+  bool PushBatch(std::vector<std::vector<framework::LoDTensor>>* batch) {
+    return queue_.SendBatch(batch);
+  }
+
+  size_t PopBatch(std::vector<std::vector<framework::LoDTensor>>* batch,
+                  size_t max_num) {
+    return queue_.ReceiveBatch(batch, max_num);
+  }
+
   inline size_t Cap() const { return queue_.Cap(); }
 
   inline size_t Size() const { return queue_.Size(); }
@@ -198,6 +210,136 @@ class OrderedMultiDeviceLoDTensorBlockingQueue {
   mutable std::condition_variable cv_;
 };
 
+// Shards the queue per producer so that many DataLoader workers stop
+// serializing on a single mutex: producer i only ever touches shard
+// i % shard_num, and the consumer drains the shards in strict round
+// robin. The rotation keeps per-producer FIFO order and a deterministic
+// interleaving across producers, the same property the ordered
+// multi-device queue above provides on the push side. A producer that
+// finishes must call CloseShard so the consumer's rotation can skip its
+// shard instead of blocking on it.
+class ShardedLoDTensorBlockingQueue {
+ public:
+  ShardedLoDTensorBlockingQueue(size_t capacity, size_t shard_num,
+                                bool speed_test_mode = false) {
+    PADDLE_ENFORCE_GE(shard_num, 1,
+                      platform::errors::InvalidArgument(
+                          "Shard number of ShardedLoDTensorBlockingQueue "
+                          "must be at least 1, but received %d.",
+                          shard_num));
+    auto cap = (capacity + shard_num - 1) / shard_num;
+    queues_.reserve(shard_num);
+    for (size_t i = 0; i < shard_num; ++i) {
+      queues_.emplace_back(new LoDTensorBlockingQueue(cap, speed_test_mode));
+    }
+  }
+
+  ~ShardedLoDTensorBlockingQueue() {
+    VLOG(10) << "Destruct ShardedLoDTensorBlockingQueue";
+  }
+
+  bool Push(size_t producer_idx,
+            const std::vector<framework::LoDTensor>& lod_tensor_vec) {
+    return Shard(producer_idx)->Push(lod_tensor_vec);
+  }
+
+  bool Push(size_t producer_idx,
+            std::vector<framework::LoDTensor>&& lod_tensor_vec) {
+    return Shard(producer_idx)->Push(std::move(lod_tensor_vec));
+  }
+
+  bool PushBatch(size_t producer_idx,
+                 std::vector<std::vector<framework::LoDTensor>>* batch) {
+    return Shard(producer_idx)->PushBatch(batch);
+  }
+
+  void CloseShard(size_t producer_idx) { Shard(producer_idx)->Close(); }
+
+  // Consumer side. Blocks on the current shard until it yields a sample;
+  // a shard that is closed and drained leaves the rotation.
+  std::vector<framework::LoDTensor> Pop(bool* ok = nullptr) {
+    for (size_t tried = 0; tried < queues_.size(); ++tried) {
+      bool success = false;
+      auto data = queues_[pop_index_ % queues_.size()]->Pop(&success);
+      ++pop_index_;
+      if (success) {
+        if (ok != nullptr) *ok = true;
+        return data;
+      }
+    }
+    if (ok != nullptr) *ok = false;
+    return {};
+  }
+
+  size_t PopBatch(std::vector<std::vector<framework::LoDTensor>>* batch,
+                  size_t max_num) {
+    for (size_t tried = 0; tried < queues_.size(); ++tried) {
+      size_t num =
+          queues_[pop_index_ % queues_.size()]->PopBatch(batch, max_num);
+      ++pop_index_;
+      if (num > 0) {
+        return num;
+      }
+    }
+    return 0;
+  }
+
+  inline size_t ShardNum() const { return queues_.size(); }
+
+  inline size_t Cap() const {
+    size_t cap = 0;
+    for (auto& item : queues_) {
+      cap += item->Cap();
+    }
+    return cap;
+  }
+
+  inline size_t Size() const {
+    size_t size = 0;
+    for (auto& item : queues_) {
+      size += item->Size();
+    }
+    return size;
+  }
+
+  inline void ReOpen() {
+    for (auto& item : queues_) {
+      item->ReOpen();
+    }
+    pop_index_ = 0;
+  }
+
+  inline void Close() {
+    VLOG(1) << "ShardedLoDTensorBlockingQueue close";
+    for (auto& item : queues_) {
+      item->Close();
+    }
+  }
+
+  inline bool IsClosed() const {
+    for (auto& item : queues_) {
+      if (!item->IsClosed()) return false;
+    }
+    return true;
+  }
+
+  inline void Kill() {
+    for (auto& item : queues_) {
+      item->Kill();
+    }
+  }
+
+  inline bool WaitForInited(size_t) { return true; }
+
+ private:
+  const std::shared_ptr<LoDTensorBlockingQueue>& Shard(size_t producer_idx) {
+    return queues_[producer_idx % queues_.size()];
+  }
+
+  std::vector<std::shared_ptr<LoDTensorBlockingQueue>> queues_;
+  uint64_t pop_index_{0};
+};
+
 class LoDTensorBlockingQueueHolder {
  public:
   void InitOnce(size_t capacity, bool speed_test_mode = false) {
@@ -216,6 +358,27 @@ class LoDTensorBlockingQueueHolder {
   std::shared_ptr<LoDTensorBlockingQueue> queue_;
 };
 
+class ShardedLoDTensorBlockingQueueHolder {
+ public:
+  void InitOnce(size_t capacity, size_t shard_num,
+                bool speed_test_mode = false) {
+    PADDLE_ENFORCE_EQ(
+        queue_, nullptr,
+        platform::errors::AlreadyExists("ShardedLoDTensorBlockingQueueHolder::"
+                                        "InitOnce() can only be called once"));
+    queue_.reset(new ShardedLoDTensorBlockingQueue(capacity, shard_num,
+                                                   speed_test_mode));
+  }
+
+  inline const std::shared_ptr<ShardedLoDTensorBlockingQueue>& GetQueue()
+      const {
+    return queue_;
+  }
+
+ private:
+  std::shared_ptr<ShardedLoDTensorBlockingQueue> queue_;
+};
+
 class OrderedMultiDeviceLoDTensorBlockingQueueHolder {
  public:
   void InitOnce(size_t capacity, bool speed_test_mode = false) {
@@ -238,3 +238,45 @@ TEST(BlockingQueue, speed_test_mode) {
   }
   EXPECT_EQ(q2.Size(), queue_size);
 }
+
+TEST(BlockingQueue, SendBatchReceiveBatchTest) {
+  const size_t queue_cap = 4;
+  const size_t elem_num = 10;
+  BlockingQueue<size_t> q(queue_cap);
+  std::thread sender([&]() {
+    std::vector<size_t> batch;
+    for (size_t i = 0; i < elem_num; ++i) {
+      batch.push_back(i);
+    }
+    // larger than the capacity, so the sender has to wait for the
+    // receiver to drain the queue in between
+    EXPECT_TRUE(q.SendBatch(&batch));
+    EXPECT_TRUE(batch.empty());
+    q.Close();
+  });
+  size_t count = 0;
+  std::vector<size_t> received;
+  while (true) {
+    size_t num = q.ReceiveBatch(&received, 3);
+    if (num == 0) {
+      break;
+    }
+    EXPECT_LE(num, 3UL);
+    EXPECT_EQ(num, received.size());
+    for (size_t i = 0; i < num; ++i) {
+      EXPECT_EQ(received[i], count++);
+    }
+  }
+  sender.join();
+  EXPECT_EQ(count, elem_num);
+  EXPECT_TRUE(q.IsClosed());
+}
+
+TEST(BlockingQueue, SendBatchToClosedQueueTest) {
+  BlockingQueue<size_t> q(2);
+  q.Close();
+  std::vector<size_t> batch{1, 2, 3};
+  EXPECT_FALSE(q.SendBatch(&batch));
+  std::vector<size_t> received;
+  EXPECT_EQ(q.ReceiveBatch(&received, 3), 0UL);
+}
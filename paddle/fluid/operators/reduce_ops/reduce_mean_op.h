@@ -26,6 +26,19 @@ struct MeanFunctor {
   }
 };
 
+template <>
+struct CPUReduceScalarTraits<MeanFunctor> {
+  static constexpr bool enabled = true;
+  template <typename T>
+  static T Reduce(T a, T b) {
+    return a + b;
+  }
+  template <typename T>
+  static T Finalize(T a, int64_t reduce_num) {
+    return a / static_cast<T>(reduce_num);
+  }
+};
+
 struct MeanGradFunctor {
   template <typename DeviceContext, typename X, typename Y, typename DX,
             typename DY, typename Dim>
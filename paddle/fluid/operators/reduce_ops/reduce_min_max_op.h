@@ -25,6 +25,19 @@ struct MaxFunctor {
   }
 };
 
+template <>
+struct CPUReduceScalarTraits<MaxFunctor> {
+  static constexpr bool enabled = true;
+  template <typename T>
+  static T Reduce(T a, T b) {
+    return a > b ? a : b;
+  }
+  template <typename T>
+  static T Finalize(T a, int64_t reduce_num) {
+    return a;
+  }
+};
+
 struct MinFunctor {
   template <typename DeviceContext, typename X, typename Y, typename Dim>
   void operator()(const DeviceContext& place, X* x, Y* y, const Dim& dim) {
@@ -32,6 +45,19 @@ struct MinFunctor {
   }
 };
 
+template <>
+struct CPUReduceScalarTraits<MinFunctor> {
+  static constexpr bool enabled = true;
+  template <typename T>
+  static T Reduce(T a, T b) {
+    return a < b ? a : b;
+  }
+  template <typename T>
+  static T Finalize(T a, int64_t reduce_num) {
+    return a;
+  }
+};
+
 struct MaxOrMinGradFunctor {
   template <typename DeviceContext, typename X, typename Y, typename DX,
             typename DY, typename Dim>
@@ -84,6 +84,122 @@ static inline std::vector<int> GetReduceDim(const std::vector<int>& dims,
   }
   return reduce_dims;
 }
+// Scalar counterparts of the Eigen reduce functors, used by the cache-blocked
+// CPU reduce engine below. A reduce functor opts in by specializing this next
+// to its Eigen definition (sum/mean/max/min do); reductions without a
+// specialization keep the Eigen path.
+template <typename Functor>
+struct CPUReduceScalarTraits {
+  static constexpr bool enabled = false;
+};
+
+// View the reduction as {pre, red, post}, which is only possible when the
+// reduced axes form one contiguous run in the shape.
+inline bool GetReduce3DView(const DDim& src_dims,
+                            const std::vector<int>& reduce_dims, int64_t* pre,
+                            int64_t* red, int64_t* post) {
+  std::vector<int> rdims(reduce_dims);
+  if (rdims.empty()) {
+    return false;
+  }
+  for (auto& d : rdims) {
+    d = d >= 0 ? d : d + src_dims.size();
+  }
+  std::sort(rdims.begin(), rdims.end());
+  for (size_t i = 1; i < rdims.size(); ++i) {
+    if (rdims[i] != rdims[i - 1] + 1) {
+      return false;
+    }
+  }
+  *pre = 1;
+  *red = 1;
+  *post = 1;
+  for (int i = 0; i < rdims.front(); ++i) {
+    (*pre) *= src_dims[i];
+  }
+  for (auto d : rdims) {
+    (*red) *= src_dims[d];
+  }
+  for (int i = rdims.back() + 1; i < src_dims.size(); ++i) {
+    (*post) *= src_dims[i];
+  }
+  return true;
+}
+
+// Hand-written CPU reduction over the {pre, red, post} view. When post == 1
+// every output element owns one contiguous input row, so the rows are simply
+// partitioned across threads. Otherwise the output row is processed in
+// L1-sized tiles: the tile stays hot in cache while the whole reduced
+// dimension streams over it once, and the (pre, tile) pairs are partitioned
+// across threads so axis-0 reductions with pre == 1 still use all cores.
+template <typename Traits, typename T>
+void CPUBlockedReduce(const T* x, T* out, int64_t pre, int64_t red,
+                      int64_t post) {
+  if (post == 1) {
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+    for (int64_t p = 0; p < pre; ++p) {
+      const T* row = x + p * red;
+      T acc = row[0];
+      for (int64_t r = 1; r < red; ++r) {
+        acc = Traits::Reduce(acc, row[r]);
+      }
+      out[p] = Traits::Finalize(acc, red);
+    }
+  } else {
+    constexpr int64_t tile = 2048;
+    const int64_t num_tiles = (post + tile - 1) / tile;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+    for (int64_t pt = 0; pt < pre * num_tiles; ++pt) {
+      const int64_t p = pt / num_tiles;
+      const int64_t begin = (pt % num_tiles) * tile;
+      const int64_t end = std::min(begin + tile, post);
+      const T* base = x + p * red * post;
+      T* out_row = out + p * post;
+      for (int64_t j = begin; j < end; ++j) {
+        out_row[j] = base[j];
+      }
+      for (int64_t r = 1; r < red; ++r) {
+        const T* src = base + r * post;
+        for (int64_t j = begin; j < end; ++j) {
+          out_row[j] = Traits::Reduce(out_row[j], src[j]);
+        }
+      }
+      for (int64_t j = begin; j < end; ++j) {
+        out_row[j] = Traits::Finalize(out_row[j], red);
+      }
+    }
+  }
+}
+
+template <typename Functor, typename OutT>
+typename std::enable_if<CPUReduceScalarTraits<Functor>::enabled, bool>::type
+TryCPUScalarReduce(const Tensor* input, Tensor* output,
+                   const std::vector<int>& dims) {
+  // small reductions are not worth splitting across threads
+  constexpr int64_t kMinReduceSize = 1 << 15;
+  if (input->numel() < kMinReduceSize) {
+    return false;
+  }
+  int64_t pre, red, post;
+  if (!GetReduce3DView(input->dims(), dims, &pre, &red, &post) || red <= 1) {
+    return false;
+  }
+  CPUBlockedReduce<CPUReduceScalarTraits<Functor>>(
+      input->data<OutT>(), output->data<OutT>(), pre, red, post);
+  return true;
+}
+
+template <typename Functor, typename OutT>
+typename std::enable_if<!CPUReduceScalarTraits<Functor>::enabled, bool>::type
+TryCPUScalarReduce(const Tensor* input, Tensor* output,
+                   const std::vector<int>& dims) {
+  return false;
+}
+
 template <typename DeviceContext, typename OutT>
 void GetShuffledInput(const framework::ExecutionContext& context,
                       const Tensor* input, Tensor* shuffled_input,
@@ -196,6 +312,10 @@ struct ReduceKernelFunctor {
       Functor functor;
       functor(place, &x, &out, reduce_dim);
     } else {
+      if (std::is_same<DeviceContext, platform::CPUDeviceContext>::value &&
+          TryCPUScalarReduce<Functor, OutT>(input, output, dims)) {
+        return;
+      }
       int ndim = input->dims().size();
       int rdim = dims.size();
       if (ndim > 6) {
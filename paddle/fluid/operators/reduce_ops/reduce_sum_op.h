@@ -106,6 +106,19 @@ struct SumFunctor {
   }
 };
 
+template <>
+struct CPUReduceScalarTraits<SumFunctor> {
+  static constexpr bool enabled = true;
+  template <typename T>
+  static T Reduce(T a, T b) {
+    return a + b;
+  }
+  template <typename T>
+  static T Finalize(T a, int64_t reduce_num) {
+    return a;
+  }
+};
+
 struct SumGradFunctor {
   template <typename DeviceContext, typename X, typename Y, typename DX,
             typename DY, typename Dim>
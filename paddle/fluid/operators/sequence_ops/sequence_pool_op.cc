@@ -182,7 +182,9 @@ REGISTER_OPERATOR(sequence_pool_grad, ops::SequencePoolGradOp,
 REGISTER_OP_CPU_KERNEL(
     sequence_pool,
     ops::SequencePoolKernel<paddle::platform::CPUDeviceContext, float>,
-    ops::SequencePoolKernel<paddle::platform::CPUDeviceContext, double>);
+    ops::SequencePoolKernel<paddle::platform::CPUDeviceContext, double>,
+    ops::SequencePoolKernel<paddle::platform::CPUDeviceContext,
+                            paddle::platform::bfloat16>);
 
 REGISTER_OP_CPU_KERNEL(
     sequence_pool_grad,
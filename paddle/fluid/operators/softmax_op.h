@@ -60,7 +60,8 @@ class SoftmaxKernel : public framework::OpKernel<T> {
     auto* X = context.Input<Tensor>("X");
     auto* Out = context.Output<Tensor>("Out");
     const int rank = X->dims().size();
-    const int axis = CanonicalAxis(context.Attr<int>("axis"), rank);
+    static const framework::InternedAttrName kAxis("axis");
+    const int axis = CanonicalAxis(context.Attr<int>(kAxis), rank);
     int axis_dim = X->dims()[axis];
 
     // allocate memory on device.
@@ -95,7 +96,8 @@ class SoftmaxGradKernel : public framework::OpKernel<T> {
     auto* dOut = context.Input<Tensor>(framework::GradVarName("Out"));
     auto* dX = context.Output<Tensor>(framework::GradVarName("X"));
     const int rank = dX->dims().size();
-    const int axis = CanonicalAxis(context.Attr<int>("axis"), rank);
+    static const framework::InternedAttrName kAxis("axis");
+    const int axis = CanonicalAxis(context.Attr<int>(kAxis), rank);
     int axis_dim = dX->dims()[axis];
 
     // allocate memory on device.
@@ -13,6 +13,8 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #pragma once
+#include <cmath>
+
 #include "paddle/fluid/framework/eigen.h"
 #include "paddle/fluid/framework/op_registry.h"
 #include "paddle/fluid/operators/math/cross_entropy.h"
@@ -118,6 +120,69 @@ class SoftmaxWithCrossEntropyKernel : public framework::OpKernel<T> {
     labels_2d.ShareDataWith(*labels).Resize({n, labels->numel() / n});
     loss_2d.ShareDataWith(*loss).Resize({n, d / axis_dim});
 
+    const int remain = d / axis_dim;
+    if (!soft_label && remain == 1) {
+      // Fused path for the common hard-label, last-axis case. A single
+      // parallel sweep over each row computes the maximum, the exponentials
+      // and their sum, and derives the loss from the log-sum-exp, instead of
+      // a full softmax pass followed by a second full read of the softmax
+      // tensor in CrossEntropyFunctor. For large class counts this halves
+      // the memory traffic of the forward computation. The softmax output
+      // is still written since it is an op output consumed by the backward.
+      const T* logits_data = logits->data<T>();
+      T* softmax_data = softmax->data<T>();
+      T* loss_data = loss->data<T>();
+      const int64_t* label_data = labels->data<int64_t>();
+      const int ignore_index = context.Attr<int>("ignore_index");
+      // Validate labels before entering the parallel region; throwing from
+      // inside an omp worker would terminate the process.
+      for (int i = 0; i < n; ++i) {
+        const int64_t lbl = label_data[i];
+        if (lbl == ignore_index) continue;
+        PADDLE_ENFORCE_GE(lbl, 0,
+                          platform::errors::OutOfRange(
+                              "label value should >= 0 when label "
+                              "value(%f) not equal to ignore_index(%f)",
+                              lbl, ignore_index));
+        PADDLE_ENFORCE_LT(
+            lbl, axis_dim,
+            platform::errors::OutOfRange(
+                "label value should less than the shape of axis dimension "
+                "when label value(%f) not equal to ignore_index(%f), But "
+                "received label value as %ld and shape of axis dimension "
+                "is %d",
+                lbl, ignore_index, lbl, axis_dim));
+      }
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+      for (int i = 0; i < n; ++i) {
+        const T* in = logits_data + i * d;
+        T* out = softmax_data + i * d;
+        T max_val = in[0];
+        for (int k = 1; k < d; ++k) {
+          max_val = in[k] > max_val ? in[k] : max_val;
+        }
+        T sum = static_cast<T>(0);
+        for (int k = 0; k < d; ++k) {
+          const T e = std::exp(in[k] - max_val);
+          out[k] = e;
+          sum += e;
+        }
+        const T scale = static_cast<T>(1) / sum;
+        for (int k = 0; k < d; ++k) {
+          out[k] *= scale;
+        }
+        const int64_t lbl = label_data[i];
+        // log(sum) - (in[lbl] - max_val) == -log(softmax[lbl]), computed
+        // from the logits directly for better accuracy; sum >= 1 here.
+        loss_data[i] = lbl == ignore_index
+                           ? static_cast<T>(0)
+                           : std::log(sum) - (in[lbl] - max_val);
+      }
+      return;
+    }
+
     auto& dev_ctx =
         context.template device_context<platform::CPUDeviceContext>();
     math::SoftmaxFunctor<platform::CPUDeviceContext, T, false>()(
@@ -215,6 +280,35 @@ class SoftmaxWithCrossEntropyGradKernel : public framework::OpKernel<T> {
     }
     // for use_softmax=False, continue
 
+    if (!soft_label && d == axis_dim) {
+      // Fused path for the common hard-label, last-axis case: compute
+      // (softmax - one_hot) * dy in one parallel sweep per row, instead of
+      // a whole-matrix Eigen broadcast multiply followed by a second serial
+      // pass over the labels.
+      const int64_t* label_data = labels->data<int64_t>();
+      T* logit_grad_data = logit_grad->data<T>();
+      const T* out_grad_data = out_grad->data<T>();
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+      for (int i = 0; i < n; ++i) {
+        T* row = logit_grad_data + i * d;
+        const int64_t lbl = label_data[i];
+        if (lbl == ignore_index) {
+          for (int k = 0; k < d; ++k) {
+            row[k] = 0;
+          }
+        } else {
+          const T dy = out_grad_data[i];
+          for (int k = 0; k < d; ++k) {
+            row[k] *= dy;
+          }
+          row[lbl] -= dy;
+        }
+      }
+      return;
+    }
+
     if (soft_label) {
       // when soft_label = True, ignore_index is not supported
       auto lbl_mat = framework::EigenMatrix<T>::From(labels_2d);
@@ -22,8 +22,6 @@ limitations under the License. */
 #include <unordered_set>
 #include <vector>
 
-#include <boost/algorithm/string.hpp>
-
 #include "paddle/fluid/framework/string_array.h"
 #include "paddle/fluid/operators/string/faster_tokenizer_op.h"
 
@@ -102,6 +100,7 @@ void BasicTokenizer::Tokenize(const string& text, vector<wstring>* res) const {
   }
 
   std::wstring dest_text;
+  dest_text.reserve(unicode_text.size());
   for (auto ch : unicode_text) {
     if (ch == 0 || ch == 0xfffd || IsControl(ch)) {
       continue;
@@ -119,7 +118,19 @@ void BasicTokenizer::Tokenize(const string& text, vector<wstring>* res) const {
       dest_text += ch;
     }
   }
-  boost::split(*res, dest_text, boost::is_any_of(kStripChars));
+  // Split on whitespace runs directly; unlike boost::split this does not
+  // materialize an empty token per consecutive separator.
+  size_t pos = 0;
+  while (pos < dest_text.size()) {
+    size_t next = dest_text.find_first_of(kStripChars, pos);
+    if (next == std::wstring::npos) {
+      next = dest_text.size();
+    }
+    if (next > pos) {
+      res->emplace_back(dest_text, pos, next - pos);
+    }
+    pos = next + 1;
+  }
 }
 
 WordPieceTokenizer::WordPieceTokenizer(
@@ -147,25 +158,32 @@ void WordPieceTokenizer::Tokenize(const wstring& text,
 
   size_t start = 0;
   vector<int64_t> wordpiece_ids;
+  // All longest-match candidates share one buffer: the "##" prefix plus
+  // suffix is written once per start position and shrunk one character per
+  // probe, so the inner loop does no per-candidate allocation.
+  std::wstring candidate;
+  candidate.reserve(len + 2);
   while (start < len) {
+    candidate.clear();
+    if (start > 0) {
+      candidate.append(L"##");
+    }
+    candidate.append(text, start, len - start);
     size_t end = len;
-    std::wstring cur_substr;
-    int64_t cur_substr_id;
+    int64_t cur_substr_id = 0;
+    bool found = false;
     while (start < end) {
-      std::wstring sub = text.substr(start, end - start);
-      if (start > 0) {
-        sub = L"##" + sub;
-      }
-      auto it = vocab_->find(sub);
-      if (it != vocab_->end()) {
-        cur_substr = sub;
-        cur_substr_id = it->second;
+      auto vocab_it = vocab_->find(candidate);
+      if (vocab_it != vocab_->end()) {
+        found = true;
+        cur_substr_id = vocab_it->second;
         break;
       }
       end -= 1;
+      candidate.pop_back();
     }
 
-    if (cur_substr.empty()) {
+    if (!found) {
       token_ids->emplace_back(std::move(unk_token_id_));
       return;
     } else {
@@ -76,7 +76,11 @@ class TopkOpCUDAKernel : public framework::OpKernel<T> {
         framework::slice_ddim(inputdims, 0, inputdims.size() - 1));
     const int64_t input_width = inputdims[inputdims.size() - 1];
     const auto& dev_ctx = ctx.cuda_device_context();
-    if ((input_width <= 1024 || k >= 128 || k == input_width)) {
+    // Also route high-batch inputs through the single segmented radix sort:
+    // beyond 2048 rows the heap kernel's grid saturates and blocks start
+    // processing rows serially, while cub sorts all segments in one launch.
+    if ((input_width <= 1024 || k >= 128 || k == input_width ||
+         input_height > 2048)) {
       if (SortTopk<T>(dev_ctx, input, input_width, input_height, k, output,
                       indices)) {
         // Successed, return.
@@ -20,11 +20,43 @@ limitations under the License. */
 #include "paddle/fluid/framework/eigen.h"
 #include "paddle/fluid/framework/op_registry.h"
 
+#ifdef PADDLE_WITH_MKLML
+#include <omp.h>
+#endif
+
 namespace paddle {
 namespace operators {
 
 using Tensor = framework::Tensor;
 
+// Selects the k largest (value, index) pairs of data[begin, end) with a
+// min-heap of size k and appends them to *candidates sorted descending.
+// A candidate smaller than the heap root is rejected with one compare, so
+// for k << n almost every element is touched exactly once and nothing is
+// written, instead of materializing n pairs and partially sorting them.
+template <typename T>
+static void SelectTopkInRange(const T* data, size_t begin, size_t end, size_t k,
+                              std::vector<std::pair<T, size_t>>* candidates) {
+  auto greater = [](const std::pair<T, size_t>& l,
+                    const std::pair<T, size_t>& r) { return l.first > r.first; };
+  size_t heap_start = candidates->size();
+  size_t j = begin;
+  for (; j < end && j - begin < k; ++j) {
+    candidates->push_back(std::pair<T, size_t>(data[j], j));
+  }
+  std::make_heap(candidates->begin() + heap_start, candidates->end(), greater);
+  for (; j < end; ++j) {
+    if (data[j] > (*(candidates->begin() + heap_start)).first) {
+      std::pop_heap(candidates->begin() + heap_start, candidates->end(),
+                    greater);
+      candidates->back() = std::pair<T, size_t>(data[j], j);
+      std::push_heap(candidates->begin() + heap_start, candidates->end(),
+                     greater);
+    }
+  }
+  std::sort_heap(candidates->begin() + heap_start, candidates->end(), greater);
+}
+
 template <typename DeviceContext, typename T>
 class TopkKernel : public framework::OpKernel<T> {
  public:
@@ -53,11 +85,64 @@ class TopkKernel : public framework::OpKernel<T> {
         framework::slice_ddim(inputdims, 0, inputdims.size() - 1));
     const size_t col = inputdims[inputdims.size() - 1];
     Eigen::DSizes<int, 2> flat2dims(row, col);
+    const T* input_data = input->data<T>();
+    // When k is much smaller than the row width, heap selection over the
+    // raw row beats building and partially sorting a vector of col pairs:
+    // the scan stops scaling with col * log(col) and almost never writes.
+    const bool use_selection = k * 8 < col;
+
+#ifdef PADDLE_WITH_MKLML
+    const size_t num_threads = static_cast<size_t>(omp_get_max_threads());
+    if (use_selection && row < num_threads) {
+      // Few long rows (e.g. top-50 of 1M candidates): the rows alone
+      // cannot feed every thread, so parallelize across blocks within
+      // each row and reduce the per-block winners.
+      const size_t num_blocks = std::min(num_threads, col / (k * 8));
+      const size_t block_len = (col + num_blocks - 1) / num_blocks;
+      for (size_t i = 0; i < row; i++) {
+        const T* row_data = input_data + i * col;
+        std::vector<std::vector<std::pair<T, size_t>>> block_candidates(
+            num_blocks);
+#pragma omp parallel for
+        for (size_t b = 0; b < num_blocks; b++) {
+          size_t begin = b * block_len;
+          size_t end = std::min(col, begin + block_len);
+          SelectTopkInRange(row_data, begin, end, k, &block_candidates[b]);
+        }
+        std::vector<std::pair<T, size_t>> candidates;
+        candidates.reserve(num_blocks * k);
+        for (auto& block : block_candidates) {
+          candidates.insert(candidates.end(), block.begin(), block.end());
+        }
+        std::partial_sort(
+            candidates.begin(), candidates.begin() + k, candidates.end(),
+            [](const std::pair<T, size_t>& l, const std::pair<T, size_t>& r) {
+              return l.first > r.first;
+            });
+        for (size_t j = 0; j < k; j++) {
+          output_data[i * k + j] = candidates[j].first;
+          indices_data[i * k + j] = int64_t(candidates[j].second);
+        }
+      }
+      return;
+    }
+#endif
 // NOTE: eigen shape doesn't affect paddle tensor.
 #ifdef PADDLE_WITH_MKLML
 #pragma omp parallel for
 #endif
     for (size_t i = 0; i < row; i++) {
+      if (use_selection) {
+        std::vector<std::pair<T, size_t>> selected;
+        selected.reserve(k);
+        SelectTopkInRange(input_data + i * col, static_cast<size_t>(0), col, k,
+                          &selected);
+        for (size_t j = 0; j < k; j++) {
+          output_data[i * k + j] = selected[j].first;
+          indices_data[i * k + j] = int64_t(selected[j].second);
+        }
+        continue;
+      }
       std::vector<std::pair<T, size_t>> vec;
       vec.reserve(col);
       // 1D vector
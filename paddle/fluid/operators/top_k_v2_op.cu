@@ -83,7 +83,11 @@ class TopkV2OpCUDAKernel : public framework::OpKernel<T> {
 
       if (k > input_width) k = input_width;
 
-      if ((input_width <= 1024 || k >= 128 || k == input_width)) {
+      // Also route high-batch inputs through the single segmented radix sort:
+      // beyond 2048 rows the heap kernel's grid saturates and blocks start
+      // processing rows serially, while cub sorts all segments in one launch.
+      if ((input_width <= 1024 || k >= 128 || k == input_width ||
+           input_height > 2048)) {
         if (SortTopk<T>(dev_ctx, input, input_width, input_height, k, output,
                         indices, largest)) {
           // Successed, return.
@@ -16,6 +16,7 @@ limitations under the License. */
 
 #include <vector>
 #include "paddle/fluid/framework/op_registry.h"
+#include "paddle/fluid/operators/math/blocked_transpose.h"
 #include "paddle/fluid/operators/math/math_function.h"
 
 namespace paddle {
@@ -23,10 +24,48 @@ namespace operators {
 
 enum { kTransposeMKLDNNFP32 = 1, kTransposeMKLDNNINT8 = 2 };
 
+template <typename T, typename DeviceContext>
+inline bool TryTransposeBlocked(const DeviceContext& dev_ctx,
+                                const framework::Tensor& in,
+                                framework::Tensor* out,
+                                const std::vector<int>& axis) {
+  return false;
+}
+
+// On CPU, route the permutations that amount to (batched) 2-D matrix
+// transposes through the tiled engine in math/blocked_transpose.h instead
+// of the single-threaded Eigen shuffle. Small tensors keep the Eigen path;
+// the tiling overhead only pays off once the matrix falls out of cache.
+template <typename T>
+inline bool TryTransposeBlocked(const platform::CPUDeviceContext& dev_ctx,
+                                const framework::Tensor& in,
+                                framework::Tensor* out,
+                                const std::vector<int>& axis) {
+  constexpr int64_t kMinBlockedTransposeSize = 16384;
+  if (in.numel() < kMinBlockedTransposeSize) {
+    return false;
+  }
+  auto dims = in.dims();
+  if (axis == std::vector<int>{1, 0}) {
+    math::TransposeBlocked2D<T>(in.data<T>(), out->data<T>(), 1, dims[0],
+                                dims[1]);
+    return true;
+  }
+  if (axis == std::vector<int>{0, 2, 1}) {
+    math::TransposeBlocked2D<T>(in.data<T>(), out->data<T>(), dims[0], dims[1],
+                                dims[2]);
+    return true;
+  }
+  return false;
+}
+
 template <typename DeviceContext, typename T>
 inline void TransCompute(const int dim, const DeviceContext& dev_ctx,
                          const framework::Tensor& in, framework::Tensor* out,
                          const std::vector<int>& axis) {
+  if (TryTransposeBlocked<T>(dev_ctx, in, out, axis)) {
+    return;
+  }
   switch (dim) {
     case 1:
       math::Transpose<DeviceContext, T, 1> trans1;
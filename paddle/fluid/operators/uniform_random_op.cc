@@ -18,17 +18,52 @@ limitations under the License. */
 #include "paddle/fluid/framework/generator.h"
 #include "paddle/fluid/framework/op_registry.h"
 #include "paddle/fluid/framework/operator.h"
+#include "paddle/fluid/framework/philox_engine.h"
 #include "paddle/fluid/platform/bfloat16.h"
 
 namespace paddle {
 namespace operators {
 
 namespace {
+// Fills below this size stay on the sequential engine; the parallel
+// counter-based path only pays off on large tensors.
+constexpr int64_t kMinParallelRandomSize = 8192;
+
 template <typename T>
 inline void UniformRealDistribution(T *data, const int64_t &size,
                                     const float &min, const float &max,
                                     const unsigned int &seed) {
   VLOG(4) << "[CPU] UniformRandomKernel<T>";
+#ifdef PADDLE_WITH_MKLML
+  if (size >= kMinParallelRandomSize) {
+    // Counter-based fill: every block of the Philox stream is addressed
+    // by its index, so threads sample disjoint ranges independently and
+    // the result is reproducible for a fixed seed at any thread count.
+    uint64_t philox_seed = seed;
+    if (philox_seed == 0) {
+      auto engine = paddle::framework::GetCPURandomEngine(0);
+      philox_seed = (*engine)();
+    }
+    paddle::framework::PhiloxEngine philox(philox_seed);
+    const double range = static_cast<double>(max) - static_cast<double>(min);
+    const int64_t num_blocks = (size + 1) / 2;
+#pragma omp parallel for
+    for (int64_t b = 0; b < num_blocks; ++b) {
+      auto block = philox(b);
+      int64_t i = b * 2;
+      data[i] = static_cast<T>(
+          min + paddle::framework::PhiloxEngine::Uniform01(block[0], block[1]) *
+                    range);
+      if (i + 1 < size) {
+        data[i + 1] = static_cast<T>(
+            min +
+            paddle::framework::PhiloxEngine::Uniform01(block[2], block[3]) *
+                range);
+      }
+    }
+    return;
+  }
+#endif
   std::uniform_real_distribution<T> dist(static_cast<T>(min),
                                          static_cast<T>(max));
   auto engine = paddle::framework::GetCPURandomEngine(seed);
@@ -111,6 +111,64 @@ NCCLComm* NCCLCommContext::CreateComm(ncclUniqueId* nccl_id, int nranks,
   return comm_wrapper;
 }
 
+void NCCLCommContext::CreateComms(const std::vector<ncclUniqueId*>& nccl_ids,
+                                  int nranks, int rank, int dev_id,
+                                  int first_ring_id) {
+  PADDLE_ENFORCE_GT(nccl_ids.size(), 0,
+                    platform::errors::InvalidArgument(
+                        "Expected the size of nccl_ids > 0. But received the "
+                        "size of nccl_ids is %d.",
+                        nccl_ids.size()));
+  for (auto* nccl_id : nccl_ids) {
+    PADDLE_ENFORCE_NOT_NULL(nccl_id,
+                            platform::errors::InvalidArgument(
+                                "The nccl unique id should not be null."));
+  }
+  PADDLE_ENFORCE_GT(
+      nranks, 1,
+      platform::errors::InvalidArgument(
+          "Expected nranks > 1. But received nranks is %d.", nranks));
+  PADDLE_ENFORCE_GE(rank, 0,
+                    platform::errors::InvalidArgument(
+                        "Expected rank >= 0. But received rank is %d.", rank));
+  PADDLE_ENFORCE_LT(
+      rank, nranks,
+      platform::errors::InvalidArgument(
+          "Expected rank < nranks. But received rank is %d, nranks is %d.",
+          rank, nranks));
+  PADDLE_ENFORCE_GE(
+      dev_id, 0,
+      platform::errors::InvalidArgument(
+          "Expected dev_id >= 0. But received dev_id is %d.", dev_id));
+
+  std::vector<ncclComm_t> comms(nccl_ids.size(), nullptr);
+  SetDeviceId(dev_id);
+  {
+    // one grouped bootstrap: every ring exchanges its bootstrap information
+    // concurrently, so the setup time no longer grows linearly with the
+    // number of rings
+    PADDLE_ENFORCE_CUDA_SUCCESS(dynload::ncclGroupStart());
+    for (size_t i = 0; i < nccl_ids.size(); ++i) {
+      PADDLE_ENFORCE_CUDA_SUCCESS(platform::dynload::ncclCommInitRank(
+          &comms[i], nranks, *nccl_ids[i], rank));
+    }
+    PADDLE_ENFORCE_CUDA_SUCCESS(dynload::ncclGroupEnd());
+  }
+
+  // the communicators are only guaranteed to be set after ncclGroupEnd, so
+  // they are wrapped and registered afterwards
+  for (size_t i = 0; i < nccl_ids.size(); ++i) {
+    int ring_id = first_ring_id + static_cast<int>(i);
+    AssignNCCLComm(comms[i], nranks, rank, dev_id, ring_id);
+    VLOG(1) << "nccl communicator of rank " << rank << " in ring " << ring_id
+            << " has been created on device " << dev_id;
+  }
+
+  std::call_once(once_flag_, []() {
+    std::atexit([]() { NCCLCommContext::Instance().ReleaseNCCLComms(); });
+  });
+}
+
 void NCCLCommContext::CreateAllNCCLComms(const std::vector<int>& dev_ids,
                                          int ring_id) {
   PADDLE_ENFORCE_GT(
@@ -75,6 +75,12 @@ class NCCLCommContext {
   NCCLComm* CreateComm(ncclUniqueId* nccl_id, int nranks, int rank, int dev_id,
                        int ring_id = 0);
 
+  // create one communicator per ring in a single nccl group, so the rings
+  // bootstrap concurrently over the shared connections instead of one
+  // after another
+  void CreateComms(const std::vector<ncclUniqueId*>& nccl_ids, int nranks,
+                   int rank, int dev_id, int first_ring_id = 0);
+
   void CreateAllNCCLComms(const std::vector<int>& dev_ids, int ring_id = 0);
 
   void CreateNCCLCommMultiTrainer(const std::vector<int>& dev_ids,
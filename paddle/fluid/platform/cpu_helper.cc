@@ -14,6 +14,16 @@ limitations under the License. */
 
 #include "paddle/fluid/platform/cpu_helper.h"
 
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "glog/logging.h"
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+#include <sched.h>
+#endif
+
 #ifdef PADDLE_WITH_MKLML
 #include <omp.h>
 
@@ -52,5 +62,95 @@ void SetNumThreads(int num_threads) {
 #endif
 }
 
+#if !defined(_WIN32) && !defined(__APPLE__)
+namespace {
+
+// Reads a sysfs cpulist file with comma separated ranges, e.g. "0-9,40-49",
+// into core ids. Returns an empty vector when the file does not exist.
+std::vector<int> ReadCpuListFile(const std::string &path) {
+  std::vector<int> core_ids;
+  std::ifstream fin(path);
+  if (!fin.is_open()) {
+    return core_ids;
+  }
+  std::string range;
+  while (std::getline(fin, range, ',')) {
+    int begin = 0;
+    int end = 0;
+    auto dash = range.find('-');
+    if (dash == std::string::npos) {
+      begin = end = std::stoi(range);
+    } else {
+      begin = std::stoi(range.substr(0, dash));
+      end = std::stoi(range.substr(dash + 1));
+    }
+    for (int core_id = begin; core_id <= end; ++core_id) {
+      core_ids.push_back(core_id);
+    }
+  }
+  return core_ids;
+}
+
+void BindCurrentThread(const std::vector<int> &core_ids, size_t offset) {
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+#ifdef PADDLE_WITH_MKLML
+  // One core per worker, so the threads of an instance stop migrating and
+  // keep their caches warm.
+  CPU_SET(core_ids[offset % core_ids.size()], &mask);
+#else
+  // Without a worker pool to spread out, allow the whole core set.
+  for (int core_id : core_ids) {
+    CPU_SET(core_id, &mask);
+  }
+#endif
+  if (-1 == sched_setaffinity(0, sizeof(mask), &mask)) {
+    VLOG(1) << "WARNING: Failed to set thread affinity to core "
+            << core_ids[offset % core_ids.size()];
+  }
+}
+
+}  // namespace
+#endif
+
+void SetThreadAffinity(const std::vector<int> &core_ids) {
+#if defined(_WIN32) || defined(__APPLE__)
+  // Thread affinity is only supported on Linux.
+  return;
+#else
+  if (core_ids.empty()) return;
+#ifdef PADDLE_WITH_MKLML
+  // The parallel region forces the worker pool of the calling thread into
+  // existence with the currently configured size, and pins every worker
+  // (including the calling thread, which is the master) to its core.
+#pragma omp parallel
+  { BindCurrentThread(core_ids, static_cast<size_t>(omp_get_thread_num())); }
+#else
+  BindCurrentThread(core_ids, 0);
+#endif
+#endif
+}
+
+std::vector<int> GetNumaNodeCores(int numa_node) {
+#if !defined(_WIN32) && !defined(__APPLE__)
+  std::ostringstream path;
+  path << "/sys/devices/system/node/node" << numa_node << "/cpulist";
+  return ReadCpuListFile(path.str());
+#else
+  return {};
+#endif
+}
+
+std::vector<int> GetSMTSiblings(int core_id) {
+#if !defined(_WIN32) && !defined(__APPLE__)
+  std::ostringstream path;
+  path << "/sys/devices/system/cpu/cpu" << core_id
+       << "/topology/thread_siblings_list";
+  return ReadCpuListFile(path.str());
+#else
+  return {};
+#endif
+}
+
 }  // namespace platform
 }  // namespace paddle
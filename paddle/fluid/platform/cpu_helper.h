@@ -16,11 +16,27 @@ limitations under the License. */
 
 #include <stddef.h>
 
+#include <vector>
+
 namespace paddle {
 namespace platform {
 
 //! Set the number of threads in use.
 void SetNumThreads(int num_threads);
 
+//! Bind the calling thread and the math library worker threads to the given
+//! cores. Workers are pinned one per core, round-robin when there are more
+//! threads than cores. Only supported on Linux, a no-op elsewhere.
+void SetThreadAffinity(const std::vector<int>& core_ids);
+
+//! Get the core ids of one NUMA node. Returns an empty vector when the node
+//! does not exist or the platform exposes no NUMA topology.
+std::vector<int> GetNumaNodeCores(int numa_node);
+
+//! Get the SMT (hyper-thread) sibling core ids of one core, including the
+//! core itself. Returns an empty vector when the core does not exist or the
+//! platform exposes no topology.
+std::vector<int> GetSMTSiblings(int core_id);
+
 }  // namespace platform
 }  // namespace paddle
@@ -30,7 +30,16 @@ limitations under the License. */
 #include <unistd.h>
 #endif  // _WIN32
 
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
 #include <algorithm>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include "glog/logging.h"
 #include "paddle/fluid/platform/flags.h"
 
 DECLARE_double(fraction_of_cpu_memory_to_use);
@@ -71,6 +80,64 @@ size_t CpuTotalPhysicalMemory() {
 #endif
 }
 
+#if defined(__linux__)
+// Returns the whole CPUs allowed by the cgroup CPU bandwidth quota of this
+// process, rounded up, or -1 when no quota is set.
+static int CgroupCpuQuota() {
+  // cgroup v2: "cpu.max" holds "<quota> <period>" or "max <period>"
+  {
+    std::ifstream fin("/sys/fs/cgroup/cpu.max");
+    std::string quota_str;
+    int64_t period = 0;
+    if (fin.is_open() && (fin >> quota_str >> period) && quota_str != "max" &&
+        period > 0) {
+      int64_t quota = std::stoll(quota_str);
+      if (quota > 0) {
+        return static_cast<int>((quota + period - 1) / period);
+      }
+    }
+  }
+  // cgroup v1: quota and period live in separate files, quota -1 = no limit
+  {
+    std::ifstream quota_fin("/sys/fs/cgroup/cpu/cpu.cfs_quota_us");
+    std::ifstream period_fin("/sys/fs/cgroup/cpu/cpu.cfs_period_us");
+    int64_t quota = -1;
+    int64_t period = 0;
+    if (quota_fin.is_open() && period_fin.is_open() && (quota_fin >> quota) &&
+        (period_fin >> period) && quota > 0 && period > 0) {
+      return static_cast<int>((quota + period - 1) / period);
+    }
+  }
+  return -1;
+}
+#endif
+
+size_t CpuAvailableCoreCount() {
+  static size_t available_cores = []() -> size_t {
+    size_t num_cores = std::thread::hardware_concurrency();
+    if (num_cores == 0) {
+      num_cores = 1;
+    }
+#if defined(__linux__)
+    // cpuset cgroups and taskset both narrow the affinity mask
+    cpu_set_t mask;
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+      size_t allowed = static_cast<size_t>(CPU_COUNT(&mask));
+      if (allowed > 0 && allowed < num_cores) {
+        num_cores = allowed;
+      }
+    }
+    int quota_cores = CgroupCpuQuota();
+    if (quota_cores > 0 && static_cast<size_t>(quota_cores) < num_cores) {
+      num_cores = static_cast<size_t>(quota_cores);
+    }
+#endif
+    VLOG(3) << "Available CPU cores for this process: " << num_cores;
+    return num_cores;
+  }();
+  return available_cores;
+}
+
 size_t CpuMaxAllocSize() {
   // For distributed systems, it requires configuring and limiting
   // the fraction of memory to use.
@@ -55,6 +55,13 @@ namespace platform {
 
 size_t CpuTotalPhysicalMemory();
 
+//! Get the number of logical CPUs this process may actually use: the
+//! hardware count clamped by the process affinity mask and by the cgroup
+//! (v1 cpu.cfs_quota_us / v2 cpu.max) CPU quota, so containers with a CPU
+//! limit are not oversubscribed. Thread pools should size themselves from
+//! this instead of std::thread::hardware_concurrency().
+size_t CpuAvailableCoreCount();
+
 //! Get the maximum allocation size for a machine.
 size_t CpuMaxAllocSize();
 
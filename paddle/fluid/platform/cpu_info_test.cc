@@ -14,6 +14,7 @@
 #include "paddle/fluid/platform/cpu_info.h"
 
 #include <sstream>
+#include <thread>
 
 #include "gflags/gflags.h"
 #include "gtest/gtest.h"
@@ -30,3 +31,12 @@ TEST(CpuMemoryUsage, Print) {
                                        use_percent, memory_size)
             << std::endl;
 }
+
+TEST(CpuAvailableCoreCount, InRange) {
+  size_t available = paddle::platform::CpuAvailableCoreCount();
+  size_t hardware = std::thread::hardware_concurrency();
+  EXPECT_GE(available, 1UL);
+  if (hardware > 0) {
+    EXPECT_LE(available, hardware);
+  }
+}
@@ -21,32 +21,49 @@ namespace platform {
 
 CudaStreamResourcePool::CudaStreamResourcePool() {
   int dev_cnt = platform::GetCUDADeviceCount();
-  pool_.reserve(dev_cnt);
-  for (int dev_idx = 0; dev_idx < dev_cnt; ++dev_idx) {
-    auto creator = [dev_idx] {
-      platform::SetDeviceId(dev_idx);
-      gpuStream_t stream;
+  pool_.resize(kNumTiers);
+  for (size_t tier = 0; tier < kNumTiers; ++tier) {
+    // Only the communication tier raises the stream priority; the compute
+    // and copy tiers keep the default priority but stay in separate free
+    // lists so copies never get recycled onto a compute user.
+    bool high_priority = tier == static_cast<size_t>(StreamTier::kComm);
+    pool_[tier].reserve(dev_cnt);
+    for (int dev_idx = 0; dev_idx < dev_cnt; ++dev_idx) {
+      auto creator = [dev_idx, high_priority] {
+        platform::SetDeviceId(dev_idx);
+        gpuStream_t stream;
 #ifdef PADDLE_WITH_HIP
-      PADDLE_ENFORCE_CUDA_SUCCESS(
-          hipStreamCreateWithFlags(&stream, hipStreamNonBlocking));
+        if (high_priority) {
+          PADDLE_ENFORCE_CUDA_SUCCESS(hipStreamCreateWithPriority(
+              &stream, hipStreamNonBlocking, -1));
+        } else {
+          PADDLE_ENFORCE_CUDA_SUCCESS(
+              hipStreamCreateWithFlags(&stream, hipStreamNonBlocking));
+        }
 #else
-      PADDLE_ENFORCE_CUDA_SUCCESS(
-          cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
+        if (high_priority) {
+          PADDLE_ENFORCE_CUDA_SUCCESS(cudaStreamCreateWithPriority(
+              &stream, cudaStreamNonBlocking, -1));
+        } else {
+          PADDLE_ENFORCE_CUDA_SUCCESS(
+              cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
+        }
 #endif
-      return stream;
-    };
+        return stream;
+      };
 
-    auto deleter = [dev_idx](gpuStream_t stream) {
-      platform::SetDeviceId(dev_idx);
+      auto deleter = [dev_idx](gpuStream_t stream) {
+        platform::SetDeviceId(dev_idx);
 #ifdef PADDLE_WITH_HIP
-      PADDLE_ENFORCE_CUDA_SUCCESS(hipStreamDestroy(stream));
+        PADDLE_ENFORCE_CUDA_SUCCESS(hipStreamDestroy(stream));
 #else
-      PADDLE_ENFORCE_CUDA_SUCCESS(cudaStreamDestroy(stream));
+        PADDLE_ENFORCE_CUDA_SUCCESS(cudaStreamDestroy(stream));
 #endif
-    };
+      };
 
-    pool_.emplace_back(
-        ResourcePool<CudaStreamObject>::Create(creator, deleter));
+      pool_[tier].emplace_back(
+          ResourcePool<CudaStreamObject>::Create(creator, deleter));
+    }
   }
 }
 
@@ -55,17 +72,23 @@ CudaStreamResourcePool& CudaStreamResourcePool::Instance() {
   return pool;
 }
 
-std::shared_ptr<CudaStreamObject> CudaStreamResourcePool::New(int dev_idx) {
+std::shared_ptr<CudaStreamObject> CudaStreamResourcePool::New(int dev_idx,
+                                                              StreamTier tier) {
   PADDLE_ENFORCE_GE(
       dev_idx, 0,
       platform::errors::InvalidArgument(
           "The dev_idx should be not less than 0, but got %d.", dev_idx));
+  size_t tier_idx = static_cast<size_t>(tier);
+  PADDLE_ENFORCE_LT(tier_idx, kNumTiers,
+                    platform::errors::OutOfRange(
+                        "The stream tier should be less than %d, but got %d.",
+                        kNumTiers, tier_idx));
   PADDLE_ENFORCE_LT(
-      dev_idx, pool_.size(),
+      dev_idx, pool_[tier_idx].size(),
       platform::errors::OutOfRange(
           "The dev_idx should be less than device count %d, but got %d.",
-          pool_.size(), dev_idx));
-  return pool_[dev_idx]->New();
+          pool_[tier_idx].size(), dev_idx));
+  return pool_[tier_idx][dev_idx]->New();
 }
 
 CudaEventResourcePool::CudaEventResourcePool() {
@@ -37,9 +37,21 @@ namespace platform {
 using CudaStreamObject = std::remove_pointer<gpuStream_t>::type;
 using CudaEventObject = std::remove_pointer<gpuEvent_t>::type;
 
+// Pooled streams are kept in named tiers so a recycled handle keeps its
+// role: compute kernels, communication collectives and memory copies
+// never end up sharing a stream. The communication tier is created with
+// the highest priority the device supports, so collectives launched on
+// it preempt concurrently running compute kernels.
+enum class StreamTier : size_t {
+  kCompute = 0,
+  kComm = 1,
+  kCopy = 2,
+};
+
 class CudaStreamResourcePool {
  public:
-  std::shared_ptr<CudaStreamObject> New(int dev_idx);
+  std::shared_ptr<CudaStreamObject> New(
+      int dev_idx, StreamTier tier = StreamTier::kCompute);
 
   static CudaStreamResourcePool &Instance();
 
@@ -49,7 +61,10 @@ class CudaStreamResourcePool {
   DISABLE_COPY_AND_ASSIGN(CudaStreamResourcePool);
 
  private:
-  std::vector<std::shared_ptr<ResourcePool<CudaStreamObject>>> pool_;
+  static constexpr size_t kNumTiers = 3;
+  // pool_[tier][dev_idx]
+  std::vector<std::vector<std::shared_ptr<ResourcePool<CudaStreamObject>>>>
+      pool_;
 };
 
 class CudaEventResourcePool {
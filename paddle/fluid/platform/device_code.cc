@@ -14,13 +14,20 @@ limitations under the License. */
 
 #include <sys/stat.h>
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <set>
+#include <sstream>
 #include <utility>
 
 #include "paddle/fluid/platform/device_code.h"
 #include "paddle/fluid/platform/enforce.h"
+#include "paddle/fluid/platform/port.h"
 
 DECLARE_string(cuda_dir);
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+DECLARE_string(device_code_cache_dir);
+#endif
 
 namespace paddle {
 namespace platform {
@@ -209,6 +216,99 @@ static std::string FindCUDAIncludePath() {
   return "";
 }
 
+// Returns the cache file path for a compiled kernel, keyed by the kernel
+// source hash, the device architecture and the NVRTC/HIPRTC version so a
+// stale binary is never reused. Empty string when caching is disabled.
+static std::string DeviceCodeCachePath(const std::string& name,
+                                       const std::string& kernel,
+                                       int compute_capability) {
+  if (FLAGS_device_code_cache_dir.empty()) {
+    return "";
+  }
+  int rtc_major = 0;
+  int rtc_minor = 0;
+#ifdef PADDLE_WITH_HIP
+  if (dynload::hiprtcVersion(&rtc_major, &rtc_minor) != HIPRTC_SUCCESS) {
+    return "";
+  }
+#else
+  if (dynload::nvrtcVersion(&rtc_major, &rtc_minor) != NVRTC_SUCCESS) {
+    return "";
+  }
+#endif
+  std::ostringstream ss;
+  ss << FLAGS_device_code_cache_dir << "/" << name << "_" << std::hex
+     << std::hash<std::string>()(kernel) << std::dec << "_cc"
+     << compute_capability << "_rtc" << rtc_major << "." << rtc_minor
+     << ".bin";
+  return ss.str();
+}
+
+bool CUDADeviceCode::TryLoadCachedBinary(const std::string& path) {
+  if (path.empty()) {
+    return false;
+  }
+  std::ifstream fin(path, std::ios::binary);
+  if (!fin) {
+    return false;
+  }
+  std::ostringstream ss;
+  ss << fin.rdbuf();
+  const std::string& binary = ss.str();
+  if (binary.empty()) {
+    return false;
+  }
+  ptx_.assign(binary.begin(), binary.end());
+
+#ifdef PADDLE_WITH_HIP
+  if (!CheckCUDADriverResult(dynload::hipModuleLoadData(&module_, ptx_.data()),
+                             "hipModuleLoadData")) {
+    return false;
+  }
+  if (!CheckCUDADriverResult(
+          dynload::hipModuleGetFunction(&function_, module_, name_.c_str()),
+          "hipModuleGetFunction")) {
+    return false;
+  }
+#else
+  if (!CheckCUDADriverResult(dynload::cuModuleLoadData(&module_, ptx_.data()),
+                             "cuModuleLoadData", name_)) {
+    return false;
+  }
+  if (!CheckCUDADriverResult(
+          dynload::cuModuleGetFunction(&function_, module_, name_.c_str()),
+          "cuModuleGetFunction", name_)) {
+    return false;
+  }
+#endif
+  VLOG(3) << "Loaded cached device code for " << name_ << " from " << path;
+  return true;
+}
+
+void CUDADeviceCode::SaveCachedBinary(const std::string& path) const {
+  if (path.empty()) {
+    return;
+  }
+  MkDirRecursively(DirName(path).c_str());
+  // Stage and rename so concurrent writers never expose a partial file;
+  // racing writers produce identical content, so the last rename wins
+  // harmlessly.
+  std::string tmp_path =
+      path + ".tmp." + std::to_string(reinterpret_cast<uintptr_t>(this));
+  {
+    std::ofstream fout(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!fout) {
+      return;
+    }
+    fout.write(ptx_.data(), ptx_.size());
+  }
+  if (rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+  } else {
+    VLOG(3) << "Saved compiled device code for " << name_ << " to " << path;
+  }
+}
+
 CUDADeviceCode::CUDADeviceCode(const Place& place, const std::string& name,
                                const std::string& kernel) {
   if (!is_gpu_place(place)) {
@@ -232,6 +332,18 @@ bool CUDADeviceCode::Compile(bool include_path) {
         << "NVRTC and CUDA driver are need for JIT compiling of CUDA code.";
     return false;
   }
+
+  auto* dev_ctx = reinterpret_cast<CUDADeviceContext*>(
+      DeviceContextPool::Instance().Get(place_));
+  int compute_capability = dev_ctx->GetComputeCapability();
+  std::string cache_path =
+      DeviceCodeCachePath(name_, kernel_, compute_capability);
+  if (TryLoadCachedBinary(cache_path)) {
+    max_threads_ = dev_ctx->GetMaxPhysicalThreadCount();
+    is_compiled_ = true;
+    return true;
+  }
+
 #ifdef PADDLE_WITH_HIP
   hiprtcProgram program;
   if (!CheckNVRTCResult(dynload::hiprtcCreateProgram(&program,
@@ -245,9 +357,6 @@ bool CUDADeviceCode::Compile(bool include_path) {
   }
 
   // Compile the program for specified compute_capability
-  auto* dev_ctx = reinterpret_cast<CUDADeviceContext*>(
-      DeviceContextPool::Instance().Get(place_));
-  int compute_capability = dev_ctx->GetComputeCapability();
   std::vector<const char*> options = {"-std=c++11", "--amdgpu-target=gfx906"};
   std::string include_option;
   if (include_path) {
@@ -322,9 +431,6 @@ bool CUDADeviceCode::Compile(bool include_path) {
   }
 
   // Compile the program for specified compute_capability
-  auto* dev_ctx = reinterpret_cast<CUDADeviceContext*>(
-      DeviceContextPool::Instance().Get(place_));
-  int compute_capability = dev_ctx->GetComputeCapability();
   std::string compute_flag =
       "--gpu-architecture=compute_" + std::to_string(compute_capability);
   std::vector<const char*> options = {"--std=c++11", compute_flag.c_str()};
@@ -389,6 +495,8 @@ bool CUDADeviceCode::Compile(bool include_path) {
   }
 #endif
 
+  SaveCachedBinary(cache_path);
+
   max_threads_ = dev_ctx->GetMaxPhysicalThreadCount();
   is_compiled_ = true;
   return true;
@@ -71,6 +71,14 @@ class CUDADeviceCode : public DeviceCode {
   bool CheckNVRTCResult(nvrtcResult result, std::string function);
 #endif
 
+  // Loads a previously compiled binary from the on-disk cache and builds
+  // the module from it, skipping NVRTC entirely. Returns false on any
+  // miss or failure, in which case the caller compiles from source.
+  bool TryLoadCachedBinary(const std::string& path);
+
+  // Persists the compiled binary for other processes and later restarts.
+  void SaveCachedBinary(const std::string& path) const;
+
   static bool available_;
 
   bool is_compiled_{false};
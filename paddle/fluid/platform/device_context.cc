@@ -9,16 +9,48 @@ distributed under the License is distributed on an "AS IS" BASIS,
 WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License. */
+
+// Must come before any (transitive) Eigen Tensor include so that the
+// ThreadPoolDevice definitions are compiled in for this translation unit.
+#define EIGEN_USE_THREADS
+
 #include "paddle/fluid/platform/device_context.h"
+#include <algorithm>
+#include <functional>
 #include <set>
 
+#include "paddle/fluid/platform/cpu_info.h"
+
+#ifdef PADDLE_WITH_MKLML
+#include <omp.h>
+#endif
+
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
 #include "paddle/fluid/memory/allocation/cuda_device_context_allocator.h"
 #include "paddle/fluid/platform/cuda_device_guard.h"
 #endif
 #include "glog/logging.h"
+#include "paddle/fluid/platform/flags.h"
 #include "paddle/fluid/platform/profiler.h"
 
+#ifdef PADDLE_WITH_MKLDNN
+PADDLE_DEFINE_EXPORTED_int64(
+    mkldnn_blob_cache_capacity, 0,
+    "Max total number of cached oneDNN objects. When the budget is "
+    "exceeded, whole least-recently-used shape groups are evicted, so "
+    "variable-shape serving keeps a stable cache working set. Not "
+    "positive means the cache is unbounded.");
+
+PADDLE_DEFINE_EXPORTED_int64(
+    mkldnn_shape_bucket_size, 0,
+    "Round the flattened row count of innermost-axis oneDNN normalization "
+    "primitives (softmax, layer_norm) up to a multiple of this value, so "
+    "variable-sequence-length traffic reuses a small set of primitives "
+    "instead of creating one per distinct shape. The padded rows are "
+    "computed in scratch memory and discarded. Not positive disables "
+    "bucketing.");
+#endif
+
 namespace paddle {
 namespace memory {
 
@@ -193,6 +225,90 @@ Eigen::DefaultDevice* CPUDeviceContext::eigen_device() const {
   return eigen_device_.get();
 }
 
+namespace {
+
+Eigen::ThreadPoolDevice* GetCPUEigenThreadPoolDevice() {
+  // One pool for the whole process, sized to the same team the
+  // oneDNN/OpenMP kernels use. The two runtimes never run concurrently
+  // inside one op, so matching the sizes keeps the combined demand at one
+  // team and stops them from thrashing each other's workers.
+#ifdef PADDLE_WITH_MKLML
+  static const int num_threads = std::max(omp_get_max_threads(), 1);
+#else
+  static const int num_threads =
+      static_cast<int>(CpuAvailableCoreCount());
+#endif
+  static Eigen::ThreadPool pool(num_threads);
+  static Eigen::ThreadPoolDevice device(&pool, num_threads);
+  return &device;
+}
+
+}  // namespace
+
+Eigen::ThreadPoolDevice* CPUDeviceContext::eigen_pool_device() const {
+  return GetCPUEigenThreadPoolDevice();
+}
+
+namespace {
+
+struct CPUScratchWorkspace {
+  static constexpr size_t kAlignment = 64;
+
+  std::unique_ptr<uint8_t[]> buffer_;
+  uint8_t* aligned_base_{nullptr};
+  size_t capacity_{0};
+  size_t used_{0};
+  // Chunks handed out after buffer_ filled up; their total size grows the
+  // arena at the next reset, so each size is overflowed at most once.
+  std::vector<std::unique_ptr<uint8_t[]>> overflow_;
+  size_t overflow_bytes_{0};
+
+  void Grow(size_t capacity) {
+    buffer_.reset(new uint8_t[capacity + kAlignment]);
+    aligned_base_ = reinterpret_cast<uint8_t*>(
+        (reinterpret_cast<uintptr_t>(buffer_.get()) + kAlignment - 1) &
+        ~(kAlignment - 1));
+    capacity_ = capacity;
+  }
+};
+
+CPUScratchWorkspace& GetCPUScratchWorkspace() {
+  static thread_local CPUScratchWorkspace workspace;
+  return workspace;
+}
+
+}  // namespace
+
+void* CPUDeviceContext::AllocateWorkspace(size_t size) const {
+  auto& workspace = GetCPUScratchWorkspace();
+  size_t aligned_size =
+      (size + CPUScratchWorkspace::kAlignment - 1) /
+      CPUScratchWorkspace::kAlignment * CPUScratchWorkspace::kAlignment;
+  if (workspace.used_ + aligned_size <= workspace.capacity_) {
+    void* ptr = workspace.aligned_base_ + workspace.used_;
+    workspace.used_ += aligned_size;
+    return ptr;
+  }
+  workspace.overflow_.emplace_back(
+      new uint8_t[aligned_size + CPUScratchWorkspace::kAlignment]);
+  workspace.overflow_bytes_ += aligned_size;
+  return reinterpret_cast<void*>(
+      (reinterpret_cast<uintptr_t>(workspace.overflow_.back().get()) +
+       CPUScratchWorkspace::kAlignment - 1) &
+      ~(CPUScratchWorkspace::kAlignment - 1));
+}
+
+void CPUDeviceContext::ResetWorkspace() const {
+  auto& workspace = GetCPUScratchWorkspace();
+  size_t high_water = workspace.used_ + workspace.overflow_bytes_;
+  if (high_water > workspace.capacity_) {
+    workspace.Grow(high_water);
+  }
+  workspace.overflow_.clear();
+  workspace.overflow_bytes_ = 0;
+  workspace.used_ = 0;
+}
+
 Place CPUDeviceContext::GetPlace() const { return place_; }
 
 #ifdef PADDLE_WITH_XPU
@@ -424,6 +540,25 @@ CUDAContext::CUDAContext(const CUDAPlace& place,
 #endif
 }
 
+void CUDAContext::SetStream(gpuStream_t stream) {
+  if (stream_->raw_stream() == stream) {
+    return;
+  }
+  CUDADeviceGuard guard(place_.device);
+  DestoryCuDNNContext();
+  DestoryCuBlasContext();
+#ifndef PADDLE_WITH_HIP
+  DestoryCuSolverContext();
+#endif
+  stream_->SetStream(stream);
+  InitEigenContext();
+  InitCuBlasContext();
+  InitCuDNNContext();
+#ifndef PADDLE_WITH_HIP
+  InitCuSolverContext();
+#endif
+}
+
 CUDAContext::~CUDAContext() {
   CUDADeviceGuard guard(place_.device);
   DestoryCuDNNContext();
@@ -578,11 +713,7 @@ Place CUDAPinnedDeviceContext::GetPlace() const { return place_; }
 
 #ifdef PADDLE_WITH_MKLDNN
 MKLDNNDeviceContext::MKLDNNDeviceContext(CPUPlace place)
-    : CPUDeviceContext(place), p_blobmap_() {
-  p_blobmap_.reset(new BlobMap());
-  p_exec_items_.reset(new ExecShape());
-  p_mutex_.reset(new std::mutex());
-}
+    : CPUDeviceContext(place) {}
 
 MKLDNNDeviceContextThreadLocals::Body::Body()
     : cur_engine(mkldnn::engine::kind::cpu, 0), cur_stream(cur_engine) {
@@ -651,94 +782,144 @@ mkldnn::stream& MKLDNNDeviceContextThreadLocals::Body::get_stream(void) {
   return cur_stream;
 }
 
+MKLDNNDeviceContext::CacheShard& MKLDNNDeviceContext::GetShard(
+    const std::string& input_shape_str) const {
+  return shards_[std::hash<std::string>{}(input_shape_str) % kCacheShards];
+}
+
 void MKLDNNDeviceContext::ResetBlobMap(void* ptr) {
-  std::lock_guard<decltype(*p_mutex_)> lock(*p_mutex_);
-  if (!block_next_cache_clearing_) {
-    VLOG(3) << "Clearing DNNL cache.";
-    // If no specific executor pointer then clear
-    // everything. For executor pointer then clear only
-    // objects allocated when using given executor
+  {
+    std::lock_guard<std::mutex> lock(clearing_mutex_);
+    if (block_next_cache_clearing_) {
+      VLOG(3) << "Prevented Clearing DNNL cache.";
+      block_next_cache_clearing_ = false;
+      return;
+    }
+  }
+  VLOG(3) << "Clearing DNNL cache.";
+  // If no specific executor pointer then clear
+  // everything. For executor pointer then clear only
+  // objects allocated when using given executor
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex_);
     if (ptr == nullptr) {
-      p_blobmap_->clear();
+      shard.blob_map_.clear();
+      shard.exec_items_.clear();
+      shard.lru_shapes_.clear();
+      shard.num_entries_ = 0;
     } else {
       // Iterate through all shapes and release
       // for each shape and active executor all entries
       // of this executor
-      for (auto& s : *p_exec_items_) {
+      for (auto& s : shard.exec_items_) {
         for (auto& v : (*s.second)[ptr]) {
           (v.first)->erase(v.second);
+          if (shard.num_entries_ > 0) {
+            --shard.num_entries_;
+          }
         }
         s.second->erase(ptr);
       }
     }
-  } else {
-    VLOG(3) << "Prevented Clearing DNNL cache.";
-    block_next_cache_clearing_ = false;
   }
 }
 
-void MKLDNNDeviceContext::RemoveShapeEntriesWithExecutor(void) const {
-  p_exec_items_->erase(p_exec_items_->begin());
-}
-
-void MKLDNNDeviceContext::LinkEntryWithExecutor(BlobPtr_t<KeyBlob> pblob,
+void MKLDNNDeviceContext::LinkEntryWithExecutor(CacheShard* shard,
+                                                BlobPtr_t<KeyBlob> pblob,
                                                 KeyBlob::iterator it) const {
   // Take current input shape from TLS
   // Take current executor addess from TLS
   // and for this executor's items add the one defined with arguments
-  auto key_it = p_exec_items_
-                    ->insert(std::make_pair(tls().cur_input_shape_str,
-                                            std::make_shared<ExecMap>()))
+  auto key_it = shard->exec_items_
+                    .insert(std::make_pair(tls().cur_input_shape_str,
+                                           std::make_shared<ExecMap>()))
                     .first;
   (*key_it->second)[tls().get_curr_exec()].push_back(std::make_pair(pblob, it));
 
-  VLOG(3) << "LinkEntryWithExecutor, shapes: " << p_exec_items_->size()
+  VLOG(3) << "LinkEntryWithExecutor, shapes: " << shard->exec_items_.size()
           << " curr exec size: "
           << (*key_it->second)[tls().get_curr_exec()].size() << "\n";
 }
 
+void MKLDNNDeviceContext::TouchShape(CacheShard* shard, int sid,
+                                     const std::string& shape) const {
+  auto key = std::make_pair(sid, shape);
+  auto it =
+      std::find(shard->lru_shapes_.begin(), shard->lru_shapes_.end(), key);
+  if (it != shard->lru_shapes_.end()) {
+    shard->lru_shapes_.splice(shard->lru_shapes_.begin(), shard->lru_shapes_,
+                              it);
+  } else {
+    shard->lru_shapes_.push_front(std::move(key));
+  }
+}
+
+void MKLDNNDeviceContext::EvictShape(CacheShard* shard, int sid,
+                                     const std::string& shape) const {
+  auto map_it = shard->blob_map_.find(sid);
+  if (map_it != shard->blob_map_.end()) {
+    auto key_it = map_it->second->find(shape);
+    if (key_it != map_it->second->end()) {
+      shard->num_entries_ -=
+          std::min(shard->num_entries_, key_it->second->size());
+      map_it->second->erase(key_it);
+    }
+  }
+  shard->exec_items_.erase(shape);
+  shard->lru_shapes_.remove(std::make_pair(sid, shape));
+  VLOG(2) << "sid=" << sid << ", remove all blobs of shape: " << shape;
+}
+
 void MKLDNNDeviceContext::BlockNextCacheClearing() {
-  std::lock_guard<decltype(*p_mutex_)> lock(*p_mutex_);
+  std::lock_guard<std::mutex> lock(clearing_mutex_);
   VLOG(3) << "Next DNNL cache clearing has been blocked.";
   block_next_cache_clearing_ = true;
 }
 
 size_t MKLDNNDeviceContext::GetShapeBlobSize() const {
-  std::lock_guard<decltype(*p_mutex_)> lock(*p_mutex_);
-  BlobMap* pMap = p_blobmap_.get();
-  auto map_it = pMap->find(tls().cur_mkldnn_session_id);
-  if (map_it == pMap->end()) {
+  size_t size = 0;
+  bool found = false;
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    auto map_it = shard.blob_map_.find(tls().cur_mkldnn_session_id);
+    if (map_it != shard.blob_map_.end()) {
+      found = true;
+      size += map_it->second->size();
+    }
+  }
+  if (!found) {
     PADDLE_THROW(platform::errors::NotFound(
         "MKLDNNDeviceContext don't find cur_mkldnn_session_id: %d.",
         tls().cur_mkldnn_session_id));
   }
-  return map_it->second->size();
+  return size;
 }
 
 void MKLDNNDeviceContext::SetBlob(const std::string& name,
                                   BlobPtr_t<void> data) const {
-  BlobMap* pMap = p_blobmap_.get();
   BlobPtr_t<ShapeBlob> sBlob = nullptr;
   BlobPtr_t<KeyBlob> pBlob = nullptr;
 
   int sid = tls().get_cur_mkldnn_session_id();
+  const std::string& shape_str = tls().cur_input_shape_str;
+  auto& shard = GetShard(shape_str);
 
-  std::lock_guard<decltype(*p_mutex_)> lock(*p_mutex_);
+  std::lock_guard<std::mutex> lock(shard.mutex_);
 
   // Find ShapeBlob for current mkldnn session id.
-  auto map_it = pMap->find(sid);
+  auto map_it = shard.blob_map_.find(sid);
 
-  if (map_it == pMap->end()) {
+  if (map_it == shard.blob_map_.end()) {
     // 1st time to set blob in current thread
     sBlob = std::make_shared<ShapeBlob>();
-    (*pMap)[sid] = sBlob;
+    shard.blob_map_[sid] = sBlob;
     VLOG(2) << "SetBlob: sid=" << sid << ", add new sid\n";
   } else {
     sBlob = map_it->second;
   }
 
   // Find KeyBlob for current input shape
-  auto key_it = sBlob->find(tls().cur_input_shape_str);
+  auto key_it = sBlob->find(shape_str);
 
   if (key_it == sBlob->end()) {
     // In cache clearing mode, cur_input_shape_cache_capacity defines
@@ -748,13 +929,17 @@ void MKLDNNDeviceContext::SetBlob(const std::string& name,
         sBlob->size() &&
         (sBlob->size() >=
          static_cast<size_t>(tls().cur_input_shape_cache_capacity))) {
-      VLOG(2) << "sid=" << sid
-              << ", remove all blobs of shape: " << sBlob->begin()->first;
-      sBlob->erase(sBlob->begin()->first);
-      RemoveShapeEntriesWithExecutor();
+      // Evict the least recently used shape of this session.
+      for (auto it = shard.lru_shapes_.rbegin();
+           it != shard.lru_shapes_.rend(); ++it) {
+        if (it->first == sid) {
+          EvictShape(&shard, sid, it->second);
+          break;
+        }
+      }
     }
     pBlob = std::make_shared<KeyBlob>();
-    (*sBlob)[tls().cur_input_shape_str] = pBlob;
+    (*sBlob)[shape_str] = pBlob;
   } else {
     pBlob = key_it->second;
   }
@@ -764,12 +949,30 @@ void MKLDNNDeviceContext::SetBlob(const std::string& name,
   if (blob_it == pBlob->end()) {
     auto el =
         pBlob->insert(std::make_pair(name, data));  //  (*pBlob)[name] = data;
+    ++shard.num_entries_;
+    ++cache_inserts_;
     // Register new element in per executor map
     // to have easily erased when executor terminated
-    LinkEntryWithExecutor(pBlob, el.first);
+    LinkEntryWithExecutor(&shard, pBlob, el.first);
   } else {
     blob_it->second = data;  // set data to existing blob
   }
+  TouchShape(&shard, sid, shape_str);
+
+  // Enforce the configured entry budget, never evicting the active shape.
+  if (FLAGS_mkldnn_blob_cache_capacity > 0) {
+    size_t shard_capacity = std::max<size_t>(
+        1,
+        static_cast<size_t>(FLAGS_mkldnn_blob_cache_capacity) / kCacheShards);
+    while (shard.num_entries_ > shard_capacity &&
+           shard.lru_shapes_.size() > 1) {
+      auto victim = shard.lru_shapes_.back();
+      if (victim.first == sid && victim.second == shape_str) {
+        break;
+      }
+      EvictShape(&shard, victim.first, victim.second);
+    }
+  }
   VLOG(2) << "SetBlob: sid=" << sid << ", add blob=" << name << "\n";
   // lock will be automatically released when out of scope
   return;
@@ -777,9 +980,12 @@ void MKLDNNDeviceContext::SetBlob(const std::string& name,
 
 unsigned int MKLDNNDeviceContext::GetCachedObjectsNumber(void) const {
   unsigned int num_entries = 0;
-  for (auto const& l3 : *p_blobmap_) {
-    for (auto const& l2 : *(l3.second)) {
-      num_entries += (l2.second)->size();
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    for (auto const& l3 : shard.blob_map_) {
+      for (auto const& l2 : *(l3.second)) {
+        num_entries += (l2.second)->size();
+      }
     }
   }
   return num_entries;
@@ -787,27 +993,29 @@ unsigned int MKLDNNDeviceContext::GetCachedObjectsNumber(void) const {
 
 MKLDNNDeviceContext::BlobPtr_t<void> MKLDNNDeviceContext::GetBlob(
     const std::string& name) const {
-  BlobMap* pMap = p_blobmap_.get();
   BlobPtr_t<ShapeBlob> sBlob = nullptr;
   BlobPtr_t<KeyBlob> pBlob = nullptr;
 
   int sid = tls().get_cur_mkldnn_session_id();
+  const std::string& shape_str = tls().cur_input_shape_str;
+  auto& shard = GetShard(shape_str);
 
-  std::lock_guard<decltype(*p_mutex_)> lock(*p_mutex_);
+  std::lock_guard<std::mutex> lock(shard.mutex_);
 
   // Find ShapeBlob for current mkldnn session id firstly
-  auto map_it = pMap->find(sid);
-  if (map_it == pMap->end()) {
+  auto map_it = shard.blob_map_.find(sid);
+  if (map_it == shard.blob_map_.end()) {
     VLOG(2) << "GetBlob: sid=" << sid << ", miss sid\n";
+    ++cache_misses_;
     return nullptr;
   }
   sBlob = map_it->second;
 
   // Find KeyBlob for current input shape secondly
-  auto sBlob_it = sBlob->find(tls().cur_input_shape_str);
+  auto sBlob_it = sBlob->find(shape_str);
   if (sBlob_it == sBlob->end()) {
-    VLOG(2) << "GetBlob: sid=" << tls().cur_input_shape_str
-            << ", miss input_shape_str\n";
+    VLOG(2) << "GetBlob: sid=" << shape_str << ", miss input_shape_str\n";
+    ++cache_misses_;
     return nullptr;
   }
   pBlob = sBlob_it->second;
@@ -817,9 +1025,13 @@ MKLDNNDeviceContext::BlobPtr_t<void> MKLDNNDeviceContext::GetBlob(
 
   if (key_it == pBlob->end()) {
     VLOG(2) << "GetBlob sid=" << sid << ", miss blob=" << name << "\n";
+    ++cache_misses_;
     return nullptr;
   }
 
+  ++cache_hits_;
+  TouchShape(&shard, sid, shape_str);
+
   VLOG(2) << "GetBlob sid=" << sid << ", get blob=" << name << "\n";
   // lock will be automatically released when out of scope
   return key_it->second;
@@ -10,8 +10,11 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 #pragma once
 
+#include <atomic>
 #include <future>  // NOLINT
 #include <memory>
+#include <array>
+#include <list>
 #include <mutex>  // NOLINT
 #include <string>
 #include <unordered_map>
@@ -66,6 +69,7 @@ limitations under the License. */
 namespace Eigen {
 struct DefaultDevice;
 struct GpuDevice;
+struct ThreadPoolDevice;
 }  // namespace Eigen
 
 #ifdef PADDLE_WITH_XPU
@@ -124,8 +128,32 @@ class CPUDeviceContext : public DeviceContext {
 
   Eigen::DefaultDevice* eigen_device() const;
 
+  /**
+   * Multi-threaded Eigen device backed by one process-wide pool that every
+   * CPUDeviceContext shares. The pool is sized to match the oneDNN/OpenMP
+   * worker team, so kernels that alternate between the two runtimes do not
+   * fight over cores. Prefer it over eigen_device() for expressions large
+   * enough to be worth splitting.
+   */
+  Eigen::ThreadPoolDevice* eigen_pool_device() const;
+
   Place GetPlace() const override;
 
+  /**
+   * Bump-pointer scratch memory for kernel temporaries (im2col buffers,
+   * softmax staging, split/concat staging, ...), replacing transient
+   * allocations through the global allocator on the hot path. The arena
+   * is per calling thread, so kernels running on different threads never
+   * contend. Returned memory is 64-byte aligned and stays valid until
+   * ResetWorkspace(), which the executor calls after each op; never keep
+   * workspace pointers across kernel invocations.
+   */
+  void* AllocateWorkspace(size_t size) const;
+
+  // Drop all workspace allocations of the calling thread. The arena keeps
+  // its high-water capacity, so the steady state does not reallocate.
+  void ResetWorkspace() const;
+
  private:
   CPUPlace place_;
   std::unique_ptr<Eigen::DefaultDevice> eigen_device_;
@@ -296,6 +324,12 @@ class CUDAContext {
     return old_stream_ptr;
   }
 
+  // Rebind this context to an externally owned raw stream: the eigen
+  // device and the cublas/cudnn/cusolver handles are recreated on it, so
+  // every kernel launched through this context lands on the caller's
+  // stream. No-op when the stream is already bound.
+  void SetStream(gpuStream_t stream);
+
   const gpuStream_t& RawStream() { return stream_->raw_stream(); }
 
 #ifdef PADDLE_WITH_HIP
@@ -571,6 +605,18 @@ class CUDADeviceContext : public DeviceContext {
     thread_ctx_[this].reset(new CUDAContext(place_, priority));
   }
 
+  // Bind the calling thread's context to an externally owned stream, so the
+  // work this thread issues runs stream-ordered with the caller's own
+  // kernels and needs no cross-stream synchronization. Only this thread is
+  // affected; other threads keep their streams.
+  void SetThreadLocalStream(const gpuStream_t stream) {
+    std::lock_guard<std::mutex> guard(ctx_mtx_);
+    if (!thread_ctx_.count(this)) {
+      thread_ctx_[this].reset(new CUDAContext(place_));
+    }
+    thread_ctx_[this]->SetStream(stream);
+  }
+
   std::shared_ptr<CUDAContext> context() const {
     if (!thread_ctx_.count(this)) {
       return default_ctx_;
@@ -778,10 +824,6 @@ class MKLDNNDeviceContext : public CPUDeviceContext {
   /* \brief  Get the active engine */
   const mkldnn::engine& GetEngine() const { return tls().get_engine(); }
 
-  // Register object to currently used executor's map
-  void LinkEntryWithExecutor(BlobPtr_t<KeyBlob>, KeyBlob::iterator) const;
-  void RemoveShapeEntriesWithExecutor(void) const;
-
   // Remove all entries from the blob map
   void ResetBlobMap(void* ptr);
 
@@ -797,6 +839,13 @@ class MKLDNNDeviceContext : public CPUDeviceContext {
   // Calculate number of oneDNN objects cached
   unsigned int GetCachedObjectsNumber(void) const;
 
+  // Cumulative cache instrumentation: GetBlob calls that found an entry,
+  // GetBlob calls that did not, and entries inserted by SetBlob. Counters
+  // survive cache clearing so hit rates can be tracked over a whole run.
+  uint64_t GetCacheHitsNumber(void) const { return cache_hits_; }
+  uint64_t GetCacheMissesNumber(void) const { return cache_misses_; }
+  uint64_t GetCacheInsertsNumber(void) const { return cache_inserts_; }
+
   // Find a saved blob. Return nullptr if not found
   std::shared_ptr<void> GetBlob(const std::string& name) const;
 
@@ -805,12 +854,44 @@ class MKLDNNDeviceContext : public CPUDeviceContext {
   }
 
  private:
-  std::shared_ptr<BlobMap> p_blobmap_;
-  // Map key is pointer of executor and value is a data(iterator in map) needed
-  // to erase
-  std::shared_ptr<ExecShape> p_exec_items_;
-  std::shared_ptr<std::mutex> p_mutex_;
+  // The cache is sharded by the current input shape string: threads
+  // serving different shapes lock different shards, and the LRU entry
+  // budget of FLAGS_mkldnn_blob_cache_capacity is enforced per shard.
+  static constexpr size_t kCacheShards = 8;
+
+  struct CacheShard {
+    BlobMap blob_map_;
+    // Map key is pointer of executor and value is a data(iterator in map)
+    // needed to erase
+    ExecShape exec_items_;
+    // (session id, shape) groups ordered most recently used first.
+    std::list<std::pair<int, std::string>> lru_shapes_;
+    size_t num_entries_{0};
+    std::mutex mutex_;
+  };
+
+  CacheShard& GetShard(const std::string& input_shape_str) const;
+
+  // Register object to currently used executor's map. The caller must hold
+  // the shard lock.
+  void LinkEntryWithExecutor(CacheShard* shard, BlobPtr_t<KeyBlob>,
+                             KeyBlob::iterator) const;
+
+  // Move the (session id, shape) group to the front of the shard's LRU
+  // list. The caller must hold the shard lock.
+  void TouchShape(CacheShard* shard, int sid, const std::string& shape) const;
+
+  // Drop one shape group with all its cached objects and executor links.
+  // The caller must hold the shard lock.
+  void EvictShape(CacheShard* shard, int sid, const std::string& shape) const;
+
+  mutable std::array<CacheShard, kCacheShards> shards_;
+  mutable std::mutex clearing_mutex_;
   bool block_next_cache_clearing_ = false;
+
+  mutable std::atomic<uint64_t> cache_hits_{0};
+  mutable std::atomic<uint64_t> cache_misses_{0};
+  mutable std::atomic<uint64_t> cache_inserts_{0};
 };
 #endif
 
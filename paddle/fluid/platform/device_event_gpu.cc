@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "paddle/fluid/platform/cuda_resource_pool.h"
 #include "paddle/fluid/platform/device_event_base.h"
 #include "paddle/fluid/platform/event.h"
 
@@ -19,8 +20,7 @@
 namespace paddle {
 namespace platform {
 struct CUDADeviceEventWrapper {
-  CUDADeviceEventWrapper(const platform::Place& place, unsigned int flag)
-      : inner_event_(flag) {
+  CUDADeviceEventWrapper(const platform::Place& place, unsigned int flag) {
     PADDLE_ENFORCE_EQ(
         platform::is_gpu_place(place), true,
         platform::errors::PreconditionNotMet(
@@ -32,9 +32,15 @@ struct CUDADeviceEventWrapper {
         platform::errors::PreconditionNotMet(
             "Required DeviceOption.device_id > -1, but received %d. ",
             device_id_));
+    // DeviceEvent is only used for stream coordination and never queried
+    // for elapsed time, so the event is taken from the per-device pool of
+    // recycled cudaEventDisableTiming events instead of cudaEventCreate on
+    // every construction; the flag argument is kept for the creator
+    // interface but has no effect here.
+    inner_event_ = CudaEventResourcePool::Instance().New(device_id_);
   }
 
-  CudaEvent inner_event_;
+  std::shared_ptr<CudaEventObject> inner_event_;
   int device_id_;
 };
 
@@ -53,7 +59,9 @@ void DeviceEventRecordCUDA(DeviceEvent* event, const DeviceContext* context) {
       platform::errors::PreconditionNotMet(
           "Failed to dynamic_cast context into CUDADeviceContext."));
 
-  wrapper->inner_event_.Record(*cuda_dev_ctx->context()->Stream());
+  PADDLE_ENFORCE_CUDA_SUCCESS(
+      cudaEventRecord(wrapper->inner_event_.get(),
+                      cuda_dev_ctx->context()->Stream()->raw_stream()));
 }
 
 bool DeviceEventQueryCUDA(const DeviceEvent* event) {
@@ -63,13 +71,22 @@ bool DeviceEventQueryCUDA(const DeviceEvent* event) {
       platform::errors::PreconditionNotMet(
           "Failed to dynamic_cast event into CUDADeviceEventWrapper."));
 
-  return wrapper->inner_event_.Query();
+  gpuError_t err = cudaEventQuery(wrapper->inner_event_.get());
+  if (err == cudaSuccess) {
+    return true;
+  }
+  if (err == cudaErrorNotReady) {
+    return false;
+  }
+  PADDLE_ENFORCE_CUDA_SUCCESS(err);
+  return false;
 }
 
 void DeviceEventFinishCUDA(const DeviceEvent* event) {
   auto* wrapper = static_cast<CUDADeviceEventWrapper*>(event->GetEvent().get());
   // calling cudaEventSynchronize
-  wrapper->inner_event_.Synchronize();
+  PADDLE_ENFORCE_CUDA_SUCCESS(
+      cudaEventSynchronize(wrapper->inner_event_.get()));
 }
 
 void DeviceEventCUDAWaitCUDA(const DeviceEvent* event,
@@ -82,8 +99,7 @@ void DeviceEventCUDAWaitCUDA(const DeviceEvent* event,
       platform::errors::PreconditionNotMet(
           "Failed to dynamic_cast context into CUDADeviceContext."));
   // calling cudaStreamWaitEvent(stream, event, 0)
-  cuda_dev_ctx->context()->Stream()->WaitEvent(
-      wrapper->inner_event_.GetRawCudaEvent());
+  cuda_dev_ctx->context()->Stream()->WaitEvent(wrapper->inner_event_.get());
 }
 
 void DeviceEventCPUWaitCUDA(const DeviceEvent* event,
@@ -21,6 +21,20 @@ limitations under the License. */
 
 #include "glog/logging.h"
 #include "paddle/fluid/platform/device_tracer.h"
+#include "paddle/fluid/platform/flags.h"
+
+PADDLE_DEFINE_EXPORTED_int32(
+    device_tracer_stream_records, 0,
+    "When > 0, the device tracer appends its records to the file given by "
+    "FLAGS_device_tracer_stream_path every time this many records are "
+    "resident, so the host memory stays bounded during arbitrarily long "
+    "captures. The flushed chunks concatenate into one valid profile "
+    "protobuf. 0 keeps everything in memory until the profiler is disabled.");
+
+PADDLE_DEFINE_EXPORTED_string(
+    device_tracer_stream_path, "paddle_trace_stream.pb",
+    "The file the streaming trace export of the device tracer writes to, "
+    "only used when FLAGS_device_tracer_stream_records > 0.");
 
 namespace paddle {
 namespace platform {
@@ -315,6 +329,14 @@ class DeviceTracerImpl : public DeviceTracer {
       cpu_records_.emplace_front();
       local_cpu_records_ = &cpu_records_.front();
     }
+    if (FLAGS_device_tracer_stream_records > 0) {
+      // streaming export trades the lock-free push for bounded memory
+      std::lock_guard<std::mutex> l(trace_mu_);
+      local_cpu_records_->push_front(
+          CPURecord{anno, start_ns, end_ns, device_id, thread_id});
+      OnRecordAddedLocked();
+      return;
+    }
     local_cpu_records_->push_front(
         CPURecord{anno, start_ns, end_ns, device_id, thread_id});
   }
@@ -328,6 +350,13 @@ class DeviceTracerImpl : public DeviceTracer {
       PrintCuptiHint();
       return;
     }
+    if (FLAGS_device_tracer_stream_records > 0) {
+      std::lock_guard<std::mutex> l(trace_mu_);
+      mem_records_.push_front(MemRecord{name, start_ns, end_ns, device_id,
+                                        stream_id, correlation_id, bytes});
+      OnRecordAddedLocked();
+      return;
+    }
     // NOTE(liangdun): lock is not needed, only one thread call this function.
     mem_records_.push_front(MemRecord{name, start_ns, end_ns, device_id,
                                       stream_id, correlation_id, bytes});
@@ -351,6 +380,13 @@ class DeviceTracerImpl : public DeviceTracer {
       mem_info_record_.emplace_front();
       local_mem_info_record = &mem_info_record_.front();
     }
+    if (FLAGS_device_tracer_stream_records > 0) {
+      std::lock_guard<std::mutex> l(trace_mu_);
+      local_mem_info_record->emplace_front(MemInfoRecord{
+          start_ns, end_ns, bytes, place, thread_id, alloc_in, free_in});
+      OnRecordAddedLocked();
+      return;
+    }
     local_mem_info_record->emplace_front(MemInfoRecord{
         start_ns, end_ns, bytes, place, thread_id, alloc_in, free_in});
   }
@@ -373,6 +409,13 @@ class DeviceTracerImpl : public DeviceTracer {
       active_kind_records_.emplace_front();
       local_active_kind_records = &active_kind_records_.front();
     }
+    if (FLAGS_device_tracer_stream_records > 0) {
+      std::lock_guard<std::mutex> l(trace_mu_);
+      local_active_kind_records->push_front(ActiveKindRecord{
+          anno, start_ns, end_ns, device_id, thread_id, correlation_id});
+      OnRecordAddedLocked();
+      return;
+    }
     //  lock is not needed, only one thread call this function.
     local_active_kind_records->push_front(ActiveKindRecord{
         anno, start_ns, end_ns, device_id, thread_id, correlation_id});
@@ -387,6 +430,13 @@ class DeviceTracerImpl : public DeviceTracer {
       PrintCuptiHint();
       return;
     }
+    if (FLAGS_device_tracer_stream_records > 0) {
+      std::lock_guard<std::mutex> l(trace_mu_);
+      kernel_records_.push_front(
+          KernelRecord{name, start, end, device_id, stream_id, correlation_id});
+      OnRecordAddedLocked();
+      return;
+    }
     // NOTE(liangdun): lock is not needed, only one thread call this function.
     kernel_records_.push_front(
         KernelRecord{name, start, end, device_id, stream_id, correlation_id});
@@ -494,6 +544,17 @@ class DeviceTracerImpl : public DeviceTracer {
   }
 
   proto::Profile GenProfile(const std::string &profile_path) {
+    if (FLAGS_device_tracer_stream_records > 0) {
+      // append the records still resident, so the streaming file holds the
+      // whole capture, and hand it over
+      std::lock_guard<std::mutex> l(trace_mu_);
+      FlushStreamingLocked();
+      if (stream_file_.is_open()) {
+        stream_file_.close();
+      }
+      LOG(INFO) << "The streamed timeline trace has been written to "
+                << FLAGS_device_tracer_stream_path;
+    }
     proto::Profile profile_pb = this->GetProfile();
     std::ofstream profile_f;
     profile_f.open(profile_path,
@@ -504,11 +565,17 @@ class DeviceTracerImpl : public DeviceTracer {
   }
 
   proto::Profile GetProfile() {
-    int miss = 0, find = 0;
     std::lock_guard<std::mutex> l(trace_mu_);
     proto::Profile profile_pb;
     profile_pb.set_start_ns(start_ns_);
     profile_pb.set_end_ns(end_ns_);
+    SerializeTraceLocked(&profile_pb);
+    return profile_pb;
+  }
+
+  void SerializeTraceLocked(proto::Profile *profile_ptr) {
+    int miss = 0, find = 0;
+    proto::Profile &profile_pb = *profile_ptr;
     if (correlations_.empty()) {
       for (auto &tmp : correlations_pairs) {
         for (auto &pair : tmp) correlations_[pair.first] = pair.second;
@@ -532,6 +599,7 @@ class DeviceTracerImpl : public DeviceTracer {
       event->set_end_ns(r.end_ns);
       event->set_sub_device_id(r.stream_id);
       event->set_device_id(r.device_id);
+      event->set_correlation_id(r.correlation_id);
     }
     VLOG(1) << "KernelRecord event miss: " << miss << " find: " << find;
 
@@ -562,6 +630,7 @@ class DeviceTracerImpl : public DeviceTracer {
         event->set_end_ns(r.end_ns);
         event->set_sub_device_id(r.thread_id);
         event->set_device_id(r.device_id);
+        event->set_correlation_id(r.correlation_id);
       }
     }
     miss = find = 0;
@@ -581,6 +650,7 @@ class DeviceTracerImpl : public DeviceTracer {
       event->set_end_ns(r.end_ns);
       event->set_sub_device_id(r.stream_id);
       event->set_device_id(r.device_id);
+      event->set_correlation_id(r.correlation_id);
       event->mutable_memcopy()->set_bytes(r.bytes);
     }
     VLOG(1) << "MemRecord event miss: " << miss << " find: " << find;
@@ -611,7 +681,44 @@ class DeviceTracerImpl : public DeviceTracer {
         event->set_thread_id(r.thread_id);
       }
     }
-    return profile_pb;
+  }
+
+  // Move the resident records into a partial profile and append it to the
+  // streaming trace file. Serialized protobuf messages concatenate into one
+  // valid merged message, so the finished file still parses as a single
+  // proto::Profile. Must be called with trace_mu_ held.
+  void FlushStreamingLocked() {
+    if (!stream_file_.is_open()) {
+      stream_file_.open(FLAGS_device_tracer_stream_path,
+                        std::ios::out | std::ios::trunc | std::ios::binary);
+    }
+    proto::Profile profile_pb;
+    profile_pb.set_start_ns(start_ns_);
+    profile_pb.set_end_ns(end_ns_);
+    // new annotations may have arrived since the last flush, force the
+    // correlation map to be rebuilt from the pairs
+    correlations_.clear();
+    SerializeTraceLocked(&profile_pb);
+    profile_pb.SerializeToOstream(&stream_file_);
+    stream_file_.flush();
+    num_resident_records_ = 0;
+    kernel_records_.clear();
+    mem_records_.clear();
+    for (auto &tmp : cpu_records_) tmp.clear();
+    for (auto &tmp : mem_info_record_) tmp.clear();
+    for (auto &tmp : active_kind_records_) tmp.clear();
+    // the correlation pairs are kept, records that arrive later may still
+    // refer to correlation ids annotated before this flush
+  }
+
+  // Account for a newly buffered record in streaming mode and flush once the
+  // resident buffer reaches the configured size. Must be called with
+  // trace_mu_ held.
+  void OnRecordAddedLocked() {
+    if (++num_resident_records_ >=
+        static_cast<uint64_t>(FLAGS_device_tracer_stream_records)) {
+      FlushStreamingLocked();
+    }
   }
 
   void Disable() {
@@ -646,6 +753,9 @@ class DeviceTracerImpl : public DeviceTracer {
   bool enabled_;
   uint64_t start_ns_;
   uint64_t end_ns_;
+  // streaming export state, guarded by trace_mu_
+  std::ofstream stream_file_;
+  uint64_t num_resident_records_{0};
   std::forward_list<KernelRecord> kernel_records_;
   std::forward_list<MemRecord> mem_records_;
   std::forward_list<std::forward_list<CPURecord>> cpu_records_;
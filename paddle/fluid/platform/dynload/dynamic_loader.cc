@@ -189,6 +189,11 @@ static inline void* GetDsoHandleFromSpecificPath(const std::string& spec_path,
             << " from specific path: " << spec_path;
     std::string dso_path = join(spec_path, dso_name);
     dso_handle = dlopen(dso_path.c_str(), dynload_flags);
+#if !defined(_WIN32)
+    if (nullptr == dso_handle) {
+      VLOG(3) << "Failed to find library: " << dlerror();
+    }
+#endif  // !_WIN32
   }
   return dso_handle;
 }
@@ -200,6 +205,11 @@ static inline void* GetDsoHandleFromDefaultPath(const std::string& dso_path,
   void* dso_handle = dlopen(dso_path.c_str(), dynload_flags);
   VLOG(3) << "Try to find library: " << dso_path
           << " from default system path.";
+#if !defined(_WIN32)
+  if (nullptr == dso_handle) {
+    VLOG(3) << "Failed to find library: " << dlerror();
+  }
+#endif  // !_WIN32
 
 // TODO(chenweihang): This path is used to search which libs?
 // DYLD_LIBRARY_PATH is disabled after Mac OS 10.11 to
@@ -25,6 +25,13 @@ namespace dynload {
 #define DECLARE_TYPE(__name, ...) decltype(auto)
 #endif
 
+// NOTE: loading is lazy on two levels and must stay that way. Each getter
+// below dlopen()s its library with RTLD_LAZY the first time any wrapped
+// routine is called (the wrappers guard it with a std::once_flag), and every
+// wrapped routine dlsym()s its own symbol on its first call. A process that
+// never calls into a library therefore never maps it; in particular CPU-only
+// inference never touches the CUDA/cuDNN/NCCL libraries. Do not call these
+// getters from static initializers or unconditional init paths.
 void* GetCublasDsoHandle();
 void* GetCUDNNDsoHandle();
 void* GetCUPTIDsoHandle();
@@ -36,6 +36,16 @@ enum class EventRole {
   kSpecial,   // record event such as PE which is outer of thread local
 };
 
+// Deltas of hardware perf counters between a matched pair of kPushRange /
+// kPopRange markers. Only filled on the pop event and only when
+// FLAGS_profiler_perf_counters is set, see profiler.cc.
+struct PerfCounterValues {
+  uint64_t instructions{0};
+  uint64_t cycles{0};
+  uint64_t cache_misses{0};
+  uint64_t stalled_cycles{0};
+};
+
 class Event {
  public:
   // The DeviceContext is used to get the cuda stream.
@@ -52,6 +62,10 @@ class Event {
   void set_name(std::string name) { name_ = name; }
   void set_role(EventRole role) { role_ = role; }
   std::string attr() const { return attr_; }
+  const PerfCounterValues& perf_counters() const { return perf_counters_; }
+  void set_perf_counters(const PerfCounterValues& counters) {
+    perf_counters_ = counters;
+  }
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
 #ifndef PADDLE_WITH_CUPTI
   gpuEvent_t event() const { return event_; }
@@ -71,6 +85,7 @@ class Event {
   int64_t cpu_ns_;
   bool visited_status_{false};
   std::string attr_;
+  PerfCounterValues perf_counters_;
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
 #ifdef PADDLE_WITH_CUPTI
   int64_t gpu_ns_ = 0;
@@ -61,6 +61,22 @@ PADDLE_DEFINE_EXPORTED_bool(
     "Checking whether operator produce NAN/INF or not. It will be "
     "extremely slow so please use this flag wisely.");
 
+/**
+ * Operator related FLAG
+ * Name: FLAGS_enable_fc_packed_weight_cache
+ * Since Version: 2.2.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: Cache the MKL packed image of each FC weight matrix and reuse it
+ *       across calls, so the GEMM does not re-pack the weights on every
+ *       forward pass. Only safe when the weights are constant, i.e. for
+ *       inference; do not enable it for training.
+ */
+PADDLE_DEFINE_EXPORTED_bool(
+    enable_fc_packed_weight_cache, false,
+    "Cache the MKL packed image of FC weight matrices and reuse it across "
+    "calls. Only safe when weights are constant (inference).");
+
 // NOTE(zhiqiu): better to share the flags, otherwise we will have too many
 // flags.
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP) || \
@@ -214,6 +230,42 @@ PADDLE_DEFINE_EXPORTED_bool(
     cudnn_batchnorm_spatial_persistent, false,
     "Whether enable CUDNN_BATCHNORM_SPATIAL_PERSISTENT mode for cudnn "
     "batch_norm, default is False.");
+
+/**
+ * CUDNN related FLAG
+ * Name: FLAGS_conv_search_cache_path
+ * Since Version: 2.3
+ * Value Range: string, default=""
+ * Example: FLAGS_conv_search_cache_path=/var/cache/paddle_conv makes all
+ *          processes on the host persist and preload exhaustive-search
+ *          results for convolution algorithms through that directory, so
+ *          the multi-second searches run at most once per host.
+ * Note: empty string disables persistence. The cache file is keyed by the
+ *       cuDNN/MIOpen version and the device architecture, so stale results
+ *       are never reused after an upgrade. POSIX only.
+ */
+PADDLE_DEFINE_EXPORTED_string(
+    conv_search_cache_path, "",
+    "The directory used to persist exhaustive-search results for cuDNN "
+    "convolution algorithms across processes. Empty string disables it.");
+
+/**
+ * GPU related FLAG
+ * Name: FLAGS_device_code_cache_dir
+ * Since Version: 2.3
+ * Value Range: string, default=""
+ * Example: FLAGS_device_code_cache_dir=/var/cache/paddle_jit stores the
+ *          binaries of runtime-compiled kernels (e.g. fusion_group) in
+ *          that directory, so restarts and colocated processes skip NVRTC
+ *          compilation.
+ * Note: cache files are keyed by the kernel source hash, the device
+ *       compute capability and the NVRTC/HIPRTC version, so stale
+ *       binaries are never reused. Empty string disables the cache.
+ */
+PADDLE_DEFINE_EXPORTED_string(
+    device_code_cache_dir, "",
+    "The directory used to cache the binaries of runtime-compiled device "
+    "kernels across processes. Empty string disables the cache.");
 #endif
 
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
@@ -232,8 +284,76 @@ PADDLE_DEFINE_EXPORTED_bool(
     sync_nccl_allreduce, true,
     "If set true, will call `cudaStreamSynchronize(nccl_stream)`"
     "after allreduce, this mode can get better performance in some scenarios.");
+
+/**
+ * NCCL related FLAG
+ * Name: FLAGS_hierarchical_allreduce_pipeline_nchunks
+ * Since Version: 2.2
+ * Value Range: int32, default=1
+ * Example:
+ * Note: Number of chunks one hierarchical allreduce is split into. With
+ *       more than one chunk the intra node reduce of a chunk overlaps the
+ *       inter node allreduce of the previous chunk, so the NVLink and the
+ *       network phases are pipelined instead of running back to back.
+ */
+PADDLE_DEFINE_EXPORTED_int32(
+    hierarchical_allreduce_pipeline_nchunks, 1,
+    "Number of chunks one hierarchical allreduce is split into, "
+    "values > 1 pipeline the intra node and inter node phases.");
+
+/**
+ * NCCL related FLAG
+ * Name: FLAGS_nccl_high_priority_streams
+ * Since Version: 2.2
+ * Value Range: bool, default=false
+ * Example:
+ * Note: If set true, the NCCL communication contexts are created with the
+ *       highest stream priority the device supports, so collectives
+ *       preempt concurrently running compute kernels instead of queueing
+ *       behind them.
+ */
+PADDLE_DEFINE_EXPORTED_bool(
+    nccl_high_priority_streams, false,
+    "Create NCCL communication streams with high priority, so collectives "
+    "preempt concurrently running compute kernels.");
+
+/**
+ * CUDA Graph related FLAG
+ * Name: FLAGS_cuda_graph_auto_capture_warmup_steps
+ * Since Version: 2.2
+ * Value Range: int32, default=-1
+ * Example:
+ * Note: When >= 0 and build_strategy.allow_cuda_graph_capture is on,
+ *       ParallelExecutor runs this many warmup iterations normally, then
+ *       captures one whole iteration into a CUDA Graph and replays it on
+ *       the following steps. The graph is dropped and re-captured when a
+ *       fed tensor changes its shape, dtype or lod, or when a step
+ *       fetches data.
+ */
+PADDLE_DEFINE_EXPORTED_int32(
+    cuda_graph_auto_capture_warmup_steps, -1,
+    "Number of warmup iterations before ParallelExecutor captures the "
+    "whole iteration into a CUDA Graph, -1 disables automatic capture.");
 #endif
 
+/**
+ * Distributed related FLAG
+ * Name: FLAGS_grad_merge_allreduce_nchunks
+ * Since Version: 2.2
+ * Value Range: int32, default=1
+ * Example:
+ * Note: With gradient merge and fuse_all_reduce_ops, one fused allreduce
+ *       only starts after every gradient in its group has finished
+ *       accumulating, so all communication of the merge window bursts at
+ *       the boundary step. Values > 1 split each fused group into this
+ *       many chunks; a chunk whose accumulations complete early starts
+ *       its allreduce while the final micro batch is still in backward.
+ */
+PADDLE_DEFINE_EXPORTED_int32(
+    grad_merge_allreduce_nchunks, 1,
+    "Number of chunks one fused gradient merge allreduce group is split "
+    "into, values > 1 overlap the chunk allreduces with backward.");
+
 #ifdef PADDLE_WITH_DISTRIBUTE
 /**
  * Distributed related FLAG
@@ -604,6 +724,133 @@ PADDLE_DEFINE_EXPORTED_int32(
     "less FLAGS_max_inplace_grad_add, than it will be use several grad_add"
     "instead of sum. Default is 0.");
 
+/**
+ * Performance related FLAG
+ * Name: buffered_reader_prefetch_depth
+ * Since Version: 2.2.0
+ * Value Range: int32, default=0
+ * Example:
+ * Note: Overrides the prefetch depth (number of batches kept in flight)
+ * of BufferedReader, which decorates the DataLoader output. Default is
+ * 0, which keeps the depth requested by the caller.
+ */
+PADDLE_DEFINE_EXPORTED_int32(
+    buffered_reader_prefetch_depth, 0,
+    "Overrides the number of batches BufferedReader keeps in flight. "
+    "Default is 0 (keep the caller's buffer size).");
+
+/**
+ * Performance related FLAG
+ * Name: buffered_reader_auto_tune_depth
+ * Since Version: 2.2.0
+ * Value Range: int32, default=0
+ * Example:
+ * Note: Upper bound for the BufferedReader depth auto-tuner. When
+ * greater than the current depth, the reader watches how often the
+ * trainer arrives before the next batch is ready and deepens the
+ * pipeline one slot at a time, up to this bound, while training stays
+ * input-bound. Each extra slot holds one more decoded batch in host
+ * memory, so the bound doubles as the memory budget. Default is 0,
+ * which disables the auto-tuner.
+ */
+PADDLE_DEFINE_EXPORTED_int32(
+    buffered_reader_auto_tune_depth, 0,
+    "Maximum prefetch depth the BufferedReader auto-tuner may grow to "
+    "when training is input-bound. Default is 0 (auto-tuning disabled).");
+
+/**
+ * Performance related FLAG
+ * Name: imperative_backward_threads
+ * Since Version: 2.2.0
+ * Value Range: int32, default=1
+ * Example:
+ * Note: The number of threads used to execute the dygraph backward
+ * graph. When greater than 1, independent branches of the autograd
+ * graph are executed concurrently on a thread pool; gradient
+ * accumulation stays serialized per variable. Default is 1, which
+ * keeps the original sequential execution.
+ */
+PADDLE_DEFINE_EXPORTED_int32(
+    imperative_backward_threads, 1,
+    "The number of threads used to execute the dygraph backward graph. "
+    "When greater than 1, independent branches run concurrently. "
+    "Default is 1 (sequential execution).");
+
+/**
+ * Performance related FLAG
+ * Name: imperative_reducer_rebalance_steps
+ * Since Version: 2.2.0
+ * Value Range: int32, default=0
+ * Example:
+ * Note: The number of warmup iterations during which the dygraph
+ * Reducer measures when each gradient becomes ready. After that many
+ * iterations the gradient buckets are re-partitioned once so that every
+ * bucket covers a comparable span of the backward timeline, which
+ * equalizes the computation available to overlap each allreduce.
+ * Default is 0, which keeps the buckets fixed.
+ */
+PADDLE_DEFINE_EXPORTED_int32(
+    imperative_reducer_rebalance_steps, 0,
+    "The number of warmup iterations used by the dygraph Reducer to "
+    "measure gradient ready times before re-partitioning the buckets "
+    "once. Default is 0 (no rebalancing).");
+
+/**
+ * Performance related FLAG
+ * Name: imperative_allreduce_chunk_bytes
+ * Since Version: 2.2.0
+ * Value Range: uint64, default=0
+ * Example:
+ * Note: The maximum number of bytes a single dense allreduce issued by
+ * the dygraph Reducer may cover. A fused bucket larger than this limit
+ * (typically a single oversized parameter that monopolizes its bucket)
+ * is communicated in several in-place collective calls over slices of
+ * the fused buffer. Default is 0, which keeps one call per bucket.
+ */
+PADDLE_DEFINE_EXPORTED_uint64(
+    imperative_allreduce_chunk_bytes, 0,
+    "The maximum number of bytes per dense allreduce issued by the "
+    "dygraph Reducer; larger fused buckets are communicated in several "
+    "collective calls. Default is 0 (one call per bucket).");
+
+/**
+ * Performance related FLAG
+ * Name: dygraph_prepared_op_cache
+ * Since Version: 2.2.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: Caches the kernel selection and the inferred output dims of
+ * dygraph operators, keyed by op type, input shapes/dtypes, attributes
+ * and place. In steady-state training loops where the same op runs with
+ * the same shapes every iteration, this skips the repeated kernel type
+ * inference, kernel map lookup and InferShape call. Ops with LoD inputs,
+ * non-LoDTensor inputs/outputs or block attributes bypass the cache.
+ */
+PADDLE_DEFINE_EXPORTED_bool(
+    dygraph_prepared_op_cache, false,
+    "Cache kernel selection and inferred output dims of dygraph ops "
+    "keyed by op type, input shapes, attributes and place, so repeated "
+    "iterations skip kernel lookup and InferShape. Default is false.");
+
+/**
+ * Performance related FLAG
+ * Name: imperative_hook_threads
+ * Since Version: 2.2.0
+ * Value Range: int32, default=0
+ * Example:
+ * Note: The number of worker threads running leaf gradient hook chains
+ * (gradient hooks, cross-batch accumulation and reduce hooks)
+ * asynchronously during the dygraph backward. Hooks for different
+ * parameters run concurrently as each gradient becomes ready, overlapping
+ * with the remaining backward graph; backward() waits for all of them
+ * before it returns. Default is 0, which runs the hooks inline.
+ */
+PADDLE_DEFINE_EXPORTED_int32(
+    imperative_hook_threads, 0,
+    "The number of worker threads running leaf gradient hooks "
+    "asynchronously during the dygraph backward. Default is 0, which "
+    "runs the hooks inline.");
+
 /**
  * Debug related FLAG
  * Name: tracer_mkldnn_ops_on
@@ -708,6 +955,40 @@ PADDLE_DEFINE_EXPORTED_bool(allreduce_record_one_event, false,
 PADDLE_DEFINE_EXPORTED_bool(
     use_cinn, false, "It controls whether to run PaddlePaddle using CINN");
 
+/*
+ * CINN related FLAG
+ * Name: FLAGS_cinn_cache_dir
+ * Since Version: 2.3
+ * Value Range: string, default=""
+ * Example: FLAGS_cinn_cache_dir=/var/cache/paddle_cinn makes all processes
+ *          on the host share compiled CINN subgraphs through that
+ *          directory, so only the first process pays compilation.
+ * Note: empty string disables the persistent cache. POSIX only.
+ */
+PADDLE_DEFINE_EXPORTED_string(
+    cinn_cache_dir, "",
+    "The directory of the host-wide persistent cache of compiled CINN "
+    "subgraphs. Empty string disables the cache.");
+
+#ifndef _WIN32
+/*
+ * Model load related FLAG
+ * Name: FLAGS_use_mmap_load
+ * Since Version: 2.3
+ * Value Range: bool, default=false
+ * Example: FLAGS_use_mmap_load=true makes load_combine map the combined
+ *          parameter file copy-on-write and point CPU tensors straight at
+ *          the page cached file instead of copying every parameter.
+ * Note: POSIX only and only effective for CPU place. Colocated processes
+ *       loading the same model share one physical copy of the weights.
+ */
+PADDLE_DEFINE_EXPORTED_bool(
+    use_mmap_load, false,
+    "It controls whether load_combine maps the combined parameter file "
+    "copy-on-write and points CPU tensors at the mapping instead of "
+    "copying the data through a buffered stream");
+#endif
+
 DEFINE_int32(record_pool_max_size, 2000000,
              "SlotRecordDataset slot record pool max size");
 DEFINE_int32(slotpool_thread_num, 1, "SlotRecordDataset slot pool thread num");
@@ -717,3 +998,6 @@ DEFINE_bool(enable_slotrecord_reset_shrink, false,
             "enable slotrecord obejct reset shrink memory, default false");
 DEFINE_bool(enable_ins_parser_file, false,
             "enable parser ins file , default false");
+DEFINE_bool(data_feed_lock_free_channel, false,
+            "back the bounded data feed channels with the lock-free MPMC "
+            "ring buffer instead of mutex+condvar, default false");
@@ -14,12 +14,15 @@ limitations under the License. */
 #pragma once
 
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
+#include <xxhash.h>
 #include "mkldnn.hpp"
 #include "paddle/fluid/framework/operator.h"
 #include "paddle/fluid/platform/place.h"
@@ -397,45 +400,31 @@ inline std::string ThreadIDasStr(void) {
       std::hash<std::thread::id>()(std::this_thread::get_id()));
 }
 
+// Cache keys are opaque to the blob cache, so instead of rendering every
+// argument as a decimal string (whose concatenation shows up in profiles of
+// small-shape models) each argument is folded into an XXH64 state by its raw
+// bytes. This produces a fixed 8-byte key with no heap allocation: the key
+// itself and the short "@..." suffixes the handlers append to it all stay
+// within the small-string optimization.
 template <typename T>
-inline void AppendKey(std::string* key, const T& num) {
-  key->append(std::to_string(num));
+inline void AppendKey(XXH64_state_t* hash_state, const T& num) {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Only trivially copyable types can be folded into an oneDNN "
+                "cache key");
+  XXH64_update(hash_state, &num, sizeof(num));
 }
 
-template <>
-inline void AppendKey(std::string* key,
-                      const mkldnn::memory::format_tag& format) {
-  key->append(std::to_string(static_cast<int>(format)));
+inline void AppendKey(XXH64_state_t* hash_state, const std::string& str) {
+  XXH64_update(hash_state, str.data(), str.size());
 }
 
-template <>
-inline void AppendKey(std::string* key,
-                      const mkldnn::memory::data_type& data_type) {
-  key->append(std::to_string(static_cast<int>(data_type)));
+inline void AppendKey(XXH64_state_t* hash_state, const char* str) {
+  XXH64_update(hash_state, str, std::strlen(str));
 }
 
-template <>
-inline void AppendKey(std::string* key, const mkldnn::algorithm& algorithm) {
-  key->append(std::to_string(static_cast<int>(algorithm)));
-}
-
-template <>
-inline void AppendKey(std::string* key,
-                      const mkldnn::normalization_flags& flags) {
-  key->append(std::to_string(static_cast<int>(flags)));
-}
-
-inline void AppendKey(std::string* key, const std::string& str) {
-  key->append(str);
-}
-
-inline void AppendKey(std::string* key, const char* str) { key->append(str); }
-
 template <typename T>
-inline void AppendKey(std::string* key, const std::vector<T>& dims) {
-  for (size_t i = 0; i < dims.size(); i++) {
-    AppendKey(key, std::to_string(dims[i]));
-  }
+inline void AppendKey(XXH64_state_t* hash_state, const std::vector<T>& dims) {
+  XXH64_update(hash_state, dims.data(), dims.size() * sizeof(T));
 }
 
 // If MKLDNN build and CPU place then register suffix in DeviceContext
@@ -468,20 +457,29 @@ inline void AttachPointerHashToMKLDNNKey(void* ptr,
 template <typename... ArgTypes>
 inline std::string CreateKey(const platform::MKLDNNDeviceContext& dev_ctx,
                              ArgTypes&&... args) {
-  std::string key;
-  key.reserve(64);
+  XXH64_state_t hash_state;
+  XXH64_reset(&hash_state, 0);
   using expand_type = int[];
-  expand_type{0, (AppendKey(&key, std::forward<ArgTypes>(args)), 0)...};
-  key += paddle::platform::MKLDNNDeviceContext::tls().get_key_suffix();
-  return key;
+  expand_type{0, (AppendKey(&hash_state, std::forward<ArgTypes>(args)), 0)...};
+  AppendKey(&hash_state,
+            paddle::platform::MKLDNNDeviceContext::tls().get_key_suffix());
+  const uint64_t digest = XXH64_digest(&hash_state);
+  return std::string(reinterpret_cast<const char*>(&digest), sizeof(digest));
 }
 
 inline std::string ExtendKeyWithThreadInfoIfNeeded(
     const platform::MKLDNNDeviceContext& dev_ctx, const std::string& key) {
-  return (paddle::platform::MKLDNNDeviceContext::tls().is_tid_used_in_key() ==
-          true)
-             ? key + "-t:" + ThreadIDasStr()
-             : key;
+  if (paddle::platform::MKLDNNDeviceContext::tls().is_tid_used_in_key() ==
+      false) {
+    return key;
+  }
+  // Keep the extended key fixed-size as well, so per-thread keys built from
+  // it do not spill out of the small-string optimization either.
+  const uint64_t tid_hash =
+      std::hash<std::thread::id>()(std::this_thread::get_id());
+  return key +
+         std::string(reinterpret_cast<const char*>(&tid_hash),
+                     sizeof(tid_hash));
 }
 
 inline std::vector<std::vector<int64_t>> ToMkldnnPadding(
@@ -21,12 +21,15 @@ limitations under the License. */
 #include <vector>
 
 #include "boost/optional.hpp"
+#include "gflags/gflags.h"
 #include "paddle/fluid/framework/data_layout_transform.h"
 #include "paddle/fluid/framework/operator.h"
 #include "paddle/fluid/operators/pool_op.h"
 #include "paddle/fluid/platform/mkldnn_helper.h"
 #include "paddle/fluid/platform/place.h"
 
+DECLARE_int64(mkldnn_shape_bucket_size);
+
 namespace paddle {
 namespace platform {
 
@@ -35,6 +38,27 @@ using framework::Tensor;
 using user_function = std::function<std::shared_ptr<float>(const float*)>;
 using memory = mkldnn::memory;
 
+// Shape bucketing for primitives which normalize over the innermost axis of
+// a contiguous tensor (softmax, layer_norm). Variable-sequence-length
+// workloads produce thousands of distinct shapes, each creating a fresh
+// primitive; when FLAGS_mkldnn_shape_bucket_size is set, such a tensor is
+// flattened to 2D and its row count rounded up to the nearest bucket, so a
+// handful of primitives covers all lengths at the cost of computing a few
+// padded rows in scratch memory.
+inline bool CanBucketShape(const std::vector<int64_t>& tz, int axis,
+                           MKLDNNMemoryFormat fmt) {
+  // Flattening relies on a plain row-major layout; blocked inputs keep the
+  // exact-shape path.
+  return FLAGS_mkldnn_shape_bucket_size > 0 && tz.size() >= 2 &&
+         axis == static_cast<int>(tz.size()) - 1 &&
+         fmt == MKLDNNFormatForSize(tz.size(), MKLDNNMemoryFormat::nchw);
+}
+
+inline int64_t BucketRows(int64_t rows) {
+  const int64_t bucket = FLAGS_mkldnn_shape_bucket_size;
+  return (rows + bucket - 1) / bucket * bucket;
+}
+
 template <typename T, typename TForward,
           typename TBackward = mkldnn_dummy_primitive,
           typename TBackward_params = mkldnn_dummy_primitive>
@@ -36,6 +36,8 @@
 
 #define NCCL_ID_VARNAME "NCCLID"
 
+DECLARE_bool(nccl_high_priority_streams);
+
 namespace paddle {
 namespace platform {
 
@@ -84,7 +86,14 @@ struct NCCLContext {
   ncclComm_t comm_;
 
   explicit NCCLContext(int dev_id)
-      : ctx_(new CUDADeviceContext(CUDAPlace(dev_id))), comm_{nullptr} {}
+      : ctx_(new CUDADeviceContext(CUDAPlace(dev_id))), comm_{nullptr} {
+    // Putting the collectives on a high priority stream lets them preempt
+    // concurrently running compute kernels, so the allreduce of one layer
+    // overlaps the backward of the next instead of queueing behind it.
+    if (FLAGS_nccl_high_priority_streams) {
+      ctx_->ResetDefaultContext(stream::Priority::kHigh);
+    }
+  }
 
   gpuStream_t stream() const { return ctx_->stream(); }
   ncclComm_t comm() const { return comm_; }
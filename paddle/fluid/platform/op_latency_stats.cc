@@ -0,0 +1,79 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/platform/op_latency_stats.h"
+
+#include <utility>
+
+#include "paddle/fluid/platform/flags.h"
+
+PADDLE_DEFINE_EXPORTED_bool(
+    op_latency_stats, false,
+    "Record a log-scale wall-clock histogram per op type in "
+    "OperatorBase::Run. The histograms are cumulative, updated with a few "
+    "relaxed atomics and scraped via "
+    "paddle.fluid.core.globals().get(\"STATS_op_latency\"), so per-op "
+    "latency percentiles can be exported from production serving without "
+    "running the profiler.");
+
+namespace paddle {
+namespace platform {
+
+OpLatencyRegistry &OpLatencyRegistry::Instance() {
+  static OpLatencyRegistry instance;
+  return instance;
+}
+
+OpLatencyHistogram *OpLatencyRegistry::GetHistogram(
+    const std::string &op_type) {
+  std::lock_guard<std::mutex> guard(mu_);
+  auto &histogram = histograms_[op_type];
+  if (histogram == nullptr) {
+    histogram.reset(new OpLatencyHistogram());
+  }
+  return histogram.get();
+}
+
+void OpLatencyRegistry::Record(const std::string &op_type,
+                               uint64_t latency_ns) {
+  // The registry mutex is only taken the first time a thread meets an op
+  // type, afterwards the lookup stays thread local.
+  thread_local std::unordered_map<std::string, OpLatencyHistogram *> cache;
+  auto it = cache.find(op_type);
+  if (it == cache.end()) {
+    it = cache.emplace(op_type, GetHistogram(op_type)).first;
+  }
+  it->second->Record(latency_ns);
+}
+
+std::vector<OpLatencySnapshot> OpLatencyRegistry::GetSnapshots() {
+  std::lock_guard<std::mutex> guard(mu_);
+  std::vector<OpLatencySnapshot> snapshots;
+  snapshots.reserve(histograms_.size());
+  for (auto &pair : histograms_) {
+    OpLatencySnapshot snapshot;
+    snapshot.op_type = pair.first;
+    snapshot.count = pair.second->count();
+    snapshot.total_ns = pair.second->total_ns();
+    snapshot.buckets.reserve(OpLatencyHistogram::kNumBuckets);
+    for (int i = 0; i < OpLatencyHistogram::kNumBuckets; ++i) {
+      snapshot.buckets.push_back(pair.second->bucket(i));
+    }
+    snapshots.emplace_back(std::move(snapshot));
+  }
+  return snapshots;
+}
+
+}  // namespace platform
+}  // namespace paddle
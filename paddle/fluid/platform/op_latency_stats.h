@@ -0,0 +1,98 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "paddle/fluid/platform/macros.h"
+
+namespace paddle {
+namespace platform {
+
+// Cumulative wall-clock statistics of one op type. The buckets are
+// log-scale: bucket i counts the runs whose latency is in [2^i, 2^(i+1))
+// nanoseconds, the shape Prometheus-style histogram exporters expect for
+// deriving p50/p99. One update is three relaxed atomic increments, cheap
+// enough to stay enabled in production serving, unlike the full profiler.
+class OpLatencyHistogram {
+ public:
+  // 2^40 ns is about 18 minutes, the last bucket absorbs everything longer.
+  static constexpr int kNumBuckets = 40;
+
+  void Record(uint64_t latency_ns) {
+    int bucket = 0;
+    while (bucket + 1 < kNumBuckets && (latency_ns >> (bucket + 1)) != 0) {
+      ++bucket;
+    }
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    total_ns_.fetch_add(latency_ns, std::memory_order_relaxed);
+  }
+
+  uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+  uint64_t total_ns() const {
+    return total_ns_.load(std::memory_order_relaxed);
+  }
+  uint64_t bucket(int i) const {
+    return buckets_[i].load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> total_ns_{0};
+  std::array<std::atomic<uint64_t>, kNumBuckets> buckets_{};
+};
+
+struct OpLatencySnapshot {
+  std::string op_type;
+  uint64_t count{0};
+  uint64_t total_ns{0};
+  std::vector<uint64_t> buckets;
+};
+
+// Process-wide registry of per-op-type latency histograms, updated by
+// OperatorBase::Run when FLAGS_op_latency_stats is set and scraped through
+// GetSnapshots (exposed to python as STATS_op_latency).
+class OpLatencyRegistry {
+  DISABLE_COPY_AND_ASSIGN(OpLatencyRegistry);
+
+ public:
+  static OpLatencyRegistry &Instance();
+
+  // Histogram of `op_type`, created on first use. Histograms are never
+  // removed, so the returned pointer stays valid and may be cached.
+  OpLatencyHistogram *GetHistogram(const std::string &op_type);
+
+  void Record(const std::string &op_type, uint64_t latency_ns);
+
+  std::vector<OpLatencySnapshot> GetSnapshots();
+
+ private:
+  OpLatencyRegistry() = default;
+
+  std::mutex mu_;
+  std::unordered_map<std::string, std::unique_ptr<OpLatencyHistogram>>
+      histograms_;
+};
+
+}  // namespace platform
+}  // namespace paddle
@@ -16,10 +16,21 @@ limitations under the License. */
 #include <random>
 #include <string>
 
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
 #include "paddle/fluid/platform/device_tracer.h"
 #include "paddle/fluid/platform/enforce.h"
 #include "paddle/fluid/platform/profiler.h"
 #include "paddle/fluid/platform/profiler_helper.h"
+#ifdef PADDLE_WITH_MKLDNN
+#include "paddle/fluid/platform/device_context.h"
+#endif
 #ifdef PADDLE_WITH_CUDA
 #include "paddle/fluid/platform/dynload/nvtx.h"
 #endif
@@ -27,6 +38,20 @@ limitations under the License. */
 PADDLE_DEFINE_EXPORTED_bool(enable_rpc_profiler, false,
                             "Enable rpc profiler or not.");
 
+PADDLE_DEFINE_EXPORTED_int32(
+    profiler_sample_rate, 0,
+    "Record one out of every profiler_sample_rate RecordEvent annotations "
+    "per thread even when the profiler is disabled, so op-level latencies "
+    "can be collected in production at negligible overhead. 0 disables "
+    "sampling.");
+
+PADDLE_DEFINE_EXPORTED_bool(
+    profiler_perf_counters, false,
+    "Capture hardware perf counters (instructions, cycles, LLC misses, "
+    "stalled backend cycles) inside every RecordEvent scope and report IPC "
+    "and miss rates per event in the profiler summary. Linux only, requires "
+    "perf_event_open permission.");
+
 namespace paddle {
 namespace platform {
 
@@ -57,6 +82,83 @@ double Event::CudaElapsedMs(const Event &e) const {
 #endif
 }
 
+#if defined(__linux__)
+namespace {
+
+// One set of per-thread counting perf events, opened lazily on first use.
+// Each counter is read as a plain 8 byte value, counters that the kernel or
+// the hardware refuses to open simply stay at zero.
+class PerfCounterReader {
+ public:
+  PerfCounterReader() {
+    const std::pair<uint32_t, uint64_t> configs[kNumCounters] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND}};
+    for (size_t i = 0; i < kNumCounters; ++i) {
+      perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = configs[i].first;
+      attr.config = configs[i].second;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      fds_[i] = static_cast<int>(syscall(__NR_perf_event_open, &attr,
+                                         0 /* this thread */, -1 /* any cpu */,
+                                         -1 /* no group */, 0));
+    }
+    if (fds_[0] == -1) {
+      LOG_FIRST_N(WARNING, 1)
+          << "perf_event_open is not permitted, hardware counters will not "
+             "be recorded. Check /proc/sys/kernel/perf_event_paranoid.";
+    }
+  }
+
+  ~PerfCounterReader() {
+    for (size_t i = 0; i < kNumCounters; ++i) {
+      if (fds_[i] != -1) {
+        close(fds_[i]);
+      }
+    }
+  }
+
+  bool Read(PerfCounterValues *values) {
+    uint64_t counters[kNumCounters] = {0, 0, 0, 0};
+    bool any_counter_read = false;
+    for (size_t i = 0; i < kNumCounters; ++i) {
+      if (fds_[i] == -1) {
+        continue;
+      }
+      if (read(fds_[i], &counters[i], sizeof(counters[i])) ==
+          sizeof(counters[i])) {
+        any_counter_read = true;
+      }
+    }
+    values->instructions = counters[0];
+    values->cycles = counters[1];
+    values->cache_misses = counters[2];
+    values->stalled_cycles = counters[3];
+    return any_counter_read;
+  }
+
+ private:
+  static constexpr size_t kNumCounters = 4;
+  int fds_[kNumCounters] = {-1, -1, -1, -1};
+};
+
+}  // namespace
+#endif  // __linux__
+
+static bool ReadPerfCounters(PerfCounterValues *values) {
+#if defined(__linux__)
+  static thread_local PerfCounterReader reader;
+  return reader.Read(values);
+#else
+  return false;
+#endif
+}
+
 RecordEvent::RecordEvent(const std::string &name, const EventRole role,
                          const std::string attr) {
 #ifndef _WIN32
@@ -67,12 +169,30 @@ RecordEvent::RecordEvent(const std::string &name, const EventRole role,
   }
 #endif
 #endif
-  if (g_state == ProfilerState::kDisabled || name.empty()) return;
+  if (g_state == ProfilerState::kDisabled || name.empty()) {
+    if (FLAGS_profiler_sample_rate > 0 && !name.empty() &&
+        ++g_sample_counter >= FLAGS_profiler_sample_rate) {
+      // Sampling mode: record every Nth annotation of this thread into the
+      // per-thread sample list. The thread local counter and the block
+      // structure of EventList keep the hot path free of locks, the
+      // timestamps are taken in nanoseconds when the events are constructed.
+      g_sample_counter = 0;
+      is_sampled_ = true;
+      Event *e = GetSampledEventList().Record(EventType::kPushRange, name,
+                                              g_thread_id, role, attr);
+      role_ = role;
+      name_ = e->name();
+    }
+    return;
+  }
 
   // do some initialization
   start_ns_ = PosixInNsec();
   role_ = role;
   is_enabled_ = true;
+  if (FLAGS_profiler_perf_counters) {
+    has_perf_counters_ = ReadPerfCounters(&perf_counters_start_);
+  }
   // lock is not needed, the code below is thread-safe
   // Maybe need the same push/pop behavior.
   Event *e = PushEvent(name, role, attr);
@@ -88,6 +208,11 @@ RecordEvent::~RecordEvent() {
   }
 #endif
 #endif
+  if (is_sampled_) {
+    GetSampledEventList().Record(EventType::kPopRange, name_, g_thread_id,
+                                 role_, "none");
+    return;
+  }
   if (g_state == ProfilerState::kDisabled || !is_enabled_) return;
   // lock is not needed, the code below is thread-safe
   DeviceTracer *tracer = GetDeviceTracer();
@@ -96,7 +221,21 @@ RecordEvent::~RecordEvent() {
                           BlockDepth(), g_thread_id);
   }
   ClearCurAnnotation();
-  PopEvent(name_, role_);
+  Event *e = PopEvent(name_, role_);
+  if (has_perf_counters_) {
+    PerfCounterValues end_values;
+    if (ReadPerfCounters(&end_values)) {
+      PerfCounterValues delta;
+      delta.instructions =
+          end_values.instructions - perf_counters_start_.instructions;
+      delta.cycles = end_values.cycles - perf_counters_start_.cycles;
+      delta.cache_misses =
+          end_values.cache_misses - perf_counters_start_.cache_misses;
+      delta.stalled_cycles =
+          end_values.stalled_cycles - perf_counters_start_.stalled_cycles;
+      e->set_perf_counters(delta);
+    }
+  }
 }
 
 void MemEvenRecorder::PushMemRecord(const void *ptr, const Place &place,
@@ -107,8 +246,22 @@ void MemEvenRecorder::PushMemRecord(const void *ptr, const Place &place,
   PADDLE_ENFORCE_EQ(events.count(ptr), 0,
                     platform::errors::InvalidArgument(
                         "The Place can't exist in the stage of PushMemRecord"));
-  events.emplace(ptr, std::unique_ptr<RecordMemEvent>(
-                          new MemEvenRecorder::RecordMemEvent(place, size)));
+  auto result =
+      events.emplace(ptr, std::unique_ptr<RecordMemEvent>(
+                              new MemEvenRecorder::RecordMemEvent(place, size)));
+
+  const auto &record = *result.first->second;
+  auto &info = peak_info_[place];
+  auto &usage = info.live_by_annotation[record.alloc_in_];
+  usage.bytes += size;
+  usage.count += 1;
+  info.live_bytes += size;
+  if (info.live_bytes > info.peak_bytes) {
+    // new high-water mark, snapshot who owns the live memory right now
+    info.peak_bytes = info.live_bytes;
+    info.peak_time_ns = record.start_ns_;
+    info.peak_by_annotation = info.live_by_annotation;
+  }
 }
 
 void MemEvenRecorder::PopMemRecord(const void *ptr, const Place &place) {
@@ -118,6 +271,16 @@ void MemEvenRecorder::PopMemRecord(const void *ptr, const Place &place) {
   auto iter = events.find(ptr);
   // The ptr maybe not in address_memevent
   if (iter != events.end()) {
+    const auto &record = *iter->second;
+    auto &info = peak_info_[place];
+    auto usage = info.live_by_annotation.find(record.alloc_in_);
+    if (usage != info.live_by_annotation.end()) {
+      usage->second.bytes -= record.bytes_;
+      usage->second.count -= 1;
+      usage->second.freed_count += 1;
+      usage->second.freed_lifetime_ns += PosixInNsec() - record.start_ns_;
+    }
+    info.live_bytes -= record.bytes_;
     events.erase(iter);
   }
 }
@@ -125,6 +288,41 @@ void MemEvenRecorder::PopMemRecord(const void *ptr, const Place &place) {
 void MemEvenRecorder::Flush() {
   std::lock_guard<std::mutex> guard(mtx_);
   address_memevent_.clear();
+  peak_info_.clear();
+}
+
+void MemEvenRecorder::PrintPeakMemoryBreakdown() {
+  std::lock_guard<std::mutex> guard(mtx_);
+  for (auto &item : peak_info_) {
+    auto &info = item.second;
+    if (info.peak_bytes == 0) continue;
+    std::vector<std::pair<std::string, AnnotationUsage>> usages(
+        info.peak_by_annotation.begin(), info.peak_by_annotation.end());
+    std::sort(usages.begin(), usages.end(),
+              [](const std::pair<std::string, AnnotationUsage> &lhs,
+                 const std::pair<std::string, AnnotationUsage> &rhs) {
+                return lhs.second.bytes > rhs.second.bytes;
+              });
+    std::cout << "\n------------------->    Peak Memory Breakdown    "
+                 "<-------------------"
+              << std::endl
+              << "Place: " << item.first
+              << "  Peak: " << info.peak_bytes / 1048576.0 << " MB"
+              << std::endl;
+    for (auto &usage : usages) {
+      if (usage.second.bytes == 0) continue;
+      double mean_lifetime_ms =
+          usage.second.freed_count == 0
+              ? 0.
+              : static_cast<double>(usage.second.freed_lifetime_ns) /
+                    (usage.second.freed_count * 1000000.0);
+      std::cout << "  " << usage.first << ": "
+                << usage.second.bytes / 1048576.0 << " MB in "
+                << usage.second.count
+                << " allocations, mean lifetime of freed allocations "
+                << mean_lifetime_ms << " ms" << std::endl;
+    }
+  }
 }
 
 MemEvenRecorder::RecordMemEvent::RecordMemEvent(const Place &place,
@@ -198,8 +396,10 @@ Event *PushEvent(const std::string &name, const EventRole role,
                                attr);
 }
 
-void PopEvent(const std::string &name, const EventRole role, std::string attr) {
-  GetEventList().Record(EventType::kPopRange, name, g_thread_id, role, attr);
+Event *PopEvent(const std::string &name, const EventRole role,
+                std::string attr) {
+  return GetEventList().Record(EventType::kPopRange, name, g_thread_id, role,
+                               attr);
 }
 void EnableProfiler(ProfilerState state) {
   PADDLE_ENFORCE_NE(state, ProfilerState::kDisabled,
@@ -241,9 +441,31 @@ void ResetProfiler() {
   }
 }
 
+#ifdef PADDLE_WITH_MKLDNN
+static void PrintMKLDNNCacheStatistics() {
+  auto *dev_ctx = dynamic_cast<MKLDNNDeviceContext *>(
+      DeviceContextPool::Instance().Get(CPUPlace()));
+  if (dev_ctx == nullptr) return;
+  uint64_t hits = dev_ctx->GetCacheHitsNumber();
+  uint64_t misses = dev_ctx->GetCacheMissesNumber();
+  if (hits + misses == 0) return;
+  double hit_rate = 100.0 * static_cast<double>(hits) /
+                    static_cast<double>(hits + misses);
+  std::cout << "------------------->    oneDNN cache report    <-------------------"
+            << std::endl
+            << "Lookups: " << hits + misses << "  Hits: " << hits
+            << "  Misses: " << misses << "  Hit rate: " << hit_rate << "%"
+            << std::endl
+            << "Inserts: " << dev_ctx->GetCacheInsertsNumber()
+            << "  Cached objects: " << dev_ctx->GetCachedObjectsNumber()
+            << std::endl;
+}
+#endif
+
 void DisableProfiler(EventSortingKey sorted_key,
                      const std::string &profile_path) {
   SynchronizeAllDevice();
+  MemEvenRecorder::Instance().PrintPeakMemoryBreakdown();
   MemEvenRecorder::Instance().Flush();
 
   std::lock_guard<std::mutex> l(profiler_mu);
@@ -267,6 +489,10 @@ void DisableProfiler(EventSortingKey sorted_key,
   std::vector<std::vector<MemEvent>> all_mem_events = GetMemEvents();
   ParseMemEvents(all_mem_events);
 
+#ifdef PADDLE_WITH_MKLDNN
+  PrintMKLDNNCacheStatistics();
+#endif
+
   ResetProfiler();
   g_state = ProfilerState::kDisabled;
   g_tracer_option = TracerOption::kDefault;
@@ -315,6 +541,16 @@ std::vector<std::vector<Event>> GetAllEvents() {
   return result;
 }
 
+std::vector<std::vector<Event>> GetAllSampledEvents() {
+  std::lock_guard<std::mutex> guard(g_all_sampled_event_lists_mutex);
+  std::vector<std::vector<Event>> result;
+  for (auto it = g_all_sampled_event_lists.begin();
+       it != g_all_sampled_event_lists.end(); ++it) {
+    result.emplace_back((*it)->Reduce());
+  }
+  return result;
+}
+
 bool IsProfileEnabled() { return g_state != ProfilerState::kDisabled; }
 
 bool ShouldSendProfileState() { return should_send_profile_state; }
@@ -85,6 +85,12 @@ struct EventItem {
   double gpu_time;
   float ratio;
   EventRole role;
+  // Hardware counter totals of all calls, only filled when
+  // FLAGS_profiler_perf_counters is set.
+  uint64_t instructions{0};
+  uint64_t cycles{0};
+  uint64_t cache_misses{0};
+  uint64_t stalled_cycles{0};
 };
 
 struct OverHead {
@@ -103,6 +109,10 @@ struct MemEvenRecorder {
   void PushMemRecord(const void* ptr, const Place& place, size_t size);
   void PopMemRecord(const void* ptr, const Place& place);
   void Flush();
+  // Print, for every place, the breakdown of the live allocations observed
+  // at the memory high-water mark, aggregated by the annotation active when
+  // each allocation was made and sorted by size.
+  void PrintPeakMemoryBreakdown();
   static MemEvenRecorder& Instance() { return recorder; }
 
  private:
@@ -118,10 +128,30 @@ struct MemEvenRecorder {
     std::string free_in_;
   };
 
+  // Per-annotation share of the live allocations of one place, plus the
+  // statistics of the allocations already freed for mean lifetimes.
+  struct AnnotationUsage {
+    size_t bytes{0};
+    size_t count{0};
+    size_t freed_count{0};
+    uint64_t freed_lifetime_ns{0};
+  };
+
+  // Live/peak accounting of one place, updated on every push/pop.
+  struct PeakInfo {
+    size_t live_bytes{0};
+    size_t peak_bytes{0};
+    uint64_t peak_time_ns{0};
+    std::map<std::string, AnnotationUsage> live_by_annotation;
+    // copy of live_by_annotation taken at the high-water mark
+    std::map<std::string, AnnotationUsage> peak_by_annotation;
+  };
+
   static MemEvenRecorder recorder;
   std::map<Place,
            std::unordered_map<const void*, std::unique_ptr<RecordMemEvent>>>
       address_memevent_;
+  std::map<Place, PeakInfo> peak_info_;
   std::mutex mtx_;
   MemEvenRecorder() {}
   DISABLE_COPY_AND_ASSIGN(MemEvenRecorder);
@@ -136,6 +166,9 @@ struct RecordEvent {
 
   bool is_enabled_{false};
   bool is_pushed_{false};
+  // whether this invocation was picked by the sampling mode, see
+  // FLAGS_profiler_sample_rate
+  bool is_sampled_{false};
   uint64_t start_ns_;
   // Event name
   std::string name_;
@@ -143,6 +176,10 @@ struct RecordEvent {
   // different kernel invocations within an op.
   std::string full_name_;
   EventRole role_{EventRole::kOrdinary};
+  // Counter readings taken at construction when FLAGS_profiler_perf_counters
+  // is set, the deltas are attached to the matching pop event.
+  bool has_perf_counters_{false};
+  PerfCounterValues perf_counters_start_;
 };
 
 class RecordRPCEvent {
@@ -206,12 +243,17 @@ void PopMemEvent(uint64_t start_ns, uint64_t end_ns, size_t bytes,
                  const Place& place, const std::string& annotation);
 Event* PushEvent(const std::string& name, const EventRole role,
                  const std::string attr = "none");
-void PopEvent(const std::string& name, const EventRole role,
-              const std::string attr = "none");
+Event* PopEvent(const std::string& name, const EventRole role,
+                const std::string attr = "none");
 // Return the event list of all threads. Assumed the returned value calls
 // event_lists, event_lists[i][j] represents the j-th Event of i-th thread.
 std::vector<std::vector<Event>> GetAllEvents();
 
+// Drain the events collected by the sampling mode of all threads. Each call
+// returns the samples recorded since the previous one, so op-level latency
+// distributions can be exported continuously while training keeps running.
+std::vector<std::vector<Event>> GetAllSampledEvents();
+
 // Enable the profiling function.
 void EnableProfiler(ProfilerState state);
 // Clear the g_all_event_lists, which is total event lists of all threads.
@@ -35,6 +35,10 @@ limitations under the License. */
 #include <hip/hip_runtime.h>
 #endif
 
+#include "gflags/gflags.h"
+
+DECLARE_bool(profiler_perf_counters);
+
 namespace paddle {
 namespace platform {
 
@@ -64,6 +68,12 @@ static std::list<std::shared_ptr<EventList<MemEvent>>> g_all_mem_event_lists;
 static thread_local std::shared_ptr<EventList<MemEvent>> g_mem_event_list;
 static std::mutex g_all_mem_event_lists_mutex;
 static thread_local int32_t g_mem_thread_id;
+// The sampled event lists of all threads, used by the always-on sampling mode
+static std::mutex g_all_sampled_event_lists_mutex;
+static std::list<std::shared_ptr<EventList<Event>>> g_all_sampled_event_lists;
+static thread_local std::shared_ptr<EventList<Event>> g_sampled_event_list;
+// Counts the RecordEvent invocations of this thread since the last sample
+static thread_local int64_t g_sample_counter = 0;
 static uint32_t g_mem_next_thread_id = 0;
 
 static int FindNthReversePos(const std::string &s, const char ch, const int N) {
@@ -98,6 +108,17 @@ inline EventList<Event> &GetEventList() {
   return *g_event_list;
 }
 
+inline EventList<Event> &GetSampledEventList() {
+  if (!g_sampled_event_list) {
+    // make sure this thread has got its id before the first sample
+    GetEventList();
+    std::lock_guard<std::mutex> guard(g_all_sampled_event_lists_mutex);
+    g_sampled_event_list = std::make_shared<EventList<Event>>();
+    g_all_sampled_event_lists.emplace_front(g_sampled_event_list);
+  }
+  return *g_sampled_event_list;
+}
+
 inline EventList<MemEvent> &GetMemEventList() {
   if (!g_mem_event_list) {
     g_mem_event_list = std::make_shared<EventList<MemEvent>>();
@@ -369,11 +390,17 @@ void SetEvent(bool merge_thread, const Event &analyze_event,
       }
       *max_name_width = std::max(*max_name_width, print_name_size);
 
+      // The perf counter deltas of the scope are attached to the pop event.
+      const PerfCounterValues &counters = analyze_event.perf_counters();
       if (event_idx->find(event_name) == event_idx->end()) {
         event_idx->insert({event_name, event_items->size()});
         EventItem event_item = {event_name, 1,          event_time, event_time,
                                 event_time, event_time, cpu_time,   gpu_time,
                                 0.,         rit->role()};
+        event_item.instructions = counters.instructions;
+        event_item.cycles = counters.cycles;
+        event_item.cache_misses = counters.cache_misses;
+        event_item.stalled_cycles = counters.stalled_cycles;
         event_items->push_back(event_item);
       } else {
         int index = event_idx->at(event_name);
@@ -388,6 +415,10 @@ void SetEvent(bool merge_thread, const Event &analyze_event,
             std::max(event_time, event_items->at(index).max_time);
         event_items->at(index).gpu_time += gpu_time;
         event_items->at(index).cpu_time += cpu_time;
+        event_items->at(index).instructions += counters.instructions;
+        event_items->at(index).cycles += counters.cycles;
+        event_items->at(index).cache_misses += counters.cache_misses;
+        event_items->at(index).stalled_cycles += counters.stalled_cycles;
       }
 
       // remove the push marker from the list
@@ -610,7 +641,12 @@ void PrintProfiler(
     }
     std::cout << std::setw(data_width) << "Min." << std::setw(data_width)
               << "Max." << std::setw(data_width) << "Ave."
-              << std::setw(data_width) << "Ratio." << std::endl;
+              << std::setw(data_width) << "Ratio.";
+    if (FLAGS_profiler_perf_counters) {
+      std::cout << std::setw(data_width) << "IPC" << std::setw(data_width * 2)
+                << "LLC miss/Kinst" << std::setw(data_width) << "Stall rate";
+    }
+    std::cout << std::endl;
   }
 
   if (events_table.size() <= 0) return;
@@ -668,6 +704,24 @@ void PrintProfiler(
       } else {
         std::cout << std::setw(data_width) << event_item.ratio;
       }
+      if (FLAGS_profiler_perf_counters) {
+        double ipc = event_item.cycles > 0
+                         ? static_cast<double>(event_item.instructions) /
+                               event_item.cycles
+                         : 0.0;
+        double misses_per_kinst =
+            event_item.instructions > 0
+                ? 1000.0 * event_item.cache_misses / event_item.instructions
+                : 0.0;
+        double stall_rate =
+            event_item.cycles > 0
+                ? static_cast<double>(event_item.stalled_cycles) /
+                      event_item.cycles
+                : 0.0;
+        std::cout << std::setw(data_width) << ipc
+                  << std::setw(data_width * 2) << misses_per_kinst
+                  << std::setw(data_width) << stall_rate;
+      }
       std::cout << std::endl;
 
       PrintProfiler(child_table, child_map, sorted_func, sorted_by, overhead,
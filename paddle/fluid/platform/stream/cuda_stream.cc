@@ -52,11 +52,31 @@ bool CUDAStream::Init(const Place& place, const Priority& priority,
   return true;
 }
 
+#ifdef PADDLE_WITH_HIP
+void CUDAStream::SetStream(hipStream_t stream) {
+#else
+void CUDAStream::SetStream(cudaStream_t stream) {
+#endif
+  if (owned_stream_ && stream_) {
+    Wait();
+    WaitCallback();
+#ifdef PADDLE_WITH_HIP
+    PADDLE_ENFORCE_CUDA_SUCCESS(hipStreamDestroy(stream_));
+#else
+    PADDLE_ENFORCE_CUDA_SUCCESS(cudaStreamDestroy(stream_));
+#endif
+  }
+  owned_stream_ = false;
+  stream_ = stream;
+  callback_manager_.reset(new StreamCallbackManager<gpuStream_t>(stream_));
+  VLOG(3) << "GPUStream binds external stream: " << stream_;
+}
+
 void CUDAStream::Destroy() {
   CUDADeviceGuard guard(BOOST_GET_CONST(CUDAPlace, place_).device);
   Wait();
   WaitCallback();
-  if (stream_) {
+  if (owned_stream_ && stream_) {
 #ifdef PADDLE_WITH_HIP
     PADDLE_ENFORCE_CUDA_SUCCESS(hipStreamDestroy(stream_));
 #else
@@ -101,6 +101,16 @@ class CUDAStream final {
 #else
   const cudaStream_t& raw_stream() const { return stream_; }
 #endif
+
+  // Adopt an externally owned raw stream: the previously owned stream (if
+  // any) is destroyed, later work is issued on the given stream, and
+  // Destroy() leaves it alone since its lifetime belongs to the caller.
+#ifdef PADDLE_WITH_HIP
+  void SetStream(hipStream_t stream);
+#else
+  void SetStream(cudaStream_t stream);
+#endif
+
   void Destroy();
 
   bool Query() const {
@@ -138,6 +148,7 @@ class CUDAStream final {
 
  private:
   Place place_;
+  bool owned_stream_{true};
 #ifdef PADDLE_WITH_HIP
   hipStream_t stream_{nullptr};
 #else
@@ -15,12 +15,14 @@
 #include "paddle/fluid/pybind/bind_cost_model.h"
 
 #include <pybind11/stl.h>
+#include <memory>
 #include "paddle/fluid/framework/ir/cost_model.h"
 #include "paddle/fluid/framework/program_desc.h"
 
 namespace py = pybind11;
 using paddle::framework::CostData;
 using paddle::framework::CostModel;
+using paddle::framework::OpCostDatabase;
 using paddle::framework::ProgramDesc;
 
 namespace paddle {
@@ -49,7 +51,24 @@ void BindCostModel(py::module* m) {
              return self.ProfileMeasure(*main_program_desc,
                                         *startup_program_desc, device,
                                         fetch_cost_list);
+           })
+      .def("predict_profile",
+           [](CostModel& self, py::object py_main_program,
+              const std::string& device) {
+             py::object py_main_program_desc = py_main_program.attr("desc");
+             ProgramDesc* main_program_desc =
+                 py_main_program_desc.cast<ProgramDesc*>();
+             return self.PredictProfile(*main_program_desc, device);
            });
+
+  py::class_<OpCostDatabase, std::unique_ptr<OpCostDatabase, py::nodelete>>(
+      *m, "OpCostDatabase")
+      .def_static("instance", &OpCostDatabase::Instance,
+                  py::return_value_policy::reference)
+      .def("save", &OpCostDatabase::Save)
+      .def("load", &OpCostDatabase::Load)
+      .def("size", &OpCostDatabase::Size)
+      .def("clear", &OpCostDatabase::Clear);
 }
 
 }  // namespace pybind
@@ -294,6 +294,10 @@ void BindDataset(py::module *m) {
            py::call_guard<py::gil_scoped_release>())
       .def("set_preload_thread_num", &framework::Dataset::SetPreLoadThreadNum,
            py::call_guard<py::gil_scoped_release>())
+      .def("set_preload_double_buffer",
+           &framework::Dataset::SetPreLoadDoubleBuffer, py::arg("enable"),
+           py::arg("budget_ins") = 0,
+           py::call_guard<py::gil_scoped_release>())
       .def("create_preload_readers", &framework::Dataset::CreatePreLoadReaders,
            py::call_guard<py::gil_scoped_release>())
       .def("destroy_preload_readers",
@@ -308,9 +312,23 @@ void BindDataset(py::module *m) {
       .def("set_fleet_send_sleep_seconds",
            &framework::Dataset::SetFleetSendSleepSeconds,
            py::call_guard<py::gil_scoped_release>())
+      .def("set_shuffle_spill", &framework::Dataset::SetShuffleSpill,
+           py::call_guard<py::gil_scoped_release>())
       .def("enable_pv_merge", &framework::Dataset::EnablePvMerge,
            py::call_guard<py::gil_scoped_release>());
 
+  m->def("convert_multi_slot_text_to_instant_binary",
+         [](const std::string &text_filename,
+            const std::string &binary_filename,
+            const std::string &data_feed_desc_str) {
+           framework::DataFeedDesc data_feed_desc;
+           google::protobuf::TextFormat::ParseFromString(data_feed_desc_str,
+                                                         &data_feed_desc);
+           return framework::ConvertMultiSlotTextToInstantBinary(
+               text_filename, binary_filename, data_feed_desc);
+         },
+         py::call_guard<py::gil_scoped_release>());
+
   py::class_<IterableDatasetWrapper>(*m, "IterableDatasetWrapper")
       .def(py::init<framework::Dataset *, const std::vector<std::string> &,
                     const std::vector<platform::Place> &, size_t, bool>())
@@ -24,10 +24,19 @@
 
 #include "gflags/gflags.h"
 #include "paddle/fluid/framework/python_headers.h"
+#include "paddle/fluid/memory/allocation/allocator_facade.h"
 #include "paddle/fluid/platform/enforce.h"
 #include "paddle/fluid/platform/errors.h"
 #include "paddle/fluid/platform/macros.h"
+#include "paddle/fluid/platform/op_latency_stats.h"
+#include "paddle/fluid/platform/place.h"
 #include "pybind11/stl.h"
+#ifdef PADDLE_WITH_MKLDNN
+#include "paddle/fluid/platform/device_context.h"
+#endif
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+#include "paddle/fluid/platform/gpu_info.h"
+#endif
 
 // FIXME(zengjinle): these 2 flags may be removed by the linker when compiling
 // CPU-only Paddle. It is because they are only used in
@@ -247,6 +256,90 @@ static void RegisterGlobalVarGetterSetter() {
                                         value_ptr);
     boost::apply_visitor(visitor, default_value);
   }
+
+  auto *instance = GlobalVarGetterSetterRegistry::MutableInstance();
+
+#ifdef PADDLE_WITH_MKLDNN
+  // Read-only oneDNN primitive cache statistics, queried e.g. with
+  // paddle.fluid.core.globals().get("STATS_mkldnn_cache_hits"). Getters are
+  // evaluated lazily, after the device context pool has been initialized.
+  auto mkldnn_dev_ctx = []() -> const platform::MKLDNNDeviceContext * {
+    return dynamic_cast<platform::MKLDNNDeviceContext *>(
+        platform::DeviceContextPool::Instance().Get(platform::CPUPlace()));
+  };
+  instance->Register("STATS_mkldnn_cache_hits", /*is_public=*/false,
+                     [mkldnn_dev_ctx]() -> py::object {
+                       return py::cast(mkldnn_dev_ctx()->GetCacheHitsNumber());
+                     });
+  instance->Register("STATS_mkldnn_cache_misses", /*is_public=*/false,
+                     [mkldnn_dev_ctx]() -> py::object {
+                       return py::cast(
+                           mkldnn_dev_ctx()->GetCacheMissesNumber());
+                     });
+  instance->Register("STATS_mkldnn_cache_inserts", /*is_public=*/false,
+                     [mkldnn_dev_ctx]() -> py::object {
+                       return py::cast(
+                           mkldnn_dev_ctx()->GetCacheInsertsNumber());
+                     });
+  instance->Register("STATS_mkldnn_cache_entries", /*is_public=*/false,
+                     [mkldnn_dev_ctx]() -> py::object {
+                       return py::cast(
+                           mkldnn_dev_ctx()->GetCachedObjectsNumber());
+                     });
+#endif
+
+  // Read-only telemetry of the auto_growth allocators, one entry per place
+  // ("cpu", "gpu:0", ...), queried with
+  // paddle.fluid.core.globals().get("STATS_allocator_telemetry"). All fields
+  // are zero or empty for places that do not use the auto_growth strategy.
+  auto allocator_telemetry = [](const platform::Place &place) -> py::dict {
+    auto &facade = memory::allocation::AllocatorFacade::Instance();
+    auto stats = facade.GetStats(place);
+    py::dict d;
+    d["current_usage"] = stats.current_usage;
+    d["peak_usage"] = stats.peak_usage;
+    d["chunk_count"] = stats.chunk_count;
+    d["chunk_bytes"] = stats.chunk_bytes;
+    d["free_block_count"] = stats.free_block_count;
+    d["free_block_bytes"] = stats.free_block_bytes;
+    d["free_block_histogram"] = stats.free_block_histogram;
+    d["growth_count"] = stats.growth_count;
+    d["retry_count"] = stats.retry_count;
+    d["events"] = facade.GetAllocEventLog(place);
+    return d;
+  };
+  instance->Register(
+      "STATS_allocator_telemetry", /*is_public=*/false,
+      [allocator_telemetry]() -> py::object {
+        py::dict result;
+        result["cpu"] = allocator_telemetry(platform::CPUPlace());
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+        for (int dev_id : platform::GetSelectedDevices()) {
+          result[py::str("gpu:" + std::to_string(dev_id))] =
+              allocator_telemetry(platform::CUDAPlace(dev_id));
+        }
+#endif
+        return std::move(result);
+      });
+
+  // Read-only per-op-type latency histograms recorded by OperatorBase::Run
+  // when FLAGS_op_latency_stats is set, queried with
+  // paddle.fluid.core.globals().get("STATS_op_latency"). Bucket i of each
+  // histogram counts the runs whose wall-clock time was in [2^i, 2^(i+1))
+  // nanoseconds, ready for a Prometheus-style quantile export.
+  instance->Register(
+      "STATS_op_latency", /*is_public=*/false, []() -> py::object {
+        py::dict result;
+        for (const auto &snapshot :
+             platform::OpLatencyRegistry::Instance().GetSnapshots()) {
+          py::dict d;
+          d["count"] = snapshot.count;
+          d["total_ns"] = snapshot.total_ns;
+          d["buckets"] = snapshot.buckets;
+          result[py::str(snapshot.op_type)] = d;
+        }
+        return std::move(result);
+      });
 }
 
 }  // namespace pybind
@@ -38,6 +38,8 @@ void BindGlooWrapper(py::module* m) {
       .def("size", &framework::GlooWrapper::Size)
       .def("barrier", &framework::GlooWrapper::Barrier)
       .def("set_timeout_seconds", &framework::GlooWrapper::SetTimeoutSeconds)
+      .def("set_allreduce_chunk_elements",
+           &framework::GlooWrapper::SetAllReduceChunkElements)
       .def("set_rank", &framework::GlooWrapper::SetRank)
       .def("set_size", &framework::GlooWrapper::SetSize)
       .def("set_iface", &framework::GlooWrapper::SetIface)
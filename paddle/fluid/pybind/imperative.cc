@@ -1964,6 +1964,40 @@ void BindImperative(py::module *m_ptr) {
                     &imperative::Tracer::SetAmpLevel)
       .def_property("_has_grad", &imperative::Tracer::HasGrad,
                     &imperative::Tracer::SetHasGrad)
+      .def("_begin_recompute_segment",
+           &imperative::Tracer::BeginRecomputeSegment)
+      .def("_end_recompute_segment", &imperative::Tracer::EndRecomputeSegment,
+           py::arg("outputs"))
+      .def("_enable_hot_loop_capture",
+           &imperative::Tracer::EnableHotLoopCapture,
+           py::arg("capture_threshold") = 3)
+      .def("_disable_hot_loop_capture",
+           &imperative::Tracer::DisableHotLoopCapture)
+      .def("_mark_loop_iteration_end",
+           &imperative::Tracer::MarkLoopIterationEnd)
+      .def("_is_hot_loop_ready",
+           [](imperative::Tracer &self) {
+             auto *capturer = self.GetHotLoopCapturer();
+             return capturer != nullptr && capturer->IsReady();
+           })
+      .def("_hot_loop_feed_names",
+           [](imperative::Tracer &self) {
+             auto *capturer = self.GetHotLoopCapturer();
+             PADDLE_ENFORCE_NOT_NULL(
+                 capturer, platform::errors::PreconditionNotMet(
+                               "Hot loop capture is not enabled."));
+             return capturer->FeedVarNames();
+           })
+      .def("_replay_hot_loop",
+           [](imperative::Tracer &self,
+              const std::vector<std::shared_ptr<imperative::VarBase>> &feeds) {
+             auto *capturer = self.GetHotLoopCapturer();
+             PADDLE_ENFORCE_NOT_NULL(
+                 capturer, platform::errors::PreconditionNotMet(
+                               "Hot loop capture is not enabled."));
+             return capturer->Replay(feeds);
+           },
+           py::arg("feeds"))
       .def_property(
           "_expected_place",
           [](const imperative::Tracer &self) -> py::object {
@@ -2180,7 +2214,9 @@ void BindImperative(py::module *m_ptr) {
                     std::shared_ptr<imperative::ParallelContext>,
                     const std::vector<size_t> &, bool>())
       .def("prepare_for_backward", &imperative::Reducer::PrepareForBackward,
-           py::arg("vars"), py::call_guard<py::gil_scoped_release>());
+           py::arg("vars"), py::call_guard<py::gil_scoped_release>())
+      .def("_set_comm_hook", &imperative::Reducer::SetCommHook,
+           py::arg("hook_type"));
 
   m.def("assign_group_by_size", &imperative::AssignGroupBySize, py::arg("vars"),
         py::arg("is_sparse_gradient"),
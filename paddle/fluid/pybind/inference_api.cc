@@ -32,6 +32,9 @@
 #include "paddle/fluid/inference/api/paddle_inference_api.h"
 #include "paddle/fluid/inference/api/paddle_pass_builder.h"
 #include "paddle/fluid/inference/utils/io_utils.h"
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+#include "paddle/fluid/platform/stream/cuda_stream.h"
+#endif
 
 namespace py = pybind11;
 
@@ -181,8 +184,12 @@ void ZeroCopyTensorCreate(
     py::array_t<T, py::array::c_style | py::array::forcecast> data) {
   std::vector<int> shape;
   std::copy_n(data.shape(), data.ndim(), std::back_inserter(shape));
+  const T *data_ptr = static_cast<const T *>(data.data());
+  // The reshape and the host-to-device copy do not touch Python objects;
+  // release the GIL so other serving threads can prepare their requests.
+  py::gil_scoped_release release;
   tensor.Reshape(std::move(shape));
-  tensor.copy_from_cpu(static_cast<const T *>(data.data()));
+  tensor.copy_from_cpu(data_ptr);
 }
 
 /// \brief Experimental interface.
@@ -193,6 +200,7 @@ void ZeroCopyTensorCreate(
 void ZeroCopyStringTensorCreate(ZeroCopyTensor &tensor,  // NOLINT
                                 const paddle_infer::Strings *data) {
   size_t shape = data->size();
+  py::gil_scoped_release release;
   tensor.ReshapeStrings(shape);
   tensor.copy_strings_from_cpu(data);
 }
@@ -203,8 +211,10 @@ void PaddleInferTensorCreate(
     py::array_t<T, py::array::c_style | py::array::forcecast> data) {
   std::vector<int> shape;
   std::copy_n(data.shape(), data.ndim(), std::back_inserter(shape));
+  const T *data_ptr = static_cast<const T *>(data.data());
+  py::gil_scoped_release release;
   tensor.Reshape(std::move(shape));
-  tensor.CopyFromCpu(static_cast<const T *>(data.data()));
+  tensor.CopyFromCpu(data_ptr);
 }
 
 /// \brief Experimental interface.
@@ -216,6 +226,7 @@ void PaddleInferStringTensorCreate(paddle_infer::Tensor &tensor,  // NOLINT
                                    const paddle_infer::Strings *data) {
   VLOG(3) << "Create PaddleInferTensor, dtype = Strings ";
   size_t shape = data->size();
+  py::gil_scoped_release release;
   tensor.ReshapeStrings(shape);
   tensor.CopyStringsFromCpu(data);
 }
@@ -246,25 +257,30 @@ py::array ZeroCopyTensorToNumpy(ZeroCopyTensor &tensor) {  // NOLINT
   py::array::ShapeContainer shape(tensor_shape.begin(), tensor_shape.end());
   py::array array(dt, std::move(shape));
 
+  // The device-to-host copy works on the raw numpy buffer only; release the
+  // GIL for its duration.
+  void *array_data = array.mutable_data();
+  py::gil_scoped_release release;
+
   switch (tensor.type()) {
     case PaddleDType::INT32:
-      tensor.copy_to_cpu(static_cast<int32_t *>(array.mutable_data()));
+      tensor.copy_to_cpu(static_cast<int32_t *>(array_data));
       break;
     case PaddleDType::INT64:
-      tensor.copy_to_cpu(static_cast<int64_t *>(array.mutable_data()));
+      tensor.copy_to_cpu(static_cast<int64_t *>(array_data));
       break;
     case PaddleDType::FLOAT32:
-      tensor.copy_to_cpu<float>(static_cast<float *>(array.mutable_data()));
+      tensor.copy_to_cpu<float>(static_cast<float *>(array_data));
       break;
     case PaddleDType::FLOAT16:
       tensor.copy_to_cpu<paddle::platform::float16>(
-          static_cast<paddle::platform::float16 *>(array.mutable_data()));
+          static_cast<paddle::platform::float16 *>(array_data));
       break;
     case PaddleDType::UINT8:
-      tensor.copy_to_cpu<uint8_t>(static_cast<uint8_t *>(array.mutable_data()));
+      tensor.copy_to_cpu<uint8_t>(static_cast<uint8_t *>(array_data));
       break;
     case PaddleDType::INT8:
-      tensor.copy_to_cpu<int8_t>(static_cast<int8_t *>(array.mutable_data()));
+      tensor.copy_to_cpu<int8_t>(static_cast<int8_t *>(array_data));
       break;
     default:
       PADDLE_THROW(platform::errors::Unimplemented(
@@ -280,25 +296,28 @@ py::array PaddleInferTensorToNumpy(paddle_infer::Tensor &tensor) {  // NOLINT
   py::array::ShapeContainer shape(tensor_shape.begin(), tensor_shape.end());
   py::array array(dt, std::move(shape));
 
+  void *array_data = array.mutable_data();
+  py::gil_scoped_release release;
+
   switch (tensor.type()) {
     case PaddleDType::INT32:
-      tensor.CopyToCpu(static_cast<int32_t *>(array.mutable_data()));
+      tensor.CopyToCpu(static_cast<int32_t *>(array_data));
       break;
     case PaddleDType::INT64:
-      tensor.CopyToCpu(static_cast<int64_t *>(array.mutable_data()));
+      tensor.CopyToCpu(static_cast<int64_t *>(array_data));
       break;
     case PaddleDType::FLOAT32:
-      tensor.CopyToCpu<float>(static_cast<float *>(array.mutable_data()));
+      tensor.CopyToCpu<float>(static_cast<float *>(array_data));
       break;
     case PaddleDType::FLOAT16:
       tensor.CopyToCpu<paddle::platform::float16>(
-          static_cast<paddle::platform::float16 *>(array.mutable_data()));
+          static_cast<paddle::platform::float16 *>(array_data));
       break;
     case PaddleDType::UINT8:
-      tensor.CopyToCpu(static_cast<uint8_t *>(array.mutable_data()));
+      tensor.CopyToCpu(static_cast<uint8_t *>(array_data));
       break;
     case PaddleDType::INT8:
-      tensor.CopyToCpu(static_cast<int8_t *>(array.mutable_data()));
+      tensor.CopyToCpu(static_cast<int8_t *>(array_data));
       break;
     default:
       PADDLE_THROW(platform::errors::Unimplemented(
@@ -469,12 +488,14 @@ void BindPaddlePredictor(py::module *m) {
              std::vector<PaddleTensor> outputs;
              self.Run(inputs, &outputs);
              return outputs;
-           })
+           },
+           py::call_guard<py::gil_scoped_release>())
       .def("get_input_tensor", &PaddlePredictor::GetInputTensor)
       .def("get_output_tensor", &PaddlePredictor::GetOutputTensor)
       .def("get_input_names", &PaddlePredictor::GetInputNames)
       .def("get_output_names", &PaddlePredictor::GetOutputNames)
-      .def("zero_copy_run", &PaddlePredictor::ZeroCopyRun)
+      .def("zero_copy_run", &PaddlePredictor::ZeroCopyRun,
+           py::call_guard<py::gil_scoped_release>())
       .def("clone", &PaddlePredictor::Clone)
       .def("get_serialized_program", &PaddlePredictor::GetSerializedProgram);
 
@@ -512,10 +533,12 @@ void BindNativePredictor(py::module *m) {
              std::vector<PaddleTensor> outputs;
              self.Run(inputs, &outputs);
              return outputs;
-           })
+           },
+           py::call_guard<py::gil_scoped_release>())
       .def("get_input_tensor", &NativePaddlePredictor::GetInputTensor)
       .def("get_output_tensor", &NativePaddlePredictor::GetOutputTensor)
-      .def("zero_copy_run", &NativePaddlePredictor::ZeroCopyRun)
+      .def("zero_copy_run", &NativePaddlePredictor::ZeroCopyRun,
+           py::call_guard<py::gil_scoped_release>())
       .def("clone", &NativePaddlePredictor::Clone)
       .def("scope", &NativePaddlePredictor::scope,
            py::return_value_policy::reference);
@@ -556,6 +579,15 @@ void BindAnalysisConfig(py::module *m) {
            py::arg("device_id") = 0)
       .def("enable_npu", &AnalysisConfig::EnableNpu, py::arg("device_id") = 0)
       .def("disable_gpu", &AnalysisConfig::DisableGpu)
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+      .def("set_exec_stream",
+           [](AnalysisConfig &self, platform::stream::CUDAStream &stream) {
+             self.SetExecStream(
+                 reinterpret_cast<void *>(stream.raw_stream()));
+           },
+           py::arg("stream"))
+#endif
+      .def("external_stream_enabled", &AnalysisConfig::external_stream_enabled)
       .def("use_gpu", &AnalysisConfig::use_gpu)
       .def("use_xpu", &AnalysisConfig::use_xpu)
       .def("use_npu", &AnalysisConfig::use_npu)
@@ -605,6 +637,12 @@ void BindAnalysisConfig(py::module *m) {
       .def("shape_range_info_path", &AnalysisConfig::shape_range_info_path)
       .def("shape_range_info_collected",
            &AnalysisConfig::shape_range_info_collected)
+      .def("enable_shape_range_monitoring",
+           &AnalysisConfig::EnableShapeRangeMonitoring,
+           py::arg("shape_range_info_path"),
+           py::arg("flush_interval_runs") = 1024)
+      .def("shape_range_monitoring_enabled",
+           &AnalysisConfig::shape_range_monitoring_enabled)
       .def("enable_tuned_tensorrt_dynamic_shape",
            &AnalysisConfig::EnableTunedTensorRtDynamicShape)
       .def("tuned_tensorrt_dynamic_shape",
@@ -707,13 +745,15 @@ void BindAnalysisPredictor(py::module *m) {
             std::vector<PaddleTensor> outputs;
             self.Run(inputs, &outputs);
             return outputs;
-          })
+          },
+          py::call_guard<py::gil_scoped_release>())
       .def("get_input_tensor", &AnalysisPredictor::GetInputTensor)
       .def("get_output_tensor", &AnalysisPredictor::GetOutputTensor)
       .def("get_input_names", &AnalysisPredictor::GetInputNames)
       .def("get_output_names", &AnalysisPredictor::GetOutputNames)
       .def("get_input_tensor_shape", &AnalysisPredictor::GetInputTensorShape)
-      .def("zero_copy_run", &AnalysisPredictor::ZeroCopyRun)
+      .def("zero_copy_run", &AnalysisPredictor::ZeroCopyRun,
+           py::call_guard<py::gil_scoped_release>())
       .def("clear_intermediate_tensor",
            &AnalysisPredictor::ClearIntermediateTensor)
       .def("try_shrink_memory", &AnalysisPredictor::TryShrinkMemory)
@@ -742,7 +782,8 @@ void BindPaddleInferPredictor(py::module *m) {
       .def("get_output_names", &paddle_infer::Predictor::GetOutputNames)
       .def("get_input_handle", &paddle_infer::Predictor::GetInputHandle)
       .def("get_output_handle", &paddle_infer::Predictor::GetOutputHandle)
-      .def("run", &paddle_infer::Predictor::Run)
+      .def("run", &paddle_infer::Predictor::Run,
+           py::call_guard<py::gil_scoped_release>())
       .def("clone", &paddle_infer::Predictor::Clone)
       .def("try_shrink_memory", &paddle_infer::Predictor::TryShrinkMemory)
       .def("clear_intermediate_tensor",
@@ -32,6 +32,31 @@
 #include "paddle/fluid/pybind/imperative.h"
 
 namespace py = pybind11;
+
+// The auto-generated op functions use the METH_FASTCALL calling
+// convention on CPython >= 3.7, which hands the positional arguments
+// over as a plain C array and skips building an argument tuple per
+// call. Older interpreters fall back to METH_VARARGS and view the
+// tuple's item array in place, so the generated bodies and the arg
+// parsing helpers below only ever see `PyObject *const *args` plus an
+// explicit argument count.
+#if PY_VERSION_HEX >= 0x03070000
+#define PD_DYGRAPH_FUNCTION_PARAMS \
+  PyObject *self, PyObject *const *args, Py_ssize_t nargs
+#define PD_DYGRAPH_FUNCTION_UNPACK_ARGS() (void)self
+#define PD_DYGRAPH_FUNCTION_METH METH_FASTCALL
+#else
+#define PD_DYGRAPH_FUNCTION_PARAMS \
+  PyObject *self, PyObject *args_tuple, PyObject *kwargs
+#define PD_DYGRAPH_FUNCTION_UNPACK_ARGS()                      \
+  (void)self;                                                  \
+  (void)kwargs;                                                \
+  PyObject *const *args =                                      \
+      &((PyTupleObject *)args_tuple)->ob_item[0]; /* NOLINT */ \
+  Py_ssize_t nargs = PyTuple_GET_SIZE(args_tuple)
+#define PD_DYGRAPH_FUNCTION_METH (METH_VARARGS | METH_KEYWORDS)
+#endif
+
 namespace paddle {
 namespace pybind {
 
@@ -714,20 +739,41 @@ static inline void CastPyArg2AttrBlock(
 }
 
 static inline void ConstructAttrMapFromPyArgs(
-    const std::string& op_type, PyObject* args, ssize_t attr_start,
+    const std::string& op_type, PyObject* const* args, ssize_t attr_start,
     ssize_t attr_end, paddle::framework::AttributeMap& attrs) {  // NOLINT
   PADDLE_ENFORCE_EQ(
       (attr_end - attr_start) % 2, 0,
       platform::errors::InvalidArgument(
           "The number of arguments for attributes should be even."));
 
-  auto attr_type_map = &(OpAttrTypeMap::Instance().Map()[op_type]);
+  // Filled lazily per op type: looking the op up in OpInfoMap materializes
+  // its deferred proto, so only the ops a process actually runs pay for
+  // their attribute metadata. The GIL is held here, no extra locking is
+  // needed around the map.
+  auto& attrtype_map = OpAttrTypeMap::Instance().Map();
+  auto map_it = attrtype_map.find(op_type);
+  if (map_it == attrtype_map.end()) {
+    map_it =
+        attrtype_map
+            .emplace(op_type, std::unordered_map<
+                                  std::string,
+                                  paddle::framework::proto::AttrType>())
+            .first;
+    auto* op_info =
+        paddle::framework::OpInfoMap::Instance().GetNullable(op_type);
+    if (op_info != nullptr && op_info->HasOpProtoAndChecker()) {
+      for (auto& attr : op_info->Proto().attrs()) {
+        map_it->second[attr.name()] = attr.type();
+      }
+    }
+  }
+  auto attr_type_map = &map_it->second;
 
   PyObject* obj = nullptr;
   for (ssize_t arg_pos = attr_start; arg_pos < attr_end; arg_pos += 2) {
     Py_ssize_t key_len;
     const char* key_ptr;
-    obj = PyTuple_GET_ITEM(args, arg_pos);
+    obj = args[arg_pos];
     if (PyObject_CheckString(obj)) {
       key_ptr = PyUnicode_AsUTF8AndSize(obj, &key_len);
     } else {
@@ -743,7 +789,7 @@ static inline void ConstructAttrMapFromPyArgs(
       continue;
     }
 
-    obj = PyTuple_GET_ITEM(args, arg_pos + 1);
+    obj = args[arg_pos + 1];
 
     switch (iter->second) {
       case paddle::framework::proto::AttrType::INT:
@@ -789,12 +835,14 @@ static inline void ConstructAttrMapFromPyArgs(
 }
 
 static inline std::shared_ptr<imperative::VarBase> GetVarBaseFromArgs(
-    const std::string& op_type, const std::string& arg_name, PyObject* args,
-    ssize_t arg_idx, bool dispensable = false) {
+    const std::string& op_type, const std::string& arg_name,
+    PyObject* const* args, ssize_t args_num, ssize_t arg_idx,
+    bool dispensable = false) {
   ::pybind11::detail::instance* inst =
-      (::pybind11::detail::instance*)PyTuple_GET_ITEM(args, arg_idx);
+      arg_idx < args_num ? (::pybind11::detail::instance*)args[arg_idx]
+                         : nullptr;
 
-  if (PyTuple_Check((PyObject*)inst)) {  // NOLINT
+  if (inst != nullptr && PyTuple_Check((PyObject*)inst)) {  // NOLINT
     inst = (::pybind11::detail::instance*)PyTuple_GET_ITEM(inst, 0);
   }
 
@@ -823,11 +871,11 @@ static inline std::shared_ptr<imperative::VarBase> GetVarBaseFromArgs(
 
 static inline std::vector<std::shared_ptr<imperative::VarBase>>
 GetVarBaseListFromArgs(const std::string& op_type, const std::string& arg_name,
-                       PyObject* args, ssize_t arg_idx,
-                       bool dispensable = false) {
-  PyObject* list = PyTuple_GET_ITEM(args, arg_idx);
+                       PyObject* const* args, ssize_t args_num,
+                       ssize_t arg_idx, bool dispensable = false) {
+  PyObject* list = arg_idx < args_num ? args[arg_idx] : nullptr;
 
-  if (list == nullptr) {
+  if (list == nullptr || list == Py_None) {
     if (!dispensable) {
       PADDLE_THROW(platform::errors::InvalidArgument(
           "%s(): argument '%s' (position %d) must be list of Tensor, but got "
@@ -903,11 +951,12 @@ GetVarBaseListFromArgs(const std::string& op_type, const std::string& arg_name,
 }
 
 static inline unsigned long GetUnsignedLongFromArgs(  // NOLINT
-    const std::string& op_type, const std::string& arg_name, PyObject* args,
-    ssize_t arg_idx, bool dispensable = false) {
-  PyObject* item = PyTuple_GET_ITEM(args, arg_idx);
+    const std::string& op_type, const std::string& arg_name,
+    PyObject* const* args, ssize_t args_num, ssize_t arg_idx,
+    bool dispensable = false) {
+  PyObject* item = arg_idx < args_num ? args[arg_idx] : nullptr;
 
-  if (item == nullptr) {
+  if (item == nullptr || item == Py_None) {
     if (!dispensable) {
       PADDLE_THROW(platform::errors::InvalidArgument(
           "%s(): argument '%s' (position %d) must be long, but got None",
@@ -979,17 +1028,11 @@ static inline PyObject* MakeReturnPyObject(const std::tuple<Args...>& out) {
 }
 
 void InitOpsAttrTypeMap() {
-  auto op_info_map = paddle::framework::OpInfoMap::Instance().map();
-  for (auto iter = op_info_map.begin(); iter != op_info_map.end(); ++iter) {
-    auto op_proto = iter->second.proto_;
-    if (op_proto == nullptr) {
-      continue;
-    }
-    auto attrs_proto = op_proto->attrs();
-    for (auto& attr : attrs_proto) {
-      OpAttrTypeMap::Instance().Map()[iter->first][attr.name()] = attr.type();
-    }
-  }
+  // Kept for the generated BindOpFunctions code that calls it at import
+  // time. The attribute type map used to be filled here for every
+  // registered operator, which forced all op protos to be built during
+  // import; ConstructAttrMapFromPyArgs now fills it lazily per op type on
+  // first use instead.
 }
 
 void ThrowExceptionToPython(std::exception_ptr p) {
@@ -166,6 +166,7 @@ std::map<std::string, std::set<std::string>> op_passing_outs_map = {
     {"fake_quantize_dequantize_abs_max", {"Out", "OutScale"}},
     {"fake_channel_wise_quantize_dequantize_abs_max", {"Out", "OutScale"}},
     {"check_finite_and_unscale", {"Out", "FoundInfinite"}},
+    {"fused_clip_by_global_norm", {"Out", "GlobalNorm"}},
     {"update_loss_scaling",
      {"Out", "LossScaling", "OutGoodSteps", "OutBadSteps"}},
     {"moving_average_abs_max_scale",
@@ -237,13 +238,13 @@ const char* OUT_VAR_TYPE = R"(std::shared_ptr<imperative::VarBase>)";
 const char* OUT_VAR_LIST_TYPE = R"(std::vector<std::shared_ptr<imperative::VarBase>>)";
 
 const char* CAST_VAR_TEMPLATE = R"(
-    auto %s = GetVarBaseFromArgs("%s", "%s", args, %d, %s);)";
+    auto %s = GetVarBaseFromArgs("%s", "%s", args, nargs, %d, %s);)";
 
 const char* CAST_VAR_LIST_TEMPLATE = R"(
-    auto %s = GetVarBaseListFromArgs("%s", "%s", args, %d, %s);)";
+    auto %s = GetVarBaseListFromArgs("%s", "%s", args, nargs, %d, %s);)";
 
 const char* CAST_SIZE_T_TEMPLATE = R"(
-    auto %s = GetUnsignedLongFromArgs("%s", "%s", args, %d, %s);)";
+    auto %s = GetUnsignedLongFromArgs("%s", "%s", args, nargs, %d, %s);)";
 
 const char* ARG_TEMPLATE = R"(const %s& %s)";
 
@@ -277,14 +278,15 @@ const char* INPLACE_MAPPING_TEMPLATE = R"({"%s", "%s"})";
 
 const char* OP_FUNCTION_TEMPLATE =
 R"(
-static PyObject * %s(PyObject *self, PyObject *args, PyObject *kwargs)
+static PyObject * %s(PD_DYGRAPH_FUNCTION_PARAMS)
 {
+  PD_DYGRAPH_FUNCTION_UNPACK_ARGS();
   PyThreadState *tstate = nullptr;
   try
   {
     %s
     framework::AttributeMap attrs;
-    ConstructAttrMapFromPyArgs("%s", args, %d, PyTuple_GET_SIZE(args) , attrs);
+    ConstructAttrMapFromPyArgs("%s", args, %d, nargs, attrs);
     tstate = PyEval_SaveThread();
     %s
     imperative::NameVarBaseMap outs = %s;
@@ -304,7 +306,7 @@ static PyObject * %s(PyObject *self, PyObject *args, PyObject *kwargs)
   }
 })";
 
-const char* PYBIND_ITEM_TEMPLATE = R"(  {"%s", (PyCFunction)(void(*)(void))%s, METH_VARARGS | METH_KEYWORDS, "C++ interface function for %s in dygraph."},)";
+const char* PYBIND_ITEM_TEMPLATE = R"(  {"%s", (PyCFunction)(void(*)(void))%s, PD_DYGRAPH_FUNCTION_METH, "C++ interface function for %s in dygraph."},)";
 
 // clang-format on
 static inline bool FindInsMap(const std::string& op_type,
@@ -541,6 +543,9 @@ std::string GenerateOpFunctionsBody(
 
 static std::tuple<std::vector<std::string>, std::vector<std::string>>
 GenerateOpFunctions() {
+  // The generator enumerates every registered op, force the deferred
+  // protos that have not been looked up yet.
+  paddle::framework::OpInfoMap::Instance().MaterializeAllOpInfos();
   auto& op_info_map = paddle::framework::OpInfoMap::Instance().map();
 
   std::vector<std::string> op_function_list, bind_function_list;
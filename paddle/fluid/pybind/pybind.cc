@@ -549,17 +549,11 @@ PYBIND11_MODULE(core_noavx, m) {
                  "Note that a DLPack tensor can be consumed only once."));
 
     PyCapsule_SetName(dltensor->ptr(), "used_dltensor");
-    DLTensor dl = dmt->dl_tensor;
     framework::Tensor tensor;
 
-    if (dl.device.device_type == kDLCPU) {
-      paddle::framework::TensorFromDLPack(dl, &tensor);
-    }
-#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
-    if (dl.device.device_type == kDLGPU) {
-      paddle::framework::TensorFromDLPack(dl, &tensor);
-    }
-#endif
+    // Wraps the producer's buffer in place (no device-host-device copy);
+    // the producer's deleter runs when the tensor holder is released.
+    paddle::framework::TensorFromDLPack(dmt, &tensor);
     return tensor;
   });
 
@@ -1385,6 +1379,9 @@ All parameter, weight, gradient are variables in Paddle.
   //! Python str. If you want a str object, you should cast them in Python.
   m.def("get_all_op_protos", []() -> std::vector<py::bytes> {
     std::vector<py::bytes> ret_values;
+    // Deferred protos are only built on first lookup of their op type,
+    // enumerating them all has to force the remaining ones first.
+    OpInfoMap::Instance().MaterializeAllOpInfos();
     for (auto &iter : OpInfoMap::Instance().map()) {
       auto &info = iter.second;
       if (info.HasOpProtoAndChecker()) {
@@ -2086,7 +2083,24 @@ All parameter, weight, gradient are variables in Paddle.
                cost_info = self.DryRun(feed_names, feed_tensors);
              }
              return cost_info;
-           });
+           })
+      .def("instruction_stats", [](StandaloneExecutor &self) {
+        // per-instruction runtime statistics accumulated over the steps run
+        // so far, one dict per instruction
+        py::list result;
+        for (auto &stat : self.GetInstructionStats()) {
+          py::dict d;
+          d["op_type"] = stat.op_type;
+          d["run_count"] = stat.run_count;
+          d["mean_run_ms"] = stat.MeanRunMs();
+          d["p99_run_ms"] = stat.PercentileRunMs(0.99);
+          d["total_run_ms"] = stat.total_run_ms;
+          d["total_queue_ms"] = stat.total_queue_ms;
+          d["total_gc_ms"] = stat.total_gc_ms;
+          result.append(d);
+        }
+        return result;
+      });
 
   m.def("init_gflags", framework::InitGflags);
   m.def("init_glog", framework::InitGLOG);
@@ -16,6 +16,7 @@ limitations under the License. */
 
 #include <Python.h>
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -23,6 +24,7 @@ limitations under the License. */
 #include <vector>
 #include "paddle/fluid/framework/data_type.h"
 #include "paddle/fluid/framework/lod_tensor.h"
+#include "paddle/fluid/memory/malloc.h"
 #include "paddle/fluid/memory/memcpy.h"
 #include "paddle/fluid/operators/eigen/eigen_function.h"
 #include "paddle/fluid/operators/math/concat_and_split.h"
@@ -209,6 +211,50 @@ inline std::string TensorDTypeToPyDTypeStr(
       "Unsupported tensor data type: %s", framework::DataTypeToString(type)));
 }
 
+// Base object of a numpy array wrapping CPU tensor storage without a copy.
+// The embedded Tensor copy shares the Allocation and the inplace version
+// counter of the source, so the storage outlives the array, and the version
+// observed at wrap time is checked when the array is released: an in-place
+// update of the tensor while the array was alive means python may have read
+// stale or torn data, which is worth a warning instead of silence.
+struct ZeroCopyTensorGuard {
+  explicit ZeroCopyTensorGuard(const framework::Tensor &tensor)
+      : tensor_(tensor),
+        wrapped_version_(tensor_.InplaceVersionCounter().CurrentVersion()) {}
+
+  ~ZeroCopyTensorGuard() {
+    uint32_t current_version =
+        tensor_.InplaceVersionCounter().CurrentVersion();
+    if (current_version != wrapped_version_) {
+      LOG(WARNING) << "A tensor exposed to numpy without a copy was "
+                      "modified in place (version "
+                   << wrapped_version_ << " -> " << current_version
+                   << ") while the numpy array was alive. The array may "
+                      "have observed the modified data.";
+    }
+  }
+
+  framework::Tensor tensor_;
+  uint32_t wrapped_version_;
+};
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+// Reusable pinned staging buffer for fetching GPU tensors, grown
+// geometrically and kept for the lifetime of the thread. Device-to-host
+// copies into pageable numpy memory make the driver stage through its own
+// small pinned area chunk by chunk; one explicit pinned buffer plus a host
+// memcpy is considerably faster for large fetches.
+inline memory::AllocationPtr &GetPinnedFetchBuffer(size_t size) {
+  thread_local memory::AllocationPtr buffer;
+  if (buffer == nullptr || buffer->size() < size) {
+    size_t new_size =
+        buffer == nullptr ? size : (std::max)(size, buffer->size() * 2);
+    buffer = memory::Alloc(platform::CUDAPinnedPlace(), new_size);
+  }
+  return buffer;
+}
+#endif
+
 }  // namespace details
 
 template <typename T>
@@ -295,6 +341,10 @@ void SetTensorFromPyArrayT(
       auto holder = std::make_shared<details::NumpyAllocation<T>>(array);
       auto type = framework::ToDataType(std::type_index(typeid(T)));
       self->ResetHolderWithType(holder, type);
+      // The storage changed under every existing view of this tensor;
+      // bump the inplace version so stale snapshots are detected instead
+      // of silently aliasing the shared numpy buffer.
+      self->InplaceVersionCounter().Bump();
     } else {
       auto dst = self->mutable_data<T>(place);
       std::memcpy(dst, array.data(), array.nbytes());
@@ -706,7 +756,13 @@ inline py::array TensorToPyArray(const framework::Tensor &tensor,
 
   if (!is_gpu_tensor && !is_xpu_tensor && !is_npu_tensor) {
     if (!need_deep_copy) {
-      auto base = py::cast(std::move(tensor));
+      // Wrap the tensor storage directly, the guard keeps the Allocation
+      // alive for the lifetime of the numpy array and checks the inplace
+      // version counter when the array is released.
+      auto *guard = new details::ZeroCopyTensorGuard(tensor);
+      py::capsule base(guard, [](void *p) {
+        delete static_cast<details::ZeroCopyTensorGuard *>(p);
+      });
       return py::array(py::dtype(py_dtype_str.c_str()), py_dims, py_strides,
                        const_cast<void *>(tensor_buf_ptr), base);
     } else {
@@ -765,8 +821,19 @@ inline py::array TensorToPyArray(const framework::Tensor &tensor,
 
     size_t copy_bytes = sizeof_dtype * numel;
     auto p = BOOST_GET_CONST(platform::CUDAPlace, tensor.place());
-    paddle::memory::Copy(platform::CPUPlace(), py_arr.mutable_data(), p,
-                         tensor_buf_ptr, copy_bytes, nullptr);
+    // Stage large fetches through a reusable pinned buffer, a direct copy
+    // into the pageable numpy allocation makes the driver stage chunk by
+    // chunk through its own pinned area instead.
+    constexpr size_t kPinnedStageThreshold = 1 << 20;
+    if (copy_bytes >= kPinnedStageThreshold) {
+      auto &pinned = details::GetPinnedFetchBuffer(copy_bytes);
+      paddle::memory::Copy(platform::CUDAPinnedPlace(), pinned->ptr(), p,
+                           tensor_buf_ptr, copy_bytes, nullptr);
+      std::memcpy(py_arr.mutable_data(), pinned->ptr(), copy_bytes);
+    } else {
+      paddle::memory::Copy(platform::CPUPlace(), py_arr.mutable_data(), p,
+                           tensor_buf_ptr, copy_bytes, nullptr);
+    }
     return py_arr;
 #else
     PADDLE_THROW(platform::errors::PermissionDenied(
@@ -0,0 +1,63 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/utils/small_map.h"
+
+#include <map>
+#include <string>
+
+#include "glog/logging.h"
+#include "gtest/gtest.h"
+
+template <unsigned N>
+void SmallMapCheck(size_t n) {
+  std::map<std::string, int> std_map;
+  paddle::SmallMap<std::string, int, N> map;
+
+  CHECK_EQ(map.empty(), true);
+  for (size_t i = 0; i < n; ++i) {
+    std::string key = "key_" + std::to_string(i);
+    std_map[key] = static_cast<int>(i);
+    map[key] = static_cast<int>(i);
+  }
+  CHECK_EQ(std_map.size(), map.size());
+
+  for (auto &pair : std_map) {
+    CHECK_EQ(map.count(pair.first), static_cast<size_t>(1));
+    CHECK_EQ(map.at(pair.first), pair.second);
+    CHECK_EQ(map[pair.first], pair.second);
+  }
+  CHECK_EQ(map.count("not_exist_key"), static_cast<size_t>(0));
+  CHECK(map.find("not_exist_key") == map.end());
+
+  // operator[] on an existing key must not insert again
+  if (n > 0) {
+    map["key_0"] = -1;
+    CHECK_EQ(map.size(), std_map.size());
+    CHECK_EQ(map.at("key_0"), -1);
+  }
+
+  map.clear();
+  CHECK_EQ(map.empty(), true);
+  CHECK_EQ(map.size(), static_cast<size_t>(0));
+}
+
+TEST(small_map, small_map) {
+  for (size_t i = 0; i < 20; ++i) {
+    SmallMapCheck<1>(i);
+    SmallMapCheck<2>(i);
+    SmallMapCheck<10>(i);
+    SmallMapCheck<21>(i);
+  }
+}
@@ -0,0 +1,94 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PADDLE_UTILS_SMALL_MAP_H_
+#define PADDLE_UTILS_SMALL_MAP_H_
+
+#include <cassert>
+#include <utility>
+
+#include "paddle/utils/small_vector.h"
+
+namespace paddle {
+
+/// A map for very small numbers of entries, backed by a SmallVector of
+/// key-value pairs that is searched linearly. Entries stay inline without
+/// heap allocation while the size is at most N, which makes the map cheap
+/// to construct and destroy at high rates. Only the subset of the std::map
+/// interface our callers need is provided; iteration is in insertion
+/// order, not key order.
+template <typename KeyT, typename ValueT, unsigned N>
+class SmallMap {
+ public:
+  using value_type = std::pair<KeyT, ValueT>;
+  using iterator = typename SmallVector<value_type, N>::iterator;
+  using const_iterator = typename SmallVector<value_type, N>::const_iterator;
+
+  SmallMap() = default;
+
+  iterator begin() { return entries_.begin(); }
+  iterator end() { return entries_.end(); }
+  const_iterator begin() const { return entries_.begin(); }
+  const_iterator end() const { return entries_.end(); }
+
+  bool empty() const { return entries_.empty(); }
+  size_t size() const { return entries_.size(); }
+  void clear() { entries_.clear(); }
+
+  iterator find(const KeyT &key) {
+    iterator it = entries_.begin();
+    for (; it != entries_.end(); ++it) {
+      if (it->first == key) break;
+    }
+    return it;
+  }
+
+  const_iterator find(const KeyT &key) const {
+    const_iterator it = entries_.begin();
+    for (; it != entries_.end(); ++it) {
+      if (it->first == key) break;
+    }
+    return it;
+  }
+
+  size_t count(const KeyT &key) const { return find(key) == end() ? 0 : 1; }
+
+  ValueT &operator[](const KeyT &key) {
+    iterator it = find(key);
+    if (it != end()) {
+      return it->second;
+    }
+    entries_.emplace_back(key, ValueT());
+    return entries_.back().second;
+  }
+
+  const ValueT &at(const KeyT &key) const {
+    const_iterator it = find(key);
+    assert(it != end());
+    return it->second;
+  }
+
+  ValueT &at(const KeyT &key) {
+    iterator it = find(key);
+    assert(it != end());
+    return it->second;
+  }
+
+ private:
+  SmallVector<value_type, N> entries_;
+};
+
+}  // namespace paddle
+
+#endif  // PADDLE_UTILS_SMALL_MAP_H_
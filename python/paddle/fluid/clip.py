@@ -434,6 +434,31 @@ class ClipGradByGlobalNorm(ClipGradBase):
 
     @imperative_base.no_grad
     def _dygraph_clip(self, params_grads):
+        # Fast path: when every gradient is a dense tensor of the same dtype,
+        # the fused_clip_by_global_norm op computes the global norm and scales
+        # all gradients in place with a few multi-tensor kernels, so the
+        # number of kernel launches does not grow with the parameter count
+        # and the clip scale never leaves the device.
+        clip_grads = []
+        for p, g in params_grads:
+            if g is None:
+                continue
+            if getattr(p, 'need_clip', True) is False:
+                continue
+            clip_grads.append(g)
+        if len(clip_grads) > 0 and all(
+                g.type == core.VarDesc.VarType.LOD_TENSOR and
+                g.dtype == clip_grads[0].dtype for g in clip_grads):
+            # the kernel accumulates the fp16 norm in fp32
+            norm_dtype = core.VarDesc.VarType.FP32 \
+                if clip_grads[0].dtype == core.VarDesc.VarType.FP16 \
+                else clip_grads[0].dtype
+            global_norm_var = framework._varbase_creator(dtype=norm_dtype)
+            core.ops.fused_clip_by_global_norm(clip_grads, clip_grads,
+                                               global_norm_var, 'clip_norm',
+                                               self.clip_norm)
+            return params_grads
+
         params_and_grads = []
         sum_square_list = []
         sum_square_list_fp16 = []
@@ -794,6 +794,29 @@ class InMemoryDataset(DatasetBase):
         self.dataset.create_preload_readers()
         self.dataset.preload_into_memory()
 
+    def set_preload_double_buffer(self, enable, budget_ins=0):
+        """
+        Enable double buffered preloading: preload_into_memory of the next
+        pass fills a spare channel while the current pass trains, and
+        wait_preload_done swaps it in at the pass boundary. budget_ins > 0
+        caps the spare channel (in instances) to bound the overlap memory;
+        the remainder is loaded when wait_preload_done lifts the cap.
+
+        Args:
+            enable(bool): whether to double buffer the preload
+            budget_ins(int): preload memory budget in instances, 0 means
+                unlimited
+
+        Examples:
+            .. code-block:: python
+
+              # required: skiptest
+              import paddle.fluid as fluid
+              dataset = fluid.DatasetFactory().create_dataset("InMemoryDataset")
+              dataset.set_preload_double_buffer(True, budget_ins=10000000)
+        """
+        self.dataset.set_preload_double_buffer(enable, budget_ins)
+
     @deprecated(
         since="2.0.0",
         update_to="paddle.distributed.InMemoryDataset.wait_preload_done")
@@ -835,6 +858,29 @@ class InMemoryDataset(DatasetBase):
         """
         self.dataset.local_shuffle()
 
+    def set_shuffle_spill(self, spill_dir, bucket_num):
+        """
+        Enable disk-backed local shuffle. Records are spilled into
+        bucket_num files under spill_dir and shuffled bucket by bucket,
+        so local_shuffle keeps one bucket resident instead of the whole
+        dataset. Set bucket_num to 0 to keep the in-memory shuffle.
+
+        Args:
+            spill_dir(str): local directory for the spill bucket files
+            bucket_num(int): number of spill buckets
+
+        Examples:
+            .. code-block:: python
+
+              # required: skiptest
+              import paddle.fluid as fluid
+              dataset = fluid.DatasetFactory().create_dataset("InMemoryDataset")
+              dataset.set_shuffle_spill("/ssd/shuffle_tmp", 64)
+              dataset.load_into_memory()
+              dataset.local_shuffle()
+        """
+        self.dataset.set_shuffle_spill(spill_dir, bucket_num)
+
     @deprecated(
         since="2.0.0",
         update_to="paddle.distributed.InMemoryDataset.global_shuffle")
@@ -1149,6 +1195,31 @@ class FileInstantDataset(DatasetBase):
             "FileInstantDataset does not support global shuffle, "
             "please use InMemoryDataset for global_shuffle")
 
+    def convert_text_to_binary(self, text_filename, binary_filename):
+        """
+        Convert one file of MultiSlot text format into the binary format
+        this dataset memory-maps, so epoch start becomes an mmap plus
+        page-in instead of a parse of the whole text file. Call set_use_var
+        first so the slots are described in the data feed desc.
+
+        Examples:
+            .. code-block:: python
+
+              import paddle.fluid as fluid
+              dataset = fluid.DatasetFactory().create_dataset("FileInstantDataset")
+              dataset.set_use_var([data, label])
+              dataset.convert_text_to_binary("a.txt", "a.bin")
+
+        Args:
+            text_filename(str): path of the MultiSlot text file
+            binary_filename(str): path of the binary file to create
+
+        Returns:
+            The number of instances converted
+        """
+        return core.convert_multi_slot_text_to_instant_binary(
+            text_filename, binary_filename, self.desc())
+
 
 class BoxPSDataset(InMemoryDataset):
     """
@@ -107,6 +107,8 @@ class Hogwild(DeviceWorker):
             return
         downpour = trainer_desc.downpour_param
         hogwild = trainer_desc.hogwild_param
+        if opt_info.get("double_buffered", False):
+            hogwild.double_buffered = True
         if opt_info["stat_var_names"]:
             for i in opt_info["stat_var_names"]:
                 hogwild.stat_var_names.extend([i])
@@ -428,6 +430,8 @@ class Section(DeviceWorker):
             "for pipeline must be one of F-then-B or 1F1B")
         schedule_mode = 0 if schedule_mode_str == "F-then-B" else 1
         section_param.schedule_mode = schedule_mode
+        section_param.max_inflight_microbatches = pipeline_opt.get(
+            "max_inflight_microbatches", 0)
         cfg = section_param.section_config
         program = pipeline_opt["section_program"]
         cfg.program_desc.ParseFromString(program._get_desc()
@@ -395,6 +395,20 @@ def _is_enable_standalone_executor():
     return flag
 
 
+def _is_enable_feed_buffer_sharing():
+    """
+    Whether numpy arrays in the feed dict are shared into the feed
+    variables instead of being copied. Only C-contiguous, aligned arrays
+    fed on CPUPlace are shared; a shared array must not be mutated until
+    the step that consumed it has finished.
+    """
+    flag = False
+    env_val = os.environ.get('FLAGS_SHARE_FEED_BUFFER', None)
+    if env_val in [1, '1', True, 'True', 'true']:
+        flag = True
+    return flag
+
+
 def _get_strong_program_cache_key(program, feed, fetch_list):
     return str(id(program)) + _get_program_cache_key(feed, fetch_list)
 
@@ -410,7 +424,7 @@ def _get_program_cache_key(feed, fetch_list):
     return str(feed_var_names + fetch_var_names)
 
 
-def _as_lodtensor(data, place, dtype=None):
+def _as_lodtensor(data, place, dtype=None, zero_copy=False):
     """
         Convert numpy.ndarray to Tensor, its only support Tensor without LoD information.
         For higher dimensional sequence data, please use LoDTensor directly.
@@ -427,6 +441,8 @@ def _as_lodtensor(data, place, dtype=None):
             data(numpy.ndarray|list|tuple|scalar): a instance of array, scalar, list or tuple
             data(core.Place): the place of created tensor
             dtype(core.VarDesc.VarType|str): the expected data type of created tensor
+            zero_copy(bool): whether to share a C-contiguous, aligned CPU
+                ndarray as the tensor storage instead of copying it
 
         Returns:
             LoDTensor
@@ -454,7 +470,13 @@ def _as_lodtensor(data, place, dtype=None):
 
     # convert numpy.ndarray to tensor
     tensor = core.LoDTensor()
-    tensor.set(data, place)
+    if zero_copy and isinstance(place, core.CPUPlace) and data.flags[
+            'C_CONTIGUOUS'] and data.flags['ALIGNED']:
+        # wrap the numpy buffer as tensor storage directly; the tensor
+        # holder keeps a reference to the array so it stays alive
+        tensor.set(data, place, True)
+    else:
+        tensor.set(data, place)
     return tensor
 
 
@@ -702,6 +724,7 @@ class Executor(object):
 
         # NOTE: Whether to use experimental executor `StandaloneExecutor`.
         self._enable_interpreter_core = _is_enable_standalone_executor()
+        self._enable_feed_buffer_sharing = _is_enable_feed_buffer_sharing()
         self._executor_cache = _ExecutorCache(self.place)
 
     def _get_scope_cache(self, program_cache_key):
@@ -794,8 +817,11 @@ class Executor(object):
                 var = global_block.var(feed_target_name)
                 if var.dtype != core.VarDesc.VarType.STRINGS:
                     if not isinstance(cur_feed, core.LoDTensor):
-                        cur_feed = _as_lodtensor(cur_feed, self.place,
-                                                 var.dtype)
+                        cur_feed = _as_lodtensor(
+                            cur_feed,
+                            self.place,
+                            var.dtype,
+                            zero_copy=self._enable_feed_buffer_sharing)
                     check_feed_shape_type(var, cur_feed)
                 idx = op.desc.attr('col')
                 core.set_feed_variable(scope, cur_feed, feed_var_name, idx)
@@ -5821,6 +5821,12 @@ class PipelineOptimizer(object):
         self.mp_degree = pipeline_opt['mp_degree']
         self.mp_rank = pipeline_opt['mp_rank']
         self.scale_gradient = pipeline_opt.get('scale_gradient', False)
+        # Cap on micro batches kept in flight by the 1F1B scheduler. Each
+        # in-flight micro batch holds one set of activations, so lowering
+        # the cap below the schedule-derived depth trades pipeline bubble
+        # for a hard bound on activation memory. 0 keeps the default depth.
+        self.max_inflight_microbatches = pipeline_opt.get(
+            'max_inflight_microbatches', 0)
         assert self.mp_degree >= 1
         assert 0 <= self.mp_rank < self.mp_degree
 
@@ -5921,6 +5927,7 @@ class PipelineOptimizer(object):
             "place_id": place_id,
             "sync_steps": -1,
             "num_microbatches": self._num_microbatches,
+            "max_inflight_microbatches": self.max_inflight_microbatches,
             "start_cpu_core_id": self._start_cpu_core_id,
         }
         return optimize_ops, params_grads, program_list, self._pipeline_pair, self._pp_ring_map
@@ -75,6 +75,25 @@ class LinearTestCase(unittest.TestCase):
         })
         self.check_cost_info(cost_info)
 
+    def test_instruction_stats(self):
+        startup_program, main_program, c = self.build_program()
+        standaloneexecutor = StandaloneExecutor(
+            self.place, startup_program.desc, main_program.desc, core.Scope())
+        for i in range(10):
+            standaloneexecutor.run({
+                "a": np.ones(
+                    [2, 2], dtype="float32") * i
+            }, [c.name])
+
+        stats = standaloneexecutor.instruction_stats()
+        self.assertGreater(len(stats), 0)
+        for stat in stats:
+            self.assertEqual(stat['run_count'], 10)
+            self.assertGreaterEqual(stat['total_run_ms'], 0.0)
+            self.assertGreaterEqual(stat['p99_run_ms'], 0.0)
+            self.assertGreaterEqual(stat['total_queue_ms'], 0.0)
+            self.assertGreaterEqual(stat['total_gc_ms'], 0.0)
+
     def check_cost_info(self, cost_info):
         IS_WINDOWS = sys.platform.startswith('win')
 
@@ -0,0 +1,90 @@
+#   Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+import numpy as np
+from op_test import OpTest
+import paddle
+
+
+def ref_clip_by_global_norm(xs, clip_norm):
+    global_norm = np.sqrt(sum([np.sum(np.square(x)) for x in xs]))
+    scale = clip_norm / max(global_norm, clip_norm)
+    return [x * scale for x in xs], global_norm
+
+
+class TestFusedClipByGlobalNormOp(OpTest):
+    def setUp(self):
+        self.op_type = "fused_clip_by_global_norm"
+        self.init_config()
+        xs = [
+            np.random.random(shape).astype(self.dtype) for shape in self.shapes
+        ]
+        outs, global_norm = ref_clip_by_global_norm(xs, self.clip_norm)
+
+        self.inputs = {
+            'X': [('x{}'.format(i), x) for i, x in enumerate(xs)]
+        }
+        self.attrs = {'clip_norm': self.clip_norm}
+        self.outputs = {
+            'Out': [('out{}'.format(i), out) for i, out in enumerate(outs)],
+            'GlobalNorm': np.array([global_norm]).astype(self.dtype)
+        }
+
+    def init_config(self):
+        self.dtype = np.float32
+        self.shapes = [(16, 16), (64, ), (10, 3, 7)]
+        self.clip_norm = 1.0
+
+    def test_check_output(self):
+        self.check_output()
+
+
+class TestFusedClipByGlobalNormOpNoClip(TestFusedClipByGlobalNormOp):
+    # global norm below the threshold, gradients stay unchanged
+    def init_config(self):
+        self.dtype = np.float32
+        self.shapes = [(8, 8), (32, )]
+        self.clip_norm = 1e6
+
+
+class TestFusedClipByGlobalNormOpFp64(TestFusedClipByGlobalNormOp):
+    def init_config(self):
+        self.dtype = np.float64
+        self.shapes = [(16, 16), (64, )]
+        self.clip_norm = 0.5
+
+
+class TestDygraphClipByGlobalNormFastPath(unittest.TestCase):
+    def test_clip_result(self):
+        paddle.disable_static()
+        clip_norm = 0.8
+        clip = paddle.nn.ClipGradByGlobalNorm(clip_norm=clip_norm)
+        params_grads = []
+        np_grads = []
+        for shape in [(10, 10), (25, )]:
+            param = paddle.to_tensor(
+                np.random.random(shape).astype('float32'))
+            grad = paddle.to_tensor(np.random.random(shape).astype('float32'))
+            np_grads.append(grad.numpy())
+            params_grads.append((param, grad))
+        ref_outs, _ = ref_clip_by_global_norm(np_grads, clip_norm)
+        clipped = clip(params_grads)
+        for (p, g), ref in zip(clipped, ref_outs):
+            self.assertTrue(np.allclose(g.numpy(), ref, atol=1e-6))
+        paddle.enable_static()
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -61,6 +61,14 @@ class TestNanInf(unittest.TestCase):
         self.check_nan_inf()
 
 
+class TestNanInfFastMode(TestNanInf):
+    def setUp(self):
+        super(TestNanInfFastMode, self).setUp()
+        # the blocked early-exit scan must report the same error as the
+        # default full scan
+        self.env[str("PADDLE_INF_NAN_FAST_MODE")] = str("1")
+
+
 class TestNanInfEnv(TestNanInf):
     def setUp(self):
         super(TestNanInfEnv, self).setUp()
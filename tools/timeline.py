@@ -78,6 +78,53 @@ class _ChromeTraceFormatter(object):
         event['args'] = {'name': name}
         self._metadata.append(event)
 
+    def emit_tid(self, name, pid, tid):
+        """Adds a thread metadata event to the trace.
+
+        Args:
+          name:  The thread name as a string.
+          pid:  Identifier of the process owning the thread as an integer.
+          tid:  Identifier of the thread as an integer.
+        """
+        event = {}
+        event['name'] = 'thread_name'
+        event['ph'] = 'M'
+        event['pid'] = pid
+        event['tid'] = tid
+        event['args'] = {'name': name}
+        self._metadata.append(event)
+
+    def emit_flow_start(self, category, name, flow_id, pid, tid, timestamp):
+        """Adds the source point of a flow arrow to the trace.
+
+        Args:
+          category: The event category as a string.
+          name:  The flow name as a string.
+          flow_id:  Identifier shared with the matching finish event.
+          pid:  Identifier of the process generating this event as an integer.
+          tid:  Identifier of the thread generating this event as an integer.
+          timestamp:  The timestamp of this event as a long integer.
+        """
+        event = self._create_event('s', category, name, pid, tid, timestamp)
+        event['id'] = flow_id
+        self._events.append(event)
+
+    def emit_flow_finish(self, category, name, flow_id, pid, tid, timestamp):
+        """Adds the destination point of a flow arrow to the trace.
+
+        Args:
+          category: The event category as a string.
+          name:  The flow name as a string.
+          flow_id:  Identifier shared with the matching start event.
+          pid:  Identifier of the process generating this event as an integer.
+          tid:  Identifier of the thread generating this event as an integer.
+          timestamp:  The timestamp of this event as a long integer.
+        """
+        event = self._create_event('f', category, name, pid, tid, timestamp)
+        event['id'] = flow_id
+        event['bp'] = 'e'
+        self._events.append(event)
+
     def emit_region(self, timestamp, duration, pid, tid, category, name, args):
         """Adds a region event to the trace.
 
@@ -135,6 +182,7 @@ class Timeline(object):
         self._devices = dict()
         self._mem_devices = dict()
         self._chrome_trace = _ChromeTraceFormatter()
+        self._flow_id = 0
 
     def _allocate_pid(self):
         cur_pid = self._pid
@@ -216,6 +264,12 @@ class Timeline(object):
 
     def _allocate_events(self):
         for k, profile_pb in six.iteritems(self._profile_dict):
+            # launch/kernel coordinates keyed by CUPTI correlation id, used
+            # to draw the flow arrows from a host-side launch to the kernel
+            # (or memcpy) it produced on its stream row
+            host_launches = dict()
+            device_kernels = dict()
+            named_streams = set()
             for event in profile_pb.events:
                 if event.type == profiler_pb2.Event.CPU:
                     type = "CPU"
@@ -227,11 +281,38 @@ class Timeline(object):
                     args['mem_bytes'] = event.memcopy.bytes
                 if hasattr(event, "detail_info") and event.detail_info:
                     args['detail_info'] = event.detail_info
+                correlation_id = getattr(event, "correlation_id", 0)
+                if correlation_id > 0:
+                    args['correlation_id'] = correlation_id
+                    if type == "GPUKernel":
+                        # sub_device_id carries the stream id for GPU events
+                        device_kernels[correlation_id] = (
+                            pid, event.sub_device_id, event.start_ns)
+                        if (pid, event.sub_device_id) not in named_streams:
+                            named_streams.add((pid, event.sub_device_id))
+                            self._chrome_trace.emit_tid(
+                                "stream %d" % event.sub_device_id, pid,
+                                event.sub_device_id)
+                    elif event.device_id == -1:
+                        host_launches[correlation_id] = (
+                            pid, event.sub_device_id, event.start_ns,
+                            event.name)
                 # TODO(panyx0718): Chrome tracing only handles ms. However, some
                 # ops takes micro-seconds. Hence, we keep the ns here.
                 self._chrome_trace.emit_region(
                     event.start_ns, (event.end_ns - event.start_ns) / 1.0, pid,
                     event.sub_device_id, 'Op', event.name, args)
+            for correlation_id, launch in six.iteritems(host_launches):
+                kernel = device_kernels.get(correlation_id)
+                if kernel is None:
+                    continue
+                self._flow_id += 1
+                self._chrome_trace.emit_flow_start('launch', launch[3],
+                                                   self._flow_id, launch[0],
+                                                   launch[1], launch[2])
+                self._chrome_trace.emit_flow_finish('launch', launch[3],
+                                                    self._flow_id, kernel[0],
+                                                    kernel[1], kernel[2])
 
     def _allocate_memory_event(self):
         if not hasattr(profiler_pb2, "MemEvent"):